@@ -0,0 +1,1357 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+//---------------------------------------------------------------------------------------------------------------------
+// Description:
+// Native HTTP/1.1 load generator for HttpAsyncServer and HttpAsyncFileServer (or any server listening on localhost).
+//
+// - Closed loop (default): every connection keeps `--depth` requests in flight, sending a new one as soon as a
+//   response completes.
+// - Open loop (`--rate N`): requests are scheduled at a constant rate independently of responses, and latency is
+//   measured from the scheduled time rather than from the actual send time, so that a stalled server is not hiding
+//   queueing delay (coordinated omission). Service time (from actual send) is reported separately.
+//   Due requests are checked on every completion and on a 1 ms timer, so corrected latency can include up to 1 ms of
+//   scheduling delay at low rates.
+// - Depth 1 uses one keep-alive HttpAsyncClient per connection. Depth above 1 uses raw sockets writing requests
+//   back-to-back (HTTP/1.1 pipelining), as HttpAsyncClient processes one request at a time.
+//
+// Latencies are recorded in log-linear histograms (HdrHistogram layout with 3 significant digits) and the summary can
+// be saved as JSON with `--json` to track regressions across runs.
+//---------------------------------------------------------------------------------------------------------------------
+// Usage:
+//   HttpBenchmark --serve --connections 32 --duration 10                     (in-process HttpAsyncServer)
+//   HttpBenchmark --serve --directory Examples/AsyncWebServer --mix /index.html (in-process HttpAsyncFileServer)
+//   HttpBenchmark --url http://127.0.0.1:8090 --rate 20000 --json results.json
+//   HttpBenchmark --url http://127.0.0.1:8090 --mix "GET:/index.html*8,HEAD:/*1,POST:/upload*1" --body-size 1024
+//---------------------------------------------------------------------------------------------------------------------
+#include "../../Libraries/Async/Async.h"
+#include "../../Libraries/Containers/VirtualArray.h"
+#include "../../Libraries/File/File.h"
+#include "../../Libraries/Http/HttpAsyncClient.h"
+#include "../../Libraries/Http/HttpAsyncFileServer.h"
+#include "../../Libraries/Http/HttpAsyncServer.h"
+#include "../../Libraries/Http/HttpURLParser.h"
+#include "../../Libraries/Memory/String.h"
+#include "../../Libraries/Strings/CommandLine.h"
+#include "../../Libraries/Strings/Console.h"
+#include "../../Libraries/Strings/StringBuilder.h"
+#include "../../Libraries/Strings/StringView.h"
+#include "../../Libraries/Threading/ThreadPool.h"
+#include "../../Libraries/Threading/Threading.h"
+#include "../../Libraries/Time/Time.h"
+
+#if !SC_PLATFORM_WINDOWS
+#include <signal.h>
+#endif
+
+namespace SC
+{
+//---------------------------------------------------------------------------------------------------------------------
+// Latency histogram
+//---------------------------------------------------------------------------------------------------------------------
+/// Log-linear histogram with the same bucket layout of HdrHistogram (3 significant digits, unit magnitude 0).
+/// Values up to 2048 are recorded exactly, larger values with a relative error below 1/1024.
+struct LatencyHistogram
+{
+    static constexpr uint32_t SubBucketHalfCountMagnitude = 10;
+    static constexpr uint64_t SubBucketHalfCount          = uint64_t(1) << SubBucketHalfCountMagnitude;
+    static constexpr uint64_t SubBucketMask               = (SubBucketHalfCount << 1) - 1;
+    static constexpr uint32_t BucketCount                 = 22; // Covers values up to 2^32 - 1 (about 71 minutes)
+    static constexpr uint64_t HighestTrackableValue       = (uint64_t(1) << 32) - 1;
+    static constexpr size_t   CountsLength                = (BucketCount + 1) * SubBucketHalfCount;
+
+    void record(uint64_t value)
+    {
+        value = value > HighestTrackableValue ? HighestTrackableValue : value;
+        counts[countsIndexFor(value)]++;
+        if (totalCount == 0 or value < minValue)
+        {
+            minValue = value;
+        }
+        maxValue = value > maxValue ? value : maxValue;
+        totalCount++;
+        sum += static_cast<double>(value);
+        sumOfSquares += static_cast<double>(value) * static_cast<double>(value);
+    }
+
+    [[nodiscard]] uint64_t getCount() const { return totalCount; }
+    [[nodiscard]] uint64_t getMin() const { return minValue; }
+    [[nodiscard]] uint64_t getMax() const { return maxValue; }
+    [[nodiscard]] double   getMean() const { return totalCount == 0 ? 0.0 : sum / static_cast<double>(totalCount); }
+
+    [[nodiscard]] double getStandardDeviation() const
+    {
+        if (totalCount == 0)
+        {
+            return 0.0;
+        }
+        const double mean     = getMean();
+        const double variance = sumOfSquares / static_cast<double>(totalCount) - mean * mean;
+        return variance > 0.0 ? squareRoot(variance) : 0.0;
+    }
+
+    /// Returns the highest value equivalent to the one found at the given percentile (0.0 to 100.0)
+    [[nodiscard]] uint64_t getValueAtPercentile(double percentile) const
+    {
+        if (totalCount == 0)
+        {
+            return 0;
+        }
+        uint64_t countAtPercentile =
+            static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(totalCount) + 0.5);
+        countAtPercentile = countAtPercentile == 0 ? 1 : countAtPercentile;
+
+        uint64_t accumulated = 0;
+        for (size_t idx = 0; idx < CountsLength; ++idx)
+        {
+            accumulated += counts[idx];
+            if (accumulated >= countAtPercentile)
+            {
+                const uint64_t value = highestEquivalentValue(valueFromIndex(idx));
+                return value < maxValue ? value : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+  private:
+    uint64_t counts[CountsLength] = {0};
+    uint64_t totalCount           = 0;
+    uint64_t minValue             = 0;
+    uint64_t maxValue             = 0;
+    double   sum                  = 0.0;
+    double   sumOfSquares         = 0.0;
+
+    static uint32_t bitLength(uint64_t value)
+    {
+        uint32_t length = 0;
+        for (uint32_t shift = 32; shift > 0; shift /= 2)
+        {
+            if ((value >> shift) != 0)
+            {
+                value >>= shift;
+                length += shift;
+            }
+        }
+        return length + static_cast<uint32_t>(value);
+    }
+
+    static uint32_t bucketIndexFor(uint64_t value)
+    {
+        return bitLength(value | SubBucketMask) - (SubBucketHalfCountMagnitude + 1);
+    }
+
+    static size_t countsIndexFor(uint64_t value)
+    {
+        const uint32_t bucketIndex    = bucketIndexFor(value);
+        const uint64_t subBucketIndex = value >> bucketIndex;
+        return static_cast<size_t>(((uint64_t(bucketIndex) + 1) << SubBucketHalfCountMagnitude) +
+                                   (subBucketIndex - SubBucketHalfCount));
+    }
+
+    static uint64_t valueFromIndex(size_t index)
+    {
+        int32_t  bucketIndex    = static_cast<int32_t>(index >> SubBucketHalfCountMagnitude) - 1;
+        uint64_t subBucketIndex = (index & (SubBucketHalfCount - 1)) + SubBucketHalfCount;
+        if (bucketIndex < 0)
+        {
+            subBucketIndex -= SubBucketHalfCount;
+            bucketIndex = 0;
+        }
+        return subBucketIndex << bucketIndex;
+    }
+
+    static uint64_t highestEquivalentValue(uint64_t value)
+    {
+        return value + (uint64_t(1) << bucketIndexFor(value)) - 1;
+    }
+
+    static double squareRoot(double value)
+    {
+        double estimate = value > 1.0 ? value : 1.0;
+        for (int iteration = 0; iteration < 64; ++iteration)
+        {
+            const double next = 0.5 * (estimate + value / estimate);
+            if (next == estimate)
+            {
+                break;
+            }
+            estimate = next;
+        }
+        return estimate;
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// Options and request mix
+//---------------------------------------------------------------------------------------------------------------------
+struct HttpBenchmarkOptions
+{
+    StringView url       = "http://127.0.0.1:8090";
+    StringView mix       = "GET:/";
+    StringView engine    = "auto";
+    StringView jsonPath  = "";
+    StringView directory = "";
+
+    int32_t connections  = 16;
+    int32_t depth        = 1;
+    int32_t rate         = 0; // Requests per second (0 means closed loop)
+    int32_t duration     = 10;
+    int32_t warmup       = 2;
+    int32_t bodySize     = 0;
+    int32_t responseSize = 128;
+    bool    serve        = false;
+};
+
+struct HttpBenchmarkRequest
+{
+    HttpParser::Method method = HttpParser::Method::HttpGET;
+    StringView         methodName;
+    StringView         path;
+    uint32_t           weight = 1;
+
+    String url  = StringEncoding::Ascii; // Absolute url used by the client engine
+    String head = StringEncoding::Ascii; // Request line and headers used by the pipeline engine
+
+    [[nodiscard]] bool hasBody() const
+    {
+        return method == HttpParser::Method::HttpPOST or method == HttpParser::Method::HttpPUT or
+               method == HttpParser::Method::HttpPATCH;
+    }
+};
+
+static bool parseHttpMethod(StringView name, HttpParser::Method& method)
+{
+    struct MethodName
+    {
+        const char*        name;
+        HttpParser::Method method;
+    };
+    static constexpr MethodName methods[] = {
+        {"GET", HttpParser::Method::HttpGET},       {"HEAD", HttpParser::Method::HttpHEAD},
+        {"POST", HttpParser::Method::HttpPOST},     {"PUT", HttpParser::Method::HttpPUT},
+        {"PATCH", HttpParser::Method::HttpPATCH},   {"DELETE", HttpParser::Method::HttpDELETE},
+        {"OPTIONS", HttpParser::Method::HttpOPTIONS},
+    };
+    for (const MethodName& entry : methods)
+    {
+        if (name == StringView::fromNullTerminated(entry.name, StringEncoding::Ascii))
+        {
+            method = entry.method;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Parses a comma separated list of `[METHOD:]/path[*weight]` entries
+static Result parseRequestMix(StringView mix, Span<HttpBenchmarkRequest> requests, size_t& numRequests)
+{
+    numRequests = 0;
+    StringViewTokenizer entries(mix);
+    while (entries.tokenizeNext({','}))
+    {
+        SC_TRY_MSG(numRequests < requests.sizeInElements(), "Too many entries in request mix");
+        HttpBenchmarkRequest& request = requests[numRequests];
+
+        StringViewTokenizer weightSplit(entries.component.trimWhiteSpaces());
+        SC_TRY_MSG(weightSplit.tokenizeNext({'*'}), "Empty request mix entry");
+        StringView target = weightSplit.component;
+        if (weightSplit.tokenizeNext({'*'}))
+        {
+            int32_t weight = 0;
+            SC_TRY_MSG(weightSplit.component.parseInt32(weight) and weight > 0, "Invalid request mix weight");
+            request.weight = static_cast<uint32_t>(weight);
+        }
+
+        request.methodName = "GET";
+        request.method     = HttpParser::Method::HttpGET;
+        if (not target.startsWith("/"))
+        {
+            StringViewTokenizer methodSplit(target);
+            SC_TRY_MSG(methodSplit.tokenizeNext({':'}), "Invalid request mix entry");
+            request.methodName = methodSplit.component;
+            SC_TRY_MSG(parseHttpMethod(request.methodName, request.method), "Unsupported method in request mix");
+            target = methodSplit.remaining;
+        }
+        SC_TRY_MSG(target.startsWith("/"), "Request mix paths must start with '/'");
+        request.path = target;
+        numRequests++;
+    }
+    SC_TRY_MSG(numRequests > 0, "Request mix is empty");
+    return Result(true);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Benchmark state shared by both engines
+//---------------------------------------------------------------------------------------------------------------------
+struct HttpBenchmarkInFlight
+{
+    int64_t                     intendedNs = 0; // When the request should have been sent (by the schedule)
+    int64_t                     sentNs     = 0; // When the request has been actually handed to the socket
+    const HttpBenchmarkRequest* request    = nullptr;
+};
+
+struct HttpClientConnection;
+struct HttpPipelineConnection;
+
+struct HttpBenchmark
+{
+    static constexpr size_t  MaxConnections = 4096;
+    static constexpr size_t  MaxDepth       = 64;
+    static constexpr size_t  MaxRequests    = 16;
+    static constexpr int64_t TickMs         = 1;
+    static constexpr int64_t DrainTimeoutNs = 5'000'000'000;
+
+    enum class Engine : uint8_t
+    {
+        Client,   // One HttpAsyncClient per connection (depth 1)
+        Pipeline, // Raw sockets sending up to `depth` pipelined requests per connection
+    };
+
+    HttpBenchmarkOptions options;
+    AsyncEventLoop*      eventLoop = nullptr;
+    Engine               engine    = Engine::Client;
+
+    HttpURLParser   urlParser;
+    SocketIPAddress address;
+    SocketOptions   socketOptions; // TCP_NODELAY avoids measuring Nagle and delayed ACK interactions
+
+    HttpBenchmarkRequest requests[MaxRequests];
+    size_t               numRequests = 0;
+    uint32_t             totalWeight = 0;
+
+    String requestBody = StringEncoding::Ascii;
+
+    Span<HttpClientConnection>   clientConnections;
+    Span<HttpPipelineConnection> pipelineConnections;
+
+    // Schedule
+    Time::HighResolutionCounter baseCounter;
+    int64_t                     startNs       = 0;
+    int64_t                     warmupEndNs   = 0;
+    int64_t                     endNs         = 0;
+    double                      intervalNs    = 0.0;
+    uint64_t                    nextRequest   = 0;
+    size_t                      nextCandidate = 0;
+    uint64_t                    numInFlight   = 0;
+    bool                        issuing       = false;
+    bool                        finished      = false;
+
+    AsyncLoopTimeout ticker;
+
+    // Results (only requests scheduled after warmup are accounted)
+    LatencyHistogram latency;     // From scheduled time (corrected for coordinated omission)
+    LatencyHistogram serviceTime; // From actual send time
+    uint64_t         statusCounts[6] = {0}; // 1xx, 2xx, 3xx, 4xx, 5xx, other
+    uint64_t         numErrors       = 0;
+    uint64_t         numTimeouts     = 0;
+    uint64_t         bodyBytes       = 0;
+    int64_t          lastCompletedNs = 0;
+    String           firstError      = StringEncoding::Utf8; // Messages of failed results are not stable
+
+    [[nodiscard]] int64_t nowNs() const
+    {
+        Time::HighResolutionCounter now;
+        now.snap();
+        return now.subtractExact(baseCounter).toNanoseconds().ns;
+    }
+
+    [[nodiscard]] bool isOpenLoop() const { return options.rate > 0; }
+
+    [[nodiscard]] const HttpBenchmarkRequest& pickRequest(uint64_t index) const
+    {
+        uint32_t slot = static_cast<uint32_t>(index % totalWeight);
+        for (size_t idx = 0; idx < numRequests; ++idx)
+        {
+            if (slot < requests[idx].weight)
+            {
+                return requests[idx];
+            }
+            slot -= requests[idx].weight;
+        }
+        return requests[0];
+    }
+
+    Result init(AsyncEventLoop& loop);
+    Result start(Span<HttpClientConnection> clients, Span<HttpPipelineConnection> pipelines);
+    void   close();
+
+    void dispatch();
+    void onCompleted(const HttpBenchmarkInFlight& inFlight, uint32_t statusCode, uint64_t numBodyBytes);
+    void onFailed(const HttpBenchmarkInFlight& inFlight, Result error);
+
+  private:
+    template <typename T>
+    void dispatchTo(Span<T> connections);
+    void onTick(AsyncLoopTimeout::Result& result);
+    void finish();
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// Client engine
+//---------------------------------------------------------------------------------------------------------------------
+/// Keep-alive HttpAsyncClient sending one request at a time, with body consumed through its readable stream
+struct HttpClientConnection
+{
+    using Storage = HttpAsyncClientConnection<4, 6, 8 * 1024, 8 * 1024>;
+
+    HttpBenchmark*        benchmark = nullptr;
+    Storage               storage;
+    HttpAsyncClient       client;
+    AsyncLoopTimeout      deferred; // Sends next request outside of the client callbacks stack
+    AsyncReadableStream*  readable = nullptr;
+    HttpBenchmarkInFlight inFlight;
+
+    uint32_t statusCode   = 0;
+    uint64_t numBodyBytes = 0;
+    bool     busy         = false;
+
+    Result init(HttpBenchmark& newBenchmark)
+    {
+        benchmark = &newBenchmark;
+        SC_TRY(client.init(storage));
+        client.setSocketOptions(benchmark->socketOptions);
+        client.onResponse.bind<HttpClientConnection, &HttpClientConnection::onResponse>(*this);
+        client.onError.bind<HttpClientConnection, &HttpClientConnection::onError>(*this);
+        deferred.callback.bind<HttpClientConnection, &HttpClientConnection::onDeferred>(*this);
+        return Result(true);
+    }
+
+    [[nodiscard]] bool canSend() const { return not busy; }
+
+    Result sendRequest(const HttpBenchmarkRequest& request, int64_t intendedNs)
+    {
+        HttpAsyncClient::RequestOptions requestOptions;
+        requestOptions.setRequest(request.method, request.url.view(), true);
+        if (request.hasBody() and not benchmark->requestBody.isEmpty())
+        {
+            requestOptions.setBody(benchmark->requestBody.view());
+        }
+        inFlight.request    = &request;
+        inFlight.intendedNs = intendedNs;
+        inFlight.sentNs     = benchmark->nowNs();
+        statusCode          = 0;
+        numBodyBytes        = 0;
+        busy                = true;
+        return client.sendRequest(*benchmark->eventLoop, requestOptions);
+    }
+
+    void onResponse(HttpAsyncClientResponse& response)
+    {
+        statusCode = response.getParser().statusCode;
+        readable   = &response.getReadableStream();
+        const bool dataAdded =
+            readable->eventData.addListener<HttpClientConnection, &HttpClientConnection::onData>(*this);
+        const bool endAdded = readable->eventEnd.addListener<HttpClientConnection, &HttpClientConnection::onEnd>(*this);
+        if (not dataAdded or not endAdded)
+        {
+            onError(Result::Error("HttpBenchmark failed adding response listeners"));
+        }
+    }
+
+    void onData(AsyncBufferView::ID bufferID)
+    {
+        Span<const char> data;
+        if (readable->getBuffersPool().getReadableData(bufferID, data))
+        {
+            numBodyBytes += data.sizeInBytes();
+        }
+    }
+
+    void onEnd()
+    {
+        (void)readable->eventData.removeListener<HttpClientConnection, &HttpClientConnection::onData>(*this);
+        (void)readable->eventEnd.removeListener<HttpClientConnection, &HttpClientConnection::onEnd>(*this);
+        readable = nullptr;
+        benchmark->onCompleted(inFlight, statusCode, numBodyBytes);
+        release();
+    }
+
+    void onError(Result result)
+    {
+        if (readable != nullptr)
+        {
+            (void)readable->eventData.removeListener<HttpClientConnection, &HttpClientConnection::onData>(*this);
+            (void)readable->eventEnd.removeListener<HttpClientConnection, &HttpClientConnection::onEnd>(*this);
+            readable = nullptr;
+        }
+        benchmark->onFailed(inFlight, result);
+        release();
+    }
+
+    void release()
+    {
+        if (deferred.isFree())
+        {
+            (void)deferred.start(*benchmark->eventLoop, TimeMs{0});
+        }
+    }
+
+    void onDeferred(AsyncLoopTimeout::Result&)
+    {
+        busy = false;
+        benchmark->dispatch();
+    }
+
+    Result close()
+    {
+        if (not deferred.isFree())
+        {
+            (void)deferred.stop(*benchmark->eventLoop);
+        }
+        return client.close();
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// Pipeline engine
+//---------------------------------------------------------------------------------------------------------------------
+/// Keep-alive TCP connection writing up to `depth` requests back-to-back and matching responses in FIFO order.
+/// Response headers are parsed with HttpParser and bodies are skipped using their Content-Length.
+struct HttpPipelineConnection
+{
+    static constexpr size_t MaxHeaderSize = 8 * 1024;
+
+    HttpBenchmark* benchmark = nullptr;
+
+    SocketDescriptor   socket;
+    AsyncSocketConnect connect;
+    AsyncSocketSend    send;
+    AsyncSocketReceive receive;
+
+    HttpBenchmarkInFlight inFlight[HttpBenchmark::MaxDepth];
+
+    uint64_t numQueued    = 0; // Total requests queued on this connection
+    uint64_t numWritten   = 0; // Total requests that have been handed to a socket send
+    uint64_t numCompleted = 0; // Total responses received
+
+    Span<const char> sendBuffers[HttpBenchmark::MaxDepth * 2];
+
+    char     receiveBuffer[16 * 1024];
+    char     headerBuffer[MaxHeaderSize];
+    size_t   headerLength    = 0;
+    uint64_t bodyLength      = 0;
+    uint64_t bodyRemaining   = 0;
+    uint32_t statusCode      = 0;
+    uint8_t  headersEndMatch = 0;
+    bool     readingBody     = false;
+    bool     connected       = false;
+    bool     failed          = false;
+
+    Result init(HttpBenchmark& newBenchmark)
+    {
+        benchmark = &newBenchmark;
+
+        AsyncEventLoop& loop = *benchmark->eventLoop;
+        SC_TRY(loop.createAsyncTCPSocket(benchmark->address.getAddressFamily(), socket, benchmark->socketOptions));
+        connect.callback.bind<HttpPipelineConnection, &HttpPipelineConnection::onConnected>(*this);
+        send.callback.bind<HttpPipelineConnection, &HttpPipelineConnection::onSent>(*this);
+        receive.callback.bind<HttpPipelineConnection, &HttpPipelineConnection::onReceived>(*this);
+        return connect.start(loop, socket, benchmark->address);
+    }
+
+    [[nodiscard]] bool canSend() const
+    {
+        return not failed and numQueued - numCompleted < static_cast<uint64_t>(benchmark->options.depth);
+    }
+
+    Result sendRequest(const HttpBenchmarkRequest& request, int64_t intendedNs)
+    {
+        HttpBenchmarkInFlight& entry = inFlight[numQueued % HttpBenchmark::MaxDepth];
+        entry.request                = &request;
+        entry.intendedNs             = intendedNs;
+        numQueued++;
+        return flush();
+    }
+
+    Result flush()
+    {
+        if (not connected or not send.isFree() or numWritten == numQueued)
+        {
+            return Result(true);
+        }
+        const int64_t now        = benchmark->nowNs();
+        size_t        numBuffers = 0;
+        for (uint64_t idx = numWritten; idx < numQueued; ++idx)
+        {
+            HttpBenchmarkInFlight& entry = inFlight[idx % HttpBenchmark::MaxDepth];
+            entry.sentNs                 = now;
+            sendBuffers[numBuffers++]    = entry.request->head.view().toCharSpan();
+            if (entry.request->hasBody() and not benchmark->requestBody.isEmpty())
+            {
+                sendBuffers[numBuffers++] = benchmark->requestBody.view().toCharSpan();
+            }
+        }
+        numWritten = numQueued;
+        return send.start(*benchmark->eventLoop, socket, {sendBuffers, numBuffers});
+    }
+
+    void onConnected(AsyncSocketConnect::Result& result)
+    {
+        if (not result.isValid())
+        {
+            return fail(result.isValid());
+        }
+        connected = true;
+        Result res = receive.start(*benchmark->eventLoop, socket, {receiveBuffer, sizeof(receiveBuffer)});
+        if (res)
+        {
+            res = flush();
+        }
+        if (not res)
+        {
+            fail(res);
+        }
+    }
+
+    void onSent(AsyncSocketSend::Result& result)
+    {
+        Result res = result.isValid();
+        if (res)
+        {
+            res = flush();
+        }
+        if (not res)
+        {
+            fail(res);
+        }
+    }
+
+    void onReceived(AsyncSocketReceive::Result& result)
+    {
+        Span<char> data;
+        Result     res = result.get(data);
+        if (res and result.isEnded())
+        {
+            res = Result::Error("HttpBenchmark connection closed by server");
+        }
+        if (res)
+        {
+            res = parseResponses({data.data(), data.sizeInBytes()});
+        }
+        if (not res)
+        {
+            return fail(res);
+        }
+        if (not benchmark->finished)
+        {
+            result.reactivateRequest(true);
+        }
+    }
+
+    Result parseResponses(Span<const char> data)
+    {
+        while (not data.empty())
+        {
+            SC_TRY_MSG(numCompleted < numWritten, "HttpBenchmark received unexpected data");
+            if (readingBody)
+            {
+                const size_t toSkip =
+                    bodyRemaining < data.sizeInBytes() ? static_cast<size_t>(bodyRemaining) : data.sizeInBytes();
+                bodyRemaining -= toSkip;
+                SC_TRY(data.sliceStart(toSkip, data));
+            }
+            else
+            {
+                // Copy headers until the terminating empty line, that may be split across multiple reads
+                size_t consumed = 0;
+                bool   foundEnd = false;
+                while (consumed < data.sizeInBytes() and not foundEnd)
+                {
+                    const char current = data[consumed++];
+                    SC_TRY_MSG(headerLength < MaxHeaderSize, "HttpBenchmark response headers are too large");
+                    headerBuffer[headerLength++] = current;
+
+                    static constexpr char Terminator[] = "\r\n\r\n";
+                    headersEndMatch = current == Terminator[headersEndMatch] ? headersEndMatch + 1
+                                                                             : (current == '\r' ? 1 : 0);
+                    foundEnd        = headersEndMatch == 4;
+                }
+                SC_TRY(data.sliceStart(consumed, data));
+                if (not foundEnd)
+                {
+                    break;
+                }
+                SC_TRY(parseHeaders());
+            }
+            if (readingBody and bodyRemaining == 0)
+            {
+                const HttpBenchmarkInFlight& entry = inFlight[numCompleted % HttpBenchmark::MaxDepth];
+                numCompleted++;
+                readingBody = false;
+                benchmark->onCompleted(entry, statusCode, bodyLength);
+            }
+        }
+        if (not benchmark->finished)
+        {
+            SC_TRY(flush());
+        }
+        return Result(true);
+    }
+
+    Result parseHeaders()
+    {
+        HttpParser parser;
+        parser.type = HttpParser::Type::Response;
+
+        Span<const char> headerData = {headerBuffer, headerLength};
+        size_t           readBytes  = 0;
+        while (parser.state != HttpParser::State::Finished)
+        {
+            Span<const char> parsedData;
+            SC_TRY(parser.parse(headerData, readBytes, parsedData));
+            if (parser.state == HttpParser::State::Result and parser.token == HttpParser::Token::HeadersEnd)
+            {
+                break;
+            }
+            SC_TRY_MSG(readBytes > 0 or parser.state == HttpParser::State::Finished, "HttpBenchmark invalid headers");
+            SC_TRY(headerData.sliceStart(readBytes, headerData));
+        }
+        headerLength    = 0;
+        headersEndMatch = 0;
+
+        const HttpBenchmarkInFlight& entry = inFlight[numCompleted % HttpBenchmark::MaxDepth];
+
+        const bool hasNoBody = entry.request->method == HttpParser::Method::HttpHEAD or parser.statusCode == 204 or
+                               parser.statusCode == 304 or parser.statusCode < 200;
+        SC_TRY_MSG(parser.statusCode >= 200, "HttpBenchmark informational responses are not supported");
+
+        statusCode    = parser.statusCode;
+        bodyLength    = hasNoBody ? 0 : parser.contentLength;
+        bodyRemaining = bodyLength;
+        readingBody   = true;
+        return Result(true);
+    }
+
+    void fail(Result error)
+    {
+        if (failed)
+        {
+            return;
+        }
+        failed = true;
+        while (numCompleted < numQueued)
+        {
+            benchmark->onFailed(inFlight[numCompleted % HttpBenchmark::MaxDepth], error);
+            numCompleted++;
+        }
+        benchmark->dispatch();
+    }
+
+    Result close()
+    {
+        if (not receive.isFree())
+        {
+            (void)receive.stop(*benchmark->eventLoop);
+        }
+        if (not connect.isFree())
+        {
+            (void)connect.stop(*benchmark->eventLoop);
+        }
+        if (not send.isFree())
+        {
+            (void)send.stop(*benchmark->eventLoop);
+        }
+        return Result(true);
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// Scheduling
+//---------------------------------------------------------------------------------------------------------------------
+Result HttpBenchmark::init(AsyncEventLoop& loop)
+{
+    eventLoop                = &loop;
+    socketOptions.tcpNoDelay = true;
+    SC_TRY_MSG(urlParser.parse(options.url), "Invalid --url");
+    SC_TRY_MSG(urlParser.protocol == "http", "Only http:// urls are supported");
+    const StringSpan hostname = {urlParser.hostname.toCharSpan(), false, StringEncoding::Ascii};
+    SC_TRY_MSG(address.fromAddressPort(hostname, urlParser.port), "--url host must be an IP address");
+
+    SC_TRY(parseRequestMix(options.mix, requests, numRequests));
+    totalWeight = 0;
+    for (size_t idx = 0; idx < numRequests; ++idx)
+    {
+        HttpBenchmarkRequest& request = requests[idx];
+        totalWeight += request.weight;
+        SC_TRY(StringBuilder::format(request.url, "http://{}{}", urlParser.host, request.path));
+        auto builder = StringBuilder::create(request.head);
+        SC_TRY(builder.append("{} {} HTTP/1.1\r\nHost: {}\r\n", request.methodName, request.path, urlParser.host));
+        if (request.hasBody())
+        {
+            SC_TRY(builder.append("Content-Length: {}\r\n", options.bodySize));
+        }
+        SC_TRY(builder.append("\r\n"));
+        builder.finalize();
+    }
+
+    auto body = StringBuilder::create(requestBody);
+    for (int32_t idx = 0; idx < options.bodySize; ++idx)
+    {
+        SC_TRY(body.append("x"));
+    }
+    body.finalize();
+    return Result(true);
+}
+
+Result HttpBenchmark::start(Span<HttpClientConnection> clients, Span<HttpPipelineConnection> pipelines)
+{
+    clientConnections   = clients;
+    pipelineConnections = pipelines;
+
+    baseCounter.snap();
+    startNs     = 0;
+    warmupEndNs = static_cast<int64_t>(options.warmup) * 1'000'000'000;
+    endNs       = warmupEndNs + static_cast<int64_t>(options.duration) * 1'000'000'000;
+    intervalNs  = isOpenLoop() ? 1e9 / static_cast<double>(options.rate) : 0.0;
+    issuing     = true;
+
+    ticker.callback.bind<HttpBenchmark, &HttpBenchmark::onTick>(*this);
+    SC_TRY(ticker.start(*eventLoop, TimeMs{TickMs}));
+    dispatch();
+    return Result(true);
+}
+
+void HttpBenchmark::onTick(AsyncLoopTimeout::Result& result)
+{
+    dispatch();
+    if (not issuing and numInFlight > 0 and nowNs() > endNs + DrainTimeoutNs)
+    {
+        numTimeouts += numInFlight;
+        numInFlight = 0;
+    }
+    if (not issuing and numInFlight == 0)
+    {
+        finish();
+    }
+    else
+    {
+        result.getAsync().relativeTimeout = TimeMs{TickMs};
+        result.reactivateRequest(true);
+    }
+}
+
+void HttpBenchmark::dispatch()
+{
+    if (engine == Engine::Client)
+    {
+        dispatchTo(clientConnections);
+    }
+    else
+    {
+        dispatchTo(pipelineConnections);
+    }
+}
+
+template <typename T>
+void HttpBenchmark::dispatchTo(Span<T> connections)
+{
+    const int64_t now = nowNs();
+    while (issuing)
+    {
+        if (now >= endNs)
+        {
+            issuing = false;
+            break;
+        }
+        // Open loop sends requests that are due by the schedule, even if late (and then latency accounts for it)
+        int64_t intendedNs = now;
+        if (isOpenLoop())
+        {
+            intendedNs = startNs + static_cast<int64_t>(static_cast<double>(nextRequest) * intervalNs);
+            if (intendedNs > now)
+            {
+                break;
+            }
+        }
+
+        T* connection = nullptr;
+        for (size_t idx = 0; idx < connections.sizeInElements(); ++idx)
+        {
+            T& candidate  = connections[nextCandidate];
+            nextCandidate = (nextCandidate + 1) % connections.sizeInElements();
+            if (candidate.canSend())
+            {
+                connection = &candidate;
+                break;
+            }
+        }
+        if (connection == nullptr)
+        {
+            break; // All connections are busy, backlog will be sent as soon as one is available
+        }
+        const HttpBenchmarkRequest& request = pickRequest(nextRequest);
+        nextRequest++;
+        numInFlight++;
+        Result res = connection->sendRequest(request, intendedNs);
+        if (not res)
+        {
+            HttpBenchmarkInFlight inFlight;
+            inFlight.request    = &request;
+            inFlight.intendedNs = intendedNs;
+            inFlight.sentNs     = intendedNs;
+            onFailed(inFlight, res);
+        }
+    }
+}
+
+void HttpBenchmark::onCompleted(const HttpBenchmarkInFlight& inFlight, uint32_t statusCode, uint64_t numBodyBytes)
+{
+    numInFlight = numInFlight > 0 ? numInFlight - 1 : 0;
+    if (inFlight.intendedNs < warmupEndNs or finished)
+    {
+        return;
+    }
+    const int64_t now = nowNs();
+    latency.record(static_cast<uint64_t>(now - inFlight.intendedNs) / 1000);
+    serviceTime.record(static_cast<uint64_t>(now - inFlight.sentNs) / 1000);
+    statusCounts[statusCode >= 100 and statusCode < 600 ? statusCode / 100 - 1 : 5]++;
+    bodyBytes += numBodyBytes;
+    lastCompletedNs = now;
+}
+
+void HttpBenchmark::onFailed(const HttpBenchmarkInFlight& inFlight, Result error)
+{
+    numInFlight = numInFlight > 0 ? numInFlight - 1 : 0;
+    if (inFlight.intendedNs < warmupEndNs or finished)
+    {
+        return;
+    }
+    numErrors++;
+    if (firstError.isEmpty())
+    {
+        (void)StringBuilder::format(firstError, "{}", error.message);
+    }
+}
+
+void HttpBenchmark::finish()
+{
+    finished = true;
+    close();
+}
+
+void HttpBenchmark::close()
+{
+    for (HttpClientConnection& connection : clientConnections)
+    {
+        (void)connection.close();
+    }
+    for (HttpPipelineConnection& connection : pipelineConnections)
+    {
+        (void)connection.close();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// In-process server (--serve)
+//---------------------------------------------------------------------------------------------------------------------
+/// HttpAsyncServer running on its own thread and event loop, answering with a fixed size body or serving files from
+/// a directory through HttpAsyncFileServer
+struct HttpBenchmarkServer
+{
+    using ServerConnection = HttpAsyncConnection<3, 3, 8 * 1024, 8 * 1024>;
+
+    AsyncEventLoop      eventLoop;
+    HttpAsyncServer     httpServer;
+    HttpAsyncFileServer fileServer;
+    ThreadPool          threadPool;
+    AsyncLoopWakeUp     stopWakeUp;
+    Thread              thread;
+
+    VirtualArray<ServerConnection>                    connections = {HttpBenchmark::MaxConnections};
+    VirtualArray<HttpAsyncFileServer::StreamQueue<3>> fileStreams = {HttpBenchmark::MaxConnections};
+
+    String responseBody  = StringEncoding::Ascii;
+    String contentLength = StringEncoding::Ascii;
+    bool   serveFiles    = false;
+    Result runResult     = Result(true);
+
+    Result start(const HttpBenchmarkOptions& options, uint16_t port)
+    {
+        SC_TRY(eventLoop.create());
+        SC_TRY(connections.resize(static_cast<size_t>(options.connections)));
+        SC_TRY(httpServer.init(connections.toSpan()));
+        SocketOptions socketOptions;
+        socketOptions.tcpNoDelay = true; // Inherited by accepted sockets
+        httpServer.setSocketOptions(socketOptions);
+        SC_TRY(httpServer.start(eventLoop, "127.0.0.1", port));
+
+        serveFiles = not options.directory.isEmpty();
+        if (serveFiles)
+        {
+            SC_TRY(fileStreams.resize(static_cast<size_t>(options.connections)));
+            if (eventLoop.needsThreadPoolForFileOperations())
+            {
+                SC_TRY(threadPool.create(4));
+            }
+            SC_TRY(fileServer.init(threadPool, eventLoop, options.directory));
+        }
+        auto body = StringBuilder::create(responseBody);
+        for (int32_t idx = 0; idx < options.responseSize; ++idx)
+        {
+            SC_TRY(body.append("x"));
+        }
+        body.finalize();
+        SC_TRY(StringBuilder::format(contentLength, "{}", options.responseSize));
+
+        httpServer.onRequest.bind<HttpBenchmarkServer, &HttpBenchmarkServer::onRequest>(*this);
+        stopWakeUp.callback.bind<HttpBenchmarkServer, &HttpBenchmarkServer::onStop>(*this);
+        SC_TRY(stopWakeUp.start(eventLoop));
+        return thread.start([this](Thread& thread)
+                            {
+                                thread.setThreadName(SC_NATIVE_STR("HttpBenchmarkServer"));
+                                runResult = eventLoop.run();
+                            });
+    }
+
+    Result stop()
+    {
+        SC_TRY(stopWakeUp.wakeUp(eventLoop));
+        SC_TRY(thread.join());
+        SC_TRY(runResult);
+        if (serveFiles)
+        {
+            SC_TRY(fileServer.close());
+        }
+        SC_TRY(httpServer.close());
+        if (eventLoop.needsThreadPoolForFileOperations() and serveFiles)
+        {
+            SC_TRY(threadPool.destroy());
+        }
+        return eventLoop.close();
+    }
+
+    void onStop(AsyncLoopWakeUp::Result&) { SC_ASSERT_RELEASE(httpServer.stop()); }
+
+    void onRequest(HttpConnection& connection)
+    {
+        if (serveFiles)
+        {
+            HttpAsyncFileServer::Stream& stream = fileStreams.toSpan()[connection.getConnectionID().getIndex()];
+            SC_ASSERT_RELEASE(fileServer.handleRequest(stream, connection));
+            return;
+        }
+        const bool isHead = connection.request.getParser().method == HttpParser::Method::HttpHEAD;
+        SC_ASSERT_RELEASE(connection.response.startResponse(200));
+        SC_ASSERT_RELEASE(connection.response.addHeader("Content-Length", contentLength.view()));
+        SC_ASSERT_RELEASE(connection.response.sendHeaders());
+        if (not isHead and not responseBody.isEmpty())
+        {
+            SC_ASSERT_RELEASE(connection.response.getWritableStream().write(responseBody.view().toCharSpan()));
+        }
+        SC_ASSERT_RELEASE(connection.response.end());
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// Reporting
+//---------------------------------------------------------------------------------------------------------------------
+struct HttpBenchmarkPercentile
+{
+    const char* name;
+    double      percentile;
+};
+
+static constexpr HttpBenchmarkPercentile benchmarkPercentiles[] = {
+    {"p50", 50.0}, {"p75", 75.0}, {"p90", 90.0}, {"p99", 99.0}, {"p99.9", 99.9}, {"p99.99", 99.99},
+};
+
+static const char* benchmarkEngineName(HttpBenchmark::Engine engine)
+{
+    return engine == HttpBenchmark::Engine::Client ? "client" : "pipeline";
+}
+
+static void printHistogram(Console& console, const char* title, const LatencyHistogram& histogram)
+{
+    console.print("  {} (us): min={} mean={:.2} stddev={:.2} max={}\n", title, histogram.getMin(),
+                  histogram.getMean(), histogram.getStandardDeviation(), histogram.getMax());
+    console.print("   ");
+    for (const HttpBenchmarkPercentile& entry : benchmarkPercentiles)
+    {
+        console.print(" {}={}", entry.name, histogram.getValueAtPercentile(entry.percentile));
+    }
+    console.print("\n");
+}
+
+static Result appendJsonString(StringBuilder& builder, StringView text)
+{
+    SC_TRY(builder.append("\""));
+    for (size_t idx = 0; idx < text.sizeInBytes(); ++idx)
+    {
+        const char current = text.bytesWithoutTerminator()[idx];
+        if (current == '"' or current == '\\')
+        {
+            SC_TRY(builder.append("\\"));
+        }
+        if (static_cast<unsigned char>(current) < 0x20)
+        {
+            SC_TRY(builder.append(" "));
+            continue;
+        }
+        SC_TRY(builder.append(StringView({&current, 1}, false, StringEncoding::Ascii)));
+    }
+    return Result(builder.append("\""));
+}
+
+static Result appendJsonHistogram(StringBuilder& builder, const char* name, const LatencyHistogram& histogram)
+{
+    SC_TRY(builder.append("  \"{}\": {{\"count\": {}, \"min\": {}, \"mean\": {:.2}, \"stddev\": {:.2}, \"max\": {}",
+                          name, histogram.getCount(), histogram.getMin(), histogram.getMean(),
+                          histogram.getStandardDeviation(), histogram.getMax()));
+    for (const HttpBenchmarkPercentile& entry : benchmarkPercentiles)
+    {
+        SC_TRY(builder.append(", \"{}\": {}", entry.name, histogram.getValueAtPercentile(entry.percentile)));
+    }
+    return Result(builder.append("}"));
+}
+
+static Result writeJsonReport(const HttpBenchmark& benchmark, double requestsPerSecond, String& json)
+{
+    const HttpBenchmarkOptions& options = benchmark.options;
+
+    auto builder = StringBuilder::create(json);
+    SC_TRY(builder.append("{\n  \"url\": "));
+    SC_TRY(appendJsonString(builder, options.url));
+    SC_TRY(builder.append(",\n  \"mix\": "));
+    SC_TRY(appendJsonString(builder, options.mix));
+    SC_TRY(builder.append(",\n  \"engine\": \"{}\",\n  \"mode\": \"{}\",\n", benchmarkEngineName(benchmark.engine),
+                          benchmark.isOpenLoop() ? "open" : "closed"));
+    SC_TRY(builder.append("  \"connections\": {},\n  \"depth\": {},\n  \"rate\": {},\n", options.connections,
+                          options.depth, options.rate));
+    SC_TRY(builder.append("  \"durationSeconds\": {},\n  \"warmupSeconds\": {},\n", options.duration, options.warmup));
+    SC_TRY(builder.append("  \"requests\": {},\n  \"errors\": {},\n  \"timeouts\": {},\n",
+                          benchmark.latency.getCount(), benchmark.numErrors, benchmark.numTimeouts));
+    SC_TRY(builder.append("  \"requestsPerSecond\": {:.2},\n  \"bodyBytes\": {},\n", requestsPerSecond,
+                          benchmark.bodyBytes));
+    SC_TRY(builder.append("  \"status\": {{\"1xx\": {}, \"2xx\": {}, \"3xx\": {}, \"4xx\": {}, \"5xx\": {}, "
+                          "\"other\": {}}},\n",
+                          benchmark.statusCounts[0], benchmark.statusCounts[1], benchmark.statusCounts[2],
+                          benchmark.statusCounts[3], benchmark.statusCounts[4], benchmark.statusCounts[5]));
+    SC_TRY(appendJsonHistogram(builder, "latencyMicroseconds", benchmark.latency));
+    SC_TRY(builder.append(",\n"));
+    SC_TRY(appendJsonHistogram(builder, "serviceTimeMicroseconds", benchmark.serviceTime));
+    SC_TRY(builder.append("\n}\n"));
+    return Result(true);
+}
+
+static Result reportBenchmark(Console& console, const HttpBenchmark& benchmark)
+{
+    const HttpBenchmarkOptions& options = benchmark.options;
+
+    const double requestsPerSecond =
+        static_cast<double>(benchmark.latency.getCount()) / static_cast<double>(options.duration);
+
+    console.print("HttpBenchmark {} engine={} mode={} connections={} depth={} rate={} duration={}s warmup={}s\n",
+                  options.url, benchmarkEngineName(benchmark.engine), benchmark.isOpenLoop() ? "open" : "closed",
+                  options.connections, options.depth, options.rate, options.duration, options.warmup);
+    console.print("  requests={} errors={} timeouts={} requestsPerSecond={:.2} bodyBytes={}\n",
+                  benchmark.latency.getCount(), benchmark.numErrors, benchmark.numTimeouts, requestsPerSecond,
+                  benchmark.bodyBytes);
+    console.print("  status: 1xx={} 2xx={} 3xx={} 4xx={} 5xx={} other={}\n", benchmark.statusCounts[0],
+                  benchmark.statusCounts[1], benchmark.statusCounts[2], benchmark.statusCounts[3],
+                  benchmark.statusCounts[4], benchmark.statusCounts[5]);
+    printHistogram(console, "latency", benchmark.latency);
+    printHistogram(console, "service time", benchmark.serviceTime);
+    if (not benchmark.firstError.isEmpty())
+    {
+        console.print("  first error: {}\n", benchmark.firstError);
+    }
+
+    if (not options.jsonPath.isEmpty())
+    {
+        String json = StringEncoding::Ascii;
+        SC_TRY(writeJsonReport(benchmark, requestsPerSecond, json));
+
+        FileDescriptor file;
+        SC_TRY(file.open(options.jsonPath, FileOpen::Write));
+        SC_TRY(file.write(json.view().toCharSpan()));
+        SC_TRY(file.close());
+        console.print("  results written to {}\n", options.jsonPath);
+    }
+    return Result(true);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Main
+//---------------------------------------------------------------------------------------------------------------------
+static Result runHttpBenchmark(int argc, const char* const* argv)
+{
+    Console console;
+    Console::tryAttachingToParentConsole();
+#if !SC_PLATFORM_WINDOWS
+    ::signal(SIGPIPE, SIG_IGN); // Writing to sockets closed by the server must fail with EPIPE instead
+#endif
+
+    HttpBenchmark benchmark; // Histograms take about 400 KB
+
+    HttpBenchmarkOptions& options = benchmark.options;
+
+    CommandLineOption commandLineOptions[13];
+    commandLineOptions[0].longName  = "url";
+    commandLineOptions[0].help      = "Origin to benchmark (http only, host must be an IP address)";
+    commandLineOptions[0].valueName = "URL";
+    commandLineOptions[0].value     = CommandLineValue::stringView(options.url);
+
+    commandLineOptions[1].longName  = "mix";
+    commandLineOptions[1].help      = "Comma separated [METHOD:]/path[*weight] request mix (default GET:/)";
+    commandLineOptions[1].valueName = "MIX";
+    commandLineOptions[1].value     = CommandLineValue::stringView(options.mix);
+
+    commandLineOptions[2].longName  = "connections";
+    commandLineOptions[2].help      = "Number of concurrent keep-alive connections";
+    commandLineOptions[2].valueName = "COUNT";
+    commandLineOptions[2].value     = CommandLineValue::int32(options.connections);
+
+    commandLineOptions[3].longName  = "depth";
+    commandLineOptions[3].help      = "Pipelined requests in flight on each connection (uses the pipeline engine)";
+    commandLineOptions[3].valueName = "COUNT";
+    commandLineOptions[3].value     = CommandLineValue::int32(options.depth);
+
+    commandLineOptions[4].longName  = "rate";
+    commandLineOptions[4].help      = "Open loop constant request rate per second (0 runs closed loop)";
+    commandLineOptions[4].valueName = "RPS";
+    commandLineOptions[4].value     = CommandLineValue::int32(options.rate);
+
+    commandLineOptions[5].longName  = "duration";
+    commandLineOptions[5].help      = "Measured duration in seconds";
+    commandLineOptions[5].valueName = "SECONDS";
+    commandLineOptions[5].value     = CommandLineValue::int32(options.duration);
+
+    commandLineOptions[6].longName  = "warmup";
+    commandLineOptions[6].help      = "Seconds of load sent before measuring";
+    commandLineOptions[6].valueName = "SECONDS";
+    commandLineOptions[6].value     = CommandLineValue::int32(options.warmup);
+
+    commandLineOptions[7].longName  = "body-size";
+    commandLineOptions[7].help      = "Request body bytes for POST, PUT and PATCH entries of the mix";
+    commandLineOptions[7].valueName = "BYTES";
+    commandLineOptions[7].value     = CommandLineValue::int32(options.bodySize);
+
+    commandLineOptions[8].longName  = "engine";
+    commandLineOptions[8].help      = "client (HttpAsyncClient), pipeline (raw sockets) or auto";
+    commandLineOptions[8].valueName = "ENGINE";
+    commandLineOptions[8].value     = CommandLineValue::stringView(options.engine);
+
+    commandLineOptions[9].longName  = "json";
+    commandLineOptions[9].help      = "Write results as JSON to the given file";
+    commandLineOptions[9].valueName = "FILE";
+    commandLineOptions[9].value     = CommandLineValue::stringView(options.jsonPath);
+
+    commandLineOptions[10].longName = "serve";
+    commandLineOptions[10].help     = "Run an in-process HttpAsyncServer on the --url port (on its own thread)";
+    commandLineOptions[10].value    = CommandLineValue::boolean(options.serve);
+
+    commandLineOptions[11].longName  = "directory";
+    commandLineOptions[11].help      = "Serve files from this directory with HttpAsyncFileServer (with --serve)";
+    commandLineOptions[11].valueName = "PATH";
+    commandLineOptions[11].value     = CommandLineValue::stringView(options.directory);
+
+    commandLineOptions[12].longName  = "response-size";
+    commandLineOptions[12].help      = "Response body bytes of the in-process server (with --serve)";
+    commandLineOptions[12].valueName = "BYTES";
+    commandLineOptions[12].value     = CommandLineValue::int32(options.responseSize);
+
+    CommandLineSpec spec;
+    spec.programName = "HttpBenchmark";
+    spec.summary     = "Measure HTTP/1.1 throughput and latency distribution of a server on localhost.";
+    spec.options     = commandLineOptions;
+
+    StringSpan           argumentStorage[32];
+    CommandLineArguments arguments;
+    SC_TRY(arguments.setFromMainArguments(argc, argv, argumentStorage));
+    const CommandLineParseResult parseResult = spec.parse(arguments.values);
+    if (parseResult.status == CommandLineParseResult::Status::HelpRequested)
+    {
+        StringFormatOutput output(StringEncoding::Utf8, console, true);
+        SC_TRY_MSG(spec.writeHelp(output), "Failed writing HttpBenchmark help");
+        console.flush();
+        return Result(true);
+    }
+    if (parseResult.status == CommandLineParseResult::Status::Error)
+    {
+        StringFormatOutput output(StringEncoding::Utf8, console, false);
+        SC_TRY_MSG(spec.writeError(parseResult, output), "Failed writing HttpBenchmark parse error");
+        console.flushStdErr();
+        return Result::Error("Invalid HttpBenchmark arguments");
+    }
+    const int32_t maxConnections = static_cast<int32_t>(HttpBenchmark::MaxConnections);
+    const int32_t maxDepth       = static_cast<int32_t>(HttpBenchmark::MaxDepth);
+    SC_TRY_MSG(options.connections > 0 and options.connections <= maxConnections, "Invalid --connections");
+    SC_TRY_MSG(options.depth > 0 and options.depth <= maxDepth, "--depth must be between 1 and 64");
+    SC_TRY_MSG(options.rate >= 0, "--rate must not be negative");
+    SC_TRY_MSG(options.duration > 0 and options.warmup >= 0, "Invalid --duration or --warmup");
+    SC_TRY_MSG(options.bodySize >= 0 and options.responseSize >= 0, "Invalid --body-size or --response-size");
+    // HttpAsyncServer parses the next request only when new data is received, leaving pipelined ones unanswered
+    SC_TRY_MSG(not options.serve or options.depth == 1, "--serve does not support pipelining (--depth must be 1)");
+
+    if (options.engine == "client")
+    {
+        SC_TRY_MSG(options.depth == 1, "The client engine sends one request at a time (use --engine pipeline)");
+        benchmark.engine = HttpBenchmark::Engine::Client;
+    }
+    else if (options.engine == "pipeline" or (options.engine == "auto" and options.depth > 1))
+    {
+        benchmark.engine = HttpBenchmark::Engine::Pipeline;
+    }
+    else
+    {
+        SC_TRY_MSG(options.engine == "auto", "--engine must be client, pipeline or auto");
+        benchmark.engine = HttpBenchmark::Engine::Client;
+    }
+
+    AsyncEventLoop eventLoop;
+    SC_TRY(eventLoop.create());
+    SC_TRY(benchmark.init(eventLoop));
+
+    HttpBenchmarkServer server;
+    if (options.serve)
+    {
+        SC_TRY(server.start(options, benchmark.urlParser.port));
+    }
+
+    VirtualArray<HttpClientConnection>   clients   = {HttpBenchmark::MaxConnections};
+    VirtualArray<HttpPipelineConnection> pipelines = {HttpBenchmark::MaxConnections};
+    if (benchmark.engine == HttpBenchmark::Engine::Client)
+    {
+        SC_TRY(clients.resize(static_cast<size_t>(options.connections)));
+        for (HttpClientConnection& connection : clients.toSpan())
+        {
+            SC_TRY(connection.init(benchmark));
+        }
+    }
+    else
+    {
+        SC_TRY(pipelines.resize(static_cast<size_t>(options.connections)));
+        for (HttpPipelineConnection& connection : pipelines.toSpan())
+        {
+            SC_TRY(connection.init(benchmark));
+        }
+    }
+    SC_TRY(benchmark.start(clients.toSpan(), pipelines.toSpan()));
+    SC_TRY(eventLoop.run());
+
+    for (HttpPipelineConnection& connection : pipelines.toSpan())
+    {
+        SC_TRY(connection.socket.close());
+    }
+    SC_TRY(eventLoop.close());
+    if (options.serve)
+    {
+        SC_TRY(server.stop());
+    }
+    return reportBenchmark(console, benchmark);
+}
+} // namespace SC
+
+int main(int argc, const char* argv[])
+{
+    SC::Result result = SC::runHttpBenchmark(argc, argv);
+    if (not result)
+    {
+        SC::Console console;
+        SC::Console::tryAttachingToParentConsole();
+        console.print("HttpBenchmark failed: {}\n", result.message);
+        return -1;
+    }
+    return 0;
+}
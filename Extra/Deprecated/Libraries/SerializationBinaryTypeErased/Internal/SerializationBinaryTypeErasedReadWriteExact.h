@@ -40,8 +40,13 @@ struct SerializationBinaryTypeErasedReader
     size_t numberOfOperations = 0; ///< How many read or write operations have been issued so far
     size_t readPosition       = 0; ///< Current read  position in the buffer
 
+    static constexpr bool isCompact = false; ///< Only SerializationBinaryEncoding::Native is supported
+
     SerializationBinaryTypeErasedReader(Span<const char> memory) : memory(memory) {}
 
+    /// @brief Varints are only used by SerializationBinaryEncoding::Compact, that is not supported
+    [[nodiscard]] bool serializeVarint(uint64_t&) { return false; }
+
     [[nodiscard]] bool positionIsAtEnd() const { return readPosition == memory.sizeInBytes(); }
 
     /// @brief Read from buffer into given object
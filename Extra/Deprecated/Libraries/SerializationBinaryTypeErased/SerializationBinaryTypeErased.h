@@ -63,6 +63,8 @@ struct SerializationBinaryTypeErased
     [[nodiscard]] static bool loadVersioned(T& object, Span<const char> buffer, Span<const Reflection::TypeInfo> schema,
                                             SerializationBinaryOptions options = {}, size_t* numberOfReads = nullptr)
     {
+        if (options.encoding != SerializationBinaryEncoding::Native)
+            return false;
         SerializationBinaryTypeErasedReadVersioned loader;
 
         SerializationSchema serializationSchema(schema);
@@ -1 +1,2 @@
 #include "../Libraries/Async/Async.h"
+#include "../Libraries/Async/AsyncDNS.h"
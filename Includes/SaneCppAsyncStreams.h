@@ -1,3 +1,5 @@
+#include "../Libraries/AsyncStreams/AsyncParallelTransformStream.h"
 #include "../Libraries/AsyncStreams/AsyncRequestStreams.h"
 #include "../Libraries/AsyncStreams/AsyncStreams.h"
+#include "../Libraries/AsyncStreams/CodecTransformStreams.h"
 #include "../Libraries/AsyncStreams/ZLibTransformStreams.h"
@@ -1,4 +1,5 @@
 #include "../Libraries/Http/HttpAsyncClient.h"
+#include "../Libraries/Http/HttpAsyncClientPool.h"
 #include "../Libraries/Http/HttpAsyncFileServer.h"
 #include "../Libraries/Http/HttpAsyncServer.h"
 #include "../Libraries/Http/HttpConnection.h"
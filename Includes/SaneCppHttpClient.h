@@ -1,2 +1,3 @@
 #include "../Libraries/HttpClient/HttpClient.h"
 #include "../Libraries/HttpClient/HttpClientAsync.h"
+#include "../Libraries/HttpClient/HttpClientMulti.h"
@@ -360,7 +360,18 @@ SC::Result SC::AsyncSocketConnect::start(AsyncEventLoop& eventLoop, const Socket
 {
     SC_TRY(checkState());
     SC_TRY(descriptor.get(handle, SC::Result::Error("Invalid handle")));
-    ipAddress = address;
+    ipAddress    = address;
+    fastOpenData = {};
+    return eventLoop.start(*this);
+}
+
+SC::Result SC::AsyncSocketConnect::start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor,
+                                         SocketIPAddress address, Span<const char> data)
+{
+    SC_TRY(checkState());
+    SC_TRY(descriptor.get(handle, SC::Result::Error("Invalid handle")));
+    ipAddress    = address;
+    fastOpenData = data;
     return eventLoop.start(*this);
 }
 
@@ -411,6 +422,7 @@ SC::Result SC::AsyncSocketSendTo::start(AsyncEventLoop& eventLoop, const SocketD
     buffer       = data;
     singleBuffer = true;
     address      = ipAddress;
+    datagrams    = {};
     return eventLoop.start(*this);
 }
 
@@ -421,11 +433,32 @@ SC::Result SC::AsyncSocketSendTo::start(AsyncEventLoop& eventLoop, const SocketD
     buffers      = data;
     singleBuffer = false;
     address      = ipAddress;
+    datagrams    = {};
+    return eventLoop.start(*this);
+}
+
+SC::Result SC::AsyncSocketSendTo::start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor,
+                                        Span<const Datagram> data)
+{
+    SC_TRY(descriptor.get(handle, SC::Result::Error("Invalid handle")));
+    SC_TRY_MSG(not data.empty(), "AsyncSocketSendTo - Zero datagrams");
+    datagrams = data;
     return eventLoop.start(*this);
 }
 
 SC::Result SC::AsyncSocketSendTo::validate(AsyncEventLoop& eventLoop)
 {
+    numDatagramsSent = 0;
+    if (not datagrams.empty())
+    {
+#if SC_PLATFORM_WINDOWS
+        return SC::Result::Error("AsyncSocketSendTo - Batched datagrams are not supported on Windows");
+#else
+        SC_TRY_MSG(handle != SocketDescriptor::Invalid, "AsyncSocketSendTo - Invalid handle");
+        totalBytesWritten = 0;
+        return SC::Result(true);
+#endif
+    }
     SC_TRY(AsyncSocketSend::validate(eventLoop))
     return SC::Result(true);
 }
@@ -437,6 +470,27 @@ SC::Result SC::AsyncSocketReceive::start(AsyncEventLoop& eventLoop, const Socket
     return eventLoop.start(*this);
 }
 
+SC::Result SC::AsyncSocketReceiveFrom::start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor,
+                                             Span<char> data)
+{
+    datagrams = {};
+    return AsyncSocketReceive::start(eventLoop, descriptor, data);
+}
+
+SC::Result SC::AsyncSocketReceiveFrom::start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor,
+                                             Span<Datagram> data)
+{
+    SC_TRY(descriptor.get(handle, SC::Result::Error("Invalid handle")));
+    SC_TRY_MSG(not data.empty(), "AsyncSocketReceiveFrom - Zero datagrams");
+#if SC_PLATFORM_WINDOWS
+    return SC::Result::Error("AsyncSocketReceiveFrom - Batched datagrams are not supported on Windows");
+#else
+    datagrams = data;
+    buffer    = {};
+    return eventLoop.start(*this);
+#endif
+}
+
 SC::SocketIPAddress SC::AsyncSocketReceive::Result::getSourceAddress() const
 {
     if (getAsync().getType() == Type::SocketReceiveFrom)
@@ -446,6 +500,16 @@ SC::SocketIPAddress SC::AsyncSocketReceive::Result::getSourceAddress() const
     return SocketIPAddress();
 }
 
+SC::Span<SC::AsyncSocketReceiveDatagram> SC::AsyncSocketReceive::Result::getDatagrams() const
+{
+    if (getAsync().getType() == Type::SocketReceiveFrom)
+    {
+        Span<AsyncSocketReceiveDatagram> datagrams = static_cast<const AsyncSocketReceiveFrom&>(getAsync()).datagrams;
+        return {datagrams.data(), completionData.numDatagrams};
+    }
+    return {};
+}
+
 SC::Result SC::AsyncSocketReceive::validate(AsyncEventLoop&)
 {
     SC_TRY_MSG(handle != SocketDescriptor::Invalid, "AsyncSocketReceive - Invalid handle");
@@ -520,18 +584,20 @@ SC::Result SC::AsyncFileWrite::validate(AsyncEventLoop& eventLoop)
     return SC::Result(true);
 }
 
-SC::Result SC::AsyncFileReadiness::start(AsyncEventLoop& eventLoop, FileDescriptor::Handle fd)
+SC::Result SC::AsyncFileReadiness::start(AsyncEventLoop& eventLoop, FileDescriptor::Handle fd, Mode mode)
 {
 #if SC_PLATFORM_WINDOWS
     (void)eventLoop;
     (void)fd;
+    (void)mode;
     // Windows IOCP is completion-based and does not provide generic file-handle readiness.
     // Do not emulate this with timer polling. If socket readiness is needed later, add a
     // dedicated AsyncSocketReadiness using AFD poll / socket-specific mechanisms.
     return SC::Result::Error("AsyncFileReadiness is not supported on Windows");
 #else
     SC_TRY(checkState());
-    handle = fd;
+    handle     = fd;
+    this->mode = mode;
     return eventLoop.start(*this);
 #endif
 }
@@ -981,6 +1047,24 @@ SC::Result SC::AsyncEventLoop::createAsyncUDPSocket(SocketFlags::AddressFamily f
     return associateExternallyCreatedSocket(outDescriptor);
 }
 
+SC::Result SC::AsyncEventLoop::createAsyncTCPSocket(SocketFlags::AddressFamily family, SocketDescriptor& outDescriptor,
+                                                   const SocketOptions& options)
+{
+    SC_TRY(outDescriptor.create(family, SocketFlags::SocketStream, SocketFlags::ProtocolTcp, SocketFlags::NonBlocking,
+                                SocketFlags::NonInheritable));
+    SC_TRY(outDescriptor.setOptions(options));
+    return associateExternallyCreatedSocket(outDescriptor);
+}
+
+SC::Result SC::AsyncEventLoop::createAsyncUDPSocket(SocketFlags::AddressFamily family, SocketDescriptor& outDescriptor,
+                                                   const SocketOptions& options)
+{
+    SC_TRY(outDescriptor.create(family, SocketFlags::SocketDgram, SocketFlags::ProtocolUdp, SocketFlags::NonBlocking,
+                                SocketFlags::NonInheritable));
+    SC_TRY(outDescriptor.setOptions(options));
+    return associateExternallyCreatedSocket(outDescriptor);
+}
+
 SC::Result SC::AsyncEventLoop::wakeUpFromExternalThread()
 {
     if (not internal.wakeUpPending.exchange(true))
@@ -2580,3 +2664,8 @@ void SC::detail::AsyncCompletionVariant::destroy()
     case AsyncRequest::Type::FileSystemOperation: dtor(completionDataFileSystemOperation); break;
     }
 }
+
+//-------------------------------------------------------------------------------------------------------
+// AsyncDNSResolver / AsyncDNSQuery
+//-------------------------------------------------------------------------------------------------------
+#include "Internal/AsyncDNS.inl"
@@ -610,32 +610,76 @@ struct SC_ASYNC_EXPORT AsyncSocketAccept : public detail::AsyncSocketAcceptBase
 /// Alternatively SC::AsyncEventLoop::createAsyncTCPSocket creates and associates the socket to the loop.
 ///
 /// \snippet Tests/Libraries/Async/AsyncTest.cpp AsyncSocketConnectSnippet
+///
+/// Some data can be passed to start, to be sent in the SYN segment through TCP Fast Open, saving one round trip.
+/// This happens on Linux when a Fast Open cookie for the server is cached (so not on the first connection), and on
+/// Windows when SocketDescriptor::setTcpFastOpen has been called before connecting (ConnectEx sends the data right
+/// after connecting otherwise). Other platforms just connect.
+/// CompletionData::numBytes tells how much data has been sent, so that the remaining part (all of it when Fast Open
+/// has not been used) can be sent with AsyncSocketSend after connecting.
+///
+/// \snippet Tests/Libraries/Async/AsyncTestSocketTCP.inl AsyncSocketConnectFastOpenSnippet
 struct SC_ASYNC_EXPORT AsyncSocketConnect : public AsyncRequest
 {
     AsyncSocketConnect() : AsyncRequest(Type::SocketConnect) {}
 
-    using CompletionData = AsyncCompletionData;
-    using Result         = AsyncResultOf<AsyncSocketConnect, CompletionData>;
+    /// @brief Completion data for AsyncSocketConnect
+    struct CompletionData : public AsyncCompletionData
+    {
+        size_t numBytes = 0; ///< Bytes of AsyncSocketConnect::fastOpenData sent while connecting
+    };
+
+    using Result = AsyncResultOf<AsyncSocketConnect, CompletionData>;
     using AsyncRequest::start;
 
     /// @brief Sets async request members and calls AsyncEventLoop::start
     SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, SocketIPAddress address);
 
+    /// @brief Sets async request members and calls AsyncEventLoop::start, sending data along with the connection
+    /// @param eventLoop The event loop
+    /// @param descriptor A TCP socket associated with the event loop
+    /// @param address Address to connect to
+    /// @param data Data to send in the SYN segment when TCP Fast Open is available (must be valid until completion)
+    SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, SocketIPAddress address,
+                     Span<const char> data);
+
     Function<void(Result&)> callback; ///< Called after socket is finally connected to endpoint
 
     SocketDescriptor::Handle handle = SocketDescriptor::Invalid;
     SocketIPAddress          ipAddress;
+    Span<const char>         fastOpenData; ///< Data to be sent through TCP Fast Open (can be empty)
 
   private:
     friend struct AsyncEventLoop;
     SC::Result validate(AsyncEventLoop&);
 
+    size_t numBytesSent = 0; // Bytes of fastOpenData accepted by the kernel when sending the SYN
+
 #if SC_PLATFORM_WINDOWS
     void (*pConnectEx)() = nullptr;
     detail::WinOverlappedOpaque overlapped;
 #endif
 };
 
+/// @brief A single datagram sent by the batched AsyncSocketSendTo::start
+struct AsyncSocketSendDatagram
+{
+    Span<const char> data;    ///< Payload of the datagram
+    SocketIPAddress  address; ///< Destination of the datagram
+};
+
+/// @brief Storage for a single datagram received by the batched AsyncSocketReceiveFrom::start
+struct AsyncSocketReceiveDatagram
+{
+    Span<char>      buffer;          ///< Writeable memory where the datagram payload will be written
+    size_t          numBytes    = 0; ///< Size of the received payload
+    size_t          segmentSize = 0; ///< Size of coalesced segments (`UDP_GRO`), or zero if not coalesced
+    SocketIPAddress address;         ///< Source of the datagram
+
+    /// @brief Get a Span of the actually received payload
+    Span<const char> data() const { return {buffer.data(), numBytes}; }
+};
+
 /// @brief Starts a socket send operation, sending bytes to a remote endpoint.
 /// Callback will be called when the given socket is ready to send more data. @n
 /// @ref library_socket library can be used to create a Socket but the socket should be created with
@@ -694,6 +738,8 @@ struct SC_ASYNC_EXPORT AsyncSocketSendTo : public AsyncSocketSend
 {
     AsyncSocketSendTo() : AsyncSocketSend(Type::SocketSendTo) {}
 
+    using Datagram = AsyncSocketSendDatagram;
+
     SocketIPAddress address;
 
     SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, SocketIPAddress ipAddress,
@@ -702,10 +748,25 @@ struct SC_ASYNC_EXPORT AsyncSocketSendTo : public AsyncSocketSend
     SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, SocketIPAddress ipAddress,
                      Span<Span<const char>> data);
 
+    /// @brief Sends all the given datagrams, each one to its own destination, with as few syscalls as possible.
+    /// Callback is invoked once all datagrams have been sent, with CompletionData::numBytes set to their total size.
+    /// @note Uses `sendmmsg` on Linux (also when `io_uring` is in use), a loop of `sendto` on other Posix systems and
+    /// it's not supported on Windows.
+    SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, Span<const Datagram> datagrams);
+
+    Span<const Datagram> datagrams; ///< Datagrams to send (batched mode, when not empty)
+
+    /// @brief Coalesces consecutive datagrams with the same destination and size in a single Generic Segmentation
+    /// Offload send (`UDP_SEGMENT`), letting the kernel (or the NIC) split them. Only the last datagram of each run
+    /// can be smaller. Requires Linux 4.18+ and is ignored on other systems.
+    bool segmentationOffload = false;
+
   private:
     using AsyncSocketSend::start;
     friend struct AsyncEventLoop;
     SC::Result validate(AsyncEventLoop&);
+
+    size_t numDatagramsSent = 0;
 #if SC_PLATFORM_LINUX
     AlignedStorage<56> typeErasedMsgHdr;
 #endif
@@ -729,6 +790,7 @@ struct SC_ASYNC_EXPORT AsyncSocketReceive : public AsyncRequest
     struct CompletionData : public AsyncCompletionData
     {
         size_t numBytes     = 0;
+        size_t numDatagrams = 0; ///< Datagrams received by the batched AsyncSocketReceiveFrom::start
         bool   disconnected = false;
     };
 
@@ -748,6 +810,9 @@ struct SC_ASYNC_EXPORT AsyncSocketReceive : public AsyncRequest
         }
 
         SocketIPAddress getSourceAddress() const;
+
+        /// @brief Get datagrams received by the batched AsyncSocketReceiveFrom::start (empty otherwise)
+        Span<AsyncSocketReceiveDatagram> getDatagrams() const;
     };
     using AsyncRequest::start;
 
@@ -782,7 +847,22 @@ struct SC_ASYNC_EXPORT AsyncSocketReceive : public AsyncRequest
 struct SC_ASYNC_EXPORT AsyncSocketReceiveFrom : public AsyncSocketReceive
 {
     AsyncSocketReceiveFrom() : AsyncSocketReceive(Type::SocketReceiveFrom) {}
-    using AsyncSocketReceive::start;
+    using AsyncRequest::start;
+
+    using Datagram = AsyncSocketReceiveDatagram;
+
+    /// @brief Sets async request members and calls AsyncEventLoop::start
+    SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, Span<char> data);
+
+    /// @brief Receives as many datagrams as available (up to the number of given ones) with as few syscalls as
+    /// possible. Callback is invoked with CompletionData::numDatagrams set to the number of datagrams filled.
+    /// When SocketDescriptor::setUdpReceiveOffload is enabled the kernel can coalesce datagrams from the same
+    /// source in a single one, that can be split in Datagram::segmentSize sized segments (the last one can be shorter).
+    /// @note Uses `recvmmsg` on Linux (also when `io_uring` is in use), a loop of `recvfrom` on other Posix systems
+    /// and it's not supported on Windows.
+    SC::Result start(AsyncEventLoop& eventLoop, const SocketDescriptor& descriptor, Span<Datagram> datagrams);
+
+    Span<Datagram> datagrams; ///< Datagrams to receive (batched mode, when not empty)
 
   private:
     SocketIPAddress address;
@@ -979,8 +1059,15 @@ struct SC_ASYNC_EXPORT AsyncFileReadiness : public AsyncRequest
     using CompletionData = AsyncCompletionData;
     using Result         = AsyncResultOf<AsyncFileReadiness, CompletionData>;
 
+    /// @brief Readiness event to be monitored
+    enum class Mode : uint8_t
+    {
+        Readable, ///< Descriptor can be read without blocking (or it has been closed on the other side)
+        Writable, ///< Descriptor can be written without blocking
+    };
+
     /// Starts a file descriptor poll operation, monitoring its readiness with appropriate OS API
-    SC::Result start(AsyncEventLoop& eventLoop, FileDescriptor::Handle fileDescriptor);
+    SC::Result start(AsyncEventLoop& eventLoop, FileDescriptor::Handle fileDescriptor, Mode mode = Mode::Readable);
 
     Function<void(Result&)> callback;
 
@@ -989,6 +1076,7 @@ struct SC_ASYNC_EXPORT AsyncFileReadiness : public AsyncRequest
     SC::Result validate(AsyncEventLoop&);
 
     FileDescriptor::Handle handle = FileDescriptor::Invalid;
+    Mode                   mode   = Mode::Readable;
 };
 
 /// @brief Integrates externally-submitted completion based operations with AsyncEventLoop.
@@ -1601,9 +1689,18 @@ struct SC_ASYNC_EXPORT AsyncEventLoop
     /// @brief Creates an async TCP (IPV4 / IPV6) socket registered with the eventLoop
     Result createAsyncTCPSocket(SocketFlags::AddressFamily family, SocketDescriptor& outDescriptor);
 
+    /// @brief Creates an async TCP (IPV4 / IPV6) socket registered with the eventLoop, applying the given options
+    /// @note Options are applied before binding or connecting, as required by SO_REUSEPORT and TCP_FASTOPEN
+    Result createAsyncTCPSocket(SocketFlags::AddressFamily family, SocketDescriptor& outDescriptor,
+                                const SocketOptions& options);
+
     /// @brief Creates an async UCP (IPV4 / IPV6) socket registered with the eventLoop
     Result createAsyncUDPSocket(SocketFlags::AddressFamily family, SocketDescriptor& outDescriptor);
 
+    /// @brief Creates an async UCP (IPV4 / IPV6) socket registered with the eventLoop, applying the given options
+    Result createAsyncUDPSocket(SocketFlags::AddressFamily family, SocketDescriptor& outDescriptor,
+                                const SocketOptions& options);
+
     /// @brief Associates a previously created TCP / UDP socket with the eventLoop
     Result associateExternallyCreatedSocket(SocketDescriptor& outDescriptor);
 
@@ -0,0 +1,199 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "Async.h"
+
+namespace SC
+{
+struct AsyncDNSQuery;
+
+//! @addtogroup group_async
+//! @{
+
+/// @brief Options for SC::AsyncDNSResolver::init
+struct AsyncDNSResolverOptions
+{
+    StringSpan resolvConfPath = "/etc/resolv.conf"; ///< Nameservers configuration (empty to skip)
+    StringSpan hostsPath      = "/etc/hosts";       ///< Static host table (empty to skip)
+
+    TimeMs   timeout         = TimeMs{5000}; ///< Time waited for an answer before retrying (`options timeout:n`)
+    uint32_t attempts        = 2;            ///< Number of rounds over the nameservers (`options attempts:n`)
+    TimeMs   resolutionDelay = TimeMs{50};   ///< Time waited for `AAAA` after a positive `A` answer (RFC 8305)
+    uint32_t maxTTLSeconds   = 86400;        ///< Upper bound for the TTL of cached entries
+};
+
+/// @brief Non-blocking DNS resolver sending UDP queries through the event loop, with a TTL-respecting cache.
+///
+/// Nameservers and resolver options (`timeout:n` and `attempts:n`) are read from `/etc/resolv.conf` during
+/// AsyncDNSResolver::init, while `/etc/hosts` is looked up (synchronously, as it's a small local file) on every cache
+/// miss before querying nameservers. Explicit nameservers (optionally on a non-standard port) can be added with
+/// AsyncDNSResolver::addNameserver.
+///
+/// `A` and `AAAA` queries are sent in parallel following Happy Eyeballs v2 (RFC 8305): a positive `AAAA` answer
+/// completes the resolution immediately, while a positive `A` answer waits at most
+/// AsyncDNSResolverOptions::resolutionDelay for the `AAAA` one.
+/// Resolved addresses are interleaved by family, starting with IPv6.
+///
+/// Resolutions where both families have been answered are stored in the caller-provided cache for the minimum TTL of
+/// the returned records, replacing expired or least recently used entries when the cache is full.
+///
+/// @note Nameservers with an address family different from the first one are ignored.
+/// @note `search` and `ndots` options of `resolv.conf` are not supported, so hosts must be fully qualified.
+///
+/// Example:
+/// \snippet Tests/Libraries/Async/AsyncDNSTest.cpp AsyncDNSResolverSnippet
+struct SC_ASYNC_EXPORT AsyncDNSResolver
+{
+    static constexpr size_t MaxNameservers = 3;   ///< Same limit of glibc resolver (MAXNS)
+    static constexpr size_t MaxAddresses   = 8;   ///< Maximum number of addresses returned by a resolution
+    static constexpr size_t MaxHostLength  = 253; ///< Maximum length of a fully qualified domain name
+
+    using Options = AsyncDNSResolverOptions;
+
+    /// @brief Caller-provided storage for a cached resolution
+    struct CacheEntry
+    {
+      private:
+        friend struct AsyncDNSResolver;
+        friend struct AsyncDNSQuery;
+
+        char    host[MaxHostLength + 1] = {0};
+        uint8_t hostLength              = 0;
+        uint8_t numAddresses            = 0;
+        TimeMs  expiration; // Absolute loop time after which the entry is stale
+        TimeMs  lastUsed;
+
+        SocketIPAddress addresses[MaxAddresses];
+    };
+
+    /// @brief Initializes the resolver, reading nameservers and options from Options::resolvConfPath
+    /// @param loop The event loop where queries will be run
+    /// @param cache Storage for cached resolutions (can be empty to disable caching)
+    /// @param options Resolver options
+    /// @note A missing resolv.conf is not an error, as nameservers can still be added with addNameserver
+    Result init(AsyncEventLoop& loop, Span<CacheEntry> cache = {}, Options options = {});
+
+    /// @brief Adds a nameserver to the ones read from resolv.conf (that are tried first)
+    /// @param address Nameserver address, including port (usually 53)
+    Result addNameserver(SocketIPAddress address);
+
+    /// @brief Removes all nameservers (including the ones read from resolv.conf)
+    void clearNameservers() { numNameservers = 0; }
+
+    /// @brief Returns the nameservers in use
+    [[nodiscard]] Span<const SocketIPAddress> getNameservers() const { return {nameservers, numNameservers}; }
+
+    /// @brief Returns options in use (after applying the ones read from resolv.conf)
+    [[nodiscard]] const Options& getOptions() const { return options; }
+
+    /// @brief Drops all cached resolutions
+    void clearCache();
+
+    /// @brief Releases references to the event loop and cache
+    Result close();
+
+  private:
+    friend struct AsyncDNSQuery;
+    struct Internal;
+
+    AsyncEventLoop*  eventLoop = nullptr;
+    Span<CacheEntry> cache;
+    Options          options;
+
+    SocketIPAddress nameservers[MaxNameservers];
+    size_t          numNameservers = 0;
+    uint32_t        randomState    = 0;
+};
+
+/// @brief A caller-owned DNS resolution, run by an AsyncDNSResolver.
+/// Like any AsyncRequest it must stay at a stable address until its callback has been invoked.
+/// The callback is always invoked asynchronously (also for cache hits, `/etc/hosts` entries and IP literals), after
+/// all internal requests have been released, so the query can be started again from inside its callback.
+struct SC_ASYNC_EXPORT AsyncDNSQuery
+{
+    struct Result
+    {
+        Result(AsyncDNSQuery& query, SC::Result returnCode) : query(query), returnCode(returnCode) {}
+
+        AsyncDNSQuery& query;
+        SC::Result     returnCode; ///< Valid if at least one address has been resolved
+
+        /// @brief Resolved addresses, with their port set to the one passed to AsyncDNSQuery::start
+        [[nodiscard]] Span<const SocketIPAddress> getAddresses() const { return query.getAddresses(); }
+
+        [[nodiscard]] bool isFromCache() const { return query.fromCache; }
+    };
+
+    Function<void(Result&)> callback; ///< Called when resolution completes or fails
+
+    /// @brief Starts resolving the given host
+    /// @param resolver An initialized resolver
+    /// @param host ASCII host name (or IPv4 / IPv6 literal) to resolve (copied)
+    /// @param port Port assigned to all resolved addresses
+    SC::Result start(AsyncDNSResolver& resolver, StringSpan host, uint16_t port = 0);
+
+    /// @brief Cancels an in-progress resolution, without invoking the callback
+    SC::Result stop();
+
+    /// @brief Returns addresses resolved by last completed query (valid until the query is started again)
+    [[nodiscard]] Span<const SocketIPAddress> getAddresses() const { return {addresses, numAddresses}; }
+
+    /// @brief Returns `true` if the query is not running and can be started
+    [[nodiscard]] bool isFree() const { return phase == Phase::Free; }
+
+  private:
+    friend struct AsyncDNSResolver;
+    struct Internal;
+
+    enum class Phase : uint8_t
+    {
+        Free,       // Not started
+        Completing, // Result is known, waiting for the deferred callback
+        Querying,   // Waiting for answers from nameservers
+        Stopping,   // Waiting for internal requests to be stopped before invoking the callback
+    };
+
+    static constexpr size_t MaxPacketSize = 512; // Classic DNS over UDP payload limit (no EDNS0)
+    static constexpr size_t MaxQuerySize  = 12 + AsyncDNSResolver::MaxHostLength + 2 + 4;
+
+    AsyncDNSResolver* resolver = nullptr;
+
+    SocketDescriptor       socket;
+    AsyncSocketSendTo      sendA;
+    AsyncSocketSendTo      sendAAAA;
+    AsyncSocketReceiveFrom receive;
+    AsyncLoopTimeout       timeout; // Retry timeout, also used to defer immediate results
+    AsyncLoopTimeout       delay;   // Happy Eyeballs resolution delay
+
+    Function<void(AsyncResult&)> onStopped;
+
+    SocketIPAddress addresses[AsyncDNSResolver::MaxAddresses];
+    SocketIPAddress nameserver; // Nameserver that has been sent the last queries
+
+    char host[AsyncDNSResolver::MaxHostLength + 1] = {0};
+    char queryPacketA[MaxQuerySize];
+    char queryPacketAAAA[MaxQuerySize];
+    char responsePacket[MaxPacketSize];
+
+    SC::Result completionResult = SC::Result(true);
+
+    uint32_t minTTL          = 0;
+    uint16_t port            = 0;
+    uint16_t idA             = 0;
+    uint16_t idAAAA          = 0;
+    uint16_t querySize       = 0;
+    uint8_t  hostLength      = 0;
+    uint8_t  numAddresses    = 0;
+    uint8_t  numAddressesV4  = 0;
+    uint8_t  numAddressesV6  = 0;
+    uint8_t  attempt         = 0;
+    uint8_t  pendingStops    = 0;
+    bool     answeredA       = false;
+    bool     answeredAAAA    = false;
+    bool     fromCache       = false;
+    bool     notifyOnStopped = true;
+    Phase    phase           = Phase::Free;
+};
+
+//! @}
+} // namespace SC
@@ -0,0 +1,892 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "../AsyncDNS.h"
+
+#include <string.h> // memcpy / memmove
+
+//-------------------------------------------------------------------------------------------------------
+// AsyncDNSResolver::Internal
+//-------------------------------------------------------------------------------------------------------
+struct SC::AsyncDNSResolver::Internal
+{
+    static constexpr uint16_t TypeA    = 1;
+    static constexpr uint16_t TypeAAAA = 28;
+    static constexpr uint16_t ClassIN  = 1;
+
+    static constexpr uint16_t FlagResponse         = 0x8000;
+    static constexpr uint16_t FlagRecursionDesired = 0x0100;
+    static constexpr uint16_t MaskResponseCode     = 0x000F;
+    static constexpr uint16_t CodeNameError        = 3;
+
+    // Reads a text file line by line through a fixed buffer, skipping lines longer than the buffer
+    struct LineReader
+    {
+        FileDescriptor file;
+
+        char   buffer[1024];
+        size_t start     = 0;
+        size_t end       = 0;
+        bool   endOfFile = false;
+        bool   skipping  = false;
+
+        bool next(StringSpan& line)
+        {
+            for (;;)
+            {
+                for (size_t idx = start; idx < end; ++idx)
+                {
+                    if (buffer[idx] == '\n')
+                    {
+                        const bool skipLine = skipping;
+                        line                = StringSpan({buffer + start, idx - start}, false, StringEncoding::Ascii);
+                        start               = idx + 1;
+                        skipping            = false;
+                        if (not skipLine)
+                        {
+                            return true;
+                        }
+                        idx = start - 1;
+                    }
+                }
+                if (endOfFile)
+                {
+                    if (start < end and not skipping)
+                    {
+                        line  = StringSpan({buffer + start, end - start}, false, StringEncoding::Ascii);
+                        start = end;
+                        return true;
+                    }
+                    return false;
+                }
+                if (start == 0 and end == sizeof(buffer))
+                {
+                    end      = 0; // Line is too long, drop what has been read so far and the rest of it
+                    skipping = true;
+                }
+                ::memmove(buffer, buffer + start, end - start);
+                end -= start;
+                start = 0;
+
+                Span<char> readData;
+                if (not file.read({buffer + end, sizeof(buffer) - end}, readData) or readData.empty())
+                {
+                    endOfFile = true;
+                }
+                else
+                {
+                    end += readData.sizeInBytes();
+                }
+            }
+        }
+    };
+
+    // Splits a line into whitespace separated tokens, stopping at comments
+    struct TokenIterator
+    {
+        const char* it;
+        const char* end;
+
+        TokenIterator(StringSpan line) : it(line.bytesWithoutTerminator()), end(it + line.sizeInBytes()) {}
+
+        bool next(StringSpan& token)
+        {
+            while (it < end and (*it == ' ' or *it == '\t' or *it == '\r'))
+            {
+                it++;
+            }
+            if (it == end or *it == '#' or *it == ';')
+            {
+                return false;
+            }
+            const char* tokenStart = it;
+            while (it < end and *it != ' ' and *it != '\t' and *it != '\r' and *it != '#')
+            {
+                it++;
+            }
+            token = StringSpan({tokenStart, static_cast<size_t>(it - tokenStart)}, false, StringEncoding::Ascii);
+            return true;
+        }
+    };
+
+    static char toLower(char c) { return c >= 'A' and c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    static bool equalsIgnoreCase(StringSpan first, StringSpan second)
+    {
+        if (first.sizeInBytes() != second.sizeInBytes())
+        {
+            return false;
+        }
+        const char* a = first.bytesWithoutTerminator();
+        const char* b = second.bytesWithoutTerminator();
+        for (size_t idx = 0; idx < first.sizeInBytes(); ++idx)
+        {
+            if (toLower(a[idx]) != toLower(b[idx]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool startsWith(StringSpan text, StringSpan prefix, StringSpan& remaining)
+    {
+        const size_t prefixLength = prefix.sizeInBytes();
+        if (text.sizeInBytes() < prefixLength or
+            ::memcmp(text.bytesWithoutTerminator(), prefix.bytesWithoutTerminator(), prefixLength) != 0)
+        {
+            return false;
+        }
+        remaining = StringSpan({text.bytesWithoutTerminator() + prefixLength, text.sizeInBytes() - prefixLength}, false,
+                               StringEncoding::Ascii);
+        return true;
+    }
+
+    static bool parseUnsigned(StringSpan text, uint32_t& value)
+    {
+        value = 0;
+        for (char c : text.toCharSpan())
+        {
+            if (c < '0' or c > '9' or value > 100000)
+            {
+                return false;
+            }
+            value = value * 10 + static_cast<uint32_t>(c - '0');
+        }
+        return not text.isEmpty();
+    }
+
+    // Parses an IPv4 / IPv6 literal, ignoring IPv6 zone identifiers (`fe80::1%eth0`)
+    static bool parseAddress(StringSpan text, uint16_t port, SocketIPAddress& address)
+    {
+        size_t length = 0;
+        for (char c : text.toCharSpan())
+        {
+            if (c == '%')
+            {
+                break;
+            }
+            length++;
+        }
+        const StringSpan ascii = {{text.bytesWithoutTerminator(), length}, false, StringEncoding::Ascii};
+        return address.fromAddressPort(ascii, port);
+    }
+
+    static bool sameAddress(const SocketIPAddress& first, const SocketIPAddress& second)
+    {
+        SocketIPAddress::AsciiBuffer firstBuffer, secondBuffer;
+        StringSpan                   firstText, secondText;
+        return first.getPort() == second.getPort() and first.toString(firstBuffer, firstText) and
+               second.toString(secondBuffer, secondText) and firstText == secondText;
+    }
+
+    static bool withPort(const SocketIPAddress& address, uint16_t port, SocketIPAddress& output)
+    {
+        SocketIPAddress::AsciiBuffer buffer;
+        StringSpan                   text;
+        return address.toString(buffer, text) and output.fromAddressPort(text, port);
+    }
+
+    // Builds an address from the 4 (IPv4) or 16 (IPv6) bytes of an A / AAAA record
+    static bool fromBytes(const uint8_t* bytes, size_t numBytes, uint16_t port, SocketIPAddress& address)
+    {
+        static constexpr char hexDigits[] = "0123456789abcdef";
+
+        char   text[SocketIPAddress::MAX_ASCII_STRING_LENGTH];
+        size_t length = 0;
+        if (numBytes == 4)
+        {
+            for (size_t idx = 0; idx < 4; ++idx)
+            {
+                const uint8_t value = bytes[idx];
+                if (value >= 100)
+                {
+                    text[length++] = static_cast<char>('0' + value / 100);
+                }
+                if (value >= 10)
+                {
+                    text[length++] = static_cast<char>('0' + (value / 10) % 10);
+                }
+                text[length++] = static_cast<char>('0' + value % 10);
+                text[length++] = '.';
+            }
+        }
+        else
+        {
+            for (size_t idx = 0; idx < 16; idx += 2)
+            {
+                const uint16_t group = static_cast<uint16_t>((bytes[idx] << 8) | bytes[idx + 1]);
+                bool           digit = false;
+                for (int shift = 12; shift >= 0; shift -= 4)
+                {
+                    const uint16_t nibble = (group >> shift) & 0xF;
+                    if (digit or nibble != 0 or shift == 0)
+                    {
+                        text[length++] = hexDigits[nibble];
+                        digit          = true;
+                    }
+                }
+                text[length++] = ':';
+            }
+        }
+        length--; // Drop last separator
+        return address.fromAddressPort(StringSpan({text, length}, false, StringEncoding::Ascii), port);
+    }
+
+    static uint16_t nextRandom(AsyncDNSResolver& resolver)
+    {
+        // xorshift32, to avoid predictable query identifiers
+        uint32_t state = resolver.randomState;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        resolver.randomState = state;
+        return static_cast<uint16_t>(state >> 8);
+    }
+
+    static Result parseResolvConf(AsyncDNSResolver& resolver)
+    {
+        LineReader reader;
+        if (not reader.file.open(resolver.options.resolvConfPath, FileOpen::Read))
+        {
+            return Result(true); // Missing resolv.conf is not an error (nameservers can be added explicitly)
+        }
+        StringSpan line;
+        while (reader.next(line))
+        {
+            TokenIterator tokens(line);
+            StringSpan    keyword, value;
+            if (not tokens.next(keyword))
+            {
+                continue;
+            }
+            if (keyword == "nameserver" and tokens.next(value))
+            {
+                SocketIPAddress address;
+                if (parseAddress(value, 53, address))
+                {
+                    (void)resolver.addNameserver(address);
+                }
+            }
+            else if (keyword == "options")
+            {
+                while (tokens.next(value))
+                {
+                    StringSpan number;
+                    uint32_t   parsed = 0;
+                    if (startsWith(value, "timeout:", number) and parseUnsigned(number, parsed) and parsed > 0)
+                    {
+                        resolver.options.timeout = TimeMs{static_cast<int64_t>(parsed > 30 ? 30 : parsed) * 1000};
+                    }
+                    else if (startsWith(value, "attempts:", number) and parseUnsigned(number, parsed) and parsed > 0)
+                    {
+                        resolver.options.attempts = parsed > 5 ? 5 : parsed;
+                    }
+                }
+            }
+        }
+        return Result(true);
+    }
+
+    // Looks up host in the static host table, returning the number of addresses found
+    static size_t lookupHosts(const AsyncDNSResolver& resolver, StringSpan host, uint16_t port,
+                              Span<SocketIPAddress> addresses)
+    {
+        LineReader reader;
+        if (resolver.options.hostsPath.isEmpty() or not reader.file.open(resolver.options.hostsPath, FileOpen::Read))
+        {
+            return 0;
+        }
+        size_t     numAddresses = 0;
+        StringSpan line;
+        while (numAddresses < addresses.sizeInElements() and reader.next(line))
+        {
+            TokenIterator tokens(line);
+            StringSpan    addressText, name;
+            if (not tokens.next(addressText))
+            {
+                continue;
+            }
+            while (tokens.next(name))
+            {
+                if (equalsIgnoreCase(name, host))
+                {
+                    if (parseAddress(addressText, port, addresses[numAddresses]))
+                    {
+                        numAddresses++;
+                    }
+                    break;
+                }
+            }
+        }
+        return numAddresses;
+    }
+
+    static CacheEntry* findCacheEntry(AsyncDNSResolver& resolver, StringSpan host)
+    {
+        const TimeMs now = resolver.eventLoop->getLoopTime();
+        for (CacheEntry& entry : resolver.cache)
+        {
+            if (entry.hostLength > 0 and now.milliseconds < entry.expiration.milliseconds and
+                equalsIgnoreCase({{entry.host, entry.hostLength}, false, StringEncoding::Ascii}, host))
+            {
+                entry.lastUsed = now;
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    static void storeCacheEntry(AsyncDNSResolver& resolver, StringSpan host, Span<const SocketIPAddress> addresses,
+                                uint32_t ttlSeconds)
+    {
+        const TimeMs now = resolver.eventLoop->getLoopTime();
+        if (ttlSeconds > resolver.options.maxTTLSeconds)
+        {
+            ttlSeconds = resolver.options.maxTTLSeconds;
+        }
+        if (ttlSeconds == 0 or resolver.cache.empty())
+        {
+            return;
+        }
+        // Prefer an entry for the same host, then an expired one and finally the least recently used
+        CacheEntry* selected = nullptr;
+        for (CacheEntry& entry : resolver.cache)
+        {
+            if (entry.hostLength > 0 and
+                equalsIgnoreCase({{entry.host, entry.hostLength}, false, StringEncoding::Ascii}, host))
+            {
+                selected = &entry;
+                break;
+            }
+            if (selected == nullptr or entry.expiration.milliseconds <= now.milliseconds or
+                (selected->expiration.milliseconds > now.milliseconds and
+                 entry.lastUsed.milliseconds < selected->lastUsed.milliseconds))
+            {
+                selected = &entry;
+            }
+        }
+        ::memcpy(selected->host, host.bytesWithoutTerminator(), host.sizeInBytes());
+        selected->hostLength   = static_cast<uint8_t>(host.sizeInBytes());
+        selected->numAddresses = static_cast<uint8_t>(addresses.sizeInElements());
+        selected->expiration   = TimeMs{now.milliseconds + static_cast<int64_t>(ttlSeconds) * 1000};
+        selected->lastUsed     = now;
+        for (size_t idx = 0; idx < addresses.sizeInElements(); ++idx)
+        {
+            selected->addresses[idx] = addresses[idx];
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// AsyncDNSResolver
+//-------------------------------------------------------------------------------------------------------
+SC::Result SC::AsyncDNSResolver::init(AsyncEventLoop& loop, Span<CacheEntry> newCache, Options newOptions)
+{
+    SC_TRY_MSG(eventLoop == nullptr, "AsyncDNSResolver::init - already initialized");
+    eventLoop      = &loop;
+    cache          = newCache;
+    options        = newOptions;
+    numNameservers = 0;
+    randomState    = static_cast<uint32_t>(loop.getLoopTime().milliseconds) ^
+                  static_cast<uint32_t>(reinterpret_cast<size_t>(this) >> 4) ^ 0x9E3779B9u;
+    if (randomState == 0)
+    {
+        randomState = 1;
+    }
+    clearCache();
+    if (not options.resolvConfPath.isEmpty())
+    {
+        SC_TRY(Internal::parseResolvConf(*this));
+    }
+    SC_TRY_MSG(options.attempts > 0, "AsyncDNSResolver::init - attempts must be greater than zero");
+    return Result(true);
+}
+
+SC::Result SC::AsyncDNSResolver::addNameserver(SocketIPAddress address)
+{
+    SC_TRY_MSG(numNameservers < MaxNameservers, "AsyncDNSResolver::addNameserver - too many nameservers");
+    SC_TRY_MSG(numNameservers == 0 or nameservers[0].getAddressFamily() == address.getAddressFamily(),
+               "AsyncDNSResolver::addNameserver - address family differs from first nameserver");
+    nameservers[numNameservers++] = address;
+    return Result(true);
+}
+
+void SC::AsyncDNSResolver::clearCache()
+{
+    for (CacheEntry& entry : cache)
+    {
+        entry.hostLength   = 0;
+        entry.numAddresses = 0;
+    }
+}
+
+SC::Result SC::AsyncDNSResolver::close()
+{
+    eventLoop      = nullptr;
+    cache          = {};
+    numNameservers = 0;
+    return Result(true);
+}
+
+//-------------------------------------------------------------------------------------------------------
+// AsyncDNSQuery::Internal
+//-------------------------------------------------------------------------------------------------------
+struct SC::AsyncDNSQuery::Internal
+{
+    using ResolverInternal = AsyncDNSResolver::Internal;
+
+    static void writeUInt16(char* destination, uint16_t value)
+    {
+        destination[0] = static_cast<char>(value >> 8);
+        destination[1] = static_cast<char>(value & 0xFF);
+    }
+
+    static uint16_t readUInt16(const uint8_t* source) { return static_cast<uint16_t>((source[0] << 8) | source[1]); }
+
+    static uint32_t readUInt32(const uint8_t* source)
+    {
+        return (static_cast<uint32_t>(readUInt16(source)) << 16) | readUInt16(source + 2);
+    }
+
+    // Writes DNS header and question for the query host, leaving identifier and type to writeQueryHeader
+    static SC::Result buildQuestion(AsyncDNSQuery& query)
+    {
+        char*  packet = query.queryPacketA;
+        size_t offset = 12;
+        size_t label  = 0;
+        for (size_t idx = 0; idx <= query.hostLength; ++idx)
+        {
+            if (idx == query.hostLength or query.host[idx] == '.')
+            {
+                const size_t labelLength = idx - label;
+                if (labelLength == 0 and idx == query.hostLength and idx > 0)
+                {
+                    break; // Trailing dot of a fully qualified name
+                }
+                SC_TRY_MSG(labelLength > 0 and labelLength < 64, "AsyncDNSQuery - invalid host name label");
+                packet[offset++] = static_cast<char>(labelLength);
+                ::memcpy(packet + offset, query.host + label, labelLength);
+                offset += labelLength;
+                label = idx + 1;
+            }
+        }
+        packet[offset++] = 0;
+        offset += 4; // Type and class
+        writeUInt16(packet + 2, AsyncDNSResolver::Internal::FlagRecursionDesired);
+        writeUInt16(packet + 4, 1); // Question count
+        writeUInt16(packet + 6, 0);
+        writeUInt16(packet + 8, 0);
+        writeUInt16(packet + 10, 0);
+        writeUInt16(packet + offset - 2, ResolverInternal::ClassIN);
+        query.querySize = static_cast<uint16_t>(offset);
+        ::memcpy(query.queryPacketAAAA, query.queryPacketA, offset);
+
+        query.idA    = ResolverInternal::nextRandom(*query.resolver);
+        query.idAAAA = static_cast<uint16_t>(query.idA + 1);
+        writeUInt16(query.queryPacketA, query.idA);
+        writeUInt16(query.queryPacketAAAA, query.idAAAA);
+        writeUInt16(query.queryPacketA + offset - 4, ResolverInternal::TypeA);
+        writeUInt16(query.queryPacketAAAA + offset - 4, ResolverInternal::TypeAAAA);
+        return SC::Result(true);
+    }
+
+    static bool skipName(const uint8_t* packet, size_t packetSize, size_t& offset)
+    {
+        while (offset < packetSize)
+        {
+            const uint8_t length = packet[offset];
+            if (length == 0)
+            {
+                offset += 1;
+                return true;
+            }
+            if ((length & 0xC0) == 0xC0)
+            {
+                offset += 2; // Compression pointer always ends the name
+                return offset <= packetSize;
+            }
+            if ((length & 0xC0) != 0)
+            {
+                return false;
+            }
+            offset += 1 + length;
+        }
+        return false;
+    }
+
+    static void addAddress(AsyncDNSQuery& query, const uint8_t* bytes, size_t numBytes)
+    {
+        // IPv6 addresses fill the array from the front and IPv4 ones from the back, to be interleaved on completion
+        if (query.numAddressesV4 + query.numAddressesV6 >= AsyncDNSResolver::MaxAddresses)
+        {
+            return;
+        }
+        const size_t index = numBytes == 16 ? query.numAddressesV6
+                                            : AsyncDNSResolver::MaxAddresses - 1 - query.numAddressesV4;
+        if (ResolverInternal::fromBytes(bytes, numBytes, query.port, query.addresses[index]))
+        {
+            if (numBytes == 16)
+            {
+                query.numAddressesV6++;
+            }
+            else
+            {
+                query.numAddressesV4++;
+            }
+        }
+    }
+
+    // Parses a response packet, returning false if it doesn't answer one of the pending questions
+    static bool parseResponse(AsyncDNSQuery& query, Span<const char> data, bool& isTypeA)
+    {
+        const uint8_t* packet     = reinterpret_cast<const uint8_t*>(data.data());
+        const size_t   packetSize = data.sizeInBytes();
+        if (packetSize < query.querySize)
+        {
+            return false;
+        }
+        const uint16_t identifier = readUInt16(packet);
+        const uint16_t flags      = readUInt16(packet + 2);
+        if ((flags & ResolverInternal::FlagResponse) == 0 or readUInt16(packet + 4) != 1)
+        {
+            return false;
+        }
+        if (identifier == query.idA and not query.answeredA)
+        {
+            isTypeA = true;
+        }
+        else if (identifier == query.idAAAA and not query.answeredAAAA)
+        {
+            isTypeA = false;
+        }
+        else
+        {
+            return false;
+        }
+        // Question must echo the one that has been sent (ignoring case, that some resolvers randomize)
+        const char* question = isTypeA ? query.queryPacketA : query.queryPacketAAAA;
+        for (size_t idx = 12; idx < query.querySize; ++idx)
+        {
+            if (ResolverInternal::toLower(static_cast<char>(packet[idx])) != ResolverInternal::toLower(question[idx]))
+            {
+                return false;
+            }
+        }
+        const uint16_t responseCode = flags & ResolverInternal::MaskResponseCode;
+        if (responseCode != 0 and responseCode != ResolverInternal::CodeNameError)
+        {
+            return false; // Server failure or refused, let the retry timeout query next nameserver
+        }
+
+        const uint16_t wantedType = isTypeA ? ResolverInternal::TypeA : ResolverInternal::TypeAAAA;
+        const size_t   wantedSize = isTypeA ? 4 : 16;
+
+        uint16_t numAnswers = readUInt16(packet + 6);
+        size_t   offset     = query.querySize;
+        while (numAnswers-- > 0)
+        {
+            if (not skipName(packet, packetSize, offset) or offset + 10 > packetSize)
+            {
+                break; // Truncated response, keep what has been parsed so far
+            }
+            const uint16_t type       = readUInt16(packet + offset);
+            const uint16_t recordType = readUInt16(packet + offset + 2);
+            const uint32_t ttl        = readUInt32(packet + offset + 4);
+            const uint16_t dataLength = readUInt16(packet + offset + 8);
+            offset += 10;
+            if (offset + dataLength > packetSize)
+            {
+                break;
+            }
+            if (type == wantedType and recordType == ResolverInternal::ClassIN and dataLength == wantedSize)
+            {
+                addAddress(query, packet + offset, dataLength);
+                if (ttl < query.minTTL)
+                {
+                    query.minTTL = ttl;
+                }
+            }
+            offset += dataLength;
+        }
+        return true;
+    }
+
+    static SC::Result sendQueries(AsyncDNSQuery& query)
+    {
+        AsyncEventLoop& loop = *query.resolver->eventLoop;
+        if (not query.answeredA and query.sendA.isFree())
+        {
+            SC_TRY(query.sendA.start(loop, query.socket, query.nameserver, {query.queryPacketA, query.querySize}));
+        }
+        if (not query.answeredAAAA and query.sendAAAA.isFree())
+        {
+            SC_TRY(query.sendAAAA.start(loop, query.socket, query.nameserver,
+                                        {query.queryPacketAAAA, query.querySize}));
+        }
+        if (query.receive.isFree())
+        {
+            SC_TRY(query.receive.start(loop, query.socket, {query.responsePacket, sizeof(query.responsePacket)}));
+        }
+        return query.timeout.start(loop, query.resolver->options.timeout);
+    }
+
+    static SC::Result startQuerying(AsyncDNSQuery& query)
+    {
+        AsyncDNSResolver& resolver = *query.resolver;
+        SC_TRY_MSG(resolver.numNameservers > 0, "AsyncDNSQuery - no nameservers configured");
+        SC_TRY(buildQuestion(query));
+        query.nameserver = resolver.nameservers[0];
+        SC_TRY(resolver.eventLoop->createAsyncUDPSocket(query.nameserver.getAddressFamily(), query.socket));
+        query.phase = Phase::Querying;
+        return sendQueries(query);
+    }
+
+    static void onSent(AsyncSocketSendTo::Result&) {}
+
+    static void onReceive(AsyncDNSQuery& query, AsyncSocketReceiveFrom::Result& result)
+    {
+        Span<char> data;
+        if (query.phase != Phase::Querying or not result.get(data))
+        {
+            return; // Errors are handled by the retry timeout
+        }
+        bool isTypeA = false;
+        if (isFromNameserver(query, result.getSourceAddress()) and parseResponse(query, data, isTypeA))
+        {
+            if (isTypeA)
+            {
+                query.answeredA = true;
+            }
+            else
+            {
+                query.answeredAAAA = true;
+            }
+            // Happy Eyeballs v2 (RFC 8305 Section 3): proceed as soon as a positive AAAA answer arrives, but wait for
+            // a limited time for AAAA after a positive A answer.
+            if ((query.answeredA and query.answeredAAAA) or (not isTypeA and query.numAddressesV6 > 0))
+            {
+                complete(query);
+                return;
+            }
+            if (isTypeA and query.numAddressesV4 > 0)
+            {
+                const AsyncDNSResolver& resolver = *query.resolver;
+
+                SC::Result delayResult = query.delay.start(*resolver.eventLoop, resolver.options.resolutionDelay);
+                if (not delayResult)
+                {
+                    finish(query, delayResult);
+                    return;
+                }
+            }
+        }
+        result.reactivateRequest(true);
+    }
+
+    static bool isFromNameserver(const AsyncDNSQuery& query, const SocketIPAddress& source)
+    {
+        for (const SocketIPAddress& nameserver : query.resolver->getNameservers())
+        {
+            if (ResolverInternal::sameAddress(nameserver, source))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void onTimeout(AsyncDNSQuery& query)
+    {
+        if (query.phase == Phase::Completing)
+        {
+            finish(query, query.completionResult);
+            return;
+        }
+        const AsyncDNSResolver& resolver = *query.resolver;
+        query.attempt++;
+        if (query.attempt >= resolver.options.attempts * resolver.numNameservers)
+        {
+            complete(query); // Use whatever has been resolved so far
+            return;
+        }
+        query.nameserver = resolver.nameservers[query.attempt % resolver.numNameservers];
+        SC::Result sendResult = sendQueries(query);
+        if (not sendResult)
+        {
+            finish(query, sendResult);
+        }
+    }
+
+    // Interleaves resolved addresses by family (starting with IPv6), caches them and finishes the query
+    static void complete(AsyncDNSQuery& query)
+    {
+        SocketIPAddress interleaved[AsyncDNSResolver::MaxAddresses];
+
+        size_t numAddresses = 0;
+        for (size_t idx = 0; idx < query.numAddressesV6 or idx < query.numAddressesV4; ++idx)
+        {
+            if (idx < query.numAddressesV6)
+            {
+                interleaved[numAddresses++] = query.addresses[idx];
+            }
+            if (idx < query.numAddressesV4)
+            {
+                interleaved[numAddresses++] = query.addresses[AsyncDNSResolver::MaxAddresses - 1 - idx];
+            }
+        }
+        for (size_t idx = 0; idx < numAddresses; ++idx)
+        {
+            query.addresses[idx] = interleaved[idx];
+        }
+        query.numAddresses = static_cast<uint8_t>(numAddresses);
+        if (numAddresses == 0)
+        {
+            if (query.answeredA and query.answeredAAAA)
+            {
+                finish(query, SC::Result::Error("AsyncDNSQuery - host not found"));
+            }
+            else
+            {
+                finish(query, SC::Result::Error("AsyncDNSQuery - timeout"));
+            }
+            return;
+        }
+        if (query.answeredA and query.answeredAAAA)
+        {
+            const StringSpan host = {{query.host, query.hostLength}, false, StringEncoding::Ascii};
+            ResolverInternal::storeCacheEntry(*query.resolver, host, {query.addresses, numAddresses}, query.minTTL);
+        }
+        finish(query, SC::Result(true));
+    }
+
+    // Stops all internal requests, closing the socket and invoking the callback once all of them are free
+    static void finish(AsyncDNSQuery& query, SC::Result result)
+    {
+        query.completionResult = result;
+        query.phase            = Phase::Stopping;
+        query.pendingStops     = 0;
+
+        AsyncEventLoop& loop = *query.resolver->eventLoop;
+
+        AsyncRequest* requests[] = {&query.timeout, &query.delay, &query.receive, &query.sendA, &query.sendAAAA};
+        for (AsyncRequest* request : requests)
+        {
+            if (not request->isFree() and not request->isCancelling() and request->stop(loop, &query.onStopped))
+            {
+                query.pendingStops++;
+            }
+        }
+        if (query.pendingStops == 0)
+        {
+            release(query);
+        }
+    }
+
+    static void onStopped(AsyncDNSQuery& query)
+    {
+        if (--query.pendingStops == 0)
+        {
+            release(query);
+        }
+    }
+
+    static void release(AsyncDNSQuery& query)
+    {
+        if (query.socket.isValid())
+        {
+            (void)query.socket.close();
+        }
+        query.phase = Phase::Free;
+        if (query.notifyOnStopped and query.callback.isValid())
+        {
+            AsyncDNSQuery::Result result(query, query.completionResult);
+            query.callback(result);
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// AsyncDNSQuery
+//-------------------------------------------------------------------------------------------------------
+SC::Result SC::AsyncDNSQuery::start(AsyncDNSResolver& dnsResolver, StringSpan hostName, uint16_t hostPort)
+{
+    using ResolverInternal = AsyncDNSResolver::Internal;
+    SC_TRY_MSG(phase == Phase::Free, "AsyncDNSQuery::start - query is still running");
+    SC_TRY_MSG(dnsResolver.eventLoop != nullptr, "AsyncDNSQuery::start - resolver not initialized");
+    SC_TRY_MSG(hostName.getEncoding() == StringEncoding::Ascii, "AsyncDNSQuery::start - only ASCII is supported");
+    SC_TRY_MSG(not hostName.isEmpty() and hostName.sizeInBytes() <= AsyncDNSResolver::MaxHostLength,
+               "AsyncDNSQuery::start - invalid host length");
+
+    resolver = &dnsResolver;
+    ::memcpy(host, hostName.bytesWithoutTerminator(), hostName.sizeInBytes());
+    host[hostName.sizeInBytes()] = 0;
+
+    hostLength       = static_cast<uint8_t>(hostName.sizeInBytes());
+    port             = hostPort;
+    numAddresses     = 0;
+    numAddressesV4   = 0;
+    numAddressesV6   = 0;
+    attempt          = 0;
+    minTTL           = 0xFFFFFFFF;
+    answeredA        = false;
+    answeredAAAA     = false;
+    fromCache        = false;
+    notifyOnStopped  = true;
+    completionResult = SC::Result(true);
+
+    timeout.callback = [this](AsyncLoopTimeout::Result&) { Internal::onTimeout(*this); };
+    delay.callback   = [this](AsyncLoopTimeout::Result&) { Internal::complete(*this); };
+    sendA.callback.bind<&Internal::onSent>();
+    sendAAAA.callback.bind<&Internal::onSent>();
+    receive.callback = [this](AsyncSocketReceiveFrom::Result& result) { Internal::onReceive(*this, result); };
+    onStopped        = [this](AsyncResult&) { Internal::onStopped(*this); };
+
+    const StringSpan name = {{host, hostLength}, false, StringEncoding::Ascii};
+
+    // IP literals, cached resolutions and static host table entries are completed on next loop iteration
+    if (ResolverInternal::parseAddress(name, port, addresses[0]))
+    {
+        numAddresses = 1;
+    }
+    else if (AsyncDNSResolver::CacheEntry* entry = ResolverInternal::findCacheEntry(dnsResolver, name))
+    {
+        for (size_t idx = 0; idx < entry->numAddresses; ++idx)
+        {
+            if (ResolverInternal::withPort(entry->addresses[idx], port, addresses[numAddresses]))
+            {
+                numAddresses++;
+            }
+        }
+        fromCache = true;
+    }
+    else
+    {
+        numAddresses = static_cast<uint8_t>(ResolverInternal::lookupHosts(dnsResolver, name, port, addresses));
+    }
+    if (numAddresses > 0)
+    {
+        phase = Phase::Completing;
+        return timeout.start(*dnsResolver.eventLoop, TimeMs{0});
+    }
+    SC::Result res = Internal::startQuerying(*this);
+    if (not res)
+    {
+        notifyOnStopped = false;
+        Internal::finish(*this, res);
+    }
+    return res;
+}
+
+SC::Result SC::AsyncDNSQuery::stop()
+{
+    if (phase == Phase::Free)
+    {
+        return SC::Result(true);
+    }
+    notifyOnStopped = false;
+    if (phase != Phase::Stopping)
+    {
+        Internal::finish(*this, SC::Result::Error("AsyncDNSQuery stopped"));
+    }
+    return SC::Result(true);
+}
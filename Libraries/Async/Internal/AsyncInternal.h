@@ -132,6 +132,7 @@ struct SC::AsyncEventLoop::Internal
     static constexpr int16_t Flag_WaitingKernelCancel     = 1 << 7; // Close callback must wait for kernel cancellation
     static constexpr int16_t Flag_InternalWakeUpUserEvent = 1 << 8; // kqueue wake-up watcher uses EVFILT_USER
     static constexpr int16_t Flag_ForceThreadPool         = 1 << 9; // Use thread pool even if native async exists
+    static constexpr int16_t Flag_WatchWritable           = 1 << 10; // AsyncFileReadiness monitors writability
 
     Result close(AsyncEventLoop& eventLoop);
 
@@ -438,14 +438,27 @@ struct SC::AsyncEventLoop::Internal::KernelEventsIoURing
     {
         io_uring_sqe* submission;
         SC_TRY(getNewSubmission(eventLoop, submission));
-        struct sockaddr* sockAddr = &async.ipAddress.handle.reinterpret_as<struct sockaddr>();
-        AsyncLinuxIOUring::prepConnect(submission, async.handle, sockAddr, async.ipAddress.sizeOfHandle());
+        if (async.fastOpenData.empty())
+        {
+            struct sockaddr* sockAddr = &async.ipAddress.handle.reinterpret_as<struct sockaddr>();
+            AsyncLinuxIOUring::prepConnect(submission, async.handle, sockAddr, async.ipAddress.sizeOfHandle());
+        }
+        else
+        {
+            // IORING_OP_CONNECT can't carry data, so the SYN is sent synchronously with MSG_FASTOPEN
+            SC_TRY(KernelEventsPosix::posixStartConnect(async));
+            AsyncLinuxIOUring::prepPollAdd(submission, async.handle, POLLOUT);
+        }
         AsyncLinuxIOUring::setData(submission, &async);
         return Result(true);
     }
 
     Result completeAsync(AsyncSocketConnect::Result& res)
     {
+        if (not res.getAsync().fastOpenData.empty())
+        {
+            return KernelEventsPosix::posixCompleteConnect(res);
+        }
         res.returnCode = Result(true);
         return Result(true);
     }
@@ -475,6 +488,23 @@ struct SC::AsyncEventLoop::Internal::KernelEventsIoURing
 
     Result completeAsync(AsyncSocketSend::Result& result)
     {
+        if (result.getAsync().type == AsyncRequest::Type::SocketSendTo)
+        {
+            AsyncSocketSendTo& async = static_cast<AsyncSocketSendTo&>(result.getAsync());
+            if (not async.datagrams.empty())
+            {
+                // Socket is writable (POLLOUT), so send as many datagrams as possible with sendmmsg
+                SC_TRY(KernelEventsPosix::posixSendDatagrams(async));
+                if (async.numDatagramsSent < async.datagrams.sizeInElements())
+                {
+                    result.shouldCallCallback = false;
+                    result.reactivateRequest(true);
+                    return Result(true);
+                }
+                result.completionData.numBytes = async.totalBytesWritten;
+                return Result(true);
+            }
+        }
         result.completionData.numBytes = static_cast<size_t>(events[result.eventIndex].res);
 
         size_t totalBytes = 0;
@@ -507,6 +537,15 @@ struct SC::AsyncEventLoop::Internal::KernelEventsIoURing
 
     Result completeAsync(AsyncSocketReceive::Result& result)
     {
+        if (result.getAsync().type == AsyncRequest::Type::SocketReceiveFrom)
+        {
+            AsyncSocketReceiveFrom& async = static_cast<AsyncSocketReceiveFrom&>(result.getAsync());
+            if (not async.datagrams.empty())
+            {
+                // Socket is readable (POLLIN), so drain as many datagrams as possible with recvmmsg
+                return KernelEventsPosix::completeReceiveDatagrams(result, async);
+            }
+        }
         io_uring_cqe& completion       = events[result.eventIndex];
         result.completionData.numBytes = static_cast<size_t>(completion.res);
         if (completion.res == 0)
@@ -700,7 +739,8 @@ struct SC::AsyncEventLoop::Internal::KernelEventsIoURing
         // poll operation is completed, it will have to be resubmitted."
         io_uring_sqe* submission;
         SC_TRY(getNewSubmission(eventLoop, submission));
-        AsyncLinuxIOUring::prepPollAdd(submission, async.handle, POLLIN);
+        const bool writable = async.mode == AsyncFileReadiness::Mode::Writable;
+        AsyncLinuxIOUring::prepPollAdd(submission, async.handle, writable ? POLLOUT : POLLIN);
         AsyncLinuxIOUring::setData(submission, &async);
         return Result(true);
     }
@@ -798,6 +838,13 @@ struct SC::AsyncEventLoop::Internal::KernelEventsIoURing
     {
         io_uring_sqe* submission;
         SC_TRY(getNewSubmission(eventLoop, submission));
+        if (not async.datagrams.empty())
+        {
+            // io_uring has no sendmmsg equivalent, so wait for writability and batch datagrams in completeAsync
+            AsyncLinuxIOUring::prepPollAdd(submission, async.handle, POLLOUT);
+            AsyncLinuxIOUring::setData(submission, &async);
+            return Result(true);
+        }
 
         struct msghdr& msg = async.typeErasedMsgHdr.reinterpret_as<struct msghdr>();
         memset(&msg, 0, sizeof(msg));
@@ -831,6 +878,13 @@ struct SC::AsyncEventLoop::Internal::KernelEventsIoURing
     {
         io_uring_sqe* submission;
         SC_TRY(getNewSubmission(eventLoop, submission));
+        if (not async.datagrams.empty())
+        {
+            // io_uring has no recvmmsg equivalent, so wait for readability and batch datagrams in completeAsync
+            AsyncLinuxIOUring::prepPollAdd(submission, async.handle, POLLIN);
+            AsyncLinuxIOUring::setData(submission, &async);
+            return Result(true);
+        }
 
         struct msghdr& msg = async.typeErasedMsgHdr.reinterpret_as<struct msghdr>();
         memset(&msg, 0, sizeof(msg));
@@ -28,6 +28,17 @@
 #include <sys/wait.h>     // waitpid / WIFEXITED / WEXITSTATUS
 #include <unistd.h>       // close
 
+#include <netinet/udp.h> // UDP_SEGMENT / UDP_GRO
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // Linux 4.18
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104 // Linux 5.0
+#endif
+
 #else
 
 #include <errno.h>     // For error handling
@@ -369,7 +380,9 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
         if (epollERR or epollHUP)
         {
             const AsyncRequest* request = getAsyncRequest(idx);
-            if (request->type == AsyncRequest::Type::FileRead or request->type == AsyncRequest::Type::FileWrite)
+            // Readiness of a closed pipe / socket is reported so that the next read / write can observe it
+            if (request->type == AsyncRequest::Type::FileRead or request->type == AsyncRequest::Type::FileWrite or
+                request->type == AsyncRequest::Type::FileReadiness)
             {
                 return Result(true);
             }
@@ -581,8 +594,36 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
     //-------------------------------------------------------------------------------------------------------
     // Socket CONNECT
     //-------------------------------------------------------------------------------------------------------
-    Result activateAsync(AsyncEventLoop& eventLoop, AsyncSocketConnect& async)
+    /// @brief Starts a non-blocking connect, sending AsyncSocketConnect::fastOpenData in the SYN if possible
+    static Result posixStartConnect(AsyncSocketConnect& async)
     {
+        async.numBytesSent = 0;
+#if SC_PLATFORM_LINUX
+        if (not async.fastOpenData.empty())
+        {
+            const struct sockaddr* address = &async.ipAddress.handle.reinterpret_as<const struct sockaddr>();
+            ssize_t                res;
+            do
+            {
+                res = ::sendto(async.handle, async.fastOpenData.data(), async.fastOpenData.sizeInBytes(),
+                               MSG_FASTOPEN | MSG_NOSIGNAL, address, async.ipAddress.sizeOfHandle());
+            } while (res == -1 and errno == EINTR);
+            if (res >= 0)
+            {
+                async.numBytesSent = static_cast<size_t>(res); // A Fast Open cookie was cached
+                return Result(true);
+            }
+            if (errno == EINPROGRESS)
+            {
+                return Result(true); // No cookie yet, the SYN just requests one
+            }
+            if (errno != EOPNOTSUPP)
+            {
+                return Result::Error("connect (TCP Fast Open) failed");
+            }
+            // Client side Fast Open is disabled (net.ipv4.tcp_fastopen), fallback to a regular connect
+        }
+#endif
         SocketDescriptor client;
         SC_TRY(client.assign(async.handle));
         auto detach = MakeDeferred([&] { client.detach(); });
@@ -595,7 +636,26 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
         {
             return Result::Error("connect failed");
         }
+        return Result(true);
+    }
+
+    /// @brief Checks the outcome of a connect started with posixStartConnect, once the socket is writable
+    static Result posixCompleteConnect(AsyncSocketConnect::Result& result)
+    {
+        AsyncSocketConnect& async = result.getAsync();
+
+        int       errorCode;
+        socklen_t errorSize = sizeof(errorCode);
+        SC_TRY_MSG(::getsockopt(async.handle, SOL_SOCKET, SO_ERROR, &errorCode, &errorSize) == 0,
+                   "connect getsockopt failed");
+        SC_TRY_MSG(errorCode == 0, "connect SO_ERROR");
+        result.completionData.numBytes = async.numBytesSent;
+        return Result(true);
+    }
 
+    Result activateAsync(AsyncEventLoop& eventLoop, AsyncSocketConnect& async)
+    {
+        SC_TRY(posixStartConnect(async));
         async.flags |= Internal::Flag_WatcherSet;
         return setEventWatcher(eventLoop, async, async.handle, OUTPUT_EVENTS_MASK);
     }
@@ -604,10 +664,6 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
     {
         AsyncSocketConnect& async = result.getAsync();
 
-        int       errorCode;
-        socklen_t errorSize = sizeof(errorCode);
-        const int socketRes = ::getsockopt(async.handle, SOL_SOCKET, SO_ERROR, &errorCode, &errorSize);
-
         // TODO: This is making a syscall for each connected socket, we should probably aggregate them
         // And additionally it's stupid as probably WRITE will be subscribed again anyway
         // But probably this means to review the entire process of async stop
@@ -615,12 +671,7 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
         async.flags &= ~Internal::Flag_WatcherSet;
         SC_ASYNC_TRUST_RESULT(
             KernelQueuePosix::stopSingleWatcherImmediate(eventLoop, async.handle, OUTPUT_EVENTS_MASK));
-        if (socketRes == 0)
-        {
-            SC_TRY_MSG(errorCode == 0, "connect SO_ERROR");
-            return Result(true);
-        }
-        return Result::Error("connect getsockopt failed");
+        return posixCompleteConnect(result);
     }
 
     //-------------------------------------------------------------------------------------------------------
@@ -909,6 +960,206 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
         return Result(true);
     }
 
+    //-------------------------------------------------------------------------------------------------------
+    // Posix Datagrams (Shared between batched Socket Send To / Receive From of epoll, kqueue and io_uring)
+    //-------------------------------------------------------------------------------------------------------
+    static constexpr size_t MaxDatagramsPerCall = 64;    // Datagrams sent or received by a single syscall
+    static constexpr size_t MaxSegmentsBytes    = 65000; // Payload of a single UDP_SEGMENT send (below 64 KB)
+
+    /// @brief Receives datagrams until all of them have been filled or until the socket would block
+    static Result posixReceiveDatagrams(SocketDescriptor::Handle handle, Span<AsyncSocketReceiveDatagram> datagrams,
+                                        size_t& numReceived)
+    {
+        numReceived = 0;
+        while (numReceived < datagrams.sizeInElements())
+        {
+#if SC_PLATFORM_LINUX
+            struct mmsghdr messages[MaxDatagramsPerCall];
+            struct iovec   vectors[MaxDatagramsPerCall];
+            alignas(struct cmsghdr) char controls[MaxDatagramsPerCall][CMSG_SPACE(sizeof(int))];
+
+            size_t numMessages = datagrams.sizeInElements() - numReceived;
+            numMessages        = numMessages < MaxDatagramsPerCall ? numMessages : MaxDatagramsPerCall;
+            memset(messages, 0, sizeof(messages));
+            for (size_t idx = 0; idx < numMessages; ++idx)
+            {
+                AsyncSocketReceiveDatagram& datagram = datagrams[numReceived + idx];
+
+                vectors[idx].iov_base = datagram.buffer.data();
+                vectors[idx].iov_len  = datagram.buffer.sizeInBytes();
+
+                struct msghdr& msg = messages[idx].msg_hdr;
+                msg.msg_name       = &datagram.address.handle.reinterpret_as<struct sockaddr>();
+                msg.msg_namelen    = sizeof(datagram.address.handle);
+                msg.msg_iov        = &vectors[idx];
+                msg.msg_iovlen     = 1;
+                msg.msg_control    = controls[idx];
+                msg.msg_controllen = sizeof(controls[idx]);
+            }
+            int res;
+            do
+            {
+                res = ::recvmmsg(handle, messages, static_cast<unsigned>(numMessages), MSG_DONTWAIT, nullptr);
+            } while (res < 0 and errno == EINTR);
+            if (res < 0)
+            {
+                SC_TRY_MSG(errno == EAGAIN or errno == EWOULDBLOCK, "recvmmsg failed");
+                return Result(true);
+            }
+            for (size_t idx = 0; idx < static_cast<size_t>(res); ++idx)
+            {
+                AsyncSocketReceiveDatagram& datagram = datagrams[numReceived + idx];
+
+                datagram.numBytes    = messages[idx].msg_len;
+                datagram.segmentSize = 0;
+                struct msghdr& msg   = messages[idx].msg_hdr;
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+                {
+                    if (cmsg->cmsg_level == SOL_UDP and cmsg->cmsg_type == UDP_GRO)
+                    {
+                        int segmentSize;
+                        ::memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(segmentSize));
+                        datagram.segmentSize = static_cast<size_t>(segmentSize);
+                    }
+                }
+            }
+            numReceived += static_cast<size_t>(res);
+            if (static_cast<size_t>(res) < numMessages)
+            {
+                return Result(true); // Socket has been drained
+            }
+#else
+            AsyncSocketReceiveDatagram& datagram = datagrams[numReceived];
+
+            struct sockaddr* address    = &datagram.address.handle.reinterpret_as<struct sockaddr>();
+            socklen_t        addressLen = sizeof(datagram.address.handle);
+            ssize_t          res;
+            do
+            {
+                res = ::recvfrom(handle, datagram.buffer.data(), datagram.buffer.sizeInBytes(), MSG_DONTWAIT, address,
+                                 &addressLen);
+            } while (res < 0 and errno == EINTR);
+            if (res < 0)
+            {
+                SC_TRY_MSG(errno == EAGAIN or errno == EWOULDBLOCK, "recvfrom failed");
+                return Result(true);
+            }
+            datagram.numBytes    = static_cast<size_t>(res);
+            datagram.segmentSize = 0;
+            numReceived += 1;
+#endif
+        }
+        return Result(true);
+    }
+
+#if SC_PLATFORM_LINUX
+    /// @brief Checks if a datagram can be appended to a UDP_SEGMENT send started by the first one.
+    /// All segments must have the same size and destination, except the last one that can be shorter.
+    static bool canCoalesceDatagram(const AsyncSocketSendDatagram& first, const AsyncSocketSendDatagram& previous,
+                                    const AsyncSocketSendDatagram& datagram, size_t numSegments, size_t numBytes)
+    {
+        const size_t segmentSize = first.data.sizeInBytes();
+        return previous.data.sizeInBytes() == segmentSize and datagram.data.sizeInBytes() <= segmentSize and
+               not datagram.data.empty() and numSegments < MaxDatagramsPerCall and
+               numBytes + datagram.data.sizeInBytes() <= MaxSegmentsBytes and
+               first.address.sizeOfHandle() == datagram.address.sizeOfHandle() and
+               ::memcmp(&first.address.handle, &datagram.address.handle, first.address.sizeOfHandle()) == 0;
+    }
+#endif
+
+    /// @brief Sends remaining datagrams of a batched send to, until all have been sent or until socket would block
+    static Result posixSendDatagrams(AsyncSocketSendTo& async)
+    {
+        const Span<const AsyncSocketSendDatagram> datagrams = async.datagrams;
+        while (async.numDatagramsSent < datagrams.sizeInElements())
+        {
+#if SC_PLATFORM_LINUX
+            struct mmsghdr messages[MaxDatagramsPerCall];
+            struct iovec   vectors[MaxDatagramsPerCall];
+            size_t         messageDatagrams[MaxDatagramsPerCall]; // Number of datagrams coalesced in each message
+            alignas(struct cmsghdr) char controls[MaxDatagramsPerCall][CMSG_SPACE(sizeof(uint16_t))];
+
+            memset(messages, 0, sizeof(messages));
+            size_t numMessages = 0;
+            size_t numVectors  = 0;
+            size_t next        = async.numDatagramsSent;
+            while (next < datagrams.sizeInElements() and numVectors < MaxDatagramsPerCall)
+            {
+                const AsyncSocketSendDatagram& first = datagrams[next];
+
+                struct msghdr& msg = messages[numMessages].msg_hdr;
+                msg.msg_name       = const_cast<struct sockaddr*>(&first.address.handle.reinterpret_as<sockaddr>());
+                msg.msg_namelen    = first.address.sizeOfHandle();
+                msg.msg_iov        = &vectors[numVectors];
+
+                size_t numSegments = 0;
+                size_t numBytes    = 0;
+                do
+                {
+                    const AsyncSocketSendDatagram& datagram = datagrams[next];
+                    vectors[numVectors].iov_base            = const_cast<char*>(datagram.data.data());
+                    vectors[numVectors].iov_len             = datagram.data.sizeInBytes();
+                    numBytes += datagram.data.sizeInBytes();
+                    numVectors++;
+                    numSegments++;
+                    next++;
+                } while (async.segmentationOffload and next < datagrams.sizeInElements() and
+                         numVectors < MaxDatagramsPerCall and
+                         canCoalesceDatagram(first, datagrams[next - 1], datagrams[next], numSegments, numBytes));
+                msg.msg_iovlen = numSegments;
+
+                if (numSegments > 1)
+                {
+                    // Let the kernel split the coalesced payload in datagrams of the same size of the first one
+                    msg.msg_control        = controls[numMessages];
+                    msg.msg_controllen     = sizeof(controls[numMessages]);
+                    struct cmsghdr* cmsg   = CMSG_FIRSTHDR(&msg);
+                    cmsg->cmsg_level       = SOL_UDP;
+                    cmsg->cmsg_type        = UDP_SEGMENT;
+                    cmsg->cmsg_len         = CMSG_LEN(sizeof(uint16_t));
+                    const uint16_t segment = static_cast<uint16_t>(first.data.sizeInBytes());
+                    ::memcpy(CMSG_DATA(cmsg), &segment, sizeof(segment));
+                }
+                messageDatagrams[numMessages] = numSegments;
+                numMessages++;
+            }
+            int res;
+            do
+            {
+                res = ::sendmmsg(async.handle, messages, static_cast<unsigned>(numMessages), MSG_DONTWAIT);
+            } while (res < 0 and errno == EINTR);
+            if (res < 0)
+            {
+                SC_TRY_MSG(errno == EAGAIN or errno == EWOULDBLOCK, "sendmmsg failed");
+                return Result(true);
+            }
+            for (size_t idx = 0; idx < static_cast<size_t>(res); ++idx)
+            {
+                async.numDatagramsSent += messageDatagrams[idx];
+                async.totalBytesWritten += messages[idx].msg_len;
+            }
+#else
+            const AsyncSocketSendDatagram& datagram = datagrams[async.numDatagramsSent];
+
+            const struct sockaddr* address = &datagram.address.handle.reinterpret_as<const struct sockaddr>();
+            ssize_t                res;
+            do
+            {
+                res = ::sendto(async.handle, datagram.data.data(), datagram.data.sizeInBytes(), MSG_DONTWAIT, address,
+                               datagram.address.sizeOfHandle());
+            } while (res < 0 and errno == EINTR);
+            if (res < 0)
+            {
+                SC_TRY_MSG(errno == EAGAIN or errno == EWOULDBLOCK, "sendto failed");
+                return Result(true);
+            }
+            async.numDatagramsSent += 1;
+            async.totalBytesWritten += static_cast<size_t>(res);
+#endif
+        }
+        return Result(true);
+    }
+
     //-------------------------------------------------------------------------------------------------------
     // Socket SEND
     //-------------------------------------------------------------------------------------------------------
@@ -934,7 +1185,23 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
         if (async.type == AsyncRequest::Type::SocketSendTo)
         {
             AsyncSocketSendTo& asyncSendTo = static_cast<AsyncSocketSendTo&>(async);
-            SC_TRY(posixWriteCompleteAsync<AsyncSocketSend>(result, WriteApiPosixSendTo{asyncSendTo}));
+            if (not asyncSendTo.datagrams.empty())
+            {
+                async.flags &= ~Internal::Flag_ManualCompletion;
+                SC_TRY(posixSendDatagrams(asyncSendTo));
+                if (asyncSendTo.numDatagramsSent < asyncSendTo.datagrams.sizeInElements())
+                {
+                    // Socket would block, so skip user callback and reactivate to watch it again (like partial writes)
+                    result.shouldCallCallback = false;
+                    result.reactivateRequest(true);
+                    return Result(true);
+                }
+                result.completionData.numBytes = async.totalBytesWritten;
+            }
+            else
+            {
+                SC_TRY(posixWriteCompleteAsync<AsyncSocketSend>(result, WriteApiPosixSendTo{asyncSendTo}));
+            }
         }
         else
         {
@@ -954,6 +1221,19 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
 
     Result activateAsync(AsyncEventLoop& eventLoop, AsyncSocketSendTo& async)
     {
+        if (not async.datagrams.empty())
+        {
+            SC_ASYNC_ASSERT_RELEASE((async.flags & Internal::Flag_ManualCompletion) == 0);
+            SC_TRY(posixSendDatagrams(async));
+            if (async.numDatagramsSent < async.datagrams.sizeInElements())
+            {
+                async.flags |= Internal::Flag_WatcherSet;
+                return Result(setEventWatcher(eventLoop, async, async.handle, OUTPUT_EVENTS_MASK));
+            }
+            // All datagrams have been sent synchronously so force a manual invocation of its completion
+            async.flags |= Internal::Flag_ManualCompletion;
+            return Result(true);
+        }
         return posixWriteActivate(eventLoop, async, WriteApiPosixSendTo{async}, true);
     }
 
@@ -982,6 +1262,10 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
         if (result.getAsync().type == AsyncRequest::Type::SocketReceiveFrom)
         {
             AsyncSocketReceiveFrom& async = static_cast<AsyncSocketReceiveFrom&>(result.getAsync());
+            if (not async.datagrams.empty())
+            {
+                return completeReceiveDatagrams(result, async);
+            }
 
             struct sockaddr* address    = &async.address.handle.reinterpret_as<struct sockaddr>();
             socklen_t        addressLen = async.address.sizeOfHandle();
@@ -1007,6 +1291,25 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
     //-------------------------------------------------------------------------------------------------------
     // Socket RECEIVE FROM
     //-------------------------------------------------------------------------------------------------------
+    static Result completeReceiveDatagrams(AsyncSocketReceive::Result& result, AsyncSocketReceiveFrom& async)
+    {
+        size_t numReceived = 0;
+        SC_TRY(posixReceiveDatagrams(async.handle, async.datagrams, numReceived));
+        if (numReceived == 0)
+        {
+            // Spurious wake-up, skip user callback and keep waiting for datagrams
+            result.shouldCallCallback = false;
+            result.reactivateRequest(true);
+            return Result(true);
+        }
+        result.completionData.numDatagrams = numReceived;
+        for (size_t idx = 0; idx < numReceived; ++idx)
+        {
+            result.completionData.numBytes += async.datagrams[idx].numBytes;
+        }
+        return Result(true);
+    }
+
     Result setupAsync(AsyncEventLoop& eventLoop, AsyncSocketReceiveFrom& async)
     {
         return setupAsync(eventLoop, static_cast<AsyncSocketReceive&>(async));
@@ -1310,23 +1613,33 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
     //-------------------------------------------------------------------------------------------------------
     Result setupAsync(AsyncEventLoop& eventLoop, AsyncFileReadiness& async)
     {
+        // Remember the watched direction in flags, as teardown doesn't have access to the request
+        if (async.mode == AsyncFileReadiness::Mode::Writable)
+        {
+            async.flags |= Internal::Flag_WatchWritable;
+        }
+        else
+        {
+            async.flags &= ~Internal::Flag_WatchWritable;
+        }
+        const auto mask = (async.flags & Internal::Flag_WatchWritable) ? OUTPUT_EVENTS_MASK : INPUT_EVENTS_MASK;
 #if SC_ASYNC_USE_EPOLL
-        return setEventWatcher(eventLoop, async, async.handle, INPUT_EVENTS_MASK);
+        return setEventWatcher(eventLoop, async, async.handle, mask);
 #else
         if ((async.flags & Internal::Flag_InternalWakeUpUserEvent) != 0)
         {
             return setEventWatcher(eventLoop, async, async.handle, EVFILT_USER, 0, EV_ADD | EV_CLEAR);
         }
-        return setEventWatcher(eventLoop, async, async.handle, INPUT_EVENTS_MASK);
+        return setEventWatcher(eventLoop, async, async.handle, mask);
 #endif
     }
 
     static Result teardownAsync(AsyncFileReadiness* async, AsyncTeardown& teardown)
     {
+        const auto mask = (teardown.flags & Internal::Flag_WatchWritable) ? OUTPUT_EVENTS_MASK : INPUT_EVENTS_MASK;
 #if SC_ASYNC_USE_EPOLL
         (void)async;
-        return KernelQueuePosix::stopSingleWatcherImmediate(*teardown.eventLoop, teardown.fileHandle,
-                                                            INPUT_EVENTS_MASK);
+        return KernelQueuePosix::stopSingleWatcherImmediate(*teardown.eventLoop, teardown.fileHandle, mask);
 #else
         const bool isInternalWakeupUserEvent = (teardown.flags & Internal::Flag_InternalWakeUpUserEvent) != 0 or
                                                (async and (async->flags & Internal::Flag_InternalWakeUpUserEvent) != 0);
@@ -1335,8 +1648,7 @@ struct SC::AsyncEventLoop::Internal::KernelEventsPosix
             return KernelQueuePosix::stopSingleWatcherImmediate(
                 *teardown.eventLoop, static_cast<SocketDescriptor::Handle>(teardown.fileHandle), EVFILT_USER);
         }
-        return KernelQueuePosix::stopSingleWatcherImmediate(*teardown.eventLoop, teardown.fileHandle,
-                                                            INPUT_EVENTS_MASK);
+        return KernelQueuePosix::stopSingleWatcherImmediate(*teardown.eventLoop, teardown.fileHandle, mask);
 #endif
     }
 
@@ -523,9 +523,12 @@ struct SC::AsyncEventLoop::Internal::KernelEvents
 
         const int sockAddrLen = asyncConnect.ipAddress.sizeOfHandle();
 
+        // Data is sent with the SYN only when TCP_FASTOPEN has been set, otherwise right after connecting
+        void* sendBuffer = const_cast<char*>(asyncConnect.fastOpenData.data());
+        DWORD sendLength = static_cast<DWORD>(asyncConnect.fastOpenData.sizeInBytes());
         DWORD dummyTransferred;
         BOOL  connectRes = reinterpret_cast<LPFN_CONNECTEX>(asyncConnect.pConnectEx)(
-            asyncConnect.handle, sockAddr, sockAddrLen, nullptr, 0, &dummyTransferred, &overlapped);
+            asyncConnect.handle, sockAddr, sockAddrLen, sendBuffer, sendLength, &dummyTransferred, &overlapped);
         if (connectRes == FALSE and WSAGetLastError() != WSA_IO_PENDING)
         {
             return Result::Error("ConnectEx failed");
@@ -537,7 +540,8 @@ struct SC::AsyncEventLoop::Internal::KernelEvents
     static Result completeAsync(AsyncSocketConnect::Result& result)
     {
         AsyncSocketConnect& operation = result.getAsync();
-        SC_TRY(KernelQueue::checkWSAResult(operation.handle, operation.overlapped.get().overlapped));
+        SC_TRY(KernelQueue::checkWSAResult(operation.handle, operation.overlapped.get().overlapped,
+                                           &result.completionData.numBytes));
         return Result(true);
     }
 
@@ -671,6 +671,80 @@ Result AsyncFiberIO::receiveFrom(const SocketDescriptor& socket, Span<char> buff
     return startOperation(counter, request, state.result, startProcedure);
 }
 
+Result AsyncFiberIO::sendTo(const SocketDescriptor& socket, Span<const AsyncSocketSendDatagram> datagrams,
+                            AsyncFiberSocketSendResult* outResult)
+{
+    SC_TRY(checkFiberContext());
+    if (outResult != nullptr)
+    {
+        outResult->numBytes = 0;
+    }
+    if (datagrams.empty())
+    {
+        return Result(true);
+    }
+
+    FiberCounter             counter;
+    AsyncFiberOperationState state;
+    AsyncSocketSendTo        request;
+
+    state.asyncFiber = this;
+    state.counter    = &counter;
+
+    request.callback = [&state, outResult](AsyncSocketSendTo::Result& result)
+    {
+        state.result = result.isValid();
+        if (outResult != nullptr and state.result)
+        {
+            outResult->numBytes = result.completionData.numBytes;
+        }
+        state.asyncFiber->operationFinished();
+        SC_ASYNC_FIBERS_TRUST_RESULT(state.asyncFiber->fiberScheduler().done(*state.counter));
+    };
+
+    struct StartContext
+    {
+        AsyncSocketSendTo*                  request = nullptr;
+        const SocketDescriptor*             socket  = nullptr;
+        Span<const AsyncSocketSendDatagram> datagrams;
+    };
+    StartContext                      startContext{&request, &socket, datagrams};
+    Function<Result(AsyncEventLoop&)> startProcedure = [&startContext](AsyncEventLoop& eventLoop)
+    { return startContext.request->start(eventLoop, *startContext.socket, startContext.datagrams); };
+    return startOperation(counter, request, state.result, startProcedure);
+}
+
+Result AsyncFiberIO::receiveFrom(const SocketDescriptor& socket, Span<AsyncSocketReceiveDatagram> datagrams,
+                                 AsyncFiberSocketReceiveFromResult& outResult)
+{
+    FiberCounter             counter;
+    AsyncFiberOperationState state;
+    AsyncSocketReceiveFrom   request;
+
+    state.asyncFiber = this;
+    state.counter    = &counter;
+    outResult        = {};
+
+    request.callback = [&state, &outResult](AsyncSocketReceiveFrom::Result& result)
+    {
+        state.result        = result.isValid();
+        outResult.datagrams = result.getDatagrams();
+        state.asyncFiber->operationFinished();
+        SC_ASYNC_FIBERS_TRUST_RESULT(state.asyncFiber->fiberScheduler().done(*state.counter));
+    };
+
+    struct StartContext
+    {
+        AsyncSocketReceiveFrom*          request = nullptr;
+        const SocketDescriptor*          socket  = nullptr;
+        Span<AsyncSocketReceiveDatagram> datagrams;
+    };
+    StartContext                      startContext{&request, &socket, datagrams};
+    Function<Result(AsyncEventLoop&)> startProcedure = [&startContext](AsyncEventLoop& eventLoop)
+    { return startContext.request->start(eventLoop, *startContext.socket, startContext.datagrams); };
+    return startOperation(counter, request, state.result, startProcedure);
+}
+
 Result AsyncFiberIO::fileReadImpl(const FileDescriptor& file, Span<char> buffer, AsyncFiberFileReadResult& outResult,
                                   uint64_t offset, bool useOffset)
 {
@@ -50,6 +50,8 @@ struct AsyncFiberSocketReceiveFromResult
 {
     Span<char>      data;
     SocketIPAddress sourceAddress;
+
+    Span<AsyncSocketReceiveDatagram> datagrams; ///< Received datagrams (batched receiveFrom only)
 };
 
 struct AsyncFiberFileReadResult
@@ -128,7 +130,11 @@ struct SC_ASYNC_FIBERS_EXPORT AsyncFiberIO
                    AsyncFiberSocketSendResult* outResult = nullptr);
     Result sendTo(const SocketDescriptor& socket, SocketIPAddress address, Span<const char> data,
                   AsyncFiberSocketSendResult* outResult = nullptr);
+    Result sendTo(const SocketDescriptor& socket, Span<const AsyncSocketSendDatagram> datagrams,
+                  AsyncFiberSocketSendResult* outResult = nullptr);
     Result receiveFrom(const SocketDescriptor& socket, Span<char> buffer, AsyncFiberSocketReceiveFromResult& outResult);
+    Result receiveFrom(const SocketDescriptor& socket, Span<AsyncSocketReceiveDatagram> datagrams,
+                       AsyncFiberSocketReceiveFromResult& outResult);
     Result fileRead(const FileDescriptor& file, Span<char> buffer, AsyncFiberFileReadResult& outResult);
     Result fileReadAt(const FileDescriptor& file, uint64_t offset, Span<char> buffer,
                       AsyncFiberFileReadResult& outResult);
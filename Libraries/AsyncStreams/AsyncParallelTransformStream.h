@@ -0,0 +1,317 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../Common/CompilerMinMax.h"
+#include "AsyncStreams.h"
+
+namespace SC
+{
+//! @addtogroup group_async_streams
+//! @{
+
+/// @brief A duplex stream transforming independent chunks of data concurrently on a thread pool, in order.
+/// @n
+/// Every written buffer is split in one or more chunks, each one processed by one of the caller provided Chunk slots
+/// through a `LoopWork` running on the thread pool. Multiple chunks are in flight at the same time, and their output
+/// is pushed downstream in the same order they have been written, as soon as all previous chunks are done.
+/// When all slots are busy (or no output buffer is available) the stream applies backpressure upstream.
+/// @n
+/// Derived classes implement the transformation with the following virtual functions:
+/// - onProcessChunk transforms a chunk (runs on the thread pool, and it must only access the given chunk state)
+/// - getMaxChunkInputSize tells how much input can be processed into an output buffer of a given size
+/// - onChunkCompleted (optional) is invoked on the event loop thread for each chunk, in order
+/// - onFinalize writes trailing data on the event loop thread when the writable side is ended
+/// @note The readable request queue must be large enough to hold the output of all Chunk slots
+/// @tparam T_AsyncEventLoop The event loop type (typically SC::AsyncEventLoop) providing `LoopWork`
+/// @tparam T_ChunkState Per-slot state type, accessed by a single chunk at a time
+template <typename T_AsyncEventLoop, typename T_ChunkState>
+struct AsyncParallelTransformStreamT : public AsyncDuplexStream
+{
+    struct Chunk
+    {
+        T_ChunkState state; ///< State of this slot, used by one chunk at a time
+
+      private:
+        friend struct AsyncParallelTransformStreamT;
+        using LoopWork = typename T_AsyncEventLoop::LoopWork;
+
+        LoopWork work;
+
+        AsyncParallelTransformStreamT* stream = nullptr;
+
+        AsyncBufferView::ID inputBufferID;
+        AsyncBufferView::ID outputBufferID;
+
+        Span<const char> input;
+        Span<char>       output;
+
+        size_t   outputSize = 0;
+        uint64_t sequence   = 0;
+        bool     busy       = false;
+        bool     done       = false;
+        Result   result     = Result(true);
+
+        Result run() { return stream->onProcessChunk(state, sequence, input, output); }
+
+        void afterRun(typename LoopWork::Result& res)
+        {
+            result = res.isValid();
+            done   = true;
+            stream->emitCompletedChunks();
+        }
+    };
+
+    /// @brief Inits the stream with caller provided queues and chunk slots.
+    /// Can be called again to reuse the stream once a previous transformation has been finalized.
+    /// @param buffersPool Pool providing both input and output buffers
+    /// @param readableRequests Queue of output buffers (at least as large as chunkSlots)
+    /// @param writableRequests Queue of input buffers
+    /// @param chunkSlots Slots limiting the number of chunks being transformed concurrently
+    Result init(AsyncBuffersPool& buffersPool, Span<AsyncReadableStream::Request> readableRequests,
+                Span<AsyncWritableStream::Request> writableRequests, Span<Chunk> chunkSlots)
+    {
+        SC_TRY_MSG(not chunkSlots.empty(), "AsyncParallelTransformStreamT::init - no chunk slots");
+        for (Chunk& chunk : chunks)
+        {
+            SC_TRY_MSG(not chunk.busy, "AsyncParallelTransformStreamT::init - chunks still in flight");
+        }
+        SC_TRY(AsyncDuplexStream::init(buffersPool, readableRequests, writableRequests));
+        chunks       = chunkSlots;
+        inputOffset  = 0;
+        nextSequence = 0;
+        nextToEmit   = 0;
+        writing      = false;
+        finalized    = false;
+        for (Chunk& chunk : chunks)
+        {
+            chunk.stream = this;
+            chunk.work.work.template bind<Chunk, &Chunk::run>(chunk);
+            chunk.work.callback.template bind<Chunk, &Chunk::afterRun>(chunk);
+        }
+        return Result(true);
+    }
+
+    /// @brief Sets the event loop used to start chunk works and to receive their completion
+    void setEventLoop(T_AsyncEventLoop& loop) { eventLoop = &loop; }
+
+    /// @brief Sets the thread pool where chunks will be transformed (must be called after init)
+    template <typename T_ThreadPool>
+    Result setThreadPool(T_ThreadPool& threadPool)
+    {
+        for (Chunk& chunk : chunks)
+        {
+            SC_TRY(chunk.work.setThreadPool(threadPool));
+        }
+        return Result(true);
+    }
+
+    /// @brief Returns the number of chunks written to the stream so far
+    [[nodiscard]] uint64_t getNumChunks() const { return nextSequence; }
+
+  protected:
+    /// @brief Transforms a chunk. Invoked on the thread pool, so it must only access state and its arguments.
+    /// @param state State of the slot processing this chunk
+    /// @param sequence Zero based index of this chunk in the stream
+    /// @param input Data to transform
+    /// @param output Writable memory receiving transformed data. It must be modified to point to unused memory.
+    virtual Result onProcessChunk(T_ChunkState& state, uint64_t sequence, Span<const char> input,
+                                  Span<char>& output) = 0;
+
+    /// @brief Returns max input size that can be surely transformed into outputSize bytes (`0` if none)
+    virtual size_t getMaxChunkInputSize(size_t outputSize) const = 0;
+
+    /// @brief Invoked on event loop thread for each transformed chunk, in order, before its output is pushed
+    virtual Result onChunkCompleted(T_ChunkState&, size_t) { return Result(true); }
+
+    /// @brief Writes trailing data once all chunks have been transformed and the writable side has ended
+    /// @param output Writable memory receiving data. It must be modified to point to unused memory.
+    virtual Result onFinalize(Span<char>& output) = 0;
+
+  private:
+    T_AsyncEventLoop* eventLoop = nullptr;
+
+    Span<Chunk> chunks;
+
+    AsyncBufferView::ID                 inputBufferID; // Buffer being written, split in chunks
+    Function<void(AsyncBufferView::ID)> inputCallback;
+
+    size_t   inputOffset  = 0; // Bytes of the current input buffer already assigned to chunks
+    uint64_t nextSequence = 0;
+    uint64_t nextToEmit   = 0;
+    bool     writing      = false;
+    bool     finalized    = false;
+
+    virtual Result asyncWrite(AsyncBufferView::ID bufferID, Function<void(AsyncBufferView::ID)> cb) override
+    {
+        SC_TRY_MSG(eventLoop != nullptr, "AsyncParallelTransformStreamT::setEventLoop not called");
+        SC_TRY_MSG(not writing, "AsyncParallelTransformStreamT::asyncWrite - write already in progress");
+        writing       = true;
+        inputBufferID = bufferID;
+        inputCallback = move(cb);
+        inputOffset   = 0;
+        return dispatchInput();
+    }
+
+    virtual Result asyncRead() override
+    {
+        // Invoked also when resuming the readable side, paused by getBufferOrPause in dispatchInput
+        AsyncWritableStream::tryAsync(dispatchInput());
+        return Result(true);
+    }
+
+    // Assigns chunks of the buffer being written to free slots, finishing the write once it has been fully assigned.
+    // The write stays in flight when slots or output buffers are exhausted, applying backpressure upstream.
+    Result dispatchInput()
+    {
+        if (not writing)
+        {
+            return Result(true);
+        }
+        AsyncBuffersPool& buffersPool = AsyncReadableStream::getBuffersPool();
+
+        Span<const char> inputData;
+        SC_TRY(buffersPool.getReadableData(inputBufferID, inputData));
+        while (inputOffset < inputData.sizeInBytes())
+        {
+            Chunk* chunk = findFreeChunk();
+            if (chunk == nullptr or not getBufferOrPause(0, chunk->outputBufferID, chunk->output))
+            {
+                return Result(true); // Retry when a chunk completes or when readable side is resumed
+            }
+            const size_t maxInputSize = getMaxChunkInputSize(chunk->output.sizeInBytes());
+            const size_t inputSize    = min(inputData.sizeInBytes() - inputOffset, maxInputSize);
+
+            Result res = Result::Error("AsyncParallelTransformStreamT - output buffer is too small");
+            if (inputSize > 0 and inputData.sliceStartLength(inputOffset, inputSize, chunk->input))
+            {
+                chunk->outputSize = chunk->output.sizeInBytes();
+                chunk->sequence   = nextSequence;
+                chunk->done       = false;
+                res               = chunk->work.start(*eventLoop);
+            }
+            if (not res)
+            {
+                buffersPool.unrefBuffer(chunk->outputBufferID);
+                chunk->outputBufferID = {};
+                return res;
+            }
+            buffersPool.refBuffer(inputBufferID); // unrefBuffer in emitCompletedChunks
+            chunk->inputBufferID = inputBufferID;
+            chunk->busy          = true;
+            nextSequence++;
+            inputOffset += inputSize;
+        }
+        auto cb       = move(inputCallback);
+        inputCallback = {};
+        inputOffset   = 0;
+        writing       = false;
+        AsyncWritableStream::finishedWriting(inputBufferID, move(cb), Result(true));
+        return Result(true);
+    }
+
+    virtual bool canEndWritable() override
+    {
+        if (finalized)
+        {
+            return true;
+        }
+        if (writing)
+        {
+            return false; // dispatchInput will finish writing, that will check again
+        }
+        for (const Chunk& chunk : chunks)
+        {
+            if (chunk.busy)
+            {
+                return false; // emitCompletedChunks will resume writing, that will check again
+            }
+        }
+        AsyncBufferView::ID bufferID;
+        Span<char>          data;
+        if (not getBufferOrPause(0, bufferID, data))
+        {
+            return false; // Retry when downstream releases a buffer
+        }
+        Span<char>   output = data;
+        const Result res    = onFinalize(output);
+        const size_t size   = data.sizeInBytes() - output.sizeInBytes();
+        if (res and size > 0)
+        {
+            (void)AsyncReadableStream::push(bufferID, size);
+        }
+        AsyncReadableStream::getBuffersPool().unrefBuffer(bufferID);
+        finalized = true;
+        if (res)
+        {
+            AsyncReadableStream::pushEnd();
+        }
+        else
+        {
+            AsyncWritableStream::emitError(res);
+        }
+        return true;
+    }
+
+    Chunk* findFreeChunk()
+    {
+        for (Chunk& chunk : chunks)
+        {
+            if (not chunk.busy)
+            {
+                return &chunk;
+            }
+        }
+        return nullptr;
+    }
+
+    Chunk* findChunk(uint64_t sequence)
+    {
+        for (Chunk& chunk : chunks)
+        {
+            if (chunk.busy and chunk.sequence == sequence)
+            {
+                return &chunk;
+            }
+        }
+        return nullptr;
+    }
+
+    void emitCompletedChunks()
+    {
+        AsyncBuffersPool& buffersPool = AsyncReadableStream::getBuffersPool();
+        for (Chunk* chunk = findChunk(nextToEmit); chunk != nullptr and chunk->done; chunk = findChunk(nextToEmit))
+        {
+            nextToEmit++;
+            Result res = chunk->result;
+            if (res)
+            {
+                res = onChunkCompleted(chunk->state, chunk->input.sizeInBytes());
+            }
+            const size_t outputSize = chunk->outputSize - chunk->output.sizeInBytes();
+            if (res and outputSize > 0 and not AsyncReadableStream::hasBeenDestroyed())
+            {
+                // Ignore whatever push returns, as backpressure is handled when requesting output buffers
+                (void)AsyncReadableStream::push(chunk->outputBufferID, outputSize);
+            }
+            buffersPool.unrefBuffer(chunk->outputBufferID);
+            buffersPool.unrefBuffer(chunk->inputBufferID);
+            chunk->outputBufferID = {};
+            chunk->inputBufferID  = {};
+            chunk->input          = {};
+            chunk->output         = {};
+            chunk->busy           = false;
+            if (not res)
+            {
+                AsyncWritableStream::emitError(res);
+            }
+        }
+        if (not AsyncWritableStream::hasBeenDestroyed())
+        {
+            AsyncWritableStream::tryAsync(dispatchInput()); // Assign free slots to the write in flight
+            AsyncWritableStream::resumeWriting();           // End the writable side if it's waiting for chunks
+        }
+    }
+};
+
+//! @}
+} // namespace SC
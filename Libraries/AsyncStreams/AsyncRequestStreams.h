@@ -9,6 +9,62 @@ namespace SC
 {
 struct AsyncResult;
 
+/// @brief Moves bytes between two descriptors through a kernel pipe with `splice`, without copying them to user space.
+/// Both descriptors should be non-blocking sockets or pipes, but input can also be a regular file.
+/// Only a pipe worth of data is in flight, so a slow output stalls reading input just like a full AsyncBuffersPool.
+/// Used by AsyncRequestReadableStream when AsyncPipeline::zeroCopy is set (Linux only).
+struct SC_ASYNC_STREAMS_EXPORT AsyncKernelSplice
+{
+    /// @brief What transfer is waiting for before it can make further progress
+    enum class Status : uint8_t
+    {
+        WaitInput,  ///< Input has no data available, call transfer again when it becomes readable
+        WaitOutput, ///< Output cannot accept more data, call transfer again when it becomes writable
+        Ended,      ///< Input has been fully read and all data has been written to output
+    };
+
+    AsyncKernelSplice() = default;
+    AsyncKernelSplice(const AsyncKernelSplice&)            = delete;
+    AsyncKernelSplice& operator=(const AsyncKernelSplice&) = delete;
+    ~AsyncKernelSplice() { close(); }
+
+    /// @brief Creates the intermediate pipe used to move data from input to output
+    /// @param inputDescriptor Socket, pipe or regular file to read from
+    /// @param outputDescriptor Socket or pipe to write to
+    /// @note A regular file is read from its current position, like AsyncFileRead does when no offset is set
+    Result open(int inputDescriptor, int outputDescriptor);
+
+    /// @brief Moves as much data as possible without blocking, reporting what to wait for before calling it again
+    Result transfer(Status& status);
+
+    /// @brief Closes the intermediate pipe
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return pipeRead >= 0; }
+
+    /// @brief Returns the output descriptor passed to AsyncKernelSplice::open
+    [[nodiscard]] int getOutput() const { return output; }
+
+    /// @brief Returns total number of bytes written to output
+    [[nodiscard]] uint64_t getBytesTransferred() const { return bytesTransferred; }
+
+  private:
+    struct Internal;
+
+    int input     = -1;
+    int output    = -1;
+    int pipeRead  = -1;
+    int pipeWrite = -1;
+
+    uint64_t bytesTransferred = 0;
+    size_t   pendingBytes     = 0; // Bytes already moved to the pipe but not yet written to output
+
+    bool   inputRegularFile = false;
+    bool   inputBlocking    = false;
+    bool   inputEnded       = false;
+    Status lastStatus       = Status::WaitInput;
+};
+
 template <typename AsyncRequestType, typename AsyncEventLoopType>
 struct AsyncRequestReadableStream : public AsyncReadableStream
 {
@@ -27,8 +83,71 @@ struct AsyncRequestReadableStream : public AsyncReadableStream
     BufferViewID        bufferID;
     bool                autoCloseDescriptor = false;
 
+#if SC_PLATFORM_LINUX
+    using FileReadiness = typename AsyncEventLoopType::FileReadiness;
+
+    FileReadiness     spliceReadiness;
+    AsyncKernelSplice splice;
+
+    virtual bool asyncSplice(int outputDescriptor) override
+    {
+        // Splice reads from the current file position, so a read offset falls back to the buffered path
+        return eventLoop != nullptr and request.isFree() and getReadOffset(request, 0) == 0 and
+               splice.open(request.handle, outputDescriptor);
+    }
+
+    // Only AsyncFileRead has a read offset, other requests (like AsyncSocketReceive) always read in order
+    template <typename T>
+    static auto getReadOffset(const T& readRequest, int) -> decltype(readRequest.getOffset())
+    {
+        return readRequest.getOffset();
+    }
+
+    template <typename T>
+    static uint64_t getReadOffset(const T&, long)
+    {
+        return 0;
+    }
+
+    Result continueSplice()
+    {
+        AsyncKernelSplice::Status status;
+        SC_TRY(splice.transfer(status));
+        switch (status)
+        {
+        case AsyncKernelSplice::Status::Ended: this->pushEnd(); break;
+        case AsyncKernelSplice::Status::WaitInput:
+            spliceReadiness.callback.template bind<Self, &Self::afterSpliceReady>(*this);
+            return spliceReadiness.start(*eventLoop, request.handle, FileReadiness::Mode::Readable);
+        case AsyncKernelSplice::Status::WaitOutput:
+            spliceReadiness.callback.template bind<Self, &Self::afterSpliceReady>(*this);
+            return spliceReadiness.start(*eventLoop, splice.getOutput(), FileReadiness::Mode::Writable);
+        }
+        return Result(true);
+    }
+
+    void afterSpliceReady(typename FileReadiness::Result& result)
+    {
+        Result res = result.isValid();
+        if (res)
+        {
+            res = continueSplice();
+        }
+        if (not res)
+        {
+            this->emitError(res);
+        }
+    }
+#endif
+
     virtual Result asyncRead() override
     {
+#if SC_PLATFORM_LINUX
+        if (splice.isOpen())
+        {
+            return continueSplice(); // Data is moved by the kernel, so no eventData will ever be emitted
+        }
+#endif
         SC_ASYNC_STREAMS_ASSERT_RELEASE(request.isFree());
         if (this->getBufferOrPause(0, bufferID, request.buffer))
         {
@@ -47,6 +166,12 @@ struct AsyncRequestReadableStream : public AsyncReadableStream
 
     virtual Result asyncDestroyReadable() override
     {
+#if SC_PLATFORM_LINUX
+        if (not spliceReadiness.isFree())
+        {
+            return spliceReadiness.stop(*eventLoop, &getSpliceStopCallback());
+        }
+#endif
         if (request.isFree())
         {
             finalizeReadableDestruction();
@@ -110,6 +235,9 @@ struct AsyncRequestReadableStream : public AsyncReadableStream
         {
             SC_ASYNC_STREAMS_ASSERT_RELEASE(request.closeHandle());
         }
+#if SC_PLATFORM_LINUX
+        splice.close();
+#endif
         SC_ASYNC_STREAMS_ASSERT_RELEASE(this->finishedDestroyingReadable());
         request = {};
     }
@@ -122,10 +250,23 @@ struct AsyncRequestReadableStream : public AsyncReadableStream
         stream.finalizeReadableDestruction();
         SC_COMPILER_WARNING_POP_OFFSETOF;
     }
+#if SC_PLATFORM_LINUX
+    template <typename T_AsyncResult>
+    static void stopSpliceCallback(T_AsyncResult& result)
+    {
+        SC_COMPILER_WARNING_PUSH_OFFSETOF;
+        Self& stream = SC_COMPILER_FIELD_OFFSET(Self, spliceReadiness, static_cast<FileReadiness&>(result.async));
+        stream.finalizeReadableDestruction();
+        SC_COMPILER_WARNING_POP_OFFSETOF;
+    }
+#endif
 
   private:
     // clang-format off
     static Function<void(AsyncResult&)>& getStopCallback() { static Function<void(AsyncResult&)> cb = &stopReadableCallback<AsyncResult>; return cb; }
+#if SC_PLATFORM_LINUX
+    static Function<void(AsyncResult&)>& getSpliceStopCallback() { static Function<void(AsyncResult&)> cb = &stopSpliceCallback<AsyncResult>; return cb; }
+#endif
     // clang-format on
 
   public:
@@ -190,6 +331,14 @@ struct AsyncRequestWritableStream : public AsyncWritableStream
 
     virtual bool canEndWritable() override { return request.isFree(); }
 
+#if SC_PLATFORM_LINUX
+    virtual bool getSpliceDescriptor(int& descriptor) override
+    {
+        descriptor = request.handle;
+        return true;
+    }
+#endif
+
     void afterWrite(typename AsyncRequestType::Result& result)
     {
         BufferViewID savedBufferID = bufferID;
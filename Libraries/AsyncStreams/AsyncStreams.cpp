@@ -5,6 +5,9 @@
 #define SC_ASSERT_PROVIDER AsyncStreamsAssert
 #include "../Common/Assert.inl"
 
+#include "AsyncRequestStreams.h"
+#include "Internal/AsyncKernelSplice.inl"
+#include "Internal/CodecStreams.inl"
 #include "Internal/ZLibStream.inl"
 #include "ZLibTransformStreams.h"
 
@@ -13,10 +16,169 @@ namespace SC
 //-------------------------------------------------------------------------------------------------------
 // AsyncBufferView
 //-------------------------------------------------------------------------------------------------------
+namespace
+{
+// Free lists are indexed by floor(log2(size)), so every buffer in a class larger than the one of a requested size fits
+uint8_t scAsyncBuffersPoolSizeClass(size_t sizeInBytes)
+{
+    uint8_t sizeClass = 0;
+    while (sizeInBytes > 1 and sizeClass < 31)
+    {
+        sizeInBytes >>= 1;
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+// Writable and Growable buffers are handed out by requestNewBuffer once their reference count drops to zero
+bool scAsyncBuffersPoolIsFree(const AsyncBufferView& buffer)
+{
+    return buffer.getType() == AsyncBufferView::Type::Writable or buffer.getType() == AsyncBufferView::Type::Growable;
+}
+} // namespace
+
+void AsyncBuffersPool::buildLists()
+{
+    freeClassesMask = 0;
+    emptyHead       = -1;
+    numFree         = 0;
+    numEmpty        = 0;
+    freeBytes       = 0;
+    listsBuilt      = true;
+    // Walking backwards leaves lower indices at the head of each list, so that they're handed out first
+    for (size_t idx = buffers.sizeInElements(); idx > 0; --idx)
+    {
+        const int32_t    index  = static_cast<int32_t>(idx - 1);
+        AsyncBufferView& buffer = buffers[idx - 1];
+
+        buffer.listed = false;
+        if (buffer.type == AsyncBufferView::Type::Empty)
+        {
+            linkEmpty(index);
+        }
+        else if (buffer.refs == 0 and scAsyncBuffersPoolIsFree(buffer))
+        {
+            linkFree(index);
+        }
+    }
+}
+
+void AsyncBuffersPool::linkFree(int32_t index)
+{
+    AsyncBufferView& buffer = buffers[static_cast<size_t>(index)];
+    if (buffer.getType() == AsyncBufferView::Type::Growable)
+    {
+        // Growable storage could have been resized while in use, so its size class must be computed again
+        AsyncBufferView::GrowableStorage storage;
+
+        auto da             = buffer.getGrowableBuffer(storage, true)->getDirectAccess();
+        buffer.writableData = {static_cast<char*>(da.data), da.sizeInBytes};
+        (void)buffer.getGrowableBuffer(storage, false); // destruct
+    }
+    const size_t size = buffer.writableData.sizeInBytes();
+    const uint8_t    sc     = scAsyncBuffersPoolSizeClass(size);
+
+    const bool    classEmpty = (freeClassesMask & (1u << sc)) == 0;
+    const int32_t head       = classEmpty ? -1 : freeHeads[sc];
+
+    buffer.listed     = true;
+    buffer.sizeClass  = sc;
+    buffer.prevInList = -1;
+    buffer.nextInList = head;
+    if (head >= 0)
+    {
+        buffers[static_cast<size_t>(head)].prevInList = index;
+    }
+    freeHeads[sc] = index;
+    freeClassesMask |= 1u << sc;
+    numFree++;
+    freeBytes += size;
+}
+
+void AsyncBuffersPool::linkEmpty(int32_t index)
+{
+    AsyncBufferView& buffer = buffers[static_cast<size_t>(index)];
+
+    buffer.listed     = true;
+    buffer.prevInList = -1;
+    buffer.nextInList = emptyHead;
+    if (emptyHead >= 0)
+    {
+        buffers[static_cast<size_t>(emptyHead)].prevInList = index;
+    }
+    emptyHead = index;
+    numEmpty++;
+}
+
+void AsyncBuffersPool::unlink(int32_t index)
+{
+    AsyncBufferView& buffer = buffers[static_cast<size_t>(index)];
+    SC_ASYNC_STREAMS_ASSERT_RELEASE(buffer.listed);
+    const bool isEmpty = buffer.type == AsyncBufferView::Type::Empty;
+    if (buffer.prevInList >= 0)
+    {
+        buffers[static_cast<size_t>(buffer.prevInList)].nextInList = buffer.nextInList;
+    }
+    else if (isEmpty)
+    {
+        emptyHead = buffer.nextInList;
+    }
+    else
+    {
+        freeHeads[buffer.sizeClass] = buffer.nextInList;
+        if (buffer.nextInList < 0)
+        {
+            freeClassesMask &= ~(1u << buffer.sizeClass);
+        }
+    }
+    if (buffer.nextInList >= 0)
+    {
+        buffers[static_cast<size_t>(buffer.nextInList)].prevInList = buffer.prevInList;
+    }
+    buffer.listed     = false;
+    buffer.nextInList = -1;
+    buffer.prevInList = -1;
+    if (isEmpty)
+    {
+        numEmpty--;
+    }
+    else
+    {
+        numFree--;
+        freeBytes -= buffer.writableData.sizeInBytes();
+    }
+    const size_t numInUse = buffers.sizeInElements() - numEmpty - numFree;
+    if (numInUse > peakInUse)
+    {
+        peakInUse = numInUse;
+    }
+}
+
+void AsyncBuffersPool::recycle(int32_t index)
+{
+    AsyncBufferView& buffer = buffers[static_cast<size_t>(index)];
+    if (buffer.type == AsyncBufferView::Type::Empty)
+    {
+        linkEmpty(index);
+    }
+    else if (scAsyncBuffersPoolIsFree(buffer))
+    {
+        linkFree(index);
+    }
+}
+
 void AsyncBuffersPool::refBuffer(AsyncBufferView::ID bufferID)
 {
     AsyncBufferView* buffer = getBuffer(bufferID);
     SC_ASYNC_STREAMS_ASSERT_RELEASE(buffer);
+    if (not listsBuilt)
+    {
+        buildLists();
+    }
+    if (buffer->listed)
+    {
+        unlink(bufferID.identifier);
+    }
     buffer->refs++;
 }
 
@@ -25,6 +187,10 @@ void AsyncBuffersPool::unrefBuffer(AsyncBufferView::ID bufferID)
     AsyncBufferView* buffer = getBuffer(bufferID);
     SC_ASYNC_STREAMS_ASSERT_RELEASE(buffer);
     SC_ASYNC_STREAMS_ASSERT_RELEASE(buffer->refs != 0);
+    if (not listsBuilt)
+    {
+        buildLists();
+    }
     buffer->refs--;
     if (buffer->refs == 0)
     {
@@ -50,6 +216,7 @@ void AsyncBuffersPool::unrefBuffer(AsyncBufferView::ID bufferID)
         {
             *buffer = {};
         }
+        recycle(bufferID.identifier);
     }
 }
 
@@ -128,7 +295,17 @@ Result AsyncBuffersPool::getWritableData(AsyncBufferView::ID bufferID, Span<char
         }
         break;
     }
-    default: return Result::Error("AsyncBuffersPool::getWritableData - Readonly or Growable buffer");
+    case AsyncBufferView::Type::Growable: {
+        AsyncBufferView::GrowableStorage storage;
+
+        auto       da       = buffer->getGrowableBuffer(storage, true)->getDirectAccess();
+        Span<char> fullData = {static_cast<char*>(da.data), da.sizeInBytes};
+        const bool sliced   = fullData.sliceStartLength(buffer->offset, buffer->length, data);
+        (void)buffer->getGrowableBuffer(storage, false); // destruct
+        SC_TRY(sliced);
+        break;
+    }
+    default: return Result::Error("AsyncBuffersPool::getWritableData - Readonly buffer");
     }
     return Result(true);
 }
@@ -145,33 +322,73 @@ AsyncBufferView* AsyncBuffersPool::getBuffer(AsyncBufferView::ID bufferID)
 
 Result AsyncBuffersPool::requestNewBuffer(size_t minimumSizeInBytes, AsyncBufferView::ID& bufferID, Span<char>& data)
 {
-    for (AsyncBufferView& buffer : buffers)
+    if (not listsBuilt)
     {
-        if (buffer.type == AsyncBufferView::Type::Empty)
-            continue;
-        if (buffer.refs == 0)
-        {
-            if (buffer.type == AsyncBufferView::Type::Growable)
-            {
-                AsyncBufferView::GrowableStorage storage;
+        buildLists();
+    }
+    const uint8_t  sc            = scAsyncBuffersPoolSizeClass(minimumSizeInBytes);
+    const bool     sameClass     = (freeClassesMask & (1u << sc)) != 0;
+    const uint32_t largerClasses = sc < 31 ? freeClassesMask & ~((2u << sc) - 1) : 0;
 
-                auto da             = buffer.getGrowableBuffer(storage, true)->getDirectAccess();
-                buffer.writableData = {static_cast<char*>(da.data), da.sizeInBytes};
-                (void)buffer.getGrowableBuffer(storage, false); // destruct
-            }
-            if (buffer.writableData.sizeInBytes() >= minimumSizeInBytes)
+    int32_t found = -1;
+    // Head of the same size class is the most recently released buffer (likely still in cache)
+    if (sameClass and buffers[static_cast<size_t>(freeHeads[sc])].writableData.sizeInBytes() >= minimumSizeInBytes)
+    {
+        found = freeHeads[sc];
+    }
+    else if (largerClasses != 0)
+    {
+        // Any buffer of the smallest non-empty larger class fits
+        uint8_t largerClass = static_cast<uint8_t>(sc + 1);
+        while ((largerClasses & (1u << largerClass)) == 0)
+        {
+            largerClass++;
+        }
+        found = freeHeads[largerClass];
+    }
+    else if (sameClass)
+    {
+        // Only buffers of the same size class can still be large enough
+        for (int32_t idx = freeHeads[sc]; idx >= 0; idx = buffers[static_cast<size_t>(idx)].nextInList)
+        {
+            if (buffers[static_cast<size_t>(idx)].writableData.sizeInBytes() >= minimumSizeInBytes)
             {
-                buffer.refs   = 1;
-                buffer.offset = 0;
-                buffer.length = buffer.writableData.sizeInBytes();
-
-                bufferID =
-                    AsyncBufferView::ID(static_cast<AsyncBufferView::ID::NumericType>(&buffer - buffers.begin()));
-                return getWritableData(bufferID, data);
+                found = idx;
+                break;
             }
         }
     }
-    return Result::Error("AsyncBuffersPool::requestNewBuffer failed");
+    if (found < 0)
+    {
+        failedRequests++;
+        return Result::Error("AsyncBuffersPool::requestNewBuffer failed");
+    }
+    unlink(found);
+    AsyncBufferView& buffer = buffers[static_cast<size_t>(found)];
+
+    buffer.refs   = 1;
+    buffer.offset = 0;
+    buffer.length = buffer.writableData.sizeInBytes();
+
+    bufferID = AsyncBufferView::ID(static_cast<AsyncBufferView::ID::NumericType>(found));
+    return getWritableData(bufferID, data);
+}
+
+AsyncBuffersPool::Statistics AsyncBuffersPool::getStatistics()
+{
+    if (not listsBuilt)
+    {
+        buildLists();
+    }
+    Statistics stats;
+    stats.numBuffers     = buffers.sizeInElements();
+    stats.numEmpty       = numEmpty;
+    stats.numFree        = numFree;
+    stats.numInUse       = buffers.sizeInElements() - numEmpty - numFree;
+    stats.freeBytes      = freeBytes;
+    stats.peakInUse      = peakInUse > stats.numInUse ? peakInUse : stats.numInUse;
+    stats.failedRequests = failedRequests;
+    return stats;
 }
 
 void AsyncBuffersPool::setNewBufferSize(AsyncBufferView::ID bufferID, size_t newSizeInBytes)
@@ -225,25 +442,28 @@ void AsyncBuffersPool::setNewBufferSize(AsyncBufferView::ID bufferID, size_t new
 
 Result AsyncBuffersPool::pushBuffer(AsyncBufferView&& buffer, AsyncBufferView::ID& bufferID)
 {
-    for (size_t idx = 0; idx < buffers.sizeInElements(); ++idx)
+    if (not listsBuilt)
     {
-        if (buffers[idx].getType() == AsyncBufferView::Type::Empty)
-        {
-            if (buffer.type == AsyncBufferView::Type::Growable and buffer.length == 0)
-            {
-                AsyncBufferView::GrowableStorage storage;
+        buildLists();
+    }
+    const int32_t idx = emptyHead;
+    SC_TRY_MSG(idx >= 0, "pushBuffer failed");
+    if (buffer.type == AsyncBufferView::Type::Growable and buffer.length == 0)
+    {
+        AsyncBufferView::GrowableStorage storage;
 
-                auto da       = buffer.getGrowableBuffer(storage, true)->getDirectAccess();
-                buffer.length = da.sizeInBytes;
-                (void)buffer.getGrowableBuffer(storage, false); // destruct
-            }
-            buffer.refs  = 0;
-            buffers[idx] = move(buffer);
-            bufferID     = AsyncBufferView::ID(static_cast<AsyncBufferView::ID::NumericType>(idx));
-            return Result(true);
-        }
+        auto da       = buffer.getGrowableBuffer(storage, true)->getDirectAccess();
+        buffer.length = da.sizeInBytes;
+        (void)buffer.getGrowableBuffer(storage, false); // destruct
     }
-    return Result::Error("pushBuffer failed");
+    unlink(idx);
+    buffer.refs   = 0;
+    buffer.listed = false;
+
+    buffers[static_cast<size_t>(idx)] = move(buffer);
+    recycle(idx);
+    bufferID = AsyncBufferView::ID(static_cast<AsyncBufferView::ID::NumericType>(idx));
+    return Result(true);
 }
 
 Result AsyncBuffersPool::sliceInEqualParts(Span<AsyncBufferView> buffers, Span<char> memory, size_t numSlices)
@@ -297,33 +517,33 @@ Result AsyncBuffersPool::createChildView(AsyncBufferView::ID parentBufferID, siz
     SC_TRY_MSG(rootOffset + length <= rootFullData.sizeInBytes(),
                "AsyncBuffersPool::createChildView - Offset and length out of bounds");
 
-    for (size_t idx = 0; idx < buffers.sizeInElements(); ++idx)
+    if (not listsBuilt)
     {
-        if (buffers[idx].type == AsyncBufferView::Type::Empty)
-        {
-            AsyncBufferView& child = buffers[idx];
-            child.type             = AsyncBufferView::Type::Child;
-            child.parentID         = rootParentID;
-            child.offset           = rootOffset;
-            child.length           = length;
-            child.refs             = 1;
-            // Pre-calculate data span for debugging visibility
-            if (parent->type == AsyncBufferView::Type::ReadOnly)
-            {
-                (void)rootFullData.sliceStartLength(rootOffset, length, child.readonlyData);
-            }
-            else
-            {
-                // Root is Writable or Growable (treated as writable here)
-                Span<char> rootWritableData = {const_cast<char*>(rootFullData.data()), rootFullData.sizeInBytes()};
-                (void)rootWritableData.sliceStartLength(rootOffset, length, child.writableData);
-            }
-            refBuffer(rootParentID); // Increment parent's refcount
-            outChildBufferID = AsyncBufferView::ID(static_cast<AsyncBufferView::ID::NumericType>(idx));
-            return Result(true);
-        }
+        buildLists();
+    }
+    const int32_t idx = emptyHead;
+    SC_TRY_MSG(idx >= 0, "AsyncBuffersPool::createChildView - No space in buffer pool");
+    unlink(idx);
+    AsyncBufferView& child = buffers[static_cast<size_t>(idx)];
+    child.type             = AsyncBufferView::Type::Child;
+    child.parentID         = rootParentID;
+    child.offset           = rootOffset;
+    child.length           = length;
+    child.refs             = 1;
+    // Pre-calculate data span for debugging visibility
+    if (parent->type == AsyncBufferView::Type::ReadOnly)
+    {
+        (void)rootFullData.sliceStartLength(rootOffset, length, child.readonlyData);
     }
-    return Result::Error("AsyncBuffersPool::createChildView - No space in buffer pool");
+    else
+    {
+        // Root is Writable or Growable (treated as writable here)
+        Span<char> rootWritableData = {const_cast<char*>(rootFullData.data()), rootFullData.sizeInBytes()};
+        (void)rootWritableData.sliceStartLength(rootOffset, length, child.writableData);
+    }
+    refBuffer(rootParentID); // Increment parent's refcount
+    outChildBufferID = AsyncBufferView::ID(static_cast<AsyncBufferView::ID::NumericType>(idx));
+    return Result(true);
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -346,6 +566,8 @@ Result AsyncReadableStream::asyncResumeReading() { return Result(true); }
 
 Result AsyncReadableStream::asyncDestroyReadable() { return finishedDestroyingReadable(); }
 
+bool AsyncReadableStream::asyncSplice(int) { return false; }
+
 Result AsyncReadableStream::start()
 {
     SC_TRY_MSG(state == State::CanRead, "Can start only in CanRead state")
@@ -669,6 +891,8 @@ Result AsyncWritableStream::init(AsyncBuffersPool& buffersPool)
 
 bool AsyncWritableStream::canEndWritable() { return true; }
 
+bool AsyncWritableStream::getSpliceDescriptor(int&) { return false; }
+
 Result AsyncWritableStream::asyncDestroyWritable()
 {
     finishedDestroyingWritable();
@@ -731,6 +955,7 @@ void AsyncWritableStream::resumeWriting()
         if (canEndWritable())
         {
             state = State::Ended;
+            eventFinish.emit();
             if (autoDestroy)
             {
                 destroy();
@@ -910,6 +1135,29 @@ Result AsyncDuplexStream::init(AsyncBuffersPool& buffersPool, Span<AsyncReadable
 //-------------------------------------------------------------------------------------------------------
 AsyncTransformStream::AsyncTransformStream() {}
 
+Result AsyncTransformStream::init(AsyncBuffersPool& buffersPool)
+{
+    SC_TRY_MSG(state == State::None or state == State::Finalized,
+               "AsyncTransformStream::init - Can be called only before transforming or after finalization");
+    SC_TRY(AsyncReadableStream::init(buffersPool));
+    SC_TRY(AsyncWritableStream::init(buffersPool));
+    inputCallback  = {};
+    inputData      = {};
+    outputData     = {};
+    inputBufferID  = {};
+    outputBufferID = {};
+    state          = State::None;
+    return Result(true);
+}
+
+Result AsyncTransformStream::init(AsyncBuffersPool& buffersPool, Span<AsyncReadableStream::Request> readableRequests,
+                                  Span<AsyncWritableStream::Request> writableRequests)
+{
+    AsyncReadableStream::setReadQueue(readableRequests);
+    AsyncWritableStream::setWriteQueue(writableRequests);
+    return init(buffersPool);
+}
+
 Result AsyncTransformStream::asyncWrite(AsyncBufferView::ID bufferID, Function<void(AsyncBufferView::ID)> cb)
 {
     switch (state)
@@ -1069,6 +1317,7 @@ Result AsyncPipeline::pipe()
     AsyncReadableStream* readable = source;
     SC_TRY(chainTransforms(readable));
     dispatchReadable = readable;
+    splicing         = zeroCopy and trySplice();
 
     bool res;
     res = readable->eventData.addListener<AsyncPipeline, &AsyncPipeline::dispatchToPipes>(*this);
@@ -1095,6 +1344,7 @@ bool AsyncPipeline::unpipe()
     releasePendingWrites();
     shouldEndWhenDrained = false;
     endingPipes          = false;
+    splicing             = false;
 
     // Deregister all source events
     if (source)
@@ -1194,6 +1444,23 @@ Result AsyncPipeline::start()
 
 void AsyncPipeline::emitError(Result res) { eventError.emit(res); }
 
+bool AsyncPipeline::trySplice()
+{
+    // Source can move data straight to the sink only if nobody else needs to look at it
+    if (dispatchReadable != source or not source->canStart())
+        return false;
+    for (size_t idx = 1; idx < MaxSinks; ++idx)
+    {
+        if (sinks[idx] != nullptr)
+            return false;
+    }
+    // Data already queued on the sink (for example response headers) must be written before the spliced data
+    int descriptor;
+    if (sinks[0] == nullptr or not sinks[0]->isIdle() or not sinks[0]->getSpliceDescriptor(descriptor))
+        return false;
+    return source->asyncSplice(descriptor);
+}
+
 bool AsyncPipeline::hasPendingWrites() const
 {
     for (const PendingWrite& pendingWrite : pendingWrites)
@@ -1538,8 +1805,8 @@ void AsyncPipeline::afterSinkEnd()
         }
         else
         {
-            const bool res = sink->eventFinish.removeListener<AsyncPipeline, &AsyncPipeline::afterSinkEnd>(*this);
-            SC_ASYNC_STREAMS_ASSERT_RELEASE(res);
+            // Sinks that were already idle in endPipes have ended without ever getting this listener
+            (void)sink->eventFinish.removeListener<AsyncPipeline, &AsyncPipeline::afterSinkEnd>(*this);
         }
     }
     if (allEnded)
@@ -169,12 +169,35 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncBufferView
     int32_t refs   = 0;           // Counts AsyncReadable (single) or AsyncWritable (multiple) using it
     Type    type   = Type::Empty; // If it's Empty, Writable, ReadOnly, Growable or Child
     bool    reUse  = false;       // If it can be re-used after refs == 0
+
+    // Intrusive links for AsyncBuffersPool free lists (one per size class) or its list of empty slots
+    bool    listed     = false; // If it's linked in any of the lists of the pool
+    uint8_t sizeClass  = 0;     // Size class of the free list where it has been linked
+    int32_t nextInList = -1;
+    int32_t prevInList = -1;
 };
 
 /// @brief Holds a Span of AsyncBufferView (allocated by user) holding available memory for the streams
 /// @note User must fill the AsyncBuffersPool::buffers with a `Span` of AsyncBufferView
+/// @n
+/// Unreferenced writable and growable buffers are kept in intrusive free lists, one for each power of two size class,
+/// and empty slots in another list, so that requesting, releasing and pushing buffers doesn't scan the whole pool.
+/// The lists are built on first use, so buffers can still be assigned to the span after AsyncBuffersPool::setBuffers,
+/// but it must be called again when re-assigning slots of a span that the pool has already been using.
 struct SC_ASYNC_STREAMS_EXPORT AsyncBuffersPool
 {
+    /// @brief Occupancy statistics returned by AsyncBuffersPool::getStatistics
+    struct Statistics
+    {
+        size_t numBuffers     = 0; ///< Total number of slots in the pool
+        size_t numEmpty       = 0; ///< Slots not holding any buffer
+        size_t numFree        = 0; ///< Unreferenced buffers available to AsyncBuffersPool::requestNewBuffer
+        size_t numInUse       = 0; ///< Slots holding a buffer that is not free
+        size_t freeBytes      = 0; ///< Sum of the sizes of free buffers
+        size_t peakInUse      = 0; ///< Highest numInUse seen by AsyncBuffersPool::requestNewBuffer
+        size_t failedRequests = 0; ///< AsyncBuffersPool::requestNewBuffer calls not finding a large enough buffer
+    };
+
     /// @brief Increments a buffer reference count
     void refBuffer(AsyncBufferView::ID bufferID);
 
@@ -197,14 +220,18 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncBuffersPool
     /// @brief Sets the new size in bytes for the buffer
     void setNewBufferSize(AsyncBufferView::ID bufferID, size_t newSizeInBytes);
 
-    /// @brief Adds a buffer to the pool in any empty slot (found by scanning from start to end)
+    /// @brief Adds a buffer to the pool in any empty slot (taken from the list of empty slots)
     Result pushBuffer(AsyncBufferView&& buffer, AsyncBufferView::ID& bufferID);
 
     /// @brief Splits a span of memory in equally sized slices, assigning them to buffers and marking them as reusable
     static Result sliceInEqualParts(Span<AsyncBufferView> buffers, Span<char> memory, size_t numSlices);
 
     /// @brief Sets memory for the new buffers
-    void setBuffers(Span<AsyncBufferView> newBuffers) { buffers = newBuffers; }
+    void setBuffers(Span<AsyncBufferView> newBuffers)
+    {
+        buffers    = newBuffers;
+        listsBuilt = false;
+    }
 
     /// @brief Gets size of buffers held by the pool
     [[nodiscard]] size_t getNumBuffers() const { return buffers.sizeInElements(); }
@@ -213,9 +240,31 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncBuffersPool
     Result createChildView(AsyncBufferView::ID parentBufferID, size_t offset, size_t length,
                            AsyncBufferView::ID& outChildBufferID);
 
+    /// @brief Obtains pool sizing and occupancy statistics
+    [[nodiscard]] Statistics getStatistics();
+
   private:
+    static constexpr int NumSizeClasses = 32;
+
     /// @brief Span of buffers to be filled in by the user
     Span<AsyncBufferView> buffers;
+
+    int32_t  freeHeads[NumSizeClasses]; // Free lists heads, valid only for classes set in freeClassesMask
+    uint32_t freeClassesMask = 0;       // Bit N is set if free list of size class N is not empty
+    int32_t  emptyHead       = -1;      // Head of the list of Empty slots
+    bool     listsBuilt      = false;
+
+    size_t numFree        = 0;
+    size_t numEmpty       = 0;
+    size_t freeBytes      = 0;
+    size_t peakInUse      = 0;
+    size_t failedRequests = 0;
+
+    void buildLists();
+    void linkFree(int32_t index);
+    void linkEmpty(int32_t index);
+    void unlink(int32_t index);
+    void recycle(int32_t index);
 };
 
 /// @brief Async source abstraction emitting data events in caller provided byte buffers.
@@ -322,7 +371,15 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncReadableStream
     /// @brief Called from inside asyncDestroy to transition from Destroying to Destroyed state (emitting eventClose)
     Result finishedDestroyingReadable();
 
+    /// @brief Function that streams may define to move data directly to a descriptor, without emitting eventData.
+    /// Called by AsyncPipeline (when AsyncPipeline::zeroCopy is set) before the stream is started.
+    /// @return `true` if asyncRead will transfer data to outputDescriptor, calling pushEnd when done.
+    /// Streams must return `false` if they cannot start transferring from their current read position.
+    virtual bool asyncSplice(int outputDescriptor);
+
   private:
+    friend struct AsyncPipeline;
+
     void maybeDestroyEndedReadable();
     void emitOnData();
     void executeRead();
@@ -433,6 +490,9 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncWritableStream
     /// @brief Returns true if this stream is writing something
     [[nodiscard]] bool isStillWriting() const { return state == State::Writing or state == State::Ending; }
 
+    /// @brief Returns true if no write is in flight and the write queue is empty
+    [[nodiscard]] bool isIdle() const { return state == State::Stopped and writeQueue.isEmpty(); }
+
     /// @brief Returns true if the stream has been already destroyed (asynchronously through destroy())
     [[nodiscard]] bool hasBeenDestroyed() const { return destroyed; }
 
@@ -460,6 +520,10 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncWritableStream
     /// @brief Function that MUST be called by re-implementations of asyncDestroyWritable once they're done
     void finishedDestroyingWritable();
 
+    /// @brief Function that streams writing to a socket or pipe may define to allow AsyncPipeline zero-copy transfers
+    /// @return `true` if descriptor has been set to a valid descriptor
+    virtual bool getSpliceDescriptor(int& descriptor);
+
     void stop() { state = State::Stopped; }
 
   private:
@@ -503,6 +567,13 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncTransformStream : public AsyncDuplexStream
 {
     AsyncTransformStream();
 
+    /// @brief Inits the stream with queues set by setReadQueue / setWriteQueue.
+    /// Can be called again to reuse the stream once a previous transformation has been finalized.
+    Result init(AsyncBuffersPool& buffersPool);
+
+    Result init(AsyncBuffersPool& buffersPool, Span<AsyncReadableStream::Request> readableRequests,
+                Span<AsyncWritableStream::Request> writableRequests);
+
     void afterProcess(Span<const char> inputAfter, Span<char> outputAfter);
     void afterFinalize(Span<char> outputAfter, bool streamEnded);
 
@@ -572,6 +643,10 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncPipeline
     AsyncWritableStream* sinks[MaxSinks]           = {nullptr}; /// Provided sinks (at least one must be != nullptr)
     Event<MaxListeners, Result> eventError         = {};        /// Reports errors by source, transforms or sinks
 
+    /// If set, data is moved from source to the single sink inside the kernel (without transforms).
+    /// It falls back to AsyncBufferView copies when source or sink don't support it (see isSplicing).
+    bool zeroCopy = false;
+
     /// @brief Pipes source, transforms and sinks together
     /// @note Caller must have already setup source and sinks (and optionally transforms)
     Result pipe();
@@ -583,6 +658,9 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncPipeline
     /// @note Both source and sinks must have been already setup by the caller
     Result start();
 
+    /// @brief Returns true if pipe() has setup a zero-copy transfer (see AsyncPipeline::zeroCopy)
+    [[nodiscard]] bool isSplicing() const { return splicing; }
+
     // Internal state used by the pipeline implementation.
     AsyncReadableStream* dispatchReadable               = nullptr;
     AsyncReadableStream* transformInputs[MaxTransforms] = {nullptr};
@@ -596,6 +674,7 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncPipeline
     PendingWrite pendingWrites[MaxTransforms + MaxSinks] = {};
     bool         shouldEndWhenDrained                    = false;
     bool         endingPipes                             = false;
+    bool         splicing                                = false;
 
     // TODO: Add a pause and cancel/step
   private:
@@ -603,6 +682,7 @@ struct SC_ASYNC_STREAMS_EXPORT AsyncPipeline
     Result checkBuffersPool();
     Result chainTransforms(AsyncReadableStream*& readable);
     Result validate();
+    bool   trySplice();
 
     void asyncWriteWritable(AsyncBufferView::ID bufferID, AsyncReadableStream& readable, AsyncWritableStream& writable);
     void dispatchToPipes(AsyncBufferView::ID bufferID);
@@ -0,0 +1,99 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "AsyncStreams.h"
+#include "Internal/CodecStreams.h"
+
+namespace SC
+{
+//! @addtogroup group_async_streams
+//! @{
+
+/// @brief A transform stream running a codec on a thread pool through a `LoopWork`.
+/// @n
+/// T_Codec must expose the same `process` / `finalize` interface of SC::ZLibStream (for example SC::ZStdStream,
+/// SC::LZ4Stream or SC::BrotliStream), and it must be inited by the caller before piping data through the stream.
+/// @tparam T_AsyncEventLoop The event loop type (typically SC::AsyncEventLoop) providing `LoopWork`
+/// @tparam T_Codec The codec transforming data
+template <typename T_AsyncEventLoop, typename T_Codec>
+struct AsyncCodecTransformStreamT : public AsyncTransformStream
+{
+    AsyncCodecTransformStreamT()
+    {
+        asyncWork.work.template bind<AsyncCodecTransformStreamT, &AsyncCodecTransformStreamT::work>(*this);
+        asyncWork.callback.template bind<AsyncCodecTransformStreamT, &AsyncCodecTransformStreamT::afterWork>(*this);
+    }
+
+    T_Codec stream; ///< Codec instance, to be inited before starting the transformation
+
+    typename T_AsyncEventLoop::LoopWork asyncWork;
+
+    void setEventLoop(T_AsyncEventLoop& loop) { eventLoop = &loop; }
+
+  private:
+    T_AsyncEventLoop* eventLoop = nullptr;
+
+    virtual Result onProcess(Span<const char> input, Span<char> output) override
+    {
+        SC_ASYNC_STREAMS_ASSERT_RELEASE(not finalizing);
+        savedInput  = input;
+        savedOutput = output;
+        finalizing  = false;
+        SC_TRY_MSG(eventLoop != nullptr, "AsyncCodecTransformStreamT::setEventLoop not called");
+        return asyncWork.start(*eventLoop);
+    }
+
+    virtual Result onFinalize(Span<char> output) override
+    {
+        // Intentionally not resetting savedInput, that can contain leftover data to process
+        savedOutput = output;
+        finalizing  = true;
+        SC_TRY_MSG(eventLoop != nullptr, "AsyncCodecTransformStreamT::setEventLoop not called");
+        return asyncWork.start(*eventLoop);
+    }
+
+    void afterWork(typename T_AsyncEventLoop::LoopWork::Result&)
+    {
+        if (finalizing)
+        {
+            finalizing = not streamEnded; // Allows processing again after re-init
+            AsyncTransformStream::afterFinalize(savedOutput, streamEnded);
+        }
+        else
+        {
+            AsyncTransformStream::afterProcess(savedInput, savedOutput);
+        }
+    }
+
+    Result work()
+    {
+        return finalizing ? stream.finalize(savedOutput, streamEnded) : stream.process(savedInput, savedOutput);
+    }
+
+    bool finalizing  = false;
+    bool streamEnded = false;
+
+    Span<const char> savedInput;
+    Span<char>       savedOutput;
+};
+
+/// @brief Compresses / decompresses zstd frames on a thread pool (see SC::AsyncCodecTransformStreamT)
+template <typename T_AsyncEventLoop>
+struct AsyncZStdTransformStreamT : public AsyncCodecTransformStreamT<T_AsyncEventLoop, ZStdStream>
+{
+};
+
+/// @brief Compresses / decompresses lz4 frames on a thread pool (see SC::AsyncCodecTransformStreamT)
+template <typename T_AsyncEventLoop>
+struct AsyncLZ4TransformStreamT : public AsyncCodecTransformStreamT<T_AsyncEventLoop, LZ4Stream>
+{
+};
+
+/// @brief Compresses / decompresses brotli streams on a thread pool (see SC::AsyncCodecTransformStreamT)
+template <typename T_AsyncEventLoop>
+struct AsyncBrotliTransformStreamT : public AsyncCodecTransformStreamT<T_AsyncEventLoop, BrotliStream>
+{
+};
+
+//! @}
+} // namespace SC
@@ -0,0 +1,157 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../AsyncRequestStreams.h"
+
+#if SC_PLATFORM_LINUX
+#include <errno.h>    // errno
+#include <fcntl.h>    // splice, fcntl
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // pipe2, close
+
+struct SC::AsyncKernelSplice::Internal
+{
+    static constexpr size_t ChunkSize = 64 * 1024; // Default pipe capacity
+    static constexpr int    MaxReads  = 16;        // Yield to the event loop after moving this many chunks
+
+    static Result flush(AsyncKernelSplice& self, bool& wouldBlock)
+    {
+        wouldBlock = false;
+        while (self.pendingBytes > 0)
+        {
+            const ssize_t res = ::splice(self.pipeRead, nullptr, self.output, nullptr, self.pendingBytes,
+                                         SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (res < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN or errno == EWOULDBLOCK)
+                {
+                    wouldBlock = true;
+                    return Result(true);
+                }
+                return Result::Error("AsyncKernelSplice - splice to output failed");
+            }
+            self.pendingBytes -= static_cast<size_t>(res);
+            self.bytesTransferred += static_cast<uint64_t>(res);
+        }
+        return Result(true);
+    }
+
+    static Result fill(AsyncKernelSplice& self, bool& wouldBlock)
+    {
+        wouldBlock = false;
+        ssize_t res;
+        do
+        {
+            res = ::splice(self.input, nullptr, self.pipeWrite, nullptr, ChunkSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        } while (res < 0 and errno == EINTR);
+        if (res < 0)
+        {
+            if (errno == EAGAIN or errno == EWOULDBLOCK)
+            {
+                wouldBlock = true;
+                return Result(true);
+            }
+            return Result::Error("AsyncKernelSplice - splice from input failed");
+        }
+        if (res == 0)
+        {
+            self.inputEnded = true;
+        }
+        self.pendingBytes += static_cast<size_t>(res);
+        return Result(true);
+    }
+};
+
+SC::Result SC::AsyncKernelSplice::open(int inputDescriptor, int outputDescriptor)
+{
+    SC_TRY_MSG(not isOpen(), "AsyncKernelSplice::open - already open");
+    SC_TRY_MSG(inputDescriptor >= 0 and outputDescriptor >= 0, "AsyncKernelSplice::open - invalid descriptor");
+    struct stat inputStat, outputStat;
+    SC_TRY_MSG(::fstat(inputDescriptor, &inputStat) == 0, "AsyncKernelSplice::open - fstat input failed");
+    SC_TRY_MSG(::fstat(outputDescriptor, &outputStat) == 0, "AsyncKernelSplice::open - fstat output failed");
+    // Readiness of regular files cannot be monitored, so output is limited to sockets and pipes
+    SC_TRY_MSG(not S_ISREG(outputStat.st_mode), "AsyncKernelSplice::open - output cannot be a regular file");
+
+    const int inputFlags = ::fcntl(inputDescriptor, F_GETFL);
+    SC_TRY_MSG(inputFlags >= 0, "AsyncKernelSplice::open - fcntl input failed");
+
+    int pipes[2];
+    SC_TRY_MSG(::pipe2(pipes, O_NONBLOCK | O_CLOEXEC) == 0, "AsyncKernelSplice::open - pipe2 failed");
+    pipeRead  = pipes[0];
+    pipeWrite = pipes[1];
+    input     = inputDescriptor;
+    output    = outputDescriptor;
+
+    bytesTransferred = 0;
+    pendingBytes     = 0;
+    inputRegularFile = S_ISREG(inputStat.st_mode);
+    inputBlocking    = not inputRegularFile and (inputFlags & O_NONBLOCK) == 0;
+    inputEnded       = false;
+    // A blocking input can only be read after it has been reported readable
+    lastStatus = inputBlocking ? Status::WaitOutput : Status::WaitInput;
+    return Result(true);
+}
+
+SC::Result SC::AsyncKernelSplice::transfer(Status& status)
+{
+    SC_TRY_MSG(isOpen(), "AsyncKernelSplice::transfer - not open");
+    const bool inputReady = lastStatus == Status::WaitInput;
+
+    bool wouldBlock = false;
+    for (int numReads = 0;; ++numReads)
+    {
+        SC_TRY(Internal::flush(*this, wouldBlock));
+        if (wouldBlock)
+        {
+            status = Status::WaitOutput;
+            break;
+        }
+        if (inputEnded)
+        {
+            status = Status::Ended;
+            break;
+        }
+        if (numReads == Internal::MaxReads or (inputBlocking and (numReads > 0 or not inputReady)))
+        {
+            // Wait for input readiness (blocking input) or yield after moving many chunks (output is writable)
+            status = inputBlocking ? Status::WaitInput : Status::WaitOutput;
+            break;
+        }
+        SC_TRY(Internal::fill(*this, wouldBlock));
+        if (wouldBlock)
+        {
+            status = Status::WaitInput;
+            break;
+        }
+    }
+    lastStatus = status;
+    return Result(true);
+}
+
+void SC::AsyncKernelSplice::close()
+{
+    if (pipeRead >= 0)
+    {
+        ::close(pipeRead);
+        ::close(pipeWrite);
+    }
+    pipeRead  = -1;
+    pipeWrite = -1;
+    input     = -1;
+    output    = -1;
+}
+#else
+SC::Result SC::AsyncKernelSplice::open(int, int)
+{
+    return Result::Error("AsyncKernelSplice - splice is only available on Linux");
+}
+
+SC::Result SC::AsyncKernelSplice::transfer(Status&)
+{
+    return Result::Error("AsyncKernelSplice - splice is only available on Linux");
+}
+
+void SC::AsyncKernelSplice::close() {}
+#endif
@@ -0,0 +1,250 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../../Common/Result.h"
+
+namespace SC
+{
+struct CodecLibrary;
+struct ZStdAPI;
+struct LZ4API;
+struct BrotliAPI;
+} // namespace SC
+
+#if SC_PLATFORM_WINDOWS
+#define SC_CODEC_API_CC __cdecl
+#else
+#define SC_CODEC_API_CC
+#endif
+
+/// @brief Reference counted dynamic library holding the symbols of a codec loaded at runtime
+struct SC::CodecLibrary
+{
+    /// @brief Loads the library (or increments its reference count if already loaded)
+    /// @param libPath Path of the library to load
+    /// @param loaded Will be set to `true` if the library has been just loaded and its symbols must be resolved
+    Result load(const char* libPath, bool& loaded);
+
+    /// @brief Resolves a symbol, unloading the library if it cannot be found
+    template <typename Func>
+    Result requireSymbol(Func& func, const char* name)
+    {
+        static_assert(sizeof(Func) == sizeof(void*), "Func must be a function pointer");
+        void* symbol = findSymbol(name);
+        if (symbol == nullptr)
+        {
+            close();
+            return Result::Error("Failed to load codec symbol");
+        }
+        copyPointer(&func, symbol);
+        return Result(true);
+    }
+
+    /// @brief Decrements reference count, unloading library when it reaches zero
+    void unload();
+
+  private:
+    void* findSymbol(const char* name);
+    void  close();
+
+    static void copyPointer(void* destination, void* symbol);
+
+    void* library  = nullptr;
+    int   refCount = 0;
+};
+
+/// @brief Runtime loaded subset of the zstd streaming API
+struct SC::ZStdAPI
+{
+    struct InBuffer
+    {
+        const void* src;
+        size_t      size;
+        size_t      pos;
+    };
+    struct OutBuffer
+    {
+        void*  dst;
+        size_t size;
+        size_t pos;
+    };
+
+    enum EndDirective : int
+    {
+        Continue = 0,
+        Flush    = 1,
+        End      = 2,
+    };
+
+    static constexpr int CompressionLevelParameter = 100; // ZSTD_c_compressionLevel
+
+    Result load(const char* libPath = nullptr);
+    void   unload() { library.unload(); }
+
+    void* createCCtx() { return pCreateCCtx(); }
+    void  freeCCtx(void* cctx) { (void)pFreeCCtx(cctx); }
+    void* createDCtx() { return pCreateDCtx(); }
+    void  freeDCtx(void* dctx) { (void)pFreeDCtx(dctx); }
+
+    size_t setParameter(void* cctx, int param, int value) { return pSetParameter(cctx, param, value); }
+    size_t compressStream2(void* cctx, OutBuffer& output, InBuffer& input, EndDirective directive)
+    {
+        return pCompressStream2(cctx, &output, &input, directive);
+    }
+    size_t decompressStream(void* dctx, OutBuffer& output, InBuffer& input)
+    {
+        return pDecompressStream(dctx, &output, &input);
+    }
+    bool isError(size_t code) { return pIsError(code) != 0; }
+
+  private:
+    void*(SC_CODEC_API_CC* pCreateCCtx)()                                                 = nullptr;
+    size_t(SC_CODEC_API_CC* pFreeCCtx)(void*)                                             = nullptr;
+    void*(SC_CODEC_API_CC* pCreateDCtx)()                                                 = nullptr;
+    size_t(SC_CODEC_API_CC* pFreeDCtx)(void*)                                             = nullptr;
+    size_t(SC_CODEC_API_CC* pSetParameter)(void*, int, int)                               = nullptr;
+    size_t(SC_CODEC_API_CC* pCompressStream2)(void*, OutBuffer*, InBuffer*, EndDirective) = nullptr;
+    size_t(SC_CODEC_API_CC* pDecompressStream)(void*, OutBuffer*, InBuffer*)              = nullptr;
+    unsigned(SC_CODEC_API_CC* pIsError)(size_t)                                           = nullptr;
+
+    CodecLibrary library;
+};
+
+/// @brief Runtime loaded subset of the lz4 frame API
+struct SC::LZ4API
+{
+    static constexpr unsigned Version        = 100; // LZ4F_VERSION
+    static constexpr size_t   HeaderSizeMax  = 19;  // LZ4F_HEADER_SIZE_MAX
+    static constexpr int      BlockSize64KB  = 4;   // LZ4F_max64KB
+    static constexpr unsigned BlockSizeBytes = 64 * 1024;
+
+    struct FrameInfo
+    {
+        int                blockSizeID;
+        int                blockMode;
+        int                contentChecksumFlag;
+        int                frameType;
+        unsigned long long contentSize;
+        unsigned           dictID;
+        int                blockChecksumFlag;
+    };
+
+    struct Preferences
+    {
+        FrameInfo frameInfo;
+        int       compressionLevel;
+        unsigned  autoFlush;
+        unsigned  favorDecSpeed;
+        unsigned  reserved[3];
+    };
+
+    Result load(const char* libPath = nullptr);
+    void   unload() { library.unload(); }
+
+    bool isError(size_t code) { return pIsError(code) != 0; }
+
+    size_t createCompressionContext(void*& cctx) { return pCreateCompressionContext(&cctx, Version); }
+    void   freeCompressionContext(void* cctx) { (void)pFreeCompressionContext(cctx); }
+    size_t compressBegin(void* cctx, void* dst, size_t capacity, const Preferences& preferences)
+    {
+        return pCompressBegin(cctx, dst, capacity, &preferences);
+    }
+    size_t compressBound(size_t srcSize, const Preferences& preferences)
+    {
+        return pCompressBound(srcSize, &preferences);
+    }
+    size_t compressUpdate(void* cctx, void* dst, size_t capacity, const void* src, size_t srcSize)
+    {
+        return pCompressUpdate(cctx, dst, capacity, src, srcSize, nullptr);
+    }
+    size_t compressEnd(void* cctx, void* dst, size_t capacity) { return pCompressEnd(cctx, dst, capacity, nullptr); }
+
+    size_t createDecompressionContext(void*& dctx) { return pCreateDecompressionContext(&dctx, Version); }
+    void   freeDecompressionContext(void* dctx) { (void)pFreeDecompressionContext(dctx); }
+    size_t decompress(void* dctx, void* dst, size_t& dstSize, const void* src, size_t& srcSize)
+    {
+        return pDecompress(dctx, dst, &dstSize, src, &srcSize, nullptr);
+    }
+
+  private:
+    unsigned(SC_CODEC_API_CC* pIsError)(size_t)                                                      = nullptr;
+    size_t(SC_CODEC_API_CC* pCreateCompressionContext)(void**, unsigned)                             = nullptr;
+    size_t(SC_CODEC_API_CC* pFreeCompressionContext)(void*)                                          = nullptr;
+    size_t(SC_CODEC_API_CC* pCompressBegin)(void*, void*, size_t, const Preferences*)                = nullptr;
+    size_t(SC_CODEC_API_CC* pCompressBound)(size_t, const Preferences*)                              = nullptr;
+    size_t(SC_CODEC_API_CC* pCompressUpdate)(void*, void*, size_t, const void*, size_t, const void*) = nullptr;
+    size_t(SC_CODEC_API_CC* pCompressEnd)(void*, void*, size_t, const void*)                         = nullptr;
+    size_t(SC_CODEC_API_CC* pCreateDecompressionContext)(void**, unsigned)                           = nullptr;
+    size_t(SC_CODEC_API_CC* pFreeDecompressionContext)(void*)                                        = nullptr;
+    size_t(SC_CODEC_API_CC* pDecompress)(void*, void*, size_t*, const void*, size_t*, const void*)   = nullptr;
+
+    CodecLibrary library;
+};
+
+/// @brief Runtime loaded subset of the brotli encoder and decoder streaming APIs (two distinct libraries)
+struct SC::BrotliAPI
+{
+    enum Operation : int
+    {
+        Process = 0,
+        Flush   = 1,
+        Finish  = 2,
+    };
+
+    enum DecoderResult : int
+    {
+        DecoderError           = 0,
+        DecoderSuccess         = 1,
+        DecoderNeedsMoreInput  = 2,
+        DecoderNeedsMoreOutput = 3,
+    };
+
+    static constexpr int QualityParameter = 1; // BROTLI_PARAM_QUALITY
+
+    Result loadEncoder(const char* libPath = nullptr);
+    Result loadDecoder(const char* libPath = nullptr);
+    void   unloadEncoder() { encoder.unload(); }
+    void   unloadDecoder() { decoder.unload(); }
+
+    void* createEncoder() { return pEncoderCreateInstance(nullptr, nullptr, nullptr); }
+    void  destroyEncoder(void* state) { pEncoderDestroyInstance(state); }
+    bool  setEncoderParameter(void* state, int param, uint32_t value)
+    {
+        return pEncoderSetParameter(state, param, value) != 0;
+    }
+    bool compressStream(void* state, Operation op, size_t& availableIn, const uint8_t*& nextIn, size_t& availableOut,
+                        uint8_t*& nextOut)
+    {
+        return pEncoderCompressStream(state, op, &availableIn, &nextIn, &availableOut, &nextOut, nullptr) != 0;
+    }
+    bool isFinished(void* state) { return pEncoderIsFinished(state) != 0; }
+
+    void* createDecoder() { return pDecoderCreateInstance(nullptr, nullptr, nullptr); }
+    void  destroyDecoder(void* state) { pDecoderDestroyInstance(state); }
+
+    DecoderResult decompressStream(void* state, size_t& availableIn, const uint8_t*& nextIn, size_t& availableOut,
+                                   uint8_t*& nextOut)
+    {
+        return pDecoderDecompressStream(state, &availableIn, &nextIn, &availableOut, &nextOut, nullptr);
+    }
+
+  private:
+    using CompressStreamFunc = int(SC_CODEC_API_CC*)(void*, Operation, size_t*, const uint8_t**, size_t*, uint8_t**,
+                                                     size_t*);
+    using DecompressStreamFunc = DecoderResult(SC_CODEC_API_CC*)(void*, size_t*, const uint8_t**, size_t*, uint8_t**,
+                                                                 size_t*);
+
+    void*(SC_CODEC_API_CC* pEncoderCreateInstance)(void*, void*, void*) = nullptr;
+    void(SC_CODEC_API_CC* pEncoderDestroyInstance)(void*)               = nullptr;
+    int(SC_CODEC_API_CC* pEncoderSetParameter)(void*, int, uint32_t)    = nullptr;
+    int(SC_CODEC_API_CC* pEncoderIsFinished)(void*)                     = nullptr;
+    CompressStreamFunc pEncoderCompressStream                           = nullptr;
+
+    void*(SC_CODEC_API_CC* pDecoderCreateInstance)(void*, void*, void*) = nullptr;
+    void(SC_CODEC_API_CC* pDecoderDestroyInstance)(void*)               = nullptr;
+    DecompressStreamFunc pDecoderDecompressStream                       = nullptr;
+
+    CodecLibrary encoder;
+    CodecLibrary decoder;
+};
+#undef SC_CODEC_API_CC
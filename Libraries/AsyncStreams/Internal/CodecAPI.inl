@@ -0,0 +1,168 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "CodecAPI.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+#include <string.h> // memcpy
+
+SC::Result SC::CodecLibrary::load(const char* libPath, bool& loaded)
+{
+    loaded = false;
+    if (library != nullptr)
+    {
+        refCount++;
+        return Result(true);
+    }
+#ifdef _WIN32
+    HMODULE hmodule = ::LoadLibraryA(libPath);
+    memcpy(&library, &hmodule, sizeof(HMODULE));
+#else
+    library = ::dlopen(libPath, RTLD_NOW);
+#endif
+    SC_TRY_MSG(library != nullptr, "Failed to load codec library");
+    refCount = 1;
+    loaded   = true;
+    return Result(true);
+}
+
+void* SC::CodecLibrary::findSymbol(const char* name)
+{
+#ifdef _WIN32
+    HMODULE hmodule;
+    memcpy(&hmodule, &library, sizeof(HMODULE));
+    auto  func = ::GetProcAddress(hmodule, name);
+    void* symbol;
+    memcpy(&symbol, &func, sizeof(void*));
+    return symbol;
+#else
+    return ::dlsym(library, name);
+#endif
+}
+
+void SC::CodecLibrary::copyPointer(void* destination, void* symbol) { memcpy(destination, &symbol, sizeof(void*)); }
+
+void SC::CodecLibrary::close()
+{
+    if (library == nullptr)
+    {
+        return;
+    }
+#ifdef _WIN32
+    HMODULE hmodule;
+    memcpy(&hmodule, &library, sizeof(HMODULE));
+    ::FreeLibrary(hmodule);
+#else
+    ::dlclose(library);
+#endif
+    library  = nullptr;
+    refCount = 0;
+}
+
+void SC::CodecLibrary::unload()
+{
+    --refCount;
+    if (refCount > 0)
+    {
+        return;
+    }
+    close();
+}
+
+SC::Result SC::ZStdAPI::load(const char* libPath)
+{
+#if _WIN32
+    const char* defaultPath = "libzstd.dll";
+#elif __APPLE__
+    const char* defaultPath = "libzstd.1.dylib";
+#else
+    const char* defaultPath = "libzstd.so.1";
+#endif
+    bool loaded;
+    SC_TRY(library.load(libPath == nullptr ? defaultPath : libPath, loaded));
+    if (loaded)
+    {
+        SC_TRY(library.requireSymbol(pCreateCCtx, "ZSTD_createCCtx"));
+        SC_TRY(library.requireSymbol(pFreeCCtx, "ZSTD_freeCCtx"));
+        SC_TRY(library.requireSymbol(pCreateDCtx, "ZSTD_createDCtx"));
+        SC_TRY(library.requireSymbol(pFreeDCtx, "ZSTD_freeDCtx"));
+        SC_TRY(library.requireSymbol(pSetParameter, "ZSTD_CCtx_setParameter"));
+        SC_TRY(library.requireSymbol(pCompressStream2, "ZSTD_compressStream2"));
+        SC_TRY(library.requireSymbol(pDecompressStream, "ZSTD_decompressStream"));
+        SC_TRY(library.requireSymbol(pIsError, "ZSTD_isError"));
+    }
+    return Result(true);
+}
+
+SC::Result SC::LZ4API::load(const char* libPath)
+{
+#if _WIN32
+    const char* defaultPath = "liblz4.dll";
+#elif __APPLE__
+    const char* defaultPath = "liblz4.1.dylib";
+#else
+    const char* defaultPath = "liblz4.so.1";
+#endif
+    bool loaded;
+    SC_TRY(library.load(libPath == nullptr ? defaultPath : libPath, loaded));
+    if (loaded)
+    {
+        SC_TRY(library.requireSymbol(pIsError, "LZ4F_isError"));
+        SC_TRY(library.requireSymbol(pCreateCompressionContext, "LZ4F_createCompressionContext"));
+        SC_TRY(library.requireSymbol(pFreeCompressionContext, "LZ4F_freeCompressionContext"));
+        SC_TRY(library.requireSymbol(pCompressBegin, "LZ4F_compressBegin"));
+        SC_TRY(library.requireSymbol(pCompressBound, "LZ4F_compressBound"));
+        SC_TRY(library.requireSymbol(pCompressUpdate, "LZ4F_compressUpdate"));
+        SC_TRY(library.requireSymbol(pCompressEnd, "LZ4F_compressEnd"));
+        SC_TRY(library.requireSymbol(pCreateDecompressionContext, "LZ4F_createDecompressionContext"));
+        SC_TRY(library.requireSymbol(pFreeDecompressionContext, "LZ4F_freeDecompressionContext"));
+        SC_TRY(library.requireSymbol(pDecompress, "LZ4F_decompress"));
+    }
+    return Result(true);
+}
+
+SC::Result SC::BrotliAPI::loadEncoder(const char* libPath)
+{
+#if _WIN32
+    const char* defaultPath = "brotlienc.dll";
+#elif __APPLE__
+    const char* defaultPath = "libbrotlienc.1.dylib";
+#else
+    const char* defaultPath = "libbrotlienc.so.1";
+#endif
+    bool loaded;
+    SC_TRY(encoder.load(libPath == nullptr ? defaultPath : libPath, loaded));
+    if (loaded)
+    {
+        SC_TRY(encoder.requireSymbol(pEncoderCreateInstance, "BrotliEncoderCreateInstance"));
+        SC_TRY(encoder.requireSymbol(pEncoderDestroyInstance, "BrotliEncoderDestroyInstance"));
+        SC_TRY(encoder.requireSymbol(pEncoderSetParameter, "BrotliEncoderSetParameter"));
+        SC_TRY(encoder.requireSymbol(pEncoderIsFinished, "BrotliEncoderIsFinished"));
+        SC_TRY(encoder.requireSymbol(pEncoderCompressStream, "BrotliEncoderCompressStream"));
+    }
+    return Result(true);
+}
+
+SC::Result SC::BrotliAPI::loadDecoder(const char* libPath)
+{
+#if _WIN32
+    const char* defaultPath = "brotlidec.dll";
+#elif __APPLE__
+    const char* defaultPath = "libbrotlidec.1.dylib";
+#else
+    const char* defaultPath = "libbrotlidec.so.1";
+#endif
+    bool loaded;
+    SC_TRY(decoder.load(libPath == nullptr ? defaultPath : libPath, loaded));
+    if (loaded)
+    {
+        SC_TRY(decoder.requireSymbol(pDecoderCreateInstance, "BrotliDecoderCreateInstance"));
+        SC_TRY(decoder.requireSymbol(pDecoderDestroyInstance, "BrotliDecoderDestroyInstance"));
+        SC_TRY(decoder.requireSymbol(pDecoderDecompressStream, "BrotliDecoderDecompressStream"));
+    }
+    return Result(true);
+}
@@ -0,0 +1,146 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../../Common/Result.h"
+#include "../../Common/Span.h"
+namespace SC
+{
+//! @addtogroup group_async_streams
+//! @{
+
+/// @brief Compresses or decompresses byte streams using zstd (libzstd loaded at runtime).
+/// @n
+/// Exposes the same interface of SC::ZLibStream, so it can be used with SC::AsyncCodecTransformStreamT.
+struct ZStdStream
+{
+    enum Algorithm
+    {
+        Compress,  ///< Compress to a zstd frame
+        Decompress ///< Decompress a zstd frame
+    };
+
+    static constexpr int DefaultLevel = 3; ///< Same as ZSTD_CLEVEL_DEFAULT
+
+    ZStdStream() = default;
+    ~ZStdStream() { reset(); }
+
+    ZStdStream(const ZStdStream&)            = delete;
+    ZStdStream(ZStdStream&&)                 = delete;
+    ZStdStream& operator=(const ZStdStream&) = delete;
+    ZStdStream& operator=(ZStdStream&&)      = delete;
+
+    /// @brief Loads libzstd and inits the compressor / decompressor
+    /// @param wantedAlgorithm Compress or Decompress
+    /// @param level Compression level (from 1 to 22, ignored when decompressing)
+    Result init(Algorithm wantedAlgorithm, int level = DefaultLevel);
+
+    /// @brief Releases the compressor / decompressor, so that ZStdStream::init can be called again
+    void reset();
+
+    /// @brief Add data to be processed, see ZLibStream::process
+    Result process(Span<const char>& input, Span<char>& output);
+
+    /// @brief Writes end of frame (compression) or flushes remaining data (decompression), see ZLibStream::finalize
+    Result finalize(Span<char>& output, bool& streamEnded);
+
+  private:
+    struct Internal;
+
+    void*     context    = nullptr;
+    Algorithm algorithm  = Compress;
+    bool      frameEnded = false;
+};
+
+/// @brief Compresses or decompresses byte streams using the lz4 frame format (liblz4 loaded at runtime).
+/// @n
+/// Exposes the same interface of SC::ZLibStream, so it can be used with SC::AsyncCodecTransformStreamT.
+/// @note Compression flushes a block on every LZ4Stream::process call, so output buffers should be larger than input
+/// ones (by at least a few tens of bytes) to avoid fragmenting blocks.
+struct LZ4Stream
+{
+    enum Algorithm
+    {
+        Compress,  ///< Compress to a lz4 frame
+        Decompress ///< Decompress a lz4 frame
+    };
+
+    static constexpr int DefaultLevel = 0; ///< Fast (non HC) compression
+
+    LZ4Stream() = default;
+    ~LZ4Stream() { reset(); }
+
+    LZ4Stream(const LZ4Stream&)            = delete;
+    LZ4Stream(LZ4Stream&&)                 = delete;
+    LZ4Stream& operator=(const LZ4Stream&) = delete;
+    LZ4Stream& operator=(LZ4Stream&&)      = delete;
+
+    /// @brief Loads liblz4 and inits the compressor / decompressor
+    /// @param wantedAlgorithm Compress or Decompress
+    /// @param level Compression level (values above 2 use lz4 HC, ignored when decompressing)
+    Result init(Algorithm wantedAlgorithm, int level = DefaultLevel);
+
+    /// @brief Releases the compressor / decompressor, so that LZ4Stream::init can be called again
+    void reset();
+
+    /// @brief Add data to be processed, see ZLibStream::process
+    Result process(Span<const char>& input, Span<char>& output);
+
+    /// @brief Writes end of frame (compression) or flushes remaining data (decompression), see ZLibStream::finalize
+    Result finalize(Span<char>& output, bool& streamEnded);
+
+  private:
+    struct Internal;
+
+    void*     context          = nullptr;
+    Algorithm algorithm        = Compress;
+    int       compressionLevel = DefaultLevel;
+    bool      began            = false;
+    bool      frameEnded       = false;
+};
+
+/// @brief Compresses or decompresses byte streams using brotli (libbrotlienc / libbrotlidec loaded at runtime).
+/// @n
+/// Exposes the same interface of SC::ZLibStream, so it can be used with SC::AsyncCodecTransformStreamT.
+struct BrotliStream
+{
+    enum Algorithm
+    {
+        Compress,  ///< Compress to a brotli stream
+        Decompress ///< Decompress a brotli stream
+    };
+
+    /// Brotli default quality (11) is meant for offline compression, 5 is a better fit for streaming
+    static constexpr int DefaultLevel = 5;
+
+    BrotliStream() = default;
+    ~BrotliStream() { reset(); }
+
+    BrotliStream(const BrotliStream&)            = delete;
+    BrotliStream(BrotliStream&&)                 = delete;
+    BrotliStream& operator=(const BrotliStream&) = delete;
+    BrotliStream& operator=(BrotliStream&&)      = delete;
+
+    /// @brief Loads brotli library and inits the compressor / decompressor
+    /// @param wantedAlgorithm Compress or Decompress
+    /// @param level Compression quality (from 0 to 11, ignored when decompressing)
+    Result init(Algorithm wantedAlgorithm, int level = DefaultLevel);
+
+    /// @brief Releases the compressor / decompressor, so that BrotliStream::init can be called again
+    void reset();
+
+    /// @brief Add data to be processed, see ZLibStream::process
+    Result process(Span<const char>& input, Span<char>& output);
+
+    /// @brief Writes end of stream (compression) or flushes remaining data (decompression), see ZLibStream::finalize
+    Result finalize(Span<char>& output, bool& streamEnded);
+
+  private:
+    struct Internal;
+
+    void*     context   = nullptr;
+    Algorithm algorithm = Compress;
+    bool      ended     = false;
+};
+
+//! @}
+} // namespace SC
@@ -0,0 +1,412 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "CodecStreams.h"
+#include "../../Common/CompilerMinMax.h"
+
+#include "CodecAPI.h"
+#include "CodecAPI.inl" // IWYU pragma: keep
+
+static SC::ZStdAPI   zstd;
+static SC::LZ4API    lz4;
+static SC::BrotliAPI brotli;
+
+//-------------------------------------------------------------------------------------------------------
+// ZStdStream
+//-------------------------------------------------------------------------------------------------------
+struct SC::ZStdStream::Internal
+{
+    // Calls zstd until input is consumed or output is full, returning the last zstd return code in hint
+    static Result run(ZStdStream& self, Span<const char>& input, Span<char>& output, ZStdAPI::EndDirective directive,
+                      size_t& hint)
+    {
+        ZStdAPI::InBuffer  in  = {input.data(), input.sizeInBytes(), 0};
+        ZStdAPI::OutBuffer out = {output.data(), output.sizeInBytes(), 0};
+        do
+        {
+            const size_t inPos  = in.pos;
+            const size_t outPos = out.pos;
+            if (self.algorithm == Compress)
+            {
+                hint = zstd.compressStream2(self.context, out, in, directive);
+            }
+            else
+            {
+                hint = zstd.decompressStream(self.context, out, in);
+            }
+            SC_TRY_MSG(not zstd.isError(hint), "ZStdStream - zstd error");
+            self.frameEnded = self.algorithm == Decompress and hint == 0;
+            if (in.pos == inPos and out.pos == outPos)
+            {
+                break; // No progress
+            }
+        } while (in.pos < in.size and out.pos < out.size);
+        const bool inSliceOk  = input.sliceStart(in.pos, input);
+        const bool outSliceOk = output.sliceStart(out.pos, output);
+        SC_TRY_MSG(inSliceOk and outSliceOk, "ZStdStream - sliceStart");
+        return Result(true);
+    }
+};
+
+SC::Result SC::ZStdStream::init(Algorithm wantedAlgorithm, int level)
+{
+    SC_TRY_MSG(context == nullptr, "ZStdStream::init - already inited");
+    SC_TRY(zstd.load());
+    algorithm  = wantedAlgorithm;
+    frameEnded = false;
+    context    = algorithm == Compress ? zstd.createCCtx() : zstd.createDCtx();
+    if (context != nullptr and algorithm == Compress and
+        zstd.isError(zstd.setParameter(context, ZStdAPI::CompressionLevelParameter, level)))
+    {
+        reset();
+        return Result::Error("ZStdStream::init - invalid compression level");
+    }
+    if (context == nullptr)
+    {
+        zstd.unload();
+        return Result::Error("ZStdStream::init - cannot create context");
+    }
+    return Result(true);
+}
+
+void SC::ZStdStream::reset()
+{
+    if (context == nullptr)
+    {
+        return;
+    }
+    if (algorithm == Compress)
+    {
+        zstd.freeCCtx(context);
+    }
+    else
+    {
+        zstd.freeDCtx(context);
+    }
+    context = nullptr;
+    zstd.unload();
+}
+
+SC::Result SC::ZStdStream::process(Span<const char>& input, Span<char>& output)
+{
+    SC_TRY_MSG(context != nullptr, "ZStdStream::process - not inited");
+    SC_TRY_MSG(not output.empty(), "ZStdStream::process empty output is not allowed");
+    size_t hint;
+    return Internal::run(*this, input, output, ZStdAPI::Continue, hint);
+}
+
+SC::Result SC::ZStdStream::finalize(Span<char>& output, bool& streamEnded)
+{
+    SC_TRY_MSG(context != nullptr, "ZStdStream::finalize - not inited");
+    streamEnded = algorithm == Decompress and frameEnded;
+    if (streamEnded)
+    {
+        return Result(true);
+    }
+    const size_t     outputSize = output.sizeInBytes();
+    Span<const char> input;
+    size_t           hint;
+    SC_TRY(Internal::run(*this, input, output, ZStdAPI::End, hint));
+    if (algorithm == Compress)
+    {
+        streamEnded = hint == 0; // Frame has been fully flushed
+        return Result(true);
+    }
+    streamEnded = frameEnded;
+    SC_TRY_MSG(streamEnded or output.sizeInBytes() < outputSize, "ZStdStream::finalize - truncated input");
+    return Result(true);
+}
+
+//-------------------------------------------------------------------------------------------------------
+// LZ4Stream
+//-------------------------------------------------------------------------------------------------------
+struct SC::LZ4Stream::Internal
+{
+    static LZ4API::Preferences getPreferences(const LZ4Stream& self)
+    {
+        LZ4API::Preferences preferences = {};
+        preferences.frameInfo.blockSizeID = LZ4API::BlockSize64KB;
+        preferences.compressionLevel      = self.compressionLevel;
+        preferences.autoFlush             = 1; // Never buffer input, so output buffers can be of any size
+        return preferences;
+    }
+
+    static Result begin(LZ4Stream& self, const LZ4API::Preferences& preferences, Span<char>& output)
+    {
+        if (self.began)
+        {
+            return Result(true);
+        }
+        SC_TRY_MSG(output.sizeInBytes() >= LZ4API::HeaderSizeMax, "LZ4Stream - insufficient output space");
+        const size_t res = lz4.compressBegin(self.context, output.data(), output.sizeInBytes(), preferences);
+        SC_TRY_MSG(not lz4.isError(res), "LZ4Stream - compressBegin failed");
+        SC_TRY_MSG(output.sliceStart(res, output), "LZ4Stream - sliceStart");
+        self.began = true;
+        return Result(true);
+    }
+
+    static Result compress(LZ4Stream& self, Span<const char>& input, Span<char>& output)
+    {
+        const LZ4API::Preferences preferences = getPreferences(self);
+        SC_TRY(begin(self, preferences, output));
+        while (not input.empty())
+        {
+            // Find the largest input slice whose worst case compressed size fits the output
+            size_t sliceSize = min(input.sizeInBytes(), static_cast<size_t>(LZ4API::BlockSizeBytes));
+            size_t bound     = lz4.compressBound(sliceSize, preferences);
+            while (sliceSize > 0 and bound > output.sizeInBytes())
+            {
+                const size_t excess = bound - output.sizeInBytes();
+                sliceSize           = excess < sliceSize ? sliceSize - excess : 0;
+                bound               = lz4.compressBound(sliceSize, preferences);
+            }
+            if (sliceSize == 0)
+            {
+                break; // Needs more output space
+            }
+            const size_t res = lz4.compressUpdate(self.context, output.data(), output.sizeInBytes(), input.data(),
+                                                  sliceSize);
+            SC_TRY_MSG(not lz4.isError(res), "LZ4Stream - compressUpdate failed");
+            const bool inSliceOk  = input.sliceStart(sliceSize, input);
+            const bool outSliceOk = output.sliceStart(res, output);
+            SC_TRY_MSG(inSliceOk and outSliceOk, "LZ4Stream - sliceStart");
+        }
+        return Result(true);
+    }
+
+    static Result decompress(LZ4Stream& self, Span<const char>& input, Span<char>& output)
+    {
+        while (not output.empty())
+        {
+            size_t       dstSize = output.sizeInBytes();
+            size_t       srcSize = input.sizeInBytes();
+            const size_t res     = lz4.decompress(self.context, output.data(), dstSize, input.data(), srcSize);
+            SC_TRY_MSG(not lz4.isError(res), "LZ4Stream - decompress failed");
+            const bool inSliceOk  = input.sliceStart(srcSize, input);
+            const bool outSliceOk = output.sliceStart(dstSize, output);
+            SC_TRY_MSG(inSliceOk and outSliceOk, "LZ4Stream - sliceStart");
+            self.frameEnded = res == 0;
+            if ((dstSize == 0 and srcSize == 0) or input.empty())
+            {
+                break;
+            }
+        }
+        return Result(true);
+    }
+};
+
+SC::Result SC::LZ4Stream::init(Algorithm wantedAlgorithm, int level)
+{
+    SC_TRY_MSG(context == nullptr, "LZ4Stream::init - already inited");
+    SC_TRY(lz4.load());
+    algorithm        = wantedAlgorithm;
+    compressionLevel = level;
+    began            = false;
+    frameEnded       = false;
+    const size_t res =
+        algorithm == Compress ? lz4.createCompressionContext(context) : lz4.createDecompressionContext(context);
+    if (lz4.isError(res))
+    {
+        context = nullptr;
+        lz4.unload();
+        return Result::Error("LZ4Stream::init - cannot create context");
+    }
+    return Result(true);
+}
+
+void SC::LZ4Stream::reset()
+{
+    if (context == nullptr)
+    {
+        return;
+    }
+    if (algorithm == Compress)
+    {
+        lz4.freeCompressionContext(context);
+    }
+    else
+    {
+        lz4.freeDecompressionContext(context);
+    }
+    context = nullptr;
+    lz4.unload();
+}
+
+SC::Result SC::LZ4Stream::process(Span<const char>& input, Span<char>& output)
+{
+    SC_TRY_MSG(context != nullptr, "LZ4Stream::process - not inited");
+    SC_TRY_MSG(not output.empty(), "LZ4Stream::process empty output is not allowed");
+    const size_t inputSize  = input.sizeInBytes();
+    const size_t outputSize = output.sizeInBytes();
+    if (algorithm == Compress)
+    {
+        SC_TRY(Internal::compress(*this, input, output));
+    }
+    else
+    {
+        SC_TRY(Internal::decompress(*this, input, output));
+    }
+    SC_TRY_MSG(inputSize == 0 or input.sizeInBytes() < inputSize or output.sizeInBytes() < outputSize,
+               "LZ4Stream::process - insufficient output space");
+    return Result(true);
+}
+
+SC::Result SC::LZ4Stream::finalize(Span<char>& output, bool& streamEnded)
+{
+    SC_TRY_MSG(context != nullptr, "LZ4Stream::finalize - not inited");
+    if (algorithm == Compress)
+    {
+        const LZ4API::Preferences preferences = Internal::getPreferences(*this);
+        SC_TRY(Internal::begin(*this, preferences, output));
+        SC_TRY_MSG(output.sizeInBytes() >= lz4.compressBound(0, preferences),
+                   "LZ4Stream::finalize - insufficient output space");
+        const size_t res = lz4.compressEnd(context, output.data(), output.sizeInBytes());
+        SC_TRY_MSG(not lz4.isError(res), "LZ4Stream - compressEnd failed");
+        SC_TRY_MSG(output.sliceStart(res, output), "LZ4Stream - sliceStart");
+        streamEnded = true;
+        return Result(true);
+    }
+    if (not frameEnded)
+    {
+        // Flush data decoded but not yet written for lack of output space
+        const size_t     outputSize = output.sizeInBytes();
+        Span<const char> input;
+        SC_TRY(Internal::decompress(*this, input, output));
+        SC_TRY_MSG(frameEnded or output.sizeInBytes() < outputSize, "LZ4Stream::finalize - truncated input");
+    }
+    streamEnded = frameEnded;
+    return Result(true);
+}
+
+//-------------------------------------------------------------------------------------------------------
+// BrotliStream
+//-------------------------------------------------------------------------------------------------------
+struct SC::BrotliStream::Internal
+{
+    static Result compress(BrotliStream& self, BrotliAPI::Operation op, Span<const char>& input, Span<char>& output)
+    {
+        size_t         availableIn  = input.sizeInBytes();
+        const uint8_t* nextIn       = reinterpret_cast<const uint8_t*>(input.data());
+        size_t         availableOut = output.sizeInBytes();
+        uint8_t*       nextOut      = reinterpret_cast<uint8_t*>(output.data());
+        while (availableOut > 0)
+        {
+            const size_t inBefore  = availableIn;
+            const size_t outBefore = availableOut;
+            SC_TRY_MSG(brotli.compressStream(self.context, op, availableIn, nextIn, availableOut, nextOut),
+                       "BrotliStream - compress failed");
+            self.ended = op == BrotliAPI::Finish and brotli.isFinished(self.context);
+            if (self.ended or (op == BrotliAPI::Process and availableIn == 0) or
+                (availableIn == inBefore and availableOut == outBefore))
+            {
+                break;
+            }
+        }
+        const bool inSliceOk  = input.sliceStart(input.sizeInBytes() - availableIn, input);
+        const bool outSliceOk = output.sliceStart(output.sizeInBytes() - availableOut, output);
+        SC_TRY_MSG(inSliceOk and outSliceOk, "BrotliStream - sliceStart");
+        return Result(true);
+    }
+
+    static Result decompress(BrotliStream& self, Span<const char>& input, Span<char>& output,
+                             BrotliAPI::DecoderResult& result)
+    {
+        size_t         availableIn  = input.sizeInBytes();
+        const uint8_t* nextIn       = reinterpret_cast<const uint8_t*>(input.data());
+        size_t         availableOut = output.sizeInBytes();
+        uint8_t*       nextOut      = reinterpret_cast<uint8_t*>(output.data());
+
+        result = brotli.decompressStream(self.context, availableIn, nextIn, availableOut, nextOut);
+        SC_TRY_MSG(result != BrotliAPI::DecoderError, "BrotliStream - decompress failed");
+        self.ended = result == BrotliAPI::DecoderSuccess;
+
+        const bool inSliceOk  = input.sliceStart(input.sizeInBytes() - availableIn, input);
+        const bool outSliceOk = output.sliceStart(output.sizeInBytes() - availableOut, output);
+        SC_TRY_MSG(inSliceOk and outSliceOk, "BrotliStream - sliceStart");
+        return Result(true);
+    }
+};
+
+SC::Result SC::BrotliStream::init(Algorithm wantedAlgorithm, int level)
+{
+    SC_TRY_MSG(context == nullptr, "BrotliStream::init - already inited");
+    algorithm = wantedAlgorithm;
+    ended     = false;
+    if (algorithm == Compress)
+    {
+        SC_TRY_MSG(level >= 0 and level <= 11, "BrotliStream::init - invalid compression level");
+        SC_TRY(brotli.loadEncoder());
+        context = brotli.createEncoder();
+        if (context != nullptr and
+            not brotli.setEncoderParameter(context, BrotliAPI::QualityParameter, static_cast<uint32_t>(level)))
+        {
+            reset();
+            return Result::Error("BrotliStream::init - cannot set quality");
+        }
+        if (context == nullptr)
+        {
+            brotli.unloadEncoder();
+        }
+    }
+    else
+    {
+        SC_TRY(brotli.loadDecoder());
+        context = brotli.createDecoder();
+        if (context == nullptr)
+        {
+            brotli.unloadDecoder();
+        }
+    }
+    SC_TRY_MSG(context != nullptr, "BrotliStream::init - cannot create instance");
+    return Result(true);
+}
+
+void SC::BrotliStream::reset()
+{
+    if (context == nullptr)
+    {
+        return;
+    }
+    if (algorithm == Compress)
+    {
+        brotli.destroyEncoder(context);
+        brotli.unloadEncoder();
+    }
+    else
+    {
+        brotli.destroyDecoder(context);
+        brotli.unloadDecoder();
+    }
+    context = nullptr;
+}
+
+SC::Result SC::BrotliStream::process(Span<const char>& input, Span<char>& output)
+{
+    SC_TRY_MSG(context != nullptr, "BrotliStream::process - not inited");
+    SC_TRY_MSG(not output.empty(), "BrotliStream::process empty output is not allowed");
+    if (algorithm == Compress)
+    {
+        return Internal::compress(*this, BrotliAPI::Process, input, output);
+    }
+    BrotliAPI::DecoderResult result;
+    return Internal::decompress(*this, input, output, result);
+}
+
+SC::Result SC::BrotliStream::finalize(Span<char>& output, bool& streamEnded)
+{
+    SC_TRY_MSG(context != nullptr, "BrotliStream::finalize - not inited");
+    Span<const char> input;
+    if (algorithm == Compress)
+    {
+        SC_TRY(Internal::compress(*this, BrotliAPI::Finish, input, output));
+    }
+    else if (not ended)
+    {
+        BrotliAPI::DecoderResult result;
+        SC_TRY(Internal::decompress(*this, input, output, result));
+        SC_TRY_MSG(result != BrotliAPI::DecoderNeedsMoreInput, "BrotliStream::finalize - truncated input");
+    }
+    streamEnded = ended;
+    return Result(true);
+}
@@ -24,6 +24,12 @@ struct ZLibStream
         CompressDeflate,  ///< Use DEFLATE algorithm to compress
         DecompressDeflate ///< Use DEFLATE algorithm to decompress
     };
+
+    enum FlushMode
+    {
+        SyncFlush, ///< Align output to a byte boundary, keeping the dictionary used to compress following data
+        FullFlush  ///< Like SyncFlush, but following data can be decompressed without any of the previous output
+    };
     /// @brief Initializes a ZLibStream struct
     ZLibStream();
 
@@ -37,8 +43,12 @@ struct ZLibStream
 
     /// @brief Inits the compressor / decompressor with the required algorithm
     /// @param wantedAlgorithm Wanted algorithm (ZLIB, GZIP or DEFLATE with compression or decompression)
+    /// @param windowBits Base two logarithm of the LZ77 window size (from 9 to 15)
     /// @return Valid Result if the algorithm has been inited successfully
-    Result init(Algorithm wantedAlgorithm);
+    Result init(Algorithm wantedAlgorithm, int windowBits = 15);
+
+    /// @brief Releases the compressor / decompressor, so that ZLibStream::init can be called again
+    void reset();
 
     /// @brief Add data to be processed. Can be called multiple times before ZLibStream::finalize.
     /// @param input Span containing data to be processed, that will be modified pointing to data not (yet)
@@ -47,12 +57,43 @@ struct ZLibStream
     /// @return Valid Result if data has been processed successfully
     Result process(Span<const char>& input, Span<char>& output);
 
+    /// @brief Like ZLibStream::process, but not failing when decompression needs more input to make progress.
+    /// @n
+    /// Useful when a deflate stream is delivered in chunks that can end anywhere inside a block (like WebSocket
+    /// permessage-deflate messages), leaving to the caller the responsibility of detecting lack of progress.
+    /// @param input Span containing data to be decompressed, see ZLibStream::process
+    /// @param output Writable memory receiving decompressed data, see ZLibStream::process
+    /// @return Valid Result if data has been decompressed successfully or if more input is needed
+    Result processPartial(Span<const char>& input, Span<char>& output);
+
+    /// @brief Flushes compressed data so that all input processed so far can be decompressed (compression only).
+    /// @n
+    /// The flushed data ends with an empty stored block (`0x00 0x00 0xff 0xff`) and the stream can keep being used.
+    /// @param output Writable memory receiving processed data. It will then point to unused memory.
+    /// @param flushed Will be set to `true` when all pending data has been written to output
+    /// @param mode SyncFlush or FullFlush (resetting compression dictionary)
+    /// @return Valid Result if no error has happened during flush
+    Result flush(Span<char>& output, bool& flushed, FlushMode mode = SyncFlush);
+
     /// @brief Finalize stream by computing CRC or similar footers if needed (depending on the choosen Algorithm)
     /// @param output Writable memory receiving processed data. It will then point to unused memory.
     /// @param streamEnded Will be set to `true` if the stream has ended.
     /// @return Valid Result if no error has happened during finalization
     Result finalize(Span<char>& output, bool& streamEnded);
 
+    /// @brief Updates a CRC-32 checksum (the one used by GZIP) with additional data
+    /// @param crc CRC-32 of data preceding input (`0` to start a new checksum)
+    /// @param input Data to be added to the checksum
+    /// @return The updated CRC-32
+    static uint32_t updateCRC32(uint32_t crc, Span<const char> input);
+
+    /// @brief Combines CRC-32 of two consecutive blocks of data, without needing the data itself
+    /// @param crc1 CRC-32 of the first block
+    /// @param crc2 CRC-32 of the second block
+    /// @param length2 Size in bytes of the second block
+    /// @return CRC-32 of the two blocks concatenated
+    static uint32_t combineCRC32(uint32_t crc1, uint32_t crc2, uint64_t length2);
+
   private:
     struct Internal;
     AlignedStorage<112> buffer;
@@ -68,7 +68,76 @@ struct SC::ZLibStream::Internal
         return Result::Error("UNKNOWN");
     }
 
-    static Result decompress(ZLibAPI::Stream& stream, Span<const char>& input, Span<char>& output)
+    static Result compressFlush(ZLibAPI::Stream& stream, Span<char>& output, bool& flushed, ZLibAPI::Flush flag)
+    {
+        stream.next_in   = nullptr;
+        stream.avail_in  = 0;
+        stream.next_out  = reinterpret_cast<uint8_t*>(output.data());
+        stream.avail_out = static_cast<unsigned int>(output.sizeInBytes());
+
+        const auto result    = zlib.deflate(stream, flag);
+        const auto offsetOut = output.sizeInBytes() - stream.avail_out;
+        const bool slicesOk  = output.sliceStart(offsetOut, output);
+        SC_TRY_MSG(slicesOk, "compressFlush sliceStart");
+        flushed = stream.avail_out != 0;
+        switch (result)
+        {
+        case ZLibAPI::OK:        // All good
+        case ZLibAPI::BUF_ERROR: // Returned when there is nothing left to flush
+            return Result(true);
+        case ZLibAPI::STREAM_END: return Result::Error("STREAM_END");
+        case ZLibAPI::NEED_DICT: return Result::Error("NEED_DICT");
+        case ZLibAPI::ERRNO: return Result::Error("ERRNO");
+        case ZLibAPI::STREAM_ERROR: return Result::Error("STREAM_ERROR");
+        case ZLibAPI::DATA_ERROR: return Result::Error("DATA_ERROR");
+        case ZLibAPI::MEM_ERROR: return Result::Error("MEM_ERROR");
+        case ZLibAPI::VERSION_ERROR: return Result::Error("VERSION_ERROR");
+        }
+        return Result::Error("UNKNOWN");
+    }
+
+    static constexpr uint32_t CRC32Polynomial = 0xedb88320; // Reflected IEEE 802.3 polynomial
+
+    struct CRC32Table
+    {
+        uint32_t values[256];
+
+        constexpr CRC32Table() : values()
+        {
+            for (uint32_t idx = 0; idx < 256; ++idx)
+            {
+                uint32_t crc = idx;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ CRC32Polynomial : crc >> 1;
+                }
+                values[idx] = crc;
+            }
+        }
+    };
+
+    // Multiplies two polynomials modulo CRC32Polynomial (bit 31 is the x^0 coefficient)
+    static uint32_t multiplyModCRC32(uint32_t a, uint32_t b)
+    {
+        uint32_t mask    = 1u << 31;
+        uint32_t product = 0;
+        while (mask != 0)
+        {
+            if (a & mask)
+            {
+                product ^= b;
+                if ((a & (mask - 1)) == 0)
+                {
+                    break;
+                }
+            }
+            mask >>= 1;
+            b = (b & 1) ? (b >> 1) ^ CRC32Polynomial : b >> 1;
+        }
+        return product;
+    }
+
+    static Result decompress(ZLibAPI::Stream& stream, Span<const char>& input, Span<char>& output, bool partial)
     {
         stream.next_in   = reinterpret_cast<const uint8_t*>(input.data());
         stream.avail_in  = static_cast<unsigned int>(input.sizeInBytes());
@@ -87,7 +156,8 @@ struct SC::ZLibStream::Internal
         case ZLibAPI::OK:         // All good
         case ZLibAPI::STREAM_END: // Stream ended
             return Result(true);
-        case ZLibAPI::BUF_ERROR: return Result::Error("BUF_ERROR");
+        case ZLibAPI::BUF_ERROR: // No progress possible until more input is provided
+            return partial ? Result(true) : Result::Error("BUF_ERROR");
         case ZLibAPI::NEED_DICT: return Result::Error("NEED_DICT");
         case ZLibAPI::ERRNO: return Result::Error("ERRNO");
         case ZLibAPI::STREAM_ERROR: return Result::Error("STREAM_ERROR");
@@ -128,8 +198,14 @@ struct SC::ZLibStream::Internal
 
 SC::ZLibStream::ZLibStream() {}
 
-SC::ZLibStream::~ZLibStream()
+SC::ZLibStream::~ZLibStream() { reset(); }
+
+void SC::ZLibStream::reset()
 {
+    if (state != State::Inited)
+    {
+        return;
+    }
     ZLibAPI::Stream& stream = buffer.reinterpret_as<ZLibAPI::Stream>();
     switch (algorithm)
     {
@@ -147,12 +223,14 @@ SC::ZLibStream::~ZLibStream()
         break;
     }
     zlib.unload();
+    state = State::Constructed;
 }
 
-SC::Result SC::ZLibStream::init(Algorithm wantedAlgorithm)
+SC::Result SC::ZLibStream::init(Algorithm wantedAlgorithm, int windowBits)
 {
     ZLibAPI::Stream& stream = buffer.reinterpret_as<ZLibAPI::Stream>();
     SC_TRY_MSG(state == State::Constructed, "Init can be called only in State::Constructed");
+    SC_TRY_MSG(windowBits >= 9 and windowBits <= ZLibAPI::MaxBits, "ZLibStream::init invalid windowBits");
 
     SC_TRY(zlib.load());
 
@@ -167,31 +245,31 @@ SC::Result SC::ZLibStream::init(Algorithm wantedAlgorithm)
     switch (wantedAlgorithm)
     {
     case Algorithm::CompressZLib:
-        // Zlib requires deflateInit2 and ZLibAPI::MaxBits
-        ret = zlib.deflateInit2(stream, ZLibAPI::DEFAULT_COMPRESSION, ZLibAPI::DEFLATED, ZLibAPI::MaxBits, 8,
+        // Zlib requires deflateInit2 and windowBits
+        ret = zlib.deflateInit2(stream, ZLibAPI::DEFAULT_COMPRESSION, ZLibAPI::DEFLATED, windowBits, 8,
                                 ZLibAPI::DEFAULT_STRATEGY);
         break;
     case Algorithm::CompressGZip:
-        // GZip requires deflateInit2 and 16 + ZLibAPI::MaxBits
-        ret = zlib.deflateInit2(stream, ZLibAPI::DEFAULT_COMPRESSION, ZLibAPI::DEFLATED, 16 + ZLibAPI::MaxBits, 8,
+        // GZip requires deflateInit2 and 16 + windowBits
+        ret = zlib.deflateInit2(stream, ZLibAPI::DEFAULT_COMPRESSION, ZLibAPI::DEFLATED, 16 + windowBits, 8,
                                 ZLibAPI::DEFAULT_STRATEGY);
         break;
     case Algorithm::CompressDeflate:
-        // Deflate requires deflateInit2 and 16 + ZLibAPI::MaxBits
-        ret = zlib.deflateInit2(stream, ZLibAPI::DEFAULT_COMPRESSION, ZLibAPI::DEFLATED, -ZLibAPI::MaxBits, 8,
+        // Deflate requires deflateInit2 and -windowBits
+        ret = zlib.deflateInit2(stream, ZLibAPI::DEFAULT_COMPRESSION, ZLibAPI::DEFLATED, -windowBits, 8,
                                 ZLibAPI::DEFAULT_STRATEGY);
         break;
     case Algorithm::DecompressZLib:
-        // Zlib requires inflateInit2 and ZLibAPI::MaxBits
-        ret = zlib.inflateInit2(stream, ZLibAPI::MaxBits);
+        // Zlib requires inflateInit2 and windowBits
+        ret = zlib.inflateInit2(stream, windowBits);
         break;
     case Algorithm::DecompressGZip:
-        // GZip requires inflateInit2 and 16 + ZLibAPI::MaxBits
-        ret = zlib.inflateInit2(stream, 16 + ZLibAPI::MaxBits);
+        // GZip requires inflateInit2 and 16 + windowBits
+        ret = zlib.inflateInit2(stream, 16 + windowBits);
         break;
     case Algorithm::DecompressDeflate:
-        // Deflate requires inflateInit2 and 16 + ZLibAPI::MaxBits
-        ret = zlib.inflateInit2(stream, -ZLibAPI::MaxBits);
+        // Deflate requires inflateInit2 and -windowBits
+        ret = zlib.inflateInit2(stream, -windowBits);
         break;
     }
     if (ret == ZLibAPI::Error::OK)
@@ -199,6 +277,7 @@ SC::Result SC::ZLibStream::init(Algorithm wantedAlgorithm)
         state = State::Inited;
         return Result(true);
     }
+    zlib.unload();
     return Result::Error("ZLibStream::Init failed");
 }
 
@@ -217,11 +296,39 @@ SC::Result SC::ZLibStream::process(Span<const char>& input, Span<char>& output)
     case Algorithm::DecompressGZip:
     case Algorithm::DecompressDeflate:
         // Decompression
-        return Internal::decompress(stream, input, output);
+        return Internal::decompress(stream, input, output, false);
     }
     AsyncStreamsAssert::unreachable();
 }
 
+SC::Result SC::ZLibStream::processPartial(Span<const char>& input, Span<char>& output)
+{
+    SC_TRY_MSG(not output.empty(), "ZLibStream::processPartial empty output is not allowed");
+    SC_TRY_MSG(algorithm == DecompressZLib or algorithm == DecompressGZip or algorithm == DecompressDeflate,
+               "ZLibStream::processPartial is only for decompression");
+    return Internal::decompress(buffer.reinterpret_as<ZLibAPI::Stream>(), input, output, true);
+}
+
+SC::Result SC::ZLibStream::flush(Span<char>& output, bool& flushed, FlushMode mode)
+{
+    SC_TRY_MSG(not output.empty(), "ZLibStream::flush empty output is not allowed");
+    SC_TRY_MSG(state == State::Inited, "ZLibStream::flush stream is not inited");
+    ZLibAPI::Stream& stream = buffer.reinterpret_as<ZLibAPI::Stream>();
+    switch (algorithm)
+    {
+    case Algorithm::CompressZLib:
+    case Algorithm::CompressGZip:
+    case Algorithm::CompressDeflate: {
+        const ZLibAPI::Flush flag = mode == FullFlush ? ZLibAPI::Flush::FULL_FLUSH : ZLibAPI::Flush::SYNC_FLUSH;
+        return Internal::compressFlush(stream, output, flushed, flag);
+    }
+    case Algorithm::DecompressZLib:
+    case Algorithm::DecompressGZip:
+    case Algorithm::DecompressDeflate: break;
+    }
+    return Result::Error("ZLibStream::flush is only supported when compressing");
+}
+
 SC::Result SC::ZLibStream::finalize(Span<char>& output, bool& streamEnded)
 {
     ZLibAPI::Stream& stream = buffer.reinterpret_as<ZLibAPI::Stream>();
@@ -240,3 +347,35 @@ SC::Result SC::ZLibStream::finalize(Span<char>& output, bool& streamEnded)
     }
     AsyncStreamsAssert::unreachable();
 }
+
+SC::uint32_t SC::ZLibStream::updateCRC32(uint32_t crc, Span<const char> input)
+{
+    static constexpr Internal::CRC32Table table;
+
+    crc = ~crc;
+    for (const char value : input)
+    {
+        crc = table.values[(crc ^ static_cast<uint8_t>(value)) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+SC::uint32_t SC::ZLibStream::combineCRC32(uint32_t crc1, uint32_t crc2, uint64_t length2)
+{
+    // crc(A|B) = crc(A) * x^(8 * length(B)) + crc(B), computing x^(8 * length(B)) by repeated squaring
+    uint32_t power = 1u << 30; // x^1
+    for (int idx = 0; idx < 3; ++idx)
+    {
+        power = Internal::multiplyModCRC32(power, power); // x^8 after three squarings
+    }
+    uint32_t shift = 1u << 31; // x^0
+    for (; length2 != 0; length2 >>= 1)
+    {
+        if (length2 & 1)
+        {
+            shift = Internal::multiplyModCRC32(power, shift);
+        }
+        power = Internal::multiplyModCRC32(power, power);
+    }
+    return Internal::multiplyModCRC32(shift, crc1) ^ crc2;
+}
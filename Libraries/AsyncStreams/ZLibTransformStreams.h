@@ -1,7 +1,9 @@
 // Copyright (c) Stefano Cristiano
 // SPDX-License-Identifier: MIT
 #pragma once
+#include "AsyncParallelTransformStream.h"
 #include "AsyncStreams.h"
+#include "CodecTransformStreams.h"
 #include "Internal/ZLibStream.h"
 
 namespace SC
@@ -18,65 +20,136 @@ struct SyncZLibTransformStream : public AsyncDuplexStream
     virtual bool   canEndWritable() override;
 };
 
+/// @brief Compresses / decompresses with zlib on a thread pool (see SC::AsyncCodecTransformStreamT)
 template <typename T_AsyncEventLoop>
-struct AsyncZLibTransformStreamT : public AsyncTransformStream
+struct AsyncZLibTransformStreamT : public AsyncCodecTransformStreamT<T_AsyncEventLoop, ZLibStream>
 {
-    AsyncZLibTransformStreamT()
-    {
-        asyncWork.work.template bind<AsyncZLibTransformStreamT, &AsyncZLibTransformStreamT::work>(*this);
-        asyncWork.callback.template bind<AsyncZLibTransformStreamT, &AsyncZLibTransformStreamT::afterWork>(*this);
-    }
+};
 
+/// @brief State of each chunk slot of SC::AsyncGZipParallelStreamT
+struct GZipParallelChunkState
+{
     ZLibStream stream;
+    uint32_t   crc = 0;
+};
 
-    typename T_AsyncEventLoop::LoopWork asyncWork;
+/// @brief Compresses data in a single GZIP member, deflating multiple chunks concurrently on a thread pool.
+/// @n
+/// Like `pigz`, each chunk is compressed independently (ending with a full flush) so that the in-order concatenation
+/// of all chunks is a valid deflate stream, and CRC-32 of each chunk is combined on the event loop thread.
+/// Compression ratio is slightly lower than SC::AsyncZLibTransformStreamT, as chunks don't share their dictionary.
+/// Chunk size is bounded by the size of the written buffers and the size of the output buffers from the pool.
+template <typename T_AsyncEventLoop>
+struct AsyncGZipParallelStreamT : public AsyncParallelTransformStreamT<T_AsyncEventLoop, GZipParallelChunkState>
+{
+    using Parent = AsyncParallelTransformStreamT<T_AsyncEventLoop, GZipParallelChunkState>;
+    using Chunk  = typename Parent::Chunk;
 
-    void setEventLoop(T_AsyncEventLoop& loop) { eventLoop = &loop; }
+    /// @brief Inits the stream, see AsyncParallelTransformStreamT::init
+    Result init(AsyncBuffersPool& buffersPool, Span<AsyncReadableStream::Request> readableRequests,
+                Span<AsyncWritableStream::Request> writableRequests, Span<Chunk> chunkSlots)
+    {
+        SC_TRY(Parent::init(buffersPool, readableRequests, writableRequests, chunkSlots));
+        crc       = 0;
+        inputSize = 0;
+        // Deflate streams are inited here, as loading zlib is not thread safe
+        for (Chunk& chunk : chunkSlots)
+        {
+            chunk.state.stream.reset();
+            SC_TRY(chunk.state.stream.init(ZLibStream::CompressDeflate));
+        }
+        return Result(true);
+    }
 
   private:
-    T_AsyncEventLoop* eventLoop = nullptr;
+    static constexpr size_t HeaderSize  = 10;
+    static constexpr size_t TrailerSize = 10; // Final empty block + CRC-32 + input size
+
+    uint32_t crc       = 0;
+    uint64_t inputSize = 0;
+
+    static void writeBytes(Span<char>& output, const uint8_t* bytes, size_t numBytes)
+    {
+        for (size_t idx = 0; idx < numBytes; ++idx)
+        {
+            output[idx] = static_cast<char>(bytes[idx]);
+        }
+        (void)output.sliceStart(numBytes, output);
+    }
 
-    virtual Result onProcess(Span<const char> input, Span<char> output) override
+    static void writeHeader(Span<char>& output)
     {
-        SC_ASYNC_STREAMS_ASSERT_RELEASE(not finalizing);
-        savedInput  = input;
-        savedOutput = output;
-        finalizing  = false;
-        SC_TRY_MSG(eventLoop != nullptr, "AsyncZLibTransformStreamT::setEventLoop not called");
-        return asyncWork.start(*eventLoop);
+        // Magic, deflate method, no flags, no modification time, no extra flags, unknown OS
+        static constexpr uint8_t header[HeaderSize] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff};
+        writeBytes(output, header, HeaderSize);
     }
 
-    virtual Result onFinalize(Span<char> output) override
+    virtual size_t getMaxChunkInputSize(size_t outputSize) const override
     {
-        // Intentionally not resetting savedInput, that can contain leftover data to process
-        savedOutput = output;
-        finalizing  = true;
-        SC_TRY_MSG(eventLoop != nullptr, "AsyncZLibTransformStreamT::setEventLoop not called");
-        return asyncWork.start(*eventLoop);
+        // Deflate worst case (stored blocks) plus space for header and full flush marker
+        constexpr size_t overhead = 64;
+        if (outputSize <= overhead)
+        {
+            return 0;
+        }
+        const size_t available = outputSize - overhead;
+        return available - (available >> 11);
     }
 
-    void afterWork(typename T_AsyncEventLoop::LoopWork::Result&)
+    virtual Result onProcessChunk(GZipParallelChunkState& state, uint64_t sequence, Span<const char> input,
+                                  Span<char>& output) override
     {
-        if (finalizing)
+        if (sequence == 0)
         {
-            AsyncTransformStream::afterFinalize(savedOutput, streamEnded);
+            writeHeader(output);
         }
-        else
+        state.crc = ZLibStream::updateCRC32(0, input);
+        while (not input.empty())
         {
-            AsyncTransformStream::afterProcess(savedInput, savedOutput);
+            SC_TRY_MSG(not output.empty(), "AsyncGZipParallelStreamT - insufficient output space");
+            SC_TRY(state.stream.process(input, output));
         }
+        // Full flush resets the dictionary, so that next chunk doesn't reference data from this one
+        bool flushed = false;
+        while (not flushed)
+        {
+            SC_TRY_MSG(not output.empty(), "AsyncGZipParallelStreamT - insufficient output space");
+            SC_TRY(state.stream.flush(output, flushed, ZLibStream::FullFlush));
+        }
+        return Result(true);
     }
 
-    Result work()
+    virtual Result onChunkCompleted(GZipParallelChunkState& state, size_t chunkInputSize) override
     {
-        return finalizing ? stream.finalize(savedOutput, streamEnded) : stream.process(savedInput, savedOutput);
+        crc = ZLibStream::combineCRC32(crc, state.crc, chunkInputSize);
+        inputSize += chunkInputSize;
+        return Result(true);
     }
 
-    bool finalizing  = false;
-    bool streamEnded = false;
-
-    Span<const char> savedInput;
-    Span<char>       savedOutput;
+    virtual Result onFinalize(Span<char>& output) override
+    {
+        SC_TRY_MSG(output.sizeInBytes() >= HeaderSize + TrailerSize, "AsyncGZipParallelStreamT - insufficient space");
+        if (Parent::getNumChunks() == 0)
+        {
+            writeHeader(output);
+        }
+        const uint32_t size = static_cast<uint32_t>(inputSize); // GZIP stores input size modulo 2^32
+        // Final empty fixed block, followed by CRC-32 and input size in little endian
+        const uint8_t trailer[TrailerSize] = {
+            0x03,
+            0x00,
+            static_cast<uint8_t>(crc),
+            static_cast<uint8_t>(crc >> 8),
+            static_cast<uint8_t>(crc >> 16),
+            static_cast<uint8_t>(crc >> 24),
+            static_cast<uint8_t>(size),
+            static_cast<uint8_t>(size >> 8),
+            static_cast<uint8_t>(size >> 16),
+            static_cast<uint8_t>(size >> 24),
+        };
+        writeBytes(output, trailer, TrailerSize);
+        return Result(true);
+    }
 };
 
 } // namespace SC
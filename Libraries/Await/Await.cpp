@@ -959,6 +959,13 @@ AwaitSocketSendToAwaiter AwaitEventLoop::sendTo(const SocketDescriptor& socket,
     return AwaitSocketSendToAwaiter(*this, socket, address, data, outResult);
 }
 
+AwaitSocketSendToAwaiter AwaitEventLoop::sendTo(const SocketDescriptor& socket,
+                                                Span<const AsyncSocketSendDatagram> datagrams,
+                                                AwaitSocketSendResult* outResult)
+{
+    return AwaitSocketSendToAwaiter(*this, socket, datagrams, outResult);
+}
+
 AwaitSocketSendAllAwaiter AwaitEventLoop::sendAll(const SocketDescriptor& socket, Span<const char> data,
                                                   AwaitSocketSendResult* outResult)
 {
@@ -995,6 +1002,13 @@ AwaitSocketReceiveFromAwaiter AwaitEventLoop::receiveFrom(const SocketDescriptor
     return AwaitSocketReceiveFromAwaiter(*this, socket, buffer, outResult);
 }
 
+AwaitSocketReceiveFromAwaiter AwaitEventLoop::receiveFrom(const SocketDescriptor&          socket,
+                                                          Span<AsyncSocketReceiveDatagram> datagrams,
+                                                          AwaitSocketReceiveFromResult&    outResult)
+{
+    return AwaitSocketReceiveFromAwaiter(*this, socket, datagrams, outResult);
+}
+
 AwaitFileReadAwaiter AwaitEventLoop::fileRead(const FileDescriptor& file, Span<char> buffer,
                                               AwaitFileReadResult& outResult, AwaitFileReadOptions options)
 {
@@ -1331,6 +1345,12 @@ AwaitSocketSendToAwaiter::AwaitSocketSendToAwaiter(AwaitEventLoop& await, const
     : await(await), socket(socket), address(address), buffers(data), outResult(outResult), singleBuffer(false)
 {}
 
+AwaitSocketSendToAwaiter::AwaitSocketSendToAwaiter(AwaitEventLoop& await, const SocketDescriptor& socket,
+                                                   Span<const AsyncSocketSendDatagram> datagrams,
+                                                   AwaitSocketSendResult*              outResult)
+    : await(await), socket(socket), datagrams(datagrams), outResult(outResult)
+{}
+
 bool AwaitSocketSendToAwaiter::await_ready() const { return false; }
 
 bool AwaitSocketSendToAwaiter::await_suspend(AwaitTask::Handle newContinuation)
@@ -1347,7 +1367,11 @@ bool AwaitSocketSendToAwaiter::await_suspend(AwaitTask::Handle newContinuation)
         continuation.resume();
     };
 
-    if (singleBuffer)
+    if (not datagrams.empty())
+    {
+        operationResult = request.start(await.asyncEventLoop(), socket, datagrams);
+    }
+    else if (singleBuffer)
     {
         operationResult = request.start(await.asyncEventLoop(), socket, address, data);
     }
@@ -1833,6 +1857,12 @@ AwaitSocketReceiveFromAwaiter::AwaitSocketReceiveFromAwaiter(AwaitEventLoop& awa
     : await(await), socket(socket), buffer(buffer), outResult(outResult)
 {}
 
+AwaitSocketReceiveFromAwaiter::AwaitSocketReceiveFromAwaiter(AwaitEventLoop& await, const SocketDescriptor& socket,
+                                                             Span<AsyncSocketReceiveDatagram> datagrams,
+                                                             AwaitSocketReceiveFromResult&    outResult)
+    : await(await), socket(socket), datagrams(datagrams), outResult(outResult)
+{}
+
 bool AwaitSocketReceiveFromAwaiter::await_ready() const { return false; }
 
 bool AwaitSocketReceiveFromAwaiter::await_suspend(AwaitTask::Handle newContinuation)
@@ -1842,13 +1872,28 @@ bool AwaitSocketReceiveFromAwaiter::await_suspend(AwaitTask::Handle newContinuat
     outResult        = {};
     request.callback = [this](AsyncSocketReceiveFrom::Result& result)
     {
-        operationResult         = result.get(outResult.data);
-        outResult.sourceAddress = result.getSourceAddress();
-        outResult.disconnected  = result.completionData.disconnected;
+        if (datagrams.empty())
+        {
+            operationResult         = result.get(outResult.data);
+            outResult.sourceAddress = result.getSourceAddress();
+        }
+        else
+        {
+            operationResult     = result.isValid();
+            outResult.datagrams = result.getDatagrams();
+        }
+        outResult.disconnected = result.completionData.disconnected;
         continuation.resume();
     };
 
-    operationResult = request.start(await.asyncEventLoop(), socket, buffer);
+    if (datagrams.empty())
+    {
+        operationResult = request.start(await.asyncEventLoop(), socket, buffer);
+    }
+    else
+    {
+        operationResult = request.start(await.asyncEventLoop(), socket, datagrams);
+    }
     return operationResult;
 }
 
@@ -126,6 +126,8 @@ struct AwaitSocketReceiveFromResult
     Span<char>      data;
     SocketIPAddress sourceAddress;
     bool            disconnected = false;
+
+    Span<AsyncSocketReceiveDatagram> datagrams; ///< Received datagrams (batched receiveFrom only)
 };
 
 /// @brief Result object populated by AwaitEventLoop::fileRead.
@@ -505,6 +507,8 @@ struct SC_AWAIT_EXPORT AwaitEventLoop
                                      AwaitSocketSendResult* outResult = nullptr);
     AwaitSocketSendToAwaiter  sendTo(const SocketDescriptor& socket, SocketIPAddress address,
                                      Span<Span<const char>> data, AwaitSocketSendResult* outResult = nullptr);
+    AwaitSocketSendToAwaiter  sendTo(const SocketDescriptor& socket, Span<const AsyncSocketSendDatagram> datagrams,
+                                     AwaitSocketSendResult* outResult = nullptr);
     AwaitSocketSendAllAwaiter sendAll(const SocketDescriptor& socket, Span<const char> data,
                                       AwaitSocketSendResult* outResult = nullptr);
     AwaitSocketSendAllBuffersAwaiter sendAll(const SocketDescriptor& socket, Span<Span<const char>> data,
@@ -517,6 +521,9 @@ struct SC_AWAIT_EXPORT AwaitEventLoop
                                                  AwaitSocketReceiveLineResult& outResult);
     AwaitSocketReceiveFromAwaiter    receiveFrom(const SocketDescriptor& socket, Span<char> buffer,
                                                  AwaitSocketReceiveFromResult& outResult);
+    AwaitSocketReceiveFromAwaiter    receiveFrom(const SocketDescriptor& socket,
+                                                 Span<AsyncSocketReceiveDatagram> datagrams,
+                                                 AwaitSocketReceiveFromResult& outResult);
 
     AwaitFileReadAwaiter fileRead(const FileDescriptor& file, Span<char> buffer, AwaitFileReadResult& outResult,
                                   AwaitFileReadOptions options = {});
@@ -713,16 +720,19 @@ struct SC_AWAIT_EXPORT AwaitSocketSendToAwaiter
                              Span<const char> data, AwaitSocketSendResult* outResult);
     AwaitSocketSendToAwaiter(AwaitEventLoop& await, const SocketDescriptor& socket, SocketIPAddress address,
                              Span<Span<const char>> data, AwaitSocketSendResult* outResult);
-
-    AwaitEventLoop&         await;
-    const SocketDescriptor& socket;
-    SocketIPAddress         address;
-    Span<const char>        data;
-    Span<Span<const char>>  buffers;
-    AwaitSocketSendResult*  outResult = nullptr;
-    AsyncSocketSendTo       request;
-    Result                  operationResult = Result(true);
-    bool                    singleBuffer    = true;
+    AwaitSocketSendToAwaiter(AwaitEventLoop& await, const SocketDescriptor& socket,
+                             Span<const AsyncSocketSendDatagram> datagrams, AwaitSocketSendResult* outResult);
+
+    AwaitEventLoop&                     await;
+    const SocketDescriptor&             socket;
+    SocketIPAddress                     address;
+    Span<const char>                    data;
+    Span<Span<const char>>              buffers;
+    Span<const AsyncSocketSendDatagram> datagrams;
+    AwaitSocketSendResult*              outResult = nullptr;
+    AsyncSocketSendTo                   request;
+    Result                              operationResult = Result(true);
+    bool                                singleBuffer    = true;
 
     bool   await_ready() const;
     bool   await_suspend(AwaitTask::Handle continuation);
@@ -889,13 +899,16 @@ struct SC_AWAIT_EXPORT AwaitSocketReceiveFromAwaiter
 {
     AwaitSocketReceiveFromAwaiter(AwaitEventLoop& await, const SocketDescriptor& socket, Span<char> buffer,
                                   AwaitSocketReceiveFromResult& outResult);
-
-    AwaitEventLoop&               await;
-    const SocketDescriptor&       socket;
-    Span<char>                    buffer;
-    AwaitSocketReceiveFromResult& outResult;
-    AsyncSocketReceiveFrom        request;
-    Result                        operationResult = Result(true);
+    AwaitSocketReceiveFromAwaiter(AwaitEventLoop& await, const SocketDescriptor& socket,
+                                  Span<AsyncSocketReceiveDatagram> datagrams, AwaitSocketReceiveFromResult& outResult);
+
+    AwaitEventLoop&                  await;
+    const SocketDescriptor&          socket;
+    Span<char>                       buffer;
+    Span<AsyncSocketReceiveDatagram> datagrams;
+    AwaitSocketReceiveFromResult&    outResult;
+    AsyncSocketReceiveFrom           request;
+    Result                           operationResult = Result(true);
 
     bool   await_ready() const;
     bool   await_suspend(AwaitTask::Handle continuation);
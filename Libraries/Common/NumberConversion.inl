@@ -0,0 +1,781 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+//
+// Intentionally no #pragma once / include guard.
+// This file is source material for private implementation namespaces.
+// Each including library must get its own copy, especially in single-file amalgamations.
+//
+// Include from inside a unique private namespace.
+// Required includes before this file: locale.h, stdlib.h.
+// Required SC types: Span, StringSpan.
+
+/// @brief Locale independent conversion between numbers and their ASCII representation.
+/// Floating points are formatted with the shortest sequence of digits that parses back to the same exact value
+/// (Grisu2 with 64 bit cached powers of ten), using the same layout rules of JavaScript `Number.toString`.
+/// Parsing takes an exact fast path when significand and exponent fit the floating point precision (Clinger), that
+/// covers most of the numbers found in practice, falling back to `strtod` / `strtof` for the remaining ones.
+struct NumberConversion
+{
+    static constexpr size_t MaxChars = 32; ///< Buffer size sufficient for any number formatted by this struct
+
+    /// @brief Formats the shortest representation of a double parsing back to the same value (`nan`, `inf`, `-inf`)
+    /// @param value The value to format
+    /// @param buffer Storage for the formatted text, at least NumberConversion::MaxChars bytes
+    /// @param text Formatted text, pointing inside buffer (not null-terminated)
+    /// @return `false` if buffer is too small
+    [[nodiscard]] static bool formatDouble(double value, Span<char> buffer, StringSpan& text);
+
+    /// @brief Formats the shortest representation of a float parsing back to the same value (`nan`, `inf`, `-inf`)
+    /// @see NumberConversion::formatDouble
+    [[nodiscard]] static bool formatFloat(float value, Span<char> buffer, StringSpan& text);
+
+    /// @brief Formats a signed integer in base 10
+    /// @see NumberConversion::formatDouble
+    [[nodiscard]] static bool formatInt64(int64_t value, Span<char> buffer, StringSpan& text);
+
+    /// @brief Formats an unsigned integer in base 10
+    /// @see NumberConversion::formatDouble
+    [[nodiscard]] static bool formatUInt64(uint64_t value, Span<char> buffer, StringSpan& text);
+
+    /// @brief Formats a double in fixed notation with given number of decimals, like `printf("%.*f")` does.
+    /// Digits are computed exactly with integer arithmetic and rounded half to even, so output is the same of a
+    /// correctly rounding C library.
+    /// @param value The value to format
+    /// @param precision Number of digits after the decimal point (no decimal point is written when zero)
+    /// @param buffer Storage for the formatted text, at least 23 + precision bytes
+    /// @param text Formatted text, pointing inside buffer (not null-terminated)
+    /// @return `false` if buffer is too small or for values outside the exact integer range, that is for nan,
+    /// infinities, magnitudes larger than 2^64 and some values smaller than 2^-8 having more than 60 fractional bits
+    [[nodiscard]] static bool formatFixed(double value, uint32_t precision, Span<char> buffer, StringSpan& text);
+
+    /// @brief Parses a decimal number (`[+-]digits[.digits][(e|E)[+-]digits]`, leading or trailing dot allowed).
+    /// @param text ASCII or UTF-8 text that must be entirely made of the number
+    /// @param value The correctly rounded parsed value
+    /// @return `false` if text is not a valid number or is UTF-16
+    [[nodiscard]] static bool parseDouble(StringSpan text, double& value);
+
+    /// @brief Parses a decimal number as float, rounding it directly to single precision
+    /// @see NumberConversion::parseDouble
+    [[nodiscard]] static bool parseFloat(StringSpan text, float& value);
+
+  private:
+    struct Internal;
+};
+
+//-----------------------------------------------------------------------------------------------------------------------
+// Implementation details
+//-----------------------------------------------------------------------------------------------------------------------
+struct NumberConversion::Internal
+{
+    // Floating point number with 64 bit significand (f * 2^e)
+    struct DiyFp
+    {
+        uint64_t f = 0;
+        int      e = 0;
+
+        static DiyFp sub(DiyFp x, DiyFp y) { return {x.f - y.f, x.e}; }
+
+        // Upper 64 bits of the 128 bit product, rounded
+        static DiyFp mul(DiyFp x, DiyFp y)
+        {
+            const uint64_t xLo = x.f & 0xFFFFFFFFu;
+            const uint64_t xHi = x.f >> 32u;
+            const uint64_t yLo = y.f & 0xFFFFFFFFu;
+            const uint64_t yHi = y.f >> 32u;
+
+            const uint64_t p0 = xLo * yLo;
+            const uint64_t p1 = xLo * yHi;
+            const uint64_t p2 = xHi * yLo;
+            const uint64_t p3 = xHi * yHi;
+
+            uint64_t mid = (p0 >> 32u) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+            mid += uint64_t(1) << 31u;
+            return {p3 + (p1 >> 32u) + (p2 >> 32u) + (mid >> 32u), x.e + y.e + 64};
+        }
+
+        static DiyFp normalize(DiyFp x)
+        {
+            while ((x.f >> 63u) == 0)
+            {
+                x.f <<= 1u;
+                x.e--;
+            }
+            return x;
+        }
+
+        static DiyFp normalizeTo(DiyFp x, int exponent) { return {x.f << (x.e - exponent), exponent}; }
+    };
+
+    // Value with its (normalized) lower and upper rounding boundaries
+    struct Boundaries
+    {
+        DiyFp w, minus, plus;
+    };
+
+    struct CachedPower
+    {
+        uint64_t f;
+        int      e;
+        int      k;
+    };
+
+    template <int SignificandBits, int ExponentBias>
+    static Boundaries computeBoundaries(uint64_t significand, uint64_t biasedExponent)
+    {
+        constexpr uint64_t HiddenBit = uint64_t(1) << SignificandBits;
+        constexpr int      MinExp    = 1 - ExponentBias - SignificandBits;
+
+        const DiyFp v = biasedExponent == 0
+                            ? DiyFp{significand, MinExp}
+                            : DiyFp{significand + HiddenBit, static_cast<int>(biasedExponent) + MinExp - 1};
+
+        // Lower boundary is closer when significand is a power of two (and not the smallest normal)
+        const bool  lowerIsCloser = significand == 0 and biasedExponent > 1;
+        const DiyFp plus          = {2 * v.f + 1, v.e - 1};
+        const DiyFp minus         = lowerIsCloser ? DiyFp{4 * v.f - 1, v.e - 2} : DiyFp{2 * v.f - 1, v.e - 1};
+
+        const DiyFp normalizedPlus = DiyFp::normalize(plus);
+        return {DiyFp::normalize(v), DiyFp::normalizeTo(minus, normalizedPlus.e), normalizedPlus};
+    }
+
+    // Returns a cached power c = 10^-k such that the product with a number with binary exponent e lands in [-60, -32]
+    static CachedPower getCachedPower(int e)
+    {
+        static constexpr CachedPower cachedPowers[] = {
+            {0xAB70FE17C79AC6CA, -1060, -300}, {0xFF77B1FCBEBCDC4F, -1034, -292},
+            {0xBE5691EF416BD60C, -1007, -284}, {0x8DD01FAD907FFC3C,  -980, -276},
+            {0xD3515C2831559A83,  -954, -268}, {0x9D71AC8FADA6C9B5,  -927, -260},
+            {0xEA9C227723EE8BCB,  -901, -252}, {0xAECC49914078536D,  -874, -244},
+            {0x823C12795DB6CE57,  -847, -236}, {0xC21094364DFB5637,  -821, -228},
+            {0x9096EA6F3848984F,  -794, -220}, {0xD77485CB25823AC7,  -768, -212},
+            {0xA086CFCD97BF97F4,  -741, -204}, {0xEF340A98172AACE5,  -715, -196},
+            {0xB23867FB2A35B28E,  -688, -188}, {0x84C8D4DFD2C63F3B,  -661, -180},
+            {0xC5DD44271AD3CDBA,  -635, -172}, {0x936B9FCEBB25C996,  -608, -164},
+            {0xDBAC6C247D62A584,  -582, -156}, {0xA3AB66580D5FDAF6,  -555, -148},
+            {0xF3E2F893DEC3F126,  -529, -140}, {0xB5B5ADA8AAFF80B8,  -502, -132},
+            {0x87625F056C7C4A8B,  -475, -124}, {0xC9BCFF6034C13053,  -449, -116},
+            {0x964E858C91BA2655,  -422, -108}, {0xDFF9772470297EBD,  -396, -100},
+            {0xA6DFBD9FB8E5B88F,  -369,  -92}, {0xF8A95FCF88747D94,  -343,  -84},
+            {0xB94470938FA89BCF,  -316,  -76}, {0x8A08F0F8BF0F156B,  -289,  -68},
+            {0xCDB02555653131B6,  -263,  -60}, {0x993FE2C6D07B7FAC,  -236,  -52},
+            {0xE45C10C42A2B3B06,  -210,  -44}, {0xAA242499697392D3,  -183,  -36},
+            {0xFD87B5F28300CA0E,  -157,  -28}, {0xBCE5086492111AEB,  -130,  -20},
+            {0x8CBCCC096F5088CC,  -103,  -12}, {0xD1B71758E219652C,   -77,   -4},
+            {0x9C40000000000000,   -50,    4}, {0xE8D4A51000000000,   -24,   12},
+            {0xAD78EBC5AC620000,     3,   20}, {0x813F3978F8940984,    30,   28},
+            {0xC097CE7BC90715B3,    56,   36}, {0x8F7E32CE7BEA5C70,    83,   44},
+            {0xD5D238A4ABE98068,   109,   52}, {0x9F4F2726179A2245,   136,   60},
+            {0xED63A231D4C4FB27,   162,   68}, {0xB0DE65388CC8ADA8,   189,   76},
+            {0x83C7088E1AAB65DB,   216,   84}, {0xC45D1DF942711D9A,   242,   92},
+            {0x924D692CA61BE758,   269,  100}, {0xDA01EE641A708DEA,   295,  108},
+            {0xA26DA3999AEF774A,   322,  116}, {0xF209787BB47D6B85,   348,  124},
+            {0xB454E4A179DD1877,   375,  132}, {0x865B86925B9BC5C2,   402,  140},
+            {0xC83553C5C8965D3D,   428,  148}, {0x952AB45CFA97A0B3,   455,  156},
+            {0xDE469FBD99A05FE3,   481,  164}, {0xA59BC234DB398C25,   508,  172},
+            {0xF6C69A72A3989F5C,   534,  180}, {0xB7DCBF5354E9BECE,   561,  188},
+            {0x88FCF317F22241E2,   588,  196}, {0xCC20CE9BD35C78A5,   614,  204},
+            {0x98165AF37B2153DF,   641,  212}, {0xE2A0B5DC971F303A,   667,  220},
+            {0xA8D9D1535CE3B396,   694,  228}, {0xFB9B7CD9A4A7443C,   720,  236},
+            {0xBB764C4CA7A44410,   747,  244}, {0x8BAB8EEFB6409C1A,   774,  252},
+            {0xD01FEF10A657842C,   800,  260}, {0x9B10A4E5E9913129,   827,  268},
+            {0xE7109BFBA19C0C9D,   853,  276}, {0xAC2820D9623BF429,   880,  284},
+            {0x80444B5E7AA7CF85,   907,  292}, {0xBF21E44003ACDD2D,   933,  300},
+            {0x8E679C2F5E44FF8F,   960,  308}, {0xD433179D9C8CB841,   986,  316},
+            {0x9E19DB92B4E31BA9,  1013,  324},
+        };
+        constexpr int Alpha      = -60;
+        constexpr int MinDecExp  = -300;
+        constexpr int DecExpStep = 8;
+
+        const int f     = Alpha - e - 1;
+        const int k     = (f * 78913) / (1 << 18) + static_cast<int>(f > 0); // ceil(f * log10(2))
+        const int index = (-MinDecExp + k + (DecExpStep - 1)) / DecExpStep;
+        return cachedPowers[index];
+    }
+
+    static int findLargestPow10(uint32_t n, uint32_t& pow10)
+    {
+        constexpr uint32_t powers[] = {1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+        for (int idx = 0; idx < 9; ++idx)
+        {
+            if (n >= powers[idx])
+            {
+                pow10 = powers[idx];
+                return 10 - idx;
+            }
+        }
+        pow10 = 1;
+        return 1;
+    }
+
+    // Moves the last digit towards the value, as long as it stays inside the rounding interval
+    static void round(char* digits, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK)
+    {
+        while (rest < dist and delta - rest >= tenK and (rest + tenK < dist or dist - rest > rest + tenK - dist))
+        {
+            digits[length - 1]--;
+            rest += tenK;
+        }
+    }
+
+    // Generates the shortest digits of a number inside [minus, plus], where plus.e is in [-60, -32]
+    static void generateDigits(char* digits, int& length, int& decimalExponent, DiyFp minus, DiyFp w, DiyFp plus)
+    {
+        uint64_t delta = DiyFp::sub(plus, minus).f;
+        uint64_t dist  = DiyFp::sub(plus, w).f;
+
+        const DiyFp one = {uint64_t(1) << -plus.e, plus.e};
+
+        uint32_t integral   = static_cast<uint32_t>(plus.f >> -one.e);
+        uint64_t fractional = plus.f & (one.f - 1);
+
+        uint32_t pow10 = 0;
+        int      n     = findLargestPow10(integral, pow10);
+        while (n > 0)
+        {
+            digits[length++] = static_cast<char>('0' + integral / pow10);
+            integral %= pow10;
+            n--;
+            const uint64_t rest = (uint64_t(integral) << -one.e) + fractional;
+            if (rest <= delta)
+            {
+                decimalExponent += n;
+                round(digits, length, dist, delta, rest, uint64_t(pow10) << -one.e);
+                return;
+            }
+            pow10 /= 10;
+        }
+        int m = 0;
+        for (;;)
+        {
+            fractional *= 10;
+            digits[length++] = static_cast<char>('0' + (fractional >> -one.e));
+            fractional &= one.f - 1;
+            m++;
+            delta *= 10;
+            dist *= 10;
+            if (fractional <= delta)
+            {
+                break;
+            }
+        }
+        decimalExponent -= m;
+        round(digits, length, dist, delta, fractional, one.f);
+    }
+
+    static void grisu2(char* digits, int& length, int& decimalExponent, Boundaries boundaries)
+    {
+        const CachedPower cached = getCachedPower(boundaries.plus.e);
+        const DiyFp       c      = {cached.f, cached.e};
+
+        const DiyFp w     = DiyFp::mul(boundaries.w, c);
+        const DiyFp minus = DiyFp::mul(boundaries.minus, c);
+        const DiyFp plus  = DiyFp::mul(boundaries.plus, c);
+
+        // Shrinks the interval by one ulp on both sides to account for rounding errors of the products
+        length          = 0;
+        decimalExponent = -cached.k;
+        generateDigits(digits, length, decimalExponent, {minus.f + 1, minus.e}, w, {plus.f - 1, plus.e});
+    }
+
+    static char* writeExponent(char* it, int exponent)
+    {
+        *it++ = 'e';
+        *it++ = exponent < 0 ? '-' : '+';
+        if (exponent < 0)
+        {
+            exponent = -exponent;
+        }
+        if (exponent >= 100)
+        {
+            *it++ = static_cast<char>('0' + exponent / 100);
+            exponent %= 100;
+            *it++ = static_cast<char>('0' + exponent / 10);
+        }
+        else if (exponent >= 10)
+        {
+            *it++ = static_cast<char>('0' + exponent / 10);
+        }
+        *it++ = static_cast<char>('0' + exponent % 10);
+        return it;
+    }
+
+    // Lays out digits (d1 d2 ... dk x 10^(n - k)) like JavaScript Number.toString does
+    static char* layoutDigits(char* it, const char* digits, int k, int n)
+    {
+        if (k <= n and n <= 21)
+        {
+            // digits[000]
+            for (int idx = 0; idx < k; ++idx)
+                *it++ = digits[idx];
+            for (int idx = k; idx < n; ++idx)
+                *it++ = '0';
+        }
+        else if (0 < n and n <= 21)
+        {
+            // dig.its
+            for (int idx = 0; idx < n; ++idx)
+                *it++ = digits[idx];
+            *it++ = '.';
+            for (int idx = n; idx < k; ++idx)
+                *it++ = digits[idx];
+        }
+        else if (-6 < n and n <= 0)
+        {
+            // 0.[000]digits
+            *it++ = '0';
+            *it++ = '.';
+            for (int idx = n; idx < 0; ++idx)
+                *it++ = '0';
+            for (int idx = 0; idx < k; ++idx)
+                *it++ = digits[idx];
+        }
+        else
+        {
+            // d[.igits]e+123
+            *it++ = digits[0];
+            if (k > 1)
+            {
+                *it++ = '.';
+                for (int idx = 1; idx < k; ++idx)
+                    *it++ = digits[idx];
+            }
+            it = writeExponent(it, n - 1);
+        }
+        return it;
+    }
+
+    static char* writeSpecial(char* it, bool negative, bool isNaN)
+    {
+        const char* special = isNaN ? "nan" : (negative ? "-inf" : "inf");
+        while (*special != 0)
+            *it++ = *special++;
+        return it;
+    }
+
+    template <int SignificandBits, int ExponentBits>
+    static bool formatFloating(uint64_t bits, Span<char> buffer, StringSpan& text)
+    {
+        if (buffer.sizeInBytes() < MaxChars)
+        {
+            return false;
+        }
+        constexpr uint64_t SignificandMask = (uint64_t(1) << SignificandBits) - 1;
+        constexpr uint64_t ExponentMask    = (uint64_t(1) << ExponentBits) - 1;
+        constexpr int      ExponentBias    = (1 << (ExponentBits - 1)) - 1;
+
+        const uint64_t significand = bits & SignificandMask;
+        const uint64_t exponent    = (bits >> SignificandBits) & ExponentMask;
+        const bool     negative    = ((bits >> (SignificandBits + ExponentBits)) & 1) != 0;
+
+        char* it = buffer.data();
+        if (exponent == ExponentMask)
+        {
+            it = writeSpecial(it, negative, significand != 0);
+        }
+        else
+        {
+            if (negative)
+            {
+                *it++ = '-';
+            }
+            if (exponent == 0 and significand == 0)
+            {
+                *it++ = '0';
+            }
+            else
+            {
+                char digits[20];
+                int  length          = 0;
+                int  decimalExponent = 0;
+                grisu2(digits, length, decimalExponent,
+                       computeBoundaries<SignificandBits, ExponentBias>(significand, exponent));
+                it = layoutDigits(it, digits, length, length + decimalExponent);
+            }
+        }
+        text = StringSpan({buffer.data(), static_cast<size_t>(it - buffer.data())}, false, StringEncoding::Ascii);
+        return true;
+    }
+
+    static bool formatUnsigned(uint64_t value, bool negative, Span<char> buffer, StringSpan& text)
+    {
+        if (buffer.sizeInBytes() < 21)
+        {
+            return false;
+        }
+        static constexpr char pairs[] = "0001020304050607080910111213141516171819"
+                                        "2021222324252627282930313233343536373839"
+                                        "4041424344454647484950515253545556575859"
+                                        "6061626364656667686970717273747576777879"
+                                        "8081828384858687888990919293949596979899";
+        // Writes digits backwards, two at a time, from the end of a local buffer
+        char  digits[24];
+        char* end   = digits + sizeof(digits);
+        char* start = end;
+        while (value >= 100)
+        {
+            const size_t pair = static_cast<size_t>(value % 100) * 2;
+            value /= 100;
+            *--start = pairs[pair + 1];
+            *--start = pairs[pair];
+        }
+        if (value >= 10)
+        {
+            const size_t pair = static_cast<size_t>(value) * 2;
+            *--start          = pairs[pair + 1];
+            *--start          = pairs[pair];
+        }
+        else
+        {
+            *--start = static_cast<char>('0' + value);
+        }
+        if (negative)
+        {
+            *--start = '-';
+        }
+        const size_t length = static_cast<size_t>(end - start);
+        CompilerBuiltins::copy(buffer.data(), start, length);
+        text = StringSpan({buffer.data(), length}, false, StringEncoding::Ascii);
+        return true;
+    }
+
+    // Decimal number as parsed from text: (-1)^negative x significand x 10^exponent
+    struct Decimal
+    {
+        uint64_t significand = 0;
+        int64_t  exponent    = 0;
+        bool     negative    = false;
+        bool     truncated   = false; // More than 19 significant digits, some of which are not zero
+    };
+
+    static bool isDigit(char c) { return c >= '0' and c <= '9'; }
+
+    static bool parseDecimal(const char* it, const char* end, Decimal& decimal)
+    {
+        constexpr int MaxDigits = 19; // 10^19 - 1 still fits in uint64_t
+        if (it < end and (*it == '-' or *it == '+'))
+        {
+            decimal.negative = *it == '-';
+            it++;
+        }
+        bool hasDigits = false;
+        int  numDigits = 0;
+        while (it < end and *it == '0')
+        {
+            hasDigits = true;
+            it++;
+        }
+        while (it < end and isDigit(*it))
+        {
+            hasDigits = true;
+            if (numDigits < MaxDigits)
+            {
+                decimal.significand = decimal.significand * 10 + static_cast<uint64_t>(*it - '0');
+                numDigits++;
+            }
+            else
+            {
+                decimal.exponent++;
+                decimal.truncated = decimal.truncated or *it != '0';
+            }
+            it++;
+        }
+        if (it < end and *it == '.')
+        {
+            it++;
+            while (it < end and isDigit(*it))
+            {
+                hasDigits = true;
+                if (numDigits == 0 and *it == '0')
+                {
+                    decimal.exponent--; // leading zeros of the fraction are not significant
+                }
+                else if (numDigits < MaxDigits)
+                {
+                    decimal.significand = decimal.significand * 10 + static_cast<uint64_t>(*it - '0');
+                    decimal.exponent--;
+                    numDigits++;
+                }
+                else
+                {
+                    decimal.truncated = decimal.truncated or *it != '0';
+                }
+                it++;
+            }
+        }
+        if (not hasDigits)
+        {
+            return false;
+        }
+        if (it < end and (*it == 'e' or *it == 'E'))
+        {
+            it++;
+            bool negativeExponent = false;
+            if (it < end and (*it == '-' or *it == '+'))
+            {
+                negativeExponent = *it == '-';
+                it++;
+            }
+            if (it == end or not isDigit(*it))
+            {
+                return false;
+            }
+            int64_t exponent = 0;
+            while (it < end and isDigit(*it))
+            {
+                if (exponent < 100000) // saturates, as the value is anyway zero or infinity
+                {
+                    exponent = exponent * 10 + (*it - '0');
+                }
+                it++;
+            }
+            decimal.exponent += negativeExponent ? -exponent : exponent;
+        }
+        return it == end;
+    }
+
+    static bool parseFallback(const char* it, size_t length, const Decimal& decimal, bool asFloat, double& value)
+    {
+        // Strtod is locale dependent, so the dot is replaced with the decimal point of the current locale
+        const char decimalPoint = ::localeconv()->decimal_point[0];
+
+        char  buffer[128];
+        char* bufferIt = buffer;
+        if (length < sizeof(buffer))
+        {
+            for (size_t idx = 0; idx < length; ++idx)
+            {
+                *bufferIt++ = it[idx] == '.' ? decimalPoint : it[idx];
+            }
+        }
+        else
+        {
+            // Re-writes too long numbers from their first 19 significant digits, keeping a sticky non-zero digit
+            // when some have been truncated, so that rounding direction is preserved
+            StringSpan text;
+            if (decimal.negative)
+            {
+                *bufferIt++ = '-';
+            }
+            (void)formatUnsigned(decimal.significand, false, {bufferIt, 24}, text);
+            bufferIt += text.sizeInBytes();
+            int64_t exponent = decimal.exponent;
+            if (decimal.truncated)
+            {
+                *bufferIt++ = '1';
+                exponent -= 1;
+            }
+            *bufferIt++ = 'e';
+            (void)formatUnsigned(static_cast<uint64_t>(exponent < 0 ? -exponent : exponent), exponent < 0,
+                                 {bufferIt, 24}, text);
+            bufferIt += text.sizeInBytes();
+        }
+        *bufferIt = 0;
+        char* parsedEnd = nullptr;
+        value           = asFloat ? static_cast<double>(::strtof(buffer, &parsedEnd)) : ::strtod(buffer, &parsedEnd);
+        return parsedEnd == bufferIt;
+    }
+};
+
+inline bool NumberConversion::formatDouble(double value, Span<char> buffer, StringSpan& text)
+{
+    uint64_t bits = 0;
+    CompilerBuiltins::copy(reinterpret_cast<char*>(&bits), reinterpret_cast<const char*>(&value), sizeof(bits));
+    return Internal::formatFloating<52, 11>(bits, buffer, text);
+}
+
+inline bool NumberConversion::formatFloat(float value, Span<char> buffer, StringSpan& text)
+{
+    uint32_t bits = 0;
+    CompilerBuiltins::copy(reinterpret_cast<char*>(&bits), reinterpret_cast<const char*>(&value), sizeof(bits));
+    return Internal::formatFloating<23, 8>(bits, buffer, text);
+}
+
+inline bool NumberConversion::formatInt64(int64_t value, Span<char> buffer, StringSpan& text)
+{
+    const uint64_t magnitude = value < 0 ? uint64_t(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    return Internal::formatUnsigned(magnitude, value < 0, buffer, text);
+}
+
+inline bool NumberConversion::formatUInt64(uint64_t value, Span<char> buffer, StringSpan& text)
+{
+    return Internal::formatUnsigned(value, false, buffer, text);
+}
+
+inline bool NumberConversion::formatFixed(double value, uint32_t precision, Span<char> buffer, StringSpan& text)
+{
+    uint64_t bits = 0;
+    CompilerBuiltins::copy(reinterpret_cast<char*>(&bits), reinterpret_cast<const char*>(&value), sizeof(bits));
+    const bool     negative       = (bits >> 63) != 0;
+    const uint32_t biasedExponent = static_cast<uint32_t>((bits >> 52) & 0x7FF);
+    uint64_t       significand    = bits & ((uint64_t(1) << 52) - 1);
+    if (biasedExponent == 0x7FF or buffer.sizeInBytes() < 23 + static_cast<size_t>(precision))
+    {
+        return false; // nan or infinity
+    }
+    int exponent = -1074; // value == significand * 2^exponent
+    if (biasedExponent != 0)
+    {
+        significand |= uint64_t(1) << 52;
+        exponent = static_cast<int>(biasedExponent) - 1075;
+    }
+    while (significand != 0 and exponent < 0 and (significand & 1) == 0)
+    {
+        significand >>= 1; // Drop trailing zero bits to lower the number of fractional bits
+        exponent++;
+    }
+
+    // Split value in integer part and a fraction with fractionBits binary digits
+    uint64_t integer      = 0;
+    uint64_t fraction     = 0;
+    uint32_t fractionBits = 0;
+    if (significand == 0)
+    {
+    }
+    else if (exponent >= 0)
+    {
+        if (exponent > 11)
+            return false; // would not fit 64 bits
+        integer = significand << exponent;
+    }
+    else if (-exponent <= 60)
+    {
+        fractionBits = static_cast<uint32_t>(-exponent);
+        integer      = significand >> fractionBits;
+        fraction     = significand & ((uint64_t(1) << fractionBits) - 1);
+    }
+    else
+    {
+        // value < 2^(53 + exponent) rounds to zero if smaller than half of the last printed digit.
+        // The (precision + 1) * 3.33 bound conservatively overestimates log2(2 * 10^precision).
+        if (53 - (-exponent) > -static_cast<int>((precision + 1) * 333 / 100 + 1))
+            return false;
+    }
+
+    char* const start = buffer.data();
+    char*       it    = start;
+    if (negative)
+    {
+        *it++ = '-';
+    }
+    StringSpan integerText;
+    (void)Internal::formatUnsigned(integer, false, {it, 21}, integerText);
+    it += integerText.sizeInBytes();
+    char* const lastIntegerDigit = it - 1;
+    if (precision > 0)
+    {
+        *it++ = '.';
+    }
+    const uint64_t mask = fractionBits > 0 ? (uint64_t(1) << fractionBits) - 1 : 0;
+    for (uint32_t idx = 0; idx < precision; ++idx)
+    {
+        fraction *= 10; // fraction < 2^60, so this never overflows
+        *it++ = static_cast<char>('0' + (fraction >> fractionBits));
+        fraction &= mask;
+    }
+
+    // Round half to even on the remaining fraction, propagating carry towards the integer part
+    const uint64_t half      = fractionBits > 0 ? uint64_t(1) << (fractionBits - 1) : 1;
+    const char     lastDigit = precision > 0 ? it[-1] : *lastIntegerDigit;
+    if (fractionBits > 0 and (fraction > half or (fraction == half and (lastDigit - '0') % 2 == 1)))
+    {
+        char* digit = it - 1;
+        while (true)
+        {
+            if (*digit == '.')
+            {
+                digit--;
+            }
+            if (*digit != '9')
+            {
+                (*digit)++;
+                break;
+            }
+            *digit = '0';
+            if (digit == start or digit[-1] == '-')
+            {
+                // All digits were nines, so a leading one must be inserted
+                for (char* moved = it; moved > digit; --moved)
+                {
+                    *moved = moved[-1];
+                }
+                *digit = '1';
+                it++;
+                break;
+            }
+            digit--;
+        }
+    }
+    text = StringSpan({start, static_cast<size_t>(it - start)}, false, StringEncoding::Ascii);
+    return true;
+}
+
+inline bool NumberConversion::parseDouble(StringSpan text, double& value)
+{
+    if (text.getEncoding() == StringEncoding::Utf16)
+    {
+        return false;
+    }
+    const char*       it = text.bytesWithoutTerminator();
+    Internal::Decimal decimal;
+    if (not Internal::parseDecimal(it, it + text.sizeInBytes(), decimal))
+    {
+        return false;
+    }
+    if (decimal.significand == 0 and not decimal.truncated)
+    {
+        value = decimal.negative ? -0.0 : 0.0;
+        return true;
+    }
+    // Both significand and power of ten are exact doubles, so a single (correctly rounded) operation is exact
+    constexpr double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (not decimal.truncated and decimal.significand <= (uint64_t(1) << 53) and decimal.exponent >= -22 and
+        decimal.exponent <= 22)
+    {
+        const double significand = static_cast<double>(decimal.significand);
+        const size_t exponent    = static_cast<size_t>(decimal.exponent < 0 ? -decimal.exponent : decimal.exponent);
+
+        value = decimal.exponent < 0 ? significand / powers[exponent] : significand * powers[exponent];
+        value = decimal.negative ? -value : value;
+        return true;
+    }
+    return Internal::parseFallback(it, text.sizeInBytes(), decimal, false, value);
+}
+
+inline bool NumberConversion::parseFloat(StringSpan text, float& value)
+{
+    if (text.getEncoding() == StringEncoding::Utf16)
+    {
+        return false;
+    }
+    const char*       it = text.bytesWithoutTerminator();
+    Internal::Decimal decimal;
+    if (not Internal::parseDecimal(it, it + text.sizeInBytes(), decimal))
+    {
+        return false;
+    }
+    if (decimal.significand == 0 and not decimal.truncated)
+    {
+        value = decimal.negative ? -0.0f : 0.0f;
+        return true;
+    }
+    constexpr float powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    if (not decimal.truncated and decimal.significand <= (uint64_t(1) << 24) and decimal.exponent >= -10 and
+        decimal.exponent <= 10)
+    {
+        const float significand = static_cast<float>(decimal.significand);
+        const size_t exponent    = static_cast<size_t>(decimal.exponent < 0 ? -decimal.exponent : decimal.exponent);
+
+        value = decimal.exponent < 0 ? significand / powers[exponent] : significand * powers[exponent];
+        value = decimal.negative ? -value : value;
+        return true;
+    }
+    double parsed = 0;
+    if (not Internal::parseFallback(it, text.sizeInBytes(), decimal, true, parsed))
+    {
+        return false;
+    }
+    value = static_cast<float>(parsed);
+    return true;
+}
@@ -283,6 +283,14 @@ struct SC_FOUNDATION_EXPORT StringSpan
         const char* end = it + sizeInBytes();
         while (it < end)
         {
+            // Widen runs of ASCII (the common case for paths) without going through the full decoder
+            if (static_cast<uint8_t>(*it) < 0x80)
+            {
+                if (numWritten + 1 >= capacity)
+                    return false;
+                buffer[numWritten++] = static_cast<wchar_t>(*it++);
+                continue;
+            }
             uint32_t codePoint = 0;
             if (not decodeUTF8(it, end, codePoint))
                 return false;
@@ -17,6 +17,7 @@ Result HttpAsyncClient::init(HttpConnectionBase& storage)
     connection->readableSocketStream.setAutoDestroy(false);
     connection->writableSocketStream.setAutoDestroy(false);
     connectAsync.callback.bind<HttpAsyncClient, &HttpAsyncClient::onConnected>(*this);
+    connectFallback.callback.bind<HttpAsyncClient, &HttpAsyncClient::onConnectFallback>(*this);
     return Result(true);
 }
 
@@ -251,20 +252,72 @@ Result HttpAsyncClient::ensureConnected()
 
 Result HttpAsyncClient::beginSocketConnection()
 {
+    if (dnsResolver != nullptr)
+    {
+        dnsQuery->callback.bind<HttpAsyncClient, &HttpAsyncClient::onResolved>(*this);
+        SC_TRY(dnsQuery->start(*dnsResolver, currentURL.hostname, currentURL.port));
+        state = State::Connecting;
+        return Result(true);
+    }
     char       addressBuffer[256];
     Span<char> ipAddress = {addressBuffer};
     SC_TRY(SocketDNS::resolveDNS(currentURL.hostname, ipAddress));
 
     SocketIPAddress remoteAddress;
     SC_TRY(remoteAddress.fromAddressPort({ipAddress, true, StringEncoding::Ascii}, currentURL.port));
-    SC_TRY(eventLoop->createAsyncTCPSocket(remoteAddress.getAddressFamily(), connection->socket));
+    SC_TRY(eventLoop->createAsyncTCPSocket(remoteAddress.getAddressFamily(), connection->socket, socketOptions));
 
     state = State::Connecting;
     return connectAsync.start(*eventLoop, connection->socket, remoteAddress);
 }
 
+void HttpAsyncClient::onResolved(AsyncDNSQuery::Result& result)
+{
+    if (not result.returnCode)
+    {
+        fail(result.returnCode);
+        return;
+    }
+    dnsAddress = 0;
+
+    Result connectResult = connectToResolvedAddress();
+    if (not connectResult)
+    {
+        fail(connectResult);
+    }
+}
+
+Result HttpAsyncClient::connectToResolvedAddress()
+{
+    const SocketIPAddress& remoteAddress = dnsQuery->getAddresses()[dnsAddress];
+    SC_TRY(eventLoop->createAsyncTCPSocket(remoteAddress.getAddressFamily(), connection->socket, socketOptions));
+    return connectAsync.start(*eventLoop, connection->socket, remoteAddress);
+}
+
+void HttpAsyncClient::onConnectFallback(AsyncLoopTimeout::Result&)
+{
+    Result connectResult = connectToResolvedAddress();
+    if (not connectResult)
+    {
+        fail(connectResult);
+    }
+}
+
 void HttpAsyncClient::onConnected(AsyncSocketConnect::Result& result)
 {
+    if (not result.isValid() and dnsResolver != nullptr and dnsAddress + 1 < dnsQuery->getAddresses().sizeInElements())
+    {
+        // Fallback to next resolved address (usually of the other address family) on next loop iteration, as the
+        // failed connect request cannot be restarted from inside its own callback
+        (void)connection->socket.close();
+        dnsAddress++;
+        Result fallbackResult = connectFallback.start(*eventLoop, TimeMs{0});
+        if (not fallbackResult)
+        {
+            fail(fallbackResult);
+        }
+        return;
+    }
     if (not result.isValid())
     {
         fail(result.isValid());
@@ -914,6 +967,14 @@ void HttpAsyncClient::closeConnection()
     {
         return;
     }
+    if (dnsQuery != nullptr)
+    {
+        (void)dnsQuery->stop();
+    }
+    if (not connectFallback.isFree() and not connectFallback.isCancelling())
+    {
+        (void)connectFallback.stop(*eventLoop);
+    }
     (void)connection->getReadableTransportStream()
         .eventData.removeListener<HttpAsyncClient, &HttpAsyncClient::onResponseData>(*this);
     (void)connection->getReadableTransportStream()
@@ -1,6 +1,7 @@
 // Copyright (c) Stefano Cristiano
 // SPDX-License-Identifier: MIT
 #pragma once
+#include "../Async/AsyncDNS.h"
 #include "HttpConnection.h"
 #include "HttpExport.h"
 #include "HttpURLParser.h"
@@ -192,6 +193,31 @@ struct SC_HTTP_EXPORT HttpAsyncClient
         transportClose = {};
     }
 
+    /// @brief Resolves host names with a non-blocking resolver instead of the blocking `SocketDNS::resolveDNS`.
+    ///
+    /// When a host resolves to multiple addresses they're tried in order (IPv6 / IPv4 interleaved by the resolver),
+    /// moving to the next one as soon as a connection attempt fails.
+    /// @param resolver An initialized resolver, that can be shared by multiple clients
+    /// @param query Storage for the resolution of this client, that must outlive the client
+    void setDNSResolver(AsyncDNSResolver& resolver, AsyncDNSQuery& query)
+    {
+        dnsResolver = &resolver;
+        dnsQuery    = &query;
+    }
+
+    /// @brief Restores blocking `SocketDNS::resolveDNS` host name resolution
+    void clearDNSResolver()
+    {
+        dnsResolver = nullptr;
+        dnsQuery    = nullptr;
+    }
+
+    /// @brief Sets options applied to sockets created for new connections (before connecting)
+    void setSocketOptions(const SocketOptions& options) { socketOptions = options; }
+
+    /// @brief Gets options applied to sockets created for new connections
+    [[nodiscard]] const SocketOptions& getSocketOptions() const { return socketOptions; }
+
     /// @brief Hands the connected socket streams to a WebSocket owner after a validated `101` response.
     Result detachWebSocketTransport(HttpWebSocketTransportView& transport);
 
@@ -253,6 +279,8 @@ struct SC_HTTP_EXPORT HttpAsyncClient
     Function<void(Result)> onError;
 
   private:
+    friend struct HttpAsyncClientPool;
+
     struct RequestPreset
     {
         enum class BodyMode : uint8_t
@@ -295,6 +323,7 @@ struct SC_HTTP_EXPORT HttpAsyncClient
     Result startPreparedRequest(const RequestPreset& preset);
     Result ensureConnected();
     Result beginSocketConnection();
+    Result connectToResolvedAddress();
     Result beginResponseRead();
     Result beginRequestSend();
     Result onResponseBodyStreamRead();
@@ -308,6 +337,8 @@ struct SC_HTTP_EXPORT HttpAsyncClient
     void finishResponse();
     void fail(Result error);
 
+    void onResolved(AsyncDNSQuery::Result& result);
+    void onConnectFallback(AsyncLoopTimeout::Result& result);
     void onConnected(AsyncSocketConnect::Result& result);
     void onReadableError(Result result);
     void onWritableError(Result result);
@@ -344,6 +375,13 @@ struct SC_HTTP_EXPORT HttpAsyncClient
     Function<Result(HttpAsyncClientTransportSetup&)> transportSetup;
     Function<void()>                                 transportClose;
 
+    AsyncDNSResolver* dnsResolver = nullptr;
+    AsyncDNSQuery*    dnsQuery    = nullptr;
+    size_t            dnsAddress  = 0; // Index of the resolved address currently being connected
+    AsyncLoopTimeout  connectFallback;  // Connects to next resolved address outside of failed connect callback
+
+    SocketOptions socketOptions;
+
     State state = State::Idle;
 
     StringSpan currentProtocol;
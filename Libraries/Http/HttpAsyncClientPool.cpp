@@ -0,0 +1,397 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "HttpAsyncClientPool.h"
+
+namespace SC
+{
+struct HttpAsyncClientPool::Internal
+{
+    static bool sameOrigin(const HttpURLParser& first, const HttpURLParser& second)
+    {
+        return first.port == second.port and first.protocol == second.protocol and first.host == second.host;
+    }
+
+    static bool isConnectedTo(const Slot& slot, const HttpURLParser& origin)
+    {
+        return slot.client.canReuseConnectionFor(origin.protocol, origin.host, origin.port);
+    }
+
+    static bool hasOpenConnection(const Slot& slot) { return slot.client.hasOpenConnection; }
+
+    static void closeConnection(Slot& slot)
+    {
+        (void)slot.client.close();
+        slot.connectionRequests = 0;
+    }
+
+    static bool isExpired(const HttpAsyncClientPool& pool, const Slot& slot, TimeMs now)
+    {
+        const int64_t timeout = pool.options.idleTimeout.milliseconds;
+        return timeout > 0 and now.milliseconds - slot.idleSince.milliseconds >= timeout;
+    }
+
+    // Checks that the peer has not closed the idle connection nor sent unsolicited data on it (like a 408 response).
+    // Pending data is tolerated on custom transports (TLS) where it may belong to the transport itself.
+    static bool isHealthy(const Slot& slot)
+    {
+        bool peerClosed     = false;
+        bool hasPendingData = false;
+        if (not SocketClient(slot.client.connection->socket).probeConnection(peerClosed, hasPendingData))
+        {
+            return false;
+        }
+        return not peerClosed and (not hasPendingData or slot.client.transportSetup.isValid());
+    }
+
+    static uint32_t countConnectionsTo(const HttpAsyncClientPool& pool, const HttpURLParser& origin)
+    {
+        uint32_t count = 0;
+        for (const Slot& slot : pool.slots)
+        {
+            if (slot.acquired ? sameOrigin(slot.origin, origin) : isConnectedTo(slot, origin))
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Finds a slot for the given origin, reusing an healthy idle connection to the same origin if possible
+    static Slot* tryAcquire(HttpAsyncClientPool& pool, const HttpURLParser& origin)
+    {
+        const TimeMs now = pool.eventLoop->getLoopTime();
+
+        Slot* selected = nullptr;
+        for (Slot& slot : pool.slots)
+        {
+            if (slot.acquired or not isConnectedTo(slot, origin))
+            {
+                continue;
+            }
+            if (isExpired(pool, slot, now))
+            {
+                closeConnection(slot);
+                pool.statistics.numEvicted++;
+            }
+            else if (not isHealthy(slot))
+            {
+                closeConnection(slot);
+                pool.statistics.numHealthFailed++;
+            }
+            else
+            {
+                selected = &slot;
+                pool.statistics.numReused++;
+                break;
+            }
+        }
+
+        if (selected == nullptr)
+        {
+            if (countConnectionsTo(pool, origin) >= pool.options.maxConnectionsPerHost)
+            {
+                return nullptr;
+            }
+            // Prefer a slot without connection, falling back to closing the least recently used idle one
+            Slot* leastRecentlyUsed = nullptr;
+            for (Slot& slot : pool.slots)
+            {
+                if (slot.acquired)
+                {
+                    continue;
+                }
+                if (not hasOpenConnection(slot))
+                {
+                    selected = &slot;
+                    break;
+                }
+                if (leastRecentlyUsed == nullptr or
+                    slot.idleSince.milliseconds < leastRecentlyUsed->idleSince.milliseconds)
+                {
+                    leastRecentlyUsed = &slot;
+                }
+            }
+            if (selected == nullptr and leastRecentlyUsed != nullptr)
+            {
+                selected = leastRecentlyUsed;
+                pool.statistics.numEvicted++;
+            }
+            if (selected == nullptr)
+            {
+                return nullptr;
+            }
+            closeConnection(*selected);
+            pool.statistics.numNew++;
+        }
+        selected->acquired = true;
+        selected->origin   = origin;
+        return selected;
+    }
+
+    static Waiter* findNextWaiter(HttpAsyncClientPool& pool, uint64_t afterSequence)
+    {
+        Waiter* next = nullptr;
+        for (Waiter& waiter : pool.waiters)
+        {
+            if (waiter.queued and waiter.sequence > afterSequence and
+                (next == nullptr or waiter.sequence < next->sequence))
+            {
+                next = &waiter;
+            }
+        }
+        return next;
+    }
+
+    // Dispatches queued acquisitions in FIFO order, skipping the ones whose origin is still saturated
+    static void dispatchWaiters(HttpAsyncClientPool& pool)
+    {
+        uint64_t lastSequence = 0;
+        for (Waiter* waiter = findNextWaiter(pool, 0); waiter != nullptr; waiter = findNextWaiter(pool, lastSequence))
+        {
+            lastSequence = waiter->sequence;
+
+            HttpURLParser origin;
+            (void)origin.parse(waiter->url); // Already validated by acquire
+            Slot* slot = tryAcquire(pool, origin);
+            if (slot != nullptr)
+            {
+                AcquireCallback callback = move(waiter->callback);
+                waiter->callback         = {};
+                waiter->queued           = false;
+                callback(slot->client);
+                if (pool.eventLoop == nullptr)
+                {
+                    return; // Pool has been closed by the callback
+                }
+            }
+        }
+    }
+
+    static bool hasQueuedWaiters(const HttpAsyncClientPool& pool)
+    {
+        for (const Waiter& waiter : pool.waiters)
+        {
+            if (waiter.queued)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void scheduleDispatch(HttpAsyncClientPool& pool)
+    {
+        if (pool.dispatchTimer.isFree() and hasQueuedWaiters(pool))
+        {
+            (void)pool.dispatchTimer.start(*pool.eventLoop, TimeMs{0});
+        }
+    }
+
+    static void scheduleEviction(HttpAsyncClientPool& pool)
+    {
+        if (pool.options.idleTimeout.milliseconds <= 0 or not pool.evictionTimer.isFree())
+        {
+            return;
+        }
+        const Slot* oldest = nullptr;
+        for (const Slot& slot : pool.slots)
+        {
+            if (not slot.acquired and hasOpenConnection(slot) and
+                (oldest == nullptr or slot.idleSince.milliseconds < oldest->idleSince.milliseconds))
+            {
+                oldest = &slot;
+            }
+        }
+        if (oldest == nullptr)
+        {
+            return;
+        }
+        const int64_t elapsed = pool.eventLoop->getLoopTime().milliseconds - oldest->idleSince.milliseconds;
+        const int64_t timeout = pool.options.idleTimeout.milliseconds;
+        if (pool.evictionTimer.start(*pool.eventLoop, TimeMs{elapsed < timeout ? timeout - elapsed : 0}))
+        {
+            // Idle connections must not prevent the event loop from exiting
+            pool.eventLoop->excludeFromActiveCount(pool.evictionTimer);
+        }
+    }
+
+    static Result stopTimer(HttpAsyncClientPool& pool, AsyncLoopTimeout& timer)
+    {
+        if (not timer.isFree() and not timer.isCancelling())
+        {
+            SC_TRY(timer.stop(*pool.eventLoop));
+        }
+        return Result(true);
+    }
+};
+
+Result HttpAsyncClientPool::initInternal(AsyncEventLoop& loop, Span<Slot> newSlots,
+                                         SpanWithStride<HttpConnectionBase> connections, Span<Waiter> newWaiters,
+                                         Options newOptions)
+{
+    SC_TRY_MSG(eventLoop == nullptr, "HttpAsyncClientPool::init - already initialized");
+    SC_TRY_MSG(not newSlots.empty(), "HttpAsyncClientPool::init - no slots");
+    SC_TRY_MSG(newSlots.sizeInElements() == connections.sizeInElements(),
+               "HttpAsyncClientPool::init - slots and connections must have the same size");
+    SC_TRY_MSG(newOptions.maxConnectionsPerHost > 0, "HttpAsyncClientPool::init - maxConnectionsPerHost is zero");
+    for (size_t idx = 0; idx < newSlots.sizeInElements(); ++idx)
+    {
+        Slot& slot = newSlots[idx];
+        SC_TRY(slot.client.init(connections[idx]));
+        slot.acquired           = false;
+        slot.connectionRequests = 0;
+    }
+    for (Waiter& waiter : newWaiters)
+    {
+        waiter = {};
+    }
+    eventLoop          = &loop;
+    slots              = newSlots;
+    waiters            = newWaiters;
+    options            = newOptions;
+    statistics         = {};
+    nextWaiterSequence = 0;
+
+    dispatchTimer.callback = [this](AsyncLoopTimeout::Result&) { Internal::dispatchWaiters(*this); };
+    evictionTimer.callback = [this](AsyncLoopTimeout::Result&)
+    {
+        evictIdleConnections();
+        Internal::scheduleEviction(*this);
+    };
+    return Result(true);
+}
+
+Result HttpAsyncClientPool::close()
+{
+    if (eventLoop == nullptr)
+    {
+        return Result(true);
+    }
+    SC_TRY(Internal::stopTimer(*this, dispatchTimer));
+    SC_TRY(Internal::stopTimer(*this, evictionTimer));
+    for (Slot& slot : slots)
+    {
+        Internal::closeConnection(slot);
+        slot.acquired = false;
+    }
+    for (Waiter& waiter : waiters)
+    {
+        waiter = {};
+    }
+    slots     = {};
+    waiters   = {};
+    eventLoop = nullptr;
+    return Result(true);
+}
+
+Result HttpAsyncClientPool::acquire(StringSpan url, AcquireCallback&& callback)
+{
+    SC_TRY_MSG(eventLoop != nullptr, "HttpAsyncClientPool::acquire - init not called");
+    SC_TRY_MSG(callback.isValid(), "HttpAsyncClientPool::acquire - invalid callback");
+    HttpURLParser origin;
+    SC_TRY(origin.parse(url));
+
+    // Queued acquisitions go first, to preserve FIFO order across callers
+    Slot* slot = Internal::hasQueuedWaiters(*this) ? nullptr : Internal::tryAcquire(*this, origin);
+    if (slot != nullptr)
+    {
+        callback(slot->client);
+        return Result(true);
+    }
+    for (Waiter& waiter : waiters)
+    {
+        if (not waiter.queued)
+        {
+            waiter.url      = url;
+            waiter.callback = move(callback);
+            waiter.sequence = ++nextWaiterSequence;
+            waiter.queued   = true;
+            Internal::scheduleDispatch(*this); // Needed if queued only to preserve order
+            return Result(true);
+        }
+    }
+    return Result::Error("HttpAsyncClientPool::acquire - no connection available");
+}
+
+Result HttpAsyncClientPool::release(HttpAsyncClient& client)
+{
+    SC_TRY_MSG(eventLoop != nullptr, "HttpAsyncClientPool::release - init not called");
+    Slot* slot = nullptr;
+    for (Slot& it : slots)
+    {
+        if (&it.client == &client)
+        {
+            slot = &it;
+            break;
+        }
+    }
+    SC_TRY_MSG(slot != nullptr and slot->acquired, "HttpAsyncClientPool::release - client has not been acquired");
+
+    if (client.state != HttpAsyncClient::State::Idle and client.response.isBodyComplete() and
+        not client.responseFinalized)
+    {
+        client.finalizeResponse(false); // Released from the end event of the response body
+    }
+    if (client.state != HttpAsyncClient::State::Idle or client.webSocketUpgraded)
+    {
+        Internal::closeConnection(*slot); // Request still in progress or connection not usable for HTTP anymore
+    }
+    if (Internal::hasOpenConnection(*slot))
+    {
+        slot->connectionRequests++;
+        if (options.maxRequestsPerConnection > 0 and slot->connectionRequests >= options.maxRequestsPerConnection)
+        {
+            Internal::closeConnection(*slot);
+            statistics.numEvicted++;
+        }
+    }
+    slot->acquired  = false;
+    slot->origin    = {};
+    slot->idleSince = eventLoop->getLoopTime();
+
+    Internal::scheduleEviction(*this);
+    Internal::scheduleDispatch(*this);
+    return Result(true);
+}
+
+void HttpAsyncClientPool::evictIdleConnections()
+{
+    if (eventLoop == nullptr)
+    {
+        return;
+    }
+    const TimeMs now = eventLoop->getLoopTime();
+    for (Slot& slot : slots)
+    {
+        if (not slot.acquired and Internal::hasOpenConnection(slot) and Internal::isExpired(*this, slot, now))
+        {
+            Internal::closeConnection(slot);
+            statistics.numEvicted++;
+        }
+    }
+}
+
+HttpAsyncClientPool::Statistics HttpAsyncClientPool::getStatistics() const
+{
+    Statistics stats = statistics;
+    for (const Slot& slot : slots)
+    {
+        if (slot.acquired)
+        {
+            stats.numBusy++;
+        }
+        else if (Internal::hasOpenConnection(slot))
+        {
+            stats.numIdle++;
+        }
+    }
+    for (const Waiter& waiter : waiters)
+    {
+        if (waiter.queued)
+        {
+            stats.numQueued++;
+        }
+    }
+    return stats;
+}
+} // namespace SC
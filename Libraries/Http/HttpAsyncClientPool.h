@@ -0,0 +1,131 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "HttpAsyncClient.h"
+
+namespace SC
+{
+//! @addtogroup group_http
+//! @{
+
+/// @brief Keep-alive pool of SC::HttpAsyncClient connections, keyed by origin (protocol, host and port)
+///
+/// Every slot holds an `HttpAsyncClient` using one of the caller-provided connection storages.
+/// `acquire` prefers an idle slot already connected to the requested origin, checking that the connection is still
+/// usable (not closed by the peer, not expired and below `maxRequestsPerConnection`), so that most requests skip the
+/// TCP (and TLS) handshake. Otherwise it assigns a free slot, closing the least recently used idle connection if
+/// needed, while never exceeding `maxConnectionsPerHost` connections to the same origin.
+///
+/// When all connections for an origin are busy, acquisitions are queued in the caller-provided waiters (if any) and
+/// dispatched in FIFO order as soon as a connection to that origin is released, so that queued requests are sent
+/// back-to-back on already warm connections. HTTP/1.1 pipelining of multiple in-flight requests on the same connection
+/// is not done, as `HttpAsyncClient` processes one request at a time.
+///
+/// Idle connections are closed after `idleTimeout`, through a timer that doesn't keep the event loop alive.
+///
+/// Example:
+/// \snippet Tests/Libraries/Http/HttpAsyncClientPoolTest.cpp HttpAsyncClientPoolSnippet
+struct SC_HTTP_EXPORT HttpAsyncClientPool
+{
+    struct Options
+    {
+        uint32_t maxConnectionsPerHost    = 6;             ///< Max connections (busy or idle) to the same origin
+        uint32_t maxRequestsPerConnection = 0;             ///< Close connection after this many requests (0 = no limit)
+        TimeMs   idleTimeout              = TimeMs{30000}; ///< Close connections idle for longer than this
+    };
+
+    struct Statistics
+    {
+        size_t numBusy   = 0; ///< Slots currently acquired
+        size_t numIdle   = 0; ///< Slots not acquired holding an open connection
+        size_t numQueued = 0; ///< Acquisitions waiting for a connection
+
+        uint64_t numReused       = 0; ///< Acquisitions that have reused an idle connection
+        uint64_t numNew          = 0; ///< Acquisitions that need a new connection
+        uint64_t numEvicted      = 0; ///< Idle connections closed for timeout, LRU replacement or request limit
+        uint64_t numHealthFailed = 0; ///< Idle connections found closed or unusable when trying to reuse them
+    };
+
+    using AcquireCallback = Function<void(HttpAsyncClient&)>;
+
+    /// @brief A pool slot holding a client and its bookkeeping
+    struct Slot
+    {
+        HttpAsyncClient client;
+
+      private:
+        friend struct HttpAsyncClientPool;
+        HttpURLParser origin; // Origin of current acquisition (valid only while acquired)
+
+        TimeMs   idleSince;
+        uint32_t connectionRequests = 0; // Requests completed on current connection
+        bool     acquired           = false;
+    };
+
+    /// @brief Caller-provided storage for an acquisition waiting for a connection
+    struct Waiter
+    {
+      private:
+        friend struct HttpAsyncClientPool;
+        StringSpan      url;
+        AcquireCallback callback;
+        uint64_t        sequence = 0;
+        bool            queued   = false;
+    };
+
+    /// @brief Initializes the pool with caller-provided slots and connection storages
+    /// @param loop The event loop used by all clients
+    /// @param slots Client slots, that must be as many as connections
+    /// @param connections Connection storages (buffers, queues and sockets), one for each slot
+    /// @param waiters Storage for queued acquisitions (can be empty to fail acquisitions when the pool is saturated)
+    /// @param options Pool options
+    template <typename T>
+    Result init(AsyncEventLoop& loop, Span<Slot> slots, Span<T> connections, Span<Waiter> waiters = {},
+                Options options = {})
+    {
+        HttpConnectionBase* data = connections.data(); // T must derive from HttpConnectionBase
+        return initInternal(loop, slots, {data, connections.sizeInElements(), sizeof(T)}, waiters, options);
+    }
+
+    /// @brief Closes all connections, drops queued acquisitions and releases references to the storage passed to init
+    Result close();
+
+    /// @brief Acquires a client for the origin of the given url.
+    /// The callback is invoked synchronously if a client is available, or later when the acquisition is dequeued.
+    /// The acquired client is exclusively owned by the caller until it's passed to HttpAsyncClientPool::release.
+    /// @note Send requests with keep-alive enabled, otherwise connections will not be reused.
+    /// @warning The url must remain valid until the callback has been invoked and the client has been released.
+    /// @return Invalid Result if the url is not valid or if the pool is saturated and no waiter is available
+    Result acquire(StringSpan url, AcquireCallback&& callback);
+
+    /// @brief Returns an acquired client to the pool, once its response has been fully received (or it has failed).
+    /// The connection is kept idle for reuse if it's still open, and queued acquisitions are dispatched.
+    Result release(HttpAsyncClient& client);
+
+    /// @brief Closes all idle connections that have exceeded Options::idleTimeout
+    void evictIdleConnections();
+
+    /// @brief Returns current occupancy and counters
+    [[nodiscard]] Statistics getStatistics() const;
+
+  private:
+    Result initInternal(AsyncEventLoop& loop, Span<Slot> slots, SpanWithStride<HttpConnectionBase> connections,
+                        Span<Waiter> waiters, Options options);
+
+    struct Internal;
+
+    AsyncEventLoop* eventLoop = nullptr;
+
+    Span<Slot>   slots;
+    Span<Waiter> waiters;
+    Options      options;
+    Statistics   statistics;
+
+    AsyncLoopTimeout dispatchTimer; // Dispatches waiters outside of release callers stack
+    AsyncLoopTimeout evictionTimer; // Closes expired idle connections (excluded from loop active count)
+
+    uint64_t nextWaiterSequence = 0;
+};
+
+//! @}
+} // namespace SC
@@ -6,12 +6,7 @@
 #include "Internal/HttpStringIterator.h"
 
 #include <stdio.h>
-#include <time.h>
-#if SC_PLATFORM_WINDOWS
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <sys/timeb.h>
-#endif
+#include <string.h> // memcpy
 
 namespace SC
 {
@@ -24,7 +19,6 @@ struct HttpAsyncFileServer::Internal
         bool   partial = false;
     };
 
-    static Result writeGMTHeaderTime(StringSpan headerName, HttpResponse& response, int64_t millisecondsSinceEpoch);
     static Result readFile(StringSpan initialDirectory, size_t index, StringSpan url, HttpResponse& response);
     static Result formatHttpDate(int64_t millisecondsSinceEpoch, char* buffer, size_t bufferSize, size_t& outLength);
     static Result formatWeakETag(const FileSystem::FileStat& fileStat, char* buffer, size_t bufferSize,
@@ -36,17 +30,197 @@ struct HttpAsyncFileServer::Internal
     static Result normalizeOptionFilePath(StringSpan filePath, StringSpan& normalizedPath);
     static Result validateSafeRelativePath(StringSpan filePath);
     static bool   parseDecimalSize(StringSpan text, size_t& value);
-    static bool   parseSingleByteRange(StringSpan header, size_t fileSize, ByteRange& range);
+    static bool   parseByteRangeSpec(StringSpan spec, size_t fileSize, ByteRange& range, bool& satisfiable);
+    static bool   parseByteRanges(StringSpan header, size_t fileSize, Span<ByteRange> ranges, size_t& numRanges);
+    static Result formatByteRanges(Stream::ByteRanges& byteRanges, StringSpan boundary, StringSpan contentType,
+                                   size_t fileSize, size_t& contentLength);
+    static void   sendNextByteRange(Stream& stream);
+    static void   sendByteRangeData(Stream& stream);
+    static void   finishByteRanges(Stream& stream);
     static bool   etagMatchesIfNoneMatch(StringSpan ifNoneMatch, StringSpan etag);
     static bool   ifRangeMatches(StringSpan ifRange, StringSpan etag, StringSpan lastModified);
     static Result sendEmptyResponse(HttpResponse& response, int statusCode);
-    static Result sendNotModified(HttpResponse& response, StringSpan lastModified, StringSpan etag);
-    static Result sendRangeNotSatisfiable(HttpResponse& response, size_t fileSize);
+    static Result sendNotModified(HttpResponse& response, const HttpDateHeader& dateHeader, StringSpan lastModified,
+                                  StringSpan etag);
+    static Result sendRangeNotSatisfiable(HttpResponse& response, const HttpDateHeader& dateHeader, size_t fileSize);
+    static bool   acceptsGZip(StringSpan acceptEncoding);
+    static bool   isCompressible(StringSpan contentType);
+    static bool   findGZipSibling(StringSpan directory, StringSpan filePath, const FileSystem::FileStat& fileStat,
+                                  StringPath& gzipPath, FileSystem::FileStat& gzipStat);
+    static Result formatGZipETag(StringSpan etag, char* buffer, size_t bufferSize, size_t& outLength);
+    static Result prepareCompressor(Stream& stream, HttpConnection& connection, ThreadPool& threadPool,
+                                    AsyncEventLoop& loop);
+
+    using CacheEntry = HttpAsyncFileServerCache::Entry;
+
+    static Result lookupCache(HttpAsyncFileServerCache& cache, StringSpan directory, StringSpan filePath, int64_t now,
+                              CacheEntry*& entry, CacheEntry*& filling);
+    static Result fillCache(Stream& stream, HttpAsyncFileServerCache& cache, const HttpAsyncFileServerOptions& options,
+                            StringSpan directory, StringSpan filePath, const FileSystem::FileStat& fileStat,
+                            StringSpan contentType, int64_t now, ThreadPool& threadPool, AsyncEventLoop& loop,
+                            CacheEntry*& entry);
+    static Result readCacheFill(Stream::CacheFill& fill);
+    static void   finishCacheFill(Stream::CacheFill& fill, AsyncLoopWork::Result& result);
+    static Result readWholeFile(StringSpan path, Span<char> destination);
+    static Result pinCacheEntry(Stream& stream, HttpConnection& connection, CacheEntry& entry);
+    static void   releaseCacheEntry(Stream& stream);
+    static Result sendCachedBody(Stream& stream, HttpConnection& connection, CacheEntry& entry, Span<const char> body);
+    static bool   prepareGZipStore(Stream& stream, HttpConnection& connection, HttpAsyncFileServerCache& cache,
+                                   CacheEntry& entry);
+    static void   storeGZip(Stream& stream);
 
-    static int64_t    getCurrentTimeMilliseconds();
     static StringSpan getContentType(const HttpAsyncFileServerOptions& options, const StringSpan extension);
 };
 
+//-------------------------------------------------------------------------------------------------------
+// HttpAsyncFileServerCache
+//-------------------------------------------------------------------------------------------------------
+Result HttpAsyncFileServerCache::init(Span<Entry> newEntries, Span<char> newMemory)
+{
+    SC_TRY_MSG(entries.empty(), "HttpAsyncFileServerCache::init - already inited");
+    SC_TRY_MSG(not newEntries.empty(), "HttpAsyncFileServerCache::init - empty entries");
+    SC_TRY_MSG(newMemory.sizeInBytes() >= newEntries.sizeInElements(), "HttpAsyncFileServerCache::init - no memory");
+    entries  = newEntries;
+    memory   = newMemory;
+    slotSize = memory.sizeInBytes() / entries.sizeInElements();
+    for (Entry& entry : entries)
+    {
+        entry = Entry();
+    }
+    useCounter = 0;
+    statistics = {};
+    return Result(true);
+}
+
+Result HttpAsyncFileServerCache::close()
+{
+    for (const Entry& entry : entries)
+    {
+        SC_TRY_MSG(entry.pins == 0, "HttpAsyncFileServerCache::close - entries are still being sent");
+    }
+    entries  = {};
+    memory   = {};
+    slotSize = 0;
+    return Result(true);
+}
+
+void HttpAsyncFileServerCache::invalidate(StringSpan filePath)
+{
+    if (filePath.sizeInBytes() > 0 and filePath.bytesWithoutTerminator()[0] == '/')
+    {
+        filePath = {{filePath.bytesWithoutTerminator() + 1, filePath.sizeInBytes() - 1}, false, filePath.getEncoding()};
+    }
+    Entry* entry = find(filePath);
+    if (entry != nullptr)
+    {
+        drop(*entry);
+        statistics.invalidations++;
+    }
+    // The uncompressed entry holds the .gz sibling too
+    if (HttpStringIterator::endsWith(filePath, ".gz"))
+    {
+        invalidate({{filePath.bytesWithoutTerminator(), filePath.sizeInBytes() - 3}, false, filePath.getEncoding()});
+    }
+}
+
+void HttpAsyncFileServerCache::invalidateAll()
+{
+    for (Entry& entry : entries)
+    {
+        if (entry.valid or entry.filling)
+        {
+            drop(entry);
+            statistics.invalidations++;
+        }
+    }
+}
+
+uint32_t HttpAsyncFileServerCache::hashPath(StringSpan filePath)
+{
+    // FNV-1a, folding backslashes so that invalidate() accepts native separators on Windows
+    uint32_t hash = 2166136261u;
+    for (char current : filePath.toCharSpan())
+    {
+        hash ^= static_cast<uint8_t>(current == '\\' ? '/' : current);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+HttpAsyncFileServerCache::Entry* HttpAsyncFileServerCache::find(StringSpan filePath)
+{
+    const size_t length = filePath.sizeInBytes();
+    if (length == 0 or length > Entry::MaxPathLength)
+    {
+        return nullptr;
+    }
+    const uint32_t hash = hashPath(filePath);
+    const char*    data = filePath.bytesWithoutTerminator();
+    for (Entry& entry : entries)
+    {
+        if (not(entry.valid or entry.filling) or entry.pathHash != hash or entry.pathLength != length)
+        {
+            continue;
+        }
+        size_t idx = 0;
+        for (; idx < length; ++idx)
+        {
+            if ((data[idx] == '\\' ? '/' : data[idx]) != entry.path[idx])
+            {
+                break;
+            }
+        }
+        if (idx == length)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+HttpAsyncFileServerCache::Entry* HttpAsyncFileServerCache::acquire()
+{
+    Entry* victim = nullptr;
+    for (Entry& entry : entries)
+    {
+        if (entry.pins != 0)
+        {
+            continue;
+        }
+        if (not entry.valid)
+        {
+            return &entry;
+        }
+        if (victim == nullptr or entry.lastUse < victim->lastUse)
+        {
+            victim = &entry;
+        }
+    }
+    if (victim != nullptr)
+    {
+        drop(*victim);
+        statistics.evictions++;
+    }
+    return victim;
+}
+
+Span<char> HttpAsyncFileServerCache::getSlot(const Entry& entry)
+{
+    const size_t index = static_cast<size_t>(&entry - entries.data());
+    return {memory.data() + index * slotSize, slotSize};
+}
+
+void HttpAsyncFileServerCache::drop(Entry& entry)
+{
+    // A pinned entry keeps its bytes (still referenced by a socket write or by a fill) but can't be found anymore
+    entry.valid    = false;
+    entry.filling  = false;
+    entry.pathHash = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// HttpAsyncFileServer
+//-------------------------------------------------------------------------------------------------------
 Result HttpAsyncFileServer::init(ThreadPool& pool, AsyncEventLoop& loop, StringSpan directoryToServe)
 {
     SC_TRY_MSG(eventLoop == nullptr, "HttpAsyncFileServer::init - already inited")
@@ -55,11 +229,17 @@ Result HttpAsyncFileServer::init(ThreadPool& pool, AsyncEventLoop& loop, StringS
 
     SC_TRY_MSG(FileSystem().existsAndIsDirectory(directoryToServe), "HttpAsyncFileServer::init invalid directory");
     SC_TRY(directory.assign(directoryToServe));
+    // Responses append the Date line cached by the ticker, instead of formatting current time every time
+    SC_TRY(dateHeader.start(loop));
     return Result(true);
 }
 
 Result HttpAsyncFileServer::close()
 {
+    if (dateHeader.isStarted())
+    {
+        SC_TRY(dateHeader.stop());
+    }
     eventLoop  = nullptr;
     threadPool = nullptr;
     directory  = {};
@@ -74,6 +254,11 @@ Result HttpAsyncFileServer::setOptions(const HttpAsyncFileServerOptions& newOpti
     SC_TRY(Internal::normalizeOptionFilePath(newOptions.spaFallbackPath, normalizedFallback));
     (void)(normalizedFallback);
     options = newOptions;
+    if (options.cache != nullptr)
+    {
+        // Cached MIME types and validators may depend on the previous options
+        options.cache->invalidateAll();
+    }
     return Result(true);
 }
 
@@ -140,194 +325,442 @@ Result HttpAsyncFileServer::handleRequest(HttpAsyncFileServer::Stream& stream, H
 Result HttpAsyncFileServer::getFile(HttpAsyncFileServer::Stream& stream, HttpConnection& connection,
                                     StringSpan filePath, bool sendBody, bool allowSpaFallback)
 {
-    FileSystem fileSystem;
-    SC_TRY(fileSystem.init(directory.view()));
-    if (fileSystem.existsAndIsFile(filePath))
+    // A stream still holding an entry (its previous response is being sent) bypasses the cache
+    HttpAsyncFileServerCache* cache   = stream.cacheEntry == nullptr ? options.cache : nullptr;
+    Internal::CacheEntry*     entry   = nullptr;
+    Internal::CacheEntry*     filling = nullptr;
+    stream.byteRanges.numRanges       = 0;
+    if (cache != nullptr)
     {
-        FileSystem::FileStat fileStat;
+        SC_TRY(Internal::lookupCache(*cache, directory.view(), filePath, eventLoop->getLoopTime().milliseconds, entry,
+                                     filling));
+    }
+
+    FileSystem::FileStat fileStat;
+    StringSpan           extension;
+    if (entry == nullptr)
+    {
+        FileSystem fileSystem;
+        SC_TRY(fileSystem.init(directory.view()));
+        if (not fileSystem.existsAndIsFile(filePath))
+        {
+            StringSpan fallbackPath;
+            SC_TRY(Internal::normalizeOptionFilePath(options.spaFallbackPath, fallbackPath));
+            if (allowSpaFallback and not fallbackPath.isEmpty() and fallbackPath != filePath)
+            {
+                return getFile(stream, connection, fallbackPath, sendBody, false);
+            }
+            return Internal::sendEmptyResponse(connection.response, 404);
+        }
         SC_TRY(fileSystem.getFileStat(filePath, fileStat));
-        StringSpan name, extension;
+        StringSpan name;
         SC_TRY(HttpStringIterator::parseNameExtension(filePath, name, extension));
-        StringPath path;
-        SC_TRY(path.assign(directory.view()));
-        SC_TRY(path.append("/"));
-        SC_TRY(path.append(filePath));
+        if (cache != nullptr and filling == nullptr)
+        {
+            SC_TRY(Internal::fillCache(stream, *cache, options, directory.view(), filePath, fileStat,
+                                       Internal::getContentType(options, extension),
+                                       eventLoop->getLoopTime().milliseconds, *threadPool, *eventLoop, filling));
+        }
+    }
 
-        char   lastModifiedData[128];
+    char       lastModifiedData[128];
+    char       etagData[64];
+    StringSpan lastModified;
+    StringSpan etag;
+    StringSpan contentType;
+    size_t     fileSize = 0;
+    if (entry != nullptr)
+    {
+        entry->lastUse = ++cache->useCounter;
+        lastModified   = {{entry->lastModified, entry->lastModifiedLength}, false, StringEncoding::Ascii};
+        etag           = {{entry->etag, entry->etagLength}, false, StringEncoding::Ascii};
+        contentType    = entry->contentType;
+        fileSize       = entry->fileSize;
+    }
+    else
+    {
         size_t lastModifiedLength = 0;
         SC_TRY(Internal::formatHttpDate(fileStat.modifiedTime.milliseconds, lastModifiedData, sizeof(lastModifiedData),
                                         lastModifiedLength));
-        StringSpan lastModified = {{lastModifiedData, lastModifiedLength}, false, StringEncoding::Ascii};
-
-        char       etagData[64];
-        size_t     etagLength = 0;
-        StringSpan etag;
+        lastModified = {{lastModifiedData, lastModifiedLength}, false, StringEncoding::Ascii};
         if (options.enableValidators)
         {
+            size_t etagLength = 0;
             SC_TRY(Internal::formatWeakETag(fileStat, etagData, sizeof(etagData), etagLength));
             etag = {{etagData, etagLength}, false, StringEncoding::Ascii};
         }
+        contentType = Internal::getContentType(options, extension);
+        fileSize    = fileStat.fileSize;
+    }
+    if (not options.enableValidators)
+    {
+        etag = {};
+    }
+
+    StringSpan rangeHeader;
+    const bool hasRange = options.enableRangeRequests and connection.request.getHeader("Range", rangeHeader);
+
+    // The gzip variant is a different representation, with its own ETag, and it's never used for ranges.
+    // It comes from the cache, from a `.gz` sibling file or it's compressed on the fly while sending the body (and
+    // stored in the cache entry, if any, for the next requests).
+    StringSpan acceptEncoding;
+    const bool acceptsGZip = not hasRange and connection.request.getHeader("Accept-Encoding", acceptEncoding) and
+                             Internal::acceptsGZip(acceptEncoding);
+
+    const StringSpan     identityETag = etag;
+    bool                 hasGZip      = false;
+    bool                 useGZip      = false;
+    bool                 compressBody = false;
+    StringPath           gzipPath;
+    FileSystem::FileStat gzipStat;
+    char                 gzipETagData[64];
+    size_t               gzipETagLength = 0;
+    if (entry != nullptr and entry->gzipSize > 0)
+    {
+        hasGZip = true;
+        useGZip = acceptsGZip;
+        if (useGZip and options.enableValidators)
+        {
+            etag = {{entry->gzipETag, entry->gzipETagLength}, false, StringEncoding::Ascii};
+        }
+    }
+    else if (entry == nullptr and options.serveGZipSiblings and
+             Internal::findGZipSibling(directory.view(), filePath, fileStat, gzipPath, gzipStat))
+    {
+        hasGZip = true;
+        useGZip = acceptsGZip;
+        if (useGZip)
+        {
+            fileSize = gzipStat.fileSize;
+        }
+        if (useGZip and options.enableValidators)
+        {
+            char   siblingETagData[64];
+            size_t siblingETagLength = 0;
+            SC_TRY(Internal::formatWeakETag(gzipStat, siblingETagData, sizeof(siblingETagData), siblingETagLength));
+            SC_TRY(Internal::formatGZipETag({{siblingETagData, siblingETagLength}, false, StringEncoding::Ascii},
+                                            gzipETagData, sizeof(gzipETagData), gzipETagLength));
+            etag = {{gzipETagData, gzipETagLength}, false, StringEncoding::Ascii};
+        }
+    }
+    else if (options.compressResponses and fileSize >= options.compressionMinBytes and
+             Internal::isCompressible(contentType))
+    {
+        hasGZip      = true;
+        useGZip      = acceptsGZip and sendBody; // HEAD can't know the compressed length, so it describes identity
+        compressBody = useGZip;
+        if (useGZip and options.enableValidators)
+        {
+            SC_TRY(Internal::formatGZipETag(identityETag, gzipETagData, sizeof(gzipETagData), gzipETagLength));
+            etag = {{gzipETagData, gzipETagLength}, false, StringEncoding::Ascii};
+        }
+    }
 
-        if (options.enableValidators)
+    if (options.enableValidators)
+    {
+        StringSpan ifNoneMatch;
+        if (connection.request.getHeader("If-None-Match", ifNoneMatch))
         {
-            StringSpan ifNoneMatch;
-            if (connection.request.getHeader("If-None-Match", ifNoneMatch))
+            if (Internal::etagMatchesIfNoneMatch(ifNoneMatch, etag))
             {
-                if (Internal::etagMatchesIfNoneMatch(ifNoneMatch, etag))
-                {
-                    return Internal::sendNotModified(connection.response, lastModified, etag);
-                }
+                return Internal::sendNotModified(connection.response, dateHeader, lastModified, etag);
             }
-            else
+        }
+        else
+        {
+            StringSpan ifModifiedSince;
+            if (connection.request.getHeader("If-Modified-Since", ifModifiedSince) and ifModifiedSince == lastModified)
             {
-                StringSpan ifModifiedSince;
-                if (connection.request.getHeader("If-Modified-Since", ifModifiedSince) and
-                    ifModifiedSince == lastModified)
-                {
-                    return Internal::sendNotModified(connection.response, lastModified, etag);
-                }
+                return Internal::sendNotModified(connection.response, dateHeader, lastModified, etag);
             }
         }
+    }
 
-        Internal::ByteRange byteRange;
-        byteRange.length = fileStat.fileSize;
-        if (options.enableRangeRequests)
+    Internal::ByteRange byteRange;
+    byteRange.length = fileSize;
+    if (hasRange)
+    {
+        bool rangeAllowed = true;
+        if (options.enableValidators)
         {
-            StringSpan rangeHeader;
-            if (connection.request.getHeader("Range", rangeHeader))
+            StringSpan ifRange;
+            if (connection.request.getHeader("If-Range", ifRange))
             {
-                bool rangeAllowed = true;
-                if (options.enableValidators)
-                {
-                    StringSpan ifRange;
-                    if (connection.request.getHeader("If-Range", ifRange))
-                    {
-                        rangeAllowed = Internal::ifRangeMatches(ifRange, etag, lastModified);
-                    }
-                }
-                if (rangeAllowed and not Internal::parseSingleByteRange(rangeHeader, fileStat.fileSize, byteRange))
+                rangeAllowed = Internal::ifRangeMatches(ifRange, identityETag, lastModified);
+            }
+        }
+        if (rangeAllowed)
+        {
+            Internal::ByteRange ranges[Stream::ByteRanges::MaxRanges];
+            size_t              numRanges = 0;
+            if (not Internal::parseByteRanges(rangeHeader, fileSize, ranges, numRanges))
+            {
+                return Internal::sendRangeNotSatisfiable(connection.response, dateHeader, fileSize);
+            }
+            if (numRanges == 1)
+            {
+                byteRange = ranges[0];
+            }
+            else if (numRanges > 1)
+            {
+                stream.byteRanges.numRanges = numRanges;
+                for (size_t idx = 0; idx < numRanges; ++idx)
                 {
-                    return Internal::sendRangeNotSatisfiable(connection.response, fileStat.fileSize);
+                    stream.byteRanges.offsets[idx] = ranges[idx].offset;
+                    stream.byteRanges.lengths[idx] = ranges[idx].length;
                 }
             }
         }
+    }
 
-        char       contentRangeData[64];
-        size_t     contentRangeLength = 0;
-        StringSpan contentRange;
-        if (byteRange.partial)
+    // Multiple ranges are sent as multipart/byteranges, falling back to the entire file if part headers don't fit
+    char       multipartTypeData[64];
+    StringSpan multipartType;
+    if (stream.byteRanges.numRanges > 1)
+    {
+        char                  boundaryData[32];
+        HttpFixedBufferWriter boundary;
+        boundary.reset(boundaryData);
+        SC_TRY(boundary.appendLiteral("SC_BYTERANGES_", "HttpAsyncFileServer boundary too long"));
+        SC_TRY(boundary.appendDecimal(++byteRangesCount, "HttpAsyncFileServer boundary too long"));
+        const StringSpan boundarySpan = {boundary.written(), false, StringEncoding::Ascii};
+
+        HttpFixedBufferWriter typeWriter;
+        typeWriter.reset(multipartTypeData);
+        SC_TRY(typeWriter.appendLiteral("multipart/byteranges; boundary=", "HttpAsyncFileServer boundary too long"));
+        SC_TRY(typeWriter.append(boundarySpan, "HttpAsyncFileServer boundary too long"));
+        multipartType = {typeWriter.written(), false, StringEncoding::Ascii};
+
+        size_t multipartLength = 0;
+        if (Internal::formatByteRanges(stream.byteRanges, boundarySpan, contentType, fileSize, multipartLength))
+        {
+            byteRange.partial = true;
+            byteRange.length  = multipartLength;
+        }
+        else
+        {
+            stream.byteRanges.numRanges = 0;
+        }
+    }
+    const bool multipleRanges = stream.byteRanges.numRanges > 1;
+
+    char       contentRangeData[64];
+    size_t     contentRangeLength = 0;
+    StringSpan contentRange;
+    if (byteRange.partial and not multipleRanges)
+    {
+        SC_TRY(Internal::formatContentRange(byteRange, fileSize, contentRangeData, sizeof(contentRangeData),
+                                            contentRangeLength));
+        contentRange = {{contentRangeData, contentRangeLength}, false, StringEncoding::Ascii};
+    }
+
+    if (compressBody and not Internal::prepareCompressor(stream, connection, *threadPool, *eventLoop))
+    {
+        // The compressor can still be busy with a response aborted on a previous connection
+        compressBody = false;
+        useGZip      = false;
+        etag         = identityETag;
+    }
+
+    Span<const char> cachedBody;
+    if (entry != nullptr and not compressBody)
+    {
+        const Span<char> slot = cache->getSlot(*entry);
+        if (useGZip)
+        {
+            byteRange.length = entry->gzipSize;
+            cachedBody       = {slot.data() + entry->fileSize, entry->gzipSize};
+        }
+        else if (multipleRanges)
+        {
+            cachedBody = {slot.data(), fileSize};
+        }
+        else
         {
-            SC_TRY(Internal::formatContentRange(byteRange, fileStat.fileSize, contentRangeData,
-                                                sizeof(contentRangeData), contentRangeLength));
-            contentRange = {{contentRangeData, contentRangeLength}, false, StringEncoding::Ascii};
+            cachedBody = {slot.data() + byteRange.offset, byteRange.length};
         }
+    }
 
-        // Send HTTP headers first
-        SC_TRY(connection.response.startResponse(byteRange.partial ? 206 : 200));
+    // Send HTTP headers first
+    SC_TRY(connection.response.startResponse(byteRange.partial ? 206 : 200));
+    if (compressBody)
+    {
+        SC_TRY(connection.response.setChunkedTransferEncoding());
+    }
+    else
+    {
         SC_TRY(connection.response.addContentLength(byteRange.length));
-        SC_TRY(connection.response.addHeader("Content-Type", Internal::getContentType(options, extension)));
-        SC_TRY(Internal::writeGMTHeaderTime("Date", connection.response, Internal::getCurrentTimeMilliseconds()));
-        if (options.enableValidators)
+    }
+    SC_TRY(connection.response.addHeader("Content-Type", multipleRanges ? multipartType : contentType));
+    if (useGZip)
+    {
+        SC_TRY(connection.response.addHeader("Content-Encoding", "gzip"));
+    }
+    if (hasGZip)
+    {
+        SC_TRY(connection.response.addHeader("Vary", "Accept-Encoding"));
+    }
+    SC_TRY(connection.response.addDateHeader(dateHeader));
+    if (options.enableValidators)
+    {
+        SC_TRY(connection.response.addHeader("Last-Modified", lastModified));
+        SC_TRY(connection.response.addHeader("ETag", etag));
+    }
+    if (options.enableRangeRequests)
+    {
+        SC_TRY(connection.response.addHeader("Accept-Ranges", "bytes"));
+    }
+    if (not contentRange.isEmpty())
+    {
+        SC_TRY(connection.response.addHeader("Content-Range", contentRange));
+    }
+    SC_TRY(connection.response.addHeader("Server", "SC"));
+
+    if (not sendBody)
+    {
+        stream.byteRanges.numRanges = 0;
+        SC_TRY(connection.response.sendHeaders());
+        return connection.response.end();
+    }
+
+    // Context for the callbacks
+    stream.multipartListener.server     = this;
+    stream.multipartListener.stream     = &stream;
+    stream.multipartListener.connection = &connection;
+    if (multipleRanges)
+    {
+        stream.byteRanges.current = 0;
+        if (entry != nullptr)
         {
-            SC_TRY(connection.response.addHeader("Last-Modified", lastModified));
-            SC_TRY(connection.response.addHeader("ETag", etag));
+            // Parts are written straight from the cached memory, that must not be evicted in the meantime
+            SC_TRY(Internal::pinCacheEntry(stream, connection, *entry));
+            stream.byteRanges.cachedData = cachedBody.data();
         }
-        if (options.enableRangeRequests)
+        else
         {
-            SC_TRY(connection.response.addHeader("Accept-Ranges", "bytes"));
+            StringPath path;
+            SC_TRY(path.assign(directory.view()));
+            SC_TRY(path.append("/"));
+            SC_TRY(path.append(filePath));
+            const Result openRes = stream.sourceFileDescriptor.open(path.view(), FileOpen::Read);
+            if (not openRes)
+            {
+                stream.byteRanges.numRanges = 0;
+                return openRes;
+            }
         }
-        if (byteRange.partial)
+        const Result sendRes =
+            connection.response.sendHeaders([&stream](AsyncBufferView::ID) { Internal::sendNextByteRange(stream); });
+        if (not sendRes)
         {
-            SC_TRY(connection.response.addHeader("Content-Range", contentRange));
+            Internal::finishByteRanges(stream);
         }
-        SC_TRY(connection.response.addHeader("Server", "SC"));
+        return sendRes;
+    }
+
+    if (entry != nullptr and not compressBody)
+    {
+        SC_TRY(connection.response.sendHeaders());
+        return Internal::sendCachedBody(stream, connection, *entry, cachedBody);
+    }
 
-        if (not sendBody)
+    StringPath path;
+    if (useGZip and not compressBody)
+    {
+        SC_TRY(path.assign(gzipPath.view()));
+    }
+    else
+    {
+        SC_TRY(path.assign(directory.view()));
+        SC_TRY(path.append("/"));
+        SC_TRY(path.append(filePath));
+    }
+    if (compressBody)
+    {
+        FileDescriptor fd;
+        SC_TRY(fd.open(path.view(), FileOpen::Read));
+        SC_TRY(stream.readableFileStream.init(connection.buffersPool, *eventLoop, fd));
+        SC_TRY(stream.readableFileStream.request.executeOn(stream.readableFileStreamTask, *threadPool));
+        fd.detach();
+        stream.readableFileStream.setAutoCloseDescriptor(true);
+        SC_TRY(connection.response.sendHeaders());
+        // The chunked writable stream is selected by sendHeaders
+        connection.pipeline.source        = &stream.readableFileStream;
+        connection.pipeline.transforms[0] = &stream.compressor;
+        connection.pipeline.sinks[0]      = &connection.response.getWritableStream();
+        Internal::CacheEntry* gzipEntry   = entry != nullptr ? entry : filling;
+        if (gzipEntry != nullptr and Internal::prepareGZipStore(stream, connection, *cache, *gzipEntry))
         {
-            SC_TRY(connection.response.sendHeaders());
-            return connection.response.end();
+            // Next requests will be answered with the stored output instead of compressing again
+            connection.pipeline.sinks[1] = &stream.cacheWritable;
         }
+        SC_TRY(connection.pipeline.pipe());
+        SC_TRY(connection.pipeline.start());
+    }
+    else if (useAsyncFileSend or byteRange.partial)
+    {
+        stream.fileSendOffset = byteRange.offset;
+        stream.fileSendLength = byteRange.length;
+        SC_TRY(stream.sourceFileDescriptor.open(path.view(), FileOpen::Read));
 
-        if (useAsyncFileSend or byteRange.partial)
+        auto onHeadersSent = [&stream](AsyncBufferView::ID)
         {
-            // Context for the callback
-            stream.multipartListener.server     = this;
-            stream.multipartListener.stream     = &stream;
-            stream.multipartListener.connection = &static_cast<HttpConnection&>(connection);
-            stream.fileSendOffset               = byteRange.offset;
-            stream.fileSendLength               = byteRange.length;
-            SC_TRY(stream.sourceFileDescriptor.open(path.view(), FileOpen::Read));
+            HttpConnection&      connection = *stream.multipartListener.connection;
+            HttpAsyncFileServer* server     = stream.multipartListener.server;
 
-            auto onHeadersSent = [&stream](AsyncBufferView::ID)
+            // Use AsyncFileSend for zero-copy file serving
+            stream.asyncFileSend.callback = [&connection, &stream](AsyncFileSend::Result& result)
             {
-                HttpConnection&      connection = *stream.multipartListener.connection;
-                HttpAsyncFileServer* server     = stream.multipartListener.server;
-
-                // Use AsyncFileSend for zero-copy file serving
-                stream.asyncFileSend.callback = [&connection, &stream](AsyncFileSend::Result& result)
+                if (not result.isValid())
                 {
-                    if (not result.isValid())
-                    {
-                        SC_HTTP_ASSERT_RELEASE(stream.sourceFileDescriptor.close());
-                        // Error occurred during send, close the response
-                        (void)connection.response.end();
-                        return;
-                    }
-
-                    // Check if the entire file was sent
-                    if (result.isComplete())
-                    {
-                        SC_HTTP_ASSERT_RELEASE(stream.sourceFileDescriptor.close());
-                        // File send complete, close the response
-                        (void)connection.response.end();
-                    }
-                    else
-                    {
-                        // Partial send, reactivate to continue
-                        result.reactivateRequest(true);
-                    }
-                };
+                    SC_HTTP_ASSERT_RELEASE(stream.sourceFileDescriptor.close());
+                    // Error occurred during send, close the response
+                    (void)connection.response.end();
+                    return;
+                }
 
-                Result res =
-                    stream.asyncFileSend.start(*server->eventLoop, stream.sourceFileDescriptor, connection.socket,
-                                               static_cast<int64_t>(stream.fileSendOffset), stream.fileSendLength);
-                if (not res)
+                // Check if the entire file was sent
+                if (result.isComplete())
                 {
-                    // Failed to start sending file
                     SC_HTTP_ASSERT_RELEASE(stream.sourceFileDescriptor.close());
+                    // File send complete, close the response
                     (void)connection.response.end();
                 }
+                else
+                {
+                    // Partial send, reactivate to continue
+                    result.reactivateRequest(true);
+                }
             };
 
-            SC_TRY(connection.response.sendHeaders(onHeadersSent));
-        }
-        else
-        {
-            // Use legacy AsyncStreams approach
-            FileDescriptor fd;
-            SC_TRY(fd.open(path.view(), FileOpen::Read));
-            Result initRes = stream.readableFileStream.init(connection.buffersPool, *eventLoop, fd);
-            SC_HTTP_ASSERT_RELEASE(initRes);
-            SC_TRY(initRes);
-            SC_TRY(stream.readableFileStream.request.executeOn(stream.readableFileStreamTask, *threadPool));
-            fd.detach();
-            stream.readableFileStream.setAutoCloseDescriptor(true);
-            connection.pipeline.source   = &stream.readableFileStream;
-            connection.pipeline.sinks[0] = &connection.response.getWritableStream();
-            SC_TRY(connection.response.sendHeaders());
-            SC_TRY(connection.pipeline.pipe());
-            SC_TRY(connection.pipeline.start());
-        }
+            Result res = stream.asyncFileSend.start(*server->eventLoop, stream.sourceFileDescriptor, connection.socket,
+                                                    static_cast<int64_t>(stream.fileSendOffset), stream.fileSendLength);
+            if (not res)
+            {
+                // Failed to start sending file
+                SC_HTTP_ASSERT_RELEASE(stream.sourceFileDescriptor.close());
+                (void)connection.response.end();
+            }
+        };
+
+        SC_TRY(connection.response.sendHeaders(onHeadersSent));
     }
     else
     {
-        StringSpan fallbackPath;
-        SC_TRY(Internal::normalizeOptionFilePath(options.spaFallbackPath, fallbackPath));
-        if (allowSpaFallback and not fallbackPath.isEmpty() and fallbackPath != filePath)
-        {
-            return getFile(stream, connection, fallbackPath, sendBody, false);
-        }
-        return Internal::sendEmptyResponse(connection.response, 404);
+        // Use legacy AsyncStreams approach
+        FileDescriptor fd;
+        SC_TRY(fd.open(path.view(), FileOpen::Read));
+        Result initRes = stream.readableFileStream.init(connection.buffersPool, *eventLoop, fd);
+        SC_HTTP_ASSERT_RELEASE(initRes);
+        SC_TRY(initRes);
+        SC_TRY(stream.readableFileStream.request.executeOn(stream.readableFileStreamTask, *threadPool));
+        fd.detach();
+        stream.readableFileStream.setAutoCloseDescriptor(true);
+        connection.pipeline.source   = &stream.readableFileStream;
+        connection.pipeline.sinks[0] = &connection.response.getWritableStream();
+        SC_TRY(connection.response.sendHeaders());
+        SC_TRY(connection.pipeline.pipe());
+        SC_TRY(connection.pipeline.start());
     }
     return Result(true);
 }
@@ -339,6 +772,10 @@ Result HttpAsyncFileServer::putFile(HttpAsyncFileServer::Stream& stream, HttpCon
     SC_TRY(path.assign(directory.view()));
     SC_TRY(path.append("/"));
     SC_TRY(path.append(filePath));
+    if (options.cache != nullptr)
+    {
+        options.cache->invalidate(filePath);
+    }
     const size_t   totalFileUploadBytes = static_cast<size_t>(connection.request.getBodyBytesRemaining());
     FileDescriptor fd;
     SC_TRY(fd.open(path.view(), FileOpen::Write));
@@ -571,35 +1008,16 @@ bool HttpAsyncFileServer::Internal::parseDecimalSize(StringSpan text, size_t& va
     return true;
 }
 
-bool HttpAsyncFileServer::Internal::parseSingleByteRange(StringSpan header, size_t fileSize, ByteRange& range)
+bool HttpAsyncFileServer::Internal::parseByteRangeSpec(StringSpan spec, size_t fileSize, ByteRange& range,
+                                                      bool& satisfiable)
 {
-    static constexpr StringSpan Prefix = "bytes=";
+    satisfiable = false;
 
-    range.offset  = 0;
-    range.length  = fileSize;
-    range.partial = false;
-
-    const char*  data   = header.bytesWithoutTerminator();
-    const size_t length = header.sizeInBytes();
-    if (length <= Prefix.sizeInBytes() or fileSize == 0)
-    {
-        return false;
-    }
-    for (size_t idx = 0; idx < Prefix.sizeInBytes(); ++idx)
-    {
-        if (data[idx] != Prefix.bytesWithoutTerminator()[idx])
-        {
-            return false;
-        }
-    }
-
-    size_t dashIndex = static_cast<size_t>(-1);
-    for (size_t idx = Prefix.sizeInBytes(); idx < length; ++idx)
+    const char*  data      = spec.bytesWithoutTerminator();
+    const size_t length    = spec.sizeInBytes();
+    size_t       dashIndex = static_cast<size_t>(-1);
+    for (size_t idx = 0; idx < length; ++idx)
     {
-        if (data[idx] == ',')
-        {
-            return false;
-        }
         if (data[idx] == '-')
         {
             if (dashIndex != static_cast<size_t>(-1))
@@ -614,8 +1032,7 @@ bool HttpAsyncFileServer::Internal::parseSingleByteRange(StringSpan header, size
         return false;
     }
 
-    const size_t startBegin  = Prefix.sizeInBytes();
-    const size_t startLength = dashIndex - startBegin;
+    const size_t startLength = dashIndex;
     const size_t endBegin    = dashIndex + 1;
     const size_t endLength   = length - endBegin;
 
@@ -629,33 +1046,28 @@ bool HttpAsyncFileServer::Internal::parseSingleByteRange(StringSpan header, size
     if (startLength == 0)
     {
         size_t suffixLength = 0;
-        if (not parseDecimalSize({{data + endBegin, endLength}, false, header.getEncoding()}, suffixLength) or
-            suffixLength == 0)
+        if (not parseDecimalSize({{data + endBegin, endLength}, false, spec.getEncoding()}, suffixLength))
         {
             return false;
         }
-        if (suffixLength >= fileSize)
+        if (suffixLength == 0)
         {
-            start = 0;
+            return true; // Valid but unsatisfiable
         }
-        else
+        if (suffixLength < fileSize)
         {
             start = fileSize - suffixLength;
         }
     }
     else
     {
-        if (not parseDecimalSize({{data + startBegin, startLength}, false, header.getEncoding()}, start))
-        {
-            return false;
-        }
-        if (start >= fileSize)
+        if (not parseDecimalSize({{data, startLength}, false, spec.getEncoding()}, start))
         {
             return false;
         }
         if (endLength > 0)
         {
-            if (not parseDecimalSize({{data + endBegin, endLength}, false, header.getEncoding()}, end))
+            if (not parseDecimalSize({{data + endBegin, endLength}, false, spec.getEncoding()}, end))
             {
                 return false;
             }
@@ -668,14 +1080,206 @@ bool HttpAsyncFileServer::Internal::parseSingleByteRange(StringSpan header, size
                 end = fileSize - 1;
             }
         }
+        if (start >= fileSize)
+        {
+            return true; // Valid but unsatisfiable
+        }
     }
 
     range.offset  = start;
     range.length  = end - start + 1;
     range.partial = true;
+    satisfiable   = true;
+    return true;
+}
+
+bool HttpAsyncFileServer::Internal::parseByteRanges(StringSpan header, size_t fileSize, Span<ByteRange> ranges,
+                                                   size_t& numRanges)
+{
+    static constexpr StringSpan Prefix = "bytes=";
+
+    numRanges = 0;
+    if (header.sizeInBytes() <= Prefix.sizeInBytes() or fileSize == 0 or
+        not HttpStringIterator::startsWith(header, "bytes="))
+    {
+        return false;
+    }
+
+    const char*  data        = header.bytesWithoutTerminator();
+    const size_t length      = header.sizeInBytes();
+    size_t       cursor      = Prefix.sizeInBytes();
+    size_t       totalLength = 0;
+    bool         tooMany     = false;
+    while (cursor <= length)
+    {
+        size_t specEnd = cursor;
+        while (specEnd < length and data[specEnd] != ',')
+        {
+            specEnd++;
+        }
+        size_t start = cursor;
+        size_t end   = specEnd;
+        while (start < end and (data[start] == ' ' or data[start] == '\t'))
+        {
+            start++;
+        }
+        while (end > start and (data[end - 1] == ' ' or data[end - 1] == '\t'))
+        {
+            end--;
+        }
+        if (end > start)
+        {
+            ByteRange  range;
+            bool       satisfiable = false;
+            StringSpan spec        = {{data + start, end - start}, false, header.getEncoding()};
+            if (not parseByteRangeSpec(spec, fileSize, range, satisfiable))
+            {
+                return false;
+            }
+            if (satisfiable)
+            {
+                if (numRanges < ranges.sizeInElements())
+                {
+                    ranges[numRanges++] = range;
+                    totalLength += range.length;
+                }
+                else
+                {
+                    tooMany = true;
+                }
+            }
+        }
+        cursor = specEnd + 1;
+    }
+    if (numRanges == 0)
+    {
+        return false;
+    }
+    if (tooMany or (numRanges > 1 and totalLength > fileSize))
+    {
+        // Too many or overlapping ranges would cost more than the entire file, so the Range header is ignored
+        numRanges = 0;
+    }
     return true;
 }
 
+Result HttpAsyncFileServer::Internal::formatByteRanges(Stream::ByteRanges& byteRanges, StringSpan boundary,
+                                                       StringSpan contentType, size_t fileSize,
+                                                       size_t& contentLength)
+{
+    static constexpr const char* OutOfSpace = "HttpAsyncFileServer byte ranges headers space is finished";
+
+    HttpFixedBufferWriter writer;
+    writer.reset({byteRanges.headers, sizeof(byteRanges.headers)});
+    contentLength = 0;
+    for (size_t idx = 0; idx < byteRanges.numRanges; ++idx)
+    {
+        const size_t offset = byteRanges.offsets[idx];
+        SC_TRY(writer.appendLiteral("\r\n--", OutOfSpace));
+        SC_TRY(writer.append(boundary, OutOfSpace));
+        SC_TRY(writer.appendLiteral("\r\nContent-Type: ", OutOfSpace));
+        SC_TRY(writer.append(contentType, OutOfSpace));
+        SC_TRY(writer.appendLiteral("\r\nContent-Range: bytes ", OutOfSpace));
+        SC_TRY(writer.appendDecimal(offset, OutOfSpace));
+        SC_TRY(writer.appendLiteral("-", OutOfSpace));
+        SC_TRY(writer.appendDecimal(offset + byteRanges.lengths[idx] - 1, OutOfSpace));
+        SC_TRY(writer.appendLiteral("/", OutOfSpace));
+        SC_TRY(writer.appendDecimal(fileSize, OutOfSpace));
+        SC_TRY(writer.appendLiteral("\r\n\r\n", OutOfSpace));
+        byteRanges.headersEnd[idx] = writer.writtenBytes();
+        contentLength += byteRanges.lengths[idx];
+    }
+    SC_TRY(writer.appendLiteral("\r\n--", OutOfSpace));
+    SC_TRY(writer.append(boundary, OutOfSpace));
+    SC_TRY(writer.appendLiteral("--\r\n", OutOfSpace));
+    byteRanges.headersEnd[byteRanges.numRanges] = writer.writtenBytes();
+    contentLength += writer.writtenBytes();
+    return Result(true);
+}
+
+void HttpAsyncFileServer::Internal::sendNextByteRange(Stream& stream)
+{
+    Stream::ByteRanges& byteRanges = stream.byteRanges;
+    HttpConnection&     connection = *stream.multipartListener.connection;
+
+    const size_t     start   = byteRanges.current == 0 ? 0 : byteRanges.headersEnd[byteRanges.current - 1];
+    const size_t     end     = byteRanges.headersEnd[byteRanges.current];
+    Span<const char> headers = {byteRanges.headers + start, end - start};
+
+    AsyncWritableStream& writable = connection.response.getWritableStream();
+
+    Result res(true);
+    if (byteRanges.current == byteRanges.numRanges)
+    {
+        // Closing delimiter
+        res = writable.write(AsyncBufferView(headers), [&stream](AsyncBufferView::ID) { finishByteRanges(stream); });
+    }
+    else
+    {
+        res = writable.write(AsyncBufferView(headers), [&stream](AsyncBufferView::ID) { sendByteRangeData(stream); });
+    }
+    if (not res)
+    {
+        finishByteRanges(stream);
+    }
+}
+
+void HttpAsyncFileServer::Internal::sendByteRangeData(Stream& stream)
+{
+    Stream::ByteRanges& byteRanges = stream.byteRanges;
+    HttpConnection&     connection = *stream.multipartListener.connection;
+
+    const size_t offset = byteRanges.offsets[byteRanges.current];
+    const size_t length = byteRanges.lengths[byteRanges.current];
+    byteRanges.current++;
+
+    Result res(true);
+    if (byteRanges.cachedData != nullptr)
+    {
+        AsyncWritableStream& writable = connection.response.getWritableStream();
+        Span<const char>     data     = {byteRanges.cachedData + offset, length};
+        res = writable.write(AsyncBufferView(data), [&stream](AsyncBufferView::ID) { sendNextByteRange(stream); });
+    }
+    else
+    {
+        stream.asyncFileSend.callback = [&stream](AsyncFileSend::Result& result)
+        {
+            if (not result.isValid())
+            {
+                finishByteRanges(stream);
+            }
+            else if (result.isComplete())
+            {
+                sendNextByteRange(stream);
+            }
+            else
+            {
+                result.reactivateRequest(true);
+            }
+        };
+        HttpAsyncFileServer& server = *stream.multipartListener.server;
+        res = stream.asyncFileSend.start(*server.eventLoop, stream.sourceFileDescriptor, connection.socket,
+                                         static_cast<int64_t>(offset), length);
+    }
+    if (not res)
+    {
+        finishByteRanges(stream);
+    }
+}
+
+void HttpAsyncFileServer::Internal::finishByteRanges(Stream& stream)
+{
+    Stream::ByteRanges& byteRanges = stream.byteRanges;
+    if (stream.sourceFileDescriptor.isValid())
+    {
+        SC_HTTP_ASSERT_RELEASE(stream.sourceFileDescriptor.close());
+    }
+    releaseCacheEntry(stream);
+    byteRanges.cachedData = nullptr;
+    byteRanges.numRanges  = 0;
+    (void)stream.multipartListener.connection->response.end();
+}
+
 bool HttpAsyncFileServer::Internal::etagMatchesIfNoneMatch(StringSpan ifNoneMatch, StringSpan etag)
 {
     const char*  data   = ifNoneMatch.bytesWithoutTerminator();
@@ -759,10 +1363,11 @@ Result HttpAsyncFileServer::Internal::sendEmptyResponse(HttpResponse& response,
     return response.end();
 }
 
-Result HttpAsyncFileServer::Internal::sendNotModified(HttpResponse& response, StringSpan lastModified, StringSpan etag)
+Result HttpAsyncFileServer::Internal::sendNotModified(HttpResponse& response, const HttpDateHeader& dateHeader,
+                                                      StringSpan lastModified, StringSpan etag)
 {
     SC_TRY(response.startResponse(304));
-    SC_TRY(writeGMTHeaderTime("Date", response, getCurrentTimeMilliseconds()));
+    SC_TRY(response.addDateHeader(dateHeader));
     SC_TRY(response.addHeader("Last-Modified", lastModified));
     if (not etag.isEmpty())
     {
@@ -773,7 +1378,8 @@ Result HttpAsyncFileServer::Internal::sendNotModified(HttpResponse& response, St
     return response.end();
 }
 
-Result HttpAsyncFileServer::Internal::sendRangeNotSatisfiable(HttpResponse& response, size_t fileSize)
+Result HttpAsyncFileServer::Internal::sendRangeNotSatisfiable(HttpResponse& response, const HttpDateHeader& dateHeader,
+                                                              size_t fileSize)
 {
     char   contentRangeData[64];
     size_t contentRangeLength = 0;
@@ -781,7 +1387,7 @@ Result HttpAsyncFileServer::Internal::sendRangeNotSatisfiable(HttpResponse& resp
     StringSpan contentRange = {{contentRangeData, contentRangeLength}, false, StringEncoding::Ascii};
 
     SC_TRY(response.startResponse(416));
-    SC_TRY(writeGMTHeaderTime("Date", response, getCurrentTimeMilliseconds()));
+    SC_TRY(response.addDateHeader(dateHeader));
     SC_TRY(response.addHeader("Content-Range", contentRange));
     SC_TRY(response.addHeader("Accept-Ranges", "bytes"));
     SC_TRY(response.addHeader("Server", "SC"));
@@ -790,52 +1396,13 @@ Result HttpAsyncFileServer::Internal::sendRangeNotSatisfiable(HttpResponse& resp
     return response.end();
 }
 
-int64_t HttpAsyncFileServer::Internal::getCurrentTimeMilliseconds()
-{
-#if SC_PLATFORM_WINDOWS
-    struct _timeb t;
-    _ftime_s(&t);
-    return static_cast<int64_t>(t.time) * 1000 + t.millitm;
-#else
-    struct timespec nowTimeSpec;
-    clock_gettime(CLOCK_REALTIME, &nowTimeSpec);
-    constexpr int64_t nanosecondsToMilliseconds = 1000 * 1000;
-    constexpr int64_t roundingNanoseconds       = nanosecondsToMilliseconds / 2;
-    return static_cast<int64_t>(nowTimeSpec.tv_sec) * 1000 +
-           (static_cast<int64_t>(nowTimeSpec.tv_nsec) + roundingNanoseconds) / nanosecondsToMilliseconds;
-#endif
-}
-
 Result HttpAsyncFileServer::Internal::formatHttpDate(int64_t millisecondsSinceEpoch, char* buffer, size_t bufferSize,
                                                      size_t& outLength)
 {
-    const time_t seconds = static_cast<time_t>(millisecondsSinceEpoch / 1000);
-    struct tm    parsedTm;
-#if SC_PLATFORM_WINDOWS
-    if (_gmtime64_s(&parsedTm, &seconds) != 0)
-    {
-        return Result::Error("Failed to convert time");
-    }
-#else
-    if (gmtime_r(&seconds, &parsedTm) == nullptr)
-    {
-        return Result::Error("Failed to convert time");
-    }
-#endif
-
-    // Format as HTTP date: "Wed, 21 Oct 2015 07:28:00 GMT"
-    const char* days[]   = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
-    const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-
-    outLength = static_cast<size_t>(
-        snprintf(buffer, bufferSize, "%s, %02d %s %04d %02d:%02d:%02d GMT", days[parsedTm.tm_wday], parsedTm.tm_mday,
-                 months[parsedTm.tm_mon], parsedTm.tm_year + 1900, parsedTm.tm_hour, parsedTm.tm_min, parsedTm.tm_sec));
-
-    if (outLength == 0 || outLength >= bufferSize)
-    {
-        return Result::Error("Failed to format time");
-    }
-
+    HttpFixedBufferWriter writer;
+    writer.reset({buffer, bufferSize});
+    SC_TRY(writer.appendHttpDate(millisecondsSinceEpoch, "Failed to format time"));
+    outLength = writer.writtenBytes();
     return Result(true);
 }
 
@@ -877,14 +1444,408 @@ Result HttpAsyncFileServer::Internal::formatWeakETag(const FileSystem::FileStat&
     return Result(true);
 }
 
-Result HttpAsyncFileServer::Internal::writeGMTHeaderTime(StringSpan headerName, HttpResponse& response,
-                                                         int64_t millisecondsSinceEpoch)
+bool HttpAsyncFileServer::Internal::acceptsGZip(StringSpan acceptEncoding)
+{
+    const char*  data   = acceptEncoding.bytesWithoutTerminator();
+    const size_t length = acceptEncoding.sizeInBytes();
+    size_t       cursor = 0;
+    while (cursor < length)
+    {
+        size_t tokenEnd = cursor;
+        while (tokenEnd < length and data[tokenEnd] != ',')
+        {
+            tokenEnd++;
+        }
+        size_t start = cursor;
+        while (start < tokenEnd and (data[start] == ' ' or data[start] == '\t'))
+        {
+            start++;
+        }
+        size_t nameEnd = start;
+        while (nameEnd < tokenEnd and data[nameEnd] != ';' and data[nameEnd] != ' ' and data[nameEnd] != '\t')
+        {
+            nameEnd++;
+        }
+        const StringSpan name = {{data + start, nameEnd - start}, false, StringEncoding::Ascii};
+        if (HttpStringIterator::equalsIgnoreCase(name, StringSpan("gzip")) or name == "*")
+        {
+            // Only an explicit "q=0" (with any number of trailing zeros) refuses the coding
+            bool   refused = false;
+            size_t qIndex  = nameEnd;
+            while (qIndex + 1 < tokenEnd and not(data[qIndex] == 'q' and data[qIndex + 1] == '='))
+            {
+                qIndex++;
+            }
+            if (qIndex + 1 < tokenEnd)
+            {
+                size_t value = qIndex + 2;
+                refused      = value < tokenEnd and data[value] == '0';
+                for (value = value + 1; refused and value < tokenEnd; ++value)
+                {
+                    refused = data[value] == '0' or data[value] == '.' or data[value] == ' ';
+                }
+            }
+            return not refused;
+        }
+        cursor = tokenEnd + 1;
+    }
+    return false;
+}
+
+bool HttpAsyncFileServer::Internal::isCompressible(StringSpan contentType)
+{
+    // Text-like types compress well, while images, fonts and archives are usually already compressed
+    const char* data   = contentType.bytesWithoutTerminator();
+    size_t      length = 0;
+    while (length < contentType.sizeInBytes() and data[length] != ';' and data[length] != ' ')
+    {
+        length++; // Ignore parameters like "; charset=utf-8"
+    }
+    const StringSpan type = {{data, length}, false, StringEncoding::Ascii};
+    return HttpStringIterator::startsWith(type, "text/") or HttpStringIterator::endsWith(type, "xml") or
+           HttpStringIterator::endsWith(type, "json") or HttpStringIterator::endsWith(type, "javascript") or
+           HttpStringIterator::endsWith(type, "wasm");
+}
+
+bool HttpAsyncFileServer::Internal::findGZipSibling(StringSpan directory, StringSpan filePath,
+                                                    const FileSystem::FileStat& fileStat, StringPath& gzipPath,
+                                                    FileSystem::FileStat& gzipStat)
+{
+    if (not gzipPath.assign(directory) or not gzipPath.append("/") or not gzipPath.append(filePath) or
+        not gzipPath.append(".gz"))
+    {
+        return false;
+    }
+    FileSystem fileSystem;
+    if (not fileSystem.init(directory) or not fileSystem.stat(gzipPath.view(), gzipStat))
+    {
+        return false;
+    }
+    // An older sibling is stale, as the file has been modified after compressing it
+    return gzipStat.entryType == FileSystemEntryType::File and gzipStat.fileSize > 0 and
+           gzipStat.modifiedTime.milliseconds >= fileStat.modifiedTime.milliseconds;
+}
+
+Result HttpAsyncFileServer::Internal::formatGZipETag(StringSpan etag, char* buffer, size_t bufferSize,
+                                                     size_t& outLength)
+{
+    // W/"size-time" --> W/"size-time-gz"
+    const size_t length = etag.sizeInBytes();
+    SC_TRY_MSG(length > 0 and etag.bytesWithoutTerminator()[length - 1] == '"', "Invalid ETag");
+    SC_TRY_MSG(length + 3 < bufferSize, "Failed to format ETag");
+    ::memcpy(buffer, etag.bytesWithoutTerminator(), length - 1);
+    ::memcpy(buffer + length - 1, "-gz\"", 4);
+    outLength = length + 3;
+    return Result(true);
+}
+
+Result HttpAsyncFileServer::Internal::prepareCompressor(Stream& stream, HttpConnection& connection,
+                                                        ThreadPool& threadPool, AsyncEventLoop& loop)
+{
+    // Fails if a previous transform is still running on the thread pool, so it must happen before touching the zlib
+    // state or the LoopWork that the worker thread could be using
+    SC_TRY(stream.compressor.init(connection.buffersPool));
+    stream.compressor.stream.reset();
+    SC_TRY(stream.compressor.stream.init(ZLibStream::CompressGZip));
+    SC_TRY(stream.compressor.asyncWork.setThreadPool(threadPool));
+    stream.compressor.setEventLoop(loop);
+    return Result(true);
+}
+
+Result HttpAsyncFileServer::Internal::lookupCache(HttpAsyncFileServerCache& cache, StringSpan directory,
+                                                  StringSpan filePath, int64_t now, CacheEntry*& entry,
+                                                  CacheEntry*& filling)
+{
+    entry   = cache.find(filePath);
+    filling = nullptr;
+    if (entry != nullptr and entry->filling)
+    {
+        filling = entry; // Still being read on the ThreadPool
+        entry   = nullptr;
+    }
+    if (entry == nullptr)
+    {
+        cache.statistics.misses++;
+        return Result(true);
+    }
+    if (cache.revalidateIntervalMs >= 0 and now - entry->validatedTime >= cache.revalidateIntervalMs)
+    {
+        FileSystem fileSystem;
+        SC_TRY(fileSystem.init(directory));
+        FileSystem::FileStat fileStat;
+        const bool           isFile = fileSystem.stat(filePath, fileStat) and
+                            fileStat.entryType == FileSystemEntryType::File and fileStat.fileSize == entry->fileSize and
+                            fileStat.modifiedTime.milliseconds == entry->modifiedTime;
+        if (not isFile)
+        {
+            cache.drop(*entry);
+            cache.statistics.invalidations++;
+            cache.statistics.misses++;
+            entry = nullptr;
+            return Result(true);
+        }
+        entry->validatedTime = now;
+    }
+    cache.statistics.hits++;
+    return Result(true);
+}
+
+Result HttpAsyncFileServer::Internal::fillCache(Stream& stream, HttpAsyncFileServerCache& cache,
+                                                const HttpAsyncFileServerOptions& options, StringSpan directory,
+                                                StringSpan filePath, const FileSystem::FileStat& fileStat,
+                                                StringSpan contentType, int64_t now, ThreadPool& threadPool,
+                                                AsyncEventLoop& loop, CacheEntry*& filling)
+{
+    filling                 = nullptr;
+    Stream::CacheFill& fill = stream.cacheFill;
+    if (fileStat.fileSize > cache.slotSize or filePath.sizeInBytes() > CacheEntry::MaxPathLength or
+        not fill.work.isFree())
+    {
+        return Result(true); // Not cacheable (or still filling a previous entry), just serve it from disk
+    }
+    CacheEntry* candidate = cache.acquire();
+    if (candidate == nullptr)
+    {
+        return Result(true); // All entries are being used right now
+    }
+
+    SC_TRY(fill.path.assign(directory));
+    SC_TRY(fill.path.append("/"));
+    SC_TRY(fill.path.append(filePath));
+    SC_TRY(formatWeakETag(fileStat, candidate->etag, sizeof(candidate->etag), candidate->etagLength));
+    SC_TRY(formatHttpDate(fileStat.modifiedTime.milliseconds, candidate->lastModified,
+                          sizeof(candidate->lastModified), candidate->lastModifiedLength));
+
+    // The gzip representation goes in the remaining slot space, if it fits
+    candidate->gzipSize       = 0;
+    candidate->gzipETagLength = 0;
+    fill.gzipSize             = 0;
+    fill.gzipRead             = false;
+
+    FileSystem::FileStat gzipStat;
+    if (options.serveGZipSiblings and findGZipSibling(directory, filePath, fileStat, fill.gzipPath, gzipStat) and
+        gzipStat.fileSize <= cache.slotSize - fileStat.fileSize)
+    {
+        char   siblingETagData[64];
+        size_t siblingETagLength = 0;
+        SC_TRY(formatWeakETag(gzipStat, siblingETagData, sizeof(siblingETagData), siblingETagLength));
+        SC_TRY(formatGZipETag({{siblingETagData, siblingETagLength}, false, StringEncoding::Ascii},
+                              candidate->gzipETag, sizeof(candidate->gzipETag), candidate->gzipETagLength));
+        fill.gzipSize = gzipStat.fileSize;
+    }
+
+    ::memcpy(candidate->path, filePath.bytesWithoutTerminator(), filePath.sizeInBytes());
+    candidate->path[filePath.sizeInBytes()] = 0;
+
+    candidate->pathLength    = filePath.sizeInBytes();
+    candidate->pathHash      = HttpAsyncFileServerCache::hashPath(filePath);
+    candidate->contentType   = contentType;
+    candidate->fileSize      = fileStat.fileSize;
+    candidate->modifiedTime  = fileStat.modifiedTime.milliseconds;
+    candidate->validatedTime = now;
+    candidate->compressing   = false;
+    candidate->filling       = true; // Found by lookups (that don't fill it again) but served from disk until ready
+    candidate->pins++;
+
+    fill.cache    = &cache;
+    fill.entry    = candidate;
+    fill.slot     = cache.getSlot(*candidate);
+    fill.fileSize = fileStat.fileSize;
+
+    fill.work.work     = [&fill]() { return readCacheFill(fill); };
+    fill.work.callback = [&fill](AsyncLoopWork::Result& result) { finishCacheFill(fill, result); };
+
+    Result res = fill.work.setThreadPool(threadPool);
+    if (res)
+    {
+        res = fill.work.start(loop);
+        if (not res)
+        {
+            fill.work.disableThreadPool();
+        }
+    }
+    if (not res)
+    {
+        candidate->pins--;
+        cache.drop(*candidate);
+        fill.entry = nullptr;
+        return Result(true); // Just serve it from disk
+    }
+    filling = candidate;
+    return Result(true);
+}
+
+Result HttpAsyncFileServer::Internal::readCacheFill(Stream::CacheFill& fill)
+{
+    // Runs on a ThreadPool thread, touching only the slot of an entry that is pinned and not served yet
+    SC_TRY(readWholeFile(fill.path.view(), {fill.slot.data(), fill.fileSize}));
+    if (fill.gzipSize > 0 and readWholeFile(fill.gzipPath.view(), {fill.slot.data() + fill.fileSize, fill.gzipSize}))
+    {
+        fill.gzipRead = true;
+    }
+    return Result(true);
+}
+
+void HttpAsyncFileServer::Internal::finishCacheFill(Stream::CacheFill& fill, AsyncLoopWork::Result& result)
+{
+    CacheEntry& entry   = *fill.entry;
+    const bool  dropped = not entry.filling; // Invalidated or evicted while reading
+    entry.filling       = false;
+    entry.pins--;
+    fill.entry = nullptr;
+    fill.work.disableThreadPool();
+    if (dropped)
+    {
+        return;
+    }
+    if (not result.isValid())
+    {
+        fill.cache->drop(entry); // File changed or vanished in the meantime
+        return;
+    }
+    if (fill.gzipRead)
+    {
+        entry.gzipSize = fill.gzipSize;
+    }
+    entry.valid = true;
+    fill.cache->statistics.fills++;
+}
+
+Result HttpAsyncFileServer::Internal::readWholeFile(StringSpan path, Span<char> destination)
+{
+    FileDescriptor fd;
+    SC_TRY(fd.open(path, FileOpen::Read));
+    Span<char> actuallyRead;
+    SC_TRY(fd.readUntilFullOrEOF(destination, actuallyRead));
+    SC_TRY_MSG(actuallyRead.sizeInBytes() == destination.sizeInBytes(), "HttpAsyncFileServerCache - short read");
+    return fd.close();
+}
+
+Result HttpAsyncFileServer::Internal::pinCacheEntry(Stream& stream, HttpConnection& connection, CacheEntry& entry)
+{
+    SC_TRY_MSG(stream.cacheEntry == nullptr, "HttpAsyncFileServer - Stream already holds a cache entry");
+    // Writes still queued when the connection is closed are dropped without calling their callbacks
+    stream.cacheListener.stream     = &stream;
+    stream.cacheListener.connection = &connection;
+    const bool addedCloseListener =
+        connection.writableSocketStream.eventClose
+            .addListener<Stream::CacheListener, &Stream::CacheListener::onConnectionClose>(stream.cacheListener);
+    SC_TRY_MSG(addedCloseListener, "HttpAsyncFileServer - Cannot listen to connection close");
+    entry.pins++;
+    stream.cacheEntry = &entry;
+    return Result(true);
+}
+
+void HttpAsyncFileServer::Internal::releaseCacheEntry(Stream& stream)
+{
+    CacheEntry* entry = stream.cacheEntry;
+    if (entry == nullptr)
+    {
+        return;
+    }
+    (void)stream.cacheListener.connection->writableSocketStream.eventClose
+        .removeListener<Stream::CacheListener, &Stream::CacheListener::onConnectionClose>(stream.cacheListener);
+    Stream::CacheWritableStream& cacheWritable = stream.cacheWritable;
+    if (not cacheWritable.destination.empty())
+    {
+        // Storing compressed output ends here, successfully or not
+        (void)cacheWritable.eventFinish.removeListener<Stream::CacheListener, &Stream::CacheListener::onGZipStored>(
+            stream.cacheListener);
+        cacheWritable.destination = {};
+        cacheWritable.overflow    = true;
+        entry->compressing        = false;
+    }
+    entry->pins--;
+    stream.cacheEntry            = nullptr;
+    stream.byteRanges.cachedData = nullptr;
+}
+
+Result HttpAsyncFileServer::Internal::sendCachedBody(Stream& stream, HttpConnection& connection, CacheEntry& entry,
+                                                     Span<const char> body)
+{
+    if (body.sizeInBytes() > 0)
+    {
+        // Pinned entries are not evicted while the socket is still reading their bytes
+        SC_TRY(pinCacheEntry(stream, connection, entry));
+        const Result res = connection.response.getWritableStream().write(
+            AsyncBufferView(body), [&stream](AsyncBufferView::ID) { releaseCacheEntry(stream); });
+        if (not res)
+        {
+            releaseCacheEntry(stream);
+            return res;
+        }
+    }
+    return connection.response.end();
+}
+
+bool HttpAsyncFileServer::Internal::prepareGZipStore(Stream& stream, HttpConnection& connection,
+                                                     HttpAsyncFileServerCache& cache, CacheEntry& entry)
+{
+    if (entry.gzipSize > 0 or entry.compressing or entry.fileSize >= cache.slotSize)
+    {
+        return false; // Already stored, being stored by another connection or no space left in the slot
+    }
+    Stream::CacheWritableStream& cacheWritable = stream.cacheWritable;
+    if (not cacheWritable.init(connection.buffersPool) or not pinCacheEntry(stream, connection, entry))
+    {
+        return false;
+    }
+    Span<char>       slot      = cache.getSlot(entry);
+    cacheWritable.destination  = {slot.data() + entry.fileSize, cache.slotSize - entry.fileSize};
+    cacheWritable.writtenBytes = 0;
+    cacheWritable.overflow     = false;
+    if (not cacheWritable.eventFinish.addListener<Stream::CacheListener, &Stream::CacheListener::onGZipStored>(
+            stream.cacheListener))
+    {
+        releaseCacheEntry(stream);
+        return false;
+    }
+    entry.compressing = true;
+    return true;
+}
+
+void HttpAsyncFileServer::Internal::storeGZip(Stream& stream)
 {
-    char   bufferData[128];
-    size_t len;
-    SC_TRY(formatHttpDate(millisecondsSinceEpoch, bufferData, sizeof(bufferData), len));
+    CacheEntry&                  entry         = *stream.cacheEntry;
+    Stream::CacheWritableStream& cacheWritable = stream.cacheWritable;
 
-    SC_TRY(response.addHeader(headerName, {{bufferData, len}, true, StringEncoding::Ascii}));
+    const size_t size = cacheWritable.writtenBytes;
+    // 18 bytes are gzip header and trailer, that ends with the uncompressed size (modulo 2^32), telling apart
+    // the output of a response that has been interrupted before compressing the entire file
+    if ((entry.valid or entry.filling) and not cacheWritable.overflow and size >= 18 and size < entry.fileSize)
+    {
+        const uint8_t* trailer = reinterpret_cast<const uint8_t*>(cacheWritable.destination.data() + size - 4);
+        const uint32_t inputSize =
+            uint32_t(trailer[0]) | uint32_t(trailer[1]) << 8 | uint32_t(trailer[2]) << 16 | uint32_t(trailer[3]) << 24;
+        const StringSpan etag = {{entry.etag, entry.etagLength}, false, StringEncoding::Ascii};
+        if (inputSize == static_cast<uint32_t>(entry.fileSize) and
+            formatGZipETag(etag, entry.gzipETag, sizeof(entry.gzipETag), entry.gzipETagLength))
+        {
+            entry.gzipSize = size;
+        }
+    }
+    releaseCacheEntry(stream);
+}
+
+void HttpAsyncFileServer::Stream::CacheListener::onConnectionClose() { Internal::releaseCacheEntry(*stream); }
+
+void HttpAsyncFileServer::Stream::CacheListener::onGZipStored() { Internal::storeGZip(*stream); }
+
+Result HttpAsyncFileServer::Stream::CacheWritableStream::asyncWrite(AsyncBufferView::ID                 bufferID,
+                                                                    Function<void(AsyncBufferView::ID)> cb)
+{
+    Span<const char> data;
+    SC_TRY(getBuffersPool().getReadableData(bufferID, data));
+    if (not overflow and data.sizeInBytes() <= destination.sizeInBytes() - writtenBytes)
+    {
+        ::memcpy(destination.data() + writtenBytes, data.data(), data.sizeInBytes());
+        writtenBytes += data.sizeInBytes();
+    }
+    else
+    {
+        overflow = true; // Compressed output larger than the slot space
+    }
+    finishedWriting(bufferID, move(cb), Result(true));
     return Result(true);
 }
 
@@ -963,6 +1924,10 @@ void HttpAsyncFileServer::Stream::MultipartListener::onData(AsyncBufferView::ID
             case HttpMultipartParser::Token::PartHeaderEnd: {
                 if (partHeaders.isSafeFile())
                 {
+                    if (server->options.cache != nullptr)
+                    {
+                        server->options.cache->invalidate(partHeaders.fileName());
+                    }
                     (void)currentFilePath.assign(server->directory.view());
                     (void)currentFilePath.append("/");
                     (void)currentFilePath.append(partHeaders.fileName());
@@ -3,12 +3,108 @@
 #pragma once
 #include "../Async/Async.h"
 #include "../AsyncStreams/AsyncRequestStreams.h"
+#include "../AsyncStreams/ZLibTransformStreams.h"
 #include "HttpConnection.h"
 #include "HttpExport.h"
 #include "HttpMultipartParser.h"
 
 namespace SC
 {
+/// @brief Bounded in-memory cache of small files served by HttpAsyncFileServer
+///
+/// Entries and memory are provided by the caller. Memory is split in equally sized slots, one for each entry, and only
+/// files fitting a slot are cached. The remaining slot space holds the gzip representation, read from a `.gz` sibling
+/// or stored while sending the first response compressed on the fly (HttpAsyncFileServerOptions::compressResponses).
+/// Files are read into their slot on the ThreadPool passed to HttpAsyncFileServer::init, that must have worker threads,
+/// and requests are served from disk until the entry is ready.
+/// A cache hit is answered from memory with precomputed ETag, Last-Modified and MIME type, so that the socket write is
+/// the only system call.
+/// When all entries are in use, the least recently used one that is not being written to a connection is replaced.
+///
+/// Cached files are checked again with a single `stat` when older than revalidateIntervalMs.
+/// Applications already watching the served directory with FileSystemWatcher can disable revalidation and call
+/// HttpAsyncFileServerCache::invalidate from the watcher callback instead.
+struct SC_HTTP_EXPORT HttpAsyncFileServerCache
+{
+    /// @brief Storage for a single cached file (fields are managed by HttpAsyncFileServer)
+    struct Entry
+    {
+        static constexpr size_t MaxPathLength = 255;
+
+        char       path[MaxPathLength + 1];
+        char       etag[48];
+        char       gzipETag[64];
+        char       lastModified[32];
+        StringSpan contentType;
+
+        size_t   pathLength         = 0;
+        size_t   etagLength         = 0;
+        size_t   gzipETagLength     = 0;
+        size_t   lastModifiedLength = 0;
+        size_t   fileSize           = 0;
+        size_t   gzipSize           = 0;
+        int64_t  modifiedTime       = 0;
+        int64_t  validatedTime      = 0;
+        uint64_t lastUse            = 0;
+        uint32_t pathHash           = 0;
+        uint32_t pins               = 0;
+        bool     valid              = false;
+        bool     filling            = false; // Being read from disk on the ThreadPool
+        bool     compressing        = false; // Receiving the output of a response compressed on the fly
+    };
+
+    /// @brief Counters describing cache effectiveness
+    struct Statistics
+    {
+        uint64_t hits          = 0; ///< Requests served from memory
+        uint64_t misses        = 0; ///< Requests that had to stat the file
+        uint64_t evictions     = 0; ///< Valid entries replaced by a different file
+        uint64_t invalidations = 0; ///< Entries dropped by invalidate or by a failed revalidation
+        uint64_t fills         = 0; ///< Entries read from disk and ready to be served
+    };
+
+    /// @brief Milliseconds (of event loop time) after which a cached file is checked again with a `stat`.
+    /// Zero checks on every hit, a negative value never checks and leaves invalidation to the application.
+    int64_t revalidateIntervalMs = 1000;
+
+    /// @brief Assigns entries and memory used by the cache. Both must outlive all file servers using it.
+    /// @param entries Caller-owned entries defining maximum number of cached files
+    /// @param memory Caller-owned memory, split in `memory.sizeInBytes() / entries.sizeInElements()` bytes slots
+    Result init(Span<Entry> entries, Span<char> memory);
+
+    /// @brief Releases references to entries and memory. Fails if some entry is still being written to a connection.
+    Result close();
+
+    /// @brief Drops the cached entry for a path relative to the served directory (for example from a
+    /// FileSystemWatcher notification). Invalidating a `.gz` sibling also drops the uncompressed entry.
+    void invalidate(StringSpan filePath);
+
+    /// @brief Drops all cached entries
+    void invalidateAll();
+
+    /// @brief Returns the maximum number of bytes that a single entry can hold
+    [[nodiscard]] size_t getSlotSize() const { return slotSize; }
+
+    /// @brief Returns hit / miss counters
+    [[nodiscard]] const Statistics& getStatistics() const { return statistics; }
+
+  private:
+    friend struct HttpAsyncFileServer;
+
+    Span<Entry> entries;
+    Span<char>  memory;
+    size_t      slotSize   = 0;
+    uint64_t    useCounter = 0;
+    Statistics  statistics;
+
+    static uint32_t hashPath(StringSpan filePath);
+
+    Entry*     find(StringSpan filePath);
+    Entry*     acquire();
+    Span<char> getSlot(const Entry& entry);
+    void       drop(Entry& entry);
+};
+
 /// @brief Options controlling optional HttpAsyncFileServer semantics.
 struct SC_HTTP_EXPORT HttpAsyncFileServerOptions
 {
@@ -32,6 +128,21 @@ struct SC_HTTP_EXPORT HttpAsyncFileServerOptions
 
     /// @brief Rejects Content-Length uploads larger than this value. Zero means unlimited.
     size_t maxUploadBytes = 0;
+
+    /// @brief Optional in-memory cache for small files. The cache must outlive the file server.
+    HttpAsyncFileServerCache* cache = nullptr;
+
+    /// @brief Serves a `.gz` sibling (not older than the file) to clients accepting gzip (default: true).
+    bool serveGZipSiblings = true;
+
+    /// @brief Compresses text-like files without a `.gz` sibling on the fly with gzip (default: false).
+    /// Compression runs on the ThreadPool passed to HttpAsyncFileServer::init, that must have worker threads.
+    /// Responses are sent with chunked transfer encoding, as their length is not known in advance, unless the output
+    /// of a previous one has been stored in HttpAsyncFileServerOptions::cache.
+    bool compressResponses = false;
+
+    /// @brief Files smaller than this are not compressed on the fly (default: 1024 bytes)
+    size_t compressionMinBytes = 1024;
 };
 
 /// @brief Http file server statically serves files from a directory
@@ -60,6 +171,60 @@ struct SC_HTTP_EXPORT HttpAsyncFileServer
         size_t              fileSendOffset = 0;
         size_t              fileSendLength = 0;
 
+        AsyncZLibTransformStreamT<AsyncEventLoop> compressor; // Used by HttpAsyncFileServerOptions::compressResponses
+
+        /// @brief Parts of a `multipart/byteranges` response, sent one after the other with AsyncFileSend
+        struct ByteRanges
+        {
+            static constexpr size_t MaxRanges       = 8;
+            static constexpr size_t HeadersCapacity = 1536;
+
+            size_t offsets[MaxRanges];
+            size_t lengths[MaxRanges];
+            size_t headersEnd[MaxRanges + 1]; // End of each part headers in `headers`, last is the closing delimiter
+            char   headers[HeadersCapacity];
+            size_t numRanges = 0;
+            size_t current   = 0;
+
+            const char* cachedData = nullptr;
+        } byteRanges;
+
+        /// @brief Reads a file (and its `.gz` sibling) into a cache entry slot on the ThreadPool
+        struct CacheFill
+        {
+            AsyncLoopWork                    work;
+            HttpAsyncFileServerCache*        cache = nullptr;
+            HttpAsyncFileServerCache::Entry* entry = nullptr;
+            StringPath                       path;
+            StringPath                       gzipPath;
+            Span<char>                       slot;
+            size_t                           fileSize = 0;
+            size_t                           gzipSize = 0;
+            bool                             gzipRead = false;
+        } cacheFill;
+
+        /// @brief Stores the output of the compressor in the gzip part of a cache entry slot
+        struct CacheWritableStream : public AsyncWritableStream
+        {
+            Span<char> destination;
+            size_t     writtenBytes = 0;
+            bool       overflow     = false;
+
+          protected:
+            virtual Result asyncWrite(AsyncBufferView::ID bufferID, Function<void(AsyncBufferView::ID)> cb) override;
+        } cacheWritable;
+
+        HttpAsyncFileServerCache::Entry* cacheEntry = nullptr; // Pinned while sending from (or storing into) its slot
+
+        struct CacheListener
+        {
+            Stream*         stream     = nullptr;
+            HttpConnection* connection = nullptr;
+
+            void onConnectionClose(); // Queued writes are dropped without calling their callbacks
+            void onGZipStored();
+        } cacheListener;
+
         struct MultipartListener
         {
             HttpAsyncFileServer* server     = nullptr;
@@ -92,9 +257,15 @@ struct SC_HTTP_EXPORT HttpAsyncFileServer
         {
             readableFileStream.setReadQueue(readQueue);
             writableFileStream.setWriteQueue(writeQueue);
+            compressor.setReadQueue(compressorReadQueue);
+            compressor.setWriteQueue(compressorWriteQueue);
+            cacheWritable.setWriteQueue(cacheWriteQueue);
         }
         AsyncReadableStream::Request readQueue[RequestsSize];
         AsyncWritableStream::Request writeQueue[RequestsSize];
+        AsyncReadableStream::Request compressorReadQueue[RequestsSize];
+        AsyncWritableStream::Request compressorWriteQueue[RequestsSize];
+        AsyncWritableStream::Request cacheWriteQueue[RequestsSize];
     };
 
     /// @brief Initialize the web server on the given file system directory to serve
@@ -119,13 +290,15 @@ struct SC_HTTP_EXPORT HttpAsyncFileServer
   private:
     bool                       useAsyncFileSend = true;
     HttpAsyncFileServerOptions options          = {};
+    uint64_t                   byteRangesCount  = 0;
 
     Result putFile(HttpAsyncFileServer::Stream& stream, HttpConnection& connection, StringSpan filePath);
     Result getFile(HttpAsyncFileServer::Stream& stream, HttpConnection& connection, StringSpan filePath, bool sendBody,
                    bool allowSpaFallback);
     Result postMultipart(HttpAsyncFileServer::Stream& stream, HttpConnection& connection);
 
-    StringPath directory;
+    StringPath     directory;
+    HttpDateHeader dateHeader;
 
     AsyncEventLoop* eventLoop  = nullptr;
     ThreadPool*     threadPool = nullptr;
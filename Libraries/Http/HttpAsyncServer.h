@@ -87,6 +87,13 @@ struct SC_HTTP_EXPORT HttpAsyncServer
     /// @brief Gets the maximum accepted request-header size in bytes.
     [[nodiscard]] uint32_t getMaxHeaderSize() const { return maxHeaderSize; }
 
+    /// @brief Sets options applied to the listening socket by start() (before binding and listening).
+    /// Accepted connections inherit options like buffer sizes and TCP_NODELAY from the listening socket.
+    void setSocketOptions(const SocketOptions& options) { socketOptions = options; }
+
+    /// @brief Gets options applied to the listening socket
+    [[nodiscard]] const SocketOptions& getSocketOptions() const { return socketOptions; }
+
     /// @brief Sets an optional transport setup hook invoked after accepting TCP and before HTTP reads request bytes.
     void setTransportSetup(Function<Result(HttpAsyncServerTransportSetup&)>&& setup) { transportSetup = move(setup); }
 
@@ -131,6 +138,8 @@ struct SC_HTTP_EXPORT HttpAsyncServer
 
     uint32_t maxHeaderSize = 8 * 1024;
 
+    SocketOptions socketOptions;
+
     Function<Result(HttpAsyncServerTransportSetup&)> transportSetup;
     Function<void(HttpConnection&)>                  transportClose;
 
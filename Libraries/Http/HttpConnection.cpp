@@ -8,6 +8,11 @@
 #include "Internal/HttpFixedBufferWriter.inl"
 #include "Internal/HttpParsedHeaders.inl"
 
+#include <time.h>
+#if SC_PLATFORM_WINDOWS
+#include <sys/timeb.h>
+#endif
+
 namespace
 {
 static bool scHttpHexValue(char current, uint8_t& value)
@@ -1004,12 +1009,33 @@ Result HttpOutgoingMessage::addContentLength(uint64_t value)
     SC_TRY_MSG(responseHeaders.writtenBytes() != 0, "startResponse or startRequest must be the first call");
     SC_TRY_MSG(not chunkedTransferEncodingEnabled and not transferEncodingAdded,
                "HttpOutgoingMessage does not support Content-Length with Transfer-Encoding");
-    SC_TRY(responseHeaders.appendContentLength(value, "HttpOutgoingMessage::appendAscii - header space is finished",
-                                               "HttpOutgoingMessage failed formatting Content-Length"));
+    SC_TRY(responseHeaders.appendContentLength(value, "HttpOutgoingMessage::appendAscii - header space is finished"));
     contentLengthAdded = true;
     return Result(true);
 }
 
+Result HttpOutgoingMessage::addCachedHeaders(const HttpCachedHeaders& headers)
+{
+    SC_TRY_MSG(not headersSent, "Headers already sent");
+    SC_TRY_MSG(responseHeaders.writtenBytes() != 0, "startResponse or startRequest must be the first call");
+    SC_TRY(responseHeaders.append(headers.getBlock(), "HttpOutgoingMessage::appendAscii - header space is finished"));
+    hostHeaderAdded      = hostHeaderAdded or headers.hostHeaderAdded;
+    userAgentHeaderAdded = userAgentHeaderAdded or headers.userAgentHeaderAdded;
+    contentTypeAdded     = contentTypeAdded or headers.contentTypeAdded;
+    contentEncodingAdded = contentEncodingAdded or headers.contentEncodingAdded;
+    acceptEncodingAdded  = acceptEncodingAdded or headers.acceptEncodingAdded;
+    return Result(true);
+}
+
+Result HttpOutgoingMessage::addDateHeader(const HttpDateHeader& dateHeader)
+{
+    SC_TRY_MSG(not headersSent, "Headers already sent");
+    SC_TRY_MSG(responseHeaders.writtenBytes() != 0, "startResponse or startRequest must be the first call");
+    SC_TRY_MSG(dateHeader.getHeaderLine().sizeInBytes() > 0, "HttpOutgoingMessage::addDateHeader - Date not rendered");
+    return responseHeaders.append(dateHeader.getHeaderLine(),
+                                  "HttpOutgoingMessage::appendAscii - header space is finished");
+}
+
 Result HttpOutgoingMessage::setChunkedTransferEncoding()
 {
     SC_TRY_MSG(not headersSent, "Headers already sent");
@@ -1092,6 +1118,132 @@ Result HttpOutgoingMessage::end()
 
 void HttpOutgoingMessage::setKeepAlive(bool value) { keepAlive = value; }
 
+//-------------------------------------------------------------------------------------------------------
+// HttpCachedHeaders
+//-------------------------------------------------------------------------------------------------------
+void HttpCachedHeaders::reset(Span<char> memory)
+{
+    writer.reset(memory);
+    hostHeaderAdded      = false;
+    userAgentHeaderAdded = false;
+    contentTypeAdded     = false;
+    contentEncodingAdded = false;
+    acceptEncodingAdded  = false;
+}
+
+Result HttpCachedHeaders::addHeader(StringSpan headerName, StringSpan headerValue)
+{
+    SC_TRY_MSG(not HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Connection")) and
+                   not HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Content-Length")) and
+                   not HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Transfer-Encoding")),
+               "HttpCachedHeaders::addHeader - framing headers cannot be cached");
+    for (char current : headerValue.toCharSpan())
+    {
+        SC_TRY_MSG(current != '\r' and current != '\n', "HttpCachedHeaders::addHeader - value contains CR or LF");
+    }
+    SC_TRY(writer.appendHeader(headerName, headerValue, "HttpCachedHeaders::addHeader - header space is finished"));
+    if (HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Host")))
+    {
+        hostHeaderAdded = true;
+    }
+    else if (HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("User-Agent")))
+    {
+        userAgentHeaderAdded = true;
+    }
+    else if (HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Content-Type")))
+    {
+        contentTypeAdded = true;
+    }
+    else if (HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Content-Encoding")))
+    {
+        contentEncodingAdded = true;
+    }
+    else if (HttpStringIterator::equalsIgnoreCase(headerName, StringSpan("Accept-Encoding")))
+    {
+        acceptEncodingAdded = true;
+    }
+    return Result(true);
+}
+
+//-------------------------------------------------------------------------------------------------------
+// HttpDateHeader
+//-------------------------------------------------------------------------------------------------------
+Result HttpDateHeader::start(AsyncEventLoop& loop)
+{
+    SC_TRY_MSG(eventLoop == nullptr, "HttpDateHeader::start - already started");
+    SC_TRY(update(getCurrentTimeMilliseconds()));
+    timeout.callback.bind<HttpDateHeader, &HttpDateHeader::onTimeout>(*this);
+    timeout.setDebugName("HttpDateHeader");
+    SC_TRY(timeout.start(loop, TimeMs{1000}));
+    loop.excludeFromActiveCount(timeout);
+    eventLoop = &loop;
+    return Result(true);
+}
+
+Result HttpDateHeader::stop()
+{
+    SC_TRY_MSG(eventLoop != nullptr, "HttpDateHeader::stop - not started");
+    AsyncEventLoop& loop = *eventLoop;
+    eventLoop            = nullptr;
+    if (not timeout.isFree())
+    {
+        SC_TRY(timeout.stop(loop));
+    }
+    return Result(true);
+}
+
+void HttpDateHeader::onTimeout(AsyncLoopTimeout::Result& result)
+{
+    (void)update(getCurrentTimeMilliseconds());
+    // Re-align to the next wall clock second, so that the value is never more than one second stale
+    const int64_t nextSecond = 1000 - getCurrentTimeMilliseconds() % 1000;
+    timeout.relativeTimeout  = TimeMs{nextSecond > 0 ? nextSecond : 1000};
+    result.reactivateRequest(eventLoop != nullptr);
+}
+
+Result HttpDateHeader::update(int64_t millisecondsSinceEpoch)
+{
+    const int64_t second = millisecondsSinceEpoch / 1000;
+    if (lineLength > 0 and second == renderedSecond)
+    {
+        return Result(true);
+    }
+    static constexpr const char* OutOfSpace = "HttpDateHeader::update - insufficient space";
+
+    HttpFixedBufferWriter writer;
+    writer.reset(line);
+    SC_TRY(writer.appendLiteral("Date: ", OutOfSpace));
+    SC_TRY(writer.appendHttpDate(millisecondsSinceEpoch, OutOfSpace));
+    SC_TRY(writer.appendLiteral("\r\n", OutOfSpace));
+    lineLength     = writer.writtenBytes();
+    renderedSecond = second;
+    return Result(true);
+}
+
+StringSpan HttpDateHeader::getValue() const
+{
+    if (lineLength == 0)
+    {
+        return {};
+    }
+    return {{line + 6, HttpFixedBufferWriter::HttpDateLength}, false, StringEncoding::Ascii};
+}
+
+int64_t HttpDateHeader::getCurrentTimeMilliseconds()
+{
+#if SC_PLATFORM_WINDOWS
+    struct _timeb t;
+    _ftime_s(&t);
+    return static_cast<int64_t>(t.time) * 1000 + t.millitm;
+#else
+    struct timespec nowTimeSpec;
+    clock_gettime(CLOCK_REALTIME, &nowTimeSpec);
+    constexpr int64_t nanosecondsToMilliseconds = 1000 * 1000;
+    return static_cast<int64_t>(nowTimeSpec.tv_sec) * 1000 +
+           static_cast<int64_t>(nowTimeSpec.tv_nsec) / nanosecondsToMilliseconds;
+#endif
+}
+
 //-------------------------------------------------------------------------------------------------------
 // HttpResponse
 //-------------------------------------------------------------------------------------------------------
@@ -1136,12 +1288,8 @@ Result HttpResponse::startResponse(int code, StringSpan reasonPhrase)
         SC_TRY_MSG(current != '\r' and current != '\n', "HttpResponse reason phrase must not contain CR or LF");
     }
 
-    char      codeBuffer[4];
-    const int len = ::snprintf(codeBuffer, sizeof(codeBuffer), "%d", code);
-    SC_TRY_MSG(len == 3, "HttpResponse failed formatting status code");
-
     SC_TRY(responseHeaders.appendLiteral("HTTP/1.1 ", HeaderSpaceFinished));
-    SC_TRY(responseHeaders.append({codeBuffer, 3}, HeaderSpaceFinished));
+    SC_TRY(responseHeaders.appendDecimal(static_cast<uint64_t>(code), HeaderSpaceFinished));
     SC_TRY(responseHeaders.appendLiteral(" ", HeaderSpaceFinished));
     SC_TRY(responseHeaders.append(reasonPhrase, HeaderSpaceFinished));
     SC_TRY(responseHeaders.appendLiteral("\r\n", HeaderSpaceFinished));
@@ -1362,8 +1510,7 @@ Result HttpAsyncClientRequest::sendHeaders(Function<void(AsyncBufferView::ID)> c
     const bool hasBody = bodyType != BodyType::None;
     if (hasBody and not chunkedTransferEncodingEnabled and not hasHeader(KnownHeader::ContentLength))
     {
-        SC_TRY(responseHeaders.appendContentLength(contentLength, HeaderSpaceFinished,
-                                                   "HttpAsyncClientRequest failed formatting Content-Length"));
+        SC_TRY(responseHeaders.appendContentLength(contentLength, HeaderSpaceFinished));
         contentLengthAdded = true;
     }
 
@@ -266,6 +266,72 @@ struct SC_HTTP_EXPORT HttpAsyncClientResponse : public HttpIncomingMessage
     BodyStream& rawBodyStream() { return bodyStream; }
 };
 
+/// @brief Immutable block of pre-rendered header lines appended to outgoing messages with a single copy
+///
+/// Render constant headers (`Server`, `Content-Type`, `Cache-Control` etc.) once into caller-provided memory and
+/// append them to any message with HttpOutgoingMessage::addCachedHeaders.
+/// Framing headers (`Connection`, `Content-Length`, `Transfer-Encoding`) are rejected as they belong to each message.
+struct SC_HTTP_EXPORT HttpCachedHeaders
+{
+    /// @brief Clears all rendered headers and assigns the memory where they will be rendered
+    /// @warning The memory must outlive all messages where this block will be appended
+    void reset(Span<char> memory);
+
+    /// @brief Renders a `name: value` header line at the end of the block
+    Result addHeader(StringSpan headerName, StringSpan headerValue);
+
+    /// @brief Returns all header lines rendered so far
+    [[nodiscard]] Span<const char> getBlock() const { return writer.written(); }
+
+  private:
+    friend struct HttpOutgoingMessage;
+    HttpFixedBufferWriter writer;
+
+    bool hostHeaderAdded      = false;
+    bool userAgentHeaderAdded = false;
+    bool contentTypeAdded     = false;
+    bool contentEncodingAdded = false;
+    bool acceptEncodingAdded  = false;
+};
+
+/// @brief Caches the `Date` header line, rendering it again only when the current second changes
+///
+/// A started HttpDateHeader refreshes itself once per second with a periodic AsyncLoopTimeout, so that all responses
+/// created on the same event loop can append the `Date` header with HttpOutgoingMessage::addDateHeader.
+/// The timeout is excluded from the loop active count, so it will not keep AsyncEventLoop::run alive.
+struct SC_HTTP_EXPORT HttpDateHeader
+{
+    /// @brief Renders current time and starts refreshing it once per second on the given loop
+    Result start(AsyncEventLoop& loop);
+
+    /// @brief Stops refreshing the cached value
+    Result stop();
+
+    /// @brief Returns true if start has been called successfully and stop has not been called yet
+    [[nodiscard]] bool isStarted() const { return eventLoop != nullptr; }
+
+    /// @brief Renders the given time, unless it falls within the same second that has already been rendered
+    Result update(int64_t millisecondsSinceEpoch);
+
+    /// @brief Returns the cached date value, for example `Wed, 21 Oct 2015 07:28:00 GMT`
+    [[nodiscard]] StringSpan getValue() const;
+
+    /// @brief Returns the full cached header line, for example `Date: Wed, 21 Oct 2015 07:28:00 GMT\r\n`
+    [[nodiscard]] Span<const char> getHeaderLine() const { return {line, lineLength}; }
+
+    /// @brief Returns current wall clock time as milliseconds since unix epoch
+    [[nodiscard]] static int64_t getCurrentTimeMilliseconds();
+
+  private:
+    void onTimeout(AsyncLoopTimeout::Result& result);
+
+    AsyncLoopTimeout timeout;
+    AsyncEventLoop*  eventLoop      = nullptr;
+    int64_t          renderedSecond = 0;
+    size_t           lineLength     = 0;
+    char             line[40]       = {0};
+};
+
 /// @brief Outgoing message from the perspective of the participants of an HTTP transaction
 struct SC_HTTP_EXPORT HttpOutgoingMessage
 {
@@ -306,6 +372,13 @@ struct SC_HTTP_EXPORT HttpOutgoingMessage
     /// @brief Adds a formatted `Content-Length` header without caller-side temporary formatting.
     Result addContentLength(uint64_t value);
 
+    /// @brief Appends a block of pre-rendered headers with a single copy
+    /// @warning The HttpCachedHeaders memory must stay valid until headers have been sent
+    Result addCachedHeaders(const HttpCachedHeaders& headers);
+
+    /// @brief Appends the `Date` header line cached by the given HttpDateHeader
+    Result addDateHeader(const HttpDateHeader& dateHeader);
+
     /// @brief Enables chunked transfer-encoding for subsequent body writes
     Result setChunkedTransferEncoding();
 
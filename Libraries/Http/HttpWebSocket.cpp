@@ -77,10 +77,47 @@ static bool scHttpWebSocketRequiresOutgoingMask(SC::HttpWebSocketEndpointRole en
 
 static void scHttpWebSocketApplyMask(SC::Span<char> payload, const uint8_t maskKey[4], uint64_t payloadOffset)
 {
-    for (size_t idx = 0; idx < payload.sizeInBytes(); ++idx)
+    // Rotate the key so that its first byte applies to payload[0], and repeat it to fill a 64 bit word.
+    // Building the word from memory order makes it independent from endianness.
+    uint8_t rotatedKey[8];
+    for (size_t idx = 0; idx < 8; ++idx)
     {
-        payload[idx] = static_cast<char>(static_cast<uint8_t>(payload[idx]) ^ maskKey[(payloadOffset + idx) & 3]);
+        rotatedKey[idx] = maskKey[(payloadOffset + idx) & 3];
     }
+    uint64_t maskWord;
+    ::memcpy(&maskWord, rotatedKey, sizeof(maskWord));
+
+    char*        data = payload.data();
+    const size_t size = payload.sizeInBytes();
+    size_t       idx  = 0;
+    // 32 bytes per iteration, that compilers turn into 16 / 32 bytes vector XORs
+    for (; idx + 32 <= size; idx += 32)
+    {
+        uint64_t words[4];
+        ::memcpy(words, data + idx, sizeof(words));
+        words[0] ^= maskWord;
+        words[1] ^= maskWord;
+        words[2] ^= maskWord;
+        words[3] ^= maskWord;
+        ::memcpy(data + idx, words, sizeof(words));
+    }
+    for (; idx + 8 <= size; idx += 8)
+    {
+        uint64_t word;
+        ::memcpy(&word, data + idx, sizeof(word));
+        word ^= maskWord;
+        ::memcpy(data + idx, &word, sizeof(word));
+    }
+    for (; idx < size; ++idx)
+    {
+        data[idx] = static_cast<char>(static_cast<uint8_t>(data[idx]) ^ rotatedKey[idx & 3]);
+    }
+}
+
+static bool scHttpWebSocketIsDeflateTail(const char* data)
+{
+    return data[0] == 0 and data[1] == 0 and static_cast<uint8_t>(data[2]) == 0xFF and
+           static_cast<uint8_t>(data[3]) == 0xFF;
 }
 
 static bool scHttpWebSocketEqualsIgnoreCase(SC::StringSpan lhs, SC::StringSpan rhs)
@@ -105,6 +142,126 @@ static SC::StringSpan scHttpWebSocketTrim(SC::StringSpan value)
     return {{start, static_cast<size_t>(end - start)}, false, value.getEncoding()};
 }
 
+// Splits value at the first separator, returning the trimmed part before it and leaving the rest in value
+static SC::StringSpan scHttpWebSocketSplit(SC::StringSpan& value, char separator)
+{
+    const char* start = value.bytesWithoutTerminator();
+    const char* end   = start + value.sizeInBytes();
+    const char* it    = start;
+    while (it < end and *it != separator)
+    {
+        it++;
+    }
+    const SC::StringSpan part =
+        scHttpWebSocketTrim({{start, static_cast<size_t>(it - start)}, false, value.getEncoding()});
+    if (it < end)
+    {
+        it++;
+    }
+    value = {{it, static_cast<size_t>(end - it)}, false, value.getEncoding()};
+    return part;
+}
+
+static bool scHttpWebSocketParseWindowBits(SC::StringSpan value, uint8_t& windowBits)
+{
+    const char* data = value.bytesWithoutTerminator();
+    size_t      size = value.sizeInBytes();
+    if (size >= 2 and data[0] == '"' and data[size - 1] == '"')
+    {
+        data += 1;
+        size -= 2;
+    }
+    if (size == 0 or size > 2)
+    {
+        return false;
+    }
+    uint32_t number = 0;
+    for (size_t idx = 0; idx < size; ++idx)
+    {
+        if (data[idx] < '0' or data[idx] > '9')
+        {
+            return false;
+        }
+        number = number * 10 + static_cast<uint32_t>(data[idx] - '0');
+    }
+    // RFC 7692 allows 8, but zlib raw deflate streams support windows from 9 to 15 only
+    if (number < 9 or number > 15)
+    {
+        return false;
+    }
+    windowBits = static_cast<uint8_t>(number);
+    return true;
+}
+
+// Parses a single permessage-deflate extension (name followed by ';' separated parameters)
+static bool scHttpWebSocketParseDeflate(SC::StringSpan extension, bool isResponse,
+                                        SC::HttpWebSocketDeflateParameters& parameters)
+{
+    if (not scHttpWebSocketEqualsIgnoreCase(scHttpWebSocketSplit(extension, ';'), "permessage-deflate"))
+    {
+        return false;
+    }
+    enum : uint32_t
+    {
+        ServerNoContextTakeover = 1 << 0,
+        ClientNoContextTakeover = 1 << 1,
+        ServerMaxWindowBits     = 1 << 2,
+        ClientMaxWindowBits     = 1 << 3,
+    };
+    uint32_t seen = 0;
+    while (not extension.isEmpty())
+    {
+        SC::StringSpan       value = scHttpWebSocketSplit(extension, ';');
+        const SC::StringSpan name  = scHttpWebSocketSplit(value, '=');
+        value                      = scHttpWebSocketTrim(value);
+
+        uint32_t parameter = 0;
+        if (scHttpWebSocketEqualsIgnoreCase(name, "server_no_context_takeover") and value.isEmpty())
+        {
+            parameter                          = ServerNoContextTakeover;
+            parameters.serverNoContextTakeover = true;
+        }
+        else if (scHttpWebSocketEqualsIgnoreCase(name, "client_no_context_takeover") and value.isEmpty())
+        {
+            parameter                          = ClientNoContextTakeover;
+            parameters.clientNoContextTakeover = true;
+        }
+        else if (scHttpWebSocketEqualsIgnoreCase(name, "server_max_window_bits"))
+        {
+            parameter = ServerMaxWindowBits;
+            if (not scHttpWebSocketParseWindowBits(value, parameters.serverMaxWindowBits))
+            {
+                return false;
+            }
+        }
+        else if (scHttpWebSocketEqualsIgnoreCase(name, "client_max_window_bits"))
+        {
+            // An offer can omit the value, just telling that the client supports the parameter
+            parameter = ClientMaxWindowBits;
+            if ((isResponse or not value.isEmpty()) and
+                not scHttpWebSocketParseWindowBits(value, parameters.clientMaxWindowBits))
+            {
+                return false;
+            }
+        }
+        if (parameter == 0 or (seen & parameter) != 0)
+        {
+            return false; // Unknown, malformed or duplicated parameter
+        }
+        seen |= parameter;
+    }
+    return true;
+}
+
+static SC::Result scHttpWebSocketAppend(SC::Span<char> storage, size_t& length, const char* text)
+{
+    const size_t textLength = ::strlen(text);
+    SC_TRY_MSG(length + textLength <= storage.sizeInBytes(), "HttpWebSocketHandshake extension storage too small");
+    ::memcpy(storage.data() + length, text, textLength);
+    length += textLength;
+    return SC::Result(true);
+}
+
 static SC::Result scHttpWebSocketBase64Encode(SC::Span<const uint8_t> data, SC::Span<char> storage,
                                               SC::StringSpan& output)
 {
@@ -428,6 +585,66 @@ bool HttpWebSocketHandshake::headerContainsToken(StringSpan headerValue, StringS
     return false;
 }
 
+bool HttpWebSocketHandshake::negotiateDeflate(StringSpan offers, HttpWebSocketDeflateParameters& parameters)
+{
+    parameters.enabled = false;
+    while (not offers.isEmpty())
+    {
+        HttpWebSocketDeflateParameters offer;
+        if (not scHttpWebSocketParseDeflate(scHttpWebSocketSplit(offers, ','), false, offer))
+        {
+            continue; // Try next offer
+        }
+        parameters.serverNoContextTakeover = parameters.serverNoContextTakeover or offer.serverNoContextTakeover;
+        parameters.clientNoContextTakeover = parameters.clientNoContextTakeover or offer.clientNoContextTakeover;
+        if (offer.serverMaxWindowBits < parameters.serverMaxWindowBits)
+        {
+            parameters.serverMaxWindowBits = offer.serverMaxWindowBits;
+        }
+        parameters.clientMaxWindowBits = offer.clientMaxWindowBits;
+        parameters.enabled             = true;
+        return true;
+    }
+    return false;
+}
+
+Result HttpWebSocketHandshake::formatDeflateResponse(const HttpWebSocketDeflateParameters& parameters,
+                                                     Span<char> storage, StringSpan& response)
+{
+    SC_TRY_MSG(parameters.enabled, "HttpWebSocketHandshake permessage-deflate has not been negotiated");
+    SC_TRY_MSG(parameters.serverMaxWindowBits >= 9 and parameters.serverMaxWindowBits <= 15,
+               "HttpWebSocketHandshake invalid server_max_window_bits");
+
+    size_t length = 0;
+    SC_TRY(scHttpWebSocketAppend(storage, length, "permessage-deflate"));
+    if (parameters.serverNoContextTakeover)
+    {
+        SC_TRY(scHttpWebSocketAppend(storage, length, "; server_no_context_takeover"));
+    }
+    if (parameters.clientNoContextTakeover)
+    {
+        SC_TRY(scHttpWebSocketAppend(storage, length, "; client_no_context_takeover"));
+    }
+    if (parameters.serverMaxWindowBits < 15)
+    {
+        const char windowBits[] = {static_cast<char>('0' + parameters.serverMaxWindowBits / 10),
+                                   static_cast<char>('0' + parameters.serverMaxWindowBits % 10), 0};
+        SC_TRY(scHttpWebSocketAppend(storage, length, "; server_max_window_bits="));
+        SC_TRY(scHttpWebSocketAppend(storage, length, windowBits[0] == '0' ? windowBits + 1 : windowBits));
+    }
+    response = {{storage.data(), length}, false, StringEncoding::Ascii};
+    return Result(true);
+}
+
+Result HttpWebSocketHandshake::parseDeflateResponse(StringSpan response, HttpWebSocketDeflateParameters& parameters)
+{
+    parameters = {};
+    SC_TRY_MSG(scHttpWebSocketParseDeflate(response, true, parameters),
+               "HttpWebSocketHandshake response extension is not a valid permessage-deflate");
+    parameters.enabled = true;
+    return Result(true);
+}
+
 HttpWebSocketHandshakeResult HttpWebSocketHandshake::validateServerRequest(
     const HttpWebSocketServerHandshakeRequestView& request)
 {
@@ -479,6 +696,7 @@ HttpWebSocketHandshakeResult HttpWebSocketHandshake::validateServerRequest(
     (void)request.getHeader("Connection", local.connection);
     (void)request.getHeader("Sec-WebSocket-Key", local.secWebSocketKey);
     (void)request.getHeader("Sec-WebSocket-Version", local.secWebSocketVersion);
+    (void)request.getHeader("Sec-WebSocket-Extensions", local.secWebSocketExtensions);
 
     if (view != nullptr)
     {
@@ -488,7 +706,8 @@ HttpWebSocketHandshakeResult HttpWebSocketHandshake::validateServerRequest(
 }
 
 Result HttpWebSocketHandshake::validateClientResponse(const HttpWebSocketClientHandshakeResponseView& response,
-                                                      StringSpan                                      expectedClientKey)
+                                                      StringSpan                                      expectedClientKey,
+                                                      HttpWebSocketDeflateParameters*                 deflate)
 {
     SC_TRY_MSG(response.statusCode == 101, "HttpWebSocketHandshake expected 101 Switching Protocols");
     SC_TRY_MSG(scHttpWebSocketEqualsIgnoreCase(scHttpWebSocketTrim(response.upgrade), "websocket"),
@@ -501,27 +720,43 @@ Result HttpWebSocketHandshake::validateClientResponse(const HttpWebSocketClientH
     SC_TRY(computeAccept(expectedClientKey, acceptStorage, expectedAccept));
     SC_TRY_MSG(scHttpWebSocketEqualsIgnoreCase(scHttpWebSocketTrim(response.secWebSocketAccept), expectedAccept),
                "HttpWebSocketHandshake response Sec-WebSocket-Accept invalid");
+    if (deflate != nullptr)
+    {
+        *deflate = {};
+    }
+    if (not response.secWebSocketExtensions.isEmpty())
+    {
+        SC_TRY_MSG(deflate != nullptr, "HttpWebSocketHandshake response extension was not offered");
+        SC_TRY(parseDeflateResponse(scHttpWebSocketTrim(response.secWebSocketExtensions), *deflate));
+    }
     return Result(true);
 }
 
 Result HttpWebSocketHandshake::validateClientResponse(const HttpAsyncClientResponse& response,
-                                                      StringSpan                     expectedClientKey)
+                                                      StringSpan                     expectedClientKey,
+                                                      HttpWebSocketDeflateParameters* deflate)
 {
     HttpWebSocketClientHandshakeResponseView view;
     view.statusCode = response.getParser().statusCode;
     (void)response.getHeader("Upgrade", view.upgrade);
     (void)response.getHeader("Connection", view.connection);
     (void)response.getHeader("Sec-WebSocket-Accept", view.secWebSocketAccept);
-    return validateClientResponse(view, expectedClientKey);
+    (void)response.getHeader("Sec-WebSocket-Extensions", view.secWebSocketExtensions);
+    return validateClientResponse(view, expectedClientKey, deflate);
 }
 
-Result HttpWebSocketHandshake::prepareClientRequest(HttpAsyncClientRequest& request, StringSpan clientKey)
+Result HttpWebSocketHandshake::prepareClientRequest(HttpAsyncClientRequest& request, StringSpan clientKey,
+                                                    bool offerDeflate)
 {
     SC_TRY(validateClientKey(clientKey));
     SC_TRY(request.addHeader("Upgrade", "websocket"));
     SC_TRY(request.addHeader("Connection", "Upgrade"));
     SC_TRY(request.addHeader("Sec-WebSocket-Key", clientKey));
     SC_TRY(request.addHeader("Sec-WebSocket-Version", "13"));
+    if (offerDeflate)
+    {
+        SC_TRY(request.addHeader("Sec-WebSocket-Extensions", "permessage-deflate; client_max_window_bits"));
+    }
     return request.sendHeaders();
 }
 
@@ -537,7 +772,7 @@ Result HttpWebSocketHandshake::writeServerAccept(HttpResponse& response, StringS
 }
 
 Result HttpWebSocketHandshake::acceptServerConnection(HttpConnection& connection, HttpWebSocketTransportView& transport,
-                                                      Span<char> acceptStorage)
+                                                      Span<char> acceptStorage, HttpWebSocketDeflateParameters* deflate)
 {
     HttpWebSocketServerHandshakeRequestView request;
     const HttpWebSocketHandshakeResult      validation = validateServerRequest(connection.request, &request);
@@ -549,6 +784,13 @@ Result HttpWebSocketHandshake::acceptServerConnection(HttpConnection& connection
     SC_TRY(connection.response.addHeader("Upgrade", "websocket"));
     SC_TRY(connection.response.addHeader("Connection", "Upgrade"));
     SC_TRY(connection.response.addHeader("Sec-WebSocket-Accept", accept));
+    if (deflate != nullptr and negotiateDeflate(request.secWebSocketExtensions, *deflate))
+    {
+        char       extensionStorage[DeflateResponseMaxLength];
+        StringSpan extension;
+        SC_TRY(formatDeflateResponse(*deflate, extensionStorage, extension));
+        SC_TRY(connection.response.addHeader("Sec-WebSocket-Extensions", extension));
+    }
 
     connection.markWebSocketUpgraded();
     transport.readableStream = &connection.getReadableTransportStream();
@@ -576,11 +818,13 @@ Result HttpWebSocketHandshake::rejectServerConnection(HttpResponse&
 }
 
 Result HttpWebSocketClientHandshake::connect(HttpAsyncClient& newClient, AsyncEventLoop& loop, StringSpan url,
-                                             StringSpan newClientKey, HttpWebSocketTransportView& newTransport)
+                                             StringSpan newClientKey, HttpWebSocketTransportView& newTransport,
+                                             HttpWebSocketDeflateParameters* newDeflate)
 {
     SC_TRY(HttpWebSocketHandshake::validateClientKey(newClientKey));
     client    = &newClient;
     transport = &newTransport;
+    deflate   = newDeflate;
     clientKey = newClientKey;
     transport->reset();
 
@@ -592,7 +836,7 @@ Result HttpWebSocketClientHandshake::connect(HttpAsyncClient& newClient, AsyncEv
 
 void HttpWebSocketClientHandshake::onPrepareRequest(HttpAsyncClientRequest& request)
 {
-    const Result result = HttpWebSocketHandshake::prepareClientRequest(request, clientKey);
+    const Result result = HttpWebSocketHandshake::prepareClientRequest(request, clientKey, deflate != nullptr);
     if (not result)
     {
         fail(result);
@@ -604,7 +848,7 @@ void HttpWebSocketClientHandshake::onResponse(HttpAsyncClientResponse& response)
     SC_HTTP_ASSERT_RELEASE(client != nullptr);
     SC_HTTP_ASSERT_RELEASE(transport != nullptr);
 
-    Result result = HttpWebSocketHandshake::validateClientResponse(response, clientKey);
+    Result result = HttpWebSocketHandshake::validateClientResponse(response, clientKey, deflate);
     if (result)
     {
         result = client->detachWebSocketTransport(*transport);
@@ -630,14 +874,136 @@ void HttpWebSocketClientHandshake::fail(Result result)
     }
 }
 
+Result HttpWebSocketDeflate::init(const HttpWebSocketDeflateParameters& parameters, HttpWebSocketEndpointRole role,
+                                  Span<char> storage)
+{
+    SC_TRY_MSG(parameters.enabled, "HttpWebSocketDeflate permessage-deflate has not been negotiated");
+    SC_TRY_MSG(not storage.empty(), "HttpWebSocketDeflate inflate storage is empty");
+    close();
+
+    const bool isServer      = role == HttpWebSocketEndpointRole::Server;
+    deflateWindowBits        = isServer ? parameters.serverMaxWindowBits : parameters.clientMaxWindowBits;
+    deflateNoContextTakeover = isServer ? parameters.serverNoContextTakeover : parameters.clientNoContextTakeover;
+    inflateNoContextTakeover = isServer ? parameters.clientNoContextTakeover : parameters.serverNoContextTakeover;
+
+    SC_TRY(deflater.init(ZLibStream::CompressDeflate, deflateWindowBits));
+    // The largest window can inflate data compressed with any smaller window
+    const Result inflaterResult = inflater.init(ZLibStream::DecompressDeflate);
+    if (not inflaterResult)
+    {
+        deflater.reset();
+        return inflaterResult;
+    }
+    inflateStorage   = storage;
+    inflateTailBytes = 0;
+    inited           = true;
+    return Result(true);
+}
+
+void HttpWebSocketDeflate::close()
+{
+    deflater.reset();
+    inflater.reset();
+    inflateStorage   = {};
+    inflateTailBytes = 0;
+    inited           = false;
+}
+
+Result HttpWebSocketDeflate::deflateMessage(Span<const char> payload, bool messageFinished, Span<char> storage,
+                                            Span<char>& compressed)
+{
+    SC_TRY_MSG(inited, "HttpWebSocketDeflate is not inited");
+    Span<char> output = storage;
+    while (not payload.empty())
+    {
+        SC_TRY_MSG(not output.empty(), "HttpWebSocketDeflate compressed storage too small");
+        SC_TRY(deflater.process(payload, output));
+    }
+    if (messageFinished)
+    {
+        bool flushed = false;
+        while (not flushed)
+        {
+            SC_TRY_MSG(not output.empty(), "HttpWebSocketDeflate compressed storage too small");
+            SC_TRY(deflater.flush(output, flushed));
+        }
+    }
+    size_t length = storage.sizeInBytes() - output.sizeInBytes();
+    if (messageFinished)
+    {
+        if (length == 0)
+        {
+            // Nothing to flush since last message: an empty stored block is sent as a single 0x00 byte
+            SC_TRY_MSG(not storage.empty(), "HttpWebSocketDeflate compressed storage too small");
+            storage[0] = 0;
+            length     = 1;
+        }
+        else
+        {
+            // The flush ends with an empty stored block that RFC 7692 removes from the frame payload
+            SC_TRY_MSG(length >= 4 and scHttpWebSocketIsDeflateTail(storage.data() + length - 4),
+                       "HttpWebSocketDeflate unexpected flush trailer");
+            length -= 4;
+        }
+        if (deflateNoContextTakeover)
+        {
+            deflater.reset();
+            SC_TRY(deflater.init(ZLibStream::CompressDeflate, deflateWindowBits));
+        }
+    }
+    compressed = {storage.data(), length};
+    return Result(true);
+}
+
+Result HttpWebSocketDeflate::inflateMessage(Span<const char>& payload, bool messageFinished, Span<char>& output,
+                                            bool& drained)
+{
+    SC_TRY_MSG(inited, "HttpWebSocketDeflate is not inited");
+    static constexpr char deflateTail[4] = {0, 0, static_cast<char>(0xFF), static_cast<char>(0xFF)};
+
+    const size_t  payloadBytes = payload.sizeInBytes();
+    const uint8_t tailBytes    = inflateTailBytes;
+
+    Span<char> destination = inflateStorage;
+    SC_TRY(inflater.processPartial(payload, destination));
+    if (messageFinished and payload.empty() and inflateTailBytes < 4 and not destination.empty())
+    {
+        // Restore the empty stored block that the sender removed from the end of the message
+        Span<const char> tail = {deflateTail + inflateTailBytes, 4u - inflateTailBytes};
+        SC_TRY(inflater.processPartial(tail, destination));
+        inflateTailBytes = static_cast<uint8_t>(4 - tail.sizeInBytes());
+    }
+    output = {inflateStorage.data(), inflateStorage.sizeInBytes() - destination.sizeInBytes()};
+
+    // Unused destination space means that inflater has no more pending output
+    drained = payload.empty() and not destination.empty() and (not messageFinished or inflateTailBytes == 4);
+    if (not drained)
+    {
+        SC_TRY_MSG(not output.empty() or payload.sizeInBytes() != payloadBytes or inflateTailBytes != tailBytes,
+                   "HttpWebSocketDeflate inflate is not making progress");
+    }
+    else if (messageFinished)
+    {
+        inflateTailBytes = 0;
+        if (inflateNoContextTakeover)
+        {
+            inflater.reset();
+            SC_TRY(inflater.init(ZLibStream::DecompressDeflate));
+        }
+    }
+    return Result(true);
+}
+
 void HttpWebSocketFrameReader::reset(HttpWebSocketEndpointRole role)
 {
     endpointRole = role;
     currentFrame = {};
+    deflate      = nullptr;
 
     state = State::HeaderByte0;
 
     fragmentedMessageInProgress = false;
+    compressedMessageInProgress = false;
 
     headerByte0 = 0;
 
@@ -650,6 +1016,8 @@ void HttpWebSocketFrameReader::reset(HttpWebSocketEndpointRole role)
     payloadBytesConsumed      = 0;
 }
 
+void HttpWebSocketFrameReader::setDeflate(HttpWebSocketDeflate* newDeflate) { deflate = newDeflate; }
+
 Result HttpWebSocketFrameReader::parse(Span<char> data, size_t& consumedBytes)
 {
     consumedBytes = 0;
@@ -666,10 +1034,13 @@ Result HttpWebSocketFrameReader::parse(Span<char> data, size_t& consumedBytes)
 
         case State::HeaderByte1: {
             const uint8_t opcodeValue = headerByte0 & 0x0F;
-            SC_TRY_MSG((headerByte0 & 0x70) == 0, "HttpWebSocketFrameReader RSV bits are not supported");
-            currentFrame        = {};
-            currentFrame.fin    = (headerByte0 & 0x80) != 0;
-            currentFrame.opcode = static_cast<HttpWebSocketOpcode>(opcodeValue);
+            const bool    rsv1        = (headerByte0 & 0x40) != 0;
+            SC_TRY_MSG((headerByte0 & 0x30) == 0 and (not rsv1 or deflate != nullptr),
+                       "HttpWebSocketFrameReader RSV bits are not supported");
+            currentFrame            = {};
+            currentFrame.fin        = (headerByte0 & 0x80) != 0;
+            currentFrame.compressed = rsv1;
+            currentFrame.opcode     = static_cast<HttpWebSocketOpcode>(opcodeValue);
             SC_TRY_MSG(scHttpWebSocketIsSupportedOpcode(currentFrame.opcode),
                        "HttpWebSocketFrameReader unsupported opcode");
 
@@ -745,7 +1116,11 @@ Result HttpWebSocketFrameReader::parse(Span<char> data, size_t& consumedBytes)
 
             payloadBytesRemaining -= toConsume;
             const bool frameFinished = payloadBytesRemaining == 0;
-            if (onFramePayload.isValid())
+            if (currentFrame.compressed)
+            {
+                SC_TRY(inflatePayload(payload, frameFinished));
+            }
+            else if (onFramePayload.isValid())
             {
                 SC_TRY(onFramePayload(payload, frameFinished));
             }
@@ -772,16 +1147,20 @@ Result HttpWebSocketFrameReader::onHeaderReady()
     {
         SC_TRY_MSG(currentFrame.fin, "HttpWebSocketFrameReader control frames must not be fragmented");
         SC_TRY_MSG(currentFrame.payloadLength <= 125, "HttpWebSocketFrameReader control frame payload too large");
+        SC_TRY_MSG(not currentFrame.compressed, "HttpWebSocketFrameReader control frames must not be compressed");
     }
     else
     {
         if (currentFrame.opcode == HttpWebSocketOpcode::Continuation)
         {
             SC_TRY_MSG(fragmentedMessageInProgress, "HttpWebSocketFrameReader unexpected continuation frame");
+            SC_TRY_MSG(not currentFrame.compressed, "HttpWebSocketFrameReader RSV1 set on a continuation frame");
+            currentFrame.compressed = compressedMessageInProgress;
         }
         else
         {
             SC_TRY_MSG(not fragmentedMessageInProgress, "HttpWebSocketFrameReader expected continuation frame");
+            compressedMessageInProgress = currentFrame.compressed;
         }
     }
 
@@ -795,6 +1174,10 @@ Result HttpWebSocketFrameReader::onHeaderReady()
 
     if (payloadBytesRemaining == 0)
     {
+        if (currentFrame.compressed and currentFrame.fin)
+        {
+            SC_TRY(inflatePayload({}, true)); // Message end still produces the last decompressed bytes
+        }
         return finishCurrentFrame();
     }
 
@@ -802,6 +1185,24 @@ Result HttpWebSocketFrameReader::onHeaderReady()
     return Result(true);
 }
 
+Result HttpWebSocketFrameReader::inflatePayload(Span<const char> payload, bool frameFinished)
+{
+    const bool messageFinished = frameFinished and currentFrame.fin;
+
+    bool drained = false;
+    while (not drained)
+    {
+        Span<char> output;
+        SC_TRY(deflate->inflateMessage(payload, messageFinished, output, drained));
+        const bool lastOutput = drained and frameFinished;
+        if (onFramePayload.isValid() and (lastOutput or not output.empty()))
+        {
+            SC_TRY(onFramePayload(output, lastOutput));
+        }
+    }
+    return Result(true);
+}
+
 Result HttpWebSocketFrameReader::finishCurrentFrame()
 {
     if (not currentFrame.isControlFrame())
@@ -830,14 +1231,25 @@ void HttpWebSocketFrameWriter::reset(HttpWebSocketEndpointRole role)
 {
     endpointRole                = role;
     currentFrame                = {};
+    deflate                     = nullptr;
     frameInProgress             = false;
     fragmentedMessageInProgress = false;
     payloadBytesRemaining       = 0;
     payloadBytesWritten         = 0;
 }
 
-Result HttpWebSocketFrameWriter::beginFrame(const HttpWebSocketFrameHeaderView& frame, Span<char> storage,
-                                            Span<const char>& encodedHeader)
+void HttpWebSocketFrameWriter::setDeflate(HttpWebSocketDeflate* newDeflate) { deflate = newDeflate; }
+
+Result HttpWebSocketFrameWriter::deflatePayload(const HttpWebSocketFrameHeaderView& frame, Span<const char> payload,
+                                                Span<char> storage, Span<char>& compressed)
+{
+    SC_TRY_MSG(deflate != nullptr, "HttpWebSocketFrameWriter permessage-deflate is not enabled");
+    SC_TRY_MSG(not frame.isControlFrame(), "HttpWebSocketFrameWriter control frames cannot be compressed");
+    SC_TRY(validateFrame(frame));
+    return deflate->deflateMessage(payload, frame.fin, storage, compressed);
+}
+
+Result HttpWebSocketFrameWriter::validateFrame(const HttpWebSocketFrameHeaderView& frame) const
 {
     SC_TRY_MSG(not frameInProgress, "HttpWebSocketFrameWriter frame already in progress");
     SC_TRY_MSG(scHttpWebSocketIsSupportedOpcode(frame.opcode), "HttpWebSocketFrameWriter unsupported opcode");
@@ -858,9 +1270,22 @@ Result HttpWebSocketFrameWriter::beginFrame(const HttpWebSocketFrameHeaderView&
             SC_TRY_MSG(not fragmentedMessageInProgress, "HttpWebSocketFrameWriter expected continuation frame");
         }
     }
+    if (frame.compressed)
+    {
+        SC_TRY_MSG(deflate != nullptr, "HttpWebSocketFrameWriter permessage-deflate is not enabled");
+        SC_TRY_MSG(not frame.isControlFrame() and frame.opcode != HttpWebSocketOpcode::Continuation,
+                   "HttpWebSocketFrameWriter RSV1 is only valid on the first frame of a data message");
+    }
 
     const bool requiresMask = scHttpWebSocketRequiresOutgoingMask(endpointRole);
     SC_TRY_MSG(frame.masked == requiresMask, "HttpWebSocketFrameWriter invalid frame masking for endpoint role");
+    return Result(true);
+}
+
+Result HttpWebSocketFrameWriter::beginFrame(const HttpWebSocketFrameHeaderView& frame, Span<char> storage,
+                                            Span<const char>& encodedHeader)
+{
+    SC_TRY(validateFrame(frame));
 
     const size_t encodedLength =
         2 + (frame.payloadLength < 126 ? 0 : (frame.payloadLength <= 0xFFFF ? 2 : 8)) + (frame.masked ? 4 : 0);
@@ -869,7 +1294,8 @@ Result HttpWebSocketFrameWriter::beginFrame(const HttpWebSocketFrameHeaderView&
     currentFrame = frame;
 
     uint8_t* output = reinterpret_cast<uint8_t*>(storage.data());
-    output[0]       = static_cast<uint8_t>((frame.fin ? 0x80 : 0) | static_cast<uint8_t>(frame.opcode));
+    output[0]       = static_cast<uint8_t>((frame.fin ? 0x80 : 0) | (frame.compressed ? 0x40 : 0) |
+                                           static_cast<uint8_t>(frame.opcode));
 
     size_t headerOffset = 1;
     if (frame.payloadLength < 126)
@@ -969,7 +1395,8 @@ Result HttpWebSocketMessageAssembler::onFrameHeader(const HttpWebSocketFrameHead
         assemblingMessage = true;
     }
 
-    if (header.payloadLength == 0 and header.fin)
+    // Compressed messages still deliver their final bytes through onFramePayload
+    if (header.payloadLength == 0 and header.fin and not header.compressed)
     {
         if (onMessage.isValid())
         {
@@ -1012,6 +1439,7 @@ Result HttpWebSocketMessageAssembler::onFramePayload(Span<char> payload, bool fr
 void HttpWebSocketEndpoint::reset(HttpWebSocketEndpointRole role)
 {
     endpointRole = role;
+    deflate      = nullptr;
     reader.reset(role);
     writer.reset(role);
     reader.onFrameHeader.bind<HttpWebSocketEndpoint, &HttpWebSocketEndpoint::onReaderFrameHeader>(*this);
@@ -1034,6 +1462,13 @@ void HttpWebSocketEndpoint::setAutomaticMaskKey(const uint8_t maskKey[4])
     automaticMaskKeySet = true;
 }
 
+void HttpWebSocketEndpoint::setDeflate(HttpWebSocketDeflate* newDeflate)
+{
+    deflate = newDeflate;
+    reader.setDeflate(newDeflate);
+    writer.setDeflate(newDeflate);
+}
+
 Result HttpWebSocketEndpoint::receive(Span<char> data, size_t& consumedBytes)
 {
     return reader.parse(data, consumedBytes);
@@ -1095,7 +1530,31 @@ Result HttpWebSocketEndpoint::sendData(HttpWebSocketOpcode opcode, Span<const ch
     header.fin           = fin;
     header.payloadLength = payload.sizeInBytes();
     SC_TRY(applyOutgoingMask(header, maskKey));
-    return sendFrame(header, payload, storage, encodedFrame);
+    if (deflate == nullptr)
+    {
+        return sendFrame(header, payload, storage, encodedFrame);
+    }
+
+    // Compress after the largest possible header, then place the actual header right before compressed payload
+    constexpr size_t MaxHeaderLength = 2 + 8 + 4;
+    SC_TRY_MSG(storage.sizeInBytes() > MaxHeaderLength, "HttpWebSocketEndpoint frame storage too small");
+    Span<char> compressed;
+    Span<char> compressedStorage;
+    SC_TRY(storage.sliceStart(MaxHeaderLength, compressedStorage));
+    header.compressed = opcode != HttpWebSocketOpcode::Continuation;
+    SC_TRY(writer.deflatePayload(header, payload, compressedStorage, compressed));
+    header.payloadLength = compressed.sizeInBytes();
+
+    char             headerStorage[MaxHeaderLength];
+    Span<const char> encodedHeader;
+    SC_TRY(writer.beginFrame(header, headerStorage, encodedHeader));
+    char* frameStart = storage.data() + MaxHeaderLength - encodedHeader.sizeInBytes();
+    ::memcpy(frameStart, encodedHeader.data(), encodedHeader.sizeInBytes());
+    SC_TRY(writer.writePayload(compressed));
+    SC_TRY(writer.finishFrame());
+
+    encodedFrame = {frameStart, encodedHeader.sizeInBytes() + compressed.sizeInBytes()};
+    return Result(true);
 }
 
 Result HttpWebSocketEndpoint::sendPing(Span<const char> payload, const uint8_t* maskKey, Span<char> storage,
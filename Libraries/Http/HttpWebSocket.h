@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 #include "../AsyncStreams/AsyncStreams.h"
+#include "../AsyncStreams/Internal/ZLibStream.h"
 #include "../Common/Function.h"
 #include "../Common/Result.h"
 #include "../Common/Span.h"
@@ -47,6 +48,7 @@ struct SC_HTTP_EXPORT HttpWebSocketFrameHeaderView
 
     bool     fin           = true;
     bool     masked        = false;
+    bool     compressed    = false; ///< Payload is compressed with permessage-deflate (RSV1 on the first frame)
     uint64_t payloadLength = 0;
     uint8_t  maskKey[4]    = {0, 0, 0, 0};
 
@@ -78,6 +80,7 @@ struct SC_HTTP_EXPORT HttpWebSocketServerHandshakeRequestView
     StringSpan connection;
     StringSpan secWebSocketKey;
     StringSpan secWebSocketVersion;
+    StringSpan secWebSocketExtensions;
 };
 
 /// @brief Normalized client-side WebSocket opening handshake response data
@@ -88,6 +91,7 @@ struct SC_HTTP_EXPORT HttpWebSocketClientHandshakeResponseView
     StringSpan upgrade;
     StringSpan connection;
     StringSpan secWebSocketAccept;
+    StringSpan secWebSocketExtensions;
 };
 
 /// @brief Outcome of validating a WebSocket opening handshake
@@ -106,6 +110,18 @@ struct SC_HTTP_EXPORT HttpWebSocketHandshakeResult
     [[nodiscard]] int  httpStatusCode() const;
 };
 
+/// @brief Parameters of the permessage-deflate extension (RFC 7692)
+struct SC_HTTP_EXPORT HttpWebSocketDeflateParameters
+{
+    bool enabled = false; ///< The extension has been negotiated
+
+    bool serverNoContextTakeover = false; ///< Server compressor is reset after every message
+    bool clientNoContextTakeover = false; ///< Client compressor is reset after every message
+
+    uint8_t serverMaxWindowBits = 15; ///< LZ77 window of the server compressor (9 to 15)
+    uint8_t clientMaxWindowBits = 15; ///< LZ77 window of the client compressor (9 to 15)
+};
+
 /// @brief Dependency-free RFC 6455 opening handshake helpers
 struct SC_HTTP_EXPORT HttpWebSocketHandshake
 {
@@ -113,6 +129,8 @@ struct SC_HTTP_EXPORT HttpWebSocketHandshake
     static constexpr size_t AcceptKeyLength = 28;
     static constexpr size_t NonceLength     = 16;
 
+    static constexpr size_t DeflateResponseMaxLength = 128;
+
     static Result createClientKey(Span<const uint8_t> nonce, Span<char> storage, StringSpan& key);
     static Result validateClientKey(StringSpan key);
     static Result computeAccept(StringSpan clientKey, Span<char> storage, StringSpan& accept);
@@ -123,15 +141,31 @@ struct SC_HTTP_EXPORT HttpWebSocketHandshake
     static HttpWebSocketHandshakeResult validateServerRequest(const HttpRequest&                       request,
                                                               HttpWebSocketServerHandshakeRequestView* view = nullptr);
 
+    /// @brief Selects the first acceptable permessage-deflate offer of a `Sec-WebSocket-Extensions` request header
+    /// @param offers Value of the `Sec-WebSocket-Extensions` request header
+    /// @param parameters Server preferences on input (no context takeover flags, server window), negotiated on output
+    /// @return `true` if an offer has been accepted (and `parameters.enabled` has been set)
+    static bool negotiateDeflate(StringSpan offers, HttpWebSocketDeflateParameters& parameters);
+
+    /// @brief Formats the `Sec-WebSocket-Extensions` response header value for negotiated parameters
+    static Result formatDeflateResponse(const HttpWebSocketDeflateParameters& parameters, Span<char> storage,
+                                        StringSpan& response);
+
+    /// @brief Parses (client side) the `Sec-WebSocket-Extensions` response header accepting a permessage-deflate offer
+    static Result parseDeflateResponse(StringSpan response, HttpWebSocketDeflateParameters& parameters);
+
     static Result validateClientResponse(const HttpWebSocketClientHandshakeResponseView& response,
-                                         StringSpan                                      expectedClientKey);
-    static Result validateClientResponse(const HttpAsyncClientResponse& response, StringSpan expectedClientKey);
+                                         StringSpan                                      expectedClientKey,
+                                         HttpWebSocketDeflateParameters*                 deflate = nullptr);
+    static Result validateClientResponse(const HttpAsyncClientResponse& response, StringSpan expectedClientKey,
+                                         HttpWebSocketDeflateParameters* deflate = nullptr);
 
-    static Result prepareClientRequest(HttpAsyncClientRequest& request, StringSpan clientKey);
+    static Result prepareClientRequest(HttpAsyncClientRequest& request, StringSpan clientKey,
+                                       bool offerDeflate = false);
     static Result writeServerAccept(HttpResponse& response, StringSpan clientKey, Span<char> acceptStorage,
                                     StringSpan& accept);
     static Result acceptServerConnection(HttpConnection& connection, HttpWebSocketTransportView& transport,
-                                         Span<char> acceptStorage);
+                                         Span<char> acceptStorage, HttpWebSocketDeflateParameters* deflate = nullptr);
     static Result rejectServerConnection(HttpResponse& response, const HttpWebSocketHandshakeResult& result);
 };
 
@@ -141,8 +175,10 @@ struct SC_HTTP_EXPORT HttpWebSocketClientHandshake
     Function<void(HttpWebSocketTransportView&)> onConnected;
     Function<void(Result)>                      onError;
 
+    /// @brief Starts the handshake, offering permessage-deflate when `deflate` is not `nullptr`.
+    /// `deflate` (if provided) receives the negotiated parameters and must be valid until `onConnected` or `onError`.
     Result connect(HttpAsyncClient& client, AsyncEventLoop& loop, StringSpan url, StringSpan clientKey,
-                   HttpWebSocketTransportView& transport);
+                   HttpWebSocketTransportView& transport, HttpWebSocketDeflateParameters* deflate = nullptr);
 
   private:
     void onPrepareRequest(HttpAsyncClientRequest& request);
@@ -150,9 +186,49 @@ struct SC_HTTP_EXPORT HttpWebSocketClientHandshake
     void onClientError(Result result);
     void fail(Result result);
 
-    HttpAsyncClient*            client    = nullptr;
-    HttpWebSocketTransportView* transport = nullptr;
-    StringSpan                  clientKey;
+    HttpAsyncClient*                client    = nullptr;
+    HttpWebSocketTransportView*     transport = nullptr;
+    HttpWebSocketDeflateParameters* deflate   = nullptr;
+    StringSpan                      clientKey;
+};
+
+/// @brief Compression state of a WebSocket connection that negotiated permessage-deflate (RFC 7692).
+/// @n
+/// Compressor and decompressor keep their sliding window across messages (context takeover), unless the negotiated
+/// parameters ask to reset them after every message. Decompressed data is produced in caller-provided storage.
+struct SC_HTTP_EXPORT HttpWebSocketDeflate
+{
+    /// @brief Inits compressor and decompressor for the given negotiated parameters and local endpoint role
+    /// @param parameters Negotiated extension parameters
+    /// @param endpointRole Local endpoint role, selecting which side of the parameters applies to the compressor
+    /// @param inflateStorage Storage receiving decompressed data, delivered to the reader one chunk at a time
+    Result init(const HttpWebSocketDeflateParameters& parameters, HttpWebSocketEndpointRole endpointRole,
+                Span<char> inflateStorage);
+
+    /// @brief Releases compressor and decompressor
+    void close();
+
+    [[nodiscard]] bool isInited() const { return inited; }
+
+    /// @brief Compresses a fragment of an outgoing message into storage.
+    /// The final fragment is flushed and stripped of the trailing empty block, as required by RFC 7692.
+    Result deflateMessage(Span<const char> payload, bool messageFinished, Span<char> storage, Span<char>& compressed);
+
+    /// @brief Decompresses a fragment of an incoming message into inflate storage.
+    /// Must be called again until `drained` is `true`, consuming `output` after each call.
+    Result inflateMessage(Span<const char>& payload, bool messageFinished, Span<char>& output, bool& drained);
+
+  private:
+    ZLibStream deflater;
+    ZLibStream inflater;
+    Span<char> inflateStorage;
+
+    uint8_t deflateWindowBits = 15;
+    uint8_t inflateTailBytes  = 0;
+
+    bool deflateNoContextTakeover = false;
+    bool inflateNoContextTakeover = false;
+    bool inited                   = false;
 };
 
 /// @brief Incremental WebSocket frame reader operating on caller-owned mutable byte slices
@@ -164,6 +240,10 @@ struct SC_HTTP_EXPORT HttpWebSocketFrameReader
     void   reset(HttpWebSocketEndpointRole endpointRole);
     Result parse(Span<char> data, size_t& consumedBytes);
 
+    /// @brief Accepts RSV1 compressed messages, delivering their decompressed payload to onFramePayload.
+    /// @note Frame headers of compressed messages report the compressed payloadLength.
+    void setDeflate(HttpWebSocketDeflate* deflate);
+
   private:
     enum class State : uint8_t
     {
@@ -175,14 +255,17 @@ struct SC_HTTP_EXPORT HttpWebSocketFrameReader
     };
 
     Result onHeaderReady();
+    Result inflatePayload(Span<const char> payload, bool frameFinished);
     Result finishCurrentFrame();
 
     HttpWebSocketEndpointRole    endpointRole = HttpWebSocketEndpointRole::Client;
     HttpWebSocketFrameHeaderView currentFrame;
+    HttpWebSocketDeflate*        deflate = nullptr;
 
     State state = State::HeaderByte0;
 
     bool fragmentedMessageInProgress = false;
+    bool compressedMessageInProgress = false;
 
     uint8_t headerByte0 = 0;
 
@@ -200,13 +283,25 @@ struct SC_HTTP_EXPORT HttpWebSocketFrameWriter
 {
     void reset(HttpWebSocketEndpointRole endpointRole);
 
+    /// @brief Allows writing RSV1 compressed messages, whose payload is obtained with deflatePayload
+    void setDeflate(HttpWebSocketDeflate* deflate);
+
+    /// @brief Compresses the payload of the next data frame, before passing its length to beginFrame.
+    /// The frame (except its payloadLength) is validated first, so that a frame rejected by beginFrame doesn't
+    /// advance the compression context shared by all messages.
+    Result deflatePayload(const HttpWebSocketFrameHeaderView& frame, Span<const char> payload, Span<char> storage,
+                          Span<char>& compressed);
+
     Result beginFrame(const HttpWebSocketFrameHeaderView& frame, Span<char> storage, Span<const char>& encodedHeader);
     Result writePayload(Span<char> payload);
     Result finishFrame();
 
   private:
+    Result validateFrame(const HttpWebSocketFrameHeaderView& frame) const;
+
     HttpWebSocketEndpointRole    endpointRole = HttpWebSocketEndpointRole::Client;
     HttpWebSocketFrameHeaderView currentFrame;
+    HttpWebSocketDeflate*        deflate = nullptr;
 
     bool frameInProgress             = false;
     bool fragmentedMessageInProgress = false;
@@ -251,6 +346,9 @@ struct SC_HTTP_EXPORT HttpWebSocketEndpoint
     void reset(HttpWebSocketEndpointRole endpointRole);
     void setAutomaticMaskKey(const uint8_t maskKey[4]);
 
+    /// @brief Compresses sent data messages and decompresses received ones (call after reset, `nullptr` disables)
+    void setDeflate(HttpWebSocketDeflate* deflate);
+
     Result receive(Span<char> data, size_t& consumedBytes);
 
     Result sendFrame(const HttpWebSocketFrameHeaderView& header, Span<const char> payload, Span<char> storage,
@@ -282,6 +380,7 @@ struct SC_HTTP_EXPORT HttpWebSocketEndpoint
     HttpWebSocketFrameReader     reader;
     HttpWebSocketFrameWriter     writer;
     HttpWebSocketFrameHeaderView currentFrame;
+    HttpWebSocketDeflate*        deflate = nullptr;
 
     char             controlPayload[125]                      = {0};
     size_t           controlPayloadSize                       = 0;
@@ -31,7 +31,15 @@ struct SC_HTTP_EXPORT HttpFixedBufferWriter
     }
 
     Result appendHeader(StringSpan name, StringSpan value, const char* outOfSpaceError);
-    Result appendContentLength(uint64_t value, const char* outOfSpaceError, const char* formatError);
+    Result appendContentLength(uint64_t value, const char* outOfSpaceError);
+
+    /// @brief Appends the decimal representation of value without going through snprintf
+    Result appendDecimal(uint64_t value, const char* outOfSpaceError);
+
+    /// @brief Appends an IMF-fixdate like `Wed, 21 Oct 2015 07:28:00 GMT` (always 29 bytes)
+    Result appendHttpDate(int64_t millisecondsSinceEpoch, const char* outOfSpaceError);
+
+    static constexpr size_t HttpDateLength = 29;
 
   private:
     Span<char> buffer;
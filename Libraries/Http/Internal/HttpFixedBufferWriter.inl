@@ -2,7 +2,6 @@
 // SPDX-License-Identifier: MIT
 #include "HttpFixedBufferWriter.h"
 
-#include <stdio.h>
 #include <string.h>
 
 namespace SC
@@ -30,15 +29,117 @@ Result HttpFixedBufferWriter::appendHeader(StringSpan name, StringSpan value, co
     return Result(true);
 }
 
-Result HttpFixedBufferWriter::appendContentLength(uint64_t value, const char* outOfSpaceError, const char* formatError)
+Result HttpFixedBufferWriter::appendContentLength(uint64_t value, const char* outOfSpaceError)
 {
-    char      lengthBuffer[32];
-    const int len = ::snprintf(lengthBuffer, sizeof(lengthBuffer), "%llu", static_cast<unsigned long long>(value));
-    if (len <= 0)
+    SC_TRY(appendLiteral("Content-Length: ", outOfSpaceError));
+    SC_TRY(appendDecimal(value, outOfSpaceError));
+    return appendLiteral("\r\n", outOfSpaceError);
+}
+
+Result HttpFixedBufferWriter::appendDecimal(uint64_t value, const char* outOfSpaceError)
+{
+    static constexpr char digitPairs[] = "00010203040506070809"
+                                         "10111213141516171819"
+                                         "20212223242526272829"
+                                         "30313233343536373839"
+                                         "40414243444546474849"
+                                         "50515253545556575859"
+                                         "60616263646566676869"
+                                         "70717273747576777879"
+                                         "80818283848586878889"
+                                         "90919293949596979899";
+
+    char  digits[20];
+    char* end    = digits + sizeof(digits);
+    char* cursor = end;
+    while (value >= 100)
+    {
+        const size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        cursor -= 2;
+        cursor[0] = digitPairs[pair];
+        cursor[1] = digitPairs[pair + 1];
+    }
+    if (value >= 10)
     {
-        return Result::FromStableCharPointer(formatError);
+        const size_t pair = static_cast<size_t>(value) * 2;
+        cursor -= 2;
+        cursor[0] = digitPairs[pair];
+        cursor[1] = digitPairs[pair + 1];
     }
-    return appendHeader("Content-Length", {{lengthBuffer, static_cast<size_t>(len)}, false, StringEncoding::Ascii},
-                        outOfSpaceError);
+    else
+    {
+        *--cursor = static_cast<char>('0' + value);
+    }
+    return append({cursor, static_cast<size_t>(end - cursor)}, outOfSpaceError);
+}
+
+Result HttpFixedBufferWriter::appendHttpDate(int64_t millisecondsSinceEpoch, const char* outOfSpaceError)
+{
+    static constexpr char days[]   = "SunMonTueWedThuFriSat";
+    static constexpr char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    int64_t seconds = millisecondsSinceEpoch / 1000;
+    if (millisecondsSinceEpoch % 1000 < 0)
+    {
+        seconds -= 1;
+    }
+    int64_t daysSinceEpoch = seconds / 86400;
+    int64_t secondsOfDay   = seconds % 86400;
+    if (secondsOfDay < 0)
+    {
+        secondsOfDay += 86400;
+        daysSinceEpoch -= 1;
+    }
+
+    // Civil date from days since 1970-01-01 (proleptic gregorian calendar, eras of 400 years)
+    const int64_t  shifted   = daysSinceEpoch + 719468;
+    const int64_t  era       = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+    const uint32_t dayOfEra  = static_cast<uint32_t>(shifted - era * 146097);
+    const uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const uint32_t monthBase = (5 * dayOfYear + 2) / 153;
+    const uint32_t day       = dayOfYear - (153 * monthBase + 2) / 5 + 1;
+    const uint32_t month     = monthBase < 10 ? monthBase + 3 : monthBase - 9;
+    const int64_t  year      = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+    if (year < 0 or year > 9999)
+    {
+        return Result::Error("HttpFixedBufferWriter::appendHttpDate - year out of range");
+    }
+    int64_t weekDay = (daysSinceEpoch + 4) % 7; // 1970-01-01 was a Thursday
+    if (weekDay < 0)
+    {
+        weekDay += 7;
+    }
+
+    const uint32_t hours   = static_cast<uint32_t>(secondsOfDay / 3600);
+    const uint32_t minutes = static_cast<uint32_t>((secondsOfDay / 60) % 60);
+    const uint32_t secs    = static_cast<uint32_t>(secondsOfDay % 60);
+    const uint32_t yearU   = static_cast<uint32_t>(year);
+
+    char date[HttpDateLength];
+    ::memcpy(date, days + weekDay * 3, 3);
+    date[3]  = ',';
+    date[4]  = ' ';
+    date[5]  = static_cast<char>('0' + day / 10);
+    date[6]  = static_cast<char>('0' + day % 10);
+    date[7]  = ' ';
+    ::memcpy(date + 8, months + (month - 1) * 3, 3);
+    date[11] = ' ';
+    date[12] = static_cast<char>('0' + yearU / 1000);
+    date[13] = static_cast<char>('0' + (yearU / 100) % 10);
+    date[14] = static_cast<char>('0' + (yearU / 10) % 10);
+    date[15] = static_cast<char>('0' + yearU % 10);
+    date[16] = ' ';
+    date[17] = static_cast<char>('0' + hours / 10);
+    date[18] = static_cast<char>('0' + hours % 10);
+    date[19] = ':';
+    date[20] = static_cast<char>('0' + minutes / 10);
+    date[21] = static_cast<char>('0' + minutes % 10);
+    date[22] = ':';
+    date[23] = static_cast<char>('0' + secs / 10);
+    date[24] = static_cast<char>('0' + secs % 10);
+    ::memcpy(date + 25, " GMT", 4);
+    return append({date, sizeof(date)}, outOfSpaceError);
 }
 } // namespace SC
@@ -1,6 +1,7 @@
 // Copyright (c) Stefano Cristiano
 // SPDX-License-Identifier: MIT
 #include "HttpClient.h"
+#include "HttpClientMulti.h"
 
 #include <string.h>
 
@@ -30,6 +31,18 @@ SC::Result SC::HttpClientOperation::platformStart() { return Result::Error("Http
 SC::Result SC::HttpClientOperation::platformCancel() { return Result(true); }
 #endif
 
+#if !SC_PLATFORM_LINUX
+SC::HttpClientMulti::HttpClientMulti() {}
+SC::HttpClientMulti::~HttpClientMulti() {}
+SC::Result SC::HttpClientMulti::platformInit() { return Result::Error("HttpClientMulti: unsupported platform"); }
+SC::Result SC::HttpClientMulti::platformClose() { return Result(true); }
+SC::Result SC::HttpClientMulti::platformSocketAction(int, bool, bool)
+{
+    return Result::Error("HttpClientMulti: unsupported platform");
+}
+SC::Result SC::HttpClientMulti::platformResumePaused(HttpClientOperation&) { return Result(true); }
+#endif
+
 namespace
 {
 static char asciiLower(char c)
@@ -94,6 +107,43 @@ static SC::StringSpan trimAsciiWhiteSpace(SC::Span<const char> span)
     return {{span.data() + start, end - start}, false, SC::StringEncoding::Ascii};
 }
 
+// Parses the "q" parameter of a list element (for example "; q=0.5") into thousandths, defaulting to 1000
+static int parseQualityValue(SC::Span<const char> parameters)
+{
+    size_t idx = 0;
+    while (idx < parameters.sizeInBytes())
+    {
+        while (idx < parameters.sizeInBytes() and (parameters[idx] == ';' or isAsciiWhiteSpace(parameters[idx])))
+        {
+            idx += 1;
+        }
+        if (idx + 1 < parameters.sizeInBytes() and asciiLower(parameters[idx]) == 'q' and parameters[idx + 1] == '=')
+        {
+            idx += 2;
+            int quality = 0;
+            if (idx < parameters.sizeInBytes() and parameters[idx] == '1')
+            {
+                return 1000;
+            }
+            idx += 2; // Skip "0."
+            for (int scale = 100; scale > 0 and idx < parameters.sizeInBytes(); scale /= 10, ++idx)
+            {
+                if (parameters[idx] < '0' or parameters[idx] > '9')
+                {
+                    break;
+                }
+                quality += (parameters[idx] - '0') * scale;
+            }
+            return quality;
+        }
+        while (idx < parameters.sizeInBytes() and parameters[idx] != ';')
+        {
+            idx += 1;
+        }
+    }
+    return 1000;
+}
+
 static bool parseAsciiUint64(SC::StringSpan text, SC::uint64_t& value)
 {
     const SC::Span<const char> bytes = text.toCharSpan();
@@ -862,6 +912,10 @@ SC::HttpClientContentCoding::Type SC::HttpClientContentCoding::parseName(StringS
     {
         return Brotli;
     }
+    if (asciiEqualsIgnoreCase(name, StringSpan("zstd")))
+    {
+        return ZStd;
+    }
     return Unknown;
 }
 
@@ -875,6 +929,7 @@ const char* SC::HttpClientContentCoding::getName(Type type)
     case Deflate: return "deflate";
     case Compress: return "compress";
     case Brotli: return "br";
+    case ZStd: return "zstd";
     }
     return "unknown";
 }
@@ -942,6 +997,75 @@ SC::Result SC::HttpClientContentCoding::writeAcceptEncoding(Span<const Type> typ
     return Result(true);
 }
 
+SC::HttpClientContentCoding::Type SC::HttpClientContentCoding::selectFromAcceptEncoding(StringSpan acceptEncoding,
+                                                                                       Span<const Type> supported)
+{
+    // Quality values are in thousandths, -1 meaning "not listed"
+    int wildcardQuality = -1;
+    int qualities[ZStd + 1];
+    for (int& quality : qualities)
+    {
+        quality = -1;
+    }
+
+    const Span<const char> bytes = acceptEncoding.toCharSpan();
+    for (size_t offset = 0; offset < bytes.sizeInBytes();)
+    {
+        const size_t elementStart = offset;
+        while (offset < bytes.sizeInBytes() and bytes[offset] != ',')
+        {
+            offset += 1;
+        }
+        const Span<const char> element = {bytes.data() + elementStart, offset - elementStart};
+        offset += 1; // Skip ','
+
+        size_t nameEnd = 0;
+        while (nameEnd < element.sizeInBytes() and element[nameEnd] != ';')
+        {
+            nameEnd += 1;
+        }
+        const StringSpan name = trimAsciiWhiteSpace({element.data(), nameEnd});
+        if (name.sizeInBytes() == 0)
+        {
+            continue;
+        }
+        const int quality = parseQualityValue({element.data() + nameEnd, element.sizeInBytes() - nameEnd});
+        if (name == StringSpan("*"))
+        {
+            wildcardQuality = quality;
+            continue;
+        }
+        const Type type = parseName(name);
+        if (type != Unknown)
+        {
+            qualities[type] = quality;
+        }
+    }
+
+    Type selected        = Unknown;
+    int  selectedQuality = 0;
+    for (const Type type : supported)
+    {
+        int quality = type <= ZStd ? qualities[type] : -1;
+        if (quality < 0)
+        {
+            quality = wildcardQuality < 0 ? 0 : wildcardQuality;
+        }
+        if (quality > selectedQuality)
+        {
+            selected        = type;
+            selectedQuality = quality;
+        }
+    }
+    if (selected != Unknown)
+    {
+        return selected;
+    }
+    // Identity is always acceptable unless explicitly refused (directly or through "*;q=0")
+    const bool identityRefused = qualities[Identity] == 0 or (qualities[Identity] < 0 and wildcardQuality == 0);
+    return identityRefused ? Unknown : Identity;
+}
+
 bool SC::HttpClientResponse::getHeader(StringSpan name, StringSpan& value) const
 {
     HttpClientResponseHeaderIterator iterator;
@@ -1301,6 +1425,7 @@ SC::Result SC::HttpClientOperation::close()
     currentListener = nullptr;
     currentRequest  = {};
     notifier        = nullptr;
+    multi           = nullptr;
 
     eventMutex.lock();
     eventHead  = 0;
@@ -1474,6 +1599,64 @@ SC::Result SC::HttpClientOperation::enqueueResponseDataCopy(Span<const char> dat
     return Result(true);
 }
 
+SC::Result SC::HttpClientOperation::tryEnqueueResponseDataCopy(Span<const char> data, bool& enqueued)
+{
+    enqueued = false;
+
+    // Replay the first-fit order used by allocateResponseBuffer, both against currently free buffers and against
+    // all buffers, to know if the chunk fits now, later (once the listener drains events) or never.
+    eventMutex.lock();
+    const size_t freeSlots       = eventQueue.sizeInElements() - eventCount;
+    size_t       remainingNow    = data.sizeInBytes();
+    size_t       remainingAlways = data.sizeInBytes();
+    size_t       eventsNow       = 0;
+    size_t       eventsAlways    = 0;
+    for (const HttpClientResponseBuffer& buffer : responseBuffers)
+    {
+        const size_t bufferSize = buffer.data.sizeInBytes();
+        if (bufferSize == 0)
+        {
+            continue;
+        }
+        if (remainingAlways > 0)
+        {
+            remainingAlways -= bufferSize < remainingAlways ? bufferSize : remainingAlways;
+            eventsAlways += 1;
+        }
+        if (not buffer.inUse and remainingNow > 0)
+        {
+            remainingNow -= bufferSize < remainingNow ? bufferSize : remainingNow;
+            eventsNow += 1;
+        }
+    }
+    eventMutex.unlock();
+
+    SC_TRY_MSG(remainingAlways == 0 and eventsAlways <= eventQueue.sizeInElements(),
+               "HttpClient: response buffers too small for transfer chunk");
+    if (remainingNow > 0 or eventsNow > freeSlots)
+    {
+        return Result(true);
+    }
+    // Buffers and event slots have just been checked, so enqueueResponseDataCopy will not block
+    SC_TRY(enqueueResponseDataCopy(data));
+    enqueued = true;
+    return Result(true);
+}
+
+void SC::HttpClientOperation::discardPendingEvents()
+{
+    eventMutex.lock();
+    eventHead  = 0;
+    eventTail  = 0;
+    eventCount = 0;
+    for (HttpClientResponseBuffer& buffer : responseBuffers)
+    {
+        buffer.inUse = false;
+    }
+    eventCV.broadcast();
+    eventMutex.unlock();
+}
+
 void SC::HttpClientOperation::enqueueResponseHead()
 {
     HttpClientOperationEvent event;
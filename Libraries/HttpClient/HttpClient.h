@@ -46,6 +46,7 @@ struct SC_HTTP_CLIENT_EXPORT HttpClientContentCoding
         Deflate,
         Compress,
         Brotli,
+        ZStd,
     };
 
     Type       type = Unknown;
@@ -55,6 +56,13 @@ struct SC_HTTP_CLIENT_EXPORT HttpClientContentCoding
     [[nodiscard]] static Type        parseName(StringSpan name);
     [[nodiscard]] static const char* getName(Type type);
     [[nodiscard]] static Result writeAcceptEncoding(Span<const Type> types, Span<char> destination, StringSpan& value);
+
+    /// @brief Picks the content coding a server should use to answer a request with the given Accept-Encoding value.
+    /// Honors q-values (`q=0` refuses a coding) and the `*` wildcard, preferring `supported` order on ties.
+    /// @param acceptEncoding Value of the request Accept-Encoding header (empty value accepts only identity)
+    /// @param supported Codings the server is able to produce, in order of preference
+    /// @return The selected coding, Identity if none is acceptable or Unknown if identity has been refused too
+    [[nodiscard]] static Type selectFromAcceptEncoding(StringSpan acceptEncoding, Span<const Type> supported);
 };
 
 /// @brief Caller-owned cursor for iterating comma-separated Content-Encoding values.
@@ -383,6 +391,7 @@ struct SC_HTTP_CLIENT_EXPORT HttpClientOperationListener
 };
 
 struct SC_HTTP_CLIENT_EXPORT HttpClientOperation;
+struct SC_HTTP_CLIENT_EXPORT HttpClientMulti;
 
 /// @brief Optional notifier used by external adapters to wake up their own event loop
 struct SC_HTTP_CLIENT_EXPORT HttpClientOperationNotifier
@@ -476,6 +485,7 @@ struct SC_HTTP_CLIENT_EXPORT HttpClient
                                                 const HttpClientOperationMemory& memory);
 
     friend struct HttpClientOperation;
+    friend struct HttpClientMulti;
 
   private:
     friend struct Internal;
@@ -540,6 +550,7 @@ struct SC_HTTP_CLIENT_EXPORT HttpClientOperation
     friend struct HttpClientAppleCallbacks;
     friend struct HttpClientLinuxCallbacks;
     friend struct HttpClientWindowsCallbacks;
+    friend struct HttpClientMulti;
 
     Result platformInit();
     Result platformClose();
@@ -552,6 +563,8 @@ struct SC_HTTP_CLIENT_EXPORT HttpClientOperation
     Result allocateResponseBuffer(size_t minimumSizeInBytes, size_t& bufferIndex, Span<char>& data);
     void   releaseResponseBuffer(size_t bufferIndex);
     Result enqueueResponseDataCopy(Span<const char> data);
+    Result tryEnqueueResponseDataCopy(Span<const char> data, bool& enqueued);
+    void   discardPendingEvents();
 
     void enqueueResponseHead();
     void enqueueResponseBuffer(size_t bufferIndex, size_t size);
@@ -572,6 +585,7 @@ struct SC_HTTP_CLIENT_EXPORT HttpClientOperation
     HttpClientResponse*          currentResponse = nullptr;
     HttpClientOperationListener* currentListener = nullptr;
     HttpClientOperationNotifier* notifier        = nullptr;
+    HttpClientMulti*             multi           = nullptr;
     HttpClientRequest            currentRequest;
 
     Span<HttpClientResponseBuffer> responseBuffers;
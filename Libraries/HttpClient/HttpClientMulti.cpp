@@ -0,0 +1,183 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "HttpClientMulti.h"
+
+namespace
+{
+static constexpr SC::size_t InvalidMultiOperationIndex = static_cast<SC::size_t>(-1);
+} // namespace
+
+SC::Result SC::HttpClientMulti::init(HttpClient& clientValue, const HttpClientMultiMemory& memory,
+                                     HttpClientMultiNotifier& notifierValue)
+{
+    SC_TRY_MSG(not initialized, "HttpClientMulti: already initialized");
+    SC_TRY_MSG(clientValue.isInitialized(), "HttpClientMulti: client not initialized");
+    SC_TRY_MSG(not memory.operations.empty(), "HttpClientMulti: operations missing");
+    SC_TRY_MSG(memory.readyOperations.sizeInElements() >= memory.operations.sizeInElements(),
+               "HttpClientMulti: ready state capacity too small");
+    for (HttpClientOperation* operation : memory.operations)
+    {
+        SC_TRY_MSG(operation != nullptr, "HttpClientMulti: null operation");
+        SC_TRY_MSG(operation->isInitialized(), "HttpClientMulti: operation not initialized");
+        SC_TRY_MSG(operation->client == &clientValue, "HttpClientMulti: operation belongs to another client");
+        SC_TRY_MSG(not operation->isRequestInFlight(), "HttpClientMulti: operation has a request in flight");
+        SC_TRY_MSG(operation->multi == nullptr, "HttpClientMulti: operation already registered");
+        // Terminal events are enqueued without waiting, so there must be room for head + complete / error
+        SC_TRY_MSG(operation->eventQueue.sizeInElements() >= 2, "HttpClientMulti: operation event queue too small");
+    }
+
+    client      = &clientValue;
+    notifier    = &notifierValue;
+    multiMemory = memory;
+
+    const Result initResult = platformInit();
+    if (not initResult)
+    {
+        client      = nullptr;
+        notifier    = nullptr;
+        multiMemory = {};
+        return initResult;
+    }
+
+    for (size_t idx = 0; idx < multiMemory.operations.sizeInElements(); ++idx)
+    {
+        multiMemory.readyOperations[idx]   = 0;
+        multiMemory.operations[idx]->multi = this;
+        multiMemory.operations[idx]->setNotifier(this);
+    }
+    initialized = true;
+    return Result(true);
+}
+
+SC::Result SC::HttpClientMulti::close()
+{
+    if (not initialized)
+    {
+        return Result(true);
+    }
+
+    processing = true;
+    SC_TRY(platformClose());
+    for (size_t idx = 0; idx < multiMemory.operations.sizeInElements(); ++idx)
+    {
+        HttpClientOperation& operation = *multiMemory.operations[idx];
+        if (operation.multi == this)
+        {
+            if (operation.requestInFlight)
+            {
+                operation.discardPendingEvents();
+                operation.requestInFlight = false;
+                operation.resetRequestBodyState();
+            }
+            operation.setNotifier(nullptr);
+            operation.multi = nullptr;
+        }
+        multiMemory.readyOperations[idx] = 0;
+    }
+    processing  = false;
+    initialized = false;
+    client      = nullptr;
+    notifier    = nullptr;
+    multiMemory = {};
+    return Result(true);
+}
+
+SC::Result SC::HttpClientMulti::processSocket(int socket, bool readable, bool writable)
+{
+    SC_TRY_MSG(initialized, "HttpClientMulti: not initialized");
+    processing             = true;
+    const Result actionRes = platformSocketAction(socket, readable, writable);
+    processing             = false;
+    SC_TRY(actionRes);
+    return dispatch();
+}
+
+SC::Result SC::HttpClientMulti::processTimeout()
+{
+    // -1 is how the multi socket API identifies a timeout (CURL_SOCKET_TIMEOUT)
+    return processSocket(-1, false, false);
+}
+
+SC::Result SC::HttpClientMulti::dispatch()
+{
+    SC_TRY_MSG(initialized, "HttpClientMulti: not initialized");
+
+    const bool wasProcessing = processing;
+    processing               = true;
+
+    Result res(true);
+    bool   dispatched = true;
+    while (dispatched and res)
+    {
+        dispatched = false;
+        for (size_t idx = 0; idx < multiMemory.operations.sizeInElements() and res; ++idx)
+        {
+            if (multiMemory.readyOperations[idx] == 0)
+            {
+                continue;
+            }
+            multiMemory.readyOperations[idx] = 0;
+            dispatched                       = true;
+
+            HttpClientOperation& operation = *multiMemory.operations[idx];
+            if (operation.multi != this)
+            {
+                continue;
+            }
+            res = operation.poll(0);
+            // Listener may have closed the operation, and resuming may deliver more data marking it ready again
+            if (res and operation.multi == this)
+            {
+                res = platformResumePaused(operation);
+            }
+        }
+    }
+    processing = wasProcessing;
+    return res;
+}
+
+SC::size_t SC::HttpClientMulti::getNumOperations() const { return multiMemory.operations.sizeInElements(); }
+
+SC::size_t SC::HttpClientMulti::getNumRequestsInFlight() const
+{
+    size_t numRequests = 0;
+    for (HttpClientOperation* operation : multiMemory.operations)
+    {
+        if (operation->multi == this and operation->isRequestInFlight())
+        {
+            numRequests += 1;
+        }
+    }
+    return numRequests;
+}
+
+bool SC::HttpClientMulti::isOperationRegistered(HttpClientOperation& operation) const
+{
+    return operation.multi == this and findOperationIndex(operation) != InvalidMultiOperationIndex;
+}
+
+SC::size_t SC::HttpClientMulti::findOperationIndex(HttpClientOperation& operation) const
+{
+    for (size_t idx = 0; idx < multiMemory.operations.sizeInElements(); ++idx)
+    {
+        if (multiMemory.operations[idx] == &operation)
+        {
+            return idx;
+        }
+    }
+    return InvalidMultiOperationIndex;
+}
+
+void SC::HttpClientMulti::notifyHttpClientOperation(HttpClientOperation& operation)
+{
+    const size_t idx = findOperationIndex(operation);
+    if (idx == InvalidMultiOperationIndex)
+    {
+        return;
+    }
+    multiMemory.readyOperations[idx] = 1;
+    if (not processing)
+    {
+        notifier->notifyHttpClientMultiReady();
+    }
+}
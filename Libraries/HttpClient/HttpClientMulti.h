@@ -0,0 +1,410 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "../Common/Function.h"
+#include "HttpClient.h"
+
+namespace SC
+{
+//! @addtogroup group_http_client
+//! @{
+
+/// @brief Event loop hooks receiving socket and timer interest changes from HttpClientMulti
+struct SC_HTTP_CLIENT_EXPORT HttpClientMultiNotifier
+{
+    /// @brief Readiness the backend is waiting for on one of its sockets
+    enum class SocketInterest : uint8_t
+    {
+        Remove,           ///< Stop monitoring the socket (it's about to be closed)
+        Readable,         ///< Call HttpClientMulti::processSocket when the socket becomes readable
+        Writable,         ///< Call HttpClientMulti::processSocket when the socket becomes writable
+        ReadableWritable, ///< Call HttpClientMulti::processSocket when the socket becomes readable or writable
+    };
+
+    virtual ~HttpClientMultiNotifier() {}
+
+    /// @brief Starts, changes or stops monitoring readiness of a backend socket
+    /// @param socket Native socket handle
+    /// @param interest Readiness to monitor, or SocketInterest::Remove to stop monitoring
+    /// @return `Result(true)` on success, otherwise an error failing the transfers using the socket
+    virtual Result watchHttpClientMultiSocket(int socket, SocketInterest interest) = 0;
+
+    /// @brief Arms the single backend timer, replacing any previously armed one
+    /// @param timeoutMilliseconds Relative timeout after which HttpClientMulti::processTimeout must be called, or a
+    /// negative value to disarm the timer
+    virtual Result setHttpClientMultiTimer(int64_t timeoutMilliseconds) = 0;
+
+    /// @brief Asks to call HttpClientMulti::dispatch from the event loop (for example after a cancellation)
+    virtual void notifyHttpClientMultiReady() = 0;
+};
+
+/// @brief Caller-owned memory for HttpClientMulti.
+struct SC_HTTP_CLIENT_EXPORT HttpClientMultiMemory
+{
+    Span<HttpClientOperation*> operations;
+    Span<uint8_t>              readyOperations; ///< One byte per operation
+};
+
+/// @brief Drives many HttpClientOperation instances from a single event loop thread.
+///
+/// On the libcurl backend all registered operations share one multi handle driven through the multi socket API:
+/// the backend reports which sockets and which single timer must be monitored to a HttpClientMultiNotifier,
+/// and the event loop calls back HttpClientMulti::processSocket and HttpClientMulti::processTimeout.
+/// No thread is created per operation and nothing is polled when there is no activity.
+///
+/// Registered operations are started with the regular HttpClientOperation::start, and their listeners are invoked by
+/// HttpClientMulti methods on the event loop thread. HttpClientOperation::poll must not be used to wait on them,
+/// and they cannot be combined with HttpClientOperationScheduler or HttpClientAsyncT that install their own notifier.
+/// Response data is never waited for: when response buffers or event queue are full the transfer is paused until
+/// the listener has consumed queued events. Request body providers are invoked on the event loop thread too, so they
+/// must not block. As libcurl hands over up to 16 KB at once, response buffers (and the event queue slots needed to
+/// reference them) must be able to hold that much.
+///
+/// HttpClientMultiAsyncT connects it to AsyncEventLoop through AsyncFileReadiness and AsyncLoopTimeout.
+/// @note Only the libcurl backend (Linux) is supported, HttpClientMulti::init fails on other backends
+struct SC_HTTP_CLIENT_EXPORT HttpClientMulti final : private HttpClientOperationNotifier
+{
+    HttpClientMulti();
+    ~HttpClientMulti();
+
+    HttpClientMulti(const HttpClientMulti&)            = delete;
+    HttpClientMulti(HttpClientMulti&&)                 = delete;
+    HttpClientMulti& operator=(const HttpClientMulti&) = delete;
+    HttpClientMulti& operator=(HttpClientMulti&&)      = delete;
+
+    /// @brief Creates the backend multi handle and registers the given (initialized) operations
+    /// @param client An initialized client
+    /// @param memory Operations to register and their ready state storage
+    /// @param notifier Receives sockets and timer to be monitored by the event loop
+    /// @note Each operation needs an event queue of at least two events
+    [[nodiscard]] Result init(HttpClient& client, const HttpClientMultiMemory& memory,
+                              HttpClientMultiNotifier& notifier);
+
+    /// @brief Stops in-flight requests without notifying their listeners and unregisters all operations
+    [[nodiscard]] Result close();
+
+    /// @brief Tells the backend that a monitored socket is ready, then dispatches resulting events
+    /// @param socket The socket passed to HttpClientMultiNotifier::watchHttpClientMultiSocket
+    /// @param readable `true` if the socket has been signaled as readable
+    /// @param writable `true` if the socket has been signaled as writable
+    /// @note Passing `false` for both lets the backend check the socket by itself
+    [[nodiscard]] Result processSocket(int socket, bool readable, bool writable);
+
+    /// @brief Tells the backend that the timer armed with HttpClientMultiNotifier::setHttpClientMultiTimer expired
+    [[nodiscard]] Result processTimeout();
+
+    /// @brief Invokes listeners of operations with queued events and resumes transfers paused by full buffers
+    [[nodiscard]] Result dispatch();
+
+    [[nodiscard]] size_t getNumOperations() const;
+    [[nodiscard]] size_t getNumRequestsInFlight() const;
+    [[nodiscard]] bool   hasRequestsInFlight() const { return getNumRequestsInFlight() > 0; }
+    [[nodiscard]] bool   isOperationRegistered(HttpClientOperation& operation) const;
+    [[nodiscard]] bool   isInitialized() const { return initialized; }
+
+    friend struct HttpClientOperation;
+    friend struct Internal;
+    struct Internal;
+
+  private:
+    friend struct HttpClientLinuxCallbacks;
+
+    virtual void notifyHttpClientOperation(HttpClientOperation& operation) override;
+
+    Result platformInit();
+    Result platformClose();
+    Result platformSocketAction(int socket, bool readable, bool writable);
+    Result platformResumePaused(HttpClientOperation& operation);
+
+    [[nodiscard]] size_t findOperationIndex(HttpClientOperation& operation) const;
+
+    HttpClient*              client   = nullptr;
+    HttpClientMultiNotifier* notifier = nullptr;
+    HttpClientMultiMemory    multiMemory;
+
+    bool initialized = false;
+    bool processing  = false; // Set while inside process* / dispatch, where ready operations are dispatched anyway
+
+    alignas(uint64_t) char storage[16];
+};
+
+/// @brief Connects HttpClientMulti to an event loop, monitoring sockets with `T_AsyncEventLoop::FileReadiness` and
+/// the backend timer with `T_AsyncEventLoop::LoopTimeout`.
+///
+/// Hundreds of concurrent operations share one event loop and one backend multi handle. A caller-provided Socket
+/// slot is needed for every concurrently open backend socket (usually one per in-flight operation), and all of them
+/// must stay at a stable address until the event loop has processed the stop requests issued by close().
+/// @tparam T_AsyncEventLoop An AsyncEventLoop-like type exposing `FileReadiness` and `LoopTimeout`
+template <typename T_AsyncEventLoop>
+struct HttpClientMultiAsyncT final : private HttpClientMultiNotifier
+{
+    using T_AsyncFileReadiness = typename T_AsyncEventLoop::FileReadiness;
+    using T_AsyncLoopTimeout   = typename T_AsyncEventLoop::LoopTimeout;
+
+    /// @brief Caller-owned readiness request for one backend socket
+    struct Socket
+    {
+      private:
+        friend struct HttpClientMultiAsyncT;
+
+        void onReady(typename T_AsyncFileReadiness::Result& result) { owner->onSocketReady(*this, result); }
+
+        T_AsyncFileReadiness   readiness;
+        HttpClientMultiAsyncT* owner = nullptr;
+
+        int            handle   = -1; // Socket assigned by the backend, -1 if the slot is unassigned
+        SocketInterest interest = SocketInterest::Remove;
+
+        bool inCallback = false;
+        bool reassigned = false; // Slot has been assigned to another socket while inside its own callback
+    };
+
+    Result init(HttpClient& client, T_AsyncEventLoop& loop, const HttpClientMultiMemory& memory, Span<Socket> sockets)
+    {
+        SC_TRY_MSG(eventLoop == nullptr, "HttpClientMultiAsyncT: already initialized");
+        SC_TRY_MSG(not sockets.empty(), "HttpClientMultiAsyncT: sockets missing");
+        socketSlots = sockets;
+        for (Socket& socket : socketSlots)
+        {
+            SC_TRY_MSG(socket.readiness.isFree(), "HttpClientMultiAsyncT: socket still in use");
+            socket.owner              = this;
+            socket.handle             = -1;
+            socket.interest           = SocketInterest::Remove;
+            socket.readiness.callback = [&socket](typename T_AsyncFileReadiness::Result& result)
+            { socket.onReady(result); };
+        }
+        timer.callback      = [this](typename T_AsyncLoopTimeout::Result& result) { onTimer(result); };
+        dispatcher.callback = [this](typename T_AsyncLoopTimeout::Result& result) { onDispatch(result); };
+        timerStopped        = [this](typename T_AsyncEventLoop::ResultType&) { onTimerStopped(); };
+
+        eventLoop = &loop;
+        const Result res = multi.init(client, memory, *this);
+        if (not res)
+        {
+            eventLoop = nullptr;
+        }
+        return res;
+    }
+
+    Result close()
+    {
+        if (eventLoop == nullptr)
+        {
+            return Result(true);
+        }
+        const Result res = multi.close();
+        for (Socket& socket : socketSlots)
+        {
+            stopSocket(socket);
+        }
+        timerArmed = false;
+        stopTimeout(timer);
+        stopTimeout(dispatcher);
+        eventLoop = nullptr;
+        return res;
+    }
+
+    [[nodiscard]] HttpClientMulti& getMulti() { return multi; }
+
+    [[nodiscard]] bool isInitialized() const { return eventLoop != nullptr; }
+
+  private:
+    virtual Result watchHttpClientMultiSocket(int handle, SocketInterest interest) override
+    {
+        Socket* socket = findSocket(handle);
+        if (interest == SocketInterest::Remove)
+        {
+            if (socket != nullptr)
+            {
+                socket->handle = -1;
+                stopSocket(*socket);
+            }
+            return Result(true);
+        }
+        if (socket != nullptr)
+        {
+            if (getMode(socket->interest) == getMode(interest) or socket->inCallback)
+            {
+                // Direction changes of a socket in its own callback are applied when the callback returns
+                socket->interest = interest;
+                return Result(true);
+            }
+            // A FileReadiness can't be restarted until its stop has been processed, so use another slot
+            socket->handle = -1;
+            stopSocket(*socket);
+        }
+        socket = findFreeSocket();
+        SC_TRY_MSG(socket != nullptr, "HttpClientMultiAsyncT: sockets exhausted");
+        socket->handle   = handle;
+        socket->interest = interest;
+        if (socket->inCallback)
+        {
+            socket->reassigned = true; // Started when its callback returns
+            return Result(true);
+        }
+        return socket->readiness.start(*eventLoop, handle, getMode(interest));
+    }
+
+    virtual Result setHttpClientMultiTimer(int64_t timeoutMilliseconds) override
+    {
+        if (timeoutMilliseconds < 0)
+        {
+            timerArmed = false;
+            return stopTimer();
+        }
+        const int64_t now = eventLoop->getLoopTime().milliseconds;
+
+        timerArmed    = true;
+        timerDeadline = now + timeoutMilliseconds;
+        if (timer.isFree())
+        {
+            timerExpiration = timerDeadline;
+            return timer.start(*eventLoop, TimeMs{timeoutMilliseconds});
+        }
+        if (timerExpiration > timerDeadline)
+        {
+            // An earlier deadline needs a restart, that happens once the stop has been processed
+            return stopTimer();
+        }
+        // Otherwise the running timer expires first and it re-arms itself for the remaining time
+        return Result(true);
+    }
+
+    virtual void notifyHttpClientMultiReady() override
+    {
+        if (dispatcher.isFree())
+        {
+            (void)dispatcher.start(*eventLoop, TimeMs{0});
+        }
+    }
+
+    void onSocketReady(Socket& socket, typename T_AsyncFileReadiness::Result& result)
+    {
+        const int            handle   = socket.handle;
+        const SocketInterest interest = socket.interest;
+
+        socket.inCallback = true;
+        socket.reassigned = false;
+        // Both directions are watched through a single (writable) readiness request, so let the backend find out
+        const bool readable = interest == SocketInterest::Readable;
+        const bool writable = interest == SocketInterest::Writable;
+        (void)multi.processSocket(handle, readable, writable);
+        socket.inCallback = false;
+
+        if (socket.handle == -1)
+        {
+            return; // Socket has been removed
+        }
+        if (not socket.reassigned and socket.handle == handle and getMode(socket.interest) == getMode(interest))
+        {
+            result.reactivateRequest(true);
+            return;
+        }
+        if (not socket.readiness.start(*eventLoop, socket.handle, getMode(socket.interest)))
+        {
+            socket.handle = -1;
+        }
+    }
+
+    void onTimer(typename T_AsyncLoopTimeout::Result&)
+    {
+        if (not timerArmed)
+        {
+            return;
+        }
+        const int64_t now = eventLoop->getLoopTime().milliseconds;
+        if (now < timerDeadline)
+        {
+            timerExpiration = timerDeadline;
+            (void)timer.start(*eventLoop, TimeMs{timerDeadline - now});
+            return;
+        }
+        timerArmed = false; // The backend re-arms it when needed
+        (void)multi.processTimeout();
+    }
+
+    void onTimerStopped()
+    {
+        if (timerArmed and timer.isFree())
+        {
+            const int64_t now = eventLoop->getLoopTime().milliseconds;
+            timerExpiration   = timerDeadline;
+            (void)timer.start(*eventLoop, TimeMs{timerDeadline > now ? timerDeadline - now : 0});
+        }
+    }
+
+    void onDispatch(typename T_AsyncLoopTimeout::Result&) { (void)multi.dispatch(); }
+
+    static typename T_AsyncFileReadiness::Mode getMode(SocketInterest interest)
+    {
+        return interest == SocketInterest::Readable ? T_AsyncFileReadiness::Mode::Readable
+                                                    : T_AsyncFileReadiness::Mode::Writable;
+    }
+
+    Socket* findSocket(int handle)
+    {
+        for (Socket& socket : socketSlots)
+        {
+            if (socket.handle == handle)
+            {
+                return &socket;
+            }
+        }
+        return nullptr;
+    }
+
+    Socket* findFreeSocket()
+    {
+        for (Socket& socket : socketSlots)
+        {
+            if (socket.handle == -1 and socket.readiness.isFree())
+            {
+                return &socket;
+            }
+        }
+        return nullptr;
+    }
+
+    void stopSocket(Socket& socket)
+    {
+        // A socket inside its callback is not reactivated, that is enough to stop it
+        if (not socket.inCallback and not socket.readiness.isFree() and not socket.readiness.isCancelling())
+        {
+            (void)socket.readiness.stop(*eventLoop);
+        }
+    }
+
+    Result stopTimer()
+    {
+        if (not timer.isFree() and not timer.isCancelling())
+        {
+            SC_TRY(timer.stop(*eventLoop, &timerStopped));
+        }
+        return Result(true);
+    }
+
+    void stopTimeout(T_AsyncLoopTimeout& timeout)
+    {
+        if (not timeout.isFree() and not timeout.isCancelling())
+        {
+            (void)timeout.stop(*eventLoop);
+        }
+    }
+
+    HttpClientMulti   multi;
+    T_AsyncEventLoop* eventLoop = nullptr;
+    Span<Socket>      socketSlots;
+
+    T_AsyncLoopTimeout timer;      // Backend timer
+    T_AsyncLoopTimeout dispatcher; // Defers dispatching events queued outside of loop callbacks
+
+    Function<void(typename T_AsyncEventLoop::ResultType&)> timerStopped; // Restarts timer after an earlier deadline
+
+    int64_t timerDeadline   = 0; // Absolute loop time requested by the backend
+    int64_t timerExpiration = 0; // Absolute loop time when the running timer expires
+    bool    timerArmed      = false;
+};
+
+//! @}
+} // namespace SC
@@ -22,9 +22,16 @@ struct SC::HttpClientOperation::Internal
     bool      workerThreadStarted = false;
     bool      cancelRequested     = false;
     bool      responseHeadSeen    = false;
+    bool      multiAdded          = false; // curlHandle is attached to HttpClientMulti::Internal::multiHandle
+    bool      responsePaused      = false; // curlWriteCallback returned CURL_WRITEFUNC_PAUSE
     Result    callbackError       = Result(true);
 };
 
+struct SC::HttpClientMulti::Internal
+{
+    CURLM* multiHandle = nullptr;
+};
+
 namespace
 {
 static SC::Result appendResponseHeaderLine(SC::HttpClientResponse& response, const char* data, size_t size)
@@ -218,11 +225,29 @@ struct HttpClientLinuxCallbacks
             return 0;
         }
 
+        HttpClientOperation::Internal& internal = *reinterpret_cast<HttpClientOperation::Internal*>(operation->storage);
+        if (operation->multi != nullptr)
+        {
+            // Event loop thread can't block waiting for the listener to release buffers, so pause the transfer
+            // and let HttpClientMulti::dispatch resume it after draining queued events.
+            bool         enqueued   = false;
+            const Result enqueueRes = operation->tryEnqueueResponseDataCopy({ptr, totalSize}, enqueued);
+            if (not enqueueRes)
+            {
+                internal.callbackError = enqueueRes;
+                return 0;
+            }
+            if (not enqueued)
+            {
+                internal.responsePaused = true;
+                return CURL_WRITEFUNC_PAUSE;
+            }
+            return totalSize;
+        }
+
         const Result enqueueRes = operation->enqueueResponseDataCopy({ptr, totalSize});
         if (not enqueueRes)
         {
-            HttpClientOperation::Internal& internal =
-                *reinterpret_cast<HttpClientOperation::Internal*>(operation->storage);
             internal.callbackError = enqueueRes;
             return 0;
         }
@@ -265,6 +290,85 @@ struct HttpClientLinuxCallbacks
         HttpClientOperation::Internal& internal = *reinterpret_cast<HttpClientOperation::Internal*>(operation->storage);
         return internal.cancelRequested ? 1 : 0;
     }
+
+    static int curlMultiSocketCallback(CURL*, curl_socket_t socket, int what, void* userp, void*)
+    {
+        HttpClientMulti& multi = *reinterpret_cast<HttpClientMulti*>(userp);
+
+        HttpClientMultiNotifier::SocketInterest interest = HttpClientMultiNotifier::SocketInterest::Remove;
+        switch (what)
+        {
+        case CURL_POLL_IN: interest = HttpClientMultiNotifier::SocketInterest::Readable; break;
+        case CURL_POLL_OUT: interest = HttpClientMultiNotifier::SocketInterest::Writable; break;
+        case CURL_POLL_INOUT: interest = HttpClientMultiNotifier::SocketInterest::ReadableWritable; break;
+        default: break;
+        }
+        return multi.notifier->watchHttpClientMultiSocket(socket, interest) ? 0 : -1;
+    }
+
+    static int curlMultiTimerCallback(CURLM*, long timeoutMs, void* userp)
+    {
+        HttpClientMulti& multi = *reinterpret_cast<HttpClientMulti*>(userp);
+        return multi.notifier->setHttpClientMultiTimer(static_cast<int64_t>(timeoutMs)) ? 0 : -1;
+    }
+
+    /// @brief Enqueues the terminal events of a transfer once curl has finished with it (worker or multi mode)
+    static void completeTransfer(HttpClientOperation& operation, int res)
+    {
+        auto& session  = *reinterpret_cast<HttpClient::Internal*>(operation.client->storage);
+        auto& internal = *reinterpret_cast<HttpClientOperation::Internal*>(operation.storage);
+
+        if (not internal.responseHeadSeen and operation.currentResponse != nullptr)
+        {
+            long httpCode = 0;
+            session.curl.curl_easy_getinfo_long(internal.curlHandle, CURLINFO_RESPONSE_CODE, &httpCode);
+            operation.currentResponse->statusCode = static_cast<int>(httpCode);
+            updateNegotiatedProtocol(operation);
+            long redirectCount = 0;
+            (void)session.curl.curl_easy_getinfo_long(internal.curlHandle, CURLINFO_REDIRECT_COUNT, &redirectCount);
+            operation.currentResponse->redirectCount = static_cast<uint32_t>(redirectCount < 0 ? 0 : redirectCount);
+            char* effectiveUrl = nullptr;
+            if (session.curl.curl_easy_getinfo_ptr(internal.curlHandle, CURLINFO_EFFECTIVE_URL, &effectiveUrl) ==
+                    CURLE_OK and
+                effectiveUrl != nullptr)
+            {
+                const Result effectiveUrlError = operation.copyResponseEffectiveUrl(
+                    StringSpan::fromNullTerminated(effectiveUrl, operation.currentRequest.url.getEncoding()));
+                if (not effectiveUrlError)
+                {
+                    operation.enqueueError(effectiveUrlError);
+                    return;
+                }
+            }
+            if (isHttp2Required(operation) and
+                operation.currentResponse->negotiatedProtocol != HttpClientResponse::Protocol::Http2)
+            {
+                operation.enqueueError(Result::Error("HttpClient: HTTP/2 required but not negotiated"));
+                return;
+            }
+            operation.enqueueResponseHead();
+        }
+
+        if (res != CURLE_OK)
+        {
+            if (not internal.callbackError)
+            {
+                operation.enqueueError(internal.callbackError);
+            }
+            else if (internal.cancelRequested)
+            {
+                operation.enqueueError(Result::Error("HttpClient: request cancelled"));
+            }
+            else
+            {
+                operation.enqueueError(Result::Error("HttpClient: curl_easy_perform failed"));
+            }
+        }
+        else
+        {
+            operation.enqueueResponseComplete();
+        }
+    }
 };
 } // namespace SC
 
@@ -326,6 +430,12 @@ SC::Result SC::HttpClientOperation::platformClose()
 {
     auto& session  = *reinterpret_cast<HttpClient::Internal*>(client->storage);
     auto& internal = *reinterpret_cast<Internal*>(storage);
+    if (internal.multiAdded)
+    {
+        auto& multiInternal = *reinterpret_cast<HttpClientMulti::Internal*>(multi->storage);
+        (void)session.curl.curl_multi_remove_handle(multiInternal.multiHandle, internal.curlHandle);
+        internal.multiAdded = false;
+    }
     if (internal.workerThreadStarted)
     {
         (void)pthread_join(internal.workerThread, nullptr);
@@ -344,13 +454,26 @@ SC::Result SC::HttpClientOperation::platformClose()
     }
     internal.cancelRequested  = false;
     internal.responseHeadSeen = false;
+    internal.responsePaused   = false;
     internal.callbackError    = Result(true);
     return Result(true);
 }
 
 SC::Result SC::HttpClientOperation::platformCancel()
 {
-    reinterpret_cast<Internal*>(storage)->cancelRequested = true;
+    auto& internal           = *reinterpret_cast<Internal*>(storage);
+    internal.cancelRequested = true;
+    if (internal.multiAdded)
+    {
+        // No worker thread polls cancelRequested in multi mode: detach the transfer and report it right away
+        auto& session       = *reinterpret_cast<HttpClient::Internal*>(client->storage);
+        auto& multiInternal = *reinterpret_cast<HttpClientMulti::Internal*>(multi->storage);
+        (void)session.curl.curl_multi_remove_handle(multiInternal.multiHandle, internal.curlHandle);
+        internal.multiAdded     = false;
+        internal.responsePaused = false;
+        discardPendingEvents();
+        enqueueError(Result::Error("HttpClient: request cancelled"));
+    }
     return Result(true);
 }
 
@@ -358,10 +481,11 @@ SC::Result SC::HttpClientOperation::platformStart()
 {
     auto& session  = *reinterpret_cast<HttpClient::Internal*>(client->storage);
     auto& internal = *reinterpret_cast<Internal*>(storage);
-    SC_TRY_MSG(not internal.workerRunning, "HttpClient: request already in flight");
+    SC_TRY_MSG(not internal.workerRunning and not internal.multiAdded, "HttpClient: request already in flight");
 
     internal.cancelRequested  = false;
     internal.responseHeadSeen = false;
+    internal.responsePaused   = false;
     internal.callbackError    = Result(true);
 
     CURL* curlHandle = internal.curlHandle;
@@ -549,6 +673,17 @@ SC::Result SC::HttpClientOperation::platformStart()
         }
     }
 
+    if (multi != nullptr)
+    {
+        // The transfer is driven by HttpClientMulti on the event loop thread instead of a worker thread
+        auto& multiInternal = *reinterpret_cast<HttpClientMulti::Internal*>(multi->storage);
+        session.curl.curl_easy_setopt_ptr(curlHandle, CURLOPT_PRIVATE, this);
+        SC_TRY_MSG(session.curl.curl_multi_add_handle(multiInternal.multiHandle, curlHandle) == CURLM_OK,
+                   "HttpClientMulti: curl_multi_add_handle failed");
+        internal.multiAdded = true;
+        return Result(true);
+    }
+
     internal.workerRunning   = true;
     const int workerStartRes = pthread_create(
         &internal.workerThread, nullptr,
@@ -560,61 +695,7 @@ SC::Result SC::HttpClientOperation::platformStart()
             auto& internalRef = *reinterpret_cast<Internal*>(operation->storage);
 
             const int res = sessionRef.curl.curl_easy_perform(internalRef.curlHandle);
-
-            if (not internalRef.responseHeadSeen and operation->currentResponse != nullptr)
-            {
-                long httpCode = 0;
-                sessionRef.curl.curl_easy_getinfo_long(internalRef.curlHandle, CURLINFO_RESPONSE_CODE, &httpCode);
-                operation->currentResponse->statusCode = static_cast<int>(httpCode);
-                HttpClientLinuxCallbacks::updateNegotiatedProtocol(*operation);
-                long redirectCount = 0;
-                (void)sessionRef.curl.curl_easy_getinfo_long(internalRef.curlHandle, CURLINFO_REDIRECT_COUNT,
-                                                             &redirectCount);
-                operation->currentResponse->redirectCount =
-                    static_cast<uint32_t>(redirectCount < 0 ? 0 : redirectCount);
-                char* effectiveUrl = nullptr;
-                if (sessionRef.curl.curl_easy_getinfo_ptr(internalRef.curlHandle, CURLINFO_EFFECTIVE_URL,
-                                                          &effectiveUrl) == CURLE_OK and
-                    effectiveUrl != nullptr)
-                {
-                    const Result effectiveUrlError = operation->copyResponseEffectiveUrl(
-                        StringSpan::fromNullTerminated(effectiveUrl, operation->currentRequest.url.getEncoding()));
-                    if (not effectiveUrlError)
-                    {
-                        operation->enqueueError(effectiveUrlError);
-                        internalRef.workerRunning = false;
-                        return nullptr;
-                    }
-                }
-                if (HttpClientLinuxCallbacks::isHttp2Required(*operation) and
-                    operation->currentResponse->negotiatedProtocol != HttpClientResponse::Protocol::Http2)
-                {
-                    operation->enqueueError(Result::Error("HttpClient: HTTP/2 required but not negotiated"));
-                    internalRef.workerRunning = false;
-                    return nullptr;
-                }
-                operation->enqueueResponseHead();
-            }
-
-            if (res != CURLE_OK)
-            {
-                if (not internalRef.callbackError)
-                {
-                    operation->enqueueError(internalRef.callbackError);
-                }
-                else if (internalRef.cancelRequested)
-                {
-                    operation->enqueueError(Result::Error("HttpClient: request cancelled"));
-                }
-                else
-                {
-                    operation->enqueueError(Result::Error("HttpClient: curl_easy_perform failed"));
-                }
-            }
-            else
-            {
-                operation->enqueueResponseComplete();
-            }
+            HttpClientLinuxCallbacks::completeTransfer(*operation, res);
             internalRef.workerRunning = false;
             return nullptr;
         },
@@ -628,3 +709,127 @@ SC::Result SC::HttpClientOperation::platformStart()
 
     return Result(true);
 }
+
+SC::HttpClientMulti::HttpClientMulti()
+{
+    static_assert(sizeof(Internal) <= sizeof(storage), "Linux HttpClientMulti storage too small");
+    static_assert(alignof(Internal) <= alignof(uint64_t), "Linux HttpClientMulti alignment mismatch");
+    SC::placementNew(*reinterpret_cast<Internal*>(storage));
+}
+
+SC::HttpClientMulti::~HttpClientMulti()
+{
+    if (initialized)
+    {
+        (void)close();
+    }
+    reinterpret_cast<Internal*>(storage)->~Internal();
+}
+
+SC::Result SC::HttpClientMulti::platformInit()
+{
+    auto& session  = *reinterpret_cast<HttpClient::Internal*>(client->storage);
+    auto& internal = *reinterpret_cast<Internal*>(storage);
+    SC_TRY_MSG(session.curl.hasMultiSocket(), "HttpClientMulti: libcurl multi socket interface not available");
+    internal.multiHandle = session.curl.curl_multi_init();
+    SC_TRY_MSG(internal.multiHandle != nullptr, "HttpClientMulti: curl_multi_init failed");
+
+    using Callbacks = HttpClientLinuxCallbacks;
+    CURLM* handle   = internal.multiHandle;
+    if (session.curl.curl_multi_setopt_ptr(handle, CURLMOPT_SOCKETFUNCTION,
+                                           reinterpret_cast<void*>(&Callbacks::curlMultiSocketCallback)) != CURLM_OK or
+        session.curl.curl_multi_setopt_ptr(handle, CURLMOPT_SOCKETDATA, this) != CURLM_OK or
+        session.curl.curl_multi_setopt_ptr(handle, CURLMOPT_TIMERFUNCTION,
+                                           reinterpret_cast<void*>(&Callbacks::curlMultiTimerCallback)) != CURLM_OK or
+        session.curl.curl_multi_setopt_ptr(handle, CURLMOPT_TIMERDATA, this) != CURLM_OK)
+    {
+        (void)session.curl.curl_multi_cleanup(handle);
+        internal.multiHandle = nullptr;
+        return Result::Error("HttpClientMulti: curl_multi_setopt failed");
+    }
+    return Result(true);
+}
+
+SC::Result SC::HttpClientMulti::platformClose()
+{
+    auto& session  = *reinterpret_cast<HttpClient::Internal*>(client->storage);
+    auto& internal = *reinterpret_cast<Internal*>(storage);
+    for (HttpClientOperation* operation : multiMemory.operations)
+    {
+        auto& operationInternal = *reinterpret_cast<HttpClientOperation::Internal*>(operation->storage);
+        if (operation->multi == this and operationInternal.multiAdded)
+        {
+            (void)session.curl.curl_multi_remove_handle(internal.multiHandle, operationInternal.curlHandle);
+            operationInternal.multiAdded     = false;
+            operationInternal.responsePaused = false;
+        }
+    }
+    if (internal.multiHandle != nullptr)
+    {
+        (void)session.curl.curl_multi_cleanup(internal.multiHandle);
+        internal.multiHandle = nullptr;
+    }
+    return Result(true);
+}
+
+SC::Result SC::HttpClientMulti::platformSocketAction(int socket, bool readable, bool writable)
+{
+    auto& session  = *reinterpret_cast<HttpClient::Internal*>(client->storage);
+    auto& internal = *reinterpret_cast<Internal*>(storage);
+
+    const int eventMask      = (readable ? CURL_CSELECT_IN : 0) | (writable ? CURL_CSELECT_OUT : 0);
+    int       runningHandles = 0;
+    const int actionRes =
+        session.curl.curl_multi_socket_action(internal.multiHandle, socket, eventMask, &runningHandles);
+    SC_TRY_MSG(actionRes == CURLM_OK, "HttpClientMulti: curl_multi_socket_action failed");
+
+    int      messagesInQueue = 0;
+    CURLMsg* message         = nullptr;
+    while ((message = session.curl.curl_multi_info_read(internal.multiHandle, &messagesInQueue)) != nullptr)
+    {
+        if (message->msg != CURLMSG_DONE)
+        {
+            continue;
+        }
+        CURL*     easyHandle  = message->easy_handle;
+        const int transferRes = static_cast<int>(message->data.result);
+
+        HttpClientOperation* operation = nullptr;
+        (void)session.curl.curl_easy_getinfo_ptr(easyHandle, CURLINFO_PRIVATE, &operation);
+        // Removing the handle invalidates message, so everything needed has been copied out above
+        (void)session.curl.curl_multi_remove_handle(internal.multiHandle, easyHandle);
+        if (operation == nullptr)
+        {
+            continue;
+        }
+        auto& operationInternal          = *reinterpret_cast<HttpClientOperation::Internal*>(operation->storage);
+        operationInternal.multiAdded     = false;
+        operationInternal.responsePaused = false;
+
+        // Terminal events (head + complete or error) need two free slots, that can't be waited for on this thread
+        if (operation->eventQueue.sizeInElements() - operation->eventCount < 2)
+        {
+            SC_TRY(operation->processPendingEvents());
+        }
+        if (operation->multi != this or not operation->requestInFlight)
+        {
+            continue; // listener closed or cancelled the operation while draining its events
+        }
+        HttpClientLinuxCallbacks::completeTransfer(*operation, transferRes);
+    }
+    return Result(true);
+}
+
+SC::Result SC::HttpClientMulti::platformResumePaused(HttpClientOperation& operation)
+{
+    auto& session           = *reinterpret_cast<HttpClient::Internal*>(client->storage);
+    auto& operationInternal = *reinterpret_cast<HttpClientOperation::Internal*>(operation.storage);
+    if (not operationInternal.responsePaused or not operationInternal.multiAdded)
+    {
+        return Result(true);
+    }
+    operationInternal.responsePaused = false;
+    SC_TRY_MSG(session.curl.curl_easy_pause(operationInternal.curlHandle, CURLPAUSE_CONT) == CURLE_OK,
+               "HttpClientMulti: curl_easy_pause failed");
+    return Result(true);
+}
@@ -57,6 +57,7 @@ typedef int CURLoption;
 #define CURLOPT_HTTP_VERSION     (CURLOPTTYPE_VALUES + 84)
 #define CURLOPT_PROXY            (CURLOPTTYPE_OBJECTPOINT + 4)
 #define CURLOPT_NOPROXY          (CURLOPTTYPE_OBJECTPOINT + 177)
+#define CURLOPT_PRIVATE          (CURLOPTTYPE_OBJECTPOINT + 103)
 
 #define CURL_HTTP_VERSION_NONE              0
 #define CURL_HTTP_VERSION_1_0               1
@@ -72,8 +73,50 @@ typedef int CURLINFO;
 #define CURLINFO_RESPONSE_CODE              (CURLINFO_LONG + 2)
 #define CURLINFO_REDIRECT_COUNT             (CURLINFO_LONG + 20)
 #define CURLINFO_HTTP_VERSION               (CURLINFO_LONG + 46)
+#define CURLINFO_PRIVATE                    (CURLINFO_STRING + 21)
+
+#define CURL_READFUNC_ABORT  0x10000000
+#define CURL_WRITEFUNC_PAUSE 0x10000001
+#define CURLPAUSE_CONT       0
+
+// Multi socket interface
+typedef int curl_socket_t;
+typedef int CURLMcode;
+#define CURLM_OK 0
+
+typedef int CURLMoption;
+#define CURLMOPT_SOCKETFUNCTION (CURLOPTTYPE_FUNCTIONPOINT + 1)
+#define CURLMOPT_SOCKETDATA     (CURLOPTTYPE_OBJECTPOINT + 2)
+#define CURLMOPT_TIMERFUNCTION  (CURLOPTTYPE_FUNCTIONPOINT + 4)
+#define CURLMOPT_TIMERDATA      (CURLOPTTYPE_OBJECTPOINT + 5)
+
+#define CURL_SOCKET_TIMEOUT (-1)
+#define CURL_POLL_NONE      0
+#define CURL_POLL_IN        1
+#define CURL_POLL_OUT       2
+#define CURL_POLL_INOUT     3
+#define CURL_POLL_REMOVE    4
+#define CURL_CSELECT_IN     0x01
+#define CURL_CSELECT_OUT    0x02
+#define CURL_CSELECT_ERR    0x04
+
+typedef enum
+{
+    CURLMSG_NONE,
+    CURLMSG_DONE,
+    CURLMSG_LAST
+} CURLMSG;
 
-#define CURL_READFUNC_ABORT 0x10000000
+struct CURLMsg
+{
+    CURLMSG msg;
+    CURL*   easy_handle;
+    union
+    {
+        void*    whatever;
+        CURLcode result;
+    } data;
+};
 
 struct curl_slist
 {
@@ -101,8 +144,25 @@ struct HttpClientLinuxLibCurlLoader
     struct curl_slist* (*curl_slist_append)(struct curl_slist*, const char*) = nullptr;
     void (*curl_slist_free_all)(struct curl_slist*)                          = nullptr;
 
+    // Multi socket interface (optional, only needed by HttpClientMulti)
+    CURLM* (*curl_multi_init)()                                       = nullptr;
+    int (*curl_multi_cleanup)(CURLM*)                                 = nullptr;
+    int (*curl_multi_add_handle)(CURLM*, CURL*)                       = nullptr;
+    int (*curl_multi_remove_handle)(CURLM*, CURL*)                    = nullptr;
+    int (*curl_multi_setopt_ptr)(CURLM*, int, const void*)            = nullptr;
+    int (*curl_multi_socket_action)(CURLM*, curl_socket_t, int, int*) = nullptr;
+    struct CURLMsg* (*curl_multi_info_read)(CURLM*, int*)             = nullptr;
+    int (*curl_easy_pause)(CURL*, int)                                = nullptr;
+
     bool isValid() const { return libcurlHandle != nullptr; }
 
+    bool hasMultiSocket() const
+    {
+        return curl_multi_init != nullptr and curl_multi_cleanup != nullptr and curl_multi_add_handle != nullptr and
+               curl_multi_remove_handle != nullptr and curl_multi_setopt_ptr != nullptr and
+               curl_multi_socket_action != nullptr and curl_multi_info_read != nullptr and curl_easy_pause != nullptr;
+    }
+
     [[nodiscard]] bool init()
     {
         if (libcurlHandle)
@@ -133,6 +193,17 @@ struct HttpClientLinuxLibCurlLoader
         curl_easy_getinfo_long = reinterpret_cast<decltype(curl_easy_getinfo_long)>(getinfo);
         curl_easy_getinfo_ptr  = reinterpret_cast<decltype(curl_easy_getinfo_ptr)>(getinfo);
 
+        // clang-format off
+        curl_multi_init          = reinterpret_cast<decltype(curl_multi_init)>(::dlsym(libcurlHandle, "curl_multi_init"));
+        curl_multi_cleanup       = reinterpret_cast<decltype(curl_multi_cleanup)>(::dlsym(libcurlHandle, "curl_multi_cleanup"));
+        curl_multi_add_handle    = reinterpret_cast<decltype(curl_multi_add_handle)>(::dlsym(libcurlHandle, "curl_multi_add_handle"));
+        curl_multi_remove_handle = reinterpret_cast<decltype(curl_multi_remove_handle)>(::dlsym(libcurlHandle, "curl_multi_remove_handle"));
+        curl_multi_setopt_ptr    = reinterpret_cast<decltype(curl_multi_setopt_ptr)>(::dlsym(libcurlHandle, "curl_multi_setopt"));
+        curl_multi_socket_action = reinterpret_cast<decltype(curl_multi_socket_action)>(::dlsym(libcurlHandle, "curl_multi_socket_action"));
+        curl_multi_info_read     = reinterpret_cast<decltype(curl_multi_info_read)>(::dlsym(libcurlHandle, "curl_multi_info_read"));
+        curl_easy_pause          = reinterpret_cast<decltype(curl_easy_pause)>(::dlsym(libcurlHandle, "curl_easy_pause"));
+        // clang-format on
+
         // Verify essential symbols
         if (curl_easy_init == nullptr or curl_easy_cleanup == nullptr or curl_easy_perform == nullptr)
         {
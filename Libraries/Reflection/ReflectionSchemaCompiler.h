@@ -35,6 +35,21 @@ struct SchemaCompiler
         ArrayWithSize<TypeInfo, NUM_TYPES>       typeInfos;
         ArrayWithSize<TypeStringView, NUM_TYPES> typeNames;
         VirtualTablesType                        vtables;
+
+        /// @brief Computes a 64 bit FNV-1a hash of typeInfos, identifying memory layout of all types in the schema.
+        /// Two schemas with the same hash describe the same sizes, offsets, categories and packing of all members.
+        [[nodiscard]] uint64_t hashTypeInfos() const
+        {
+            const unsigned char* bytes    = reinterpret_cast<const unsigned char*>(typeInfos.values);
+            const size_t         numBytes = typeInfos.size * sizeof(TypeInfo);
+
+            uint64_t hash = 14695981039346656037ULL;
+            for (size_t idx = 0; idx < numBytes; ++idx)
+            {
+                hash = (hash ^ bytes[idx]) * 1099511628211ULL;
+            }
+            return hash;
+        }
     };
     template <typename Iterator, typename BinaryPredicate>
     static constexpr void bubbleSort(Iterator first, Iterator last, BinaryPredicate predicate)
@@ -23,7 +23,8 @@ struct SerializationBinaryWriter
 {
     T& buffer; ///< The underlying buffer holding serialization data
 
-    size_t numberOfOperations = 0; ///< How many read or write operations have been issued so far
+    size_t numberOfOperations = 0;     ///< How many read or write operations have been issued so far
+    bool   isCompact          = false; ///< Encodes integers as varints (SerializationBinaryEncoding::Compact)
     SerializationBinaryWriter(T& buffer) : buffer(buffer) {}
 
     /// @brief Write given object to buffer
@@ -42,6 +43,23 @@ struct SerializationBinaryWriter
         numberOfOperations++;
         return buffer.append(object);
     }
+
+    /// @brief Write value as LEB128 varint (7 bits per byte, with high bit set when more bytes follow)
+    /// @param value The value to write
+    /// @return `true` if write succeeded
+    [[nodiscard]] bool serializeVarint(uint64_t& value)
+    {
+        char     encoded[10];
+        size_t   numBytes  = 0;
+        uint64_t remaining = value;
+        while (remaining >= 0x80)
+        {
+            encoded[numBytes++] = static_cast<char>((remaining & 0x7f) | 0x80);
+            remaining >>= 7;
+        }
+        encoded[numBytes++] = static_cast<char>(remaining);
+        return serializeBytes({encoded, numBytes});
+    }
 };
 
 /// @brief A binary serialization bytes reader reading from a span of memory
@@ -49,8 +67,9 @@ struct SerializationBinaryReader
 {
     Span<const char> memory;
 
-    size_t numberOfOperations = 0; ///< How many read or write operations have been issued so far
-    size_t readPosition       = 0; ///< Current read  position in the buffer
+    size_t numberOfOperations = 0;     ///< How many read or write operations have been issued so far
+    size_t readPosition       = 0;     ///< Current read  position in the buffer
+    bool   isCompact          = false; ///< Decodes integers as varints (SerializationBinaryEncoding::Compact)
 
     SerializationBinaryReader(Span<const char> memory) : memory(memory) {}
 
@@ -85,6 +104,31 @@ struct SerializationBinaryReader
         return true;
     }
 
+    /// @brief Read a LEB128 varint written by SerializationBinaryWriter::serializeVarint. Updates readPosition
+    /// @param value Receives the decoded value
+    /// @return `true` if a complete and minimally encoded varint fitting 64 bits has been read
+    [[nodiscard]] bool serializeVarint(uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7)
+        {
+            if (readPosition >= memory.sizeInBytes())
+                return false;
+            const uint64_t byte = static_cast<uint8_t>(memory.data()[readPosition++]);
+            if (shift == 63 and byte > 1)
+                return false; // Exceeding 64 bits
+            value |= (byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                if (byte == 0 and shift > 0)
+                    return false; // Non-canonical encoding (trailing zero byte), never written by the writer
+                numberOfOperations++;
+                return true;
+            }
+        }
+        return false;
+    }
+
     /// @brief Advance read position by numBytes
     /// @param numBytes How many bytes to advance read position of
     /// @return `true` if size of buffer has not been exceeded.
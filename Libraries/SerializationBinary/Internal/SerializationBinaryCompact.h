@@ -0,0 +1,102 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../../Common/Result.h"
+#include "../../Reflection/Reflection.h"
+
+namespace SC
+{
+namespace Serialization
+{
+/// @brief Reads or writes a primitive with native representation, used by SerializationBinaryEncoding::Compact for
+/// floats, bools and single byte integers.
+template <typename T>
+struct SerializerBinaryCompactRaw
+{
+    static constexpr bool IsVarint = false;
+
+    template <typename BinaryStream>
+    [[nodiscard]] static bool serialize(T& object, BinaryStream& stream)
+    {
+        return stream.serializeBytes(&object, sizeof(T));
+    }
+};
+
+/// @brief Reads or writes an unsigned integer as LEB128 varint, failing when the decoded value doesn't fit `T`
+template <typename T>
+struct SerializerBinaryCompactUnsigned
+{
+    static constexpr bool IsVarint = true;
+
+    template <typename BinaryStream>
+    [[nodiscard]] static bool serialize(T& object, BinaryStream& stream)
+    {
+        uint64_t value = static_cast<uint64_t>(object);
+        SC_TRY(stream.serializeVarint(value));
+        object = static_cast<T>(value);
+        return static_cast<uint64_t>(object) == value;
+    }
+};
+
+/// @brief Reads or writes a signed integer as zigzag encoded LEB128 varint, so that small negative values are short
+template <typename T>
+struct SerializerBinaryCompactSigned
+{
+    static constexpr bool IsVarint = true;
+
+    template <typename BinaryStream>
+    [[nodiscard]] static bool serialize(T& object, BinaryStream& stream)
+    {
+        const int64_t signedValue = static_cast<int64_t>(object);
+        uint64_t value = (static_cast<uint64_t>(signedValue) << 1) ^ static_cast<uint64_t>(signedValue >> 63);
+        SC_TRY(stream.serializeVarint(value));
+        const int64_t decoded = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        object                = static_cast<T>(decoded);
+        return static_cast<int64_t>(object) == decoded;
+    }
+};
+
+// clang-format off
+template <typename T> struct SerializerBinaryCompact : public SerializerBinaryCompactRaw<T> {};
+template <> struct SerializerBinaryCompact<uint16_t> : public SerializerBinaryCompactUnsigned<uint16_t> {};
+template <> struct SerializerBinaryCompact<uint32_t> : public SerializerBinaryCompactUnsigned<uint32_t> {};
+template <> struct SerializerBinaryCompact<uint64_t> : public SerializerBinaryCompactUnsigned<uint64_t> {};
+template <> struct SerializerBinaryCompact<int16_t>  : public SerializerBinaryCompactSigned<int16_t> {};
+template <> struct SerializerBinaryCompact<int32_t>  : public SerializerBinaryCompactSigned<int32_t> {};
+template <> struct SerializerBinaryCompact<int64_t>  : public SerializerBinaryCompactSigned<int64_t> {};
+// clang-format on
+
+/// @brief Checks if items of type `T` can be copied in a single operation using the encoding of `stream`
+template <typename T, typename BinaryStream>
+[[nodiscard]] constexpr bool serializerBinaryCanCopyItems(const BinaryStream& stream)
+{
+    return Reflection::ExtendedTypeInfo<T>::IsPacked and
+           (not stream.isCompact or (Reflection::IsPrimitive<T>::value and not SerializerBinaryCompact<T>::IsVarint));
+}
+
+/// @brief Checks if a primitive of given category is stored as varint by SerializationBinaryEncoding::Compact
+[[nodiscard]] constexpr bool serializerBinaryIsVarint(Reflection::TypeCategory category)
+{
+    return (category >= Reflection::TypeCategory::TypeUINT16 and category <= Reflection::TypeCategory::TypeUINT64) or
+           (category >= Reflection::TypeCategory::TypeINT16 and category <= Reflection::TypeCategory::TypeINT64);
+}
+
+/// @brief Reads or writes size of a container holding items of `itemSize` bytes.
+/// Native encoding stores the size in bytes, while compact encoding stores number of items as varint.
+template <typename BinaryStream>
+[[nodiscard]] bool serializerBinaryContainerSize(BinaryStream& stream, uint64_t& sizeInBytes, size_t itemSize)
+{
+    if (not stream.isCompact)
+    {
+        return stream.serializeBytes(&sizeInBytes, sizeof(sizeInBytes));
+    }
+    SC_TRY(itemSize > 0);
+    uint64_t numItems = sizeInBytes / itemSize;
+    SC_TRY(stream.serializeVarint(numItems));
+    SC_TRY(numItems <= ~0ull / itemSize);
+    sizeInBytes = numItems * itemSize;
+    return true;
+}
+
+} // namespace Serialization
+} // namespace SC
@@ -3,6 +3,7 @@
 #pragma once
 #include "../../Common/CompilerMinMax.h"
 #include "../../Reflection/ReflectionSchemaCompiler.h"
+#include "SerializationBinaryCompact.h"
 #include "SerializationBinarySchema.h"
 
 #include "../../Common/Result.h"
@@ -74,6 +75,34 @@ struct SerializerBinaryReadVersioned
     };
 };
 
+/// @brief Checks if source items can be copied in one operation into packed items of type `T`
+template <typename T, bool IsPacked = Reflection::ExtendedTypeInfo<T>::IsPacked,
+          bool IsPrimitive = Reflection::IsPrimitive<T>::value>
+struct SerializerVersionedItemsLayout
+{
+    [[nodiscard]] static constexpr bool isSameLayout(const SerializationSchema&) { return false; }
+};
+
+template <typename T>
+struct SerializerVersionedItemsLayout<T, true, true>
+{
+    [[nodiscard]] static constexpr bool isSameLayout(const SerializationSchema& schema)
+    {
+        return schema.current().type == Reflection::Reflect<T>::getCategory();
+    }
+};
+
+template <typename T>
+struct SerializerVersionedItemsLayout<T, true, false>
+{
+    [[nodiscard]] static bool isSameLayout(const SerializationSchema& schema)
+    {
+        // Sink schema is compiled once, while the (runtime) source schema is checked once per array, not per item
+        constexpr auto sinkSchema = Reflection::Schema::template compile<T>();
+        return schema.hasSameLayoutAs(sinkSchema.typeInfos);
+    }
+};
+
 template <typename BinaryStream, typename T>
 struct SerializerReadVersionedItems
 {
@@ -84,9 +113,7 @@ struct SerializerReadVersionedItems
         const auto commonSubsetItems  = min(numSourceItems, numDestinationItems);
         const auto arrayItemTypeIndex = schema.sourceTypeIndex;
 
-        const bool isPacked =
-            Reflection::IsPrimitive<T>::value && schema.current().type == Reflection::Reflect<T>::getCategory();
-        if (isPacked)
+        if (serializerBinaryCanCopyItems<T>(stream) and SerializerVersionedItemsLayout<T>::isSameLayout(schema))
         {
             const size_t sourceNumBytes = schema.current().sizeInBytes * numSourceItems;
             const size_t destNumBytes   = numDestinationItems * sizeof(T);
@@ -144,15 +171,19 @@ struct SerializationBinaryVersionedVector
     [[nodiscard]] static constexpr bool readVersioned(Container& object, BinaryStream& stream,
                                                       SerializationSchema& schema)
     {
-        uint64_t sizeInBytes = 0;
-        SC_TRY(stream.serializeBytes(&sizeInBytes, sizeof(sizeInBytes)));
         schema.advance();
-        const bool isPacked =
-            Reflection::IsPrimitive<T>::value && schema.current().type == Reflection::Reflect<T>::getCategory();
         const size_t sourceItemSize = schema.current().sizeInBytes;
+        uint64_t     sizeInBytes    = 0;
+        SC_TRY(serializerBinaryContainerSize(stream, sizeInBytes, sourceItemSize));
         const size_t numSourceItems = static_cast<size_t>(sizeInBytes / sourceItemSize);
         const size_t numValidItems  = min(numSourceItems, NumMaxItems);
-        if (isPacked)
+
+        const uint32_t itemTypeIndex = schema.sourceTypeIndex;
+        schema.resolveLink();
+        const bool isSameLayout =
+            serializerBinaryCanCopyItems<T>(stream) and SerializerVersionedItemsLayout<T>::isSameLayout(schema);
+        schema.sourceTypeIndex  = itemTypeIndex;
+        if (isSameLayout)
         {
             SC_TRY((Reflection::ExtendedTypeInfo<Container>::resizeWithoutInitializing(object, numValidItems)));
         }
@@ -173,8 +204,15 @@ struct SerializerBinaryReadVersioned<BinaryStream, T,
     [[nodiscard]] static bool readCastValue(T& destination, BinaryStream& stream)
     {
         ValueType value;
-        if (not stream.serializeBytes(&value, sizeof(ValueType)))
+        if (stream.isCompact)
+        {
+            if (not SerializerBinaryCompact<ValueType>::serialize(value, stream))
+                return false;
+        }
+        else if (not stream.serializeBytes(&value, sizeof(ValueType)))
+        {
             return false;
+        }
         destination = static_cast<T>(value);
         return true;
     }
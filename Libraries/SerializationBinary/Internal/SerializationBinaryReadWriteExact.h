@@ -3,6 +3,7 @@
 #pragma once
 #include "../../Common/Result.h"
 #include "../../Reflection/ReflectionSchemaCompiler.h"
+#include "SerializationBinaryCompact.h"
 
 namespace SC
 {
@@ -18,7 +19,7 @@ struct SerializerBinaryReadWriteExact
 {
     [[nodiscard]] static constexpr bool serialize(T& object, BinaryStream& stream)
     {
-        if SC_LANGUAGE_IF_CONSTEXPR (Reflection::ExtendedTypeInfo<T>::IsPacked)
+        if (serializerBinaryCanCopyItems<T>(stream))
         {
             return stream.serializeBytes(&object, sizeof(T));
         }
@@ -49,7 +50,7 @@ struct SerializerBinaryReadWriteExact<BinaryStream, T[N]>
 {
     [[nodiscard]] static constexpr bool serialize(T (&object)[N], BinaryStream& stream)
     {
-        if SC_LANGUAGE_IF_CONSTEXPR (Reflection::ExtendedTypeInfo<T>::IsPacked)
+        if (serializerBinaryCanCopyItems<T>(stream))
         {
             return stream.serializeBytes(object, sizeof(object));
         }
@@ -72,6 +73,10 @@ struct SerializerBinaryReadWriteExact<BinaryStream, T,
 {
     [[nodiscard]] static constexpr bool serialize(T& object, BinaryStream& stream)
     {
+        if (stream.isCompact)
+        {
+            return SerializerBinaryCompact<T>::serialize(object, stream);
+        }
         return stream.serializeBytes(&object, sizeof(T));
     }
 };
@@ -84,19 +89,15 @@ struct SerializerBinaryExactVector
     {
         constexpr size_t itemSize = sizeof(T);
         uint64_t sizeInBytes = static_cast<uint64_t>(Reflection::ExtendedTypeInfo<Container>::size(object)) * itemSize;
-        if (not SerializerBinaryReadWriteExact<BinaryStream, uint64_t>::serialize(sizeInBytes, stream))
+        if (not serializerBinaryContainerSize(stream, sizeInBytes, itemSize))
             return false;
 
         const auto numElements = static_cast<size_t>(sizeInBytes / itemSize);
 
-        if SC_LANGUAGE_IF_CONSTEXPR (Reflection::ExtendedTypeInfo<T>::IsPacked)
+        if (serializerBinaryCanCopyItems<T>(stream))
         {
-            // TODO: C++ 14 mode would need SFINAE as it lacks "if constexpr"
-#if SC_LANGUAGE_CPP_AT_LEAST_17
+            // Items are entirely overwritten by serializeBytes when reading, so they don't need to be initialized
             SC_TRY((Reflection::ExtendedTypeInfo<Container>::resizeWithoutInitializing(object, numElements)));
-#else
-            SC_TRY((Reflection::ExtendedTypeInfo<Container>::resize(object, numElements)));
-#endif
             return stream.serializeBytes(Reflection::ExtendedTypeInfo<Container>::data(object), itemSize * numElements);
         }
         else
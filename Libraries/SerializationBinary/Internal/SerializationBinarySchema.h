@@ -39,6 +39,65 @@ struct SerializationSchema
         skipper.sourceTypes = sourceTypes;
         return skipper.skip();
     }
+
+    /// @brief Checks if current (resolved) source type and root type of `sinkTypes` are both packed with the same
+    /// memory layout and member tags, so that they can be copied in one operation instead of field by field.
+    [[nodiscard]] bool hasSameLayoutAs(Span<const Reflection::TypeInfo> sinkTypes) const
+    {
+        return haveSameLayout(sourceTypes, sourceTypeIndex, sinkTypes, 0);
+    }
+
+  private:
+    [[nodiscard]] static bool haveSameLayout(Span<const Reflection::TypeInfo> source, uint32_t sourceIndex,
+                                             Span<const Reflection::TypeInfo> sink, uint32_t sinkIndex)
+    {
+        const Reflection::TypeInfo sourceType = source[sourceIndex];
+        const Reflection::TypeInfo sinkType   = sink[sinkIndex];
+        if (sourceType.type != sinkType.type or sourceType.sizeInBytes != sinkType.sizeInBytes)
+            return false;
+        switch (sourceType.type)
+        {
+        case Reflection::TypeCategory::TypeStruct:
+            if (not sourceType.structInfo.isPacked or not sinkType.structInfo.isPacked)
+                return false;
+            break;
+        case Reflection::TypeCategory::TypeArray:
+            if (sourceType.arrayInfo.numElements != sinkType.arrayInfo.numElements)
+                return false;
+            break;
+        case Reflection::TypeCategory::TypeVector:
+        case Reflection::TypeCategory::TypeInvalid: return false;
+        default: return true; // Primitive types
+        }
+        const uint32_t numChildren = sourceType.getNumberOfChildren();
+        if (numChildren != sinkType.getNumberOfChildren() or sourceIndex + numChildren >= source.sizeInElements())
+            return false;
+        for (uint32_t idx = 1; idx <= numChildren; ++idx)
+        {
+            const Reflection::TypeInfo sourceChild = source[sourceIndex + idx];
+            const Reflection::TypeInfo sinkChild   = sink[sinkIndex + idx];
+            if (sourceType.type == Reflection::TypeCategory::TypeStruct)
+            {
+                // Members are matched by memberTag during versioned loading, so tags must also be at same offsets
+                if (sourceChild.memberInfo.memberTag != sinkChild.memberInfo.memberTag or
+                    sourceChild.memberInfo.offsetInBytes != sinkChild.memberInfo.offsetInBytes)
+                    return false;
+            }
+            if (sourceChild.hasValidLinkIndex() != sinkChild.hasValidLinkIndex())
+                return false;
+            if (sourceChild.hasValidLinkIndex())
+            {
+                if (sourceChild.getLinkIndex() >= source.sizeInElements() or
+                    not haveSameLayout(source, sourceChild.getLinkIndex(), sink, sinkChild.getLinkIndex()))
+                    return false;
+            }
+            else if (sourceChild.type != sinkChild.type or sourceChild.sizeInBytes != sinkChild.sizeInBytes)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 };
 
 //! @}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 #include "../../Reflection/Reflection.h"
+#include "SerializationBinaryCompact.h"
 
 namespace SC
 {
@@ -31,6 +32,11 @@ struct SerializationBinarySkipper
         }
         else if (sourceType.isPrimitiveType())
         {
+            if (sourceObject.isCompact and Serialization::serializerBinaryIsVarint(sourceType.type))
+            {
+                uint64_t value;
+                return sourceObject.serializeVarint(value);
+            }
             return sourceObject.advanceBytes(sourceType.sizeInBytes);
         }
         return false;
@@ -40,11 +46,18 @@ struct SerializationBinarySkipper
     BinaryStream& sourceObject;
     uint32_t&     sourceTypeIndex;
 
+    [[nodiscard]] bool canSkipAsBytes(const Reflection::TypeInfo& typeInfo) const
+    {
+        if (sourceObject.isCompact)
+            return typeInfo.isPrimitiveType() and not Serialization::serializerBinaryIsVarint(typeInfo.type);
+        return typeInfo.isPrimitiveOrPackedStruct();
+    }
+
     [[nodiscard]] bool skipStruct()
     {
         const auto structSourceType      = sourceType;
         const auto structSourceTypeIndex = sourceTypeIndex;
-        const bool isPacked              = sourceTypes.data()[sourceTypeIndex].isPrimitiveOrPackedStruct();
+        const bool isPacked              = canSkipAsBytes(sourceTypes.data()[sourceTypeIndex]);
 
         if (isPacked)
         {
@@ -74,11 +87,12 @@ struct SerializationBinarySkipper
         uint64_t sourceNumBytes = arraySourceType.sizeInBytes;
         if (arraySourceType.type == Reflection::TypeCategory::TypeVector)
         {
-            if (not sourceObject.serializeBytes(Span<char>::reinterpret_object(sourceNumBytes)))
+            const size_t sourceItemSize = sourceTypes.data()[sourceTypeIndex].sizeInBytes;
+            if (not Serialization::serializerBinaryContainerSize(sourceObject, sourceNumBytes, sourceItemSize))
                 return false;
         }
 
-        const bool isPacked = sourceTypes.data()[sourceTypeIndex].isPrimitiveOrPackedStruct();
+        const bool isPacked = canSkipAsBytes(sourceTypes.data()[sourceTypeIndex]);
         if (isPacked)
         {
             return sourceObject.advanceBytes(static_cast<size_t>(sourceNumBytes));
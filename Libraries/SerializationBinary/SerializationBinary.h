@@ -54,8 +54,20 @@ struct SerializationBinary
 
     template <typename T, typename BufferType>
     [[nodiscard]] static bool write(T& value, BufferType& buffer, size_t* numberOfWrites = nullptr)
+    {
+        return write(value, buffer, SerializationBinaryOptions(), numberOfWrites);
+    }
+
+    /// @brief Writes object `T` to a binary buffer using SerializationBinaryOptions::encoding.
+    /// SerializationBinaryEncoding::Compact stores small integers in fewer bytes, but data must be read back passing
+    /// the same encoding to SerializationBinary::loadExact or SerializationBinary::loadVersioned.
+    /// @see SerializationBinary::write
+    template <typename T, typename BufferType>
+    [[nodiscard]] static bool write(T& value, BufferType& buffer, SerializationBinaryOptions options,
+                                    size_t* numberOfWrites = nullptr)
     {
         SerializationBinaryWriter<BufferType> writer(buffer);
+        writer.isCompact = options.encoding == SerializationBinaryEncoding::Compact;
         using Writer = Serialization::SerializerBinaryReadWriteExact<SerializationBinaryWriter<BufferType>, T>;
         if (not Writer::serialize(value, writer))
             return false;
@@ -98,8 +110,19 @@ struct SerializationBinary
     /// @endcode
     template <typename T>
     [[nodiscard]] static bool loadExact(T& value, Span<const char> buffer, size_t* numberOfReads = nullptr)
+    {
+        return loadExact(value, buffer, SerializationBinaryOptions(), numberOfReads);
+    }
+
+    /// @brief Loads object `T` from binary buffer written by SerializationBinary::write with the same
+    /// SerializationBinaryOptions::encoding.
+    /// @see SerializationBinary::loadExact
+    template <typename T>
+    [[nodiscard]] static bool loadExact(T& value, Span<const char> buffer, SerializationBinaryOptions options,
+                                        size_t* numberOfReads = nullptr)
     {
         SerializationBinaryReader bufferReader(buffer);
+        bufferReader.isCompact = options.encoding == SerializationBinaryEncoding::Compact;
         using Reader = Serialization::SerializerBinaryReadWriteExact<SerializationBinaryReader, T>;
         if (not Reader::serialize(value, bufferReader))
             return false;
@@ -146,6 +169,7 @@ struct SerializationBinary
                                             SerializationBinaryOptions options = {}, size_t* numberOfReads = nullptr)
     {
         SerializationBinaryReader readerBuffer(buffer);
+        readerBuffer.isCompact = options.encoding == SerializationBinaryEncoding::Compact;
         using Reader = Serialization::SerializerBinaryReadVersioned<SerializationBinaryReader, T, void>;
         SerializationSchema versionSchema(schema);
         versionSchema.options = options;
@@ -163,6 +187,16 @@ struct SerializationBinary
     /// @see SerializationBinary::loadVersionedWithSchema
     template <typename T, typename BufferType>
     [[nodiscard]] static bool writeWithSchema(T& value, BufferType& buffer, size_t* numberOfWrites = nullptr)
+    {
+        return writeWithSchema(value, buffer, SerializationBinaryOptions(), numberOfWrites);
+    }
+
+    /// @brief Writes the reflection schema of object `T` followed by contents of object `T` using
+    /// SerializationBinaryOptions::encoding, that must be passed to SerializationBinary::loadVersionedWithSchema too.
+    /// @see SerializationBinary::writeWithSchema
+    template <typename T, typename BufferType>
+    [[nodiscard]] static bool writeWithSchema(T& value, BufferType& buffer, SerializationBinaryOptions options,
+                                              size_t* numberOfWrites = nullptr)
     {
         constexpr auto     typeInfos = Reflection::Schema::template compile<T>().typeInfos;
         constexpr uint32_t numInfos  = typeInfos.size;
@@ -171,7 +205,7 @@ struct SerializationBinary
         SC_TRY(buffer.append(Span<const char>::reinterpret_bytes(&numInfos, sizeof(numInfos))));
         SC_TRY(buffer.append(
             Span<const char>::reinterpret_bytes(typeInfos.values, typeInfos.size * sizeof(Reflection::TypeInfo))));
-        return write(value, buffer, numberOfWrites);
+        return write(value, buffer, options, numberOfWrites);
     }
 
     /// @brief Loads object `T` using the schema information that has been prepended by
@@ -210,7 +244,7 @@ struct SerializationBinary
         if (sourceSchema.equals(serializedSchema))
         {
             // If the serialized schema matches current object schema, we can run the fast "loadExact" path
-            return loadExact(value, serializedDataSlice);
+            return loadExact(value, serializedDataSlice, options, numberOfReads);
         }
         else
         {
@@ -218,6 +252,119 @@ struct SerializationBinary
             return loadVersioned(value, serializedDataSlice, serializedSchema, options, numberOfReads);
         }
     }
+
+    /// @brief Writes a 64 bit hash of the reflection schema of object `T` followed by contents of object `T`.
+    /// `T` must be a `Packed` struct or a `Vector`-like container of `Packed` items.
+    /// The serialized buffer can be accessed without any copy with SerializationBinary::viewWithSchemaHash.
+    /// @see SerializationBinary::viewWithSchemaHash
+    template <typename T, typename BufferType>
+    [[nodiscard]] static bool writeWithSchemaHash(T& value, BufferType& buffer, size_t* numberOfWrites = nullptr)
+    {
+        static_assert(Reflection::ExtendedTypeInfo<T>::IsPacked or
+                          Reflection::Reflect<T>::getCategory() == Reflection::TypeCategory::TypeVector,
+                      "T must be Packed or a Vector-like container");
+        constexpr auto schema     = Reflection::Schema::template compile<T>();
+        const uint64_t schemaHash = schema.hashTypeInfos();
+        // Implying same endianness when reading here
+        SC_TRY(buffer.append(Span<const char>::reinterpret_bytes(&schemaHash, sizeof(schemaHash))));
+        return write(value, buffer, numberOfWrites);
+    }
+
+    /// @brief Obtains a pointer to a `Packed` object `T` written by SerializationBinary::writeWithSchemaHash, pointing
+    /// directly inside `buffer` without decoding or copying it (for example a memory mapped file or a receive buffer).
+    /// @param buffer The bytes written by SerializationBinary::writeWithSchemaHash, that must outlive `value`
+    /// @param value Receives a pointer inside `buffer`
+    /// @return `false` if schema hash of `T` doesn't match the stored one, if size is wrong or if the object inside
+    /// `buffer` is not correctly aligned for `T`
+    template <typename T>
+    [[nodiscard]] static bool viewWithSchemaHash(Span<const char> buffer, const T*& value)
+    {
+        Span<const char> data;
+        SC_TRY(sliceSchemaHash<T>(buffer, data));
+        return viewExact(data, value);
+    }
+
+    /// @brief Obtains a Span of `Packed` items of `Container` (`Vector<T>` or `Array<T, N>`) written by
+    /// SerializationBinary::writeWithSchemaHash, pointing directly inside `buffer` without decoding or copying it.
+    /// @tparam Container The container type that has been passed to SerializationBinary::writeWithSchemaHash
+    /// @param buffer The bytes written by SerializationBinary::writeWithSchemaHash, that must outlive `values`
+    /// @param values Receives a span of items inside `buffer`
+    /// @return `false` if schema hash of `Container` doesn't match the stored one, if sizes are wrong or if items
+    /// inside `buffer` are not correctly aligned for `T`
+    ///
+    /// Example:
+    /// \snippet Tests/Libraries/SerializationBinary/SerializationBinaryTest.cpp serializationBinaryViewSnippet
+    template <typename Container, typename T>
+    [[nodiscard]] static bool viewWithSchemaHash(Span<const char> buffer, Span<const T>& values)
+    {
+        using ContainerInfo = Reflection::ExtendedTypeInfo<Container>;
+        static_assert(TypeTraits::IsSame<decltype(ContainerInfo::data(*static_cast<Container*>(nullptr))), T*>::value,
+                      "Container items must be of type T");
+        Span<const char> data;
+        SC_TRY(sliceSchemaHash<Container>(buffer, data));
+        return viewExact(data, values);
+    }
+
+    /// @brief Obtains a pointer to a `Packed` object `T` written by SerializationBinary::write, pointing directly
+    /// inside `buffer` without decoding or copying it. Schema of `T` must match the written one, as in loadExact.
+    template <typename T>
+    [[nodiscard]] static bool viewExact(Span<const char> buffer, const T*& value)
+    {
+        assertViewable<T>();
+        SC_TRY(buffer.sizeInBytes() == sizeof(T) and isAligned<T>(buffer.data()));
+        value = reinterpret_cast<const T*>(buffer.data());
+        return true;
+    }
+
+    /// @brief Obtains a Span of `Packed` items written by SerializationBinary::write from a `Vector`-like container,
+    /// pointing directly inside `buffer` without decoding or copying them. Schema of `T` must match the written one.
+    template <typename T>
+    [[nodiscard]] static bool viewExact(Span<const char> buffer, Span<const T>& values)
+    {
+        assertViewable<T>();
+        uint64_t sizeInBytes = 0;
+        SC_TRY(buffer.sizeInBytes() >= sizeof(sizeInBytes));
+#if SC_COMPILER_MSVC
+        ::memcpy(&sizeInBytes, buffer.data(), sizeof(sizeInBytes));
+#else
+        __builtin_memcpy(&sizeInBytes, buffer.data(), sizeof(sizeInBytes));
+#endif
+        const char* items = buffer.data() + sizeof(sizeInBytes);
+        SC_TRY(sizeInBytes == buffer.sizeInBytes() - sizeof(sizeInBytes) and sizeInBytes % sizeof(T) == 0);
+        SC_TRY(isAligned<T>(items));
+        values = {reinterpret_cast<const T*>(items), static_cast<size_t>(sizeInBytes / sizeof(T))};
+        return true;
+    }
+
+  private:
+    template <typename T>
+    static constexpr void assertViewable()
+    {
+        static_assert(Reflection::ExtendedTypeInfo<T>::IsPacked, "T must be Packed (no padding, only primitives)");
+        static_assert(TypeTraits::IsTriviallyCopyable<T>::value, "T must be trivially copyable");
+    }
+
+    template <typename T>
+    [[nodiscard]] static bool isAligned(const char* data)
+    {
+        return reinterpret_cast<size_t>(data) % alignof(T) == 0;
+    }
+
+    template <typename T>
+    [[nodiscard]] static bool sliceSchemaHash(Span<const char> buffer, Span<const char>& data)
+    {
+        constexpr auto   schema     = Reflection::Schema::template compile<T>();
+        uint64_t         schemaHash = 0;
+        Span<const char> schemaHashSlice;
+        SC_TRY(buffer.sliceStartLength(0, sizeof(schemaHash), schemaHashSlice));
+#if SC_COMPILER_MSVC
+        ::memcpy(&schemaHash, schemaHashSlice.data(), sizeof(schemaHash));
+#else
+        __builtin_memcpy(&schemaHash, schemaHashSlice.data(), sizeof(schemaHash));
+#endif
+        SC_TRY(schemaHash == schema.hashTypeInfos());
+        return buffer.sliceStart(sizeof(schemaHash), data);
+    }
 };
 
 //! @}
@@ -7,13 +7,27 @@ namespace SC
 //! @addtogroup group_serialization_binary
 //! @{
 
-/// @brief Conversion options for the binary versioned deserializer
+/// @brief Binary representation of primitive values and container sizes
+enum class SerializationBinaryEncoding
+{
+    /// @brief Native fixed width values and container sizes in bytes, copying `Packed` types in a single operation
+    Native,
+
+    /// @brief Integers wider than one byte as LEB128 varints (zigzag encoded when signed) and container sizes as
+    /// varint number of items, shrinking data made of small integers. Floats, bools and bytes are stored natively.
+    Compact,
+};
+
+/// @brief Encoding and conversion options for the binary serializer and versioned deserializer
 struct SerializationBinaryOptions
 {
     bool allowFloatToIntTruncation    = true; ///< Can truncate a float to get an integer value
     bool allowDropExcessArrayItems    = true; ///< Can drop array items if destination array is smaller
     bool allowDropExcessStructMembers = true; ///< Can drop fields not matching any memberTag in destination struct
     bool allowBoolConversions         = true; ///< Can convert bool to and from other primitive types (int / floats)
+
+    /// @brief Encoding of written data, that must be the same when reading it back
+    SerializationBinaryEncoding encoding = SerializationBinaryEncoding::Native;
 };
 
 //! @}
@@ -0,0 +1,237 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "JsonTokenizer.h"
+
+#include <string.h> // memcpy, memset
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define SC_JSON_STRUCTURAL_INDEX_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SC_JSON_STRUCTURAL_INDEX_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace
+{
+using namespace SC;
+
+// Bitmasks of character classes in a 64 bytes block, where bit N describes byte N
+struct JsonBlockMasks
+{
+    uint64_t quotes      = 0;
+    uint64_t backslashes = 0;
+    uint64_t whitespaces = 0;
+    uint64_t operators   = 0; // {}[]:,
+};
+
+#if SC_JSON_STRUCTURAL_INDEX_SSE2
+inline uint64_t toBitmask(__m128i mask) { return static_cast<uint32_t>(_mm_movemask_epi8(mask)); }
+
+inline void classifyBlock(const char* block, JsonBlockMasks& masks)
+{
+    masks = {};
+    for (int idx = 0; idx < 64; idx += 16)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + idx));
+        // Setting 0x20 bit folds '[' and ']' onto '{' and '}'
+        const __m128i folded = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+        const __m128i braces = _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), //
+                                            _mm_cmpeq_epi8(folded, _mm_set1_epi8('}')));
+        const __m128i separators = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(':')), //
+                                                _mm_cmpeq_epi8(chars, _mm_set1_epi8(',')));
+        const __m128i spaces = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')), //
+                                            _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')));
+        const __m128i newlines = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')), //
+                                              _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+
+        masks.quotes |= toBitmask(_mm_cmpeq_epi8(chars, _mm_set1_epi8('"'))) << idx;
+        masks.backslashes |= toBitmask(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'))) << idx;
+        masks.whitespaces |= toBitmask(_mm_or_si128(spaces, newlines)) << idx;
+        masks.operators |= toBitmask(_mm_or_si128(braces, separators)) << idx;
+    }
+}
+#elif SC_JSON_STRUCTURAL_INDEX_NEON
+inline uint64_t toBitmask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+{
+    // Weights each lane with its bit position, then folds lanes together with pairwise additions
+    static const uint8_t weights[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+    const uint8x16_t bits = vld1q_u8(weights);
+    uint8x16_t       sum0 = vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits));
+    uint8x16_t       sum1 = vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits));
+    sum0                  = vpaddq_u8(sum0, sum1);
+    sum0                  = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+inline void classifyBlock(const char* block, JsonBlockMasks& masks)
+{
+    uint8x16_t quotes[4], backslashes[4], whitespaces[4], operators[4];
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(block + idx * 16));
+        // Setting 0x20 bit folds '[' and ']' onto '{' and '}'
+        const uint8x16_t folded     = vorrq_u8(chars, vdupq_n_u8(0x20));
+        const uint8x16_t braces     = vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')), vceqq_u8(folded, vdupq_n_u8('}')));
+        const uint8x16_t separators = vorrq_u8(vceqq_u8(chars, vdupq_n_u8(':')), vceqq_u8(chars, vdupq_n_u8(',')));
+        const uint8x16_t spaces     = vorrq_u8(vceqq_u8(chars, vdupq_n_u8(' ')), vceqq_u8(chars, vdupq_n_u8('\t')));
+        const uint8x16_t newlines   = vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\n')), vceqq_u8(chars, vdupq_n_u8('\r')));
+
+        quotes[idx]      = vceqq_u8(chars, vdupq_n_u8('"'));
+        backslashes[idx] = vceqq_u8(chars, vdupq_n_u8('\\'));
+        whitespaces[idx] = vorrq_u8(spaces, newlines);
+        operators[idx]   = vorrq_u8(braces, separators);
+    }
+    masks.quotes      = toBitmask(quotes[0], quotes[1], quotes[2], quotes[3]);
+    masks.backslashes = toBitmask(backslashes[0], backslashes[1], backslashes[2], backslashes[3]);
+    masks.whitespaces = toBitmask(whitespaces[0], whitespaces[1], whitespaces[2], whitespaces[3]);
+    masks.operators   = toBitmask(operators[0], operators[1], operators[2], operators[3]);
+}
+#else
+inline void classifyBlock(const char* block, JsonBlockMasks& masks)
+{
+    masks = {};
+    for (uint64_t idx = 0; idx < 64; ++idx)
+    {
+        const uint64_t bit = uint64_t(1) << idx;
+        switch (block[idx])
+        {
+        case '"': masks.quotes |= bit; break;
+        case '\\': masks.backslashes |= bit; break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r': masks.whitespaces |= bit; break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',': masks.operators |= bit; break;
+        default: break;
+        }
+    }
+}
+#endif
+
+inline uint32_t countTrailingZeros(uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+#if defined(_WIN64)
+    _BitScanForward64(&index, value);
+#else
+    if (not _BitScanForward(&index, static_cast<uint32_t>(value)))
+    {
+        _BitScanForward(&index, static_cast<uint32_t>(value >> 32));
+        index += 32;
+    }
+#endif
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+// Turns quote bits into a mask covering from each opening quote (included) to its closing quote (excluded)
+inline uint64_t prefixXor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Carries string, escape and scalar state across consecutive blocks
+struct JsonStructuralScanner
+{
+    uint64_t prevEndsOddBackslash = 0; // 1 if previous block ends with an odd sequence of backslashes
+    uint64_t prevInString         = 0; // All ones if previous block ends inside a string
+    uint64_t prevScalar           = 0; // 1 if previous block ends with a number or literal character
+
+    uint32_t* scanBlock(const char* block, uint32_t offset, uint32_t* output)
+    {
+        JsonBlockMasks masks;
+        classifyBlock(block, masks);
+
+        const uint64_t quotes   = masks.quotes & ~findEscaped(masks.backslashes);
+        const uint64_t inString = prefixXor(quotes) ^ prevInString;
+        prevInString            = 0 - (inString >> 63);
+
+        // Numbers and literals start at any character outside strings not following another scalar character
+        const uint64_t scalars      = ~(masks.whitespaces | masks.operators | quotes | inString);
+        const uint64_t scalarStarts = scalars & ~((scalars << 1) | prevScalar);
+        prevScalar                  = scalars >> 63;
+
+        uint64_t structurals = (masks.operators & ~inString) | quotes | scalarStarts;
+        while (structurals != 0)
+        {
+            *output++ = offset + countTrailingZeros(structurals);
+            structurals &= structurals - 1;
+        }
+        return output;
+    }
+
+  private:
+    // Finds characters following an odd sequence of backslashes
+    uint64_t findEscaped(uint64_t backslashes)
+    {
+        constexpr uint64_t EvenBits = 0x5555555555555555ULL;
+
+        const uint64_t startEdges    = backslashes & ~(backslashes << 1);
+        const uint64_t evenStartMask = EvenBits ^ prevEndsOddBackslash; // a sequence from previous block flips parity
+        const uint64_t evenStarts    = startEdges & evenStartMask;
+        const uint64_t oddStarts     = startEdges & ~evenStartMask;
+        const uint64_t evenCarries   = backslashes + evenStarts;
+        uint64_t       oddCarries    = backslashes + oddStarts;
+
+        const bool endsOdd = oddCarries < backslashes; // an odd sequence overflows out of the block
+        oddCarries |= prevEndsOddBackslash;
+        prevEndsOddBackslash = endsOdd ? 1 : 0;
+
+        const uint64_t evenCarryEnds = evenCarries & ~backslashes;
+        const uint64_t oddCarryEnds  = oddCarries & ~backslashes;
+        return (evenCarryEnds & ~EvenBits) | (oddCarryEnds & EvenBits);
+    }
+};
+} // namespace
+
+bool SC::JsonTokenizer::buildStructuralIndex(StringSpan text, Span<uint32_t> structurals, size_t& numStructurals)
+{
+    numStructurals        = 0;
+    const size_t textSize = text.sizeInBytes();
+    if (text.getEncoding() == StringEncoding::Utf16 or static_cast<uint64_t>(textSize) >= 0xffffffffULL or
+        structurals.sizeInElements() < textSize)
+    {
+        return false;
+    }
+    const char* bytes = text.bytesWithoutTerminator();
+
+    JsonStructuralScanner scanner;
+
+    uint32_t* output = structurals.data();
+    size_t    offset = 0;
+    for (; offset + 64 <= textSize; offset += 64)
+    {
+        output = scanner.scanBlock(bytes + offset, static_cast<uint32_t>(offset), output);
+    }
+    if (offset < textSize)
+    {
+        // Whitespace padding never generates entries, even when the text ends inside an unterminated string
+        char lastBlock[64];
+        ::memset(lastBlock, ' ', sizeof(lastBlock));
+        ::memcpy(lastBlock, bytes + offset, textSize - offset);
+        output = scanner.scanBlock(lastBlock, static_cast<uint32_t>(offset), output);
+    }
+    numStructurals = static_cast<size_t>(output - structurals.data());
+    return true;
+}
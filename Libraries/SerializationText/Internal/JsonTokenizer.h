@@ -23,9 +23,20 @@ struct SC::JsonTokenizer
         size_t     position = 0;
         bool       valid    = true;
 
+        // Optional index built by JsonTokenizer::buildStructuralIndex, consumed instead of scanning characters
+        const uint32_t* structurals    = nullptr;
+        size_t          numStructurals = 0;
+        size_t          nextStructural = 0;
+
         constexpr Cursor() = default;
         constexpr Cursor(StringSpan text) : text(text), valid(text.getEncoding() != StringEncoding::Utf16) {}
 
+        /// @brief Builds a cursor walking the structural index of `text` rather than its characters
+        constexpr Cursor(StringSpan text, Span<const uint32_t> structuralIndex)
+            : text(text), valid(text.getEncoding() != StringEncoding::Utf16), structurals(structuralIndex.data()),
+              numStructurals(structuralIndex.sizeInElements())
+        {}
+
         [[nodiscard]] constexpr bool read(char& character)
         {
             if (not valid or position >= text.sizeInBytes())
@@ -101,8 +112,19 @@ struct SC::JsonTokenizer
     /// @note Token bytes offset used then by Token::getToken are relative to the passed `cursor` start
     [[nodiscard]] static constexpr bool tokenizeNext(Cursor& it, Token& token);
 
+    /// @brief Builds the structural index of a json text, to be walked by a Cursor (stage one of tokenization).
+    /// Records byte offsets of every `{}[]:,` outside strings, of every unescaped quote (opening and closing) and of
+    /// the first character of every number or literal, classifying 64 bytes at a time (using SSE2 or NEON if present).
+    /// @param text The json text to index (ASCII or UTF-8, smaller than 4 GB)
+    /// @param structurals Caller provided storage for the index, holding at least one entry per byte of `text`
+    /// @param numStructurals Number of entries written in `structurals`
+    /// @return `false` if `text` is UTF-16, too large or if `structurals` is too small
+    [[nodiscard]] static bool buildStructuralIndex(StringSpan text, Span<uint32_t> structurals,
+                                                   size_t& numStructurals);
+
   private:
     friend struct SC::JsonTokenizerTest;
+    [[nodiscard]] static constexpr bool tokenizeNextIndexed(Cursor& it, Token& token);
     [[nodiscard]] static constexpr bool scanToken(Cursor& it, Token& token);
     [[nodiscard]] static constexpr bool skipWhitespaces(Cursor& it);
 
@@ -120,7 +142,8 @@ struct SC::JsonTokenizer
 
     [[nodiscard]] static constexpr bool isNumberCharacter(char character)
     {
-        return (character >= '0' and character <= '9') or character == '.';
+        return (character >= '0' and character <= '9') or character == '.' or character == '-' or character == '+' or
+               character == 'e' or character == 'E';
     }
 };
 
@@ -129,6 +152,10 @@ struct SC::JsonTokenizer
 //-----------------------------------------------------------------------------------------------------------------------
 constexpr bool SC::JsonTokenizer::tokenizeNext(Cursor& it, Token& token)
 {
+    if (it.structurals != nullptr)
+    {
+        return tokenizeNextIndexed(it, token);
+    }
     if (skipWhitespaces(it))
     {
         return scanToken(it, token);
@@ -136,6 +163,59 @@ constexpr bool SC::JsonTokenizer::tokenizeNext(Cursor& it, Token& token)
     return false;
 }
 
+constexpr bool SC::JsonTokenizer::tokenizeNextIndexed(Cursor& it, Token& token)
+{
+    if (not it.valid or it.nextStructural >= it.numStructurals)
+    {
+        token = Token();
+        return false;
+    }
+    const char*  bytes = it.text.bytesWithoutTerminator();
+    const size_t start = it.structurals[it.nextStructural++];
+
+    token.tokenStartBytes  = start;
+    token.tokenLengthBytes = 1;
+    it.position            = start + 1;
+    switch (bytes[start])
+    {
+    case '{': token.type = Token::ObjectStart; return true;
+    case '}': token.type = Token::ObjectEnd; return true;
+    case '[': token.type = Token::ArrayStart; return true;
+    case ']': token.type = Token::ArrayEnd; return true;
+    case ':': token.type = Token::Colon; return true;
+    case ',': token.type = Token::Comma; return true;
+    case '"':
+        // Everything up to the closing quote has been masked by the index, so it must be the next entry
+        if (it.nextStructural < it.numStructurals)
+        {
+            const size_t endQuote  = it.structurals[it.nextStructural++];
+            token.type             = Token::String;
+            token.tokenStartBytes  = start + 1;
+            token.tokenLengthBytes = endQuote - start - 1;
+            it.position            = endQuote + 1;
+        }
+        else
+        {
+            token       = Token();
+            it.position = it.text.sizeInBytes();
+        }
+        return true;
+    default: break;
+    }
+    it.position = start;
+    if (not scanToken(it, token))
+    {
+        return false;
+    }
+    const size_t nextPosition =
+        it.nextStructural < it.numStructurals ? it.structurals[it.nextStructural] : it.text.sizeInBytes();
+    if (it.position < nextPosition and not isWhitespace(bytes[it.position]))
+    {
+        token.type = Token::Invalid; // scalar is followed by garbage that the index has not split in its own entry
+    }
+    return true;
+}
+
 constexpr bool SC::JsonTokenizer::scanToken(Cursor& it, Token& token)
 {
     token = Token();
@@ -212,7 +292,7 @@ constexpr bool SC::JsonTokenizer::isEscapedQuote(StringSpan text, size_t quotePo
 
 constexpr void SC::JsonTokenizer::tokenizeNumber(Cursor& it, char previousChar, Token& token)
 {
-    // eat all non whitespaces that could possibly form a number (to be validated, as it may contain multiple dots)
+    // eat all non whitespaces that could possibly form a number (to be validated, as it may contain many dots or signs)
     if (not isNumberCharacter(previousChar))
     {
         return;
@@ -48,11 +48,122 @@ struct SerializationTextReadVersioned<SerializerStream, T[N], void>
     }
 };
 
+/// @brief Compile-time table of the reflected members of struct `T`, sorted by hash of their names.
+/// Lets SerializationTextReadVersioned dispatch a field name to the loader of its member with a binary search, instead
+/// of comparing it with the name of every member.
+template <typename SerializerStream, typename T>
+struct SerializationTextMemberTable
+{
+    using LoadFunction = bool (*)(T& object, size_t offset, SerializerStream& stream);
+
+    struct Entry
+    {
+        uint32_t     hash   = 0;
+        const char*  name   = nullptr;
+        size_t       length = 0;
+        size_t       offset = 0;
+        LoadFunction load   = nullptr;
+    };
+
+    constexpr SerializationTextMemberTable() : entries(), numEntries(0)
+    {
+        (void)Reflection::Reflect<T>::visit(*this);
+        // Insertion sort is fine as it only runs at compile time
+        for (size_t idx = 1; idx < numEntries; ++idx)
+        {
+            const Entry entry = entries[idx];
+
+            size_t position = idx;
+            while (position > 0 and entries[position - 1].hash > entry.hash)
+            {
+                entries[position] = entries[position - 1];
+                position -= 1;
+            }
+            entries[position] = entry;
+        }
+    }
+
+    /// @brief Finds the member named as the given (non UTF16) field, or `nullptr` if no member has that name
+    [[nodiscard]] const Entry* find(StringSpan field) const
+    {
+        const Span<const char> fieldBytes = field.toCharSpan();
+        const uint32_t         fieldHash  = hash(fieldBytes.data(), fieldBytes.sizeInBytes());
+
+        size_t low  = 0;
+        size_t high = numEntries;
+        while (low < high)
+        {
+            const size_t middle = (low + high) / 2;
+            if (entries[middle].hash < fieldHash)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        for (; low < numEntries and entries[low].hash == fieldHash; ++low)
+        {
+            const Entry& entry = entries[low];
+            if (StringSpan({entry.name, entry.length}, false, StringEncoding::Ascii) == field)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    template <typename R, int N>
+    constexpr bool operator()(int, R T::*, const char (&name)[N], size_t offset)
+    {
+        Entry& entry = entries[numEntries++];
+        entry.hash   = hash(name, N - 1);
+        entry.name   = name;
+        entry.length = N - 1;
+        entry.offset = offset;
+        entry.load   = &loadMember<R>;
+        return true;
+    }
+
+  private:
+    struct MemberCounter
+    {
+        size_t numMembers = 0;
+
+        constexpr MemberCounter() { (void)Reflection::Reflect<T>::visit(*this); }
+
+        template <typename R, int N>
+        constexpr bool operator()(int, R T::*, const char (&)[N], size_t)
+        {
+            numMembers += 1;
+            return true;
+        }
+    };
+    static constexpr size_t NumMembers = MemberCounter().numMembers;
+
+    // FNV-1a
+    static constexpr uint32_t hash(const char* text, size_t length)
+    {
+        uint32_t value = 2166136261u;
+        for (size_t idx = 0; idx < length; ++idx)
+        {
+            value ^= static_cast<uint8_t>(text[idx]);
+            value *= 16777619u;
+        }
+        return value;
+    }
+
+    template <typename R>
+    static bool loadMember(T& object, size_t offset, SerializerStream& stream)
+    {
+        R& member = *reinterpret_cast<R*>(reinterpret_cast<char*>(&object) + offset);
+        return SerializationTextReadVersioned<SerializerStream, R, void>::loadVersioned(0, member, stream);
+    }
+
+    Entry  entries[NumMembers > 0 ? NumMembers : 1];
+    size_t numEntries;
+};
+
 template <typename SerializerStream, typename T>
 struct SerializationTextReadVersioned<
     SerializerStream, T, typename SC::TypeTraits::EnableIf<SerializationTextIsStructSerializable<T>::value>::type>
 {
-    [[nodiscard]] static constexpr bool loadVersioned(uint32_t index, T& object, SerializerStream& stream)
+    [[nodiscard]] static bool loadVersioned(uint32_t index, T& object, SerializerStream& stream)
     {
         if (not stream.startObject(index))
             return false;
@@ -64,9 +175,7 @@ struct SerializationTextReadVersioned<
         // TODO: Figure out maybe a simple way to allow clearing fields that have not been consumed
         while (hasMore)
         {
-            MemberIterator iterator{stream, object, fieldToFind};
-            Reflection::Reflect<T>::visit(iterator);
-            if (not iterator.consumed or not iterator.consumedWithSuccess)
+            if (not loadField(object, fieldToFind, stream))
                 return false;
             if (not stream.getNextField(++fieldIndex, fieldToFind, hasMore))
                 return false;
@@ -75,6 +184,21 @@ struct SerializationTextReadVersioned<
     }
 
   private:
+    [[nodiscard]] static bool loadField(T& object, StringSpan fieldToFind, SerializerStream& stream)
+    {
+        if (fieldToFind.getEncoding() != StringEncoding::Utf16)
+        {
+            static constexpr SerializationTextMemberTable<SerializerStream, T> memberTable;
+
+            const auto* entry = memberTable.find(fieldToFind);
+            return entry != nullptr and entry->load(object, entry->offset, stream);
+        }
+        // UTF16 field names must be compared by code point with the member names
+        MemberIterator iterator{stream, object, fieldToFind};
+        Reflection::Reflect<T>::visit(iterator);
+        return iterator.consumed and iterator.consumedWithSuccess;
+    }
+
     struct MemberIterator
     {
         SerializerStream& stream;
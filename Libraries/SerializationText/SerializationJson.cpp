@@ -4,10 +4,20 @@
 #include "../Common/CompilerBuiltins.h"
 #include "../Common/Result.h"
 
-#include <errno.h>
+#include <locale.h> // localeconv
 #include <stdint.h>
 #include <stdio.h>
-#include <stdlib.h>
+#include <stdlib.h> // strtod, strtof
+
+namespace SC
+{
+namespace SerializationJsonDetail
+{
+#include "../Common/NumberConversion.inl"
+}
+} // namespace SC
+
+#include "Internal/JsonStructuralIndex.inl"
 
 namespace
 {
@@ -171,54 +181,49 @@ bool containsJSONEscape(StringSpan escaped)
     return false;
 }
 
-template <size_t N>
-bool copyTokenToBuffer(StringSpan token, char (&buffer)[N])
+bool parseInt32(StringSpan token, int32_t& value)
 {
-    if (token.getEncoding() == StringEncoding::Utf16 or token.sizeInBytes() >= N)
+    const char* it  = token.bytesWithoutTerminator();
+    const char* end = it + token.sizeInBytes();
+
+    const bool negative = it != end and *it == '-';
+    if (it != end and (*it == '-' or *it == '+'))
+    {
+        it++;
+    }
+    if (it == end or token.getEncoding() == StringEncoding::Utf16)
     {
         return false;
     }
-    CompilerBuiltins::copy(buffer, token.bytesWithoutTerminator(), token.sizeInBytes());
-    buffer[token.sizeInBytes()] = 0;
-    return true;
-}
-
-bool parseInt32(StringSpan token, int32_t& value)
-{
-    char buffer[32];
-    SC_TRY(copyTokenToBuffer(token, buffer));
-    errno        = 0;
-    char* end    = nullptr;
-    long  parsed = ::strtol(buffer, &end, 10);
-    if (errno == 0 and buffer < end and parsed >= INT32_MIN and parsed <= INT32_MAX)
+    int64_t parsed = 0;
+    for (; it != end; ++it)
     {
-        value = static_cast<int32_t>(parsed);
-        return true;
+        const uint32_t digit = static_cast<uint32_t>(*it - '0');
+        if (digit > 9)
+        {
+            // Accepts numbers with fractional part or exponent (like 2.0 or 1e3) only if they are integral
+            double number;
+            SC_TRY(SerializationJsonDetail::NumberConversion::parseDouble(token, number));
+            SC_TRY(number >= INT32_MIN and number <= INT32_MAX and number == static_cast<double>(int32_t(number)));
+            value = static_cast<int32_t>(number);
+            return true;
+        }
+        parsed = parsed * 10 + digit;
+        if (parsed > int64_t(INT32_MAX) + 1)
+        {
+            return false;
+        }
     }
-    return false;
-}
-
-bool parseFloat(StringSpan token, float& value)
-{
-    char buffer[64];
-    SC_TRY(copyTokenToBuffer(token, buffer));
-    char* end = nullptr;
-    value     = ::strtof(buffer, &end);
-    return buffer < end;
-}
-
-bool appendFormatted(SerializationTextOutput& output, const char* format, int value)
-{
-    char      buffer[32];
-    const int numChars = ::snprintf(buffer, sizeof(buffer), format, value);
-    if (numChars < 0 or static_cast<size_t>(numChars) >= sizeof(buffer))
+    parsed = negative ? -parsed : parsed;
+    if (parsed > INT32_MAX)
     {
         return false;
     }
-    return output.append(StringSpan({buffer, static_cast<size_t>(numChars)}, false, StringEncoding::Ascii));
+    value = static_cast<int32_t>(parsed);
+    return true;
 }
 
-bool appendFormatted(SerializationTextOutput& output, uint8_t floatDigits, double value)
+bool appendFixed(SerializationTextOutput& output, uint8_t floatDigits, double value)
 {
     char      buffer[64];
     const int numChars = ::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(floatDigits), value);
@@ -334,20 +339,40 @@ bool SC::SerializationJson::Writer::serialize(uint32_t index, StringSpan text)
 
 bool SC::SerializationJson::Writer::serialize(uint32_t index, float value)
 {
+    // JSON has no representation for nan and infinities
+    SC_TRY(value == value and value - value == 0);
     SC_TRY(eventuallyAddComma(index));
-    return appendFormatted(output, options.floatDigits, static_cast<double>(value));
+    if (options.floatDigits > 0)
+    {
+        return appendFixed(output, options.floatDigits, static_cast<double>(value));
+    }
+    char       buffer[SerializationJsonDetail::NumberConversion::MaxChars];
+    StringSpan text;
+    SC_TRY(SerializationJsonDetail::NumberConversion::formatFloat(value, buffer, text));
+    return output.append(text);
 }
 
 bool SC::SerializationJson::Writer::serialize(uint32_t index, double value)
 {
+    SC_TRY(value == value and value - value == 0);
     SC_TRY(eventuallyAddComma(index));
-    return appendFormatted(output, options.floatDigits, value);
+    if (options.floatDigits > 0)
+    {
+        return appendFixed(output, options.floatDigits, value);
+    }
+    char       buffer[SerializationJsonDetail::NumberConversion::MaxChars];
+    StringSpan text;
+    SC_TRY(SerializationJsonDetail::NumberConversion::formatDouble(value, buffer, text));
+    return output.append(text);
 }
 
 bool SC::SerializationJson::Writer::serialize(uint32_t index, int value)
 {
     SC_TRY(eventuallyAddComma(index));
-    return appendFormatted(output, "%d", value);
+    char       buffer[SerializationJsonDetail::NumberConversion::MaxChars];
+    StringSpan text;
+    SC_TRY(SerializationJsonDetail::NumberConversion::formatInt64(value, buffer, text));
+    return output.append(text);
 }
 
 bool SC::SerializationJson::Writer::eventuallyAddComma(uint32_t index) { return index > 0 ? output.append(",") : true; }
@@ -473,12 +498,20 @@ bool SC::SerializationJson::Reader::serialize(uint32_t index, bool& value)
 
 bool SC::SerializationJson::Reader::serialize(uint32_t index, float& value)
 {
-    (void)(value);
     SC_TRY(eventuallyExpectComma(index));
     JsonTokenizer::Token token;
     SC_TRY(JsonTokenizer::tokenizeNext(iterator, token));
     SC_TRY(token.getType() == JsonTokenizer::Token::Number);
-    return parseFloat(token.getToken(iteratorText), value);
+    return SerializationJsonDetail::NumberConversion::parseFloat(token.getToken(iteratorText), value);
+}
+
+bool SC::SerializationJson::Reader::serialize(uint32_t index, double& value)
+{
+    SC_TRY(eventuallyExpectComma(index));
+    JsonTokenizer::Token token;
+    SC_TRY(JsonTokenizer::tokenizeNext(iterator, token));
+    SC_TRY(token.getType() == JsonTokenizer::Token::Number);
+    return SerializationJsonDetail::NumberConversion::parseDouble(token.getToken(iteratorText), value);
 }
 
 bool SC::SerializationJson::Reader::serialize(uint32_t index, int32_t& value)
@@ -52,8 +52,10 @@ struct SC::SerializationJson
     /// @brief Formatting options
     struct SC_SERIALIZATION_TEXT_EXPORT Options
     {
-        uint8_t floatDigits; ///< How many digits should be used when printing floating points
-        Options() { floatDigits = 2; }
+        /// How many fractional digits should be used when printing floating points.
+        /// Zero (the default) prints the shortest text that parses back to the exact same value.
+        uint8_t floatDigits;
+        Options() { floatDigits = 0; }
     };
 
     /// @brief Writes a C++ object to JSON using Reflection.
@@ -114,6 +116,38 @@ struct SC::SerializationJson
         return Serialization::SerializationTextReadVersioned<Reader, T, void>::loadVersioned(0, object, stream);
     }
 
+    /// @brief Same as SerializationJson::loadExact, but tokenizing through a structural index built upfront
+    /// @param object Object to load
+    /// @param text Json text to be deserialized
+    /// @param structurals Scratch memory for the index, holding at least one entry per byte of `text`
+    /// @return `true` if load succeeded
+    /// @see JsonTokenizer::buildStructuralIndex
+    template <typename T>
+    [[nodiscard]] static bool loadExact(T& object, StringSpan text, Span<uint32_t> structurals)
+    {
+        size_t numStructurals = 0;
+        if (not JsonTokenizer::buildStructuralIndex(text, structurals, numStructurals))
+            return false;
+        Reader stream(text, {structurals.data(), numStructurals});
+        return Serialization::SerializationTextReadWriteExact<Reader, T>::serialize(0, object, stream);
+    }
+
+    /// @brief Same as SerializationJson::loadVersioned, but tokenizing through a structural index built upfront
+    /// @param object Object to load
+    /// @param text Json text to be deserialized
+    /// @param structurals Scratch memory for the index, holding at least one entry per byte of `text`
+    /// @return `true` if load succeeded
+    /// @see JsonTokenizer::buildStructuralIndex
+    template <typename T>
+    [[nodiscard]] static bool loadVersioned(T& object, StringSpan text, Span<uint32_t> structurals)
+    {
+        size_t numStructurals = 0;
+        if (not JsonTokenizer::buildStructuralIndex(text, structurals, numStructurals))
+            return false;
+        Reader stream(text, {structurals.data(), numStructurals});
+        return Serialization::SerializationTextReadVersioned<Reader, T, void>::loadVersioned(0, object, stream);
+    }
+
   private:
     /// @brief Writer interface for Serializer that generates output JSON from C++ types.
     /// Its methods are meant to be called by Serializer
@@ -177,6 +211,7 @@ struct SC::SerializationJson
     struct SC_SERIALIZATION_TEXT_EXPORT Reader
     {
         Reader(StringSpan text) : iteratorText(text), iterator(text) {}
+        Reader(StringSpan text, Span<const uint32_t> structurals) : iteratorText(text), iterator(text, structurals) {}
 
         [[nodiscard]] bool onSerializationStart() { return true; }
         [[nodiscard]] bool onSerializationEnd() { return true; }
@@ -211,6 +246,7 @@ struct SC::SerializationJson
 
         [[nodiscard]] bool serialize(uint32_t index, bool& value);
         [[nodiscard]] bool serialize(uint32_t index, float& value);
+        [[nodiscard]] bool serialize(uint32_t index, double& value);
         [[nodiscard]] bool serialize(uint32_t index, int32_t& value);
         [[nodiscard]] bool serialize(uint32_t index, StringSpan& value);
 
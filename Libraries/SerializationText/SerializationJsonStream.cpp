@@ -0,0 +1,498 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "SerializationJsonStream.h"
+#include "../Common/CompilerBuiltins.h"
+
+namespace
+{
+using namespace SC;
+
+constexpr bool isWhitespace(char character)
+{
+    return character == ' ' or character == '\n' or character == '\r' or character == '\t';
+}
+
+constexpr bool isDigit(char character) { return character >= '0' and character <= '9'; }
+
+constexpr bool isNumberCharacter(char character)
+{
+    return isDigit(character) or character == '-' or character == '+' or character == '.' or character == 'e' or
+           character == 'E';
+}
+
+constexpr bool isLiteralCharacter(char character) { return character >= 'a' and character <= 'z'; }
+
+// Validates JSON number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isValidNumber(const char* it, const char* end)
+{
+    if (it != end and *it == '-')
+        it++;
+    if (it == end)
+        return false;
+    if (*it == '0')
+    {
+        it++;
+    }
+    else
+    {
+        if (not isDigit(*it))
+            return false;
+        while (it != end and isDigit(*it))
+            it++;
+    }
+    if (it != end and *it == '.')
+    {
+        it++;
+        if (it == end or not isDigit(*it))
+            return false;
+        while (it != end and isDigit(*it))
+            it++;
+    }
+    if (it != end and (*it == 'e' or *it == 'E'))
+    {
+        it++;
+        if (it != end and (*it == '+' or *it == '-'))
+            it++;
+        if (it == end or not isDigit(*it))
+            return false;
+        while (it != end and isDigit(*it))
+            it++;
+    }
+    return it == end;
+}
+
+bool parseHex4(const char* text, uint32_t& value)
+{
+    value = 0;
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        const char c = text[idx];
+        uint32_t   digit;
+        if (c >= '0' and c <= '9')
+            digit = static_cast<uint32_t>(c - '0');
+        else if (c >= 'a' and c <= 'f')
+            digit = static_cast<uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' and c <= 'F')
+            digit = static_cast<uint32_t>(c - 'A' + 10);
+        else
+            return false;
+        value = (value << 4) | digit;
+    }
+    return true;
+}
+
+// Decodes escape sequences in place, as decoded text is never longer than its escaped form
+bool unescapeInPlace(char* text, size_t& length)
+{
+    size_t writeIndex = 0;
+    for (size_t readIndex = 0; readIndex < length;)
+    {
+        const char character = text[readIndex++];
+        if (character != '\\')
+        {
+            text[writeIndex++] = character;
+            continue;
+        }
+        if (readIndex == length)
+            return false;
+        const char escape = text[readIndex++];
+        switch (escape)
+        {
+        case '"':
+        case '\\':
+        case '/': text[writeIndex++] = escape; continue;
+        case 'b': text[writeIndex++] = '\b'; continue;
+        case 'f': text[writeIndex++] = '\f'; continue;
+        case 'n': text[writeIndex++] = '\n'; continue;
+        case 'r': text[writeIndex++] = '\r'; continue;
+        case 't': text[writeIndex++] = '\t'; continue;
+        case 'u': break;
+        default: return false;
+        }
+        uint32_t codePoint;
+        if (readIndex + 4 > length or not parseHex4(text + readIndex, codePoint))
+            return false;
+        readIndex += 4;
+        if (codePoint >= 0xd800 and codePoint <= 0xdbff)
+        {
+            // High surrogate must be followed by an escaped low surrogate
+            uint32_t lowSurrogate;
+            if (readIndex + 6 > length or text[readIndex] != '\\' or text[readIndex + 1] != 'u' or
+                not parseHex4(text + readIndex + 2, lowSurrogate) or lowSurrogate < 0xdc00 or lowSurrogate > 0xdfff)
+                return false;
+            readIndex += 6;
+            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+        }
+        else if (codePoint >= 0xdc00 and codePoint <= 0xdfff)
+        {
+            return false;
+        }
+
+        if (codePoint <= 0x7f)
+        {
+            text[writeIndex++] = static_cast<char>(codePoint);
+        }
+        else if (codePoint <= 0x7ff)
+        {
+            text[writeIndex++] = static_cast<char>(0xc0 | (codePoint >> 6));
+            text[writeIndex++] = static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+        else if (codePoint <= 0xffff)
+        {
+            text[writeIndex++] = static_cast<char>(0xe0 | (codePoint >> 12));
+            text[writeIndex++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+            text[writeIndex++] = static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+        else
+        {
+            text[writeIndex++] = static_cast<char>(0xf0 | (codePoint >> 18));
+            text[writeIndex++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+            text[writeIndex++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+            text[writeIndex++] = static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+    }
+    length = writeIndex;
+    return true;
+}
+} // namespace
+
+SC::Result SC::JsonStreamReader::init(JsonStreamListener& listenerValue, Span<char> bufferValue,
+                                      uint32_t captureDepthValue)
+{
+    SC_TRY_MSG(captureDepthValue <= MaxDepth, "JsonStreamReader: invalid capture depth");
+
+    listener     = &listenerValue;
+    buffer       = bufferValue;
+    bufferLength = 0;
+    captureDepth = captureDepthValue;
+    depth        = 0;
+    for (uint64_t& bits : nesting)
+    {
+        bits = 0;
+    }
+    numBytesParsed = 0;
+    expect         = Expect::Value;
+    token          = Token::None;
+    capturing      = false;
+    failed         = false;
+    escaped        = false;
+    hasEscapes     = false;
+    pendingStart   = nullptr;
+    return Result(true);
+}
+
+SC::Result SC::JsonStreamReader::write(Span<const char> chunk)
+{
+    SC_TRY_MSG(listener != nullptr, "JsonStreamReader: not initialized");
+    SC_TRY_MSG(not failed, "JsonStreamReader: a previous write failed");
+
+    const char* it  = chunk.data();
+    const char* end = it + chunk.sizeInBytes();
+    if (token != Token::None or capturing)
+    {
+        pendingStart = it; // a token or captured value continues from previous chunk
+    }
+    Result res = parseChunk(it, end);
+    if (res and (token != Token::None or capturing))
+    {
+        res = appendPending(end);
+    }
+    numBytesParsed += static_cast<uint64_t>(it - chunk.data());
+    pendingStart = nullptr;
+    failed       = not res;
+    return res;
+}
+
+SC::Result SC::JsonStreamReader::end()
+{
+    SC_TRY_MSG(listener != nullptr, "JsonStreamReader: not initialized");
+    SC_TRY_MSG(not failed, "JsonStreamReader: a previous write failed");
+    if (token == Token::Number or token == Token::Literal)
+    {
+        // A scalar root value (or a captured one) can only be terminated by the end of the document
+        Result res = finishToken(nullptr);
+        if (not res)
+        {
+            failed = true;
+            return res;
+        }
+    }
+    SC_TRY_MSG(token == Token::None and expect == Expect::Done, "JsonStreamReader: incomplete document");
+    return Result(true);
+}
+
+SC::Result SC::JsonStreamReader::parseChunk(const char*& it, const char* end)
+{
+    while (it < end)
+    {
+        if (token != Token::None)
+        {
+            SC_TRY(continueToken(it, end));
+        }
+        else if (isWhitespace(*it))
+        {
+            it++;
+        }
+        else
+        {
+            SC_TRY(parseStructural(it));
+        }
+    }
+    return Result(true);
+}
+
+SC::Result SC::JsonStreamReader::parseStructural(const char*& it)
+{
+    const char character = *it;
+    if ((expect == Expect::KeyOrObjectEnd and character == '}') or
+        (expect == Expect::ValueOrArrayEnd and character == ']'))
+    {
+        return endContainer(it); // empty object or array
+    }
+    switch (expect)
+    {
+    case Expect::Value:
+    case Expect::ValueOrArrayEnd: return startValue(it);
+    case Expect::Key:
+    case Expect::KeyOrObjectEnd:
+        SC_TRY_MSG(character == '"', "JsonStreamReader: expected field name");
+        it++;
+        startToken(Token::Key, it);
+        return Result(true);
+    case Expect::Colon:
+        SC_TRY_MSG(character == ':', "JsonStreamReader: expected ':'");
+        it++;
+        expect = Expect::Value;
+        return Result(true);
+    case Expect::CommaOrEnd:
+        if (character == ',')
+        {
+            it++;
+            expect = isInObject() ? Expect::Key : Expect::Value;
+            return Result(true);
+        }
+        SC_TRY_MSG(character == (isInObject() ? '}' : ']'), "JsonStreamReader: expected ',' or end of container");
+        return endContainer(it);
+    case Expect::Done: break;
+    }
+    return Result::Error("JsonStreamReader: unexpected data after the root value");
+}
+
+SC::Result SC::JsonStreamReader::startValue(const char*& it)
+{
+    if (captureDepth > 0 and depth == captureDepth and not capturing)
+    {
+        capturing    = true;
+        pendingStart = it;
+    }
+    const char character = *it;
+    switch (character)
+    {
+    case '{':
+    case '[': {
+        SC_TRY_MSG(depth < MaxDepth, "JsonStreamReader: nesting too deep");
+        const bool isObject = character == '{';
+        if (isObject)
+            nesting[depth / 64] |= uint64_t(1) << (depth % 64);
+        else
+            nesting[depth / 64] &= ~(uint64_t(1) << (depth % 64));
+        depth++;
+        it++;
+        expect = isObject ? Expect::KeyOrObjectEnd : Expect::ValueOrArrayEnd;
+        if (not capturing)
+        {
+            SC_TRY_MSG(isObject ? listener->onObjectStart() : listener->onArrayStart(),
+                       "JsonStreamReader: listener stopped parsing");
+        }
+        return Result(true);
+    }
+    case '"': it++; startToken(Token::String, it); break;
+    default:
+        if (character == '-' or isDigit(character))
+        {
+            startToken(Token::Number, it);
+        }
+        else if (isLiteralCharacter(character))
+        {
+            startToken(Token::Literal, it);
+        }
+        else
+        {
+            return Result::Error("JsonStreamReader: unexpected character");
+        }
+        break;
+    }
+    return Result(true);
+}
+
+void SC::JsonStreamReader::startToken(Token type, const char* tokenStart)
+{
+    token      = type;
+    escaped    = false;
+    hasEscapes = false;
+    if (not capturing)
+    {
+        pendingStart = tokenStart; // captured values already track their own start
+    }
+}
+
+SC::Result SC::JsonStreamReader::endContainer(const char*& it)
+{
+    depth--;
+    it++;
+    if (not capturing)
+    {
+        SC_TRY_MSG(isInObjectAt(depth) ? listener->onObjectEnd() : listener->onArrayEnd(),
+                   "JsonStreamReader: listener stopped parsing");
+    }
+    return finishValue(it);
+}
+
+SC::Result SC::JsonStreamReader::continueToken(const char*& it, const char* end)
+{
+    const char* current = it;
+    if (token == Token::String or token == Token::Key)
+    {
+        for (; current < end; ++current)
+        {
+            const char character = *current;
+            if (escaped)
+            {
+                escaped = false;
+            }
+            else if (character == '\\')
+            {
+                escaped    = true;
+                hasEscapes = true;
+            }
+            else if (character == '"')
+            {
+                it = current + 1;
+                return finishToken(current);
+            }
+            else if (static_cast<unsigned char>(character) < 0x20)
+            {
+                it = current;
+                return Result::Error("JsonStreamReader: control character in string");
+            }
+        }
+        it = end;
+        return Result(true);
+    }
+    if (token == Token::Number)
+    {
+        while (current < end and isNumberCharacter(*current))
+            current++;
+    }
+    else
+    {
+        while (current < end and isLiteralCharacter(*current))
+            current++;
+    }
+    it = current;
+    return current < end ? finishToken(current) : Result(true);
+}
+
+SC::Result SC::JsonStreamReader::finishToken(const char* tokenEnd)
+{
+    const Token finished = token;
+    token                = Token::None;
+    if (capturing)
+    {
+        // Tokens inside a captured value are validated by whoever parses the captured text
+        if (finished == Token::Key)
+        {
+            expect = Expect::Colon;
+            return Result(true);
+        }
+        return finishValue(finished == Token::String ? tokenEnd + 1 : tokenEnd);
+    }
+
+    if (bufferLength > 0 or hasEscapes)
+    {
+        SC_TRY(appendPending(tokenEnd));
+    }
+    const bool  inBuffer = bufferLength > 0 or hasEscapes;
+    const char* text     = inBuffer ? buffer.data() : pendingStart;
+    size_t      length   = inBuffer ? bufferLength : static_cast<size_t>(tokenEnd - pendingStart);
+    bufferLength         = 0;
+    pendingStart         = nullptr;
+
+    bool accepted = true;
+    switch (finished)
+    {
+    case Token::Key:
+    case Token::String: {
+        SC_TRY_MSG(not hasEscapes or unescapeInPlace(buffer.data(), length), "JsonStreamReader: invalid escape");
+        const StringSpan decoded({text, length}, false, StringEncoding::Utf8);
+        if (finished == Token::Key)
+        {
+            SC_TRY_MSG(listener->onKey(decoded), "JsonStreamReader: listener stopped parsing");
+            expect = Expect::Colon;
+            return Result(true);
+        }
+        accepted = listener->onString(decoded);
+    }
+    break;
+    case Token::Number:
+        SC_TRY_MSG(isValidNumber(text, text + length), "JsonStreamReader: invalid number");
+        accepted = listener->onNumber(StringSpan({text, length}, false, StringEncoding::Ascii));
+        break;
+    case Token::Literal: {
+        const StringSpan literal({text, length}, false, StringEncoding::Ascii);
+        if (literal == StringSpan("true"))
+            accepted = listener->onBoolean(true);
+        else if (literal == StringSpan("false"))
+            accepted = listener->onBoolean(false);
+        else if (literal == StringSpan("null"))
+            accepted = listener->onNull();
+        else
+            return Result::Error("JsonStreamReader: invalid literal");
+    }
+    break;
+    case Token::None: break;
+    }
+    SC_TRY_MSG(accepted, "JsonStreamReader: listener stopped parsing");
+    return finishValue(tokenEnd);
+}
+
+SC::Result SC::JsonStreamReader::finishValue(const char* valueEnd)
+{
+    if (capturing and depth == captureDepth)
+    {
+        if (bufferLength > 0)
+        {
+            SC_TRY(appendPending(valueEnd));
+        }
+        const char*  text   = bufferLength > 0 ? buffer.data() : pendingStart;
+        const size_t length = bufferLength > 0 ? bufferLength : static_cast<size_t>(valueEnd - pendingStart);
+
+        bufferLength = 0;
+        pendingStart = nullptr;
+        capturing    = false;
+        SC_TRY_MSG(listener->onValue(StringSpan({text, length}, false, StringEncoding::Utf8)),
+                   "JsonStreamReader: listener stopped parsing");
+    }
+    expect = depth == 0 ? Expect::Done : Expect::CommaOrEnd;
+    return Result(true);
+}
+
+SC::Result SC::JsonStreamReader::appendPending(const char* until)
+{
+    const size_t length = static_cast<size_t>(until - pendingStart);
+    SC_TRY_MSG(length <= buffer.sizeInBytes() - bufferLength, "JsonStreamReader: buffer too small for token or value");
+    if (length > 0)
+    {
+        CompilerBuiltins::copy(buffer.data() + bufferLength, pendingStart, length);
+    }
+    bufferLength += length;
+    pendingStart = until;
+    return Result(true);
+}
+
+bool SC::JsonStreamReader::isInObject() const { return depth > 0 and isInObjectAt(depth - 1); }
+
+bool SC::JsonStreamReader::isInObjectAt(uint32_t level) const
+{
+    return (nesting[level / 64] & (uint64_t(1) << (level % 64))) != 0;
+}
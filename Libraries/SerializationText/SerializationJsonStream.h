@@ -0,0 +1,234 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../Common/Result.h"
+#include "../Common/StringSpan.h"
+#include "SerializationJson.h"
+
+namespace SC
+{
+struct SC_SERIALIZATION_TEXT_EXPORT JsonStreamListener;
+struct SC_SERIALIZATION_TEXT_EXPORT JsonStreamReader;
+template <typename T_Readable>
+struct JsonStreamReaderAsyncT;
+} // namespace SC
+
+//! @addtogroup group_serialization_text
+//! @{
+
+/// @brief Receives events parsed by JsonStreamReader.
+/// Text passed to callbacks is only valid for the duration of the callback.
+/// Returning `false` from any callback stops parsing, making JsonStreamReader::write fail.
+struct SC::JsonStreamListener
+{
+    virtual ~JsonStreamListener() {}
+
+    virtual bool onObjectStart() { return true; }
+    virtual bool onObjectEnd() { return true; }
+    virtual bool onArrayStart() { return true; }
+    virtual bool onArrayEnd() { return true; }
+
+    /// @brief Called for each object field name, with escape sequences already decoded
+    virtual bool onKey(StringSpan key) { return (void)key, true; }
+
+    /// @brief Called for each string value, with escape sequences already decoded
+    virtual bool onString(StringSpan value) { return (void)value, true; }
+
+    /// @brief Called for each number, passing its validated text (parse it with StringView::parseDouble or similar)
+    virtual bool onNumber(StringSpan number) { return (void)number, true; }
+
+    virtual bool onBoolean(bool value) { return (void)value, true; }
+    virtual bool onNull() { return true; }
+
+    /// @brief Called with the complete text of each value found at JsonStreamReader::init `captureDepth`, replacing
+    /// all the events that would be generated for it. Pass it to SerializationJson::loadExact or loadVersioned.
+    virtual bool onValue(StringSpan json) { return (void)json, true; }
+
+    /// @brief Called when the stream bound with JsonStreamReaderAsyncT::attach ends with a complete document
+    virtual void onEnd() {}
+
+    /// @brief Called when the stream bound with JsonStreamReaderAsyncT::attach fails or contains invalid JSON.
+    /// The reader is detached from the stream before calling this function.
+    virtual void onError(Result error) { (void)(error); }
+};
+
+/// @brief Incremental JSON parser consuming a document in chunks of arbitrary size, as they arrive.
+/// Events are delivered to a JsonStreamListener without ever holding the entire document in memory.
+/// Memory usage is bounded by the caller provided buffer, independently from the size of the document or the length
+/// of its arrays, as it only needs to hold a single string, number or captured value when split between two chunks.
+/// Tokens contained entirely in a chunk are passed to the listener without copying them.
+///
+/// When `captureDepth` is greater than zero, every value nested at that depth (for example `1` for the elements of a
+/// root array) is delivered as text to JsonStreamListener::onValue, so that it can be loaded into a C++ object with
+/// SerializationJson while the rest of the document is still arriving.
+///
+/// Example:
+/// \snippet Tests/Libraries/SerializationText/SerializationJsonStreamTest.cpp serializationJsonStreamSnippet
+struct SC::JsonStreamReader
+{
+    static constexpr uint32_t MaxDepth = 256; ///< Maximum nesting of objects and arrays
+
+    /// @brief Prepares the reader to parse a new document
+    /// @param listener Receives parsing events
+    /// @param buffer Memory holding tokens or captured values split between chunks (bounds their maximum length)
+    /// @param captureDepth Depth of values delivered to JsonStreamListener::onValue as text (zero disables it)
+    Result init(JsonStreamListener& listener, Span<char> buffer, uint32_t captureDepth = 0);
+
+    /// @brief Parses the next chunk of the document
+    /// @param chunk Bytes that can be discarded by the caller as soon as this function returns
+    /// @return Invalid JSON, a token longer than the buffer or a listener returning `false` produce an error
+    Result write(Span<const char> chunk);
+
+    /// @brief Signals that the document has been fully written, checking that it has been completed
+    Result end();
+
+    /// @brief Returns the listener passed to JsonStreamReader::init
+    [[nodiscard]] JsonStreamListener* getListener() const { return listener; }
+
+    /// @brief Returns the number of bytes consumed so far, useful to locate errors
+    [[nodiscard]] uint64_t getNumBytesParsed() const { return numBytesParsed; }
+
+    /// @brief Returns the current nesting depth of objects and arrays
+    [[nodiscard]] uint32_t getDepth() const { return depth; }
+
+  private:
+    enum class Expect : uint8_t
+    {
+        Value,           // A value (document start, after ':' or after ',' in arrays)
+        ValueOrArrayEnd, // First element of an array
+        Key,             // Field name after ',' in objects
+        KeyOrObjectEnd,  // First field of an object
+        Colon,           // ':' after a field name
+        CommaOrEnd,      // ',' or end of the current container
+        Done,            // Only whitespace can follow the root value
+    };
+    enum class Token : uint8_t
+    {
+        None,
+        String,
+        Key,
+        Number,
+        Literal,
+    };
+
+    JsonStreamListener* listener = nullptr;
+
+    Span<char> buffer;
+    size_t     bufferLength = 0;
+
+    uint32_t captureDepth = 0;
+    uint32_t depth        = 0;
+    uint64_t nesting[MaxDepth / 64]; // One bit per depth level, set for objects and cleared for arrays
+
+    uint64_t numBytesParsed = 0;
+
+    Expect expect     = Expect::Value;
+    Token  token      = Token::None;
+    bool   capturing  = false;
+    bool   failed     = false;
+    bool   escaped    = false; // Previous string character was a backslash
+    bool   hasEscapes = false; // Current string contains escape sequences
+
+    const char* pendingStart = nullptr; // Start of the token or captured value in the chunk being parsed
+
+    Result parseChunk(const char*& it, const char* end);
+    Result parseStructural(const char*& it);
+    Result startValue(const char*& it);
+    Result endContainer(const char*& it);
+    void   startToken(Token type, const char* tokenStart);
+    Result continueToken(const char*& it, const char* end);
+    Result finishToken(const char* tokenEnd);
+    Result finishValue(const char* valueEnd);
+    Result appendPending(const char* until);
+    bool   isInObject() const;
+    bool   isInObjectAt(uint32_t level) const;
+};
+
+/// @brief Parses chunks from eventData of an SC::AsyncReadableStream (for example an HTTP request body) with a
+/// JsonStreamReader, calling JsonStreamReader::end on its eventEnd.
+/// Results are reported through JsonStreamListener::onEnd and JsonStreamListener::onError.
+///
+/// This class exists as a template to break the dependency of SerializationText from AsyncStreams.
+/// @tparam T_Readable SC::AsyncReadableStream (or a type exposing the same events and buffers pool)
+template <typename T_Readable>
+struct SC::JsonStreamReaderAsyncT
+{
+    /// @brief Starts feeding the (already initialized) reader with data emitted by the readable stream
+    Result attach(JsonStreamReader& jsonReader, T_Readable& readableStream)
+    {
+        SC_TRY_MSG(jsonReader.getListener() != nullptr, "JsonStreamReaderAsyncT: reader not initialized");
+        SC_TRY_MSG(readable == nullptr, "JsonStreamReaderAsyncT: already attached");
+
+        bool added = readableStream.eventData.template addListener<Self, &Self::onStreamData>(*this);
+        added      = added and readableStream.eventEnd.template addListener<Self, &Self::onStreamEnd>(*this);
+        added      = added and readableStream.eventError.template addListener<Self, &Self::onStreamError>(*this);
+        if (not added)
+        {
+            removeListeners(readableStream);
+            return Result::Error("JsonStreamReaderAsyncT: too many stream listeners");
+        }
+        reader   = &jsonReader;
+        readable = &readableStream;
+        return Result(true);
+    }
+
+    /// @brief Stops listening to the readable stream bound with JsonStreamReaderAsyncT::attach
+    Result detach()
+    {
+        if (readable != nullptr)
+        {
+            removeListeners(*readable);
+            readable = nullptr;
+        }
+        return Result(true);
+    }
+
+  private:
+    using Self         = JsonStreamReaderAsyncT;
+    using BufferViewID = typename T_Readable::BufferViewID;
+
+    JsonStreamReader* reader   = nullptr;
+    T_Readable*       readable = nullptr;
+
+    void removeListeners(T_Readable& readableStream)
+    {
+        (void)readableStream.eventData.removeAllListenersBoundTo(*this);
+        (void)readableStream.eventEnd.removeAllListenersBoundTo(*this);
+        (void)readableStream.eventError.removeAllListenersBoundTo(*this);
+    }
+
+    void onStreamData(BufferViewID bufferID)
+    {
+        Span<const char> data;
+        Result           res = readable->getBuffersPool().getReadableData(bufferID, data);
+        if (res)
+        {
+            res = reader->write(data);
+        }
+        if (not res)
+        {
+            onStreamError(res);
+        }
+    }
+
+    void onStreamEnd()
+    {
+        const Result res = reader->end();
+        (void)detach();
+        if (res)
+        {
+            reader->getListener()->onEnd();
+        }
+        else
+        {
+            reader->getListener()->onError(res);
+        }
+    }
+
+    void onStreamError(Result error)
+    {
+        (void)detach();
+        reader->getListener()->onError(error);
+    }
+};
+//! @}
@@ -82,3 +82,35 @@ SC::Result SC::SocketClient::readWithTimeout(Span<char> data, Span<char>& readDa
     SC_TRY_MSG(result != SOCKET_ERROR, "select failed");
     return FD_ISSET(nativeSocket, &fds) ? read(data, readData) : Result(false);
 }
+
+SC::Result SC::SocketClient::probeConnection(bool& peerClosed, bool& hasPendingData)
+{
+    peerClosed     = false;
+    hasPendingData = false;
+    SocketDescriptor::Handle nativeSocket;
+    SC_TRY(socket.get(nativeSocket, Result::Error("Invalid socket")));
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(nativeSocket, &fds);
+
+    struct timeval tv;
+    tv.tv_sec  = 0;
+    tv.tv_usec = 0;
+#if SC_PLATFORM_WINDOWS
+    int maxFd = -1;
+#else
+    int maxFd = nativeSocket;
+#endif
+    const auto result = ::select(maxFd + 1, &fds, nullptr, nullptr, &tv);
+    SC_TRY_MSG(result != SOCKET_ERROR, "select failed");
+    if (not FD_ISSET(nativeSocket, &fds))
+    {
+        return Result(true); // Nothing to read and no hangup: connection is idle and alive
+    }
+    // Readable socket means either pending data or EOF / error, that a peek tells apart
+    char       byte;
+    const auto recvSize = ::recv(nativeSocket, &byte, 1, MSG_PEEK);
+    peerClosed          = recvSize <= 0;
+    hasPendingData      = recvSize > 0;
+    return Result(true);
+}
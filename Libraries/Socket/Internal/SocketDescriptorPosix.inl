@@ -9,6 +9,21 @@
 #include <fcntl.h>       // fcntl
 #include <netdb.h>       // AF_INET / IPPROTO_TCP / AF_UNSPEC
 #include <netinet/tcp.h> // TCP_NODELAY
+#if SC_PLATFORM_LINUX
+#include <netinet/udp.h> // UDP_GRO
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104 // Linux 5.0
+#endif
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46 // Linux 3.11
+#endif
+#ifndef TCP_FASTOPEN_CONNECT
+#define TCP_FASTOPEN_CONNECT 30 // Linux 4.11
+#endif
+#endif
 #include <unistd.h>      // close
 
 namespace SC
@@ -74,6 +89,33 @@ static Result setFileStatusFlags(int fileDescriptor, bool setFlag)
     static_assert(flag == O_NONBLOCK, "setFileStatusFlags invalid value");
     return setFileFlags(F_GETFL, F_SETFL, fileDescriptor, setFlag, flag);
 }
+
+static Result setSocketOption(int socket, int level, int option, int value, const char* errorMessage)
+{
+    if (::setsockopt(socket, level, option, &value, sizeof(value)) != 0)
+    {
+        return Result::FromStableCharPointer(errorMessage);
+    }
+    return Result(true);
+}
+
+static Result getSocketOption(int socket, int level, int option, int& value, const char* errorMessage)
+{
+    socklen_t valueLength = sizeof(value);
+    if (::getsockopt(socket, level, option, &value, &valueLength) != 0)
+    {
+        return Result::FromStableCharPointer(errorMessage);
+    }
+    return Result(true);
+}
+
+static Result getSocketOption(int socket, int level, int option, bool& value, const char* errorMessage)
+{
+    int intValue = 0;
+    SC_TRY(getSocketOption(socket, level, option, intValue, errorMessage));
+    value = intValue != 0;
+    return Result(true);
+}
 } // namespace
 
 Result detail::SocketDescriptorDefinition::releaseHandle(Handle& handle)
@@ -103,6 +145,177 @@ Result SocketDescriptor::setTcpNoDelay(bool tcpNoDelay)
     return Result(true);
 }
 
+Result SocketDescriptor::getTcpNoDelay(bool& tcpNoDelay) const
+{
+    return getSocketOption(handle, IPPROTO_TCP, TCP_NODELAY, tcpNoDelay, "getsockopt TCP_NODELAY failed");
+}
+
+Result SocketDescriptor::setReceiveBufferSize(int numBytes)
+{
+    return setSocketOption(handle, SOL_SOCKET, SO_RCVBUF, numBytes, "setsockopt SO_RCVBUF failed");
+}
+
+Result SocketDescriptor::getReceiveBufferSize(int& numBytes) const
+{
+    return getSocketOption(handle, SOL_SOCKET, SO_RCVBUF, numBytes, "getsockopt SO_RCVBUF failed");
+}
+
+Result SocketDescriptor::setSendBufferSize(int numBytes)
+{
+    return setSocketOption(handle, SOL_SOCKET, SO_SNDBUF, numBytes, "setsockopt SO_SNDBUF failed");
+}
+
+Result SocketDescriptor::getSendBufferSize(int& numBytes) const
+{
+    return getSocketOption(handle, SOL_SOCKET, SO_SNDBUF, numBytes, "getsockopt SO_SNDBUF failed");
+}
+
+Result SocketDescriptor::setBusyPoll(int microseconds)
+{
+#if SC_PLATFORM_LINUX
+    return setSocketOption(handle, SOL_SOCKET, SO_BUSY_POLL, microseconds, "setsockopt SO_BUSY_POLL failed");
+#else
+    (void)microseconds;
+    return Result::Error("setBusyPoll is only supported on Linux");
+#endif
+}
+
+Result SocketDescriptor::getBusyPoll(int& microseconds) const
+{
+#if SC_PLATFORM_LINUX
+    return getSocketOption(handle, SOL_SOCKET, SO_BUSY_POLL, microseconds, "getsockopt SO_BUSY_POLL failed");
+#else
+    (void)microseconds;
+    return Result::Error("getBusyPoll is only supported on Linux");
+#endif
+}
+
+Result SocketDescriptor::setReusePort(bool reusePort)
+{
+#if defined(SO_REUSEPORT)
+    return setSocketOption(handle, SOL_SOCKET, SO_REUSEPORT, reusePort ? 1 : 0, "setsockopt SO_REUSEPORT failed");
+#else
+    (void)reusePort;
+    return Result::Error("setReusePort is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::getReusePort(bool& reusePort) const
+{
+#if defined(SO_REUSEPORT)
+    return getSocketOption(handle, SOL_SOCKET, SO_REUSEPORT, reusePort, "getsockopt SO_REUSEPORT failed");
+#else
+    (void)reusePort;
+    return Result::Error("getReusePort is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::setTcpFastOpen(int queueLength)
+{
+#if defined(TCP_FASTOPEN)
+    return setSocketOption(handle, IPPROTO_TCP, TCP_FASTOPEN, queueLength, "setsockopt TCP_FASTOPEN failed");
+#else
+    (void)queueLength;
+    return Result::Error("setTcpFastOpen is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::getTcpFastOpen(int& queueLength) const
+{
+#if defined(TCP_FASTOPEN)
+    return getSocketOption(handle, IPPROTO_TCP, TCP_FASTOPEN, queueLength, "getsockopt TCP_FASTOPEN failed");
+#else
+    (void)queueLength;
+    return Result::Error("getTcpFastOpen is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::setTcpFastOpenConnect(bool fastOpenConnect)
+{
+#if SC_PLATFORM_LINUX
+    return setSocketOption(handle, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, fastOpenConnect ? 1 : 0,
+                           "setsockopt TCP_FASTOPEN_CONNECT failed");
+#else
+    (void)fastOpenConnect;
+    return Result::Error("setTcpFastOpenConnect is only supported on Linux");
+#endif
+}
+
+Result SocketDescriptor::getTcpFastOpenConnect(bool& fastOpenConnect) const
+{
+#if SC_PLATFORM_LINUX
+    return getSocketOption(handle, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, fastOpenConnect,
+                           "getsockopt TCP_FASTOPEN_CONNECT failed");
+#else
+    (void)fastOpenConnect;
+    return Result::Error("getTcpFastOpenConnect is only supported on Linux");
+#endif
+}
+
+Result SocketDescriptor::setTcpCork(bool cork)
+{
+#if SC_PLATFORM_LINUX
+    return setSocketOption(handle, IPPROTO_TCP, TCP_CORK, cork ? 1 : 0, "setsockopt TCP_CORK failed");
+#elif defined(TCP_NOPUSH)
+    return setSocketOption(handle, IPPROTO_TCP, TCP_NOPUSH, cork ? 1 : 0, "setsockopt TCP_NOPUSH failed");
+#else
+    (void)cork;
+    return Result::Error("setTcpCork is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::getTcpCork(bool& cork) const
+{
+#if SC_PLATFORM_LINUX
+    return getSocketOption(handle, IPPROTO_TCP, TCP_CORK, cork, "getsockopt TCP_CORK failed");
+#elif defined(TCP_NOPUSH)
+    return getSocketOption(handle, IPPROTO_TCP, TCP_NOPUSH, cork, "getsockopt TCP_NOPUSH failed");
+#else
+    (void)cork;
+    return Result::Error("getTcpCork is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::setTcpNotSentLowWatermark(int numBytes)
+{
+#if defined(TCP_NOTSENT_LOWAT)
+    return setSocketOption(handle, IPPROTO_TCP, TCP_NOTSENT_LOWAT, numBytes, "setsockopt TCP_NOTSENT_LOWAT failed");
+#else
+    (void)numBytes;
+    return Result::Error("setTcpNotSentLowWatermark is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::getTcpNotSentLowWatermark(int& numBytes) const
+{
+#if defined(TCP_NOTSENT_LOWAT)
+    return getSocketOption(handle, IPPROTO_TCP, TCP_NOTSENT_LOWAT, numBytes, "getsockopt TCP_NOTSENT_LOWAT failed");
+#else
+    (void)numBytes;
+    return Result::Error("getTcpNotSentLowWatermark is not supported on this platform");
+#endif
+}
+
+Result SocketDescriptor::setTcpDeferAccept(int seconds)
+{
+#if SC_PLATFORM_LINUX
+    return setSocketOption(handle, IPPROTO_TCP, TCP_DEFER_ACCEPT, seconds, "setsockopt TCP_DEFER_ACCEPT failed");
+#else
+    (void)seconds;
+    return Result::Error("setTcpDeferAccept is only supported on Linux");
+#endif
+}
+
+Result SocketDescriptor::getTcpDeferAccept(int& seconds) const
+{
+#if SC_PLATFORM_LINUX
+    return getSocketOption(handle, IPPROTO_TCP, TCP_DEFER_ACCEPT, seconds, "getsockopt TCP_DEFER_ACCEPT failed");
+#else
+    (void)seconds;
+    return Result::Error("getTcpDeferAccept is only supported on Linux");
+#endif
+}
+
 Result SocketDescriptor::setBroadcast(bool enableBroadcast)
 {
     int active = enableBroadcast ? 1 : 0;
@@ -111,6 +324,18 @@ Result SocketDescriptor::setBroadcast(bool enableBroadcast)
     return Result(true);
 }
 
+Result SocketDescriptor::setUdpReceiveOffload(bool enableOffload)
+{
+#if SC_PLATFORM_LINUX
+    int active = enableOffload ? 1 : 0;
+    SC_TRY_MSG(::setsockopt(handle, SOL_UDP, UDP_GRO, &active, sizeof(active)) == 0, "setsockopt UDP_GRO failed");
+    return Result(true);
+#else
+    (void)enableOffload;
+    return Result::Error("setUdpReceiveOffload is only supported on Linux");
+#endif
+}
+
 Result SocketDescriptor::joinMulticastGroup(const SocketIPAddress& multicastAddress,
                                             const SocketIPAddress& interfaceAddress)
 {
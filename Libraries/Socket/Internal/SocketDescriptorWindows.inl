@@ -19,6 +19,44 @@ using socklen_t = int;
 #include <stdatomic.h>
 #endif
 
+#ifndef TCP_FASTOPEN
+#define TCP_FASTOPEN 15 // Windows 10 1607
+#endif
+
+namespace SC
+{
+namespace
+{
+static Result setSocketOption(SOCKET socket, int level, int option, int value, const char* errorMessage)
+{
+    if (::setsockopt(socket, level, option, reinterpret_cast<const char*>(&value), sizeof(value)) == SOCKET_ERROR)
+    {
+        return Result::FromStableCharPointer(errorMessage);
+    }
+    return Result(true);
+}
+
+static Result getSocketOption(SOCKET socket, int level, int option, int& value, const char* errorMessage)
+{
+    int valueLength = sizeof(value);
+    if (::getsockopt(socket, level, option, reinterpret_cast<char*>(&value), &valueLength) == SOCKET_ERROR)
+    {
+        return Result::FromStableCharPointer(errorMessage);
+    }
+    return Result(true);
+}
+
+static Result getSocketOption(SOCKET socket, int level, int option, bool& value, const char* errorMessage)
+{
+    // Some boolean options are returned as a single byte, so the int must be zeroed first
+    int intValue = 0;
+    SC_TRY(getSocketOption(socket, level, option, intValue, errorMessage));
+    value = intValue != 0;
+    return Result(true);
+}
+} // namespace
+} // namespace SC
+
 SC::Result SC::detail::SocketDescriptorDefinition::releaseHandle(Handle& handle)
 {
     const int res = ::closesocket(handle);
@@ -54,6 +92,119 @@ SC::Result SC::SocketDescriptor::setTcpNoDelay(bool tcpNoDelay)
     return Result(true);
 }
 
+SC::Result SC::SocketDescriptor::getTcpNoDelay(bool& tcpNoDelay) const
+{
+    return getSocketOption(handle, IPPROTO_TCP, TCP_NODELAY, tcpNoDelay, "getsockopt TCP_NODELAY failed");
+}
+
+SC::Result SC::SocketDescriptor::setReceiveBufferSize(int numBytes)
+{
+    return setSocketOption(handle, SOL_SOCKET, SO_RCVBUF, numBytes, "setsockopt SO_RCVBUF failed");
+}
+
+SC::Result SC::SocketDescriptor::getReceiveBufferSize(int& numBytes) const
+{
+    return getSocketOption(handle, SOL_SOCKET, SO_RCVBUF, numBytes, "getsockopt SO_RCVBUF failed");
+}
+
+SC::Result SC::SocketDescriptor::setSendBufferSize(int numBytes)
+{
+    return setSocketOption(handle, SOL_SOCKET, SO_SNDBUF, numBytes, "setsockopt SO_SNDBUF failed");
+}
+
+SC::Result SC::SocketDescriptor::getSendBufferSize(int& numBytes) const
+{
+    return getSocketOption(handle, SOL_SOCKET, SO_SNDBUF, numBytes, "getsockopt SO_SNDBUF failed");
+}
+
+SC::Result SC::SocketDescriptor::setBusyPoll(int microseconds)
+{
+    (void)microseconds;
+    return Result::Error("setBusyPoll is only supported on Linux");
+}
+
+SC::Result SC::SocketDescriptor::getBusyPoll(int& microseconds) const
+{
+    (void)microseconds;
+    return Result::Error("getBusyPoll is only supported on Linux");
+}
+
+SC::Result SC::SocketDescriptor::setReusePort(bool reusePort)
+{
+    // SO_REUSEADDR on Windows allows stealing ports bound by other processes, so it's not a safe replacement
+    (void)reusePort;
+    return Result::Error("setReusePort is not supported on Windows");
+}
+
+SC::Result SC::SocketDescriptor::getReusePort(bool& reusePort) const
+{
+    (void)reusePort;
+    return Result::Error("getReusePort is not supported on Windows");
+}
+
+SC::Result SC::SocketDescriptor::setTcpFastOpen(int queueLength)
+{
+    // Windows only accepts a boolean, with the same option enabling Fast Open for both servers and ConnectEx
+    const int enabled = queueLength > 0 ? 1 : 0;
+    return setSocketOption(handle, IPPROTO_TCP, TCP_FASTOPEN, enabled, "setsockopt TCP_FASTOPEN failed");
+}
+
+SC::Result SC::SocketDescriptor::getTcpFastOpen(int& queueLength) const
+{
+    bool enabled = false;
+    SC_TRY(getSocketOption(handle, IPPROTO_TCP, TCP_FASTOPEN, enabled, "getsockopt TCP_FASTOPEN failed"));
+    queueLength = enabled ? 1 : 0;
+    return Result(true);
+}
+
+SC::Result SC::SocketDescriptor::setTcpFastOpenConnect(bool fastOpenConnect)
+{
+    (void)fastOpenConnect;
+    return Result::Error("setTcpFastOpenConnect is only supported on Linux");
+}
+
+SC::Result SC::SocketDescriptor::getTcpFastOpenConnect(bool& fastOpenConnect) const
+{
+    (void)fastOpenConnect;
+    return Result::Error("getTcpFastOpenConnect is only supported on Linux");
+}
+
+SC::Result SC::SocketDescriptor::setTcpCork(bool cork)
+{
+    (void)cork;
+    return Result::Error("setTcpCork is not supported on Windows");
+}
+
+SC::Result SC::SocketDescriptor::getTcpCork(bool& cork) const
+{
+    (void)cork;
+    return Result::Error("getTcpCork is not supported on Windows");
+}
+
+SC::Result SC::SocketDescriptor::setTcpNotSentLowWatermark(int numBytes)
+{
+    (void)numBytes;
+    return Result::Error("setTcpNotSentLowWatermark is not supported on Windows");
+}
+
+SC::Result SC::SocketDescriptor::getTcpNotSentLowWatermark(int& numBytes) const
+{
+    (void)numBytes;
+    return Result::Error("getTcpNotSentLowWatermark is not supported on Windows");
+}
+
+SC::Result SC::SocketDescriptor::setTcpDeferAccept(int seconds)
+{
+    (void)seconds;
+    return Result::Error("setTcpDeferAccept is only supported on Linux");
+}
+
+SC::Result SC::SocketDescriptor::getTcpDeferAccept(int& seconds) const
+{
+    (void)seconds;
+    return Result::Error("getTcpDeferAccept is only supported on Linux");
+}
+
 SC::Result SC::SocketDescriptor::setBroadcast(bool enableBroadcast)
 {
     int active = enableBroadcast ? 1 : 0;
@@ -65,6 +216,12 @@ SC::Result SC::SocketDescriptor::setBroadcast(bool enableBroadcast)
     return Result(true);
 }
 
+SC::Result SC::SocketDescriptor::setUdpReceiveOffload(bool enableOffload)
+{
+    (void)enableOffload;
+    return Result::Error("setUdpReceiveOffload is only supported on Linux");
+}
+
 SC::Result SC::SocketDescriptor::joinMulticastGroup(const SocketIPAddress& multicastAddress,
                                                     const SocketIPAddress& interfaceAddress)
 {
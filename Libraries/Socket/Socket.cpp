@@ -31,3 +31,48 @@ SC::Result SC::SocketDescriptor::getAddressFamily(SocketFlags::AddressFamily& ad
     addressFamily = SocketFlags::AddressFamilyFromInt(socketInfo.sin6_family);
     return Result(true);
 }
+
+SC::Result SC::SocketDescriptor::setOptions(const SocketOptions& options)
+{
+    if (options.receiveBufferSize > 0)
+    {
+        SC_TRY(setReceiveBufferSize(options.receiveBufferSize));
+    }
+    if (options.sendBufferSize > 0)
+    {
+        SC_TRY(setSendBufferSize(options.sendBufferSize));
+    }
+    if (options.busyPollMicroseconds > 0)
+    {
+        SC_TRY(setBusyPoll(options.busyPollMicroseconds));
+    }
+    if (options.reusePort)
+    {
+        SC_TRY(setReusePort(true));
+    }
+    if (options.tcpNoDelay)
+    {
+        SC_TRY(setTcpNoDelay(true));
+    }
+    if (options.tcpCork)
+    {
+        SC_TRY(setTcpCork(true));
+    }
+    if (options.tcpNotSentLowWatermark > 0)
+    {
+        SC_TRY(setTcpNotSentLowWatermark(options.tcpNotSentLowWatermark));
+    }
+    if (options.tcpFastOpenQueueLength > 0)
+    {
+        SC_TRY(setTcpFastOpen(options.tcpFastOpenQueueLength));
+    }
+    if (options.tcpFastOpenConnect)
+    {
+        SC_TRY(setTcpFastOpenConnect(true));
+    }
+    if (options.tcpDeferAcceptSeconds > 0)
+    {
+        SC_TRY(setTcpDeferAccept(options.tcpDeferAcceptSeconds));
+    }
+    return Result(true);
+}
@@ -158,6 +158,26 @@ struct SC_SOCKET_EXPORT SocketIPAddress
     struct Internal;
 };
 
+/// @brief Throughput and latency tuning options applied by SC::SocketDescriptor::setOptions.
+/// Zero / `false` fields leave the corresponding OS default untouched.
+/// @note Options affecting connection setup (`reusePort`, `tcpFastOpenQueueLength`, `tcpDeferAcceptSeconds`) must be
+/// applied before SocketServer::bind / SocketServer::listen, while buffer sizes should be set before connecting or
+/// listening for the TCP window scale to account for them.
+struct SocketOptions
+{
+    int receiveBufferSize      = 0; ///< Kernel receive buffer size in bytes (SO_RCVBUF)
+    int sendBufferSize         = 0; ///< Kernel send buffer size in bytes (SO_SNDBUF)
+    int busyPollMicroseconds   = 0; ///< Busy poll the device queue on blocking receives (SO_BUSY_POLL, Linux)
+    int tcpNotSentLowWatermark = 0; ///< Unsent bytes threshold for writability (TCP_NOTSENT_LOWAT, Linux / macOS)
+    int tcpFastOpenQueueLength = 0; ///< Pending TCP Fast Open requests accepted by a server (TCP_FASTOPEN)
+    int tcpDeferAcceptSeconds  = 0; ///< Wake up accept only when data arrives (TCP_DEFER_ACCEPT, Linux)
+
+    bool reusePort          = false; ///< Let multiple sockets bind the same address and port (SO_REUSEPORT)
+    bool tcpNoDelay         = false; ///< Disable Nagle's algorithm (TCP_NODELAY)
+    bool tcpCork            = false; ///< Only send full segments until uncorked (TCP_CORK / TCP_NOPUSH)
+    bool tcpFastOpenConnect = false; ///< Defer the SYN to the first write to carry its data (TCP_FASTOPEN_CONNECT)
+};
+
 /// @brief Low-level OS socket handle.
 /// It also allow querying inheritability and changing it (and blocking mode)
 /// @n
@@ -208,11 +228,99 @@ struct SC_SOCKET_EXPORT SocketDescriptor : public UniqueHandle<detail::SocketDes
     /// @return Valid Result if the TCP_NODELAY option has been set successfully
     Result setTcpNoDelay(bool tcpNoDelay);
 
+    /// @brief Queries if Nagle's algorithm is disabled (TCP_NODELAY)
+    Result getTcpNoDelay(bool& tcpNoDelay) const;
+
+    /// @brief Applies all non-default fields of the given SocketOptions, stopping at the first failure
+    /// @param options The options to apply
+    /// @return Valid Result if all requested options have been set successfully
+    Result setOptions(const SocketOptions& options);
+
+    /// @brief Sets the kernel receive buffer size (SO_RCVBUF)
+    /// @param numBytes Requested size in bytes
+    /// @note Linux doubles the requested value (for bookkeeping overhead) and caps it to `net.core.rmem_max`
+    Result setReceiveBufferSize(int numBytes);
+
+    /// @brief Queries the kernel receive buffer size (SO_RCVBUF), as adjusted by the OS
+    Result getReceiveBufferSize(int& numBytes) const;
+
+    /// @brief Sets the kernel send buffer size (SO_SNDBUF)
+    /// @param numBytes Requested size in bytes
+    /// @note Linux doubles the requested value (for bookkeeping overhead) and caps it to `net.core.wmem_max`
+    Result setSendBufferSize(int numBytes);
+
+    /// @brief Queries the kernel send buffer size (SO_SNDBUF), as adjusted by the OS
+    Result getSendBufferSize(int& numBytes) const;
+
+    /// @brief Sets for how long blocking receives busy poll the device queue before sleeping (SO_BUSY_POLL)
+    /// @param microseconds Busy poll duration (`0` to disable)
+    /// @note Only supported on Linux. Raising the value above `net.core.busy_poll` requires `CAP_NET_ADMIN`.
+    Result setBusyPoll(int microseconds);
+
+    /// @brief Queries the busy poll duration in microseconds (SO_BUSY_POLL, Linux only)
+    Result getBusyPoll(int& microseconds) const;
+
+    /// @brief Lets multiple sockets bind the same address and port (SO_REUSEPORT), to be set before binding.
+    /// On Linux incoming connections (or datagrams) are load balanced among all listening sockets.
+    /// @note Not supported on Windows
+    Result setReusePort(bool reusePort);
+
+    /// @brief Queries if SO_REUSEPORT is set
+    Result getReusePort(bool& reusePort) const;
+
+    /// @brief Enables TCP Fast Open on a server socket, to be set before SocketServer::listen (TCP_FASTOPEN)
+    /// @param queueLength Maximum number of pending Fast Open requests (`0` to disable).
+    /// macOS and Windows only care about it being non-zero.
+    /// @note Linux also requires bit `2` of `net.ipv4.tcp_fastopen` sysctl (and bit `1` for clients)
+    Result setTcpFastOpen(int queueLength);
+
+    /// @brief Queries the TCP Fast Open queue length of a server socket (TCP_FASTOPEN)
+    Result getTcpFastOpen(int& queueLength) const;
+
+    /// @brief Defers the SYN of a blocking SocketClient::connect until the first write, sending its data in the SYN
+    /// when a Fast Open cookie is available (TCP_FASTOPEN_CONNECT). AsyncSocketConnect doesn't need this option.
+    /// @note Only supported on Linux 4.11+
+    Result setTcpFastOpenConnect(bool fastOpenConnect);
+
+    /// @brief Queries if TCP_FASTOPEN_CONNECT is set (Linux only)
+    Result getTcpFastOpenConnect(bool& fastOpenConnect) const;
+
+    /// @brief Holds partial segments until uncorked, to coalesce multiple small writes (TCP_CORK / TCP_NOPUSH)
+    /// @param cork `true` to cork the socket, `false` to uncork it, flushing pending data
+    /// @note Not supported on Windows
+    Result setTcpCork(bool cork);
+
+    /// @brief Queries if the socket is corked (TCP_CORK / TCP_NOPUSH)
+    Result getTcpCork(bool& cork) const;
+
+    /// @brief Limits unsent data in the kernel send buffer, as the socket is reported writable only when unsent bytes
+    /// are below the threshold (TCP_NOTSENT_LOWAT). Reduces latency of prioritized data written late.
+    /// @param numBytes Threshold in bytes
+    /// @note Only supported on Linux and macOS
+    Result setTcpNotSentLowWatermark(int numBytes);
+
+    /// @brief Queries the unsent bytes threshold (TCP_NOTSENT_LOWAT)
+    Result getTcpNotSentLowWatermark(int& numBytes) const;
+
+    /// @brief Makes a listening socket accept connections only once they have sent some data (TCP_DEFER_ACCEPT)
+    /// @param seconds Maximum time waiting for data before accepting anyway (`0` to disable)
+    /// @note Only supported on Linux. The queried value is rounded to the retransmission timeouts.
+    Result setTcpDeferAccept(int seconds);
+
+    /// @brief Queries the defer accept timeout (TCP_DEFER_ACCEPT, Linux only)
+    Result getTcpDeferAccept(int& seconds) const;
+
     /// @brief Enables or disables broadcast on this socket (for UDP)
     /// @param enableBroadcast `true` to enable broadcast (set SO_BROADCAST), `false` to disable
     /// @return Valid Result if the SO_BROADCAST option has been set successfully
     Result setBroadcast(bool enableBroadcast);
 
+    /// @brief Lets the kernel coalesce consecutive datagrams from the same source in a single one (for UDP)
+    /// @param enableOffload `true` to enable Generic Receive Offload (set UDP_GRO), `false` to disable
+    /// @return Valid Result if the UDP_GRO option has been set successfully
+    /// @note Only supported on Linux 5.0+. Received datagrams can then hold multiple equally sized segments.
+    Result setUdpReceiveOffload(bool enableOffload);
+
     /// @brief Joins an IPv4 or IPv6 multicast group on a specific interface
     /// @param multicastAddress The multicast group address to join
     /// @param interfaceAddress The local interface address to join on
@@ -339,6 +447,12 @@ struct SC_SOCKET_EXPORT SocketClient
     /// @return Valid Result if bytes have been read successfully and timeout didn't occur
     Result readWithTimeout(Span<char> data, Span<char>& readData, int64_t timeout);
 
+    /// @brief Checks, without blocking and without consuming any byte, the state of an idle connected socket
+    /// @param[out] peerClosed `true` if the peer has closed the connection (or the connection is in error state)
+    /// @param[out] hasPendingData `true` if some data has been received and it's waiting to be read
+    /// @return Valid Result if the socket state has been queried successfully
+    Result probeConnection(bool& peerClosed, bool& hasPendingData);
+
   private:
     const SocketDescriptor& socket;
 };
@@ -44,6 +44,24 @@ struct SC_STRINGS_EXPORT Console
         return printInternal(false, fmt, forward<Types>(args)...);
     }
 
+    /// @brief Prints a SC_FORMAT_STRING, checked at compile time against args, to stdout
+    /// @return `true` if message has been printed successfully to Console
+    template <typename Literal, typename... Types>
+    bool print(StringFormatString<Literal> fmt, Types&&... args)
+    {
+        StringFormatOutput output(StringEncoding::Utf8, *this, true);
+        return StringFormat<StringIteratorASCII>::format(output, fmt, forward<Types>(args)...);
+    }
+
+    /// @brief Prints a SC_FORMAT_STRING, checked at compile time against args, to stderr
+    /// @return `true` if message has been printed successfully to Console
+    template <typename Literal, typename... Types>
+    bool printError(StringFormatString<Literal> fmt, Types&&... args)
+    {
+        StringFormatOutput output(StringEncoding::Utf8, *this, false);
+        return StringFormat<StringIteratorASCII>::format(output, fmt, forward<Types>(args)...);
+    }
+
     /// @brief Prints a string to console
     void print(const StringSpan str);
 
@@ -36,6 +36,93 @@ static bool formatSprintf(StringFormatOutput& data, const char (&formatSpecifier
     return validResult && data.append(StringView({buffer, static_cast<size_t>(numCharsExcludingTerminator)}, true,
                                                  StringEncoding::Ascii));
 }
+
+// Parses printf-like [flags][width][.precision] specifiers that can be written without snprintf
+static bool parseNumberSpecifier(StringSpan specifier, StringFormatSpecifier& parsed)
+{
+    return parsed.parse(specifier.bytesWithoutTerminator(), specifier.sizeInBytes());
+}
+
+// Writes sign, digits and padding of a number with the same rules of printf
+static bool appendNumber(StringFormatOutput& data, const StringFormatSpecifier& parsed, char sign, StringSpan digits,
+                         size_t minDigits, bool zeroPad)
+{
+    const size_t numDigits = digits.sizeInBytes();
+    if (sign == 0 and parsed.width == 0 and minDigits <= numDigits)
+        return data.append(digits);
+
+    size_t       zeroes  = minDigits > numDigits ? minDigits - numDigits : 0;
+    const size_t length  = (sign != 0 ? 1 : 0) + zeroes + numDigits;
+    size_t       spaces  = static_cast<size_t>(parsed.width) > length ? static_cast<size_t>(parsed.width) - length : 0;
+    char         buffer[256]; // width and precision have at most two digits each, fixed notation at most 23 + 99
+    char*        it = buffer;
+    if (zeroPad and not parsed.leftAlign)
+    {
+        zeroes += spaces;
+        spaces = 0;
+    }
+    for (; not parsed.leftAlign and spaces > 0; --spaces)
+        *it++ = ' ';
+    if (sign != 0)
+        *it++ = sign;
+    for (; zeroes > 0; --zeroes)
+        *it++ = '0';
+    memcpy(it, digits.bytesWithoutTerminator(), numDigits);
+    it += numDigits;
+    for (; spaces > 0; --spaces)
+        *it++ = ' ';
+    return data.append(StringView({buffer, static_cast<size_t>(it - buffer)}, false, StringEncoding::Ascii));
+}
+
+static char signOf(const StringFormatSpecifier& parsed, bool negative)
+{
+    return negative ? '-' : (parsed.plusSign ? '+' : (parsed.spaceSign ? ' ' : 0));
+}
+
+// Integers are written with NumberConversion, precision being the minimum number of digits like for printf("%.*d")
+static bool formatInteger(StringFormatOutput& data, const StringFormatSpecifier& parsed, uint64_t magnitude,
+                          bool negative, bool isSigned)
+{
+    char       buffer[StringsDetail::NumberConversion::MaxChars];
+    StringSpan digits;
+    if (parsed.precision == 0 and magnitude == 0)
+        digits = StringSpan({"", 0}, false, StringEncoding::Ascii); // like printf("%.0d", 0)
+    else
+        SC_TRY(StringsDetail::NumberConversion::formatUInt64(magnitude, buffer, digits));
+    const char   sign      = isSigned ? signOf(parsed, negative) : 0;
+    const size_t minDigits = parsed.precision < 0 ? 0 : static_cast<size_t>(parsed.precision);
+    return appendNumber(data, parsed, sign, digits, minDigits, parsed.zeroPad and parsed.precision < 0);
+}
+
+static bool formatSigned(StringFormatOutput& data, const StringFormatSpecifier& parsed, int64_t value)
+{
+    const uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    return formatInteger(data, parsed, magnitude, value < 0, true);
+}
+
+// Fixed notation floating points are written with NumberConversion::formatFixed like printf("%.*f").
+// Returns false without writing anything when value is outside of the range handled by formatFixed.
+static bool tryFormatFixed(StringFormatOutput& data, const StringFormatSpecifier& parsed, double value, bool& written)
+{
+    char       buffer[128];
+    StringSpan text;
+    const auto precision = static_cast<uint32_t>(parsed.precision < 0 ? 6 : parsed.precision);
+    written              = StringsDetail::NumberConversion::formatFixed(value, precision, buffer, text);
+    if (not written)
+        return false;
+    const bool       negative = text.bytesWithoutTerminator()[0] == '-';
+    const size_t     skipped  = negative ? 1 : 0;
+    const StringSpan digits({text.bytesWithoutTerminator() + skipped, text.sizeInBytes() - skipped}, false,
+                            StringEncoding::Ascii);
+    return appendNumber(data, parsed, signOf(parsed, negative), digits, 0, parsed.zeroPad);
+}
+
+// The 'r' specifier formats the shortest text that parses back to the same exact floating point value
+static bool isRoundTripSpecifier(StringSpan specifier)
+{
+    return specifier.sizeInBytes() == 1 and specifier.bytesWithoutTerminator()[0] == 'r';
+}
+
 #if SC_COMPILER_MSVC || SC_COMPILER_CLANG_CL
 #if SC_PLATFORM_64_BIT == 0
 bool StringFormatterFor<ssize_t>::format(StringFormatOutput& data, const StringSpan specifier, const long value)
@@ -65,6 +152,9 @@ bool StringFormatterFor<SC::ssize_t>::format(StringFormatOutput& data, const Str
 bool StringFormatterFor<SC::int64_t>::format(StringFormatOutput& data, const StringSpan specifier,
                                              const SC::int64_t value)
 {
+    StringFormatSpecifier parsed;
+    if (parseNumberSpecifier(specifier, parsed))
+        return formatSigned(data, parsed, value);
     constexpr char formatSpecifier[] = PRIi64;
     return formatSprintf(data, formatSpecifier, specifier, value);
 }
@@ -72,6 +162,9 @@ bool StringFormatterFor<SC::int64_t>::format(StringFormatOutput& data, const Str
 bool StringFormatterFor<SC::uint64_t>::format(StringFormatOutput& data, const StringSpan specifier,
                                               const SC::uint64_t value)
 {
+    StringFormatSpecifier parsed;
+    if (parseNumberSpecifier(specifier, parsed))
+        return formatInteger(data, parsed, value, false, false);
     constexpr char formatSpecifier[] = PRIu64;
     return formatSprintf(data, formatSpecifier, specifier, value);
 }
@@ -79,6 +172,9 @@ bool StringFormatterFor<SC::uint64_t>::format(StringFormatOutput& data, const St
 bool StringFormatterFor<SC::int32_t>::format(StringFormatOutput& data, const StringSpan specifier,
                                              const SC::int32_t value)
 {
+    StringFormatSpecifier parsed;
+    if (parseNumberSpecifier(specifier, parsed))
+        return formatSigned(data, parsed, value);
     constexpr char formatSpecifier[] = "d";
     return formatSprintf(data, formatSpecifier, specifier, value);
 }
@@ -86,7 +182,10 @@ bool StringFormatterFor<SC::int32_t>::format(StringFormatOutput& data, const Str
 bool StringFormatterFor<SC::uint32_t>::format(StringFormatOutput& data, const StringSpan specifier,
                                               const SC::uint32_t value)
 {
-    constexpr char formatSpecifier[] = "d";
+    StringFormatSpecifier parsed;
+    if (parseNumberSpecifier(specifier, parsed))
+        return formatInteger(data, parsed, value, false, false);
+    constexpr char formatSpecifier[] = "u";
     return formatSprintf(data, formatSpecifier, specifier, value);
 }
 
@@ -121,12 +220,40 @@ bool StringFormatterFor<bool>::format(StringFormatOutput& data, const StringSpan
 
 bool StringFormatterFor<float>::format(StringFormatOutput& data, const StringSpan specifier, const float value)
 {
+    if (isRoundTripSpecifier(specifier))
+    {
+        char       buffer[StringsDetail::NumberConversion::MaxChars];
+        StringSpan text;
+        return StringsDetail::NumberConversion::formatFloat(value, buffer, text) and data.append(text);
+    }
+    StringFormatSpecifier parsed;
+    bool                  written = false;
+    if (parseNumberSpecifier(specifier, parsed))
+    {
+        const bool succeeded = tryFormatFixed(data, parsed, value, written);
+        if (written)
+            return succeeded;
+    }
     constexpr char formatSpecifier[] = "f";
     return formatSprintf(data, formatSpecifier, specifier, value);
 }
 
 bool StringFormatterFor<double>::format(StringFormatOutput& data, const StringSpan specifier, const double value)
 {
+    if (isRoundTripSpecifier(specifier))
+    {
+        char       buffer[StringsDetail::NumberConversion::MaxChars];
+        StringSpan text;
+        return StringsDetail::NumberConversion::formatDouble(value, buffer, text) and data.append(text);
+    }
+    StringFormatSpecifier parsed;
+    bool                  written = false;
+    if (parseNumberSpecifier(specifier, parsed))
+    {
+        const bool succeeded = tryFormatFixed(data, parsed, value, written);
+        if (written)
+            return succeeded;
+    }
     constexpr char formatSpecifier[] = "f";
     return formatSprintf(data, formatSpecifier, specifier, value);
 }
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "../../Strings/StringIterator.h"
+#include "StringSearch.h"
 
 namespace SC
 {
@@ -32,32 +33,23 @@ bool StringIterator<CharIterator>::advanceAfterFindingSameIterator(StringIterato
         return false;
     }
 
-    if (otherLength == thisLength)
+    const ssize_t codeUnitSize = static_cast<ssize_t>(StringEncodingGetSize(getEncoding()));
+    const char*   haystack     = it;
+    while (true)
     {
-        if (memcmp(it, other.it, otherLength * sizeof(CodeUnit)) == 0)
+        const char* found = StringSearch::find(haystack, static_cast<size_t>(end - haystack), other.it, otherLength);
+        if (found == nullptr)
         {
-            setToEnd();
-            return true;
-        }
-        return false;
-    }
-
-    const size_t difference = thisLength - otherLength;
-    for (size_t index = 0; index <= difference; index++)
-    {
-        size_t subIndex = 0;
-        for (subIndex = 0; subIndex < otherLength; subIndex++)
-        {
-            if (it[index + subIndex] != other.it[subIndex])
-                break;
+            return false;
         }
-        if (subIndex == otherLength)
+        // Byte search must be resumed when matching at a position not aligned to a code unit (UTF16)
+        if ((found - it) % codeUnitSize == 0)
         {
-            it += index + subIndex;
+            it = found + otherLength;
             return true;
         }
+        haystack = found + 1;
     }
-    return false;
 }
 
 template <typename CharIterator>
@@ -166,6 +158,20 @@ template bool StringIterator<StringIteratorUTF16>::advanceOfBytes(ssize_t bytesL
 template <typename CharIterator>
 bool StringIterator<CharIterator>::advanceUntilMatchesAny(Span<const CodePoint> items, CodePoint& matched)
 {
+    StringSearchByteSet byteSet;
+    if (CharIterator::getEncoding() != StringEncoding::Utf16 and byteSet.build(items))
+    {
+        // ASCII bytes are never part of multi-byte UTF8 sequences, so they can be searched as bytes
+        const char* found = StringSearch::findFirstOf(it, static_cast<size_t>(end - it), byteSet);
+        if (found == nullptr)
+        {
+            it = end;
+            return false;
+        }
+        it      = found;
+        matched = static_cast<uint8_t>(*found);
+        return true;
+    }
     while (it < end)
     {
         const auto decoded = CharIterator::decode(it, end);
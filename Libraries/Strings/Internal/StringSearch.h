@@ -0,0 +1,255 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../../Common/Span.h"
+
+#include <string.h> // memchr, memcmp
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define SC_STRING_SEARCH_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SC_STRING_SEARCH_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace SC
+{
+/// @brief Set of ASCII bytes searched by StringSearch::findFirstOf, with a bitmap lookup table for the scalar path
+struct StringSearchByteSet
+{
+    static constexpr size_t MaxVectorBytes = 8; ///< Sets up to this size are matched with SIMD compares
+
+    uint32_t classes[8] = {0}; ///< Byte class lookup table (one bit for each of the 256 byte values)
+    uint8_t  bytes[MaxVectorBytes];
+    size_t   numBytes = 0;
+
+    [[nodiscard]] bool contains(uint8_t byte) const { return ((classes[byte >> 5] >> (byte & 31)) & 1) != 0; }
+
+    /// @brief Builds the set from code points, failing if any of them is not ASCII
+    [[nodiscard]] bool build(Span<const uint32_t> codePoints)
+    {
+        for (const uint32_t codePoint : codePoints)
+        {
+            if (codePoint >= 0x80)
+                return false;
+            if (contains(static_cast<uint8_t>(codePoint)))
+                continue;
+            if (numBytes < MaxVectorBytes)
+                bytes[numBytes] = static_cast<uint8_t>(codePoint);
+            classes[codePoint >> 5] |= 1u << (codePoint & 31);
+            numBytes++;
+        }
+        return true;
+    }
+};
+
+/// @brief Byte oriented substring and byte set search, filtering candidates with SIMD (SSE2 / NEON, selected at
+/// compile time) on first and last needle byte before verifying them with `memcmp`
+struct StringSearch
+{
+    /// @brief Finds first occurrence of needle inside haystack
+    /// @return Pointer to the match inside haystack or `nullptr` if not found (haystack when needle is empty)
+    static const char* find(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+    {
+        if (needleLength == 0)
+            return haystack;
+        if (needleLength > haystackLength)
+            return nullptr;
+        if (needleLength == 1)
+            return static_cast<const char*>(::memchr(haystack, needle[0], haystackLength));
+
+        const size_t      last      = needleLength - 1;
+        const char* const lastStart = haystack + haystackLength - needleLength; // Last valid match start (inclusive)
+        const char*       it        = haystack;
+#if SC_STRING_SEARCH_SSE2 || SC_STRING_SEARCH_NEON
+        const Vector firstByte = splat(needle[0]);
+        const Vector lastByte  = splat(needle[last]);
+        while (lastStart - it >= static_cast<ssize_t>(VectorSize - 1))
+        {
+            uint64_t mask = toMask(both(equal(load(it), firstByte), equal(load(it + last), lastByte)));
+            while (mask != 0)
+            {
+                const size_t offset = countTrailingZeros(mask) / MaskBitsPerByte;
+                if (::memcmp(it + offset + 1, needle + 1, last - 1) == 0)
+                    return it + offset;
+                mask &= ~(((uint64_t(1) << MaskBitsPerByte) - 1) << (offset * MaskBitsPerByte));
+            }
+            it += VectorSize;
+        }
+#endif
+        while (it <= lastStart)
+        {
+            it = static_cast<const char*>(::memchr(it, needle[0], static_cast<size_t>(lastStart - it) + 1));
+            if (it == nullptr)
+                return nullptr;
+            if (it[last] == needle[last] and ::memcmp(it + 1, needle + 1, last - 1) == 0)
+                return it;
+            it++;
+        }
+        return nullptr;
+    }
+
+    /// @brief Finds first occurrence of needle inside haystack ignoring case of ASCII letters
+    /// @return Pointer to the match inside haystack or `nullptr` if not found (haystack when needle is empty)
+    static const char* findIgnoreCaseASCII(const char* haystack, size_t haystackLength, const char* needle,
+                                           size_t needleLength)
+    {
+        if (needleLength == 0)
+            return haystack;
+        if (needleLength > haystackLength)
+            return nullptr;
+
+        const size_t      last      = needleLength - 1;
+        const char* const lastStart = haystack + haystackLength - needleLength;
+        const char*       it        = haystack;
+        const char        first     = lowercase(needle[0]);
+        const char        lastChar  = lowercase(needle[last]);
+#if SC_STRING_SEARCH_SSE2 || SC_STRING_SEARCH_NEON
+        const Vector firstByte = splat(first);
+        const Vector lastByte  = splat(lastChar);
+        while (lastStart - it >= static_cast<ssize_t>(VectorSize - 1))
+        {
+            const Vector firstMatch = equal(lowercase(load(it)), firstByte);
+            uint64_t     mask       = toMask(both(firstMatch, equal(lowercase(load(it + last)), lastByte)));
+            while (mask != 0)
+            {
+                const size_t offset = countTrailingZeros(mask) / MaskBitsPerByte;
+                if (equalsIgnoreCaseASCII(it + offset + 1, needle + 1, last))
+                    return it + offset;
+                mask &= ~(((uint64_t(1) << MaskBitsPerByte) - 1) << (offset * MaskBitsPerByte));
+            }
+            it += VectorSize;
+        }
+#endif
+        for (; it <= lastStart; ++it)
+        {
+            if (lowercase(it[0]) == first and lowercase(it[last]) == lastChar and
+                equalsIgnoreCaseASCII(it + 1, needle + 1, last))
+                return it;
+        }
+        return nullptr;
+    }
+
+    /// @brief Finds first byte of text that belongs to given set
+    /// @return Pointer to the matching byte or `nullptr` if not found
+    static const char* findFirstOf(const char* text, size_t length, const StringSearchByteSet& set)
+    {
+        if (set.numBytes == 0)
+            return nullptr;
+        if (set.numBytes == 1)
+            return static_cast<const char*>(::memchr(text, set.bytes[0], length));
+        const char*       it  = text;
+        const char* const end = text + length;
+#if SC_STRING_SEARCH_SSE2 || SC_STRING_SEARCH_NEON
+        if (set.numBytes <= StringSearchByteSet::MaxVectorBytes)
+        {
+            Vector needles[StringSearchByteSet::MaxVectorBytes];
+            for (size_t idx = 0; idx < set.numBytes; ++idx)
+            {
+                needles[idx] = splat(static_cast<char>(set.bytes[idx]));
+            }
+            while (static_cast<size_t>(end - it) >= VectorSize)
+            {
+                const Vector chars   = load(it);
+                Vector       matches = equal(chars, needles[0]);
+                for (size_t idx = 1; idx < set.numBytes; ++idx)
+                {
+                    matches = either(matches, equal(chars, needles[idx]));
+                }
+                const uint64_t mask = toMask(matches);
+                if (mask != 0)
+                    return it + countTrailingZeros(mask) / MaskBitsPerByte;
+                it += VectorSize;
+            }
+        }
+#endif
+        for (; it < end; ++it)
+        {
+            if (set.contains(static_cast<uint8_t>(*it)))
+                return it;
+        }
+        return nullptr;
+    }
+
+  private:
+    static char lowercase(char c) { return (c >= 'A' and c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c; }
+
+    static bool equalsIgnoreCaseASCII(const char* first, const char* second, size_t length)
+    {
+        for (size_t idx = 0; idx < length; ++idx)
+        {
+            if (lowercase(first[idx]) != lowercase(second[idx]))
+                return false;
+        }
+        return true;
+    }
+
+    static uint32_t countTrailingZeros(uint64_t value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index = 0;
+#if defined(_WIN64)
+        _BitScanForward64(&index, value);
+#else
+        if (not _BitScanForward(&index, static_cast<uint32_t>(value)))
+        {
+            _BitScanForward(&index, static_cast<uint32_t>(value >> 32));
+            index += 32;
+        }
+#endif
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+    }
+
+#if SC_STRING_SEARCH_SSE2
+    using Vector = __m128i;
+
+    static constexpr size_t VectorSize      = 16;
+    static constexpr size_t MaskBitsPerByte = 1; // One bit per byte from _mm_movemask_epi8
+
+    static Vector   load(const char* bytes) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)); }
+    static Vector   splat(char c) { return _mm_set1_epi8(c); }
+    static Vector   equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+    static Vector   both(Vector a, Vector b) { return _mm_and_si128(a, b); }
+    static Vector   either(Vector a, Vector b) { return _mm_or_si128(a, b); }
+    static uint64_t toMask(Vector v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+
+    static Vector lowercase(Vector chars)
+    {
+        // Shifts 'A'...'Z' to the lowest 26 signed values, as SSE2 has only signed byte comparisons
+        const Vector shifted = _mm_add_epi8(chars, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+        const Vector isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+        return _mm_or_si128(chars, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+    }
+#elif SC_STRING_SEARCH_NEON
+    using Vector = uint8x16_t;
+
+    static constexpr size_t VectorSize      = 16;
+    static constexpr size_t MaskBitsPerByte = 4; // Four bits per byte from narrowing shift of 16 bit lanes
+
+    static Vector load(const char* bytes) { return vld1q_u8(reinterpret_cast<const uint8_t*>(bytes)); }
+    static Vector splat(char c) { return vdupq_n_u8(static_cast<uint8_t>(c)); }
+    static Vector equal(Vector a, Vector b) { return vceqq_u8(a, b); }
+    static Vector both(Vector a, Vector b) { return vandq_u8(a, b); }
+    static Vector either(Vector a, Vector b) { return vorrq_u8(a, b); }
+
+    static uint64_t toMask(Vector v)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+    }
+
+    static Vector lowercase(Vector chars)
+    {
+        const Vector isUpper = vcltq_u8(vsubq_u8(chars, vdupq_n_u8('A')), vdupq_n_u8(26));
+        return vorrq_u8(chars, vandq_u8(isUpper, vdupq_n_u8(0x20)));
+    }
+#endif
+};
+} // namespace SC
@@ -2,10 +2,11 @@
 // SPDX-License-Identifier: MIT
 
 #include "../../Strings/StringView.h"
+#include "StringSearch.h"
 
 #include <errno.h>  // errno
 #include <stdint.h> // INT32_MIN/MAX
-#include <stdlib.h> // atoi
+#include <stdlib.h> // strtol
 #include <string.h> // strlen
 
 bool SC::StringView::parseInt32(int32_t& value) const
@@ -66,57 +67,44 @@ bool SC::StringView::parseInt32(int32_t& value) const
     return false;
 }
 
-bool SC::StringView::parseFloat(float& value) const
+namespace
 {
-    double dValue;
-    if (parseDouble(dValue))
-    {
-        value = static_cast<float>(dValue);
-        return true;
-    }
-    return false;
-}
-
-bool SC::StringView::parseDouble(double& value) const
+// Narrows UTF-16 text made only of ASCII characters to a buffer, as numbers are made only of ASCII characters
+template <size_t N>
+bool narrowNumberToASCII(SC::StringView view, char (&buffer)[N], SC::StringSpan& number)
 {
-    if (text == nullptr)
-        return false;
-    if (hasNullTerm)
-    {
-        value = atof(text);
-    }
-    else
+    if (view.getEncoding() != SC::StringEncoding::Utf16)
     {
-        char         buffer[255];
-        const size_t bufferSize = min(textSizeInBytes, static_cast<decltype(textSizeInBytes)>(sizeof(buffer) - 1));
-        if (text != nullptr)
-            memcpy(buffer, text, bufferSize);
-        buffer[bufferSize] = 0;
-        value              = atof(buffer);
+        number = view;
+        return true;
     }
-    if (value == 0.0f)
+    SC::StringIteratorUTF16 it(view.getIterator<SC::StringIteratorUTF16>());
+    SC::StringCodePoint     codePoint;
+    size_t                  index = 0;
+    while (it.advanceRead(codePoint))
     {
-        // atof returns 0 on failed parsing...
-        // TODO: Handle float scientific notation
-        StringIteratorASCII it = getIterator<StringIteratorASCII>();
-        (void)it.advanceIfMatchesAny({'-', '+'}); // optional
-        if (it.isAtEnd())                         // we now require something
-        {
+        if (codePoint > 127 or index == N)
             return false;
-        }
-        (void)it.advanceUntilDifferentFrom('0'); // any number of 0s
-        if (it.advanceIfMatches('.'))            // optional
-        {
-            if (it.isAtEnd()) // but if it exists now we need at least a number
-            {
-                return false;
-            }
-        }
-        (void)it.advanceUntilDifferentFrom('0'); // any number of 0s
-        return it.isAtEnd();                     // if they where all zeroes
+        buffer[index++] = static_cast<char>(codePoint);
     }
+    number = SC::StringSpan({buffer, index}, false, SC::StringEncoding::Ascii);
     return true;
 }
+} // namespace
+
+bool SC::StringView::parseFloat(float& value) const
+{
+    char       buffer[255]; // Only used to narrow UTF-16, as UTF-8 and ASCII are parsed in place
+    StringSpan number;
+    return narrowNumberToASCII(*this, buffer, number) and StringsDetail::NumberConversion::parseFloat(number, value);
+}
+
+bool SC::StringView::parseDouble(double& value) const
+{
+    char       buffer[255]; // Only used to narrow UTF-16, as UTF-8 and ASCII are parsed in place
+    StringSpan number;
+    return narrowNumberToASCII(*this, buffer, number) and StringsDetail::NumberConversion::parseDouble(number, value);
+}
 
 static constexpr uint32_t stringViewLowercaseASCII(uint32_t codePoint)
 {
@@ -212,6 +200,10 @@ bool SC::StringView::containsStringIgnoreCaseASCII(const StringView str) const
     {
         return true;
     }
+    if (hasCompatibleEncoding(str) and getEncoding() != StringEncoding::Utf16)
+    {
+        return StringSearch::findIgnoreCaseASCII(text, textSizeInBytes, str.text, str.textSizeInBytes) != nullptr;
+    }
     return withIterators(*this, str,
                          [](auto haystackStart, auto needleStart)
                          {
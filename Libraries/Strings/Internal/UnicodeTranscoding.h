@@ -0,0 +1,458 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "../../Common/Span.h"
+
+#include <string.h> // memcpy
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define SC_UNICODE_TRANSCODING_NEON 1
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define SC_UNICODE_TRANSCODING_AVX2 1
+#define SC_UNICODE_TRANSCODING_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SC_UNICODE_TRANSCODING_SSE2 1
+#endif
+
+namespace SC
+{
+struct UnicodeTranscoding;
+} // namespace SC
+
+/// @brief Strict validation and transcoding between UTF-8 and UTF-16 (little endian), without any OS API.
+/// Runs of ASCII text are detected, widened and narrowed 16 or 32 bytes at a time (SSE2 / AVX2 / NEON, selected at
+/// compile time), falling back to a scalar decoder only for blocks containing multi-byte sequences.
+/// Overlong UTF-8 sequences, surrogates encoded in UTF-8, code points above U+10FFFF, truncated sequences and
+/// unpaired UTF-16 surrogates are all rejected.
+/// UTF-16 text is passed as bytes, so that it doesn't need to be 2 bytes aligned.
+struct SC::UnicodeTranscoding
+{
+    /// @brief Counts number of leading bytes of text that are ASCII (`< 0x80`)
+    [[nodiscard]] static size_t countAscii(Span<const char> text);
+
+    /// @brief Checks if text is well-formed UTF-8
+    [[nodiscard]] static bool isValidUtf8(Span<const char> utf8);
+
+    /// @brief Checks if text is well-formed UTF-16 little endian (with an even number of bytes and paired surrogates)
+    [[nodiscard]] static bool isValidUtf16(Span<const char> utf16);
+
+    /// @brief Maximum number of UTF-16 bytes produced converting given number of UTF-8 bytes
+    [[nodiscard]] static constexpr size_t maxUtf16Bytes(size_t utf8Bytes) { return utf8Bytes * 2; }
+
+    /// @brief Maximum number of UTF-8 bytes produced converting given number of UTF-16 bytes
+    [[nodiscard]] static constexpr size_t maxUtf8Bytes(size_t utf16Bytes) { return (utf16Bytes / 2) * 3; }
+
+    /// @brief Converts UTF-8 text to UTF-16 little endian
+    /// @param utf8 Source text (not null-terminated)
+    /// @param utf16 Destination bytes, UnicodeTranscoding::maxUtf16Bytes are always sufficient
+    /// @param numBytesWritten Number of bytes written to utf16 (not null-terminated)
+    /// @return `false` if utf8 is not valid UTF-8 or if utf16 is too small
+    [[nodiscard]] static bool convertUtf8ToUtf16(Span<const char> utf8, Span<char> utf16, size_t& numBytesWritten);
+
+    /// @brief Converts UTF-16 little endian text to UTF-8
+    /// @param utf16 Source text (not null-terminated)
+    /// @param utf8 Destination bytes, UnicodeTranscoding::maxUtf8Bytes are always sufficient
+    /// @param numBytesWritten Number of bytes written to utf8 (not null-terminated)
+    /// @param replaceUnpairedSurrogates Writes U+FFFD for each unpaired surrogate instead of failing
+    /// @return `false` if utf16 is not valid UTF-16 or if utf8 is too small
+    [[nodiscard]] static bool convertUtf16ToUtf8(Span<const char> utf16, Span<char> utf8, size_t& numBytesWritten,
+                                                 bool replaceUnpairedSurrogates = false);
+
+  private:
+    struct Internal;
+};
+
+struct SC::UnicodeTranscoding::Internal
+{
+    static constexpr size_t BlockSize = 16; // Number of bytes of a UTF-8 block or UTF-16 code units of a UTF-16 block
+
+#if SC_UNICODE_TRANSCODING_SSE2
+    static bool isAsciiBlock(const char* utf8)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8));
+        return _mm_movemask_epi8(chars) == 0;
+    }
+
+    static void widenAsciiBlock(const char* utf8, char* utf16)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8));
+        const __m128i zero  = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(utf16), _mm_unpacklo_epi8(chars, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(utf16 + 16), _mm_unpackhi_epi8(chars, zero));
+    }
+
+    static bool narrowAsciiBlock(const char* utf16, char* utf8)
+    {
+        const __m128i units0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16));
+        const __m128i units1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16 + 16));
+        const __m128i high   = _mm_and_si128(_mm_or_si128(units0, units1), _mm_set1_epi16(-0x80)); // 0xFF80
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF)
+            return false;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(utf8), _mm_packus_epi16(units0, units1));
+        return true;
+    }
+
+    static bool hasNoSurrogatesBlock(const char* utf16)
+    {
+        const __m128i mask   = _mm_set1_epi16(static_cast<short>(0xF800));
+        const __m128i tag    = _mm_set1_epi16(static_cast<short>(0xD800));
+        const __m128i units0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16));
+        const __m128i units1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16 + 16));
+        const __m128i found  = _mm_or_si128(_mm_cmpeq_epi16(_mm_and_si128(units0, mask), tag),
+                                            _mm_cmpeq_epi16(_mm_and_si128(units1, mask), tag));
+        return _mm_movemask_epi8(found) == 0;
+    }
+#elif SC_UNICODE_TRANSCODING_NEON
+    static bool isAsciiBlock(const char* utf8)
+    {
+        return vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(utf8))) < 0x80;
+    }
+
+    static void widenAsciiBlock(const char* utf8, char* utf16)
+    {
+        const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(utf8));
+        vst1q_u8(reinterpret_cast<uint8_t*>(utf16), vreinterpretq_u8_u16(vmovl_u8(vget_low_u8(chars))));
+        vst1q_u8(reinterpret_cast<uint8_t*>(utf16 + 16), vreinterpretq_u8_u16(vmovl_high_u8(chars)));
+    }
+
+    static bool narrowAsciiBlock(const char* utf16, char* utf8)
+    {
+        const uint16x8_t units0 = vreinterpretq_u16_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(utf16)));
+        const uint16x8_t units1 = vreinterpretq_u16_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(utf16 + 16)));
+        if (vmaxvq_u16(vorrq_u16(units0, units1)) >= 0x80)
+            return false;
+        vst1q_u8(reinterpret_cast<uint8_t*>(utf8), vcombine_u8(vmovn_u16(units0), vmovn_u16(units1)));
+        return true;
+    }
+
+    static bool hasNoSurrogatesBlock(const char* utf16)
+    {
+        const uint16x8_t mask   = vdupq_n_u16(0xF800);
+        const uint16x8_t tag    = vdupq_n_u16(0xD800);
+        const uint16x8_t units0 = vreinterpretq_u16_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(utf16)));
+        const uint16x8_t units1 = vreinterpretq_u16_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(utf16 + 16)));
+        const uint16x8_t found  = vorrq_u16(vceqq_u16(vandq_u16(units0, mask), tag), //
+                                            vceqq_u16(vandq_u16(units1, mask), tag));
+        return vmaxvq_u16(found) == 0;
+    }
+#else
+    // Portable fallback processing 8 bytes at a time in a 64 bit register
+    static uint64_t load64(const char* bytes)
+    {
+        uint64_t value;
+        ::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    static bool isAsciiBlock(const char* utf8)
+    {
+        return ((load64(utf8) | load64(utf8 + 8)) & 0x8080808080808080ULL) == 0;
+    }
+
+    static void widenAsciiBlock(const char* utf8, char* utf16)
+    {
+        for (size_t idx = 0; idx < BlockSize; ++idx)
+        {
+            utf16[idx * 2]     = utf8[idx];
+            utf16[idx * 2 + 1] = 0;
+        }
+    }
+
+    static bool narrowAsciiBlock(const char* utf16, char* utf8)
+    {
+        uint64_t merged = 0;
+        for (size_t idx = 0; idx < BlockSize * 2; idx += 8)
+        {
+            merged |= load64(utf16 + idx);
+        }
+        // Checks byte pattern [<0x80, 0x00] of all units, independently from endianness of the 64 bit loads
+        const char* bytes = reinterpret_cast<const char*>(&merged);
+        for (size_t idx = 0; idx < sizeof(merged); idx += 2)
+        {
+            if ((static_cast<uint8_t>(bytes[idx]) & 0x80) != 0 or bytes[idx + 1] != 0)
+                return false;
+        }
+        for (size_t idx = 0; idx < BlockSize; ++idx)
+        {
+            utf8[idx] = utf16[idx * 2];
+        }
+        return true;
+    }
+
+    static bool hasNoSurrogatesBlock(const char* utf16)
+    {
+        for (size_t idx = 0; idx < BlockSize; ++idx)
+        {
+            if ((static_cast<uint8_t>(utf16[idx * 2 + 1]) & 0xF8) == 0xD8)
+                return false;
+        }
+        return true;
+    }
+#endif
+
+    static uint32_t loadUnit(const char* utf16)
+    {
+        return static_cast<uint32_t>(static_cast<uint8_t>(utf16[0])) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(utf16[1])) << 8);
+    }
+
+    static void storeUnit(char* utf16, uint32_t unit)
+    {
+        utf16[0] = static_cast<char>(unit & 0xFF);
+        utf16[1] = static_cast<char>(unit >> 8);
+    }
+
+    // Decodes one (possibly multi-byte) UTF-8 sequence rejecting overlong forms, surrogates and values > U+10FFFF
+    static bool decodeUtf8(const char*& it, const char* end, uint32_t& codePoint)
+    {
+        const uint32_t lead = static_cast<uint8_t>(*it);
+        if (lead < 0x80)
+        {
+            codePoint = lead;
+            it += 1;
+            return true;
+        }
+        size_t   numTrailing;
+        uint32_t minCodePoint;
+        if (lead >= 0xC2 and lead <= 0xDF)
+        {
+            numTrailing  = 1;
+            minCodePoint = 0x80;
+            codePoint    = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 and lead <= 0xEF)
+        {
+            numTrailing  = 2;
+            minCodePoint = 0x800;
+            codePoint    = lead & 0x0F;
+        }
+        else if (lead >= 0xF0 and lead <= 0xF4)
+        {
+            numTrailing  = 3;
+            minCodePoint = 0x10000;
+            codePoint    = lead & 0x07;
+        }
+        else
+        {
+            return false;
+        }
+        if (static_cast<size_t>(end - it) <= numTrailing)
+            return false;
+        for (size_t idx = 1; idx <= numTrailing; ++idx)
+        {
+            const uint32_t trail = static_cast<uint8_t>(it[idx]);
+            if ((trail & 0xC0) != 0x80)
+                return false;
+            codePoint = (codePoint << 6) | (trail & 0x3F);
+        }
+        if (codePoint < minCodePoint or codePoint > 0x10FFFF or (codePoint >= 0xD800 and codePoint <= 0xDFFF))
+            return false;
+        it += numTrailing + 1;
+        return true;
+    }
+
+    // Decodes one UTF-16 code unit or surrogate pair, rejecting unpaired surrogates
+    static bool decodeUtf16(const char*& it, const char* end, uint32_t& codePoint)
+    {
+        const uint32_t lead = loadUnit(it);
+        if (lead < 0xD800 or lead > 0xDFFF)
+        {
+            codePoint = lead;
+            it += 2;
+            return true;
+        }
+        if (lead >= 0xDC00 or end - it < 4)
+            return false;
+        const uint32_t trail = loadUnit(it + 2);
+        if (trail < 0xDC00 or trail > 0xDFFF)
+            return false;
+        codePoint = 0x10000 + ((lead - 0xD800) << 10) + (trail - 0xDC00);
+        it += 4;
+        return true;
+    }
+
+    static size_t encodeUtf8(uint32_t codePoint, char* utf8)
+    {
+        if (codePoint < 0x80)
+        {
+            utf8[0] = static_cast<char>(codePoint);
+            return 1;
+        }
+        if (codePoint < 0x800)
+        {
+            utf8[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+            utf8[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+            return 2;
+        }
+        if (codePoint < 0x10000)
+        {
+            utf8[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+            utf8[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            utf8[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+            return 3;
+        }
+        utf8[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+        utf8[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        utf8[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 4;
+    }
+};
+
+inline size_t SC::UnicodeTranscoding::countAscii(Span<const char> text)
+{
+    const char* it  = text.data();
+    const char* end = it + text.sizeInBytes();
+#if SC_UNICODE_TRANSCODING_AVX2
+    while (end - it >= 32)
+    {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+        if (_mm256_movemask_epi8(chars) != 0)
+            break;
+        it += 32;
+    }
+#endif
+    while (static_cast<size_t>(end - it) >= Internal::BlockSize and Internal::isAsciiBlock(it))
+    {
+        it += Internal::BlockSize;
+    }
+    while (it < end and static_cast<uint8_t>(*it) < 0x80)
+    {
+        it++;
+    }
+    return static_cast<size_t>(it - text.data());
+}
+
+inline bool SC::UnicodeTranscoding::isValidUtf8(Span<const char> utf8)
+{
+    const char* it  = utf8.data();
+    const char* end = it + utf8.sizeInBytes();
+    while (it < end)
+    {
+        it += countAscii({it, static_cast<size_t>(end - it)});
+        // Decode scalar until reaching next block boundary, where ASCII detection can kick in again
+        const char* blockEnd = static_cast<size_t>(end - it) > Internal::BlockSize ? it + Internal::BlockSize : end;
+        while (it < blockEnd)
+        {
+            uint32_t codePoint;
+            if (not Internal::decodeUtf8(it, end, codePoint))
+                return false;
+        }
+    }
+    return true;
+}
+
+inline bool SC::UnicodeTranscoding::isValidUtf16(Span<const char> utf16)
+{
+    if (utf16.sizeInBytes() % 2 != 0)
+        return false;
+    const char* it  = utf16.data();
+    const char* end = it + utf16.sizeInBytes();
+    while (it < end)
+    {
+        if (static_cast<size_t>(end - it) >= Internal::BlockSize * 2 and Internal::hasNoSurrogatesBlock(it))
+        {
+            it += Internal::BlockSize * 2;
+            continue;
+        }
+        const size_t blockBytes = Internal::BlockSize * 2;
+        const char*  blockEnd   = static_cast<size_t>(end - it) > blockBytes ? it + blockBytes : end;
+        while (it < blockEnd)
+        {
+            uint32_t codePoint;
+            if (not Internal::decodeUtf16(it, end, codePoint))
+                return false;
+        }
+    }
+    return true;
+}
+
+inline bool SC::UnicodeTranscoding::convertUtf8ToUtf16(Span<const char> utf8, Span<char> utf16,
+                                                       size_t& numBytesWritten)
+{
+    const char* it     = utf8.data();
+    const char* end    = it + utf8.sizeInBytes();
+    char*       out    = utf16.data();
+    char* const outEnd = out + utf16.sizeInBytes();
+    while (it < end)
+    {
+        if (static_cast<size_t>(end - it) >= Internal::BlockSize and
+            static_cast<size_t>(outEnd - out) >= Internal::BlockSize * 2 and Internal::isAsciiBlock(it))
+        {
+            Internal::widenAsciiBlock(it, out);
+            it += Internal::BlockSize;
+            out += Internal::BlockSize * 2;
+            continue;
+        }
+        const char* blockEnd = static_cast<size_t>(end - it) > Internal::BlockSize ? it + Internal::BlockSize : end;
+        while (it < blockEnd)
+        {
+            uint32_t codePoint;
+            if (not Internal::decodeUtf8(it, end, codePoint))
+                return false;
+            if (codePoint < 0x10000)
+            {
+                if (outEnd - out < 2)
+                    return false;
+                Internal::storeUnit(out, codePoint);
+                out += 2;
+            }
+            else
+            {
+                if (outEnd - out < 4)
+                    return false;
+                codePoint -= 0x10000;
+                Internal::storeUnit(out, 0xD800 + (codePoint >> 10));
+                Internal::storeUnit(out + 2, 0xDC00 + (codePoint & 0x3FF));
+                out += 4;
+            }
+        }
+    }
+    numBytesWritten = static_cast<size_t>(out - utf16.data());
+    return true;
+}
+
+inline bool SC::UnicodeTranscoding::convertUtf16ToUtf8(Span<const char> utf16, Span<char> utf8,
+                                                       size_t& numBytesWritten, bool replaceUnpairedSurrogates)
+{
+    if (utf16.sizeInBytes() % 2 != 0)
+        return false;
+    const char* it     = utf16.data();
+    const char* end    = it + utf16.sizeInBytes();
+    char*       out    = utf8.data();
+    char* const outEnd = out + utf8.sizeInBytes();
+    while (it < end)
+    {
+        if (static_cast<size_t>(end - it) >= Internal::BlockSize * 2 and
+            static_cast<size_t>(outEnd - out) >= Internal::BlockSize and Internal::narrowAsciiBlock(it, out))
+        {
+            it += Internal::BlockSize * 2;
+            out += Internal::BlockSize;
+            continue;
+        }
+        const size_t blockBytes = Internal::BlockSize * 2;
+        const char*  blockEnd   = static_cast<size_t>(end - it) > blockBytes ? it + blockBytes : end;
+        while (it < blockEnd)
+        {
+            uint32_t codePoint;
+            if (not Internal::decodeUtf16(it, end, codePoint))
+            {
+                if (not replaceUnpairedSurrogates)
+                    return false;
+                codePoint = 0xFFFD; // Replacement character, taking the place of the single unpaired surrogate
+                it += 2;
+            }
+            char         encoded[4];
+            const size_t numBytes = Internal::encodeUtf8(codePoint, encoded);
+            if (static_cast<size_t>(outEnd - out) < numBytes)
+                return false;
+            ::memcpy(out, encoded, numBytes);
+            out += numBytes;
+        }
+    }
+    numBytesWritten = static_cast<size_t>(out - utf8.data());
+    return true;
+}
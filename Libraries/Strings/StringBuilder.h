@@ -35,6 +35,10 @@ struct SC_STRINGS_EXPORT StringBuilder
     /// @brief Helper to format a StringView against args, replacing destination contents, in a single function call
     template <typename T, typename... Types>
     [[nodiscard]] static bool format(T& buffer, StringView fmt, Types&&... args) { return StringBuilder::create(buffer).append(fmt, forward<Types>(args)...); }
+
+    /// @brief Helper to format a SC_FORMAT_STRING checked at compile time, replacing destination contents
+    template <typename T, typename Literal, typename... Types>
+    [[nodiscard]] static bool format(T& buffer, StringFormatString<Literal> fmt, Types&&... args) { return StringBuilder::create(buffer).append(fmt, forward<Types>(args)...); }
     // clang-format on
 
     /// @brief Formats the given StringView against args, appending to destination contents
@@ -47,6 +51,14 @@ struct SC_STRINGS_EXPORT StringBuilder
         return StringFormat<StringIteratorASCII>::format(sfo, fmt, forward<Types>(args)...);
     }
 
+    /// @brief Formats a SC_FORMAT_STRING checked at compile time against args, appending to destination contents
+    template <typename Literal, typename... Types>
+    [[nodiscard]] bool append(StringFormatString<Literal> fmt, Types&&... args)
+    {
+        StringFormatOutput sfo(encoding, *buffer);
+        return StringFormat<StringIteratorASCII>::format(sfo, fmt, forward<Types>(args)...);
+    }
+
     /// @brief Appends StringView to destination buffer
     /// @param str StringView to append to destination buffer
     [[nodiscard]] bool append(StringView str);
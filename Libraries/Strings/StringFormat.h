@@ -59,6 +59,218 @@ struct SC_STRINGS_EXPORT StringFormatOutput
     size_t   backupSize = 0;
 };
 
+/// @brief Printf-like `[flags][width][.precision]` specification used inside `{:...}` for numbers.
+/// Supported flags are `-` (left align), `+` (always print sign), ` ` (space in place of plus sign) and `0` (pad with
+/// zeroes). Width and precision are limited to two digits.
+struct StringFormatSpecifier
+{
+    bool    leftAlign = false; ///< `-` flag
+    bool    plusSign  = false; ///< `+` flag
+    bool    spaceSign = false; ///< ` ` flag
+    bool    zeroPad   = false; ///< `0` flag
+    int32_t width     = 0;     ///< Minimum number of characters written (padding with spaces or zeroes)
+    int32_t precision = -1;    ///< Decimals for floating points or minimum digits for integers (`-1` if missing)
+
+    /// @brief Parses the specification, returning `false` if it uses unsupported syntax
+    [[nodiscard]] constexpr bool parse(const char* text, size_t length)
+    {
+        size_t idx = 0;
+        for (; idx < length; ++idx)
+        {
+            const char flag = text[idx];
+            if (flag == '-')
+                leftAlign = true;
+            else if (flag == '+')
+                plusSign = true;
+            else if (flag == ' ')
+                spaceSign = true;
+            else if (flag == '0')
+                zeroPad = true;
+            else
+                break;
+        }
+        if (not parseNumber(text, length, idx, width))
+            return false;
+        if (idx < length and text[idx] == '.')
+        {
+            idx++;
+            precision = 0;
+            if (not parseNumber(text, length, idx, precision))
+                return false;
+        }
+        return idx == length;
+    }
+
+  private:
+    [[nodiscard]] static constexpr bool parseNumber(const char* text, size_t length, size_t& idx, int32_t& number)
+    {
+        const size_t start = idx;
+        for (; idx < length and text[idx] >= '0' and text[idx] <= '9'; ++idx)
+        {
+            number = number * 10 + (text[idx] - '0');
+        }
+        return idx - start <= 2;
+    }
+};
+
+/// @brief Category of an argument used to validate its specifier in a format string parsed at compile time
+enum class StringFormatArgumentKind
+{
+    Integer,  ///< Integers accept a StringFormatSpecifier
+    Floating, ///< Floating points accept a StringFormatSpecifier or `r` (shortest round trip representation)
+    Other,    ///< Any other type (strings, bools, chars, custom StringFormatterFor) accepts any specifier
+};
+
+/// @brief Maps an argument type to its StringFormatArgumentKind
+template <typename T, StringFormatArgumentKind Kind = StringFormatArgumentKind::Other>
+struct StringFormatArgumentKindOf
+{
+    static constexpr StringFormatArgumentKind value = Kind;
+};
+
+// clang-format off
+template <> struct StringFormatArgumentKindOf<signed char>       : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<unsigned char>     : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<short>             : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<unsigned short>    : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<int>               : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<unsigned int>      : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<long>              : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<unsigned long>     : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<long long>         : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<unsigned long long>: StringFormatArgumentKindOf<void, StringFormatArgumentKind::Integer> {};
+template <> struct StringFormatArgumentKindOf<float>             : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Floating> {};
+template <> struct StringFormatArgumentKindOf<double>            : StringFormatArgumentKindOf<void, StringFormatArgumentKind::Floating> {};
+// clang-format on
+
+/// @brief A literal format string parsed at compile time, to be created with SC_FORMAT_STRING
+/// @tparam Literal A type holding the string literal (see SC_FORMAT_STRING)
+template <typename Literal>
+struct StringFormatString
+{
+    /// @brief Returns the format string text
+    static constexpr StringView text()
+    {
+        return StringView({Literal::get(), Literal::size()}, true, StringEncoding::Utf8);
+    }
+};
+
+/// @brief Parses format strings at compile time into a table of literal text and argument segments
+struct StringFormatCompiler
+{
+    /// @brief A run of literal text or an argument placeholder with its specifier
+    struct Segment
+    {
+        uint32_t start    = 0;  ///< Start of literal text or of the specifier, in bytes from format string start
+        uint32_t length   = 0;  ///< Length of literal text or of the specifier
+        int32_t  argument = -1; ///< Position of the argument or `-1` for literal text
+    };
+
+    /// @brief Segments of a format string, computed by StringFormatCompiler::compile
+    template <size_t MaxSegments>
+    struct Segments
+    {
+        Segment segments[MaxSegments];
+        size_t  numSegments  = 0;     ///< Number of segments (can exceed MaxSegments when just counting them)
+        size_t  numArguments = 0;     ///< Highest argument position referenced plus one
+        bool    isValid      = false; ///< `false` for unmatched braces or invalid argument positions
+
+        constexpr void push(uint32_t start, uint32_t length, int32_t argument)
+        {
+            if (numSegments < MaxSegments)
+            {
+                segments[numSegments].start    = start;
+                segments[numSegments].length   = length;
+                segments[numSegments].argument = argument;
+            }
+            numSegments++;
+        }
+    };
+
+    /// @brief Splits text in segments, with the same rules of StringFormat::format.
+    /// Compile once with a single segment to know the number of segments needed.
+    template <size_t MaxSegments>
+    static constexpr Segments<MaxSegments> compile(const char* text, size_t length)
+    {
+        Segments<MaxSegments> result;
+        size_t  start    = 0;
+        int32_t position = 0;
+        size_t  idx      = 0;
+        while (idx < length)
+        {
+            const char current = text[idx];
+            if (current != '{' and current != '}')
+            {
+                idx++;
+                continue;
+            }
+            if (idx + 1 < length and text[idx + 1] == current)
+            {
+                // Escaped brace, keeping only one of the two in the literal text
+                result.push(static_cast<uint32_t>(start), static_cast<uint32_t>(idx + 1 - start), -1);
+                idx += 2;
+                start = idx;
+                continue;
+            }
+            if (current == '}')
+                return result; // single unescaped '}'
+            if (idx > start)
+                result.push(static_cast<uint32_t>(start), static_cast<uint32_t>(idx - start), -1);
+            size_t close = idx + 1;
+            while (close < length and text[close] != '}')
+                close++;
+            if (close == length)
+                return result; // unmatched '{'
+            size_t  colon          = idx + 1;
+            int32_t parsedPosition = position;
+            if (colon < close and text[colon] != ':')
+                parsedPosition = 0;
+            for (; colon < close and text[colon] != ':'; ++colon)
+            {
+                if (text[colon] < '0' or text[colon] > '9' or parsedPosition > 1000)
+                    return result; // not a valid position
+                parsedPosition = parsedPosition * 10 + (text[colon] - '0');
+            }
+            const size_t specifierStart = colon < close ? colon + 1 : close;
+            result.push(static_cast<uint32_t>(specifierStart), static_cast<uint32_t>(close - specifierStart),
+                        parsedPosition);
+            position += 1;
+            if (static_cast<size_t>(parsedPosition) + 1 > result.numArguments)
+                result.numArguments = static_cast<size_t>(parsedPosition) + 1;
+            idx   = close + 1;
+            start = idx;
+        }
+        if (length > start)
+            result.push(static_cast<uint32_t>(start), static_cast<uint32_t>(length - start), -1);
+        result.isValid = true;
+        return result;
+    }
+
+    /// @brief Checks that specifiers of all placeholders are valid for the kind of the argument they refer to
+    template <size_t MaxSegments>
+    static constexpr bool validate(const Segments<MaxSegments>& result, const char* text,
+                                   const StringFormatArgumentKind* kinds)
+    {
+        for (size_t idx = 0; idx < result.numSegments; ++idx)
+        {
+            const Segment& segment = result.segments[idx];
+            if (segment.argument < 0 or kinds[segment.argument] == StringFormatArgumentKind::Other)
+                continue;
+            const char* specifier = text + segment.start;
+            if (segment.length == 1 and specifier[0] == 'r')
+            {
+                if (kinds[segment.argument] != StringFormatArgumentKind::Floating)
+                    return false;
+                continue;
+            }
+            StringFormatSpecifier parsed;
+            if (not parsed.parse(specifier, segment.length))
+                return false;
+        }
+        return true;
+    }
+};
+
 /// @brief Formats String with a simple DSL embedded in the format string
 ///
 /// This is a small implementation to format using a minimal string based DSL, but good enough for simple usages.
@@ -68,6 +280,8 @@ struct SC_STRINGS_EXPORT StringFormatOutput
 /// the given value. As the backend for actual number to string formatting is `snprintf`, such specification strings are
 /// the same as what would be given to snprintf. For example passing `"{:02}"` is transformed to `"%.02f"` when passed
 /// to snprintf. @n
+/// Integers without a specification are converted without going through snprintf, and `"{:r}"` formats floating
+/// points with the shortest digits that parse back to the same exact value (for example `0.1` or `1e+21`). @n
 /// `{` is escaped if found near to another `{`. In other words `format("{{")` will print a single `{`.
 ///
 /// Example:
@@ -92,6 +306,17 @@ struct StringFormat
     template <typename... Types>
     [[nodiscard]] static bool format(StringFormatOutput& data, StringView fmt, Types&&... args);
 
+    /// @brief Formats a string parsed at compile time (see SC_FORMAT_STRING), where mismatched braces, wrong number
+    /// of arguments or number specifiers not valid for their argument type are compile errors.
+    /// @tparam Literal Type holding the format string, created by SC_FORMAT_STRING
+    /// @tparam Types Types of the arguments being formatted
+    /// @param data Destination abstraction (buffer or console)
+    /// @param fmt The format string created with SC_FORMAT_STRING
+    /// @param args Actual arguments being formatted
+    /// @return `true` if format succeeded
+    template <typename Literal, typename... Types>
+    [[nodiscard]] static bool format(StringFormatOutput& data, StringFormatString<Literal> fmt, Types&&... args);
+
   private:
     struct Implementation;
 };
@@ -219,6 +444,53 @@ bool SC::StringFormat<RangeIterator>::format(StringFormatOutput& data, StringVie
     }
 }
 
+template <typename RangeIterator>
+template <typename Literal, typename... Types>
+bool SC::StringFormat<RangeIterator>::format(StringFormatOutput& data, StringFormatString<Literal>, Types&&... args)
+{
+    constexpr size_t NumSegments = StringFormatCompiler::compile<1>(Literal::get(), Literal::size()).numSegments;
+    static constexpr StringFormatCompiler::Segments<NumSegments == 0 ? 1 : NumSegments> compiled =
+        StringFormatCompiler::compile<NumSegments == 0 ? 1 : NumSegments>(Literal::get(), Literal::size());
+    constexpr StringFormatArgumentKind kinds[] = {
+        StringFormatArgumentKindOf<typename TypeTraits::RemoveConst<
+            typename TypeTraits::RemoveReference<Types>::type>::type>::value...,
+        StringFormatArgumentKind::Other};
+    static_assert(compiled.isValid, "Format string has unmatched '{' or '}' or an invalid argument position");
+    static_assert(compiled.numArguments == sizeof...(Types), "Format string doesn't use all and only given arguments");
+    static_assert(StringFormatCompiler::validate(compiled, Literal::get(), kinds),
+                  "Format string has a specifier that is not valid for the type of its argument");
+
+    constexpr auto maxArgs = sizeof...(args);
+    data.onFormatBegin();
+    for (size_t idx = 0; idx < compiled.numSegments; ++idx)
+    {
+        const StringFormatCompiler::Segment& segment = compiled.segments[idx];
+        const StringView text({Literal::get() + segment.start, segment.length}, false, StringEncoding::Utf8);
+        const bool       succeeded = segment.argument < 0 ? data.append(text)
+                                                          : Implementation::template formatArgument<maxArgs, maxArgs>(
+                                                          data, text, segment.argument, forward<Types>(args)...);
+        if (not succeeded)
+            SC_LANGUAGE_UNLIKELY
+            {
+                data.onFormatFailed();
+                return false;
+            }
+    }
+    return data.onFormatSucceeded();
+}
+
+/// @brief Creates a SC::StringFormatString from a string literal, parsing it at compile time when formatting
+#define SC_FORMAT_STRING(literal)                                                                                      \
+    []                                                                                                                 \
+    {                                                                                                                  \
+        struct Literal                                                                                                 \
+        {                                                                                                              \
+            static constexpr const char* get() { return literal; }                                                    \
+            static constexpr SC::size_t  size() { return sizeof(literal) - 1; }                                       \
+        };                                                                                                             \
+        return SC::StringFormatString<Literal>();                                                                      \
+    }()
+
 namespace SC
 {
 // clang-format off
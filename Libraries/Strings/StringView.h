@@ -404,6 +404,8 @@ struct SC::StringView : public StringSpan
     /// @brief Try parsing current StringView as a floating point number.
     /// @param value Will receive the parsed floating point number, if function returns `true`.
     /// @return `true` if the StringView has been successfully parsed as a floating point number.
+    /// @note The entire StringView must be a decimal number with optional exponent (`-12.5e3`), parsed independently
+    /// from current locale and rounded to the nearest float.
     ///
     /// Example:
     /// @code{.cpp}
@@ -419,6 +421,7 @@ struct SC::StringView : public StringSpan
     /// @brief Try parsing current StringView as a double precision floating point number.
     /// @param value Will receive the parsed double precision floating point number, if function returns `true`.
     /// @return `true` if the StringView has been successfully parsed as a double precision floating point number.
+    /// @note Follows the same rules of StringView::parseFloat, rounding to the nearest double.
     ///
     /// Example:
     /// @code{.cpp}
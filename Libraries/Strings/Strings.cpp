@@ -5,6 +5,19 @@
 #define SC_ASSERT_PROVIDER StringsAssert
 #include "../Common/Assert.inl"
 
+#include "../Common/StringSpan.h"
+
+#include <locale.h> // localeconv
+#include <stdlib.h> // strtod, strtof
+
+namespace SC
+{
+namespace StringsDetail
+{
+#include "../Common/NumberConversion.inl"
+}
+} // namespace SC
+
 #include "Internal/CommandLine.inl"
 #include "Internal/Console.inl"
 #include "Internal/Path.inl"
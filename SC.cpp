@@ -13,6 +13,7 @@
 #include "Libraries/Hashing/Hashing.cpp"
 #include "Libraries/Http/Http.cpp"
 #include "Libraries/Http/HttpAsyncClient.cpp"
+#include "Libraries/Http/HttpAsyncClientPool.cpp"
 #include "Libraries/Http/HttpAsyncFileServer.cpp"
 #include "Libraries/Http/HttpAsyncServer.cpp"
 #include "Libraries/Http/HttpConnection.cpp"
@@ -23,6 +24,7 @@
 #include "Libraries/Http/HttpURLParser.cpp"
 #include "Libraries/Http/HttpWebSocket.cpp"
 #include "Libraries/HttpClient/HttpClient.cpp"
+#include "Libraries/HttpClient/HttpClientMulti.cpp"
 #include "Libraries/HttpClient/HttpClientScheduler.cpp"
 #include "Libraries/HttpClient/HttpClientSession.cpp"
 #include "Libraries/Memory/Memory.cpp"
@@ -30,6 +32,7 @@
 #include "Libraries/Process/Process.cpp"
 #include "Libraries/SerialPort/SerialPort.cpp"
 #include "Libraries/SerializationText/SerializationJson.cpp"
+#include "Libraries/SerializationText/SerializationJsonStream.cpp"
 #include "Libraries/Socket/Socket.cpp"
 #include "Libraries/Strings/Strings.cpp"
 #include "Libraries/Testing/Testing.cpp"
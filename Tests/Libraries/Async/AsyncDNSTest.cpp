@@ -0,0 +1,438 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "Libraries/Async/AsyncDNS.h"
+#include "Libraries/Common/Assert.h"
+#include "Libraries/FileSystem/FileSystem.h"
+#include "Libraries/Memory/String.h"
+#include "Libraries/Socket/Socket.h"
+#include "Libraries/Strings/Path.h"
+#include "Libraries/Strings/StringView.h"
+#include "Libraries/Testing/Testing.h"
+
+#include <string.h> // memcpy
+
+namespace SC
+{
+struct AsyncDNSTest;
+}
+
+namespace
+{
+struct TimeoutGuard
+{
+    SC::AsyncLoopTimeout timeout;
+
+    SC::Result start(SC::AsyncEventLoop& loop, SC::TimeMs duration)
+    {
+        timeout.callback = [](SC::AsyncLoopTimeout::Result&)
+        { SC_ASSERT_RELEASE("Test never finished. Event loop timeout expired." && false); };
+        SC_TRY(timeout.start(loop, duration));
+        loop.excludeFromActiveCount(timeout);
+        return SC::Result(true);
+    }
+};
+
+// Minimal stand-in for a recursive DNS server, answering A / AAAA questions from a static table
+struct StandInDNSServer
+{
+    struct Record
+    {
+        const char* host;
+
+        SC::uint8_t  addressesV4[2][4];
+        SC::uint8_t  numAddressesV4;
+        SC::uint8_t  addressesV6[2][16];
+        SC::uint8_t  numAddressesV6;
+        SC::uint32_t ttl;
+
+        bool answerAAAA = true;  // false to simulate a server that never answers AAAA questions
+        bool nameError  = false; // true to answer NXDOMAIN
+        int  dropFirst  = 0;     // Number of questions to ignore before answering
+    };
+
+    SC::Span<Record> records;
+
+    int numQuestions = 0;
+
+    SC::SocketDescriptor       socket;
+    SC::AsyncSocketReceiveFrom receive;
+    SC::AsyncSocketSendTo      sends[4];
+
+    char question[512];
+    char replies[4][512];
+
+    SC::Result start(SC::AsyncEventLoop& loop, SC::uint16_t port)
+    {
+        SC::SocketIPAddress address;
+        SC_TRY(address.fromAddressPort("127.0.0.1", port));
+        SC_TRY(loop.createAsyncUDPSocket(address.getAddressFamily(), socket));
+        SC_TRY(SC::SocketServer(socket).bind(address));
+        receive.callback.bind<StandInDNSServer, &StandInDNSServer::onReceive>(*this);
+        SC_TRY(receive.start(loop, socket, {question, sizeof(question)}));
+        loop.excludeFromActiveCount(receive);
+        return SC::Result(true);
+    }
+
+    void onReceive(SC::AsyncSocketReceiveFrom::Result& result)
+    {
+        result.reactivateRequest(true);
+        SC::Span<char> data;
+        SC_ASSERT_RELEASE(result.get(data));
+        numQuestions++;
+
+        // Decode question name as a dotted string
+        char   name[256];
+        size_t nameLength = 0;
+        size_t offset     = 12;
+        while (data[offset] != 0)
+        {
+            const size_t labelLength = static_cast<SC::uint8_t>(data[offset]);
+            if (nameLength > 0)
+            {
+                name[nameLength++] = '.';
+            }
+            ::memcpy(name + nameLength, data.data() + offset + 1, labelLength);
+            nameLength += labelLength;
+            offset += 1 + labelLength;
+        }
+        const size_t       questionEnd  = offset + 5;
+        const SC::uint8_t* questionType = reinterpret_cast<const SC::uint8_t*>(data.data() + offset + 1);
+        const SC::uint16_t type         = static_cast<SC::uint16_t>((questionType[0] << 8) | questionType[1]);
+
+        Record* record = nullptr;
+        for (Record& it : records)
+        {
+            const SC::StringSpan host = SC::StringSpan::fromNullTerminated(it.host, SC::StringEncoding::Ascii);
+            if (SC::StringView({name, nameLength}, false, SC::StringEncoding::Ascii) == host)
+            {
+                record = &it;
+            }
+        }
+        if (record == nullptr or (type == 28 and not record->answerAAAA) or record->dropFirst-- > 0)
+        {
+            return;
+        }
+
+        SC::AsyncSocketSendTo* send = nullptr;
+        for (SC::AsyncSocketSendTo& it : sends)
+        {
+            if (it.isFree())
+            {
+                send = &it;
+                break;
+            }
+        }
+        SC_ASSERT_RELEASE(send != nullptr);
+        char* reply = replies[send - sends];
+        ::memcpy(reply, data.data(), questionEnd);
+        reply[2] = static_cast<char>(0x81);                            // Response, recursion desired
+        reply[3] = static_cast<char>(record->nameError ? 0x83 : 0x80); // Recursion available, NXDOMAIN
+
+        const SC::uint8_t numAddresses = type == 1 ? record->numAddressesV4 : record->numAddressesV6;
+        const SC::uint8_t numAnswers   = record->nameError ? 0 : numAddresses;
+
+        reply[6] = 0;
+        reply[7] = static_cast<char>(numAnswers);
+
+        size_t replySize = questionEnd;
+        for (SC::uint8_t idx = 0; idx < numAnswers; ++idx)
+        {
+            const size_t   dataLength = type == 1 ? 4 : 16;
+            const SC::uint8_t* address    = type == 1 ? record->addressesV4[idx] : record->addressesV6[idx];
+
+            const char answer[] = {static_cast<char>(0xC0), 12, // Pointer to question name
+                                   0, static_cast<char>(type), 0, 1,
+                                   static_cast<char>(record->ttl >> 24), static_cast<char>(record->ttl >> 16),
+                                   static_cast<char>(record->ttl >> 8), static_cast<char>(record->ttl), 0,
+                                   static_cast<char>(dataLength)};
+            ::memcpy(reply + replySize, answer, sizeof(answer));
+            replySize += sizeof(answer);
+            ::memcpy(reply + replySize, address, dataLength);
+            replySize += dataLength;
+        }
+        SC_ASSERT_RELEASE(send->start(result.eventLoop, socket, result.getSourceAddress(), {reply, replySize}));
+    }
+};
+
+SC::StringView addressToString(const SC::SocketIPAddress& address, SC::SocketIPAddress::AsciiBuffer& buffer)
+{
+    SC::StringSpan text;
+    SC_ASSERT_RELEASE(address.toString(buffer, text));
+    return text;
+}
+} // namespace
+
+struct SC::AsyncDNSTest : public SC::TestCase
+{
+    AsyncDNSTest(SC::TestReport& report) : TestCase(report, "AsyncDNSTest")
+    {
+        if (test_section("resolve and cache"))
+        {
+            resolveAndCache();
+        }
+        if (test_section("happy eyeballs and retries"))
+        {
+            happyEyeballsAndRetries();
+        }
+        if (test_section("resolv.conf and hosts"))
+        {
+            resolvConfAndHosts();
+        }
+    }
+
+    void resolveAndCache();
+    void happyEyeballsAndRetries();
+    void resolvConfAndHosts();
+};
+
+void SC::AsyncDNSTest::resolveAndCache()
+{
+    AsyncEventLoop loop;
+    SC_TEST_EXPECT(loop.create());
+
+    StandInDNSServer::Record records[2] = {
+        {"dual.test", {{10, 0, 0, 1}, {10, 0, 0, 2}}, 2, {{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}}, 1,
+         60},
+        {"zero.test", {{10, 0, 0, 3}}, 1, {}, 0, 0},
+    };
+    StandInDNSServer server;
+    server.records      = records;
+    const uint16_t port = report.mapPort(26132);
+    SC_TEST_EXPECT(server.start(loop, port));
+
+    TimeoutGuard timeout;
+    SC_TEST_EXPECT(timeout.start(loop, TimeMs{3000}));
+
+    SocketIPAddress nameserver;
+    SC_TEST_EXPECT(nameserver.fromAddressPort("127.0.0.1", port));
+
+    //! [AsyncDNSResolverSnippet]
+    AsyncDNSResolver::CacheEntry cache[4]; // Storage for cached resolutions
+
+    AsyncDNSResolver::Options options;
+    options.resolvConfPath = {}; // Use only the explicitly added nameserver
+    options.hostsPath      = {};
+
+    AsyncDNSResolver resolver;
+    SC_TEST_EXPECT(resolver.init(loop, cache, options));
+    SC_TEST_EXPECT(resolver.addNameserver(nameserver));
+
+    struct Context
+    {
+        AsyncDNSResolver& resolver;
+        StandInDNSServer& server;
+
+        int step = 0;
+    } ctx = {resolver, server};
+
+    AsyncDNSQuery query; // Must stay at a stable address until the callback is invoked
+    query.callback = [this, &ctx](AsyncDNSQuery::Result& result)
+    {
+        SC_TEST_EXPECT(result.returnCode);
+        SocketIPAddress::AsciiBuffer buffer;
+        switch (ctx.step++)
+        {
+        case 0: {
+            // A and AAAA answers are interleaved by family, starting with IPv6
+            Span<const SocketIPAddress> addresses = result.getAddresses();
+            SC_TEST_EXPECT(addresses.sizeInElements() == 3 and not result.isFromCache());
+            SC_TEST_EXPECT(addressToString(addresses[0], buffer) == "2001:db8::1");
+            SC_TEST_EXPECT(addressToString(addresses[1], buffer) == "10.0.0.1");
+            SC_TEST_EXPECT(addressToString(addresses[2], buffer) == "10.0.0.2");
+            SC_TEST_EXPECT(addresses[0].getPort() == 443 and addresses[2].getPort() == 443);
+            SC_TEST_EXPECT(ctx.server.numQuestions == 2);
+            // Queries can be restarted from inside the callback, and this one will hit the cache (ignoring case)
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "DUAL.test", 80));
+            break;
+        }
+        case 1:
+            SC_TEST_EXPECT(result.isFromCache() and result.getAddresses().sizeInElements() == 3);
+            SC_TEST_EXPECT(result.getAddresses()[1].getPort() == 80);
+            SC_TEST_EXPECT(ctx.server.numQuestions == 2);
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "zero.test"));
+            break;
+        case 2:
+            // Records with zero TTL are not cached, so the second resolution will query the server again
+            SC_TEST_EXPECT(not result.isFromCache() and result.getAddresses().sizeInElements() == 1);
+            SC_TEST_EXPECT(ctx.server.numQuestions == 4);
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "zero.test"));
+            break;
+        case 3:
+            SC_TEST_EXPECT(not result.isFromCache() and ctx.server.numQuestions == 6);
+            SC_TEST_EXPECT(addressToString(result.getAddresses()[0], buffer) == "10.0.0.3");
+            break;
+        }
+    };
+    SC_TEST_EXPECT(query.start(resolver, "dual.test", 443));
+    //! [AsyncDNSResolverSnippet]
+
+    SC_TEST_EXPECT(loop.run());
+    SC_TEST_EXPECT(ctx.step == 4 and query.isFree());
+    SC_TEST_EXPECT(resolver.close());
+    SC_TEST_EXPECT(loop.close());
+    SC_TEST_EXPECT(server.socket.close());
+}
+
+void SC::AsyncDNSTest::happyEyeballsAndRetries()
+{
+    AsyncEventLoop loop;
+    SC_TEST_EXPECT(loop.create());
+
+    StandInDNSServer::Record records[3] = {
+        {"v4only.test", {{10, 0, 0, 4}}, 1, {}, 0, 60, false},
+        {"retry.test", {{10, 0, 0, 5}}, 1, {}, 0, 60, true, false, 2},
+        {"missing.test", {}, 0, {}, 0, 60, true, true},
+    };
+    StandInDNSServer server;
+    server.records      = records;
+    const uint16_t port = report.mapPort(26133);
+    SC_TEST_EXPECT(server.start(loop, port));
+
+    TimeoutGuard timeout;
+    SC_TEST_EXPECT(timeout.start(loop, TimeMs{3000}));
+
+    AsyncDNSResolver::CacheEntry cache[2];
+    AsyncDNSResolver::Options    options;
+    options.resolvConfPath  = {};
+    options.hostsPath       = {};
+    options.timeout         = TimeMs{200};
+    options.resolutionDelay = TimeMs{20};
+
+    SocketIPAddress nameserver;
+    SC_TEST_EXPECT(nameserver.fromAddressPort("127.0.0.1", port));
+
+    AsyncDNSResolver resolver;
+    SC_TEST_EXPECT(resolver.init(loop, cache, options));
+    SC_TEST_EXPECT(resolver.addNameserver(nameserver));
+
+    struct Context
+    {
+        AsyncDNSResolver& resolver;
+        StandInDNSServer& server;
+        AsyncEventLoop&   loop;
+
+        TimeMs startTime;
+        int    step = 0;
+    } ctx = {resolver, server, loop, loop.getLoopTime()};
+
+    AsyncDNSQuery query;
+    query.callback = [this, &ctx](AsyncDNSQuery::Result& result)
+    {
+        ctx.loop.updateTime();
+        const int64_t elapsed = ctx.loop.getLoopTime().milliseconds - ctx.startTime.milliseconds;
+        ctx.startTime         = ctx.loop.getLoopTime();
+        switch (ctx.step++)
+        {
+        case 0:
+            // Missing AAAA answer doesn't block resolution for the entire retry timeout
+            SC_TEST_EXPECT(result.returnCode and result.getAddresses().sizeInElements() == 1);
+            SC_TEST_EXPECT(elapsed < 150);
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "v4only.test"));
+            break;
+        case 1:
+            // Partial resolutions (missing AAAA answer) are not cached
+            SC_TEST_EXPECT(result.returnCode and not result.isFromCache());
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "retry.test"));
+            break;
+        case 2:
+            // First A and AAAA questions have been dropped, so they've been sent again after the retry timeout
+            SC_TEST_EXPECT(result.returnCode and result.getAddresses().sizeInElements() == 1);
+            SC_TEST_EXPECT(elapsed >= 190);
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "missing.test"));
+            break;
+        case 3: SC_TEST_EXPECT(not result.returnCode); break;
+        }
+    };
+    SC_TEST_EXPECT(query.start(resolver, "v4only.test"));
+
+    SC_TEST_EXPECT(loop.run());
+    SC_TEST_EXPECT(ctx.step == 4);
+    SC_TEST_EXPECT(server.numQuestions == 2 + 2 + 4 + 2);
+    SC_TEST_EXPECT(resolver.close());
+    SC_TEST_EXPECT(loop.close());
+    SC_TEST_EXPECT(server.socket.close());
+}
+
+void SC::AsyncDNSTest::resolvConfAndHosts()
+{
+    AsyncEventLoop loop;
+    SC_TEST_EXPECT(loop.create());
+
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(report.applicationRootDirectory.view()));
+    SC_TEST_EXPECT(fs.writeString("dns-resolv.conf", "# Generated\n"
+                                                     "nameserver 127.0.0.1\n"
+                                                     "nameserver ::1 # different family, ignored\n"
+                                                     "search example.com\n"
+                                                     "options rotate timeout:3 attempts:4\n"
+                                                     "nameserver 127.0.0.2"));
+    SC_TEST_EXPECT(fs.writeString("dns-hosts", "127.0.0.1\tlocalhost\n"
+                                               "# 10.0.0.9 commented.test\n"
+                                               "10.1.2.3   myhost.test  alias.test # comment\n"
+                                               "fe80::1%lo0 linklocal.test\n"));
+    String resolvConfPath, hostsPath;
+    SC_TEST_EXPECT(Path::join(resolvConfPath, {report.applicationRootDirectory.view(), "dns-resolv.conf"}));
+    SC_TEST_EXPECT(Path::join(hostsPath, {report.applicationRootDirectory.view(), "dns-hosts"}));
+
+    AsyncDNSResolver::Options options;
+    options.resolvConfPath = resolvConfPath.view();
+    options.hostsPath      = hostsPath.view();
+
+    AsyncDNSResolver resolver;
+    SC_TEST_EXPECT(resolver.init(loop, {}, options));
+    SocketIPAddress::AsciiBuffer buffer;
+    SC_TEST_EXPECT(resolver.getNameservers().sizeInElements() == 2);
+    SC_TEST_EXPECT(addressToString(resolver.getNameservers()[1], buffer) == "127.0.0.2");
+    SC_TEST_EXPECT(resolver.getNameservers()[0].getPort() == 53);
+    SC_TEST_EXPECT(resolver.getOptions().timeout.milliseconds == 3000);
+    SC_TEST_EXPECT(resolver.getOptions().attempts == 4);
+
+    // Nameservers are never contacted, as all names are resolved from the hosts file or are literals
+    resolver.clearNameservers();
+
+    struct Context
+    {
+        AsyncDNSResolver& resolver;
+
+        int step = 0;
+    } ctx = {resolver};
+
+    AsyncDNSQuery query;
+    query.callback = [this, &ctx](AsyncDNSQuery::Result& result)
+    {
+        SC_TEST_EXPECT(result.returnCode and result.getAddresses().sizeInElements() == 1);
+        SocketIPAddress::AsciiBuffer buffer;
+        const SocketIPAddress&       address = result.getAddresses()[0];
+        switch (ctx.step++)
+        {
+        case 0:
+            SC_TEST_EXPECT(addressToString(address, buffer) == "10.1.2.3" and address.getPort() == 8080);
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "linklocal.test"));
+            break;
+        case 1:
+            SC_TEST_EXPECT(addressToString(address, buffer) == "fe80::1");
+            SC_TEST_EXPECT(result.query.start(ctx.resolver, "192.168.1.1", 21));
+            break;
+        case 2: SC_TEST_EXPECT(addressToString(address, buffer) == "192.168.1.1" and address.getPort() == 21); break;
+        }
+    };
+    SC_TEST_EXPECT(query.start(resolver, "Alias.Test", 8080));
+    bool callbackInvoked = ctx.step > 0;
+    SC_TEST_EXPECT(not callbackInvoked); // Callback is always invoked asynchronously
+
+    SC_TEST_EXPECT(loop.run());
+    SC_TEST_EXPECT(ctx.step == 3);
+
+    // Names not in hosts file fail without nameservers
+    SC_TEST_EXPECT(not query.start(resolver, "commented.test"));
+    SC_TEST_EXPECT(query.isFree());
+
+    SC_TEST_EXPECT(resolver.close());
+    SC_TEST_EXPECT(loop.close());
+    SC_TEST_EXPECT(fs.removeFiles({"dns-resolv.conf", "dns-hosts"}));
+}
+
+namespace SC
+{
+void runAsyncDNSTest(SC::TestReport& report) { AsyncDNSTest test(report); }
+} // namespace SC
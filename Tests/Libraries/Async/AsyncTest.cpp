@@ -172,6 +172,10 @@ SC::AsyncTest::AsyncTest(SC::TestReport& report) : TestCase(report, "AsyncTest")
         {
             socketTCPConnect();
         }
+        if (test_section("socket TCP connect with fast open"))
+        {
+            socketTCPConnectFastOpen();
+        }
         if (test_section("socket TCP send/receive"))
         {
             socketTCPSendReceive();
@@ -188,6 +192,10 @@ SC::AsyncTest::AsyncTest(SC::TestReport& report) : TestCase(report, "AsyncTest")
         {
             socketUDPSendReceive();
         }
+        if (test_section("socket UDP batched send/receive"))
+        {
+            socketUDPSendReceiveBatched();
+        }
         if (test_section("file read/write"))
         {
             fileReadWrite(false); // do not use thread-pool
@@ -212,6 +220,10 @@ SC::AsyncTest::AsyncTest(SC::TestReport& report) : TestCase(report, "AsyncTest")
         {
             fileReadiness();
         }
+        if (test_section("file readiness writable"))
+        {
+            fileReadinessWritable();
+        }
         if (test_section("file readiness cancel"))
         {
             fileReadinessCancel();
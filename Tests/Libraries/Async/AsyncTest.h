@@ -52,6 +52,7 @@ struct SC::AsyncTest : public SC::TestCase
     void fileWriteMultiple(bool useThreadPool);
     void fileSend(bool useThreadPool);
     void fileReadiness();
+    void fileReadinessWritable();
     void fileReadinessCancel();
     void externalCompletionManual();
     void fileClose();
@@ -65,12 +66,14 @@ struct SC::AsyncTest : public SC::TestCase
     // TCP Sockets
     void socketTCPAccept();
     void socketTCPConnect();
+    void socketTCPConnectFastOpen();
     void socketTCPSendReceive();
     void socketTCPSendMultiple();
     void socketTCPSendReceiveError();
 
     // UDP Sockets
     void socketUDPSendReceive();
+    void socketUDPSendReceiveBatched();
 
     // File System Operations
     void fileSystemOperations();
@@ -367,6 +367,57 @@ void SC::AsyncTest::fileReadiness()
     SC_TEST_EXPECT(eventLoop.close());
 }
 
+void SC::AsyncTest::fileReadinessWritable()
+{
+    PipeDescriptor pipe;
+    PipeOptions    pipeOptions;
+    pipeOptions.blocking = false;
+    SC_TEST_EXPECT(pipe.createPipe(pipeOptions));
+
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create(options));
+
+    FileDescriptor::Handle writeHandle = FileDescriptor::Invalid;
+    SC_TEST_EXPECT(pipe.writePipe.get(writeHandle, Result::Error("write handle")));
+
+    int                pollCount = 0;
+    AsyncFileReadiness poll;
+    poll.setDebugName("FileReadinessWritable");
+    poll.callback = [this, &pollCount](AsyncFileReadiness::Result& res)
+    {
+        SC_TEST_EXPECT(res.isValid());
+        pollCount++;
+    };
+
+#if SC_PLATFORM_WINDOWS
+    SC_TEST_EXPECT(not poll.start(eventLoop, writeHandle, AsyncFileReadiness::Mode::Writable));
+    SC_TEST_EXPECT(pollCount == 0);
+#else
+    // An empty pipe is immediately writable
+    SC_TEST_EXPECT(poll.start(eventLoop, writeHandle, AsyncFileReadiness::Mode::Writable));
+    SC_TEST_EXPECT(eventLoop.runOnce());
+    SC_TEST_EXPECT(pollCount == 1);
+
+    // Fill the pipe until it would block, so that it's not writable anymore
+    char buffer[4096] = {};
+    while (pipe.writePipe.write({buffer, sizeof(buffer)}))
+        continue;
+    SC_TEST_EXPECT(poll.start(eventLoop, writeHandle, AsyncFileReadiness::Mode::Writable));
+    SC_TEST_EXPECT(eventLoop.runNoWait());
+    SC_TEST_EXPECT(pollCount == 1);
+
+    // Draining the pipe makes it writable again
+    Span<char> readData;
+    while (pipe.readPipe.read({buffer, sizeof(buffer)}, readData) and not readData.empty())
+        continue;
+    SC_TEST_EXPECT(eventLoop.runOnce());
+    SC_TEST_EXPECT(pollCount == 2);
+#endif
+
+    SC_TEST_EXPECT(pipe.close());
+    SC_TEST_EXPECT(eventLoop.close());
+}
+
 void SC::AsyncTest::fileReadinessCancel()
 {
     PipeDescriptor pipe;
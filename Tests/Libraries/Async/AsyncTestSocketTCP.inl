@@ -181,6 +181,95 @@ void SC::AsyncTest::socketTCPConnect()
     SC_TEST_EXPECT(context.acceptedClient[1].close());
 }
 
+void SC::AsyncTest::socketTCPConnectFastOpen()
+{
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create(options));
+
+    SocketIPAddress address;
+    SC_TEST_EXPECT(address.fromAddressPort("127.0.0.1", report.mapPort(5058)));
+
+    SocketOptions serverOptions;
+    serverOptions.tcpFastOpenQueueLength = 16;
+
+    SocketDescriptor serverSocket;
+    SC_TEST_EXPECT(eventLoop.createAsyncTCPSocket(address.getAddressFamily(), serverSocket, serverOptions));
+    {
+        SocketServer server(serverSocket);
+        SC_TEST_EXPECT(server.bind(address));
+        SC_TEST_EXPECT(server.listen(2));
+    }
+
+    static constexpr StringView request = "GET / HTTP/1.1\r\n\r\n";
+
+    // The first connection obtains a Fast Open cookie (if enabled on server side), that is used by the second one
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        SocketDescriptor  acceptedClient;
+        AsyncSocketAccept accept;
+        accept.callback = [&](AsyncSocketAccept::Result& res) { SC_TEST_EXPECT(res.moveTo(acceptedClient)); };
+        SC_TEST_EXPECT(accept.start(eventLoop, serverSocket));
+
+        //! [AsyncSocketConnectFastOpenSnippet]
+        SocketOptions clientOptions;
+#if SC_PLATFORM_WINDOWS
+        clientOptions.tcpFastOpenQueueLength = 1; // Windows needs TCP_FASTOPEN also on the connecting socket
+#endif
+        struct Client
+        {
+            SocketDescriptor socket;
+            AsyncSocketSend  send;
+        } client;
+        SC_TEST_EXPECT(eventLoop.createAsyncTCPSocket(address.getAddressFamily(), client.socket, clientOptions));
+
+        AsyncSocketConnect connect;
+        connect.callback = [this, &client](AsyncSocketConnect::Result& res)
+        {
+            SC_TEST_EXPECT(res.isValid());
+            // Send the part of the request that has not been carried by the SYN (if any)
+            Span<const char> remaining;
+            SC_TEST_EXPECT(request.toCharSpan().sliceStart(res.completionData.numBytes, remaining));
+            if (not remaining.empty())
+            {
+                client.send.callback = [this](AsyncSocketSend::Result& sendRes) { SC_TEST_EXPECT(sendRes.isValid()); };
+                SC_TEST_EXPECT(client.send.start(res.eventLoop, client.socket, remaining));
+            }
+        };
+        SC_TEST_EXPECT(connect.start(eventLoop, client.socket, address, request.toCharSpan()));
+        //! [AsyncSocketConnectFastOpenSnippet]
+
+        struct Context
+        {
+            char   buffer[64]  = {0};
+            size_t numReceived = 0;
+        } context;
+
+        AsyncSocketReceive receive;
+        receive.callback = [this, &context](AsyncSocketReceive::Result& res)
+        {
+            Span<char> readData;
+            SC_TEST_EXPECT(res.get(readData));
+            context.numReceived += readData.sizeInBytes();
+            SC_TEST_EXPECT(context.numReceived <= request.sizeInBytes());
+            if (context.numReceived < request.sizeInBytes())
+            {
+                res.getAsync().buffer = {context.buffer + context.numReceived,
+                                         sizeof(context.buffer) - context.numReceived};
+                res.reactivateRequest(true);
+            }
+        };
+        SC_TEST_EXPECT(eventLoop.run()); // Accept and connect
+        SC_TEST_EXPECT(acceptedClient.isValid());
+        SC_TEST_EXPECT(eventLoop.associateExternallyCreatedSocket(acceptedClient));
+        SC_TEST_EXPECT(receive.start(eventLoop, acceptedClient, {context.buffer, sizeof(context.buffer)}));
+        SC_TEST_EXPECT(eventLoop.run());
+        SC_TEST_EXPECT(StringView({context.buffer, context.numReceived}, false, StringEncoding::Ascii) == request);
+        SC_TEST_EXPECT(client.socket.close());
+        SC_TEST_EXPECT(acceptedClient.close());
+    }
+    SC_TEST_EXPECT(serverSocket.close());
+}
+
 void SC::AsyncTest::socketTCPSendReceive()
 {
     AsyncEventLoop eventLoop;
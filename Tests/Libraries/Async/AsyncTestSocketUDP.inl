@@ -63,3 +63,88 @@ void SC::AsyncTest::socketUDPSendReceive()
     SC_TEST_EXPECT(clientSocket.close());
     SC_TEST_EXPECT(eventLoop.close());
 }
+
+void SC::AsyncTest::socketUDPSendReceiveBatched()
+{
+#if SC_PLATFORM_WINDOWS
+    // Batched datagrams are not supported on Windows
+#else
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create(options));
+    SocketIPAddress serverAddress;
+    const uint16_t  port = report.mapPort(5055);
+    SC_TEST_EXPECT(serverAddress.fromAddressPort("127.0.0.1", port));
+
+    SocketDescriptor serverSocket, clientSocket;
+    SC_TEST_EXPECT(eventLoop.createAsyncUDPSocket(serverAddress.getAddressFamily(), serverSocket));
+    SC_TEST_EXPECT(eventLoop.createAsyncUDPSocket(serverAddress.getAddressFamily(), clientSocket));
+    SC_TEST_EXPECT(SocketServer(serverSocket).bind(serverAddress));
+#if SC_PLATFORM_LINUX
+    // Kernel is allowed (but not forced) to coalesce segments sent with UDP_SEGMENT
+    SC_TEST_EXPECT(serverSocket.setUdpReceiveOffload(true));
+#endif
+
+    //! [AsyncSocketSendToBatchedSnippet]
+    // Runs of datagrams with same size and destination are coalesced when segmentationOffload is set.
+    // Here "AAAA", "BBBB", "CCCC", "DD" and "EEEEEE", "F" will be sent with just two messages.
+    AsyncSocketSendDatagram sendDatagrams[6];
+    const StringSpan        payloads[6] = {"AAAA", "BBBB", "CCCC", "DD", "EEEEEE", "F"};
+    for (size_t idx = 0; idx < 6; ++idx)
+    {
+        sendDatagrams[idx].data    = payloads[idx].toCharSpan();
+        sendDatagrams[idx].address = serverAddress;
+    }
+    AsyncSocketSendTo sendTo;
+    sendTo.segmentationOffload = SC_PLATFORM_LINUX;
+    sendTo.callback            = [this](AsyncSocketSendTo::Result& res)
+    {
+        SC_TEST_EXPECT(res.isValid());
+        SC_TEST_EXPECT(res.completionData.numBytes == 21); // Sum of all datagram sizes
+    };
+    SC_TEST_EXPECT(sendTo.start(eventLoop, clientSocket, {sendDatagrams, 6}));
+    //! [AsyncSocketSendToBatchedSnippet]
+
+    struct Context
+    {
+        char   buffers[8][64];
+        char   received[32] = {0};
+        size_t numReceived  = 0;
+        size_t numSegments  = 0;
+    } context;
+
+    //! [AsyncSocketReceiveFromBatchedSnippet]
+    AsyncSocketReceiveDatagram receiveDatagrams[8];
+    for (size_t idx = 0; idx < 8; ++idx)
+    {
+        receiveDatagrams[idx].buffer = context.buffers[idx];
+    }
+    AsyncSocketReceiveFrom receiveFrom;
+    receiveFrom.callback = [this, &context](AsyncSocketReceiveFrom::Result& res)
+    {
+        SC_TEST_EXPECT(res.isValid());
+        for (const AsyncSocketReceiveDatagram& datagram : res.getDatagrams())
+        {
+            SC_TEST_EXPECT(datagram.address.isValid());
+            const Span<const char> data = datagram.data();
+            SC_TEST_EXPECT(context.numReceived + data.sizeInBytes() <= sizeof(context.received));
+            ::memcpy(context.received + context.numReceived, data.data(), data.sizeInBytes());
+            context.numReceived += data.sizeInBytes();
+            // A coalesced datagram holds segments of segmentSize bytes (with a shorter last one)
+            const size_t segment = datagram.segmentSize == 0 ? data.sizeInBytes() : datagram.segmentSize;
+            context.numSegments += (data.sizeInBytes() + segment - 1) / segment;
+        }
+        res.reactivateRequest(context.numSegments < 6);
+    };
+    SC_TEST_EXPECT(receiveFrom.start(eventLoop, serverSocket, {receiveDatagrams, 8}));
+    //! [AsyncSocketReceiveFromBatchedSnippet]
+
+    SC_TEST_EXPECT(eventLoop.run());
+
+    SC_TEST_EXPECT(context.numSegments == 6);
+    SC_TEST_EXPECT(context.numReceived == 21);
+    SC_TEST_EXPECT(::memcmp(context.received, "AAAABBBBCCCCDDEEEEEEF", 21) == 0);
+    SC_TEST_EXPECT(serverSocket.close());
+    SC_TEST_EXPECT(clientSocket.close());
+    SC_TEST_EXPECT(eventLoop.close());
+#endif
+}
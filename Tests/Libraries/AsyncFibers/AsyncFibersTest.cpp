@@ -156,6 +156,10 @@ struct SC::AsyncFibersTest : public SC::TestCase
         {
             udpSendReceive();
         }
+        if (test_section("udp batched send receive"))
+        {
+            udpBatchedSendReceive();
+        }
         if (test_section("file send"))
         {
             fileSend();
@@ -2599,6 +2603,95 @@ struct SC::AsyncFibersTest : public SC::TestCase
         SC_TEST_EXPECT(eventLoop.close());
     }
 
+    void udpBatchedSendReceive()
+    {
+#if not SC_PLATFORM_WINDOWS
+        struct State
+        {
+            AsyncFiberIO*     io           = nullptr;
+            SocketDescriptor* serverSocket = nullptr;
+            SocketDescriptor* clientSocket = nullptr;
+
+            AsyncSocketSendDatagram    sendDatagrams[3];
+            AsyncSocketReceiveDatagram receiveDatagrams[3];
+            char                       receiveBuffers[3][16] = {};
+            size_t                     numReceived           = 0;
+
+            AsyncFiberSocketSendResult sendResult;
+
+            Result receiveAll()
+            {
+                while (numReceived < 3)
+                {
+                    AsyncFiberSocketReceiveFromResult receiveResult;
+                    SC_TRY(io->receiveFrom(*serverSocket, {receiveDatagrams + numReceived, 3 - numReceived},
+                                           receiveResult));
+                    numReceived += receiveResult.datagrams.sizeInElements();
+                }
+                return Result(true);
+            }
+        };
+
+        AsyncEventLoop eventLoop;
+        SC_TEST_EXPECT(eventLoop.create());
+
+        SocketIPAddress serverAddress;
+        SC_TEST_EXPECT(serverAddress.fromAddressPort("127.0.0.1", report.mapPort(6059)));
+
+        SocketDescriptor serverSocket;
+        SocketDescriptor clientSocket;
+        SC_TEST_EXPECT(eventLoop.createAsyncUDPSocket(serverAddress.getAddressFamily(), serverSocket));
+        SC_TEST_EXPECT(eventLoop.createAsyncUDPSocket(serverAddress.getAddressFamily(), clientSocket));
+        SC_TEST_EXPECT(SocketServer(serverSocket).bind(serverAddress));
+
+        FiberScheduler scheduler;
+        AsyncFiberIO   io(scheduler, eventLoop);
+        FiberTask      receiveTask;
+        FiberTask      sendTask;
+        char           receiveStackMemory[64 * 1024] = {};
+        char           sendStackMemory[64 * 1024]    = {};
+        FiberStack     receiveStack({receiveStackMemory, sizeof(receiveStackMemory)});
+        FiberStack     sendStack({sendStackMemory, sizeof(sendStackMemory)});
+
+        State state;
+        state.io           = &io;
+        state.serverSocket = &serverSocket;
+        state.clientSocket = &clientSocket;
+
+        const StringSpan payloads[3] = {"one", "two", "three"};
+        for (size_t idx = 0; idx < 3; ++idx)
+        {
+            state.sendDatagrams[idx].data      = payloads[idx].toCharSpan();
+            state.sendDatagrams[idx].address   = serverAddress;
+            state.receiveDatagrams[idx].buffer = state.receiveBuffers[idx];
+        }
+
+        SC_TEST_EXPECT(scheduler.spawn(receiveTask, receiveStack,
+                                       FiberTask::Procedure([&state](FiberScheduler&) { return state.receiveAll(); })));
+        SC_TEST_EXPECT(scheduler.spawn(
+            sendTask, sendStack,
+            FiberTask::Procedure(
+                [&state](FiberScheduler&)
+                { return state.io->sendTo(*state.clientSocket, state.sendDatagrams, &state.sendResult); })));
+
+        SC_TEST_EXPECT(io.run());
+        SC_TEST_EXPECT(receiveTask.result());
+        SC_TEST_EXPECT(sendTask.result());
+        SC_TEST_EXPECT(state.sendResult.numBytes == 11);
+        SC_TEST_EXPECT(state.numReceived == 3);
+        for (size_t idx = 0; idx < 3; ++idx)
+        {
+            const Span<const char> data = state.receiveDatagrams[idx].data();
+            SC_TEST_EXPECT(state.receiveDatagrams[idx].address.isValid());
+            SC_TEST_EXPECT(StringView(data, false, StringEncoding::Ascii) == StringView(payloads[idx]));
+        }
+
+        SC_TEST_EXPECT(serverSocket.close());
+        SC_TEST_EXPECT(clientSocket.close());
+        SC_TEST_EXPECT(eventLoop.close());
+#endif
+    }
+
     void fileSend()
     {
         struct State
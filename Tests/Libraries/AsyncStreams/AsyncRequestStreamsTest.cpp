@@ -4,6 +4,7 @@
 #include "Libraries/AsyncStreams/AsyncRequestStreams.h"
 #include "Libraries/Async/Async.h"
 #include "Libraries/AsyncStreams/AsyncStreams.h"
+#include "Libraries/AsyncStreams/CodecTransformStreams.h"
 #include "Libraries/AsyncStreams/Internal/ZLibAPI.h"
 #include "Libraries/AsyncStreams/ZLibTransformStreams.h"
 #include "Libraries/Containers/Vector.h"
@@ -27,6 +28,8 @@ using WritableFileStream       = AsyncWritableFileStream<AsyncEventLoop>;
 using ReadableSocketStream     = AsyncReadableSocketStream<AsyncEventLoop>;
 using WritableSocketStream     = AsyncWritableSocketStream<AsyncEventLoop>;
 using AsyncZLibTransformStream = AsyncZLibTransformStreamT<AsyncEventLoop>;
+using AsyncGZipParallelStream  = AsyncGZipParallelStreamT<AsyncEventLoop>;
+using AsyncZStdTransformStream = AsyncZStdTransformStreamT<AsyncEventLoop>;
 } // namespace SC
 
 struct SC::AsyncRequestStreamsTest : public SC::TestCase
@@ -132,6 +135,26 @@ struct SC::AsyncRequestStreamsTest : public SC::TestCase
                                                                                                     readable, blocking);
             }
 
+            if (test_section("zero copy"))
+            {
+                zeroCopy(false);
+            }
+
+            if (test_section("zero copy after queued write"))
+            {
+                zeroCopy(true);
+            }
+
+            if (test_section("parallel gzip"))
+            {
+                parallelGZip();
+            }
+
+            if (test_section("zstd transform"))
+            {
+                zstdTransform();
+            }
+
             if (numTestsToRun == 2)
             {
                 // If on Linux next run will test io_uring backend (if available)
@@ -141,13 +164,16 @@ struct SC::AsyncRequestStreamsTest : public SC::TestCase
     }
 
     void createAsyncConnectedSockets(AsyncEventLoop& eventLoop, SocketDescriptor& writeSide,
-                                     SocketDescriptor& readSide);
+                                     SocketDescriptor& readSide, uint16_t port = 5050);
     void createAsyncConnectedPipes(AsyncEventLoop& eventLoop, FileDescriptor& writeSide, FileDescriptor& readSide,
                                    bool blocking);
     void createAsyncConnectedNamedPipes(AsyncEventLoop& eventLoop, FileDescriptor& writeSide, FileDescriptor& readSide,
                                         bool blocking);
 
     void fileToFile();
+    void zeroCopy(bool queueHeaderWrite);
+    void parallelGZip();
+    void zstdTransform();
 
     template <typename READABLE_TYPE, typename WRITABLE_TYPE, typename ZLIB_STREAM_TYPE, typename DESCRIPTOR_TYPE>
     void fileCompressRemote(AsyncEventLoop& eventLoop, DESCRIPTOR_TYPE& writeSide, DESCRIPTOR_TYPE& readSide,
@@ -165,10 +191,10 @@ struct SC::AsyncRequestStreamsTest : public SC::TestCase
 };
 
 void SC::AsyncRequestStreamsTest::createAsyncConnectedSockets(AsyncEventLoop& eventLoop, SocketDescriptor& writeSide,
-                                                              SocketDescriptor& readSide)
+                                                              SocketDescriptor& readSide, uint16_t port)
 {
     SocketDescriptor serverSocket;
-    uint16_t         tcpPort        = report.mapPort(5050);
+    uint16_t         tcpPort        = report.mapPort(port);
     StringView       connectAddress = "::1";
     SocketIPAddress  nativeAddress;
     SC_TEST_EXPECT(nativeAddress.fromAddressPort(connectAddress, tcpPort));
@@ -574,6 +600,367 @@ void SC::AsyncRequestStreamsTest::fileCompressRemote(AsyncEventLoop& eventLoop,
     SC_TEST_EXPECT(fs.removeFiles({"source.txt", "destination.txt"}));
 }
 
+void SC::AsyncRequestStreamsTest::zeroCopy(bool queueHeaderWrite)
+{
+    // This test:
+    // 1. Pipes a file into a socket and that socket into a second socket, both with AsyncPipeline::zeroCopy
+    // 2. Collects everything received from the second socket with a regular readable stream
+    // 3. Checks that received data matches the file (and that pipelines have been splicing on Linux)
+    // When queueHeaderWrite is set, a write queued on the first socket before piping must be received before the file
+    // data, making the first pipeline fall back to buffered copies.
+    Vector<uint64_t> source;
+    constexpr size_t numElements = 1024 * 1024 / sizeof(uint64_t); // Many times the capacity of a kernel pipe
+    SC_TEST_EXPECT(source.resizeWithoutInitializing(numElements));
+    for (size_t idx = 0; idx < numElements; ++idx)
+    {
+        source[idx] = idx;
+    }
+    const Span<const char> sourceData = source.toSpanConst().reinterpret_as_span_of<const char>();
+
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(report.applicationRootDirectory.view()));
+    SC_TEST_EXPECT(fs.write("zerocopy.txt", sourceData));
+
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create(options));
+
+    SocketDescriptor writeSide1, readSide1, writeSide2, readSide2;
+    createAsyncConnectedSockets(eventLoop, writeSide1, readSide1, 5050);
+    createAsyncConnectedSockets(eventLoop, writeSide2, readSide2, 5051);
+
+    String fileName;
+    SC_TEST_EXPECT(Path::join(fileName, {report.applicationRootDirectory.view(), "zerocopy.txt"}));
+    FileOpen openModeRead;
+    openModeRead.mode     = FileOpen::Read;
+    openModeRead.blocking = false;
+    FileDescriptor readFd;
+    SC_TEST_EXPECT(readFd.open(fileName.view(), openModeRead));
+    SC_TEST_EXPECT(eventLoop.associateExternallyCreatedFileDescriptor(readFd));
+
+    constexpr size_t numberOfBuffers = 4;
+    constexpr size_t buffersSize     = 16 * 1024;
+    AsyncBufferView  buffers[numberOfBuffers + 1]; // Last one is left empty for the header write
+    Buffer           buffer;
+    SC_TEST_EXPECT(buffer.resizeWithoutInitializing(buffersSize * numberOfBuffers));
+    for (size_t idx = 0; idx < numberOfBuffers; ++idx)
+    {
+        Span<char> writableData;
+        SC_TEST_EXPECT(buffer.toSpan().sliceStartLength(idx * buffersSize, buffersSize, writableData));
+        buffers[idx] = writableData;
+        buffers[idx].setReusable(true);
+    }
+    AsyncBuffersPool pool;
+    pool.setBuffers(buffers);
+
+    ReadableFileStream           fileStream;
+    WritableSocketStream         writeStream1, writeStream2;
+    ReadableSocketStream         readStream1, readStream2;
+    AsyncReadableStream::Request readRequests[3][numberOfBuffers + 1];
+    AsyncWritableStream::Request writeRequests[2][numberOfBuffers + 1];
+
+    fileStream.setReadQueue(readRequests[0]);
+    readStream1.setReadQueue(readRequests[1]);
+    readStream2.setReadQueue(readRequests[2]);
+    writeStream1.setWriteQueue(writeRequests[0]);
+    writeStream2.setWriteQueue(writeRequests[1]);
+    SC_TEST_EXPECT(fileStream.init(pool, eventLoop, readFd));
+    SC_TEST_EXPECT(writeStream1.init(pool, eventLoop, writeSide1));
+    SC_TEST_EXPECT(readStream1.init(pool, eventLoop, readSide1));
+    SC_TEST_EXPECT(writeStream2.init(pool, eventLoop, writeSide2));
+    SC_TEST_EXPECT(readStream2.init(pool, eventLoop, readSide2));
+
+    // Closing each write side when its pipeline ends propagates the end to the next one
+    writeStream1.setAutoCloseDescriptor(true);
+    readStream1.setAutoCloseDescriptor(true);
+    writeStream2.setAutoCloseDescriptor(true);
+    readStream2.setAutoCloseDescriptor(true);
+    writeSide1.detach();
+    readSide1.detach();
+    writeSide2.detach();
+    readSide2.detach();
+
+    constexpr StringSpan header = "HEADER";
+    if (queueHeaderWrite)
+    {
+        SC_TEST_EXPECT(writeStream1.write("HEADER"));
+    }
+
+    AsyncPipeline pipeline1 = {&fileStream, {}, {&writeStream1}};
+    AsyncPipeline pipeline2 = {&readStream1, {}, {&writeStream2}};
+    pipeline1.zeroCopy      = true;
+    pipeline2.zeroCopy      = true;
+    (void)pipeline1.eventError.addListener([this](Result res) { SC_TEST_EXPECT(res); });
+    (void)pipeline2.eventError.addListener([this](Result res) { SC_TEST_EXPECT(res); });
+    SC_TEST_EXPECT(pipeline1.pipe());
+    SC_TEST_EXPECT(pipeline2.pipe());
+    SC_TEST_EXPECT(pipeline1.isSplicing() == (SC_PLATFORM_LINUX != 0 and not queueHeaderWrite));
+    SC_TEST_EXPECT(pipeline2.isSplicing() == (SC_PLATFORM_LINUX != 0));
+
+    struct Collector
+    {
+        AsyncBuffersPool& pool;
+        Buffer            received;
+        bool              valid = true;
+    } collector = {pool, {}, true};
+    SC_TEST_EXPECT(collector.received.reserve(header.sizeInBytes() + sourceData.sizeInBytes()));
+    (void)readStream2.eventData.addListener(
+        [&collector](AsyncBufferView::ID bufferID)
+        {
+            Span<const char> data;
+            collector.valid = collector.valid and collector.pool.getReadableData(bufferID, data) and
+                              collector.received.append(data);
+        });
+    (void)readStream2.eventError.addListener([this](Result res) { SC_TEST_EXPECT(res); });
+
+    SC_TEST_EXPECT(pipeline1.start());
+    SC_TEST_EXPECT(pipeline2.start());
+    SC_TEST_EXPECT(readStream2.start());
+
+    // Safety timout against hangs
+    AsyncLoopTimeout timeout;
+    timeout.callback = [this](AsyncLoopTimeout::Result&)
+    { SC_TEST_EXPECT("Test never finished. Event Loop is stuck. Timeout expired." && false); };
+    SC_TEST_EXPECT(timeout.start(eventLoop, TimeMs{5000}));
+    eventLoop.excludeFromActiveCount(timeout);
+
+    SC_TEST_EXPECT(eventLoop.run());
+    SC_TEST_EXPECT(readFd.close());
+
+    const size_t  headerSize = queueHeaderWrite ? header.sizeInBytes() : 0;
+    const Buffer& received   = collector.received;
+    SC_TEST_EXPECT(collector.valid);
+    SC_TEST_EXPECT(received.size() == headerSize + sourceData.sizeInBytes());
+    SC_TEST_EXPECT(::memcmp(received.data(), header.bytesWithoutTerminator(), headerSize) == 0);
+    SC_TEST_EXPECT(::memcmp(received.data() + headerSize, sourceData.data(), sourceData.sizeInBytes()) == 0);
+    SC_TEST_EXPECT(fs.removeFile("zerocopy.txt"));
+}
+
+void SC::AsyncRequestStreamsTest::parallelGZip()
+{
+    // This test:
+    // 1. Compresses a file with AsyncGZipParallelStream, transforming multiple chunks concurrently on a thread pool
+    // 2. Decompresses the resulting file with a regular GZIP ZLibStream
+    // 3. Checks that decompressed data matches the source file
+    Vector<uint64_t> source;
+    constexpr size_t numElements = 256 * 1024 / sizeof(uint64_t);
+    SC_TEST_EXPECT(source.resizeWithoutInitializing(numElements));
+    for (size_t idx = 0; idx < numElements; ++idx)
+    {
+        source[idx] = (idx * 2654435761u) % 4099; // Somewhat compressible data
+    }
+    const Span<const char> sourceData = source.toSpanConst().reinterpret_as_span_of<const char>();
+
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(report.applicationRootDirectory.view()));
+    SC_TEST_EXPECT(fs.write("parallel.txt", sourceData));
+
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create(options));
+
+    constexpr size_t numberOfBuffers = 16;
+    constexpr size_t buffersSize     = 4 * 1024;
+    AsyncBufferView  buffers[numberOfBuffers];
+    Buffer           buffer;
+    SC_TEST_EXPECT(buffer.resizeWithoutInitializing(buffersSize * numberOfBuffers));
+    SC_TEST_EXPECT(AsyncBuffersPool::sliceInEqualParts(buffers, buffer.toSpan(), numberOfBuffers));
+    AsyncBuffersPool pool;
+    pool.setBuffers(buffers);
+
+    String fileName;
+    SC_TEST_EXPECT(Path::join(fileName, {report.applicationRootDirectory.view(), "parallel.txt"}));
+    FileOpen openModeRead;
+    openModeRead.mode     = FileOpen::Read;
+    openModeRead.blocking = false;
+    FileDescriptor readFd;
+    SC_TEST_EXPECT(readFd.open(fileName.view(), openModeRead));
+    SC_TEST_EXPECT(eventLoop.associateExternallyCreatedFileDescriptor(readFd));
+
+    SC_TEST_EXPECT(Path::join(fileName, {report.applicationRootDirectory.view(), "parallel.gz"}));
+    FileOpen openModeWrite;
+    openModeWrite.mode     = FileOpen::Write;
+    openModeWrite.blocking = false;
+    FileDescriptor writeFd;
+    SC_TEST_EXPECT(writeFd.open(fileName.view(), openModeWrite));
+    SC_TEST_EXPECT(eventLoop.associateExternallyCreatedFileDescriptor(writeFd));
+
+    ReadableFileStream           readable;
+    AsyncReadableStream::Request readableRequests[numberOfBuffers + 1];
+    readable.setReadQueue(readableRequests);
+    SC_TEST_EXPECT(readable.init(pool, eventLoop, readFd));
+
+    WritableFileStream           writable;
+    AsyncWritableStream::Request writableRequests[numberOfBuffers + 1];
+    writable.setWriteQueue(writableRequests);
+    SC_TEST_EXPECT(writable.init(pool, eventLoop, writeFd));
+
+    //! [AsyncGZipParallelStreamSnippet]
+    constexpr size_t numberOfChunks = 4;
+    ThreadPool       threadPool;
+    SC_TEST_EXPECT(threadPool.create(numberOfChunks));
+
+    AsyncGZipParallelStream        gzip;
+    AsyncGZipParallelStream::Chunk gzipChunks[numberOfChunks];
+    AsyncReadableStream::Request   gzipReadRequests[numberOfBuffers + 1];
+    AsyncWritableStream::Request   gzipWriteRequests[numberOfBuffers + 1];
+    SC_TEST_EXPECT(gzip.init(pool, gzipReadRequests, gzipWriteRequests, gzipChunks));
+    SC_TEST_EXPECT(gzip.setThreadPool(threadPool));
+    gzip.setEventLoop(eventLoop);
+
+    AsyncPipeline pipeline = {&readable, {&gzip}, {&writable}};
+    //! [AsyncGZipParallelStreamSnippet]
+    (void)pipeline.eventError.addListener([this](Result res) { SC_TEST_EXPECT(res); });
+    SC_TEST_EXPECT(pipeline.pipe());
+    SC_TEST_EXPECT(pipeline.start());
+
+    // Safety timout against hangs
+    AsyncLoopTimeout timeout;
+    timeout.callback = [this](AsyncLoopTimeout::Result&)
+    { SC_TEST_EXPECT("Test never finished. Event Loop is stuck. Timeout expired." && false); };
+    SC_TEST_EXPECT(timeout.start(eventLoop, TimeMs{5000}));
+    eventLoop.excludeFromActiveCount(timeout);
+
+    SC_TEST_EXPECT(eventLoop.run());
+    SC_TEST_EXPECT(readFd.close());
+    SC_TEST_EXPECT(writeFd.close());
+    SC_TEST_EXPECT(gzip.getNumChunks() > numberOfChunks);
+
+    // Decompress the written file
+    Buffer compressed;
+    SC_TEST_EXPECT(fs.read("parallel.gz", compressed));
+    Buffer decompressed;
+    SC_TEST_EXPECT(decompressed.resizeWithoutInitializing(sourceData.sizeInBytes() + 1));
+
+    ZLibStream decompressor;
+    SC_TEST_EXPECT(decompressor.init(ZLibStream::DecompressGZip));
+    Span<const char> input  = compressed.toSpanConst();
+    Span<char>       output = decompressed.toSpan();
+    SC_TEST_EXPECT(decompressor.process(input, output));
+    SC_TEST_EXPECT(input.empty());
+    bool streamEnded = false;
+    SC_TEST_EXPECT(decompressor.finalize(output, streamEnded));
+    SC_TEST_EXPECT(streamEnded);
+    SC_TEST_EXPECT(decompressed.size() - output.sizeInBytes() == sourceData.sizeInBytes());
+    SC_TEST_EXPECT(::memcmp(decompressed.data(), sourceData.data(), sourceData.sizeInBytes()) == 0);
+
+    SC_TEST_EXPECT(fs.removeFiles({"parallel.txt", "parallel.gz"}));
+}
+
+void SC::AsyncRequestStreamsTest::zstdTransform()
+{
+    // This test:
+    // 1. Compresses a file with AsyncZStdTransformStream (skipping the test if libzstd is not available)
+    // 2. Decompresses the resulting file with a regular ZStdStream
+    // 3. Checks that decompressed data matches the source file
+    {
+        ZStdStream probe;
+        if (not probe.init(ZStdStream::Compress))
+        {
+            return;
+        }
+    }
+    Vector<uint64_t> source;
+    constexpr size_t numElements = 64 * 1024 / sizeof(uint64_t);
+    SC_TEST_EXPECT(source.resizeWithoutInitializing(numElements));
+    for (size_t idx = 0; idx < numElements; ++idx)
+    {
+        source[idx] = (idx * 2654435761u) % 4099; // Somewhat compressible data
+    }
+    const Span<const char> sourceData = source.toSpanConst().reinterpret_as_span_of<const char>();
+
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(report.applicationRootDirectory.view()));
+    SC_TEST_EXPECT(fs.write("codec.txt", sourceData));
+
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create(options));
+
+    constexpr size_t numberOfBuffers = 8;
+    constexpr size_t buffersSize     = 4 * 1024;
+    AsyncBufferView  buffers[numberOfBuffers];
+    Buffer           buffer;
+    SC_TEST_EXPECT(buffer.resizeWithoutInitializing(buffersSize * numberOfBuffers));
+    SC_TEST_EXPECT(AsyncBuffersPool::sliceInEqualParts(buffers, buffer.toSpan(), numberOfBuffers));
+    AsyncBuffersPool pool;
+    pool.setBuffers(buffers);
+
+    String fileName;
+    SC_TEST_EXPECT(Path::join(fileName, {report.applicationRootDirectory.view(), "codec.txt"}));
+    FileOpen openModeRead;
+    openModeRead.mode     = FileOpen::Read;
+    openModeRead.blocking = false;
+    FileDescriptor readFd;
+    SC_TEST_EXPECT(readFd.open(fileName.view(), openModeRead));
+    SC_TEST_EXPECT(eventLoop.associateExternallyCreatedFileDescriptor(readFd));
+
+    SC_TEST_EXPECT(Path::join(fileName, {report.applicationRootDirectory.view(), "codec.zst"}));
+    FileOpen openModeWrite;
+    openModeWrite.mode     = FileOpen::Write;
+    openModeWrite.blocking = false;
+    FileDescriptor writeFd;
+    SC_TEST_EXPECT(writeFd.open(fileName.view(), openModeWrite));
+    SC_TEST_EXPECT(eventLoop.associateExternallyCreatedFileDescriptor(writeFd));
+
+    ReadableFileStream           readable;
+    AsyncReadableStream::Request readableRequests[numberOfBuffers + 1];
+    readable.setReadQueue(readableRequests);
+    SC_TEST_EXPECT(readable.init(pool, eventLoop, readFd));
+
+    WritableFileStream           writable;
+    AsyncWritableStream::Request writableRequests[numberOfBuffers + 1];
+    writable.setWriteQueue(writableRequests);
+    SC_TEST_EXPECT(writable.init(pool, eventLoop, writeFd));
+
+    //! [AsyncCodecTransformStreamSnippet]
+    ThreadPool threadPool;
+    SC_TEST_EXPECT(threadPool.create(1));
+
+    AsyncZStdTransformStream     zstd;
+    AsyncReadableStream::Request zstdReadRequests[numberOfBuffers + 1];
+    AsyncWritableStream::Request zstdWriteRequests[numberOfBuffers + 1];
+    SC_TEST_EXPECT(zstd.init(pool, zstdReadRequests, zstdWriteRequests));
+    SC_TEST_EXPECT(zstd.stream.init(ZStdStream::Compress));
+    SC_TEST_EXPECT(zstd.asyncWork.setThreadPool(threadPool));
+    zstd.setEventLoop(eventLoop);
+
+    AsyncPipeline pipeline = {&readable, {&zstd}, {&writable}};
+    //! [AsyncCodecTransformStreamSnippet]
+    (void)pipeline.eventError.addListener([this](Result res) { SC_TEST_EXPECT(res); });
+    SC_TEST_EXPECT(pipeline.pipe());
+    SC_TEST_EXPECT(pipeline.start());
+
+    // Safety timout against hangs
+    AsyncLoopTimeout timeout;
+    timeout.callback = [this](AsyncLoopTimeout::Result&)
+    { SC_TEST_EXPECT("Test never finished. Event Loop is stuck. Timeout expired." && false); };
+    SC_TEST_EXPECT(timeout.start(eventLoop, TimeMs{5000}));
+    eventLoop.excludeFromActiveCount(timeout);
+
+    SC_TEST_EXPECT(eventLoop.run());
+    SC_TEST_EXPECT(readFd.close());
+    SC_TEST_EXPECT(writeFd.close());
+
+    // Decompress the written file
+    Buffer compressed;
+    SC_TEST_EXPECT(fs.read("codec.zst", compressed));
+    SC_TEST_EXPECT(compressed.size() < sourceData.sizeInBytes());
+    Buffer decompressed;
+    SC_TEST_EXPECT(decompressed.resizeWithoutInitializing(sourceData.sizeInBytes() + 1));
+
+    ZStdStream decompressor;
+    SC_TEST_EXPECT(decompressor.init(ZStdStream::Decompress));
+    Span<const char> input  = compressed.toSpanConst();
+    Span<char>       output = decompressed.toSpan();
+    SC_TEST_EXPECT(decompressor.process(input, output));
+    SC_TEST_EXPECT(input.empty());
+    bool streamEnded = false;
+    SC_TEST_EXPECT(decompressor.finalize(output, streamEnded));
+    SC_TEST_EXPECT(streamEnded);
+    SC_TEST_EXPECT(decompressed.size() - output.sizeInBytes() == sourceData.sizeInBytes());
+    SC_TEST_EXPECT(::memcmp(decompressed.data(), sourceData.data(), sourceData.sizeInBytes()) == 0);
+
+    SC_TEST_EXPECT(fs.removeFiles({"codec.txt", "codec.zst"}));
+}
+
 namespace SC
 {
 void runAsyncRequestStreamTest(SC::TestReport& report) { AsyncRequestStreamsTest test(report); }
@@ -54,6 +54,10 @@ struct SC::AsyncStreamsTest : public SC::TestCase
         {
             createChildView();
         }
+        if (test_section("buffers pool size classes"))
+        {
+            buffersPoolSizeClasses();
+        }
         if (test_section("unshift"))
         {
             unshift();
@@ -74,6 +78,7 @@ struct SC::AsyncStreamsTest : public SC::TestCase
     void readableAsyncStream();
     void writableStream();
     void createChildView();
+    void buffersPoolSizeClasses();
     void unshift();
     void pipelineBackpressureSyncSource();
     void pipelineBackpressureAsyncSource();
@@ -481,6 +486,85 @@ void SC::AsyncStreamsTest::createChildView()
     SC_TEST_EXPECT(pool.getBuffer(parentID) != nullptr);
 }
 
+void SC::AsyncStreamsTest::buffersPoolSizeClasses()
+{
+    // Two small (16 bytes), one medium (40 bytes) and one large (200 bytes) buffer, plus two empty slots
+    char            memory[16 + 16 + 40 + 200];
+    AsyncBufferView buffers[6];
+    buffers[0] = Span<char>(memory, 16);
+    buffers[1] = Span<char>(memory + 16, 16);
+    buffers[2] = Span<char>(memory + 32, 40);
+    buffers[3] = Span<char>(memory + 72, 200);
+    for (size_t idx = 0; idx < 4; ++idx)
+    {
+        buffers[idx].setReusable(true);
+    }
+    AsyncBuffersPool pool;
+    pool.setBuffers(buffers);
+
+    AsyncBuffersPool::Statistics stats = pool.getStatistics();
+    SC_TEST_EXPECT(stats.numBuffers == 6);
+    SC_TEST_EXPECT(stats.numEmpty == 2);
+    SC_TEST_EXPECT(stats.numFree == 4);
+    SC_TEST_EXPECT(stats.numInUse == 0);
+    SC_TEST_EXPECT(stats.freeBytes == sizeof(memory));
+
+    // A request is served by the smallest size class holding a large enough buffer
+    AsyncBufferView::ID id1, id2, id3;
+    Span<char>          data;
+    SC_TEST_EXPECT(pool.requestNewBuffer(10, id1, data));
+    SC_TEST_EXPECT(id1.identifier == 0 and data.sizeInBytes() == 16);
+    SC_TEST_EXPECT(pool.requestNewBuffer(33, id2, data));
+    SC_TEST_EXPECT(id2.identifier == 2 and data.sizeInBytes() == 40);
+    SC_TEST_EXPECT(pool.requestNewBuffer(41, id3, data));
+    SC_TEST_EXPECT(id3.identifier == 3 and data.sizeInBytes() == 200);
+    SC_TEST_EXPECT(not pool.requestNewBuffer(17, id3, data)); // Only a 16 bytes buffer is left
+
+    stats = pool.getStatistics();
+    SC_TEST_EXPECT(stats.numFree == 1 and stats.numInUse == 3 and stats.peakInUse == 3);
+    SC_TEST_EXPECT(stats.freeBytes == 16 and stats.failedRequests == 1);
+
+    // Released buffers are reused first (the other 16 bytes buffer has never been used)
+    pool.unrefBuffer(id1);
+    SC_TEST_EXPECT(pool.requestNewBuffer(1, id1, data));
+    SC_TEST_EXPECT(id1.identifier == 0);
+
+    // Pushed buffers and child views take empty slots, returning them when released
+    AsyncBufferView::ID pushedID, childID;
+    SC_TEST_EXPECT(pool.pushBuffer(AsyncBufferView("pushed"), pushedID));
+    SC_TEST_EXPECT(pool.createChildView(id2, 0, 8, childID));
+    SC_TEST_EXPECT(pool.getStatistics().numEmpty == 0);
+    SC_TEST_EXPECT(not pool.createChildView(id2, 0, 8, id3));
+    pool.refBuffer(pushedID);
+    pool.unrefBuffer(pushedID);
+    pool.unrefBuffer(childID);
+    pool.unrefBuffer(id1);
+    pool.unrefBuffer(id2);
+
+    stats = pool.getStatistics();
+    SC_TEST_EXPECT(stats.numEmpty == 2 and stats.numFree == 3 and stats.numInUse == 1 and stats.peakInUse == 5);
+
+    // Unreferenced growable buffers are handed out too, sized by their current storage
+    AsyncBufferView  growableBuffers[1];
+    AsyncBuffersPool growablePool;
+    growablePool.setBuffers(growableBuffers);
+
+    Buffer growable;
+    SC_TEST_EXPECT(growable.resizeWithoutInitializing(64));
+    AsyncBufferView growableView(move(growable));
+    growableView.setReusable(true);
+    AsyncBufferView::ID growableID;
+    SC_TEST_EXPECT(growablePool.pushBuffer(move(growableView), growableID));
+    SC_TEST_EXPECT(growablePool.getStatistics().numFree == 1);
+    SC_TEST_EXPECT(growablePool.getStatistics().freeBytes == 64);
+    SC_TEST_EXPECT(growablePool.requestNewBuffer(50, growableID, data));
+    SC_TEST_EXPECT(growableID.identifier == 0 and data.sizeInBytes() == 64);
+    growablePool.unrefBuffer(growableID);
+    SC_TEST_EXPECT(growablePool.requestNewBuffer(10, growableID, data));
+    SC_TEST_EXPECT(data.sizeInBytes() == 64);
+    SC_TEST_EXPECT(not growablePool.requestNewBuffer(1, growableID, data));
+}
+
 void SC::AsyncStreamsTest::unshift()
 {
     AsyncBufferView::ID bufferID;
@@ -0,0 +1,144 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "Libraries/AsyncStreams/Internal/CodecStreams.h"
+#include "Libraries/Common/CompilerMinMax.h"
+#include "Libraries/Testing/Testing.h"
+#include <memory.h> // memcmp
+
+namespace SC
+{
+struct CodecStreamsTest;
+}
+
+struct SC::CodecStreamsTest : public SC::TestCase
+{
+    CodecStreamsTest(SC::TestReport& report) : TestCase(report, "CodecStreamsTest")
+    {
+        if (test_section("zstd"))
+        {
+            ZStdStream probe;
+            if (probe.init(ZStdStream::Compress))
+            {
+                roundTrip<ZStdStream>(ZStdStream::DefaultLevel);
+                roundTrip<ZStdStream>(19);
+                truncatedInput<ZStdStream>();
+            }
+        }
+        if (test_section("lz4"))
+        {
+            LZ4Stream probe;
+            if (probe.init(LZ4Stream::Compress))
+            {
+                roundTrip<LZ4Stream>(LZ4Stream::DefaultLevel);
+                roundTrip<LZ4Stream>(9);
+                truncatedInput<LZ4Stream>();
+            }
+        }
+        if (test_section("brotli"))
+        {
+            BrotliStream probe;
+            if (probe.init(BrotliStream::Compress))
+            {
+                roundTrip<BrotliStream>(BrotliStream::DefaultLevel);
+                roundTrip<BrotliStream>(11);
+                truncatedInput<BrotliStream>();
+            }
+        }
+    }
+
+    static constexpr size_t InputSize = 8 * 1024;
+
+    char original[InputSize];
+    char compressed[InputSize * 2];
+    char decompressed[InputSize];
+
+    size_t compressedSize   = 0;
+    size_t decompressedSize = 0;
+
+    void fillOriginal()
+    {
+        // Repetitive but not constant data, to give the codec something to compress
+        for (size_t idx = 0; idx < InputSize; ++idx)
+        {
+            original[idx] = static_cast<char>('a' + (idx * 7 + idx / 64) % 23);
+        }
+    }
+
+    // Transforms input feeding it in chunks of inputStep bytes into output windows of at most outputStep bytes
+    template <typename T_Codec>
+    bool transform(T_Codec& codec, Span<const char> input, Span<char> destination, size_t& destinationSize,
+                   size_t inputStep, size_t outputStep)
+    {
+        destinationSize = 0;
+        while (not input.empty())
+        {
+            Span<const char> inputWindow;
+            Span<char>       outputWindow;
+            SC_TEST_EXPECT(input.sliceStartLength(0, min(inputStep, input.sizeInBytes()), inputWindow));
+            const size_t outputSize = min(outputStep, destination.sizeInBytes() - destinationSize);
+            SC_TEST_EXPECT(destination.sliceStartLength(destinationSize, outputSize, outputWindow));
+            const size_t inputBefore = inputWindow.sizeInBytes();
+            if (not codec.process(inputWindow, outputWindow))
+            {
+                return false;
+            }
+            destinationSize += outputSize - outputWindow.sizeInBytes();
+            SC_TEST_EXPECT(input.sliceStart(inputBefore - inputWindow.sizeInBytes(), input));
+        }
+        bool streamEnded = false;
+        while (not streamEnded)
+        {
+            Span<char>   outputWindow;
+            const size_t outputSize = min(outputStep, destination.sizeInBytes() - destinationSize);
+            SC_TEST_EXPECT(destination.sliceStartLength(destinationSize, outputSize, outputWindow));
+            if (not codec.finalize(outputWindow, streamEnded))
+            {
+                return false;
+            }
+            destinationSize += outputSize - outputWindow.sizeInBytes();
+        }
+        return true;
+    }
+
+    template <typename T_Codec>
+    void roundTrip(int level)
+    {
+        fillOriginal();
+        T_Codec compressor;
+        SC_TEST_EXPECT(compressor.init(T_Codec::Compress, level));
+        SC_TEST_EXPECT(transform(compressor, original, compressed, compressedSize, 1000, 256));
+        SC_TEST_EXPECT(compressedSize > 0 and compressedSize < InputSize / 2);
+
+        T_Codec decompressor;
+        SC_TEST_EXPECT(decompressor.init(T_Codec::Decompress));
+        Span<const char> compressedData = {compressed, compressedSize};
+        SC_TEST_EXPECT(transform(decompressor, compressedData, decompressed, decompressedSize, 100, 333));
+        SC_TEST_EXPECT(decompressedSize == InputSize);
+        SC_TEST_EXPECT(memcmp(original, decompressed, InputSize) == 0);
+
+        // Streams can be reused after reset
+        decompressor.reset();
+        SC_TEST_EXPECT(decompressor.init(T_Codec::Decompress));
+        SC_TEST_EXPECT(transform(decompressor, compressedData, decompressed, decompressedSize, InputSize, InputSize));
+        SC_TEST_EXPECT(decompressedSize == InputSize);
+    }
+
+    template <typename T_Codec>
+    void truncatedInput()
+    {
+        fillOriginal();
+        T_Codec compressor;
+        SC_TEST_EXPECT(compressor.init(T_Codec::Compress));
+        SC_TEST_EXPECT(transform(compressor, original, compressed, compressedSize, InputSize, sizeof(compressed)));
+
+        T_Codec decompressor;
+        SC_TEST_EXPECT(decompressor.init(T_Codec::Decompress));
+        Span<const char> truncated = {compressed, compressedSize / 2};
+        SC_TEST_EXPECT(not transform(decompressor, truncated, decompressed, decompressedSize, InputSize, InputSize));
+    }
+};
+
+namespace SC
+{
+void runCodecStreamsTest(SC::TestReport& report) { CodecStreamsTest test(report); }
+} // namespace SC
@@ -67,10 +67,25 @@ struct SC::ZLibStreamTest : public SC::TestCase
             syncDecompression(ZLibStream::DecompressZLib, "test"_a8, testCompressedZLIB);
             syncCompression(ZLibStream::CompressZLib, "test"_a8, testCompressedZLIB);
         }
+        if (test_section("reset"))
+        {
+            streamReset();
+        }
+        if (test_section("partial"))
+        {
+            partialDecompression();
+        }
+        if (test_section("crc32"))
+        {
+            crc32();
+        }
     }
 
     void syncCompression(ZLibStream::Algorithm compressionAlgorithm, const StringView inputString,
                          const Span<const uint8_t> compressedReference);
+    void streamReset();
+    void partialDecompression();
+    void crc32();
     void syncDecompression(ZLibStream::Algorithm compressionAlgorithm, const StringView referenceString,
                            const Span<const uint8_t> compressedReference);
 
@@ -134,6 +149,92 @@ void SC::ZLibStreamTest::syncCompression(ZLibStream::Algorithm compressionAlgori
     SC_TEST_EXPECT(memcmpSpans(compressedReference, output));
 }
 
+void SC::ZLibStreamTest::streamReset()
+{
+    // The same ZLibStream compresses and then (after reset) decompresses its own output
+    ZLibStream stream;
+    SC_TEST_EXPECT(stream.init(ZLibStream::CompressGZip));
+    SC_TEST_EXPECT(not stream.init(ZLibStream::CompressGZip));
+
+    char             compressedData[64];
+    Span<const char> input       = "test"_a8.toCharSpan();
+    Span<char>       destination = compressedData;
+    bool             streamEnded = false;
+    SC_TEST_EXPECT(stream.process(input, destination));
+    SC_TEST_EXPECT(stream.finalize(destination, streamEnded));
+    SC_TEST_EXPECT(streamEnded);
+    Span<char> compressed;
+    SC_TEST_EXPECT(detail::sliceFromStartUntil(Span<char>(compressedData), destination, compressed));
+
+    stream.reset();
+    SC_TEST_EXPECT(stream.init(ZLibStream::DecompressGZip));
+
+    char             decompressedData[16];
+    Span<const char> compressedInput = compressed;
+    destination                      = decompressedData;
+    streamEnded                      = false;
+    SC_TEST_EXPECT(stream.process(compressedInput, destination));
+    SC_TEST_EXPECT(stream.finalize(destination, streamEnded));
+    SC_TEST_EXPECT(streamEnded);
+    Span<char> decompressed;
+    SC_TEST_EXPECT(detail::sliceFromStartUntil(Span<char>(decompressedData), destination, decompressed));
+    SC_TEST_EXPECT(memcmpSpans(decompressed, "test"_a8.toCharSpan()));
+
+    stream.reset();
+    stream.reset(); // Resetting an already reset stream does nothing
+}
+
+void SC::ZLibStreamTest::partialDecompression()
+{
+    // "test" compressed with deflate, fed in two chunks with an empty one in the middle
+    static constexpr uint8_t testCompressedDEFLATE[] = {0x2B, 0x49, 0x2D, 0x2E, 0x01, 0x00};
+    const char*              compressed = reinterpret_cast<const char*>(testCompressedDEFLATE);
+
+    ZLibStream decompressor;
+    SC_TEST_EXPECT(decompressor.init(ZLibStream::DecompressDeflate));
+    char       writableBufferData[16];
+    Span<char> destination = writableBufferData;
+
+    Span<const char> input = {compressed, 3};
+    SC_TEST_EXPECT(decompressor.processPartial(input, destination));
+    SC_TEST_EXPECT(input.empty());
+
+    // No progress is possible without more input: process fails while processPartial waits for it
+    Span<const char> noInput;
+    SC_TEST_EXPECT(not decompressor.process(noInput, destination));
+    SC_TEST_EXPECT(decompressor.processPartial(noInput, destination));
+
+    input = {compressed + 3, sizeof(testCompressedDEFLATE) - 3};
+    SC_TEST_EXPECT(decompressor.processPartial(input, destination));
+    SC_TEST_EXPECT(input.empty());
+    Span<char> output;
+    SC_TEST_EXPECT(detail::sliceFromStartUntil(Span<char>(writableBufferData), destination, output));
+    SC_TEST_EXPECT(memcmpSpans(output, "test"_a8.toCharSpan()));
+
+    ZLibStream compressor;
+    SC_TEST_EXPECT(compressor.init(ZLibStream::CompressDeflate));
+    destination = writableBufferData;
+    input       = {compressed, 3};
+    SC_TEST_EXPECT(not compressor.processPartial(input, destination)); // Decompression only
+}
+
+void SC::ZLibStreamTest::crc32()
+{
+    const Span<const char> data = "123456789"_a8.toCharSpan();
+    SC_TEST_EXPECT(ZLibStream::updateCRC32(0, data) == 0xcbf43926); // CRC-32 check value
+    SC_TEST_EXPECT(ZLibStream::updateCRC32(0, {}) == 0);
+    for (size_t split = 0; split <= data.sizeInBytes(); ++split)
+    {
+        Span<const char> first, second;
+        SC_TEST_EXPECT(data.sliceStartLength(0, split, first));
+        SC_TEST_EXPECT(data.sliceStart(split, second));
+        const uint32_t crc1 = ZLibStream::updateCRC32(0, first);
+        const uint32_t crc2 = ZLibStream::updateCRC32(0, second);
+        SC_TEST_EXPECT(ZLibStream::updateCRC32(crc1, second) == 0xcbf43926);
+        SC_TEST_EXPECT(ZLibStream::combineCRC32(crc1, crc2, second.sizeInBytes()) == 0xcbf43926);
+    }
+}
+
 void SC::ZLibStreamTest::syncDecompression(ZLibStream::Algorithm algorithm, const StringView referenceString,
                                            const Span<const uint8_t> compressedReference)
 {
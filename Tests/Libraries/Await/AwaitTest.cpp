@@ -563,6 +563,50 @@ struct SC::AwaitTest : public SC::TestCase
         co_return Result(true);
     }
 
+    static AwaitTask batchedDatagramsOnce(AwaitEventLoop& await, const SocketDescriptor& sender,
+                                          const SocketDescriptor& receiver, SocketIPAddress receiverAddress)
+    {
+        AsyncSocketSendDatagram sendDatagrams[3];
+        sendDatagrams[0].data = StringSpan("one").toCharSpan();
+        sendDatagrams[1].data = StringSpan("two").toCharSpan();
+        sendDatagrams[2].data = StringSpan("three").toCharSpan();
+        for (AsyncSocketSendDatagram& datagram : sendDatagrams)
+        {
+            datagram.address = receiverAddress;
+        }
+
+        AwaitSocketSendResult sendResult;
+        SC_CO_TRY(co_await await.sendTo(sender, sendDatagrams, &sendResult));
+        if (sendResult.numBytes != 11)
+        {
+            co_return Result::Error("UDP batched send byte count mismatch");
+        }
+
+        char                       receiveBuffers[3][16] = {};
+        AsyncSocketReceiveDatagram receiveDatagrams[3];
+        for (size_t idx = 0; idx < 3; ++idx)
+        {
+            receiveDatagrams[idx].buffer = receiveBuffers[idx];
+        }
+        size_t numReceived = 0;
+        while (numReceived < 3)
+        {
+            AwaitSocketReceiveFromResult receiveResult;
+            Span<AsyncSocketReceiveDatagram> pending = {receiveDatagrams + numReceived, 3 - numReceived};
+            SC_CO_TRY(co_await await.receiveFrom(receiver, pending, receiveResult));
+            for (const AsyncSocketReceiveDatagram& datagram : receiveResult.datagrams)
+            {
+                if (StringView(datagram.data(), false, StringEncoding::Ascii) !=
+                    StringView(sendDatagrams[numReceived].data, false, StringEncoding::Ascii))
+                {
+                    co_return Result::Error("UDP batched receive data mismatch");
+                }
+                numReceived++;
+            }
+        }
+        co_return Result(true);
+    }
+
     static AwaitTask receiveForever(AwaitEventLoop& await, const SocketDescriptor& receiver)
     {
         char                     receiveBuffer[16] = {};
@@ -2664,6 +2708,31 @@ struct SC::AwaitTest : public SC::TestCase
             SC_TEST_EXPECT(sender.close());
             SC_TEST_EXPECT(async.close());
         }
+#if not SC_PLATFORM_WINDOWS
+        {
+            AsyncEventLoop async;
+            SC_TEST_EXPECT(async.create());
+            SC_AWAIT_TEST_EVENT_LOOP(await, async);
+
+            SocketIPAddress receiverAddress;
+            SC_TEST_EXPECT(receiverAddress.fromAddressPort("127.0.0.1", report.mapPort(5056)));
+
+            SocketDescriptor receiver;
+            SocketDescriptor sender;
+            SC_TEST_EXPECT(async.createAsyncUDPSocket(receiverAddress.getAddressFamily(), receiver));
+            SC_TEST_EXPECT(async.createAsyncUDPSocket(receiverAddress.getAddressFamily(), sender));
+            SC_TEST_EXPECT(SocketServer(receiver).bind(receiverAddress));
+
+            AwaitTask task = batchedDatagramsOnce(await, sender, receiver, receiverAddress);
+            SC_TEST_EXPECT(await.spawn(task));
+            SC_TEST_EXPECT(await.run());
+            SC_TEST_EXPECT(task.result());
+
+            SC_TEST_EXPECT(receiver.close());
+            SC_TEST_EXPECT(sender.close());
+            SC_TEST_EXPECT(async.close());
+        }
+#endif
         {
             AsyncEventLoop async;
             SC_TEST_EXPECT(async.create());
@@ -0,0 +1,277 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "Libraries/Http/HttpAsyncClientPool.h"
+#include "HttpStringAppend.h"
+#include "Libraries/Common/Assert.h"
+#include "Libraries/Http/HttpAsyncServer.h"
+#include "Libraries/Memory/Buffer.h"
+#include "Libraries/Memory/String.h"
+#include "Libraries/Strings/StringBuilder.h"
+#include "Libraries/Strings/StringView.h"
+#include "Libraries/Testing/Testing.h"
+
+namespace SC
+{
+struct HttpAsyncClientPoolTest;
+}
+
+namespace
+{
+using ServerConnection = SC::HttpAsyncConnection<3, 3, 8 * 1024, 8 * 1024>;
+using ClientConnection = SC::HttpAsyncClientConnection<4, 6, 8 * 1024, 8 * 1024>;
+
+struct TimeoutGuard
+{
+    SC::AsyncLoopTimeout timeout;
+
+    SC::Result start(SC::AsyncEventLoop& loop, SC::TimeMs duration)
+    {
+        timeout.callback = [](SC::AsyncLoopTimeout::Result&)
+        { SC_ASSERT_RELEASE("Test never finished. Event loop timeout expired." && false); };
+        SC_TRY(timeout.start(loop, duration));
+        loop.excludeFromActiveCount(timeout);
+        return SC::Result(true);
+    }
+};
+
+// Collects the body of the response of a given client and releases it to the pool once the response ends
+struct PooledResponse
+{
+    SC::HttpAsyncClientPool* pool     = nullptr;
+    SC::HttpAsyncClient*     client   = nullptr;
+    SC::AsyncReadableStream* readable = nullptr;
+
+    SC::Buffer buffer;
+
+    SC::Function<void(SC::StringSpan)> onBody;
+
+    void start(SC::HttpAsyncClientPool& newPool, SC::HttpAsyncClient& newClient)
+    {
+        pool   = &newPool;
+        client = &newClient;
+        buffer = {};
+
+        client->onResponse = [this](SC::HttpAsyncClientResponse& response)
+        {
+            readable = &response.getReadableStream();
+            SC_ASSERT_RELEASE((readable->eventData.addListener<PooledResponse, &PooledResponse::onData>(*this)));
+            SC_ASSERT_RELEASE((readable->eventEnd.addListener<PooledResponse, &PooledResponse::onEnd>(*this)));
+        };
+        client->onError = [](SC::Result result) { SC_ASSERT_RELEASE(result); };
+    }
+
+    void onData(SC::AsyncBufferView::ID bufferID)
+    {
+        SC::Span<const char> data;
+        SC_ASSERT_RELEASE(readable->getBuffersPool().getReadableData(bufferID, data));
+        SC::GrowableBuffer<SC::Buffer> gb(buffer);
+
+        SC::HttpStringAppend& sb = static_cast<SC::HttpStringAppend&>(static_cast<SC::IGrowableBuffer&>(gb));
+        SC_ASSERT_RELEASE(sb.append(data, 0));
+    }
+
+    void onEnd()
+    {
+        SC_ASSERT_RELEASE((readable->eventData.removeListener<PooledResponse, &PooledResponse::onData>(*this)));
+        SC_ASSERT_RELEASE((readable->eventEnd.removeListener<PooledResponse, &PooledResponse::onEnd>(*this)));
+        readable = nullptr;
+        SC_ASSERT_RELEASE(pool->release(*client));
+        onBody({buffer.toSpanConst(), false, SC::StringEncoding::Ascii});
+    }
+};
+
+void respondHello(SC::HttpConnection& connection)
+{
+    SC_ASSERT_RELEASE(connection.response.startResponse(200));
+    SC_ASSERT_RELEASE(connection.response.addHeader("Content-Length", "5"));
+    SC_ASSERT_RELEASE(connection.response.sendHeaders());
+    SC_ASSERT_RELEASE(connection.response.getWritableStream().write("hello"));
+    SC_ASSERT_RELEASE(connection.response.end());
+}
+} // namespace
+
+struct SC::HttpAsyncClientPoolTest : public SC::TestCase
+{
+    HttpAsyncClientPoolTest(SC::TestReport& report) : TestCase(report, "HttpAsyncClientPoolTest")
+    {
+        if (test_section("reuse and queueing"))
+        {
+            reuseAndQueueing();
+        }
+        if (test_section("health check and idle eviction"))
+        {
+            healthCheckAndIdleEviction();
+        }
+    }
+
+    void reuseAndQueueing();
+    void healthCheckAndIdleEviction();
+};
+
+void SC::HttpAsyncClientPoolTest::reuseAndQueueing()
+{
+    AsyncEventLoop loop;
+    SC_TEST_EXPECT(loop.create());
+
+    ServerConnection serverConnections[4];
+    HttpAsyncServer  httpServer;
+    const uint16_t   port = report.mapPort(26130);
+    SC_TEST_EXPECT(httpServer.init(Span<ServerConnection>(serverConnections)));
+    SC_TEST_EXPECT(httpServer.start(loop, "127.0.0.1", port));
+    httpServer.onRequest = [](HttpConnection& connection) { respondHello(connection); };
+
+    TimeoutGuard timeout;
+    SC_TEST_EXPECT(timeout.start(loop, TimeMs{3000}));
+
+    String url = StringEncoding::Ascii;
+    SC_TEST_EXPECT(StringBuilder::format(url, "http://127.0.0.1:{}/pooled", port));
+
+    ClientConnection            connections[2];
+    HttpAsyncClientPool::Slot   slots[2];
+    HttpAsyncClientPool::Waiter waiters[2];
+
+    HttpAsyncClientPool pool;
+    struct Context
+    {
+        HttpAsyncClientPool& pool;
+        HttpAsyncServer&     httpServer;
+        AsyncEventLoop&      loop;
+        String&              url;
+
+        PooledResponse responses[2];
+        int            completions = 0;
+    } ctx = {pool, httpServer, loop, url};
+
+    //! [HttpAsyncClientPoolSnippet]
+    HttpAsyncClientPool::Options options;
+    options.maxConnectionsPerHost = 1; // Force all requests to share the same connection
+    SC_TEST_EXPECT(pool.init(loop, Span<HttpAsyncClientPool::Slot>(slots), Span<ClientConnection>(connections),
+                             Span<HttpAsyncClientPool::Waiter>(waiters), options));
+
+    auto sendRequest = [this, &ctx](HttpAsyncClient& client)
+    {
+        // Client is owned exclusively until it's released to the pool (done by PooledResponse at end of response)
+        PooledResponse& response = ctx.responses[ctx.responses[0].client == &client ? 0 : 1];
+        response.start(ctx.pool, client);
+        response.onBody = [this, &ctx](StringSpan body)
+        {
+            SC_TEST_EXPECT(StringView(body) == "hello");
+            if (++ctx.completions == 3)
+            {
+                const HttpAsyncClientPool::Statistics stats = ctx.pool.getStatistics();
+                SC_TEST_EXPECT(stats.numNew == 1 and stats.numReused == 2 and stats.numHealthFailed == 0);
+                SC_TEST_EXPECT(stats.numBusy == 0 and stats.numIdle == 1 and stats.numQueued == 0);
+                SC_TEST_EXPECT(ctx.httpServer.stop());
+            }
+        };
+        SC_TEST_EXPECT(client.get(ctx.loop, ctx.url.view(), true)); // keep-alive is needed to reuse connections
+    };
+    SC_TEST_EXPECT(pool.acquire(url.view(), sendRequest)); // Invoked immediately
+    SC_TEST_EXPECT(pool.acquire(url.view(), sendRequest)); // Queued until first request releases its client
+    SC_TEST_EXPECT(pool.acquire(url.view(), sendRequest)); // Queued
+    //! [HttpAsyncClientPoolSnippet]
+
+    SC_TEST_EXPECT(pool.getStatistics().numBusy == 1 and pool.getStatistics().numQueued == 2);
+    SC_TEST_EXPECT(not pool.acquire(url.view(), sendRequest)); // No waiters left
+
+    SC_TEST_EXPECT(loop.run());
+    SC_TEST_EXPECT(ctx.completions == 3);
+    SC_TEST_EXPECT(pool.close());
+    SC_TEST_EXPECT(httpServer.close());
+    SC_TEST_EXPECT(loop.close());
+}
+
+void SC::HttpAsyncClientPoolTest::healthCheckAndIdleEviction()
+{
+    AsyncEventLoop loop;
+    SC_TEST_EXPECT(loop.create());
+
+    // Server closes connections after each response, even if it advertises keep-alive
+    ServerConnection serverConnections[4];
+    HttpAsyncServer  httpServer;
+    const uint16_t   port = report.mapPort(26131);
+    SC_TEST_EXPECT(httpServer.init(Span<ServerConnection>(serverConnections)));
+    SC_TEST_EXPECT(httpServer.start(loop, "127.0.0.1", port));
+    httpServer.setMaxRequestsPerConnection(1);
+    httpServer.onRequest = [](HttpConnection& connection) { respondHello(connection); };
+
+    TimeoutGuard timeout;
+    SC_TEST_EXPECT(timeout.start(loop, TimeMs{3000}));
+
+    String url = StringEncoding::Ascii;
+    SC_TEST_EXPECT(StringBuilder::format(url, "http://127.0.0.1:{}/health", port));
+
+    ClientConnection          connections[1];
+    HttpAsyncClientPool::Slot slots[1];
+
+    HttpAsyncClientPool::Options options;
+    options.idleTimeout = TimeMs{100};
+
+    HttpAsyncClientPool pool;
+    SC_TEST_EXPECT(pool.init(loop, Span<HttpAsyncClientPool::Slot>(slots), Span<ClientConnection>(connections), {},
+                             options));
+
+    struct Context
+    {
+        HttpAsyncClientPool&     pool;
+        HttpAsyncServer&         httpServer;
+        AsyncEventLoop&          loop;
+        String&                  url;
+
+        PooledResponse   response;
+        AsyncLoopTimeout deferredStep;
+        int              completions = 0;
+
+        void sendRequest(HttpAsyncClient& client)
+        {
+            response.start(pool, client);
+            response.onBody.bind<Context, &Context::onBody>(*this);
+            SC_ASSERT_RELEASE(client.get(loop, url.view(), true));
+        }
+
+        void onBody(StringSpan body)
+        {
+            SC_ASSERT_RELEASE(StringView(body) == "hello");
+            completions++;
+            // Give time to the server to close the connection (first step) or to the pool to evict it (second step)
+            deferredStep.callback.bind<Context, &Context::onDeferred>(*this);
+            SC_ASSERT_RELEASE(deferredStep.start(loop, TimeMs{completions == 1 ? 50 : 300}));
+        }
+
+        void onDeferred(AsyncLoopTimeout::Result&)
+        {
+            const HttpAsyncClientPool::Statistics stats = pool.getStatistics();
+            if (completions == 1)
+            {
+                SC_ASSERT_RELEASE(stats.numIdle == 1);
+                HttpAsyncClientPool::AcquireCallback callback;
+                callback.bind<Context, &Context::sendRequest>(*this);
+                SC_ASSERT_RELEASE(pool.acquire(url.view(), move(callback)));
+                // Connection closed by the server has been detected and replaced
+                SC_ASSERT_RELEASE(pool.getStatistics().numHealthFailed == 1);
+                SC_ASSERT_RELEASE(pool.getStatistics().numNew == 2);
+            }
+            else
+            {
+                SC_ASSERT_RELEASE(stats.numReused == 0);
+                SC_ASSERT_RELEASE(stats.numEvicted == 1 and stats.numIdle == 0);
+                SC_ASSERT_RELEASE(httpServer.stop());
+            }
+        }
+    } ctx = {pool, httpServer, loop, url};
+
+    HttpAsyncClientPool::AcquireCallback callback;
+    callback.bind<Context, &Context::sendRequest>(ctx);
+    SC_TEST_EXPECT(pool.acquire(url.view(), move(callback)));
+
+    SC_TEST_EXPECT(loop.run());
+    SC_TEST_EXPECT(ctx.completions == 2);
+    SC_TEST_EXPECT(pool.close());
+    SC_TEST_EXPECT(httpServer.close());
+    SC_TEST_EXPECT(loop.close());
+}
+
+namespace SC
+{
+void runHttpAsyncClientPoolTest(SC::TestReport& report) { HttpAsyncClientPoolTest test(report); }
+} // namespace SC
@@ -304,11 +304,16 @@ struct SC::HttpAsyncClientTest : public SC::TestCase
         {
             commonMethodWrappers();
         }
+        if (test_section("async DNS resolver with address fallback"))
+        {
+            asyncDNSResolverFallback();
+        }
     }
 
     void basicGet();
     void headResponse();
     void commonMethodWrappers();
+    void asyncDNSResolverFallback();
     void putSpanBody();
     void requestOptions();
     void requestOptionBodyHelpers();
@@ -480,6 +485,85 @@ void SC::HttpAsyncClientTest::basicGet()
     SC_TEST_EXPECT(loop.close());
 }
 
+void SC::HttpAsyncClientTest::asyncDNSResolverFallback()
+{
+    AsyncEventLoop loop;
+    SC_TEST_EXPECT(loop.create());
+
+    ServerConnection connections[2];
+    HttpAsyncServer  httpServer;
+    const uint16_t   port = report.mapPort(26134);
+    SC_TEST_EXPECT(httpServer.init(Span<ServerConnection>(connections)));
+    SC_TEST_EXPECT(httpServer.start(loop, "127.0.0.1", port));
+
+    httpServer.onRequest = [this](HttpConnection& connection)
+    {
+        SC_TEST_EXPECT(connection.response.startResponse(200));
+        SC_TEST_EXPECT(connection.response.addHeader("Content-Length", "8"));
+        SC_TEST_EXPECT(connection.response.sendHeaders());
+        SC_TEST_EXPECT(connection.response.getWritableStream().write("resolved"));
+        SC_TEST_EXPECT(connection.response.end());
+    };
+
+    // First address refuses connections (server is only listening on 127.0.0.1), so the client must try the second
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(report.applicationRootDirectory.view()));
+    SC_TEST_EXPECT(fs.writeString("http-dns-hosts", "127.0.0.2 server.test\n127.0.0.1 server.test\n"));
+    String hostsPath = StringEncoding::Ascii;
+    SC_TEST_EXPECT(StringBuilder::format(hostsPath, "{}/http-dns-hosts", report.applicationRootDirectory.view()));
+
+    AsyncDNSResolver::Options options;
+    options.resolvConfPath = {};
+    options.hostsPath      = hostsPath.view();
+
+    AsyncDNSResolver resolver;
+    AsyncDNSQuery    query;
+    SC_TEST_EXPECT(resolver.init(loop, {}, options));
+
+    ClientConnection  clientStorage;
+    HttpAsyncClient   client;
+    ResponseCollector collector;
+    SC_TEST_EXPECT(client.init(clientStorage));
+    client.setDNSResolver(resolver, query);
+
+    struct Context
+    {
+        ResponseCollector& collector;
+        HttpAsyncServer&   httpServer;
+
+        bool completed = false;
+    } ctx = {collector, httpServer};
+
+    client.onResponse = [this, &ctx](HttpAsyncClientResponse& response)
+    {
+        ctx.collector.attach(response,
+                             [this, &ctx](HttpAsyncClientResponse& completedResponse)
+                             {
+                                 ctx.collector.detach();
+                                 SC_TEST_EXPECT(completedResponse.getParser().statusCode == 200);
+                                 SC_TEST_EXPECT(StringView(ctx.collector.view()) == "resolved");
+                                 SC_TEST_EXPECT(ctx.httpServer.stop());
+                                 ctx.completed = true;
+                             });
+    };
+    client.onError = [this](Result result) { SC_TEST_EXPECT(result); };
+
+    String url = StringEncoding::Ascii;
+    SC_TEST_EXPECT(StringBuilder::format(url, "http://server.test:{}/dns", port));
+    SC_TEST_EXPECT(client.get(loop, url.view()));
+
+    TimeoutGuard timeout;
+    SC_TEST_EXPECT(timeout.start(loop, TimeMs{2000}));
+    SC_TEST_EXPECT(loop.run());
+    SC_TEST_EXPECT(ctx.completed);
+    SC_TEST_EXPECT(query.getAddresses().sizeInElements() == 2);
+    SC_TEST_EXPECT(client.close());
+    SC_TEST_EXPECT(resolver.close());
+    SC_TEST_EXPECT(httpServer.close());
+    SC_TEST_EXPECT(loop.close());
+    SC_TEST_EXPECT(fs.removeFile("http-dns-hosts"));
+}
+
 void SC::HttpAsyncClientTest::httpsRequiresTransportAdapter()
 {
     AsyncEventLoop loop;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 #include "Libraries/Http/HttpAsyncFileServer.h"
 #include "HttpTestClient.h"
+#include "Libraries/AsyncStreams/Internal/ZLibAPI.h"
 #include "Libraries/FileSystem/FileSystem.h"
 #include "Libraries/Http/HttpAsyncServer.h"
 #include "Libraries/Memory/String.h"
@@ -35,6 +36,102 @@ static bool resultMessageEquals(SC::Result result, SC::StringSpan expected)
 {
     return not result and SC::StringSpan::fromNullTerminated(result.message, SC::StringEncoding::Ascii) == expected;
 }
+
+static bool compressionTestsAvailable()
+{
+    SC::ZLibAPI zlib;
+    if (not zlib.load())
+    {
+        return false;
+    }
+    zlib.unload();
+    return true;
+}
+
+// Extracts the (optionally chunked) body of a gzip response and decompresses it in the given storage
+static SC::Result decompressGZipResponse(SC::StringSpan response, bool chunked, SC::Span<char> compressedStorage,
+                                         SC::Span<char> storage, SC::Span<char>& decoded)
+{
+    const char*  data      = response.bytesWithoutTerminator();
+    const size_t length    = response.sizeInBytes();
+    size_t       bodyStart = 0;
+    while (bodyStart + 4 <= length and ::memcmp(data + bodyStart, "\r\n\r\n", 4) != 0)
+    {
+        bodyStart++;
+    }
+    SC_TRY_MSG(bodyStart + 4 <= length, "missing headers end");
+    bodyStart += 4;
+
+    size_t compressedSize = 0;
+    if (chunked)
+    {
+        size_t cursor = bodyStart;
+        while (true)
+        {
+            size_t chunkSize = 0;
+            for (; cursor < length and data[cursor] != '\r'; ++cursor)
+            {
+                const char c = data[cursor];
+                chunkSize    = chunkSize * 16 + static_cast<size_t>(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+            }
+            cursor += 2;
+            if (chunkSize == 0)
+            {
+                break;
+            }
+            SC_TRY_MSG(cursor + chunkSize + 2 <= length, "truncated chunk");
+            SC_TRY_MSG(compressedSize + chunkSize <= compressedStorage.sizeInBytes(), "compressed storage too small");
+            ::memcpy(compressedStorage.data() + compressedSize, data + cursor, chunkSize);
+            compressedSize += chunkSize;
+            cursor += chunkSize + 2;
+        }
+    }
+    else
+    {
+        compressedSize = length - bodyStart;
+        SC_TRY_MSG(compressedSize <= compressedStorage.sizeInBytes(), "compressed storage too small");
+        ::memcpy(compressedStorage.data(), data + bodyStart, compressedSize);
+    }
+
+    SC::ZLibStream         stream;
+    SC::Span<const char>   input     = {compressedStorage.data(), compressedSize};
+    SC::Span<char>         remaining = storage;
+    bool                   ended     = false;
+    SC_TRY(stream.init(SC::ZLibStream::DecompressGZip));
+    SC_TRY(stream.process(input, remaining));
+    SC_TRY_MSG(input.empty(), "decompressed storage too small");
+    SC_TRY(stream.finalize(remaining, ended));
+    SC_TRY_MSG(ended, "gzip stream did not end");
+    decoded = {storage.data(), storage.sizeInBytes() - remaining.sizeInBytes()};
+    return SC::Result(true);
+}
+
+// Calls a function once the cache has read the given number of entries (on the thread pool)
+struct CacheFillWaiter
+{
+    SC::AsyncLoopTimeout          timeout;
+    SC::HttpAsyncFileServerCache* cache = nullptr;
+    SC::uint64_t                  fills = 0;
+    SC::Function<void()>          onFilled;
+
+    SC::Result start(SC::AsyncEventLoop& loop, SC::HttpAsyncFileServerCache& fileCache, SC::uint64_t numFills,
+                     SC::Function<void()>&& func)
+    {
+        cache            = &fileCache;
+        fills            = numFills;
+        onFilled         = SC::move(func);
+        timeout.callback = [this](SC::AsyncLoopTimeout::Result& result)
+        {
+            if (cache->getStatistics().fills < fills)
+            {
+                result.reactivateRequest(true);
+                return;
+            }
+            onFilled();
+        };
+        return timeout.start(loop, SC::TimeMs{1});
+    }
+};
 } // namespace
 
 struct SC::HttpAsyncFileServerTest : public SC::TestCase
@@ -65,12 +162,22 @@ struct SC::HttpAsyncFileServerTest : public SC::TestCase
         {
             optionDiagnosticMessages();
         }
+        if (test_section("hot file cache"))
+        {
+            hotFileCache();
+        }
+        if (test_section("compressed responses") and compressionTestsAvailable())
+        {
+            compressedResponses();
+        }
     }
     void httpFileServerTest(bool useAsyncFileSend);
     void uploadPolicy();
     void uploadsDisabled();
     void customMimeLookup();
     void optionDiagnosticMessages();
+    void hotFileCache();
+    void compressedResponses();
 };
 
 void SC::HttpAsyncFileServerTest::customMimeLookup()
@@ -127,6 +234,7 @@ void SC::HttpAsyncFileServerTest::customMimeLookup()
         context.test->recordExpectation("custom MIME type",
                                         response.containsString("Content-Type: application/x-sane"));
         context.test->recordExpectation("custom MIME body", response.containsString("custom mime"));
+        context.test->recordExpectation("custom MIME date", response.containsString("\r\nDate: "));
         context.test->recordExpectation("custom MIME lookup called", *context.lookupCount == 1);
         context.test->recordExpectation("remove custom MIME fixture", context.fs->removeFile("custom.sane"));
         context.test->recordExpectation("stop server", context.httpServer->stop());
@@ -146,6 +254,456 @@ void SC::HttpAsyncFileServerTest::customMimeLookup()
     SC_TEST_EXPECT(eventLoop.close());
 }
 
+void SC::HttpAsyncFileServerTest::hotFileCache()
+{
+    StringView     webServerFolder = report.applicationRootDirectory.view();
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create());
+
+    using HttpConnectionType = HttpAsyncConnection<2, 2, 8 * 1024, 8 * 1024>;
+
+    HttpConnectionType                  connections[1];
+    HttpAsyncFileServer::StreamQueue<2> streams[1];
+    HttpAsyncServer                     httpServer;
+    HttpAsyncFileServer                 fileServer;
+    ThreadPool                          threadPool;
+    const uint16_t                      serverPort = report.mapPort(26127);
+
+    SC_TEST_EXPECT(threadPool.create(2)); // Cache entries are always filled on the thread pool
+    SC_TEST_EXPECT(httpServer.init(Span<HttpConnectionType>(connections)));
+    SC_TEST_EXPECT(httpServer.start(eventLoop, "127.0.0.1", serverPort));
+    SC_TEST_EXPECT(fileServer.init(threadPool, eventLoop, webServerFolder));
+
+    // Two entries of 64 bytes each, never revalidated (invalidation is explicit, as from a FileSystemWatcher)
+    HttpAsyncFileServerCache::Entry cacheEntries[2];
+    char                            cacheMemory[128];
+    HttpAsyncFileServerCache        cache;
+    SC_TEST_EXPECT(cache.init(cacheEntries, cacheMemory));
+    SC_TEST_EXPECT(cache.getSlotSize() == 64);
+    cache.revalidateIntervalMs = -1;
+
+    HttpAsyncFileServerOptions options;
+    options.cache = &cache;
+    SC_TEST_EXPECT(fileServer.setOptions(options));
+
+    struct RequestHandler
+    {
+        HttpAsyncServer&                     httpServer;
+        HttpAsyncFileServer&                 fileServer;
+        HttpAsyncFileServer::StreamQueue<2>* streams;
+        bool                                 stopAfterRequest;
+    } handler = {httpServer, fileServer, streams, false};
+
+    httpServer.onRequest = [&handler](HttpConnection& connection)
+    {
+        const size_t index = connection.getConnectionID().getIndex();
+        SC_ASSERT_RELEASE(handler.fileServer.handleRequest(handler.streams[index], connection));
+        if (handler.stopAfterRequest)
+        {
+            // Closes the connection while the cached body write is still queued behind the headers
+            SC_ASSERT_RELEASE(handler.httpServer.stop());
+        }
+    };
+
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(webServerFolder));
+    SC_TEST_EXPECT(fs.writeString("hot.txt", "hot file body"));
+    SC_TEST_EXPECT(fs.writeString("hot.txt.gz", "fake-gzip"));
+    char largeData[100];
+    ::memset(largeData, 'x', sizeof(largeData));
+    SC_TEST_EXPECT(fs.writeString("hot-large.txt", StringSpan({largeData, sizeof(largeData)}, false,
+                                                                 StringEncoding::Ascii)));
+
+    String serverURL = StringEncoding::Ascii;
+    SC_TEST_EXPECT(StringBuilder::format(serverURL, "http://127.0.0.1:{}/", serverPort));
+
+    struct HotFileCacheContext
+    {
+        HttpAsyncFileServerTest*  test;
+        HttpAsyncServer*          httpServer;
+        HttpAsyncFileServerCache* cache;
+        FileSystem*               fs;
+        AsyncEventLoop*           loop;
+        String*                   serverURL;
+        bool*                     stopAfterRequest;
+
+        CacheFillWaiter fillWaiter;
+
+        HttpTestClient firstClient;
+        HttpTestClient gzipClient;
+        HttpTestClient staleClient;
+        HttpTestClient changedClient;
+        HttpTestClient rangeClient;
+        HttpTestClient multiRangeClient;
+        HttpTestClient largeClient;
+        HttpTestClient abortedClient;
+    } context = {this, &httpServer, &cache, &fs, &eventLoop, &serverURL, &handler.stopAfterRequest,
+                 {},   {},          {},     {},  {},         {},         {},                        {},
+                 {}};
+
+    static constexpr StringSpan identityRequest = "GET /hot.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                  "Connection: close\r\n\r\n";
+
+    context.firstClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("cache miss 200", response.containsString("200 OK"));
+        context.test->recordExpectation("cache miss body", response.containsString("hot file body"));
+        context.test->recordExpectation("cache miss vary", response.containsString("Vary: Accept-Encoding"));
+        context.test->recordExpectation("cache miss identity", not response.containsString("Content-Encoding"));
+        context.test->recordExpectation("cache miss counted", context.cache->getStatistics().misses == 1);
+
+        // The miss has been served from disk, while reading the file in the cache
+        auto onFilled = [&context]()
+        {
+            static constexpr StringSpan gzipRequest = "GET /hot.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                      "Accept-Encoding: br;q=1.0, gzip;q=0.5\r\n"
+                                                      "Connection: close\r\n\r\n";
+            context.test->recordExpectation(
+                "start gzip request",
+                context.gzipClient.sendRaw(*context.loop, context.serverURL->view(), gzipRequest));
+        };
+        context.test->recordExpectation("wait first fill",
+                                        context.fillWaiter.start(*context.loop, *context.cache, 1, onFilled));
+    };
+    context.gzipClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("cache hit 200", response.containsString("200 OK"));
+        context.test->recordExpectation("cache hit gzip", response.containsString("Content-Encoding: gzip"));
+        context.test->recordExpectation("cache hit gzip body", response.containsString("fake-gzip"));
+        context.test->recordExpectation("cache hit gzip length", response.containsString("Content-Length: 9"));
+        context.test->recordExpectation("cache hit gzip etag", response.containsString("-gz\""));
+        context.test->recordExpectation("cache hit counted", context.cache->getStatistics().hits == 1);
+
+        // Modify files on disk without telling the cache: old content is still served
+        context.test->recordExpectation("remove gzip sibling", context.fs->removeFile("hot.txt.gz"));
+        context.test->recordExpectation("modify hot file", context.fs->writeString("hot.txt", "changed body"));
+        context.test->recordExpectation(
+            "start stale request",
+            context.staleClient.sendRaw(*context.loop, context.serverURL->view(), identityRequest));
+    };
+    context.staleClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("stale body", response.containsString("hot file body"));
+
+        context.cache->invalidate("hot.txt.gz"); // drops hot.txt too
+        context.test->recordExpectation("invalidation counted", context.cache->getStatistics().invalidations == 1);
+        context.test->recordExpectation(
+            "start changed request",
+            context.changedClient.sendRaw(*context.loop, context.serverURL->view(), identityRequest));
+    };
+    context.changedClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("changed body", response.containsString("changed body"));
+        context.test->recordExpectation("changed no vary", not response.containsString("Vary:"));
+
+        auto onFilled = [&context]()
+        {
+            static constexpr StringSpan rangeRequest = "GET /hot.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                       "Accept-Encoding: gzip\r\n"
+                                                       "Range: bytes=0-6\r\n"
+                                                       "Connection: close\r\n\r\n";
+            context.test->recordExpectation(
+                "start range request",
+                context.rangeClient.sendRaw(*context.loop, context.serverURL->view(), rangeRequest));
+        };
+        context.test->recordExpectation("wait changed fill",
+                                        context.fillWaiter.start(*context.loop, *context.cache, 2, onFilled));
+    };
+    context.rangeClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("cached range 206", response.containsString("206 Partial Content"));
+        context.test->recordExpectation("cached range header", response.containsString("Content-Range: bytes 0-6/12"));
+        context.test->recordExpectation("cached range body", response.containsString("\r\n\r\nchanged"));
+
+        static constexpr StringSpan multiRangeRequest = "GET /hot.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                        "Range: bytes=0-6,-4\r\n"
+                                                        "Connection: close\r\n\r\n";
+        context.test->recordExpectation(
+            "start multi range request",
+            context.multiRangeClient.sendRaw(*context.loop, context.serverURL->view(), multiRangeRequest));
+    };
+    context.multiRangeClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("cached multi range 206", response.containsString("206 Partial Content"));
+        context.test->recordExpectation("cached multi range first",
+                                        response.containsString("bytes 0-6/12\r\n\r\nchanged\r\n--"));
+        context.test->recordExpectation("cached multi range second",
+                                        response.containsString("bytes 8-11/12\r\n\r\nbody\r\n--"));
+
+        String largeURL = StringEncoding::Ascii;
+        context.test->recordExpectation("format large url",
+                                        StringBuilder::format(largeURL, "{}hot-large.txt", context.serverURL->view()));
+        context.test->recordExpectation("start large request", context.largeClient.get(*context.loop, largeURL.view()));
+    };
+    context.largeClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("uncacheable 200", response.containsString("200 OK"));
+        context.test->recordExpectation("uncacheable length", response.containsString("Content-Length: 100"));
+
+        const HttpAsyncFileServerCache::Statistics& statistics = context.cache->getStatistics();
+        context.test->recordExpectation("final hits", statistics.hits == 4);
+        context.test->recordExpectation("final misses", statistics.misses == 3);
+        context.test->recordExpectation("final evictions", statistics.evictions == 0);
+        context.test->recordExpectation("final fills", statistics.fills == 2);
+        context.test->recordExpectation("remove large file", context.fs->removeFile("hot-large.txt"));
+
+        // The entry pinned by the aborted response must be released, or cache.close() fails
+        *context.stopAfterRequest = true;
+        context.test->recordExpectation(
+            "start aborted request",
+            context.abortedClient.sendRaw(*context.loop, context.serverURL->view(), identityRequest));
+    };
+    context.abortedClient.callback = [&context](HttpTestClient&)
+    {
+        context.test->recordExpectation("aborted hit", context.cache->getStatistics().hits == 5);
+        context.test->recordExpectation("remove hot file", context.fs->removeFile("hot.txt"));
+    };
+
+    SC_TEST_EXPECT(context.firstClient.sendRaw(eventLoop, serverURL.view(), identityRequest));
+
+    AsyncLoopTimeout timeout;
+    timeout.callback = [this](AsyncLoopTimeout::Result&)
+    { SC_TEST_EXPECT("Test never finished. Event Loop is stuck. Timeout expired." && false); };
+    SC_TEST_EXPECT(timeout.start(eventLoop, TimeMs{2000}));
+    eventLoop.excludeFromActiveCount(timeout);
+
+    SC_TEST_EXPECT(eventLoop.run());
+    SC_TEST_EXPECT(fileServer.close());
+    SC_TEST_EXPECT(httpServer.close());
+    SC_TEST_EXPECT(cache.close());
+    SC_TEST_EXPECT(eventLoop.close());
+}
+
+void SC::HttpAsyncFileServerTest::compressedResponses()
+{
+    StringView     webServerFolder = report.applicationRootDirectory.view();
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create());
+
+    using HttpConnectionType = HttpAsyncConnection<2, 2, 8 * 1024, 8 * 1024>;
+
+    HttpConnectionType                  connections[1];
+    HttpAsyncFileServer::StreamQueue<2> streams[1];
+    HttpAsyncServer                     httpServer;
+    HttpAsyncFileServer                 fileServer;
+    ThreadPool                          threadPool;
+    const uint16_t                      serverPort = report.mapPort(26128);
+
+    SC_TEST_EXPECT(threadPool.create(2)); // Compression always runs on the thread pool
+    SC_TEST_EXPECT(httpServer.init(Span<HttpConnectionType>(connections)));
+    SC_TEST_EXPECT(httpServer.start(eventLoop, "127.0.0.1", serverPort));
+    SC_TEST_EXPECT(fileServer.init(threadPool, eventLoop, webServerFolder));
+
+    // A single 4 KB entry, large enough for small.json and its compressed representation (enabled in the last step)
+    HttpAsyncFileServerCache::Entry cacheEntries[1];
+    char                            cacheMemory[4096];
+    HttpAsyncFileServerCache        cache;
+    SC_TEST_EXPECT(cache.init(cacheEntries, cacheMemory));
+
+    HttpAsyncFileServerOptions options;
+    options.compressResponses = true;
+    SC_TEST_EXPECT(fileServer.setOptions(options));
+
+    httpServer.onRequest = [&](HttpConnection& connection)
+    { SC_ASSERT_RELEASE(fileServer.handleRequest(streams[connection.getConnectionID().getIndex()], connection)); };
+
+    // large.txt spans many buffers of the connection pool, exercising backpressure between file, compressor and socket
+    String largeText = StringEncoding::Ascii;
+    {
+        auto builder = StringBuilder::create(largeText);
+        for (int idx = 0; idx < 1000; ++idx)
+        {
+            SC_TEST_EXPECT(builder.append("Line {} of a text file compressed on the fly ({})\n", idx, idx * 7919));
+        }
+    }
+    String smallJson = StringEncoding::Ascii;
+    {
+        auto builder = StringBuilder::create(smallJson);
+        SC_TEST_EXPECT(builder.append("["));
+        for (int idx = 0; idx < 100; ++idx)
+        {
+            SC_TEST_EXPECT(builder.append("{{\"id\": {}, \"name\": \"item\"}},", idx));
+        }
+        SC_TEST_EXPECT(builder.append("0]"));
+    }
+
+    FileSystem fs;
+    SC_TEST_EXPECT(fs.init(webServerFolder));
+    SC_TEST_EXPECT(fs.writeString("large.txt", largeText.view()));
+    SC_TEST_EXPECT(fs.writeString("small.json", smallJson.view()));
+    SC_TEST_EXPECT(fs.writeString("sibling.txt", "sibling body, long enough to be compressed if it was 1KB"));
+    SC_TEST_EXPECT(fs.writeString("sibling.txt.gz", "fake-gzip"));
+
+    String serverURL = StringEncoding::Ascii;
+    SC_TEST_EXPECT(StringBuilder::format(serverURL, "http://127.0.0.1:{}/", serverPort));
+
+    static char compressedStorage[128 * 1024];
+    static char decompressedStorage[256 * 1024];
+
+    struct CompressedResponsesContext
+    {
+        HttpAsyncFileServerTest*    test;
+        HttpAsyncServer*            httpServer;
+        HttpAsyncFileServer*        fileServer;
+        HttpAsyncFileServerOptions* options;
+        HttpAsyncFileServerCache*   cache;
+        FileSystem*                 fs;
+        AsyncEventLoop*             loop;
+        String*                     serverURL;
+        String*                     largeText;
+        String*                     smallJson;
+
+        HttpTestClient siblingClient;
+        HttpTestClient compressedClient;
+        HttpTestClient compressedAgainClient;
+        HttpTestClient identityClient;
+        HttpTestClient headClient;
+        HttpTestClient missClient;
+        HttpTestClient cachedClient;
+
+        CacheFillWaiter fillWaiter;
+
+        void expectDecompressed(HttpTestClient& result, bool chunked, StringSpan expected, StringSpan name)
+        {
+            Span<char> decoded;
+            test->recordExpectation(name, decompressGZipResponse(result.getResponse(), chunked, compressedStorage,
+                                                                 decompressedStorage, decoded) and
+                                              StringSpan(decoded, false, StringEncoding::Ascii) == expected);
+        }
+    } context = {this,       &httpServer, &fileServer, &options, &cache, &fs, &eventLoop, &serverURL, &largeText,
+                 &smallJson, {},          {},          {},       {},     {},  {},         {},         {}};
+
+    static constexpr StringSpan largeRequest  = "GET /large.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                "Accept-Encoding: gzip, deflate\r\n"
+                                                "Connection: close\r\n\r\n";
+    static constexpr StringSpan cachedRequest = "GET /small.json HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                "Accept-Encoding: gzip\r\n"
+                                                "Connection: close\r\n\r\n";
+
+    context.siblingClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("sibling 200", response.containsString("200 OK"));
+        context.test->recordExpectation("sibling gzip", response.containsString("Content-Encoding: gzip"));
+        context.test->recordExpectation("sibling type", response.containsString("Content-Type: text/plain"));
+        context.test->recordExpectation("sibling length", response.containsString("Content-Length: 9"));
+        context.test->recordExpectation("sibling vary", response.containsString("Vary: Accept-Encoding"));
+        context.test->recordExpectation("sibling etag", response.containsString("-gz\""));
+        context.test->recordExpectation("sibling body", response.endsWith("\r\n\r\nfake-gzip"));
+        context.test->recordExpectation(
+            "start compressed request",
+            context.compressedClient.sendRaw(*context.loop, context.serverURL->view(), largeRequest));
+    };
+    context.compressedClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("compressed 200", response.containsString("200 OK"));
+        context.test->recordExpectation("compressed gzip", response.containsString("Content-Encoding: gzip"));
+        context.test->recordExpectation("compressed chunked", response.containsString("Transfer-Encoding: chunked"));
+        context.test->recordExpectation("compressed no length", not response.containsString("Content-Length"));
+        context.test->recordExpectation("compressed vary", response.containsString("Vary: Accept-Encoding"));
+        context.expectDecompressed(result, true, context.largeText->view(), "compressed body");
+        // The same connection stream (and compressor) is reused for the next request
+        context.test->recordExpectation(
+            "start compressed again request",
+            context.compressedAgainClient.sendRaw(*context.loop, context.serverURL->view(), largeRequest));
+    };
+    context.compressedAgainClient.callback = [&context](HttpTestClient& result)
+    {
+        context.expectDecompressed(result, true, context.largeText->view(), "compressed again body");
+
+        String largeURL = StringEncoding::Ascii;
+        context.test->recordExpectation("format large url",
+                                        StringBuilder::format(largeURL, "{}large.txt", context.serverURL->view()));
+        context.test->recordExpectation("start identity request",
+                                        context.identityClient.get(*context.loop, largeURL.view()));
+    };
+    context.identityClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("identity 200", response.containsString("200 OK"));
+        context.test->recordExpectation("identity not encoded", not response.containsString("Content-Encoding"));
+        context.test->recordExpectation("identity vary", response.containsString("Vary: Accept-Encoding"));
+        context.test->recordExpectation("identity body", response.endsWith(context.largeText->view()));
+
+        static constexpr StringSpan headRequest = "HEAD /large.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                  "Accept-Encoding: gzip\r\n"
+                                                  "Connection: close\r\n\r\n";
+        context.test->recordExpectation(
+            "start head request", context.headClient.sendRaw(*context.loop, context.serverURL->view(), headRequest));
+    };
+    context.headClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("head 200", response.containsString("200 OK"));
+        context.test->recordExpectation("head identity length", response.containsString("Content-Length: "));
+        context.test->recordExpectation("head not chunked", not response.containsString("Transfer-Encoding"));
+
+        // The first compressed response is stored in the cache, so next ones have a known length
+        context.options->cache = context.cache;
+        context.test->recordExpectation("enable cache", context.fileServer->setOptions(*context.options));
+
+        context.test->recordExpectation(
+            "start cache miss request",
+            context.missClient.sendRaw(*context.loop, context.serverURL->view(), cachedRequest));
+    };
+    context.missClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("cache miss gzip", response.containsString("Content-Encoding: gzip"));
+        context.test->recordExpectation("cache miss chunked", response.containsString("Transfer-Encoding: chunked"));
+        context.expectDecompressed(result, true, context.smallJson->view(), "cache miss compressed body");
+        auto onFilled = [&context]()
+        {
+            context.test->recordExpectation(
+                "start cached request",
+                context.cachedClient.sendRaw(*context.loop, context.serverURL->view(), cachedRequest));
+        };
+        context.test->recordExpectation("wait cache fill",
+                                        context.fillWaiter.start(*context.loop, *context.cache, 1, onFilled));
+    };
+    context.cachedClient.callback = [&context](HttpTestClient& result)
+    {
+        const StringView response(result.getResponse());
+        context.test->recordExpectation("cached gzip", response.containsString("Content-Encoding: gzip"));
+        context.test->recordExpectation("cached length", response.containsString("Content-Length: "));
+        context.test->recordExpectation("cached not chunked", not response.containsString("Transfer-Encoding"));
+        context.expectDecompressed(result, false, context.smallJson->view(), "cached compressed body");
+        context.test->recordExpectation("cached entry", context.cache->getStatistics().misses == 1 and
+                                                            context.cache->getStatistics().hits == 1);
+
+        context.test->recordExpectation("remove large file", context.fs->removeFile("large.txt"));
+        context.test->recordExpectation("remove small file", context.fs->removeFile("small.json"));
+        context.test->recordExpectation("remove sibling file", context.fs->removeFile("sibling.txt"));
+        context.test->recordExpectation("remove sibling gzip", context.fs->removeFile("sibling.txt.gz"));
+        context.test->recordExpectation("stop server", context.httpServer->stop());
+    };
+
+    static constexpr StringSpan siblingRequest = "GET /sibling.txt HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                                 "Accept-Encoding: gzip\r\n"
+                                                 "Connection: close\r\n\r\n";
+    SC_TEST_EXPECT(context.siblingClient.sendRaw(eventLoop, serverURL.view(), siblingRequest));
+
+    AsyncLoopTimeout timeout;
+    timeout.callback = [this](AsyncLoopTimeout::Result&)
+    { SC_TEST_EXPECT("Test never finished. Event Loop is stuck. Timeout expired." && false); };
+    SC_TEST_EXPECT(timeout.start(eventLoop, TimeMs{5000}));
+    eventLoop.excludeFromActiveCount(timeout);
+
+    SC_TEST_EXPECT(eventLoop.run());
+    SC_TEST_EXPECT(fileServer.close());
+    SC_TEST_EXPECT(httpServer.close());
+    SC_TEST_EXPECT(cache.close());
+    SC_TEST_EXPECT(eventLoop.close());
+}
+
 void SC::HttpAsyncFileServerTest::optionDiagnosticMessages()
 {
     AsyncEventLoop eventLoop;
@@ -383,6 +941,7 @@ void SC::HttpAsyncFileServerTest::httpFileServerTest(bool useAsyncFileSend)
         int disabledRangeCount     = 0;
         int etagCount              = 0;
         int rangeCount             = 0;
+        int multiRangeCount        = 0;
         int ifRangeMismatchCount   = 0;
         int invalidRangeCount      = 0;
         int conditionalCount       = 0;
@@ -400,6 +959,7 @@ void SC::HttpAsyncFileServerTest::httpFileServerTest(bool useAsyncFileSend)
         HttpTestClient disabledRangeClient     = {};
         HttpTestClient etagClient              = {};
         HttpTestClient rangeClient             = {};
+        HttpTestClient multiRangeClient        = {};
         HttpTestClient ifRangeMismatchClient   = {};
         HttpTestClient invalidRangeClient      = {};
         HttpTestClient conditionalClient       = {};
@@ -602,6 +1162,30 @@ void SC::HttpAsyncFileServerTest::httpFileServerTest(bool useAsyncFileSend)
         SC_TEST_EXPECT(str.containsString("<bod"));
         SC_TEST_EXPECT(not str.containsString("Response from file"));
 
+        static constexpr StringSpan multiRangeRequest = "GET /file.html HTTP/1.1\r\n"
+                                                        "Host: 127.0.0.1\r\n"
+                                                        "Range: bytes=0-5, 12-19\r\n"
+                                                        "Connection: close\r\n\r\n";
+        SC_TEST_EXPECT(context.multiRangeClient.sendRaw(*context.loop, context.serverURL.view(), multiRangeRequest));
+    };
+
+    context.multiRangeClient.callback = [this, &context](HttpTestClient& result)
+    {
+        context.multiRangeCount++;
+        StringView str(result.getResponse());
+        SC_TEST_EXPECT(str.containsString("206 Partial Content"));
+        SC_TEST_EXPECT(str.containsString("Content-Type: multipart/byteranges; boundary=SC_BYTERANGES_"));
+        SC_TEST_EXPECT(str.containsString("Content-Type: text/html\r\n"
+                                          "Content-Range: bytes 0-5/44\r\n\r\n<html>\r\n--"));
+        SC_TEST_EXPECT(str.containsString("Content-Range: bytes 12-19/44\r\n\r\nResponse\r\n--SC_BYTERANGES_"));
+        SC_TEST_EXPECT(str.endsWith("--\r\n"));
+        SC_TEST_EXPECT(not str.containsString("Response from file"));
+        StringView body;
+        SC_TEST_EXPECT(str.splitAfter("\r\n\r\n", body));
+        String contentLength = StringEncoding::Ascii;
+        SC_TEST_EXPECT(StringBuilder::format(contentLength, "Content-Length: {}\r\n", body.sizeInBytes()));
+        SC_TEST_EXPECT(str.containsString(contentLength.view()));
+
         static constexpr StringSpan ifRangeMismatchRequest = "GET /file.html HTTP/1.1\r\n"
                                                              "Host: 127.0.0.1\r\n"
                                                              "Range: bytes=6-9\r\n"
@@ -821,6 +1405,7 @@ void SC::HttpAsyncFileServerTest::httpFileServerTest(bool useAsyncFileSend)
     SC_TEST_EXPECT(context.disabledRangeCount == 1);
     SC_TEST_EXPECT(context.etagCount == 1);
     SC_TEST_EXPECT(context.rangeCount == 1);
+    SC_TEST_EXPECT(context.multiRangeCount == 1);
     SC_TEST_EXPECT(context.ifRangeMismatchCount == 1);
     SC_TEST_EXPECT(context.invalidRangeCount == 1);
     SC_TEST_EXPECT(context.conditionalCount == 1);
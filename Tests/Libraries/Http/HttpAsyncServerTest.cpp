@@ -253,6 +253,10 @@ struct SC::HttpAsyncServerTest : public SC::TestCase
         {
             responseBodyHelpers();
         }
+        if (test_section("cached headers"))
+        {
+            cachedHeaders();
+        }
         if (test_section("response diagnostic messages"))
         {
             responseDiagnosticMessages();
@@ -291,6 +295,7 @@ struct SC::HttpAsyncServerTest : public SC::TestCase
     void standardResponseStatuses();
     void emptyResponseHelper();
     void responseBodyHelpers();
+    void cachedHeaders();
     void responseDiagnosticMessages();
     void serverLifecycleDiagnosticMessages();
     void connectionBodyCopyHelper();
@@ -753,6 +758,76 @@ void SC::HttpAsyncServerTest::maxHeaderSizeError()
     SC_TEST_EXPECT(eventLoop.close());
 }
 
+void SC::HttpAsyncServerTest::cachedHeaders()
+{
+    HttpDateHeader dateHeader;
+    SC_TEST_EXPECT(dateHeader.update(0));
+    SC_TEST_EXPECT(dateHeader.getValue() == "Thu, 01 Jan 1970 00:00:00 GMT");
+    SC_TEST_EXPECT(dateHeader.update(1709208000999)); // Leap day
+    SC_TEST_EXPECT(dateHeader.getValue() == "Thu, 29 Feb 2024 12:00:00 GMT");
+    SC_TEST_EXPECT(dateHeader.update(1445412480000));
+    SC_TEST_EXPECT(dateHeader.getValue() == "Wed, 21 Oct 2015 07:28:00 GMT");
+    SC_TEST_EXPECT(StringSpan(dateHeader.getHeaderLine(), false, StringEncoding::Ascii) ==
+                   "Date: Wed, 21 Oct 2015 07:28:00 GMT\r\n");
+
+    char              cachedStorage[128];
+    HttpCachedHeaders cached;
+    cached.reset(cachedStorage);
+    SC_TEST_EXPECT(cached.addHeader("Server", "SC"));
+    SC_TEST_EXPECT(cached.addHeader("Content-Type", "application/json"));
+    SC_TEST_EXPECT(not cached.addHeader("Content-Length", "10"));
+    SC_TEST_EXPECT(not cached.addHeader("Connection", "close"));
+    SC_TEST_EXPECT(not cached.addHeader("X-Broken", "a\r\nb"));
+    SC_TEST_EXPECT(StringSpan(cached.getBlock(), false, StringEncoding::Ascii) ==
+                   "Server: SC\r\nContent-Type: application/json\r\n");
+
+    char              tinyStorage[8];
+    HttpCachedHeaders tiny;
+    tiny.reset(tinyStorage);
+    SC_TEST_EXPECT(not tiny.addHeader("Server", "SC"));
+
+    SC::AsyncBufferView  buffers[4] = {};
+    SC::AsyncBuffersPool pool;
+    pool.setBuffers(buffers);
+
+    RecordedWritableStream writable;
+    SC_TEST_EXPECT(writable.init(pool));
+
+    ProbeHttpResponse response;
+    char              headers[256] = {0};
+    response.setup(headers, writable);
+
+    SC_TEST_EXPECT(not response.addCachedHeaders(cached)); // startResponse must be called first
+    SC_TEST_EXPECT(response.startResponse(200));
+    SC_TEST_EXPECT(response.addCachedHeaders(cached));
+    SC_TEST_EXPECT(response.addDateHeader(dateHeader));
+    SC_TEST_EXPECT(response.addContentLength(18446744073709551615ull));
+    SC_TEST_EXPECT(response.sendHeaders());
+    while (writable.flushOne()) {}
+
+    constexpr StringView expected = "HTTP/1.1 200 OK\r\n"
+                                    "Server: SC\r\n"
+                                    "Content-Type: application/json\r\n"
+                                    "Date: Wed, 21 Oct 2015 07:28:00 GMT\r\n"
+                                    "Content-Length: 18446744073709551615\r\n"
+                                    "Connection: keep-alive\r\n"
+                                    "\r\n";
+    SC_TEST_EXPECT(StringSpan(writable.output.toSpanConst(), false, StringEncoding::Ascii) == expected);
+
+    AsyncEventLoop eventLoop;
+    SC_TEST_EXPECT(eventLoop.create());
+    HttpDateHeader loopDateHeader;
+    SC_TEST_EXPECT(loopDateHeader.start(eventLoop));
+    SC_TEST_EXPECT(not loopDateHeader.start(eventLoop));
+    SC_TEST_EXPECT(loopDateHeader.isStarted());
+    SC_TEST_EXPECT(loopDateHeader.getValue().sizeInBytes() == 29);
+    SC_TEST_EXPECT(eventLoop.run()); // The refresh timeout must not keep the loop alive
+    SC_TEST_EXPECT(loopDateHeader.stop());
+    SC_TEST_EXPECT(not loopDateHeader.isStarted());
+    SC_TEST_EXPECT(eventLoop.runNoWait());
+    SC_TEST_EXPECT(eventLoop.close());
+}
+
 void SC::HttpAsyncServerTest::responseBodyHelpers()
 {
     {
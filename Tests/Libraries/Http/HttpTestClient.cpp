@@ -3,7 +3,8 @@
 #include "HttpTestClient.h"
 #include "HttpStringAppend.h"
 #include "Libraries/Http/HttpURLParser.h"
-#include <stdio.h> // snprintf
+#include <stdio.h>  // snprintf
+#include <string.h> // memcmp
 
 SC::Result SC::HttpTestClient::get(AsyncEventLoop& loop, StringSpan url, bool keepOpen)
 {
@@ -282,7 +283,7 @@ SC::Result SC::HttpTestClient::sendRaw(AsyncEventLoop& loop, StringSpan url, Str
     parsedBytes         = 0;
     contentLen          = 0;
     headersReceived     = false;
-    responseHasNoBody   = false;
+    responseHasNoBody   = request.sizeInBytes() >= 5 and ::memcmp(request.bytesWithoutTerminator(), "HEAD ", 5) == 0;
     keepConnectionOpen  = false;
     hasActiveConnection = false;
     return connectAsync.start(*eventLoop, clientSocket, localHost);
@@ -364,6 +365,32 @@ void SC::HttpTestClient::startReceiveResponse(AsyncSocketSend::Result& result)
     }
 }
 
+bool SC::HttpTestClient::isResponseComplete() const
+{
+    if (headersReceived and not responseHasNoBody)
+    {
+        // Chunked responses have no Content-Length and are complete after receiving the last chunk
+        static constexpr char   chunkedHeader[]  = "Transfer-Encoding: chunked\r\n";
+        static constexpr char   lastChunk[]      = "0\r\n\r\n";
+        static constexpr size_t chunkedHeaderLen = sizeof(chunkedHeader) - 1;
+        static constexpr size_t lastChunkLen     = sizeof(lastChunk) - 1;
+
+        const char* data    = content.data();
+        bool        chunked = false;
+        for (size_t idx = 0; not chunked and idx + chunkedHeaderLen <= parsedBytes; ++idx)
+        {
+            chunked = ::memcmp(data + idx, chunkedHeader, chunkedHeaderLen) == 0;
+        }
+        if (chunked)
+        {
+            return content.size() >= parsedBytes + lastChunkLen and
+                   ::memcmp(data + content.size() - lastChunkLen, lastChunk, lastChunkLen) == 0;
+        }
+    }
+    const size_t expectedContentLen = responseHasNoBody and headersReceived ? 0 : contentLen;
+    return content.size() == parsedBytes + expectedContentLen;
+}
+
 void SC::HttpTestClient::tryParseResponse(AsyncSocketReceive::Result& result)
 {
     receivedBytes += result.completionData.numBytes;
@@ -394,8 +421,7 @@ void SC::HttpTestClient::tryParseResponse(AsyncSocketReceive::Result& result)
             }
         }
     }
-    const size_t expectedContentLen = responseHasNoBody and headersReceived ? 0 : contentLen;
-    if (content.size() == parsedBytes + expectedContentLen)
+    if (isResponseComplete())
     {
         // If we're not keeping the connection open, or if the server closed the connection, close it
         if (not keepConnectionOpen or result.completionData.disconnected)
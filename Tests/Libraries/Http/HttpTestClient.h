@@ -61,6 +61,7 @@ struct HttpTestClient
     void startSendingBody(AsyncLoopTimeout::Result& result);
     void startReceiveResponse(AsyncSocketSend::Result& result);
     void tryParseResponse(AsyncSocketReceive::Result& result);
+    bool isResponseComplete() const;
 
     HttpParser parser;
     Buffer     content;
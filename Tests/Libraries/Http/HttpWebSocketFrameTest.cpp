@@ -1,6 +1,7 @@
 // Copyright (c) Stefano Cristiano
 // SPDX-License-Identifier: MIT
 #include "HttpStringAppend.h"
+#include "Libraries/AsyncStreams/Internal/ZLibAPI.h"
 #include "Libraries/Http/HttpWebSocket.h"
 #include "Libraries/Memory/Buffer.h"
 #include "Libraries/Strings/StringView.h"
@@ -126,6 +127,39 @@ static bool spansEqual(SC::Span<const char> lhs, SC::Span<const char> rhs)
     return true;
 }
 
+// Frames encoded by the endpoint in frameStorage are parsed (and unmasked) in place
+static SC::Span<char> writableFrame(char* frameStorage, SC::Span<const char> frame)
+{
+    return {frameStorage + (frame.data() - frameStorage), frame.sizeInBytes()};
+}
+
+static bool compressionTestsAvailable()
+{
+    SC::ZLibAPI zlib;
+    if (not zlib.load())
+    {
+        return false;
+    }
+    zlib.unload();
+    return true;
+}
+
+struct MessageCollector
+{
+    SC::HttpWebSocketOpcode opcode = SC::HttpWebSocketOpcode::Text;
+
+    SC::Span<const char> message;
+    size_t               count = 0;
+
+    SC::Result onMessage(SC::HttpWebSocketOpcode messageOpcode, SC::Span<const char> messageData)
+    {
+        opcode  = messageOpcode;
+        message = messageData;
+        count++;
+        return SC::Result(true);
+    }
+};
+
 static bool resultMessageEquals(SC::Result result, SC::StringSpan expected)
 {
     if (result or result.message == nullptr)
@@ -173,6 +207,14 @@ struct SC::HttpWebSocketFrameTest : public SC::TestCase
         {
             writerRoundtrip();
         }
+        if (test_section("masking at any offset"))
+        {
+            maskingAtAnyOffset();
+        }
+        if (test_section("permessage-deflate") and compressionTestsAvailable())
+        {
+            perMessageDeflate();
+        }
     }
 
     void unmaskedServerFrames();
@@ -183,6 +225,8 @@ struct SC::HttpWebSocketFrameTest : public SC::TestCase
     void maskingRoleValidation();
     void invalidFrameRejection();
     void writerRoundtrip();
+    void maskingAtAnyOffset();
+    void perMessageDeflate();
 };
 
 void SC::HttpWebSocketFrameTest::unmaskedServerFrames()
@@ -420,6 +464,46 @@ void SC::HttpWebSocketFrameTest::fragmentationSequences()
 
     const char expected[] = {'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l'};
     SC_TEST_EXPECT(spansEqual(collector.payload.toSpanConst(), {expected, sizeof(expected)}));
+
+    // Control frames can be interleaved with the fragments of a message
+    HttpWebSocketFrameHeaderView ping;
+    ping.fin           = true;
+    ping.opcode        = HttpWebSocketOpcode::Ping;
+    ping.masked        = false;
+    ping.payloadLength = 1;
+
+    char pingPayload[] = {'p'};
+    writer.reset(HttpWebSocketEndpointRole::Server);
+    totalBytes = 0;
+    SC_TEST_EXPECT(encodeFrame(writer, first, {payload1, sizeof(payload1)}, {output, sizeof(output)}, frameBytes));
+    totalBytes += frameBytes;
+    SC_TEST_EXPECT(encodeFrame(writer, ping, {pingPayload, sizeof(pingPayload)},
+                               {output + totalBytes, sizeof(output) - totalBytes}, frameBytes));
+    totalBytes += frameBytes;
+
+    HttpWebSocketFrameHeaderView compressedStart = first;
+    compressedStart.compressed                   = true;
+    Span<const char> encodedHeader;
+    Span<char>       remaining = {output + totalBytes, sizeof(output) - totalBytes};
+    const Result     result    = writer.beginFrame(compressedStart, remaining, encodedHeader);
+    SC_TEST_EXPECT(resultMessageEquals(result, "HttpWebSocketFrameWriter expected continuation frame"));
+    SC_TEST_EXPECT(encodeFrame(writer, third, {payload3, sizeof(payload3)},
+                               {output + totalBytes, sizeof(output) - totalBytes}, frameBytes));
+    totalBytes += frameBytes;
+
+    ReaderCollector interleaved;
+    reader.reset(HttpWebSocketEndpointRole::Client);
+    reader.onFrameHeader.bind<ReaderCollector, &ReaderCollector::onHeader>(interleaved);
+    reader.onFramePayload.bind<ReaderCollector, &ReaderCollector::onPayload>(interleaved);
+    SC_TEST_EXPECT(reader.parse({output, totalBytes}, consumed));
+    SC_TEST_EXPECT(consumed == totalBytes);
+    SC_TEST_EXPECT(interleaved.numHeaders == 3);
+    SC_TEST_EXPECT(interleaved.headers[0].opcode == HttpWebSocketOpcode::Text);
+    SC_TEST_EXPECT(interleaved.headers[1].opcode == HttpWebSocketOpcode::Ping);
+    SC_TEST_EXPECT(interleaved.headers[2].opcode == HttpWebSocketOpcode::Continuation);
+
+    const char interleavedExpected[] = {'h', 'e', 'l', 'p', ' ', 'w', 'o', 'r', 'l'};
+    SC_TEST_EXPECT(spansEqual(interleaved.payload.toSpanConst(), {interleavedExpected, sizeof(interleavedExpected)}));
 }
 
 void SC::HttpWebSocketFrameTest::controlFrames()
@@ -620,4 +704,182 @@ void SC::HttpWebSocketFrameTest::writerRoundtrip()
     SC_TEST_EXPECT(spansEqual(collector.payload.toSpanConst(), {payload, sizeof(payload)}));
 }
 
+
+void SC::HttpWebSocketFrameTest::maskingAtAnyOffset()
+{
+    const SC::uint8_t maskKey[4] = {0x12, 0x34, 0x56, 0x78};
+
+    char original[100];
+    for (size_t idx = 0; idx < sizeof(original); ++idx)
+    {
+        original[idx] = static_cast<char>(idx * 7);
+    }
+
+    // Split the payload in different points, so that word-sized masking starts at every key offset
+    for (size_t split = 0; split < 40; ++split)
+    {
+        HttpWebSocketFrameWriter writer;
+        writer.reset(HttpWebSocketEndpointRole::Client);
+
+        HttpWebSocketFrameHeaderView header;
+        header.opcode        = HttpWebSocketOpcode::Binary;
+        header.masked        = true;
+        header.payloadLength = sizeof(original);
+        ::memcpy(header.maskKey, maskKey, sizeof(maskKey));
+
+        char             encoded[128];
+        Span<const char> encodedHeader;
+        SC_TEST_EXPECT(writer.beginFrame(header, encoded, encodedHeader));
+        char* payload = encoded + encodedHeader.sizeInBytes();
+        ::memcpy(payload, original, sizeof(original));
+        SC_TEST_EXPECT(writer.writePayload({payload, split}));
+        SC_TEST_EXPECT(writer.writePayload({payload + split, sizeof(original) - split}));
+        SC_TEST_EXPECT(writer.finishFrame());
+
+        bool maskedCorrectly = true;
+        for (size_t idx = 0; idx < sizeof(original); ++idx)
+        {
+            maskedCorrectly = maskedCorrectly and payload[idx] == static_cast<char>(original[idx] ^ maskKey[idx & 3]);
+        }
+        SC_TEST_EXPECT(maskedCorrectly);
+
+        ReaderCollector          collector;
+        HttpWebSocketFrameReader reader;
+        reader.reset(HttpWebSocketEndpointRole::Server);
+        reader.onFramePayload.bind<ReaderCollector, &ReaderCollector::onPayload>(collector);
+
+        const size_t chunkSizes[] = {encodedHeader.sizeInBytes() + split};
+        SC_TEST_EXPECT(parseFrameInChunks(reader, {encoded, encodedHeader.sizeInBytes() + sizeof(original)},
+                                          chunkSizes, 1));
+        SC_TEST_EXPECT(spansEqual(collector.payload.toSpanConst(), {original, sizeof(original)}));
+    }
+}
+
+void SC::HttpWebSocketFrameTest::perMessageDeflate()
+{
+    // Server asks to reset its own compressor after every message, client keeps its context
+    HttpWebSocketDeflateParameters parameters;
+    parameters.enabled                 = true;
+    parameters.serverNoContextTakeover = true;
+
+    char                 clientInflate[64];
+    char                 serverInflate[64];
+    HttpWebSocketDeflate clientDeflate;
+    HttpWebSocketDeflate serverDeflate;
+    SC_TEST_EXPECT(clientDeflate.init(parameters, HttpWebSocketEndpointRole::Client, clientInflate));
+    SC_TEST_EXPECT(serverDeflate.init(parameters, HttpWebSocketEndpointRole::Server, serverInflate));
+
+    const SC::uint8_t     maskKey[4] = {0xAA, 0xBB, 0xCC, 0xDD};
+    HttpWebSocketEndpoint client;
+    client.reset(HttpWebSocketEndpointRole::Client);
+    client.setDeflate(&clientDeflate);
+    HttpWebSocketEndpoint server;
+    server.reset(HttpWebSocketEndpointRole::Server);
+    server.setDeflate(&serverDeflate);
+
+    char                          messageStorage[2048];
+    HttpWebSocketMessageAssembler assembler;
+    MessageCollector              collector;
+    bool                          compressed = false;
+    assembler.reset(messageStorage);
+    assembler.onMessage.bind<MessageCollector, &MessageCollector::onMessage>(collector);
+    server.onFrameHeader = [&assembler, &compressed](const HttpWebSocketFrameHeaderView& header)
+    {
+        compressed = header.compressed;
+        return assembler.onFrameHeader(header);
+    };
+    server.onDataFramePayload = [&assembler](HttpWebSocketOpcode, Span<char> data, bool finished)
+    { return assembler.onFramePayload(data, finished); };
+
+    // A JSON document repeating the same keys (larger than inflate storage to check chunked decompression)
+    char   json[1500];
+    size_t jsonLength = 0;
+    json[jsonLength++] = '[';
+    while (jsonLength + 40 < sizeof(json))
+    {
+        const char item[] = "{\"name\":\"sensor\",\"value\":42,\"ok\":true},";
+        ::memcpy(json + jsonLength, item, sizeof(item) - 1);
+        jsonLength += sizeof(item) - 1;
+    }
+    json[jsonLength - 1] = ']';
+
+    char             frameStorage[2048];
+    Span<const char> frame;
+    size_t           consumed = 0;
+
+    SC_TEST_EXPECT(client.sendData(HttpWebSocketOpcode::Text, {json, jsonLength}, true, maskKey, frameStorage, frame));
+    const size_t firstFrameSize = frame.sizeInBytes();
+    SC_TEST_EXPECT(firstFrameSize < jsonLength / 4);
+    SC_TEST_EXPECT((static_cast<SC::uint8_t>(frame[0]) & 0x40) != 0); // RSV1
+    SC_TEST_EXPECT(server.receive(writableFrame(frameStorage, frame), consumed));
+    SC_TEST_EXPECT(consumed == frame.sizeInBytes());
+    SC_TEST_EXPECT(compressed);
+    SC_TEST_EXPECT(collector.count == 1);
+    SC_TEST_EXPECT(spansEqual(collector.message, {json, jsonLength}));
+
+    // Context takeover: the same message again is encoded as a reference to the previous one
+    SC_TEST_EXPECT(client.sendData(HttpWebSocketOpcode::Text, {json, jsonLength}, true, maskKey, frameStorage, frame));
+    SC_TEST_EXPECT(frame.sizeInBytes() < firstFrameSize);
+    SC_TEST_EXPECT(server.receive(writableFrame(frameStorage, frame), consumed));
+    SC_TEST_EXPECT(collector.count == 2);
+    SC_TEST_EXPECT(spansEqual(collector.message, {json, jsonLength}));
+
+    // Frames rejected because of fragmentation state must not advance the compression context, or the messages
+    // following them (checked below) could not be decompressed anymore
+    const Span<const char> rejected = {json, 100};
+    SC_TEST_EXPECT(
+        not client.sendData(HttpWebSocketOpcode::Continuation, rejected, true, maskKey, frameStorage, frame));
+
+    // Fragmented message, with RSV1 only on the first frame and an empty final continuation
+    SC_TEST_EXPECT(client.sendData(HttpWebSocketOpcode::Binary, {json, 100}, false, maskKey, frameStorage, frame));
+    SC_TEST_EXPECT(server.receive(writableFrame(frameStorage, frame), consumed));
+    SC_TEST_EXPECT(not client.sendData(HttpWebSocketOpcode::Text, rejected, true, maskKey, frameStorage, frame));
+    SC_TEST_EXPECT(client.sendData(HttpWebSocketOpcode::Continuation, {json + 100, jsonLength - 100}, false, maskKey,
+                                   frameStorage, frame));
+    SC_TEST_EXPECT((static_cast<SC::uint8_t>(frame[0]) & 0x40) == 0);
+    SC_TEST_EXPECT(compressed); // Continuation frames of a compressed message are reported as compressed
+    SC_TEST_EXPECT(server.receive(writableFrame(frameStorage, frame), consumed));
+    SC_TEST_EXPECT(client.sendData(HttpWebSocketOpcode::Continuation, {}, true, maskKey, frameStorage, frame));
+    SC_TEST_EXPECT(server.receive(writableFrame(frameStorage, frame), consumed));
+    SC_TEST_EXPECT(collector.count == 3);
+    SC_TEST_EXPECT(collector.opcode == HttpWebSocketOpcode::Binary);
+    SC_TEST_EXPECT(spansEqual(collector.message, {json, jsonLength}));
+
+    // Empty message
+    SC_TEST_EXPECT(client.sendData(HttpWebSocketOpcode::Text, {}, true, maskKey, frameStorage, frame));
+    SC_TEST_EXPECT(server.receive(writableFrame(frameStorage, frame), consumed));
+    SC_TEST_EXPECT(collector.count == 4);
+    SC_TEST_EXPECT(collector.message.empty());
+
+    // Server without context takeover produces frames of the same size for the same message
+    ReaderCollector          received;
+    HttpWebSocketFrameReader clientReader;
+    clientReader.reset(HttpWebSocketEndpointRole::Client);
+    clientReader.setDeflate(&clientDeflate);
+    clientReader.onFramePayload.bind<ReaderCollector, &ReaderCollector::onPayload>(received);
+
+    size_t serverFrameSizes[2];
+    for (size_t idx = 0; idx < 2; ++idx)
+    {
+        SC_TEST_EXPECT(server.sendData(HttpWebSocketOpcode::Text, {json, 200}, true, nullptr, frameStorage, frame));
+        serverFrameSizes[idx] = frame.sizeInBytes();
+        SC_TEST_EXPECT(clientReader.parse(writableFrame(frameStorage, frame), consumed));
+    }
+    SC_TEST_EXPECT(serverFrameSizes[0] == serverFrameSizes[1]);
+    SC_TEST_EXPECT(received.payload.size() == 400);
+    SC_TEST_EXPECT(spansEqual({received.payload.data(), 200}, {json, 200}));
+    SC_TEST_EXPECT(spansEqual({received.payload.data() + 200, 200}, {json, 200}));
+    SC_TEST_EXPECT(received.finishedFlags[received.numPayloadEvents - 1]);
+
+    // Compressed frames are rejected when the extension has not been enabled
+    HttpWebSocketFrameReader plainReader;
+    plainReader.reset(HttpWebSocketEndpointRole::Client);
+    SC_TEST_EXPECT(server.sendData(HttpWebSocketOpcode::Text, {json, 200}, true, nullptr, frameStorage, frame));
+    Result result = plainReader.parse(writableFrame(frameStorage, frame), consumed);
+    SC_TEST_EXPECT(resultMessageEquals(result, "HttpWebSocketFrameReader RSV bits are not supported"));
+
+    clientDeflate.close();
+    serverDeflate.close();
+}
+
 void SC::runHttpWebSocketFrameTest(SC::TestReport& report) { HttpWebSocketFrameTest test(report); }
@@ -32,6 +32,10 @@ struct SC::HttpWebSocketHandshakeTest : public SC::TestCase
         {
             clientResponseValidation();
         }
+        if (test_section("permessage-deflate negotiation"))
+        {
+            perMessageDeflateNegotiation();
+        }
         if (test_section("async server accept integration"))
         {
             asyncServerAcceptIntegration();
@@ -57,6 +61,7 @@ struct SC::HttpWebSocketHandshakeTest : public SC::TestCase
     void clientKeyAndAcceptGeneration();
     void serverRequestValidation();
     void clientResponseValidation();
+    void perMessageDeflateNegotiation();
     void asyncServerAcceptIntegration();
     void asyncClientConnectIntegration();
     void asyncServerKeepsUpgradedConnectionAlive();
@@ -123,6 +128,62 @@ void SC::HttpWebSocketHandshakeTest::clientResponseValidation()
     SC_TEST_EXPECT(not HttpWebSocketHandshake::validateClientResponse(response, "dGhlIHNhbXBsZSBub25jZQ=="));
 }
 
+void SC::HttpWebSocketHandshakeTest::perMessageDeflateNegotiation()
+{
+    char       storage[HttpWebSocketHandshake::DeflateResponseMaxLength];
+    StringSpan response;
+
+    // First acceptable offer wins, and server preferences are kept
+    HttpWebSocketDeflateParameters server;
+    server.clientNoContextTakeover = true;
+    SC_TEST_EXPECT(HttpWebSocketHandshake::negotiateDeflate(
+        "x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=8, "
+        "permessage-deflate; client_max_window_bits; server_max_window_bits=\"10\"",
+        server));
+    SC_TEST_EXPECT(server.enabled);
+    SC_TEST_EXPECT(server.serverMaxWindowBits == 10);
+    SC_TEST_EXPECT(server.clientMaxWindowBits == 15);
+    SC_TEST_EXPECT(not server.serverNoContextTakeover);
+    SC_TEST_EXPECT(HttpWebSocketHandshake::formatDeflateResponse(server, storage, response));
+    SC_TEST_EXPECT(response == "permessage-deflate; client_no_context_takeover; server_max_window_bits=10");
+
+    HttpWebSocketDeflateParameters client;
+    SC_TEST_EXPECT(HttpWebSocketHandshake::parseDeflateResponse(response, client));
+    SC_TEST_EXPECT(client.enabled);
+    SC_TEST_EXPECT(client.clientNoContextTakeover);
+    SC_TEST_EXPECT(client.serverMaxWindowBits == 10);
+
+    server = {};
+    SC_TEST_EXPECT(HttpWebSocketHandshake::negotiateDeflate("permessage-deflate; server_no_context_takeover", server));
+    SC_TEST_EXPECT(HttpWebSocketHandshake::formatDeflateResponse(server, storage, response));
+    SC_TEST_EXPECT(response == "permessage-deflate; server_no_context_takeover");
+
+    // Unknown, duplicated or malformed parameters make an offer unacceptable
+    server = {};
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::negotiateDeflate("permessage-deflate; unknown", server));
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::negotiateDeflate(
+        "permessage-deflate; server_no_context_takeover; server_no_context_takeover", server));
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::negotiateDeflate("permessage-deflate; server_max_window_bits", server));
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::negotiateDeflate("", server));
+    SC_TEST_EXPECT(not server.enabled);
+
+    // Client requires a value for client_max_window_bits and rejects responses it did not offer
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::parseDeflateResponse("permessage-deflate; client_max_window_bits",
+                                                                    client));
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::parseDeflateResponse("permessage-deflate, permessage-deflate", client));
+    SC_TEST_EXPECT(
+        HttpWebSocketHandshake::parseDeflateResponse("permessage-deflate; client_max_window_bits=9", client));
+    SC_TEST_EXPECT(client.clientMaxWindowBits == 9);
+
+    HttpWebSocketClientHandshakeResponseView view;
+    view.statusCode             = 101;
+    view.upgrade                = "websocket";
+    view.connection             = "Upgrade";
+    view.secWebSocketAccept     = "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=";
+    view.secWebSocketExtensions = "permessage-deflate";
+    SC_TEST_EXPECT(not HttpWebSocketHandshake::validateClientResponse(view, "dGhlIHNhbXBsZSBub25jZQ=="));
+}
+
 void SC::HttpWebSocketHandshakeTest::asyncServerAcceptIntegration()
 {
     AsyncEventLoop eventLoop;
@@ -5,6 +5,7 @@
 #include "Libraries/Common/Deferred.h"
 #include "Libraries/Http/HttpAsyncServer.h"
 #include "Libraries/HttpClient/HttpClientAsync.h"
+#include "Libraries/HttpClient/HttpClientMulti.h"
 #include "Libraries/HttpClient/HttpClientScheduler.h"
 #include "Libraries/HttpClient/HttpClientSession.h"
 #include "Libraries/Memory/String.h"
@@ -160,6 +161,12 @@ struct SC::HttpClientTest : public SC::TestCase
         {
             asyncUploadPipeline();
         }
+#if SC_PLATFORM_LINUX
+        if (test_section("multi event loop"))
+        {
+            multiEventLoop();
+        }
+#endif
 #endif
     }
 
@@ -345,6 +352,73 @@ struct SC::HttpClientTest : public SC::TestCase
         }
     };
 
+    struct LargeResponseWriter
+    {
+        HttpConnection* connection   = nullptr;
+        size_t          remaining    = 0;
+        bool            waitingDrain = false;
+
+        void start(HttpConnection& client, size_t total)
+        {
+            connection = &client;
+            remaining  = total;
+            writeNext();
+        }
+
+        void onDrain()
+        {
+            if (waitingDrain)
+            {
+                waitingDrain = false;
+                (void)connection->response.getWritableStream()
+                    .eventDrain.removeListener<LargeResponseWriter, &LargeResponseWriter::onDrain>(*this);
+            }
+            writeNext();
+        }
+
+        void writeNext()
+        {
+            AsyncWritableStream& writable = connection->response.getWritableStream();
+            AsyncBuffersPool&    pool     = writable.getBuffersPool();
+
+            while (remaining > 0)
+            {
+                AsyncBufferView::ID bufferID;
+                Span<char>          data;
+                if (not pool.requestNewBuffer(1, bufferID, data))
+                {
+                    break;
+                }
+
+                const size_t toWrite = remaining < data.sizeInBytes() ? remaining : data.sizeInBytes();
+                memset(data.data(), 'A', toWrite);
+                pool.setNewBufferSize(bufferID, toWrite);
+                const Result res = writable.write(bufferID);
+                pool.unrefBuffer(bufferID);
+                if (res)
+                {
+                    remaining -= toWrite;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            if (remaining == 0)
+            {
+                (void)connection->response.end();
+            }
+            else if (not waitingDrain)
+            {
+                waitingDrain = true;
+                const bool added =
+                    writable.eventDrain.addListener<LargeResponseWriter, &LargeResponseWriter::onDrain>(*this);
+                SC_ASSERT_RELEASE(added);
+            }
+        }
+    };
+
     void initAndClose()
     {
         HttpClient client;
@@ -1356,6 +1430,20 @@ struct SC::HttpClientTest : public SC::TestCase
         char tinyAcceptEncodingScratch[4];
         SC_TEST_EXPECT(not HttpClientContentCoding::writeAcceptEncoding(
             acceptedCodings, {tinyAcceptEncodingScratch, sizeof(tinyAcceptEncodingScratch)}, acceptEncoding));
+
+        using Coding = HttpClientContentCoding;
+        SC_TEST_EXPECT(Coding::parseName("ZSTD"_a8) == Coding::ZStd);
+        SC_TEST_EXPECT(strcmp(Coding::getName(Coding::ZStd), "zstd") == 0);
+
+        const Coding::Type serverCodings[] = {Coding::ZStd, Coding::Brotli, Coding::GZip};
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding("gzip, br, zstd"_a8, serverCodings) == Coding::ZStd);
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding("gzip, zstd;q=0.5, br"_a8, serverCodings) == Coding::Brotli);
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding("zstd;q=0, br;q=0.8, *;q=0.9"_a8, serverCodings) ==
+                       Coding::GZip);
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding("deflate"_a8, serverCodings) == Coding::Identity);
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding(""_a8, serverCodings) == Coding::Identity);
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding("deflate, identity;q=0"_a8, serverCodings) == Coding::Unknown);
+        SC_TEST_EXPECT(Coding::selectFromAcceptEncoding("*;q=0"_a8, serverCodings) == Coding::Unknown);
     }
 
     void contentCodingPolicy()
@@ -2970,72 +3058,7 @@ struct SC::HttpClientTest : public SC::TestCase
         TestServer server(loop);
         SC_TEST_EXPECT(server.start(report));
 
-        struct LargeResponseWriter
-        {
-            HttpConnection* connection   = nullptr;
-            size_t          remaining    = 0;
-            bool            waitingDrain = false;
-
-            void start(HttpConnection& client, size_t total)
-            {
-                connection = &client;
-                remaining  = total;
-                writeNext();
-            }
-
-            void onDrain()
-            {
-                if (waitingDrain)
-                {
-                    waitingDrain = false;
-                    (void)connection->response.getWritableStream()
-                        .eventDrain.removeListener<LargeResponseWriter, &LargeResponseWriter::onDrain>(*this);
-                }
-                writeNext();
-            }
-
-            void writeNext()
-            {
-                AsyncWritableStream& writable = connection->response.getWritableStream();
-                AsyncBuffersPool&    pool     = writable.getBuffersPool();
-
-                while (remaining > 0)
-                {
-                    AsyncBufferView::ID bufferID;
-                    Span<char>          data;
-                    if (not pool.requestNewBuffer(1, bufferID, data))
-                    {
-                        break;
-                    }
-
-                    const size_t toWrite = remaining < data.sizeInBytes() ? remaining : data.sizeInBytes();
-                    memset(data.data(), 'A', toWrite);
-                    pool.setNewBufferSize(bufferID, toWrite);
-                    const Result res = writable.write(bufferID);
-                    pool.unrefBuffer(bufferID);
-                    if (res)
-                    {
-                        remaining -= toWrite;
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-
-                if (remaining == 0)
-                {
-                    (void)connection->response.end();
-                }
-                else if (not waitingDrain)
-                {
-                    waitingDrain = true;
-                    const bool added =
-                        writable.eventDrain.addListener<LargeResponseWriter, &LargeResponseWriter::onDrain>(*this);
-                    SC_ASSERT_RELEASE(added);
-                }
-            }
-        } writer;
+        LargeResponseWriter writer;
 
         server.server.onRequest = [&writer](HttpConnection& client)
         {
@@ -3257,6 +3280,172 @@ struct SC::HttpClientTest : public SC::TestCase
         SC_TEST_EXPECT(client.close());
         SC_TEST_EXPECT(loop.close());
     }
+
+    void multiEventLoop()
+    {
+        static constexpr size_t NumSmall         = 6; // Test server has room for 8 connections
+        static constexpr size_t LargeIndex       = NumSmall;
+        static constexpr size_t CancelIndex      = NumSmall + 1;
+        static constexpr size_t NumOperations    = NumSmall + 2;
+        static constexpr size_t LargePayloadSize = 1024 * 1024;
+
+        struct MultiCollector final : public HttpClientOperationListener
+        {
+            size_t* numCompleted = nullptr;
+
+            char   firstBytes[16] = {};
+            size_t received       = 0;
+            int    headCount      = 0;
+            bool   completed      = false;
+            bool   onlyA          = true;
+            Result finalRes       = Result(true);
+
+            virtual void onResponseHead(HttpClientResponse&) override { headCount += 1; }
+
+            virtual void onResponseBody(Span<const char> data) override
+            {
+                for (size_t idx = 0; idx < data.sizeInBytes(); ++idx)
+                {
+                    if (received + idx < sizeof(firstBytes))
+                    {
+                        firstBytes[received + idx] = data[idx];
+                    }
+                    onlyA = onlyA and data[idx] == 'A';
+                }
+                received += data.sizeInBytes();
+            }
+
+            virtual void onResponseComplete() override { complete(Result(true)); }
+
+            virtual void onError(Result error) override { complete(error); }
+
+            void complete(Result res)
+            {
+                completed = true;
+                finalRes  = res;
+                *numCompleted += 1;
+            }
+        };
+
+        AsyncEventLoop loop;
+        SC_TEST_EXPECT(loop.create());
+
+        TestServer server(loop);
+        SC_TEST_EXPECT(server.start(report));
+
+        LargeResponseWriter writer;
+        server.server.onRequest = [&writer](HttpConnection& client)
+        {
+            SC_ASSERT_RELEASE(client.response.startResponse(200));
+            if (client.request.getRequestTarget() == "/large")
+            {
+                SC_ASSERT_RELEASE(client.response.addHeader("Content-Length"_a8, "1048576"_a8));
+                SC_ASSERT_RELEASE(client.response.sendHeaders());
+                writer.start(client, LargePayloadSize);
+            }
+            else
+            {
+                SC_ASSERT_RELEASE(client.response.addHeader("Content-Length"_a8, "6"_a8));
+                SC_ASSERT_RELEASE(client.response.sendHeaders());
+                SC_ASSERT_RELEASE(client.response.getWritableStream().write("ABCDEF"));
+                SC_ASSERT_RELEASE(client.response.end());
+            }
+        };
+
+        String largeUrl(StringEncoding::Ascii);
+        SC_TEST_EXPECT(StringBuilder::format(largeUrl, "{}/large", server.endpoint.view()));
+
+        HttpClient client;
+        SC_TEST_EXPECT(client.init());
+
+        CoreOperationMemory<16 * 1024, 2, 4, 1024, 1024>      smallMemories[NumSmall + 1];
+        CoreOperationMemory<32 * 1024, 2, 4, 4096, 16 * 1024> largeMemory;
+        HttpClientOperation                                   operations[NumOperations];
+        HttpClientOperation*                                  operationPointers[NumOperations];
+        uint8_t                                               readyOperations[NumOperations] = {};
+        HttpClientResponse                                    responses[NumOperations];
+        MultiCollector                                        collectors[NumOperations];
+        HttpClientMultiAsyncT<AsyncEventLoop>::Socket         sockets[NumOperations];
+        size_t                                                numCompleted = 0;
+
+        for (size_t idx = 0; idx < NumOperations; ++idx)
+        {
+            collectors[idx].numCompleted = &numCompleted;
+            const HttpClientOperationMemory& memory =
+                idx == LargeIndex ? largeMemory.memory : smallMemories[idx < LargeIndex ? idx : idx - 1].memory;
+            SC_TEST_EXPECT(operations[idx].init(client, memory));
+            operationPointers[idx] = &operations[idx];
+        }
+
+        HttpClientMultiMemory multiMemory;
+        multiMemory.operations      = {operationPointers, NumOperations};
+        multiMemory.readyOperations = {readyOperations, NumOperations};
+
+        HttpClientMultiAsyncT<AsyncEventLoop> multiAsync;
+        SC_TEST_EXPECT(multiAsync.init(client, loop, multiMemory, {sockets, NumOperations}));
+        HttpClientMulti& multi = multiAsync.getMulti();
+        SC_TEST_EXPECT(multi.getNumOperations() == NumOperations);
+        SC_TEST_EXPECT(multi.isOperationRegistered(operations[0]));
+        SC_TEST_EXPECT(not multi.hasRequestsInFlight());
+
+        for (size_t idx = 0; idx < NumOperations; ++idx)
+        {
+            HttpClientRequest request;
+            request.url = idx == LargeIndex ? largeUrl.view() : server.endpoint.view();
+            SC_TEST_EXPECT(operations[idx].start(request, responses[idx], &collectors[idx]));
+        }
+        SC_TEST_EXPECT(multi.getNumRequestsInFlight() == NumOperations);
+        SC_TEST_EXPECT(operations[CancelIndex].cancel());
+
+        // Server and all transfers share this thread
+        while (numCompleted < NumOperations)
+        {
+            SC_TEST_EXPECT(loop.runOnce());
+        }
+        SC_TEST_EXPECT(not multi.hasRequestsInFlight());
+
+        for (size_t idx = 0; idx < NumSmall; ++idx)
+        {
+            SC_TEST_EXPECT(collectors[idx].finalRes);
+            SC_TEST_EXPECT(collectors[idx].headCount == 1);
+            SC_TEST_EXPECT(responses[idx].statusCode == 200);
+            SC_TEST_EXPECT(StringView({collectors[idx].firstBytes, collectors[idx].received}, false,
+                                      StringEncoding::Ascii) == "ABCDEF");
+        }
+        SC_TEST_EXPECT(collectors[LargeIndex].finalRes);
+        SC_TEST_EXPECT(collectors[LargeIndex].headCount == 1);
+        SC_TEST_EXPECT(collectors[LargeIndex].received == LargePayloadSize);
+        SC_TEST_EXPECT(collectors[LargeIndex].onlyA);
+        SC_TEST_EXPECT(not collectors[CancelIndex].finalRes);
+        SC_TEST_EXPECT(collectors[CancelIndex].headCount == 0);
+
+        // Operations can be reused after completion
+        HttpClientRequest request;
+        request.url                = server.endpoint.view();
+        collectors[0]              = MultiCollector();
+        collectors[0].numCompleted = &numCompleted;
+        numCompleted               = 0;
+        SC_TEST_EXPECT(operations[0].start(request, responses[0], &collectors[0]));
+        while (numCompleted < 1)
+        {
+            SC_TEST_EXPECT(loop.runOnce());
+        }
+        SC_TEST_EXPECT(collectors[0].finalRes);
+        SC_TEST_EXPECT(collectors[0].received == 6);
+
+        // Loop exits only if all sockets and timers have been released
+        SC_TEST_EXPECT(multiAsync.close());
+        SC_TEST_EXPECT(server.scheduleStop());
+        SC_TEST_EXPECT(loop.run());
+
+        for (size_t idx = 0; idx < NumOperations; ++idx)
+        {
+            SC_TEST_EXPECT(operations[idx].close());
+        }
+        SC_TEST_EXPECT(client.close());
+        SC_TEST_EXPECT(server.server.close());
+        SC_TEST_EXPECT(loop.close());
+    }
 };
 
 namespace SC
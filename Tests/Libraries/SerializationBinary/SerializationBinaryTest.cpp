@@ -8,17 +8,245 @@
 namespace SC
 {
 struct SerializationBinaryTest;
+struct SerializationBinaryLookupEntry;
+struct SerializationBinaryLookupEntry2;
+struct SerializationBinaryCompactStruct;
 } // namespace SC
 
+struct SC::SerializationBinaryLookupEntry
+{
+    uint32_t key    = 0;
+    float    weight = 0;
+    double   value  = 0;
+};
+SC_REFLECT_STRUCT_VISIT(SC::SerializationBinaryLookupEntry)
+SC_REFLECT_STRUCT_FIELD(0, key)
+SC_REFLECT_STRUCT_FIELD(1, weight)
+SC_REFLECT_STRUCT_FIELD(2, value)
+SC_REFLECT_STRUCT_LEAVE()
+
+struct SC::SerializationBinaryLookupEntry2
+{
+    double   value  = 0;
+    uint32_t key    = 0;
+    float    weight = 0;
+    uint32_t extra  = 0;
+};
+SC_REFLECT_STRUCT_VISIT(SC::SerializationBinaryLookupEntry2)
+SC_REFLECT_STRUCT_FIELD(2, value)
+SC_REFLECT_STRUCT_FIELD(0, key)
+SC_REFLECT_STRUCT_FIELD(1, weight)
+SC_REFLECT_STRUCT_FIELD(3, extra)
+SC_REFLECT_STRUCT_LEAVE()
+
+struct SC::SerializationBinaryCompactStruct
+{
+    uint8_t                                byteValue  = 200;
+    uint16_t                               shortValue = 300;
+    int32_t                                intValue   = -1;
+    int64_t                                int64Value = -9223372036854775807LL - 1;
+    uint64_t                               bigValue   = ~0ull;
+    float                                  floatValue = 1.5f;
+    int16_t                                shorts[3]  = {-64, 64, 0};
+    Vector<uint32_t>                       counters   = {0, 1, 127, 128, 16384};
+    Vector<SerializationBinaryLookupEntry> entries    = {{1, 0.5f, 2.0}, {2, 0.25f, 4.0}};
+};
+SC_REFLECT_STRUCT_VISIT(SC::SerializationBinaryCompactStruct)
+SC_REFLECT_STRUCT_FIELD(0, byteValue)
+SC_REFLECT_STRUCT_FIELD(1, shortValue)
+SC_REFLECT_STRUCT_FIELD(2, intValue)
+SC_REFLECT_STRUCT_FIELD(3, int64Value)
+SC_REFLECT_STRUCT_FIELD(4, bigValue)
+SC_REFLECT_STRUCT_FIELD(5, floatValue)
+SC_REFLECT_STRUCT_FIELD(6, shorts)
+SC_REFLECT_STRUCT_FIELD(7, counters)
+SC_REFLECT_STRUCT_FIELD(8, entries)
+SC_REFLECT_STRUCT_LEAVE()
+
 struct SC::SerializationBinaryTest : public SC::SerializationSuiteTest::SerializationTest
 {
     SerializationBinaryTest(SC::TestReport& report) : SerializationTest(report, "SerializationBinaryTest")
     {
         runSameVersionTests<SerializationBinary, SerializationBinary>();
         runVersionedTests<SerializationBinary, SerializationBinary, Reflection::Schema>();
+        if (test_section("View"))
+        {
+            view();
+        }
+        if (test_section("Versioned packed items"))
+        {
+            versionedPackedItems();
+        }
+        if (test_section("Compact encoding"))
+        {
+            compactEncoding();
+        }
     }
+
+    void view();
+    void versionedPackedItems();
+    void compactEncoding();
 };
 
+void SC::SerializationBinaryTest::view()
+{
+    static_assert(Reflection::ExtendedTypeInfo<SerializationBinaryLookupEntry>::IsPacked, "Must be packed");
+    //! [serializationBinaryViewSnippet]
+    Vector<SerializationBinaryLookupEntry> table;
+    for (uint32_t idx = 0; idx < 100; ++idx)
+    {
+        SC_TEST_EXPECT(table.push_back({idx, 0.5f, idx * 2.0}));
+    }
+    Buffer buffer; // It could be a memory mapped file or a receive buffer
+    SC_TEST_EXPECT(SerializationBinary::writeWithSchemaHash(table, buffer));
+
+    // Items are accessed directly inside buffer, without decoding or copying them
+    Span<const SerializationBinaryLookupEntry> entries;
+    SC_TEST_EXPECT(SerializationBinary::viewWithSchemaHash<Vector<SerializationBinaryLookupEntry>>(buffer.toSpanConst(),
+                                                                                                  entries));
+    SC_TEST_EXPECT(entries.sizeInElements() == 100);
+    SC_TEST_EXPECT(entries[42].key == 42 and entries[42].weight == 0.5f and entries[42].value == 84.0);
+    SC_TEST_EXPECT(entries.data() == reinterpret_cast<const SerializationBinaryLookupEntry*>(buffer.data() + 16));
+    //! [serializationBinaryViewSnippet]
+
+    // A different schema, a truncated buffer or a misaligned buffer are rejected
+    using SerializationSuiteTest::PrimitiveStruct;
+    Span<const PrimitiveStruct> otherEntries;
+    SC_TEST_EXPECT(not SerializationBinary::viewWithSchemaHash<Vector<PrimitiveStruct>>(buffer.toSpanConst(),
+                                                                                        otherEntries));
+    Span<const char> truncated;
+    SC_TEST_EXPECT(buffer.toSpanConst().sliceStartLength(0, buffer.size() - 1, truncated));
+    SC_TEST_EXPECT(not SerializationBinary::viewWithSchemaHash<Vector<SerializationBinaryLookupEntry>>(truncated,
+                                                                                                      entries));
+    Buffer misaligned;
+    SC_TEST_EXPECT(misaligned.append(StringSpan("x").toCharSpan()) and misaligned.append(buffer.toSpanConst()));
+    Span<const char> shifted;
+    SC_TEST_EXPECT(misaligned.toSpanConst().sliceStart(1, shifted));
+    SC_TEST_EXPECT(not SerializationBinary::viewWithSchemaHash<Vector<SerializationBinaryLookupEntry>>(shifted,
+                                                                                                      entries));
+
+    // Single packed objects can be viewed too
+    SerializationBinaryLookupEntry entry = {7, 1.5f, 3.0};
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationBinary::writeWithSchemaHash(entry, buffer));
+    const SerializationBinaryLookupEntry* viewed = nullptr;
+    SC_TEST_EXPECT(SerializationBinary::viewWithSchemaHash(buffer.toSpanConst(), viewed));
+    SC_TEST_EXPECT(viewed->key == 7 and viewed->weight == 1.5f and viewed->value == 3.0);
+    const PrimitiveStruct* other = nullptr;
+    SC_TEST_EXPECT(not SerializationBinary::viewWithSchemaHash(buffer.toSpanConst(), other));
+
+    // Data written without schema hash
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationBinary::write(table, buffer));
+    SC_TEST_EXPECT(SerializationBinary::viewExact(buffer.toSpanConst(), entries));
+    SC_TEST_EXPECT(entries.sizeInElements() == 100 and entries[99].value == 198.0);
+}
+
+void SC::SerializationBinaryTest::versionedPackedItems()
+{
+    Vector<SerializationBinaryLookupEntry> table;
+    for (uint32_t idx = 0; idx < 100; ++idx)
+    {
+        SC_TEST_EXPECT(table.push_back({idx, 0.5f, idx * 2.0}));
+    }
+    Buffer buffer;
+    SC_TEST_EXPECT(SerializationBinary::write(table, buffer));
+    const Span<const char> data   = buffer.toSpanConst();
+    constexpr auto         schema = Reflection::Schema::compile<Vector<SerializationBinaryLookupEntry>>();
+
+    // Items with the same packed layout are loaded with a single copy
+    Vector<SerializationBinaryLookupEntry> sameLayout;
+    size_t                                 numReads = 0;
+    SC_TEST_EXPECT(SerializationBinary::loadVersioned(sameLayout, data, schema.typeInfos, {}, &numReads));
+    SC_TEST_EXPECT(numReads == 2); // size + items
+    SC_TEST_EXPECT(sameLayout.size() == 100 and sameLayout[99].key == 99 and sameLayout[99].value == 198.0);
+
+    // Items with a different layout are still matched member by member
+    Vector<SerializationBinaryLookupEntry2> otherLayout;
+    SC_TEST_EXPECT(SerializationBinary::loadVersioned(otherLayout, data, schema.typeInfos, {}, &numReads));
+    SC_TEST_EXPECT(numReads == 1 + 100 * 3);
+    SC_TEST_EXPECT(otherLayout.size() == 100 and otherLayout[99].key == 99 and otherLayout[99].value == 198.0);
+    SC_TEST_EXPECT(otherLayout[99].weight == 0.5f and otherLayout[99].extra == 0);
+
+    // Excess items not fitting the destination are dropped after the single copy
+    Array<SerializationBinaryLookupEntry, 10> fixed;
+    SC_TEST_EXPECT(SerializationBinary::loadVersioned(fixed, data, schema.typeInfos, {}, &numReads));
+    SC_TEST_EXPECT(numReads == 2 and fixed.size() == 10 and fixed[9].key == 9 and fixed[9].value == 18.0);
+}
+
+void SC::SerializationBinaryTest::compactEncoding()
+{
+    SerializationBinaryOptions options;
+    options.encoding = SerializationBinaryEncoding::Compact;
+
+    // Varints use 7 bits per byte, with zigzag encoding for signed integers
+    Buffer   buffer;
+    uint32_t unsignedValue = 300;
+    int32_t  signedValue   = -65;
+    SC_TEST_EXPECT(SerializationBinary::write(unsignedValue, buffer, options));
+    SC_TEST_EXPECT(SerializationBinary::write(signedValue, buffer, options));
+    SC_TEST_EXPECT(buffer.size() == 4 and memcmp(buffer.data(), "\xac\x02\x81\x01", 4) == 0);
+
+    // Small integers shrink
+    Vector<int32_t> smallValues;
+    for (int32_t idx = 0; idx < 1000; ++idx)
+    {
+        SC_TEST_EXPECT(smallValues.push_back(idx % 100 - 50));
+    }
+    Buffer nativeBuffer;
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationBinary::write(smallValues, nativeBuffer));
+    SC_TEST_EXPECT(SerializationBinary::write(smallValues, buffer, options));
+    SC_TEST_EXPECT(nativeBuffer.size() == 8 + 4000 and buffer.size() == 2 + 1000);
+
+    SerializationBinaryCompactStruct object;
+    object.intValue = -2;
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationBinary::write(object, buffer, options));
+
+    SerializationBinaryCompactStruct loaded;
+    loaded.byteValue  = 0;
+    loaded.int64Value = 0;
+    loaded.shorts[0]  = 0;
+    loaded.counters.clear();
+    loaded.entries.clear();
+    SC_TEST_EXPECT(SerializationBinary::loadExact(loaded, buffer.toSpanConst(), options));
+    SC_TEST_EXPECT(loaded.byteValue == 200 and loaded.shortValue == 300 and loaded.intValue == -2);
+    SC_TEST_EXPECT(loaded.int64Value == object.int64Value and loaded.bigValue == ~0ull and loaded.floatValue == 1.5f);
+    SC_TEST_EXPECT(loaded.shorts[0] == -64 and loaded.shorts[1] == 64 and loaded.shorts[2] == 0);
+    SC_TEST_EXPECT(loaded.counters.size() == 5 and loaded.counters[3] == 128 and loaded.counters[4] == 16384);
+    SC_TEST_EXPECT(loaded.entries.size() == 2 and loaded.entries[1].key == 2 and loaded.entries[1].value == 4.0);
+
+    // Versioned loading converts and skips varints too
+    constexpr auto schema = Reflection::Schema::compile<SerializationBinaryCompactStruct>();
+    SerializationSuiteTest::VersionedStruct1 versioned1;
+    SerializationSuiteTest::VersionedStruct2 versioned2;
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationBinary::writeWithSchema(versioned1, buffer, options));
+    SC_TEST_EXPECT(SerializationBinary::loadVersionedWithSchema(versioned2, buffer.toSpanConst(), options));
+    SC_TEST_EXPECT(versioned2.int64Value == -13 and versioned2.floatValue == 1.5f);
+
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationBinary::write(object, buffer, options));
+    SerializationBinaryLookupEntry2 partial; // Only shares tags 0,1,2,3 with different types
+    SC_TEST_EXPECT(SerializationBinary::loadVersioned(partial, buffer.toSpanConst(), schema.typeInfos, options));
+    SC_TEST_EXPECT(partial.key == 200 and partial.weight == 300.0f and partial.value == -2.0);
+
+    // Truncated data, overlong or non-canonical varints or values not fitting destination type are rejected
+    Span<const char> truncated;
+    SC_TEST_EXPECT(buffer.toSpanConst().sliceStartLength(0, buffer.size() - 1, truncated));
+    SC_TEST_EXPECT(not SerializationBinary::loadExact(loaded, truncated, options));
+    uint16_t shortValue = 0;
+    SC_TEST_EXPECT(not SerializationBinary::loadExact(shortValue, StringSpan("\x80\x80\x04").toCharSpan(), options));
+    uint64_t longValue = 0;
+    constexpr StringSpan overlong = "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02";
+    SC_TEST_EXPECT(not SerializationBinary::loadExact(longValue, overlong.toCharSpan(), options));
+    const char nonCanonical[] = {'\x80', '\x00'}; // Zero with a redundant trailing byte
+    SC_TEST_EXPECT(not SerializationBinary::loadExact(longValue, {nonCanonical, sizeof(nonCanonical)}, options));
+    const char zero[] = {'\x00'};
+    SC_TEST_EXPECT(SerializationBinary::loadExact(longValue, {zero, sizeof(zero)}, options) and longValue == 0);
+}
+
 namespace SC
 {
 void runSerializationBinaryTest(SC::TestReport& report) { SerializationBinaryTest test(report); }
@@ -1,7 +1,12 @@
 // Copyright (c) Stefano Cristiano
 // SPDX-License-Identifier: MIT
 #include "Libraries/SerializationText/Internal/JsonTokenizer.h"
+#include "Libraries/Containers/Vector.h"
+#include "Libraries/Memory/Buffer.h"
+#include "Libraries/Memory/String.h"
+#include "Libraries/Strings/StringBuilder.h"
 #include "Libraries/Testing/Testing.h"
+#include "Libraries/Time/Time.h"
 
 namespace SC
 {
@@ -169,6 +174,214 @@ struct SC::JsonTokenizerTest : public SC::TestCase
             SC_TEST_EXPECT(testTokenizeEndOfInput("{}   "));
             SC_TEST_EXPECT(testInvalidTokenResetsState("{_}"));
         }
+        if (test_section("structural index"))
+        {
+            testStructuralIndexMatchesReference();
+            testStructuralIndexTokens();
+        }
+        if (test_section("structural index benchmark", Execute::OnlyExplicit))
+        {
+            benchmarkStructuralIndex();
+        }
+    }
+
+    // Character by character equivalent of JsonTokenizer::buildStructuralIndex
+    static size_t buildReferenceIndex(StringSpan text, uint32_t* structurals)
+    {
+        const char* bytes = text.bytesWithoutTerminator();
+
+        size_t numStructurals = 0;
+        bool   inString       = false;
+        bool   escaped        = false;
+        bool   prevScalar     = false;
+        for (size_t idx = 0; idx < text.sizeInBytes(); ++idx)
+        {
+            const char current = bytes[idx];
+            const bool isQuote = current == '"' and not escaped;
+            escaped            = current == '\\' and not escaped;
+            if (isQuote)
+            {
+                structurals[numStructurals++] = static_cast<uint32_t>(idx);
+                inString                      = not inString;
+                prevScalar                    = false;
+            }
+            else if (inString)
+            {
+                continue;
+            }
+            else if (current == '{' or current == '}' or current == '[' or current == ']' or current == ':' or
+                     current == ',')
+            {
+                structurals[numStructurals++] = static_cast<uint32_t>(idx);
+                prevScalar                    = false;
+            }
+            else if (isWhitespace(current))
+            {
+                prevScalar = false;
+            }
+            else
+            {
+                if (not prevScalar)
+                {
+                    structurals[numStructurals++] = static_cast<uint32_t>(idx);
+                }
+                prevScalar = true;
+            }
+        }
+        return numStructurals;
+    }
+
+    static constexpr bool isWhitespace(char character) { return JsonTokenizer::isWhitespace(character); }
+
+    void testStructuralIndexMatchesReference()
+    {
+        // Random texts biased towards characters changing tokenizer state, crossing multiple 64 bytes blocks
+        constexpr char alphabet[] = "{}[]:,\"\"\\\\\\ \t\na1";
+
+        char     text[300];
+        uint32_t expected[300];
+        uint32_t structurals[300];
+        uint32_t seed = 1234;
+        for (int iteration = 0; iteration < 5000; ++iteration)
+        {
+            seed                 = seed * 1664525u + 1013904223u;
+            const size_t length = (seed >> 8) % sizeof(text);
+            for (size_t idx = 0; idx < length; ++idx)
+            {
+                seed      = seed * 1664525u + 1013904223u;
+                text[idx] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+            }
+            const StringSpan textSpan({text, length}, false, StringEncoding::Ascii);
+
+            size_t numStructurals = 0;
+            SC_TEST_EXPECT(JsonTokenizer::buildStructuralIndex(textSpan, structurals, numStructurals));
+            const size_t numExpected = buildReferenceIndex(textSpan, expected);
+            SC_TEST_EXPECT(numStructurals == numExpected);
+            for (size_t idx = 0; idx < numStructurals and idx < numExpected; ++idx)
+            {
+                if (structurals[idx] != expected[idx])
+                {
+                    SC_TEST_EXPECT(structurals[idx] == expected[idx]);
+                    return;
+                }
+            }
+        }
+        size_t numStructurals = 0;
+        SC_TEST_EXPECT(not JsonTokenizer::buildStructuralIndex("{}", {structurals, 1}, numStructurals));
+    }
+
+    // Checks that walking the structural index generates the same tokens as the character by character tokenizer
+    [[nodiscard]] static bool sameTokens(StringSpan text, Span<uint32_t> structurals)
+    {
+        size_t numStructurals = 0;
+        SC_TRY(JsonTokenizer::buildStructuralIndex(text, structurals, numStructurals));
+
+        JsonTokenizer::Cursor scalarIt(text);
+        JsonTokenizer::Cursor indexedIt(text, {structurals.data(), numStructurals});
+        JsonTokenizer::Token  scalarToken, indexedToken;
+        while (JsonTokenizer::tokenizeNext(scalarIt, scalarToken))
+        {
+            SC_TRY(JsonTokenizer::tokenizeNext(indexedIt, indexedToken));
+            SC_TRY(scalarToken.getType() == indexedToken.getType());
+            SC_TRY(scalarToken.getToken(text) == indexedToken.getToken(text));
+        }
+        return not JsonTokenizer::tokenizeNext(indexedIt, indexedToken);
+    }
+
+    void testStructuralIndexTokens()
+    {
+        uint32_t structurals[256];
+        SC_TEST_EXPECT(sameTokens("", structurals));
+        SC_TEST_EXPECT(sameTokens(" { \n\t} ", structurals));
+        SC_TEST_EXPECT(sameTokens("{  \"x\"\t   :   \t1.2\t  }", structurals));
+        SC_TEST_EXPECT(sameTokens("{\"x\":1,\"y\":[true,false,null]}", structurals));
+        SC_TEST_EXPECT(sameTokens("\"A\\\"B\"", structurals));
+        SC_TEST_EXPECT(sameTokens("\"A\\\\\"B", structurals));
+        SC_TEST_EXPECT(sameTokens("\"ASD\"\"", structurals));
+        SC_TEST_EXPECT(sameTokens("\"ASD", structurals));
+        SC_TEST_EXPECT(sameTokens("{_}", structurals));
+        SC_TEST_EXPECT(sameTokens("{\"string with {[:,]} and an escaped \\\" quote spanning over the first block\": "
+                                  "[1, 2.5,\"\\\\\", \"\\\\\\\"\"], \"other\"  : null, \"last\":false}",
+                                  structurals));
+
+        // Garbage following a literal is not split into its own token, so the literal itself becomes invalid
+        constexpr StringSpan garbage        = "truex";
+        size_t               numStructurals = 0;
+        JsonTokenizer::Token token;
+        SC_TEST_EXPECT(JsonTokenizer::buildStructuralIndex(garbage, structurals, numStructurals));
+        JsonTokenizer::Cursor it(garbage, {structurals, numStructurals});
+        SC_TEST_EXPECT(JsonTokenizer::tokenizeNext(it, token));
+        SC_TEST_EXPECT(token.getType() == JsonTokenizer::Token::Invalid);
+    }
+
+    void benchmarkStructuralIndex()
+    {
+        constexpr StringSpan record = "{\"id\": 12345, \"name\": \"A \\\"quoted\\\" name\", \"ratio\": 0.75, "
+                                      "\"tags\": [\"alpha\", \"beta\", \"gamma\"], \"active\": true, "
+                                      "\"message\": \"request completed after retrying the upstream\"},\n";
+        constexpr size_t     numRecords = 100000;
+        constexpr int        iterations = 10;
+
+        Buffer text;
+        bool   appended = text.append(StringSpan("[").toCharSpan());
+        for (size_t idx = 0; idx < numRecords; ++idx)
+        {
+            appended = appended and text.append(record.toCharSpan());
+        }
+        SC_TEST_EXPECT(appended and text.append(StringSpan("{}]").toCharSpan()));
+        const StringSpan json({text.data(), text.size()}, false, StringEncoding::Ascii);
+
+        Vector<uint32_t> structurals;
+        SC_TEST_EXPECT(structurals.resize(json.sizeInBytes()));
+
+        size_t scalarTokens  = 0;
+        size_t indexedTokens = 0;
+
+        Time::HighResolutionCounter start;
+        start.snap();
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            JsonTokenizer::Cursor it(json);
+            JsonTokenizer::Token  token;
+            while (JsonTokenizer::tokenizeNext(it, token))
+                scalarTokens++;
+        }
+        Time::HighResolutionCounter scalarEnd;
+        scalarEnd.snap();
+
+        Time::Nanoseconds indexNs;
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            Time::HighResolutionCounter indexStart;
+            indexStart.snap();
+            size_t numStructurals = 0;
+            SC_TEST_EXPECT(JsonTokenizer::buildStructuralIndex(json, structurals.toSpan(), numStructurals));
+            Time::HighResolutionCounter indexEnd;
+            indexEnd.snap();
+            indexNs.ns += indexEnd.subtractExact(indexStart).toNanoseconds().ns;
+
+            JsonTokenizer::Cursor it(json, {structurals.data(), numStructurals});
+            JsonTokenizer::Token  token;
+            while (JsonTokenizer::tokenizeNext(it, token))
+                indexedTokens++;
+        }
+        Time::HighResolutionCounter indexedEnd;
+        indexedEnd.snap();
+        SC_TEST_EXPECT(scalarTokens == indexedTokens);
+
+        const double totalBytes = static_cast<double>(json.sizeInBytes()) * iterations;
+        const auto   toGBs      = [totalBytes](int64_t ns)
+        { return totalBytes / static_cast<double>(ns > 0 ? ns : 1); };
+        String reportString;
+        SC_ASSERT_RELEASE(StringBuilder::create(reportString)
+                              .append("JsonTokenizer benchmark: bytes={} iterations={} tokens={}\n"
+                                      "  scalar tokenizer  {:.2} GB/s\n"
+                                      "  structural index  {:.2} GB/s\n"
+                                      "  indexed tokenizer {:.2} GB/s (index + tokenization)\n",
+                                      json.sizeInBytes(), iterations, scalarTokens / iterations,
+                                      toGBs(scalarEnd.subtractExact(start).toNanoseconds().ns), toGBs(indexNs.ns),
+                                      toGBs(indexedEnd.subtractExact(scalarEnd).toNanoseconds().ns)));
+        report.console.print(reportString.view());
     }
 };
 
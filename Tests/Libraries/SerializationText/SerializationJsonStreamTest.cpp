@@ -0,0 +1,304 @@
+// Copyright (c) Stefano Cristiano
+// SPDX-License-Identifier: MIT
+#include "Libraries/SerializationText/SerializationJsonStream.h"
+#include "Libraries/AsyncStreams/AsyncStreams.h"
+#include "Libraries/ContainersReflection/MemorySerialization.h"
+#include "Libraries/Memory/Buffer.h"
+#include "Libraries/Testing/Testing.h"
+
+#include <stdio.h>  // snprintf
+#include <string.h> // memcpy
+
+namespace SC
+{
+struct SerializationJsonStreamTest;
+struct JsonStreamRecord;
+} // namespace SC
+
+struct SC::JsonStreamRecord
+{
+    int    id = 0;
+    String name;
+};
+SC_REFLECT_STRUCT_VISIT(SC::JsonStreamRecord)
+SC_REFLECT_STRUCT_FIELD(0, id)
+SC_REFLECT_STRUCT_FIELD(1, name)
+SC_REFLECT_STRUCT_LEAVE()
+
+struct SC::SerializationJsonStreamTest : public SC::TestCase
+{
+    SerializationJsonStreamTest(SC::TestReport& report) : TestCase(report, "SerializationJsonStreamTest")
+    {
+        if (test_section("events"))
+        {
+            events();
+        }
+        if (test_section("invalid documents"))
+        {
+            invalidDocuments();
+        }
+        if (test_section("capture values"))
+        {
+            captureValues();
+        }
+        if (test_section("AsyncReadableStream"))
+        {
+            asyncReadableStream();
+        }
+    }
+
+    void events();
+    void invalidDocuments();
+    void captureValues();
+    void asyncReadableStream();
+
+    // Records every event in a compact text form
+    struct TraceListener : public JsonStreamListener
+    {
+        Buffer trace;
+
+        bool add(StringSpan prefix, StringSpan text = {})
+        {
+            return trace.append(prefix.toCharSpan()) and trace.append(text.toCharSpan()) and
+                   trace.append(StringSpan(" ").toCharSpan());
+        }
+        virtual bool onObjectStart() override { return add("{"); }
+        virtual bool onObjectEnd() override { return add("}"); }
+        virtual bool onArrayStart() override { return add("["); }
+        virtual bool onArrayEnd() override { return add("]"); }
+        virtual bool onKey(StringSpan key) override { return add("k:", key); }
+        virtual bool onString(StringSpan value) override { return add("s:", value); }
+        virtual bool onNumber(StringSpan number) override { return add("n:", number); }
+        virtual bool onBoolean(bool value) override { return add(value ? StringSpan("true") : StringSpan("false")); }
+        virtual bool onNull() override { return add("null"); }
+        virtual bool onValue(StringSpan json) override { return add("v:", json); }
+
+        StringSpan view() const { return StringSpan({trace.data(), trace.size()}, false, StringEncoding::Utf8); }
+    };
+
+    // Parses the document in chunks of the given size
+    static Result parseInChunks(JsonStreamReader& reader, StringSpan json, size_t chunkSize)
+    {
+        const char*  data = json.bytesWithoutTerminator();
+        const size_t size = json.sizeInBytes();
+        for (size_t offset = 0; offset < size; offset += chunkSize)
+        {
+            const size_t length = offset + chunkSize < size ? chunkSize : size - offset;
+            SC_TRY(reader.write({data + offset, length}));
+        }
+        return reader.end();
+    }
+};
+
+void SC::SerializationJsonStreamTest::events()
+{
+    constexpr StringSpan json =
+        R"( {"name" : "caf\u00e9 \"\ud83d\ude00\"", "list":[1, -2.5e3, true, false, null, [], {}],"x":{"y":"z"}} )";
+    constexpr StringSpan expected = "{ k:name s:caf\xc3\xa9 \"\xf0\x9f\x98\x80\" k:list [ n:1 n:-2.5e3 true false null "
+                                    "[ ] { } ] k:x { k:y s:z } } ";
+
+    // Same events must be generated regardless of how the document is split
+    bool allMatching = true;
+    for (size_t chunkSize = 1; chunkSize <= json.sizeInBytes(); ++chunkSize)
+    {
+        char             buffer[32];
+        TraceListener    listener;
+        JsonStreamReader reader;
+        SC_TEST_EXPECT(reader.init(listener, buffer));
+        allMatching = allMatching and parseInChunks(reader, json, chunkSize) and listener.view() == expected;
+        allMatching = allMatching and reader.getNumBytesParsed() == json.sizeInBytes() and reader.getDepth() == 0;
+    }
+    SC_TEST_EXPECT(allMatching);
+
+    // Scalar root values are terminated by the end of the document
+    char             buffer[8];
+    TraceListener    listener;
+    JsonStreamReader reader;
+    SC_TEST_EXPECT(reader.init(listener, buffer));
+    SC_TEST_EXPECT(parseInChunks(reader, "12345", 2));
+    SC_TEST_EXPECT(listener.view() == "n:12345 ");
+}
+
+void SC::SerializationJsonStreamTest::invalidDocuments()
+{
+    constexpr StringSpan invalid[] = {
+        "",      "{",           "[1,]",      "{\"a\" 1}",    "{\"a\":1,}", "[1 2]",        "[01]",  "[1.]",
+        "[-]",   "[1e]",        "[tru]",     "[nulll]",      "{1:2}",      "[\"\\x\"]",    "[}",    "{]",
+        "[1]]",  "[1] [2]",     "[\"a\nb\"]", "[\"\\ud83d\"]", "\"open",    "[\"\\u00zz\"]", "+1",   "[.5]",
+    };
+    bool allFailed = true;
+    for (StringSpan json : invalid)
+    {
+        char             buffer[16];
+        TraceListener    listener;
+        JsonStreamReader reader;
+        SC_TEST_EXPECT(reader.init(listener, buffer));
+        allFailed = allFailed and not parseInChunks(reader, json, 1);
+        SC_TEST_EXPECT(reader.init(listener, buffer));
+        allFailed = allFailed and not parseInChunks(reader, json, 64);
+    }
+    SC_TEST_EXPECT(allFailed);
+
+    char             buffer[4];
+    TraceListener    listener;
+    JsonStreamReader reader;
+
+    // Tokens fitting in a chunk are not copied, while split ones must fit the buffer
+    SC_TEST_EXPECT(reader.init(listener, buffer));
+    SC_TEST_EXPECT(parseInChunks(reader, "[\"long string\"]", 64));
+    SC_TEST_EXPECT(reader.init(listener, buffer));
+    SC_TEST_EXPECT(not parseInChunks(reader, "[\"long string\"]", 5));
+
+    // Listeners can stop parsing and further writes fail
+    struct StoppingListener : public JsonStreamListener
+    {
+        virtual bool onNumber(StringSpan) override { return false; }
+    } stopping;
+    SC_TEST_EXPECT(reader.init(stopping, buffer));
+    SC_TEST_EXPECT(not reader.write(StringSpan("[1,").toCharSpan()));
+    SC_TEST_EXPECT(not reader.write(StringSpan("2]").toCharSpan()));
+}
+
+void SC::SerializationJsonStreamTest::captureValues()
+{
+    //! [serializationJsonStreamSnippet]
+    // Loads each element of a root array with SerializationJson as soon as it has been fully received
+    struct RecordsListener : public JsonStreamListener
+    {
+        size_t numRecords = 0;
+        bool   allValid   = true;
+
+        virtual bool onValue(StringSpan json) override
+        {
+            JsonStreamRecord record;
+            if (not SerializationJson::loadExact(record, json))
+                return false;
+            allValid = allValid and record.id == static_cast<int>(numRecords) and record.name == "record";
+            numRecords++;
+            return true;
+        }
+    } listener;
+
+    char             buffer[64]; // Must only hold a single record split between two chunks
+    JsonStreamReader reader;
+    SC_TEST_EXPECT(reader.init(listener, buffer, 1)); // Capture values at depth 1 (elements of root array)
+
+    SC_TEST_EXPECT(reader.write(StringSpan("[").toCharSpan()));
+    for (int idx = 0; idx < 1000; ++idx)
+    {
+        char       record[64];
+        const int  length = ::snprintf(record, sizeof(record), "%s{\"id\":%d,\"name\":\"record\"}", //
+                                       idx > 0 ? "," : "", idx);
+        const size_t half = static_cast<size_t>(length) / 2;
+        // Split each record in two chunks, simulating data arriving from the network
+        SC_TEST_EXPECT(reader.write({record, half}));
+        SC_TEST_EXPECT(reader.write({record + half, static_cast<size_t>(length) - half}));
+    }
+    SC_TEST_EXPECT(reader.write(StringSpan("]").toCharSpan()));
+    SC_TEST_EXPECT(reader.end());
+    SC_TEST_EXPECT(listener.numRecords == 1000 and listener.allValid);
+    //! [serializationJsonStreamSnippet]
+
+    // Captured scalars and nested containers, with keys of the root object still delivered as events
+    constexpr StringSpan json     = R"({"a":[1,{"b":"}"}],"c":"x\"y","d":-12})";
+    constexpr StringSpan expected = R"({ k:a v:[1,{"b":"}"}] k:c v:"x\"y" k:d v:-12 } )";
+
+    bool allMatching = true;
+    for (size_t chunkSize = 1; chunkSize <= json.sizeInBytes(); ++chunkSize)
+    {
+        TraceListener traceListener;
+        SC_TEST_EXPECT(reader.init(traceListener, buffer, 1));
+        allMatching = allMatching and parseInChunks(reader, json, chunkSize) and traceListener.view() == expected;
+    }
+    SC_TEST_EXPECT(allMatching);
+}
+
+void SC::SerializationJsonStreamTest::asyncReadableStream()
+{
+    constexpr size_t numberOfBuffers = 2;
+    constexpr size_t bufferBytesSize = 5;
+    char             memory[numberOfBuffers * bufferBytesSize];
+    AsyncBufferView  buffers[numberOfBuffers];
+    for (size_t idx = 0; idx < numberOfBuffers; ++idx)
+    {
+        buffers[idx] = Span<char>(memory + idx * bufferBytesSize, bufferBytesSize);
+        buffers[idx].setReusable(true);
+    }
+    AsyncBuffersPool pool;
+    pool.setBuffers(buffers);
+
+    // Produces the document in small slices, like a network body
+    struct DocumentReadableStream : public AsyncReadableStream
+    {
+        StringSpan document;
+        size_t     offset = 0;
+
+        virtual Result asyncRead() override
+        {
+            if (offset < document.sizeInBytes())
+            {
+                AsyncBufferView::ID bufferID;
+                Span<char>          data;
+                if (getBufferOrPause(bufferBytesSize, bufferID, data))
+                {
+                    size_t length = document.sizeInBytes() - offset;
+                    length        = length < data.sizeInBytes() ? length : data.sizeInBytes();
+                    ::memcpy(data.data(), document.bytesWithoutTerminator() + offset, length);
+                    offset += length;
+                    SC_TRY(push(bufferID, length));
+                    getBuffersPool().unrefBuffer(bufferID);
+                    reactivate(true);
+                }
+            }
+            else
+            {
+                pushEnd();
+            }
+            return Result(true);
+        }
+    };
+
+    struct EndListener : public TraceListener
+    {
+        int numEnds   = 0;
+        int numErrors = 0;
+
+        virtual void onEnd() override { numEnds++; }
+        virtual void onError(Result) override { numErrors++; }
+    };
+
+    const StringSpan documents[] = {R"({"values":[1,2,3],"text":"streamed"})", R"({"values":[1,2,3],"text":)"};
+    for (const StringSpan document : documents)
+    {
+        DocumentReadableStream       readable;
+        AsyncReadableStream::Request requests[numberOfBuffers + 1];
+        readable.document = document;
+        readable.setReadQueue(requests);
+        SC_TEST_EXPECT(readable.init(pool));
+
+        char             buffer[16];
+        EndListener      listener;
+        JsonStreamReader reader;
+        SC_TEST_EXPECT(reader.init(listener, buffer));
+        JsonStreamReaderAsyncT<AsyncReadableStream> binding;
+        SC_TEST_EXPECT(binding.attach(reader, readable));
+        SC_TEST_EXPECT(not binding.attach(reader, readable));
+        SC_TEST_EXPECT(readable.start());
+        SC_TEST_EXPECT(readable.isEnded());
+        if (document == documents[0])
+        {
+            SC_TEST_EXPECT(listener.numEnds == 1 and listener.numErrors == 0);
+            SC_TEST_EXPECT(listener.view() == "{ k:values [ n:1 n:2 n:3 ] k:text s:streamed } ");
+        }
+        else
+        {
+            SC_TEST_EXPECT(listener.numEnds == 0 and listener.numErrors == 1);
+        }
+        SC_TEST_EXPECT(binding.detach()); // Already detached by end of stream
+    }
+}
+
+namespace SC
+{
+void runSerializationJsonStreamTest(SC::TestReport& report) { SerializationJsonStreamTest test(report); }
+} // namespace SC
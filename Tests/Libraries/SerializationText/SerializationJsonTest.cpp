@@ -14,6 +14,7 @@ struct EscapedStringTest;
 struct BorrowedStringTest;
 struct VersionedVectorItem;
 struct VersionedVectorTest;
+struct NumbersTest;
 } // namespace SC
 
 //! [serializationJsonSnippet1]
@@ -83,6 +84,24 @@ SC_REFLECT_STRUCT_LEAVE()
 
 //! [serializationJsonSnippet1]
 
+struct SC::NumbersTest
+{
+    double tenth    = 0.1;
+    double large    = 1e21;
+    double smallest = -5e-324;
+    float  maximum  = 3.4028235e38f;
+    float  third    = 1.0f / 3.0f;
+    int    minimum  = -2147483647 - 1;
+};
+SC_REFLECT_STRUCT_VISIT(SC::NumbersTest)
+SC_REFLECT_STRUCT_FIELD(0, tenth)
+SC_REFLECT_STRUCT_FIELD(1, large)
+SC_REFLECT_STRUCT_FIELD(2, smallest)
+SC_REFLECT_STRUCT_FIELD(3, maximum)
+SC_REFLECT_STRUCT_FIELD(4, third)
+SC_REFLECT_STRUCT_FIELD(5, minimum)
+SC_REFLECT_STRUCT_LEAVE()
+
 namespace SC
 {
 struct SerializationJsonTest;
@@ -93,6 +112,8 @@ struct SC::SerializationJsonTest : public SC::TestCase
     inline void jsonWrite();
     inline void jsonLoadExact();
     inline void jsonLoadVersioned();
+    inline void jsonLoadStructuralIndex();
+    inline void jsonNumbers();
     SerializationJsonTest(SC::TestReport& report) : TestCase(report, "SerializationJsonTest")
     {
         if (test_section("SerializationJson::write"))
@@ -107,6 +128,14 @@ struct SC::SerializationJsonTest : public SC::TestCase
         {
             jsonLoadVersioned();
         }
+        if (test_section("SerializationJson::structural index"))
+        {
+            jsonLoadStructuralIndex();
+        }
+        if (test_section("SerializationJson::numbers"))
+        {
+            jsonNumbers();
+        }
     }
 };
 
@@ -114,7 +143,7 @@ void SC::SerializationJsonTest::jsonWrite()
 {
     //! [serializationJsonWriteSnippet]
     //! [serializationJsonBasicWriteSnippet]
-    constexpr StringView testJSON = R"({"x":2,"y":1.50,"xy":[1,3],"myTest":"asdf","myVector":["Str1","Str2"]})"_a8;
+    constexpr StringView testJSON = R"({"x":2,"y":1.5,"xy":[1,3],"myTest":"asdf","myVector":["Str1","Str2"]})"_a8;
 
     SmallBuffer<256> buffer;
 
@@ -187,6 +216,16 @@ void SC::SerializationJsonTest::jsonLoadVersioned()
     SC_TEST_EXPECT(test == Test());
     //! [serializationJsonBasicVersionedSnippet]
 
+    constexpr StringView partialJson = R"({"myTest":"asdf", "x": 5})"_a8;
+    SC_TEST_EXPECT(SerializationJson::loadVersioned(test, partialJson));
+    SC_TEST_EXPECT(test.x == 5 and test.myTest == "asdf");
+    constexpr StringView unknownFieldJson   = R"({"x": 2, "z": 1})"_a8;
+    constexpr StringView prefixedFieldJson  = R"({"x": 2, "myTes": "asdf"})"_a8;
+    constexpr StringView caseMismatchedJson = R"({"X": 2})"_a8;
+    SC_TEST_EXPECT(not SerializationJson::loadVersioned(test, unknownFieldJson));
+    SC_TEST_EXPECT(not SerializationJson::loadVersioned(test, prefixedFieldJson));
+    SC_TEST_EXPECT(not SerializationJson::loadVersioned(test, caseMismatchedJson));
+
     constexpr StringView escapedJSON = R"({"value":"quote\"slash\\line\nunicode \u0041"})"_a8;
     EscapedStringTest    escaped;
     SC_TEST_EXPECT(SerializationJson::loadVersioned(escaped, escapedJSON));
@@ -212,7 +251,82 @@ void SC::SerializationJsonTest::jsonLoadVersioned()
     //! [serializationJsonLoadVersionedSnippet]
 }
 
+void SC::SerializationJsonTest::jsonLoadStructuralIndex()
+{
+    uint32_t structurals[128];
+
+    constexpr StringView testJSON = R"({"x":2,"y":1.50,"xy":[1,3],"myTest":"asdf","myVector":["Str1","Str2"]})"_a8;
+    Test                 test;
+    test.x      = 1;
+    test.myTest = "KFDOK";
+    SC_TEST_EXPECT(SerializationJson::loadExact(test, testJSON, structurals));
+    SC_TEST_EXPECT(test == Test());
+
+    constexpr StringView scrambledJson =
+        R"({"y"  :  1.50, "x": 2.0, "myVector"  :  ["Str1","Str2"], "myTest":"asdf"})"_a8;
+    test.x = 0;
+    (void)test.myVector.resize(1);
+    SC_TEST_EXPECT(SerializationJson::loadVersioned(test, scrambledJson, structurals));
+    SC_TEST_EXPECT(test == Test());
+
+    constexpr StringView escapedJSON = R"({"value":"quote\"slash\\line\nunicode \u0041"})"_a8;
+    EscapedStringTest    escaped;
+    SC_TEST_EXPECT(SerializationJson::loadVersioned(escaped, escapedJSON, structurals));
+    SC_TEST_EXPECT(escaped.value == "quote\"slash\\line\nunicode A");
+
+    constexpr StringView versionedVectorJSON = R"({"items":[{"second":"b","first":1},{"second":"c","first":2}]})"_a8;
+    VersionedVectorTest  versionedVector;
+    SC_TEST_EXPECT(SerializationJson::loadVersioned(versionedVector, versionedVectorJSON, structurals));
+    SC_TEST_EXPECT(versionedVector.items.size() == 2);
+    SC_TEST_EXPECT(versionedVector.items[1].second == "c");
+
+    // Index memory must hold at least one entry per byte of the json text
+    SC_TEST_EXPECT(not SerializationJson::loadVersioned(versionedVector, versionedVectorJSON, {structurals, 16}));
+}
+
 namespace SC
 {
 void runSerializationJsonTest(SC::TestReport& report) { SerializationJsonTest test(report); }
 } // namespace SC
+
+void SC::SerializationJsonTest::jsonNumbers()
+{
+    // Floating points are written with the shortest digits that read back to the exact same value
+    constexpr StringView numbersJSON = R"({"tenth":0.1,"large":1e+21,"smallest":-5e-324,"maximum":3.4028235e+38,)"
+                                       R"("third":0.33333334,"minimum":-2147483648})"_a8;
+
+    SmallBuffer<256> buffer;
+    NumbersTest      numbers;
+    SC_TEST_EXPECT(SerializationJson::write(numbers, buffer));
+    const StringView serializedJSON({buffer.data(), buffer.size()}, false, StringEncoding::Ascii);
+    SC_TEST_EXPECT(serializedJSON == numbersJSON);
+
+    NumbersTest loaded;
+    loaded.tenth    = 0;
+    loaded.large    = 0;
+    loaded.smallest = 0;
+    loaded.maximum  = 0;
+    loaded.third    = 0;
+    loaded.minimum  = 0;
+    SC_TEST_EXPECT(SerializationJson::loadExact(loaded, numbersJSON));
+    SC_TEST_EXPECT(loaded.tenth == numbers.tenth and loaded.large == numbers.large);
+    SC_TEST_EXPECT(loaded.smallest == numbers.smallest and loaded.maximum == numbers.maximum);
+    SC_TEST_EXPECT(loaded.third == numbers.third and loaded.minimum == numbers.minimum);
+
+    // Fixed digits can still be requested explicitly
+    SerializationJson::Options options;
+    options.floatDigits = 2;
+    buffer.clear();
+    SC_TEST_EXPECT(SerializationJson::write(numbers, buffer, options));
+    const StringView fixedJSON({buffer.data(), buffer.size()}, false, StringEncoding::Ascii);
+    SC_TEST_EXPECT(fixedJSON.startsWith(R"({"tenth":0.10,)"_a8));
+
+    // JSON has no representation for nan or infinities, and numbers must be entirely valid
+    numbers.tenth = numbers.tenth - numbers.tenth + numbers.large * numbers.large * numbers.large * 1e300;
+    buffer.clear();
+    SC_TEST_EXPECT(not SerializationJson::write(numbers, buffer));
+    SC_TEST_EXPECT(not SerializationJson::loadExact(loaded, R"({"tenth":1.2.3})"_a8));
+    SC_TEST_EXPECT(not SerializationJson::loadExact(loaded, R"({"tenth":1e})"_a8));
+    SC_TEST_EXPECT(not SerializationJson::loadExact(loaded, R"({"tenth":0.1,"large":1,"smallest":1,"maximum":1,)"
+                                                             R"("third":1,"minimum":2147483648})"_a8));
+}
@@ -17,6 +17,7 @@ struct SC::SocketTest : public SC::TestCase
     inline void socketCreate();
     inline void socketClientServer(SocketFlags::SocketType socketType, SocketFlags::ProtocolType protocol);
     inline void socketMulticast();
+    inline void socketOptions();
 
     inline Result socketServerSnippet();
     inline Result socketClientAcceptSnippet();
@@ -49,6 +50,10 @@ struct SC::SocketTest : public SC::TestCase
         {
             socketMulticast();
         }
+        if (test_section("socket options"))
+        {
+            socketOptions();
+        }
     }
 };
 
@@ -179,6 +184,13 @@ void SC::SocketTest::socketClientServer(SocketFlags::SocketType socketType, Sock
     SC_TEST_EXPECT(acceptedClient.read({buf, sizeof(buf)}, readData));
     SC_TEST_EXPECT(buf[0] == testValue and testValue != 0);
     SC_TEST_EXPECT(not acceptedClient.readWithTimeout({buf, sizeof(buf)}, readData, 10));
+    if (protocol == SocketFlags::ProtocolTcp)
+    {
+        bool peerClosed     = true;
+        bool hasPendingData = true;
+        SC_TEST_EXPECT(acceptedClient.probeConnection(peerClosed, hasPendingData));
+        SC_TEST_EXPECT(not peerClosed and not hasPendingData);
+    }
     params.eventObject.signal();
     SC_TEST_EXPECT(acceptedClient.readWithTimeout({buf, sizeof(buf)}, readData, 10 * 1000));
     SC_TEST_EXPECT(buf[0] == testValue + 1);
@@ -260,6 +272,83 @@ void SC::SocketTest::socketMulticast()
     SC_TEST_EXPECT(receiverSocket.close());
 }
 
+void SC::SocketTest::socketOptions()
+{
+    //! [socketOptionsSnippet]
+    SocketDescriptor serverSocket;
+    SC_TEST_EXPECT(serverSocket.create(SocketFlags::AddressFamilyIPV4));
+
+    SocketOptions options;
+    options.receiveBufferSize = 256 * 1024;
+    options.sendBufferSize    = 256 * 1024;
+    options.tcpNoDelay        = true;
+#if !SC_PLATFORM_WINDOWS
+    options.reusePort = true; // Other sockets can bind the same port to share the incoming connections
+#endif
+#if SC_PLATFORM_LINUX
+    options.tcpFastOpenQueueLength = 16; // Accept data in the SYN of connections from known clients
+    options.tcpDeferAcceptSeconds  = 1;  // Wake up accept only when the request has arrived
+#endif
+    SC_TEST_EXPECT(serverSocket.setOptions(options));
+
+    SocketIPAddress address;
+    SC_TEST_EXPECT(address.fromAddressPort("127.0.0.1", report.mapPort(5057)));
+    SocketServer server(serverSocket);
+    SC_TEST_EXPECT(server.bind(address));
+    SC_TEST_EXPECT(server.listen(16));
+    //! [socketOptionsSnippet]
+
+    // OS can round or double buffer sizes, but never go below the requested ones (when allowed by system limits)
+    int numBytes = 0;
+    SC_TEST_EXPECT(serverSocket.getReceiveBufferSize(numBytes) and numBytes >= 128 * 1024);
+    SC_TEST_EXPECT(serverSocket.getSendBufferSize(numBytes) and numBytes >= 128 * 1024);
+
+    bool enabled = false;
+    SC_TEST_EXPECT(serverSocket.getTcpNoDelay(enabled) and enabled);
+    SC_TEST_EXPECT(serverSocket.setTcpNoDelay(false));
+    SC_TEST_EXPECT(serverSocket.getTcpNoDelay(enabled) and not enabled);
+
+    int value = 0;
+#if !SC_PLATFORM_WINDOWS
+    SC_TEST_EXPECT(serverSocket.getReusePort(enabled) and enabled);
+
+    // A second socket with SO_REUSEPORT can bind the same address and port
+    SocketDescriptor secondSocket;
+    SC_TEST_EXPECT(secondSocket.create(SocketFlags::AddressFamilyIPV4));
+    SC_TEST_EXPECT(secondSocket.setReusePort(true));
+    SC_TEST_EXPECT(SocketServer(secondSocket).bind(address));
+    SC_TEST_EXPECT(secondSocket.close());
+
+    SocketDescriptor clientSocket;
+    SC_TEST_EXPECT(clientSocket.create(SocketFlags::AddressFamilyIPV4));
+    SC_TEST_EXPECT(clientSocket.setTcpCork(true));
+    SC_TEST_EXPECT(clientSocket.getTcpCork(enabled) and enabled);
+    SC_TEST_EXPECT(clientSocket.setTcpCork(false));
+    SC_TEST_EXPECT(clientSocket.getTcpCork(enabled) and not enabled);
+    SC_TEST_EXPECT(clientSocket.setTcpNotSentLowWatermark(16 * 1024));
+    SC_TEST_EXPECT(clientSocket.getTcpNotSentLowWatermark(value) and value == 16 * 1024);
+#if SC_PLATFORM_LINUX
+    SC_TEST_EXPECT(serverSocket.getTcpFastOpen(value) and value == 16);
+    SC_TEST_EXPECT(serverSocket.getTcpDeferAccept(value) and value > 0);
+    SC_TEST_EXPECT(clientSocket.setTcpFastOpenConnect(true));
+    SC_TEST_EXPECT(clientSocket.getTcpFastOpenConnect(enabled) and enabled);
+    SC_TEST_EXPECT(clientSocket.setBusyPoll(0));
+    SC_TEST_EXPECT(clientSocket.getBusyPoll(value) and value == 0);
+#else
+    SC_TEST_EXPECT(not clientSocket.setTcpFastOpenConnect(true));
+    SC_TEST_EXPECT(not clientSocket.setTcpDeferAccept(1));
+    SC_TEST_EXPECT(not clientSocket.setBusyPoll(50));
+#endif
+    SC_TEST_EXPECT(clientSocket.close());
+#else
+    SC_TEST_EXPECT(not serverSocket.setReusePort(true));
+    SC_TEST_EXPECT(not serverSocket.setTcpCork(true));
+    SC_TEST_EXPECT(not serverSocket.setTcpDeferAccept(1));
+    (void)value;
+#endif
+    SC_TEST_EXPECT(serverSocket.close());
+}
+
 SC::Result SC::SocketTest::socketServerSnippet()
 {
     //! [socketServerSnippet]
@@ -1,6 +1,7 @@
 // Copyright (c) Stefano Cristiano
 // SPDX-License-Identifier: MIT
 #include "Libraries/Strings/StringConverter.h"
+#include "Libraries/Strings/Internal/UnicodeTranscoding.h"
 #include "Libraries/Containers/Vector.h"
 #include "Libraries/Memory/Buffer.h"
 #include "Libraries/Memory/String.h"
@@ -15,6 +16,8 @@ struct StringConverterTest;
 struct SC::StringConverterTest : public SC::TestCase
 {
     inline void convertUtf8Utf16();
+    inline void convertMixedText();
+    inline void rejectInvalidText();
     StringConverterTest(SC::TestReport& report) : TestCase(report, "StringConverterTest")
     {
         using namespace SC;
@@ -22,6 +25,14 @@ struct SC::StringConverterTest : public SC::TestCase
         {
             convertUtf8Utf16();
         }
+        if (test_section("UTF8<->UTF16 mixed ASCII and multi-byte"))
+        {
+            convertMixedText();
+        }
+        if (test_section("UTF8<->UTF16 invalid"))
+        {
+            rejectInvalidText();
+        }
     }
 };
 
@@ -53,6 +64,101 @@ void SC::StringConverterTest::convertUtf8Utf16()
     SC_TEST_EXPECT(output == u16view);
     //! [stringConverterTestSnippet]
 }
+void SC::StringConverterTest::convertMixedText()
+{
+    // Long ASCII runs (processed in SIMD blocks) around 2, 3 and 4 bytes UTF-8 sequences ("é", "日", "😀")
+    SmallBuffer<512> utf8;
+    SmallBuffer<512> utf16;
+    for (int idx = 0; idx < 3; ++idx)
+    {
+        for (int ascii = 0; ascii < 37; ++ascii)
+        {
+            const char asciiChar = static_cast<char>('a' + ascii % 26);
+            SC_TEST_EXPECT(utf8.append({&asciiChar, 1}));
+            const char asciiUnit[] = {asciiChar, 0};
+            SC_TEST_EXPECT(utf16.append({asciiUnit, 2}));
+        }
+        SC_TEST_EXPECT(utf8.append({"\xC3\xA9\xE6\x97\xA5\xF0\x9F\x98\x80", 9}));
+        SC_TEST_EXPECT(utf16.append({"\xE9\x00\xE5\x65\x3D\xD8\x00\xDE", 8}));
+    }
+    const StringView u8view  = StringView(utf8.toSpanConst(), false, StringEncoding::Utf8);
+    const StringView u16view = StringView(utf16.toSpanConst(), false, StringEncoding::Utf16);
+
+    // Conversion appends after existing content of the destination
+    String string = StringEncoding::Utf16;
+    SC_TEST_EXPECT(string.assign(StringView({"\x3E\x00", 2}, false, StringEncoding::Utf16)));
+    SC_TEST_EXPECT(StringConverter::appendEncodingTo(StringEncoding::Utf16, u8view, string,
+                                                     StringConverter::DoNotTerminate));
+    const StringView converted = string.view();
+    SC_TEST_EXPECT(converted.startsWith(StringView({"\x3E\x00", 2}, false, StringEncoding::Utf16)));
+    SC_TEST_EXPECT(converted.sizeInBytes() == u16view.sizeInBytes() + 2);
+    SC_TEST_EXPECT(converted.sliceStart(1) == u16view);
+
+    SmallBuffer<512> roundTrip;
+    SC_TEST_EXPECT(roundTrip.append({">", 1}));
+    SC_TEST_EXPECT(StringConverter::appendEncodingTo(StringEncoding::Utf8, u16view, roundTrip,
+                                                     StringConverter::NullTerminate));
+    SC_TEST_EXPECT(roundTrip.size() == u8view.sizeInBytes() + 2);
+    SC_TEST_EXPECT(roundTrip[0] == '>' and roundTrip[roundTrip.size() - 1] == 0);
+    SC_TEST_EXPECT(StringView({roundTrip.data() + 1, u8view.sizeInBytes()}, false, StringEncoding::Utf8) == u8view);
+
+    SC_TEST_EXPECT(UnicodeTranscoding::isValidUtf8(utf8.toSpanConst()));
+    SC_TEST_EXPECT(UnicodeTranscoding::isValidUtf16(utf16.toSpanConst()));
+    SC_TEST_EXPECT(UnicodeTranscoding::countAscii(utf8.toSpanConst()) == 37);
+}
+
+void SC::StringConverterTest::rejectInvalidText()
+{
+    const StringSpan invalidUtf8[] = {
+        "\xC0\x80",         // overlong NUL
+        "\xE0\x80\xAF",     // overlong '/'
+        "\xED\xA0\x80",     // surrogate encoded in UTF-8
+        "\xF4\x90\x80\x80", // above U+10FFFF
+        "\xE6\x97",         // truncated sequence
+        "\xE6\x41\xA5",     // invalid continuation byte
+        "\xFF",             // invalid lead byte
+    };
+    for (const StringSpan sequence : invalidUtf8)
+    {
+        // Embed the sequence after a long ASCII prefix to exercise the switch from SIMD blocks to scalar decoding
+        SmallBuffer<64> utf8;
+        SC_TEST_EXPECT(utf8.append({"0123456789abcdef0123456789abcdef01234", 37}));
+        SC_TEST_EXPECT(utf8.append(sequence.toCharSpan()));
+        SC_TEST_EXPECT(not UnicodeTranscoding::isValidUtf8(utf8.toSpanConst()));
+
+        SmallBuffer<256> utf16;
+        SC_TEST_EXPECT(utf16.append({"\x3E\x00", 2}));
+        const StringView view = StringView(utf8.toSpanConst(), false, StringEncoding::Utf8);
+        SC_TEST_EXPECT(not StringConverter::appendEncodingTo(StringEncoding::Utf16, view, utf16,
+                                                             StringConverter::NullTerminate));
+        SC_TEST_EXPECT(utf16.size() == 2); // Destination is left untouched
+    }
+
+    const char loneLead[]  = "\x41\x00\x00\xD8\x42\x00"; // "A" + lead surrogate not followed by trail + "B"
+    const char loneTrail[] = "\x41\x00\x00\xDC";         // "A" + trail surrogate without lead
+    const char truncated[] = "\x41\x00\x3D\xD8";         // "A" + lead surrogate at end of text
+    const Span<const char> invalidUtf16[] = {{loneLead, sizeof(loneLead) - 1},
+                                             {loneTrail, sizeof(loneTrail) - 1},
+                                             {truncated, sizeof(truncated) - 1}};
+    // Converting to UTF-8 replaces unpaired surrogates with U+FFFD, so that native (Windows) strings always convert
+    const StringSpan replacedUtf8[] = {"A\xEF\xBF\xBD" "B", "A\xEF\xBF\xBD", "A\xEF\xBF\xBD"};
+    for (size_t idx = 0; idx < 3; ++idx)
+    {
+        const Span<const char> sequence = invalidUtf16[idx];
+        SC_TEST_EXPECT(not UnicodeTranscoding::isValidUtf16(sequence));
+        char   strict[16];
+        size_t numWritten = 0;
+        SC_TEST_EXPECT(not UnicodeTranscoding::convertUtf16ToUtf8(sequence, strict, numWritten));
+
+        SmallBuffer<64> utf8;
+        const StringView view = StringView(sequence, false, StringEncoding::Utf16);
+        SC_TEST_EXPECT(StringConverter::appendEncodingTo(StringEncoding::Utf8, view, utf8,
+                                                         StringConverter::DoNotTerminate));
+        SC_TEST_EXPECT(StringView(utf8.toSpanConst(), false, StringEncoding::Utf8) == replacedUtf8[idx]);
+    }
+    SC_TEST_EXPECT(not UnicodeTranscoding::isValidUtf16({"\x41\x00\x42", 3})); // odd number of bytes
+}
+
 namespace SC
 {
 void runStringConverterTest(SC::TestReport& report) { StringConverterTest test(report); }
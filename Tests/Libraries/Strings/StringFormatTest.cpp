@@ -88,6 +88,18 @@ struct SC::StringFormatTest : public SC::TestCase
             SC_TEST_EXPECT(buffer == "__1.200000__");
             SC_TEST_EXPECT(StringBuilder::format(buffer, "__{}__", double(1.2)));
             SC_TEST_EXPECT(buffer == "__1.200000__");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "__{:r}__", float(1.2)));
+            SC_TEST_EXPECT(buffer == "__1.2__");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:r}_{:r}_{:r}", 0.1, 1e21, -5e-324));
+            SC_TEST_EXPECT(buffer == "0.1_1e+21_-5e-324");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:r}_{:r}", 123456789012345680000.0, 0.000001));
+            SC_TEST_EXPECT(buffer == "123456789012345680000_0.000001");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "__{}__", static_cast<int64_t>(-9223372036854775807LL - 1)));
+            SC_TEST_EXPECT(buffer == "__-9223372036854775808__");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "__{}__", uint32_t(4000000000u)));
+            SC_TEST_EXPECT(buffer == "__4000000000__");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "__{:05}__", uint32_t(42)));
+            SC_TEST_EXPECT(buffer == "__00042__");
             SC_TEST_EXPECT(StringBuilder::format(buffer, "__{}__", ssize_t(-4)));
             SC_TEST_EXPECT(buffer == "__-4__");
             SC_TEST_EXPECT(StringBuilder::format(buffer, "__{}__", size_t(+4)));
@@ -125,6 +137,41 @@ struct SC::StringFormatTest : public SC::TestCase
             SC_TEST_EXPECT(StringBuilder::format(buffer, "{0:.2}_{1}_{0:.4}", 1.2222, "salve"));
             SC_TEST_EXPECT(buffer == "1.22_salve_1.2222");
         }
+        if (test_section("number specifiers"))
+        {
+            String buffer(StringEncoding::Ascii);
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:+6}|{:-6}|{: }|{:+}", 7, -3, 5, uint32_t(5)));
+            SC_TEST_EXPECT(buffer == "    +7|-3    | 5|5");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:06}|{:8.4}|{:08.4}|{:.0}", -42, 42, -42, 0));
+            SC_TEST_EXPECT(buffer == "-00042|    0042|   -0042|");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:09.3}|{:-9.1}|{:+.0}|{:.0}", -2.5, 0.25, 2.5, 3.5));
+            SC_TEST_EXPECT(buffer == "-0002.500|0.2      |+2|4");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:.2}|{:.3}|{:.1}", 0.125, -0.0, 9.96));
+            SC_TEST_EXPECT(buffer == "0.12|-0.000|10.0");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:.20}", 0.1));
+            SC_TEST_EXPECT(buffer == "0.10000000000000000555");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, "{:.1}", 1e20));
+            SC_TEST_EXPECT(buffer == "100000000000000000000.0");
+        }
+        if (test_section("format string checked at compile time"))
+        {
+            String buffer(StringEncoding::Ascii);
+            SC_TEST_EXPECT(StringBuilder::format(buffer, SC_FORMAT_STRING("{1}_{0}_{1}"), 1, 0));
+            SC_TEST_EXPECT(buffer == "0_1_0");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, SC_FORMAT_STRING("{{{}}}_{:05}_{:r}"), "a", 42, 0.1));
+            SC_TEST_EXPECT(buffer == "{a}_00042_0.1");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, SC_FORMAT_STRING("{0:.2}_{1}_{0:+8.4}"), 1.2222, "salve"));
+            SC_TEST_EXPECT(buffer == "1.22_salve_ +1.2222");
+            SC_TEST_EXPECT(StringBuilder::format(buffer, SC_FORMAT_STRING("no arguments")));
+            SC_TEST_EXPECT(buffer == "no arguments");
+            auto builder = StringBuilder::createForAppendingTo(buffer);
+            SC_TEST_EXPECT(builder.append(SC_FORMAT_STRING("_{}_{}"), StringView("sv"), true));
+            SC_TEST_EXPECT(builder.finalize() == "no arguments_sv_true");
+            // The following lines would fail to compile:
+            // (void)StringBuilder::format(buffer, SC_FORMAT_STRING("{} {}"), 1); // Missing argument
+            // (void)StringBuilder::format(buffer, SC_FORMAT_STRING("{:r}"), 1);  // 'r' is valid only for floats
+            // (void)StringBuilder::format(buffer, SC_FORMAT_STRING("{"), 1);     // Unmatched brace
+        }
     }
 };
 
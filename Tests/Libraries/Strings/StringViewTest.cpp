@@ -120,6 +120,32 @@ struct SC::StringViewTest : public SC::TestCase
             SC_TEST_EXPECT(not StringView("-.").parseFloat(value));
             SC_TEST_EXPECT(not StringView("-..0").parseFloat(value));
             SC_TEST_EXPECT(not StringView("").parseFloat(value));
+            SC_TEST_EXPECT(not StringView("1.5x").parseFloat(value));
+            SC_TEST_EXPECT(StringView("1e-3").parseFloat(value) and value == 1e-3f);
+            const StringView utf16 = "\x2d\x00\x32\x00\x2e\x00\x35\x00\x45\x00\x32\x00"_u16; // -2.5E2
+            SC_TEST_EXPECT(utf16.parseFloat(value) and value == -250.0f);
+        }
+
+        if (test_section("parseDouble"))
+        {
+            double value;
+            SC_TEST_EXPECT(StringView("0.1").parseDouble(value) and value == 0.1);
+            SC_TEST_EXPECT(StringView("1e+21").parseDouble(value) and value == 1e21);
+            SC_TEST_EXPECT(StringView("-5e-324").parseDouble(value) and value == -5e-324);
+            SC_TEST_EXPECT(StringView("1.7976931348623157e308").parseDouble(value) and value == 1.7976931348623157e308);
+            SC_TEST_EXPECT(StringView("9007199254740993").parseDouble(value) and value == 9007199254740992.0);
+            SC_TEST_EXPECT(not StringView("1e").parseDouble(value));
+            SC_TEST_EXPECT(not StringView("nan").parseDouble(value));
+
+            // UTF-16 numbers longer than the formatted ones are narrowed to ASCII before being parsed
+            char longUtf16[200] = {'0', 0, '.', 0}; // "0.000...001" with 100 characters
+            for (size_t idx = 4; idx < sizeof(longUtf16); idx += 2)
+            {
+                longUtf16[idx]     = idx + 2 == sizeof(longUtf16) ? '1' : '0';
+                longUtf16[idx + 1] = 0;
+            }
+            SC_TEST_EXPECT(StringView({longUtf16, sizeof(longUtf16)}, false, StringEncoding::Utf16).parseDouble(value));
+            SC_TEST_EXPECT(value == 1e-98);
         }
 
         if (test_section("startsWith/endsWith"))
@@ -224,6 +250,16 @@ struct SC::StringViewTest : public SC::TestCase
                 SC_TEST_EXPECT(lines.component == "Line3");
                 SC_TEST_EXPECT(not lines.tokenizeNextLine());
             }
+            {
+                // More separators than the SIMD compares, falling back to byte class table
+                StringViewTokenizer tokenizer("alpha beta,gamma;delta:epsilon|zeta.eta!theta?iota-kappa"_a8);
+                const StringCodePoint separators[] = {' ', ',', ';', ':', '|', '.', '!', '?', '-'};
+                SC_TEST_EXPECT(tokenizer.countTokens(separators).numSplitsNonEmpty == 10);
+                StringViewTokenizer words("x\xc3\xa9x, \xe6\x97\xa5 long enough to cross a block,done"_u8);
+                SC_TEST_EXPECT(words.tokenizeNext({',', ' '}) and words.component == "x\xc3\xa9x"_u8);
+                SC_TEST_EXPECT(words.tokenizeNext({',', ' '}) and words.component == "\xe6\x97\xa5"_u8);
+                SC_TEST_EXPECT(words.countTokens({','}).numSplitsNonEmpty == 4); // Includes the two tokens above
+            }
             constexpr auto keyValue16 =
                 "\x4b\x00\x45\x00\x59\x00\x20\x00\x3d\x00\x20\x00\x56\x00\x41\x00\x4c\x00\x55\x00\x45\x00"_u16;
             constexpr auto keyValue8 = "KEY = VALUE"_u8;
@@ -281,6 +317,22 @@ struct SC::StringViewTest : public SC::TestCase
             SC_TEST_EXPECT(not asd.containsString("4567"));
             size_t overlapPoints = 0;
             SC_TEST_EXPECT(not asd.fullyOverlaps("123___", overlapPoints) and overlapPoints == 3);
+
+            // Longer than SIMD block size, with partial matches before the real one and matches near the end
+            StringView log = "2024-01-01 INFO boundary--boundar-boundary--x ERROR: disk full at /dev/sda1"_a8;
+            SC_TEST_EXPECT(log.containsString("ERROR: disk"));
+            SC_TEST_EXPECT(log.containsString("sda1"));
+            SC_TEST_EXPECT(log.containsString("2024"));
+            SC_TEST_EXPECT(not log.containsString("ERROR: disk empty"));
+            SC_TEST_EXPECT(not log.containsString("sda12"));
+            StringView afterBoundary;
+            SC_TEST_EXPECT(log.splitAfter("boundary--x", afterBoundary));
+            SC_TEST_EXPECT(afterBoundary == " ERROR: disk full at /dev/sda1");
+
+            // Bytes matching across two UTF16 code units must not be considered a match
+            const StringView units = StringView({"\x00\x41\x42\x00", 4}, false, StringEncoding::Utf16);
+            SC_TEST_EXPECT(not units.containsString(StringView({"\x41\x42", 2}, false, StringEncoding::Utf16)));
+            SC_TEST_EXPECT(units.containsString(StringView({"\x42\x00", 2}, false, StringEncoding::Utf16)));
         }
         if (test_section("contains ignore case ASCII"))
         {
@@ -290,6 +342,11 @@ struct SC::StringViewTest : public SC::TestCase
             SC_TEST_EXPECT(not "x86_64-w64-windows-gnu"_a8.containsStringIgnoreCaseASCII("musl"_a8));
             SC_TEST_EXPECT("caf\xc3\xa9-runner"_u8.containsStringIgnoreCaseASCII("CAF\xc3\xa9"_u8));
             SC_TEST_EXPECT(not "caf\xc3\xa9-runner"_u8.containsStringIgnoreCaseASCII("CAF\xc3\x89"_u8));
+            StringView header = "Content-Type: multipart/form-data; BOUNDARY=----WebKitFormBoundary7MA4YWxk"_a8;
+            SC_TEST_EXPECT(header.containsStringIgnoreCaseASCII("boundary=----webkitformboundary7ma4ywxk"_a8));
+            SC_TEST_EXPECT(header.containsStringIgnoreCaseASCII("CONTENT-TYPE"_a8));
+            SC_TEST_EXPECT(not header.containsStringIgnoreCaseASCII("boundary=----webkitformboundary7ma4ywxz"_a8));
+            SC_TEST_EXPECT(not "[@"_a8.containsStringIgnoreCaseASCII("{`"_a8)); // Only letters are folded
         }
         if (test_section("compare"))
         {
@@ -57,6 +57,7 @@ void runHashingTest(TestReport& report);
 // Http
 void runHttpParserTest(TestReport& report);
 void runHttpAsyncClientTest(TestReport& report);
+void runHttpAsyncClientPoolTest(TestReport& report);
 void runHttpAsyncServerTest(TestReport& report);
 void runHttpAsyncFileServerTest(TestReport& report);
 void runHttpURLParserTest(TestReport& report);
@@ -87,6 +88,7 @@ void runSerializationBinaryTest(TestReport& report);
 void runSerializationBinaryTypeErasedTest(TestReport& report);
 void runSerializationJsonTest(TestReport& report);
 void runSerializationJsonTokenizerTest(TestReport& report);
+void runSerializationJsonStreamTest(TestReport& report);
 
 // Socket
 void runSocketTest(TestReport& report);
@@ -111,9 +113,11 @@ void runOptionalTest(TestReport& report);
 // Async
 void runAsyncContractTest(SC::TestReport& report);
 void runAsyncTest(SC::TestReport& report);
+void runAsyncDNSTest(SC::TestReport& report);
 void runAsyncStreamTest(SC::TestReport& report);
 void runAsyncRequestStreamTest(SC::TestReport& report);
 void runZLibStreamTest(TestReport& report);
+void runCodecStreamsTest(TestReport& report);
 void runIntrusiveDoubleLinkedListTest(TestReport& report);
 
 // Support
@@ -204,6 +208,7 @@ int main(int argc, const char* argv[])
     // Http tests
     runHttpParserTest(report);
     runHttpAsyncClientTest(report);
+    runHttpAsyncClientPoolTest(report);
     runHttpAsyncServerTest(report);
     runHttpAsyncFileServerTest(report);
     runHttpURLParserTest(report);
@@ -237,6 +242,7 @@ int main(int argc, const char* argv[])
     runSerializationBinaryTypeErasedTest(report);
     runSerializationJsonTokenizerTest(report);
     runSerializationJsonTest(report);
+    runSerializationJsonStreamTest(report);
 
     // Socket tests
     runSocketTest(report);
@@ -262,9 +268,11 @@ int main(int argc, const char* argv[])
     // Async tests
     runAsyncContractTest(report);
     runAsyncTest(report);
+    runAsyncDNSTest(report);
     runAsyncStreamTest(report);
     runAsyncRequestStreamTest(report);
     runZLibStreamTest(report);
+    runCodecStreamsTest(report);
     runIntrusiveDoubleLinkedListTest(report);
 
     // DebugVisualizers tests